@@ -55,16 +55,38 @@ void mp_soft_spi_transfer(void *self_in, size_t len, const uint8_t *src, uint8_t
     // will run as fast as possible, limited only by CPU speed and GPIO time.
     #ifdef MICROPY_HW_SOFTSPI_MIN_DELAY
     if (delay_half == MICROPY_HW_SOFTSPI_MIN_DELAY) {
+        // Cache bus state in locals so it stays in registers, only drive MOSI
+        // when the output bit changes, and skip MISO sampling entirely for
+        // write-only transfers (dest == NULL), eg display flushes.
+        mp_hal_pin_obj_t sck = self->sck;
+        mp_hal_pin_obj_t mosi = self->mosi;
+        mp_hal_pin_obj_t miso = self->miso;
+        unsigned int pol = self->polarity;
+        unsigned int last_out = 2; // impossible value, forces the first write
         for (size_t i = 0; i < len; ++i) {
             uint8_t data_out = src[i];
-            uint8_t data_in = 0;
-            for (int j = 0; j < 8; ++j, data_out <<= 1) {
-                mp_hal_pin_write(self->mosi, (data_out >> 7) & 1);
-                mp_hal_pin_write(self->sck, 1 - self->polarity);
-                data_in = (data_in << 1) | mp_hal_pin_read(self->miso);
-                mp_hal_pin_write(self->sck, self->polarity);
-            }
-            if (dest != NULL) {
+            if (dest == NULL) {
+                for (int j = 0; j < 8; ++j, data_out <<= 1) {
+                    unsigned int bit = (data_out >> 7) & 1;
+                    if (bit != last_out) {
+                        mp_hal_pin_write(mosi, bit);
+                        last_out = bit;
+                    }
+                    mp_hal_pin_write(sck, 1 - pol);
+                    mp_hal_pin_write(sck, pol);
+                }
+            } else {
+                uint8_t data_in = 0;
+                for (int j = 0; j < 8; ++j, data_out <<= 1) {
+                    unsigned int bit = (data_out >> 7) & 1;
+                    if (bit != last_out) {
+                        mp_hal_pin_write(mosi, bit);
+                        last_out = bit;
+                    }
+                    mp_hal_pin_write(sck, 1 - pol);
+                    data_in = (data_in << 1) | mp_hal_pin_read(miso);
+                    mp_hal_pin_write(sck, pol);
+                }
                 dest[i] = data_in;
             }
         }
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Atomic operations on 32-bit words in memory, for building lock-free
+// structures (e.g. SPSC queues shared with an ISR or another core) in
+// Python or viper code without masking interrupts.  The compiler's
+// __atomic builtins lower to LDREX/STREX on Thumb and lock-prefixed
+// instructions on x86, so no global IRQ blackout is involved.  Addresses
+// are taken as plain integers, typically from uctypes.addressof().
+
+#include "py/runtime.h"
+#include "extmod/machine_atomic.h"
+
+#if MICROPY_PY_MACHINE_ATOMIC
+
+STATIC uint32_t *machine_atomic_get_ptr(mp_obj_t addr_o) {
+    uintptr_t addr = mp_obj_get_int_truncated(addr_o);
+    if ((addr & 3) != 0) {
+        mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("address %08x is not aligned to %d bytes"), addr, 4);
+    }
+    return (uint32_t *)addr;
+}
+
+STATIC mp_obj_t machine_atomic_load(mp_obj_t addr_in) {
+    uint32_t *ptr = machine_atomic_get_ptr(addr_in);
+    return mp_obj_new_int_from_uint(__atomic_load_n(ptr, __ATOMIC_ACQUIRE));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(machine_atomic_load_obj, machine_atomic_load);
+
+STATIC mp_obj_t machine_atomic_store(mp_obj_t addr_in, mp_obj_t val_in) {
+    uint32_t *ptr = machine_atomic_get_ptr(addr_in);
+    __atomic_store_n(ptr, (uint32_t)mp_obj_get_int_truncated(val_in), __ATOMIC_RELEASE);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(machine_atomic_store_obj, machine_atomic_store);
+
+// Returns the value held at the address before the addition.
+STATIC mp_obj_t machine_atomic_add(mp_obj_t addr_in, mp_obj_t val_in) {
+    uint32_t *ptr = machine_atomic_get_ptr(addr_in);
+    uint32_t val = (uint32_t)mp_obj_get_int_truncated(val_in);
+    return mp_obj_new_int_from_uint(__atomic_fetch_add(ptr, val, __ATOMIC_ACQ_REL));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(machine_atomic_add_obj, machine_atomic_add);
+
+// Stores desired at the address if it currently holds expected; returns
+// whether the store happened.
+STATIC mp_obj_t machine_atomic_cas(mp_obj_t addr_in, mp_obj_t expected_in, mp_obj_t desired_in) {
+    uint32_t *ptr = machine_atomic_get_ptr(addr_in);
+    uint32_t expected = (uint32_t)mp_obj_get_int_truncated(expected_in);
+    uint32_t desired = (uint32_t)mp_obj_get_int_truncated(desired_in);
+    bool ok = __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return mp_obj_new_bool(ok);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(machine_atomic_cas_obj, machine_atomic_cas);
+
+#endif // MICROPY_PY_MACHINE_ATOMIC
@@ -52,7 +52,18 @@ STATIC int mp_hal_i2c_scl_release(machine_i2c_obj_t *self) {
 
     mp_hal_pin_od_high(self->scl);
     mp_hal_i2c_delay(self);
-    // For clock stretching, wait for the SCL pin to be released, with timeout.
+    if (mp_hal_pin_read(self->scl) != 0) {
+        // common case: no clock stretching
+        return 0;
+    }
+    // Short stretches resolve within a bit time; spin on the pin without
+    // inserting delays first so they don't cost a microsecond each.
+    for (int fast = 64; fast; --fast) {
+        if (mp_hal_pin_read(self->scl) != 0) {
+            return 0;
+        }
+    }
+    // For longer clock stretching, wait for the SCL pin to be released, with timeout.
     for (; mp_hal_pin_read(self->scl) == 0 && count; --count) {
         mp_hal_delay_us_fast(1);
     }
@@ -535,6 +546,80 @@ STATIC int write_mem(mp_obj_t self_in, uint16_t addr, uint32_t memaddr, uint8_t
     return i2c_p->transfer(self, addr, 2, bufs, MP_MACHINE_I2C_FLAG_STOP);
 }
 
+#if MICROPY_PY_MACHINE_I2C_TRANSACTION
+
+// transaction(addr, msgs[, stop]) -- msgs is a sequence of (read, buf)
+// pairs, executed as one bus transaction: a repeated start before each
+// message and a single stop (if requested) after the last.  Returns the
+// total number of acks received for written bytes.
+STATIC mp_obj_t machine_i2c_transaction(size_t n_args, const mp_obj_t *args) {
+    mp_obj_base_t *self = (mp_obj_base_t *)MP_OBJ_TO_PTR(args[0]);
+    mp_int_t addr = mp_obj_get_int(args[1]);
+
+    size_t nmsgs;
+    mp_obj_t *msgs;
+    mp_obj_get_array(args[2], &nmsgs, &msgs);
+
+    bool stop = (n_args == 3) ? true : mp_obj_is_true(args[3]);
+
+    mp_machine_i2c_p_t *i2c_p = (mp_machine_i2c_p_t *)self->type->protocol;
+    int num_acks = 0;
+    for (size_t i = 0; i < nmsgs; ++i) {
+        mp_obj_t *items;
+        mp_obj_get_array_fixed_n(msgs[i], 2, &items);
+        bool rd = mp_obj_is_true(items[0]);
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(items[1], &bufinfo, rd ? MP_BUFFER_WRITE : MP_BUFFER_READ);
+        mp_machine_i2c_buf_t buf = {.len = bufinfo.len, .buf = bufinfo.buf};
+        unsigned int flags = rd ? MP_MACHINE_I2C_FLAG_READ : 0;
+        if (stop && i + 1 == nmsgs) {
+            flags |= MP_MACHINE_I2C_FLAG_STOP;
+        }
+        int ret = i2c_p->transfer(self, addr, 1, &buf, flags);
+        if (ret < 0) {
+            // release the bus before raising
+            if (i2c_p->stop != NULL) {
+                i2c_p->stop(self);
+            }
+            mp_raise_OSError(-ret);
+        }
+        if (!rd) {
+            num_acks += ret;
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(num_acks);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_i2c_transaction_obj, 3, 4, machine_i2c_transaction);
+
+// writeto_then_readfrom(addr, wrbuf, rdbuf) -- write wrbuf then read into
+// rdbuf with a repeated start in between, as one call.  This is the common
+// register-read shape for sensor polling.
+STATIC mp_obj_t machine_i2c_writeto_then_readfrom(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    mp_obj_base_t *self = (mp_obj_base_t *)MP_OBJ_TO_PTR(args[0]);
+    mp_int_t addr = mp_obj_get_int(args[1]);
+
+    mp_buffer_info_t wrinfo;
+    mp_get_buffer_raise(args[2], &wrinfo, MP_BUFFER_READ);
+    mp_buffer_info_t rdinfo;
+    mp_get_buffer_raise(args[3], &rdinfo, MP_BUFFER_WRITE);
+
+    int ret = mp_machine_i2c_writeto(self, addr, wrinfo.buf, wrinfo.len, false);
+    if (ret != (int)wrinfo.len) {
+        // nack or error: must generate STOP
+        mp_machine_i2c_writeto(self, addr, NULL, 0, true);
+        mp_raise_OSError(ret < 0 ? -ret : MP_ENODEV);
+    }
+    ret = mp_machine_i2c_readfrom(self, addr, rdinfo.buf, rdinfo.len, true);
+    if (ret < 0) {
+        mp_raise_OSError(-ret);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_i2c_writeto_then_readfrom_obj, 4, 4, machine_i2c_writeto_then_readfrom);
+
+#endif // MICROPY_PY_MACHINE_I2C_TRANSACTION
+
 STATIC const mp_arg_t machine_i2c_mem_allowed_args[] = {
     { MP_QSTR_addr,    MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
     { MP_QSTR_memaddr, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
@@ -620,6 +705,10 @@ STATIC const mp_rom_map_elem_t machine_i2c_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readfrom_into), MP_ROM_PTR(&machine_i2c_readfrom_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto), MP_ROM_PTR(&machine_i2c_writeto_obj) },
     { MP_ROM_QSTR(MP_QSTR_writevto), MP_ROM_PTR(&machine_i2c_writevto_obj) },
+    #if MICROPY_PY_MACHINE_I2C_TRANSACTION
+    { MP_ROM_QSTR(MP_QSTR_transaction), MP_ROM_PTR(&machine_i2c_transaction_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeto_then_readfrom), MP_ROM_PTR(&machine_i2c_writeto_then_readfrom_obj) },
+    #endif
 
     // memory operations
     { MP_ROM_QSTR(MP_QSTR_readfrom_mem), MP_ROM_PTR(&machine_i2c_readfrom_mem_obj) },
@@ -0,0 +1,227 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2021 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/mpconfig.h"
+#if MICROPY_PY_MACHINE_PINGROUP
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "extmod/virtpin.h"
+#include "extmod/machine_pingroup.h"
+
+// PinGroup class
+//
+// Maps an ordered collection of pins onto the bits of an integer so a
+// parallel bus can be read or written with a single call: pin i of the
+// group is bit (1 << i) of the value.  When the port can map every pin of
+// a group onto one GPIO port register (MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL)
+// the whole group is transferred with a single register access, otherwise
+// the pins are accessed one at a time through the pin protocol.
+
+typedef struct _machine_pin_group_t {
+    mp_obj_base_t base;
+    size_t n_pins;
+    mp_obj_t *pins;
+    mp_uint_t all_mask;
+    #if MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+    bool direct;
+    uintptr_t port_id;
+    uint8_t *bits; // position of each pin within the port register
+    #endif
+} machine_pin_group_t;
+
+#if MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+// The port provides the mapping from a pin object to its GPIO port register
+// and bit position, plus masked whole-port accessors.  mp_hal_pin_group_map
+// returns false for pins that can't be reached as a register (the group then
+// falls back to per-pin access).
+bool mp_hal_pin_group_map(mp_obj_t pin, uintptr_t *port_id, uint8_t *bit);
+mp_uint_t mp_hal_pin_group_read(uintptr_t port_id);
+void mp_hal_pin_group_write(uintptr_t port_id, mp_uint_t value, mp_uint_t mask);
+#endif
+
+STATIC mp_uint_t pin_group_read(machine_pin_group_t *self) {
+    mp_uint_t value = 0;
+    #if MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+    if (self->direct) {
+        mp_uint_t port = mp_hal_pin_group_read(self->port_id);
+        for (size_t i = 0; i < self->n_pins; ++i) {
+            value |= ((port >> self->bits[i]) & 1) << i;
+        }
+        return value;
+    }
+    #endif
+    for (size_t i = 0; i < self->n_pins; ++i) {
+        value |= (mp_uint_t)(mp_virtual_pin_read(self->pins[i]) != 0) << i;
+    }
+    return value;
+}
+
+STATIC void pin_group_write(machine_pin_group_t *self, mp_uint_t value, mp_uint_t mask) {
+    #if MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+    if (self->direct) {
+        mp_uint_t port_value = 0;
+        mp_uint_t port_mask = 0;
+        for (size_t i = 0; i < self->n_pins; ++i) {
+            if ((mask >> i) & 1) {
+                port_mask |= (mp_uint_t)1 << self->bits[i];
+                port_value |= ((value >> i) & 1) << self->bits[i];
+            }
+        }
+        mp_hal_pin_group_write(self->port_id, port_value, port_mask);
+        return;
+    }
+    #endif
+    for (size_t i = 0; i < self->n_pins; ++i) {
+        if ((mask >> i) & 1) {
+            mp_virtual_pin_write(self->pins[i], (value >> i) & 1);
+        }
+    }
+}
+
+STATIC mp_obj_t pin_group_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+
+    size_t n_pins;
+    mp_obj_t *pins;
+    mp_obj_get_array(args[0], &n_pins, &pins);
+    if (n_pins == 0 || n_pins > 8 * sizeof(mp_uint_t)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid number of pins"));
+    }
+
+    machine_pin_group_t *o = m_new_obj(machine_pin_group_t);
+    o->base.type = type;
+    o->n_pins = n_pins;
+    o->pins = m_new(mp_obj_t, n_pins);
+    for (size_t i = 0; i < n_pins; ++i) {
+        o->pins[i] = pins[i];
+    }
+    if (n_pins == 8 * sizeof(mp_uint_t)) {
+        o->all_mask = (mp_uint_t)-1;
+    } else {
+        o->all_mask = ((mp_uint_t)1 << n_pins) - 1;
+    }
+
+    #if MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+    // Resolve the group to a single port register up front if possible.
+    o->direct = true;
+    o->bits = m_new(uint8_t, n_pins);
+    for (size_t i = 0; i < n_pins; ++i) {
+        uintptr_t port_id;
+        if (!mp_hal_pin_group_map(o->pins[i], &port_id, &o->bits[i])
+            || (i != 0 && port_id != o->port_id)) {
+            o->direct = false;
+            break;
+        }
+        o->port_id = port_id;
+    }
+    #endif
+
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC void pin_group_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)kind;
+    machine_pin_group_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "<PinGroup of %u pins>", (unsigned)self->n_pins);
+}
+
+// fast method for getting/setting the whole group value
+STATIC mp_obj_t pin_group_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    machine_pin_group_t *self = MP_OBJ_TO_PTR(self_in);
+    if (n_args == 0) {
+        // get pins
+        return mp_obj_new_int_from_uint(pin_group_read(self));
+    } else {
+        // set pins
+        pin_group_write(self, mp_obj_get_int_truncated(args[0]), self->all_mask);
+        return mp_const_none;
+    }
+}
+
+STATIC mp_obj_t pin_group_value(size_t n_args, const mp_obj_t *args) {
+    return pin_group_call(args[0], n_args - 1, 0, args + 1);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pin_group_value_obj, 1, 2, pin_group_value);
+
+STATIC mp_obj_t pin_group_read_all(mp_obj_t self_in) {
+    machine_pin_group_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(pin_group_read(self));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(pin_group_read_all_obj, pin_group_read_all);
+
+// write_all(value, mask=all): set the pins whose bit is set in mask.
+STATIC mp_obj_t pin_group_write_all(size_t n_args, const mp_obj_t *args) {
+    machine_pin_group_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_uint_t mask = self->all_mask;
+    if (n_args == 3) {
+        mask &= mp_obj_get_int_truncated(args[2]);
+    }
+    pin_group_write(self, mp_obj_get_int_truncated(args[1]), mask);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(pin_group_write_all_obj, 2, 3, pin_group_write_all);
+
+STATIC mp_uint_t pin_group_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    (void)errcode;
+    machine_pin_group_t *self = MP_OBJ_TO_PTR(self_in);
+
+    switch (request) {
+        case MP_PIN_READ: {
+            return pin_group_read(self);
+        }
+        case MP_PIN_WRITE: {
+            pin_group_write(self, arg, self->all_mask);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+STATIC const mp_rom_map_elem_t pin_group_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_value), MP_ROM_PTR(&pin_group_value_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_all), MP_ROM_PTR(&pin_group_read_all_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write_all), MP_ROM_PTR(&pin_group_write_all_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(pin_group_locals_dict, pin_group_locals_dict_table);
+
+STATIC const mp_pin_p_t pin_group_pin_p = {
+    .ioctl = pin_group_ioctl,
+};
+
+const mp_obj_type_t machine_pin_group_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_PinGroup,
+    .print = pin_group_print,
+    .make_new = pin_group_make_new,
+    .call = pin_group_call,
+    .protocol = &pin_group_pin_p,
+    .locals_dict = (void *)&pin_group_locals_dict,
+};
+
+#endif // MICROPY_PY_MACHINE_PINGROUP
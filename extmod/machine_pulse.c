@@ -25,6 +25,7 @@
  */
 
 #include "py/runtime.h"
+#include "py/binary.h"
 #include "py/mperrno.h"
 #include "extmod/machine_pulse.h"
 
@@ -62,4 +63,44 @@ STATIC mp_obj_t machine_time_pulse_us_(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_time_pulse_us_obj, 2, 3, machine_time_pulse_us_);
 
+// Capture the time of successive edges (level changes) on pin into the edges
+// array, as microsecond timestamps relative to the start of the call.  This
+// default implementation reads the pin in a tight polling loop; ports with
+// timer-capture hardware can override it.  Returns the number of edges
+// captured, which is less than n_edges if timeout_us elapses first (the
+// timeout covers the whole capture, not each edge).
+MP_WEAK mp_uint_t machine_time_pulses_us(mp_hal_pin_obj_t pin, uint32_t *edges, mp_uint_t n_edges, mp_uint_t timeout_us) {
+    int level = mp_hal_pin_read(pin);
+    mp_uint_t start = mp_hal_ticks_us();
+    mp_uint_t n = 0;
+    while (n < n_edges) {
+        int cur = mp_hal_pin_read(pin);
+        mp_uint_t now = mp_hal_ticks_us();
+        if (cur != level) {
+            level = cur;
+            edges[n++] = now - start;
+        } else if ((mp_uint_t)(now - start) >= timeout_us) {
+            break;
+        }
+    }
+    return n;
+}
+
+STATIC mp_obj_t machine_time_pulses_us_(size_t n_args, const mp_obj_t *args) {
+    mp_hal_pin_obj_t pin = mp_hal_get_pin_obj(args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    size_t sz = mp_binary_get_size('@', bufinfo.typecode, NULL);
+    if (sz != sizeof(uint32_t)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("expecting an array of 32-bit items"));
+    }
+    mp_uint_t timeout_us = 1000000;
+    if (n_args > 2) {
+        timeout_us = mp_obj_get_int(args[2]);
+    }
+    mp_uint_t n = machine_time_pulses_us(pin, bufinfo.buf, bufinfo.len / sz, timeout_us);
+    return MP_OBJ_NEW_SMALL_INT(n);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_time_pulses_us_obj, 2, 3, machine_time_pulses_us_);
+
 #endif
@@ -30,7 +30,9 @@
 #include "py/mphal.h"
 
 mp_uint_t machine_time_pulse_us(mp_hal_pin_obj_t pin, int pulse_level, mp_uint_t timeout_us);
+mp_uint_t machine_time_pulses_us(mp_hal_pin_obj_t pin, uint32_t *edges, mp_uint_t n_edges, mp_uint_t timeout_us);
 
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(machine_time_pulse_us_obj);
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(machine_time_pulses_us_obj);
 
 #endif // MICROPY_INCLUDED_EXTMOD_MACHINE_PULSE_H
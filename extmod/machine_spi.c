@@ -104,6 +104,135 @@ STATIC mp_obj_t mp_machine_spi_write_readinto(mp_obj_t self, mp_obj_t wr_buf, mp
 }
 MP_DEFINE_CONST_FUN_OBJ_3(mp_machine_spi_write_readinto_obj, mp_machine_spi_write_readinto);
 
+#if MICROPY_PY_MACHINE_SPI_ASYNC
+
+#include "py/objlist.h"
+
+// Queued transfers.  A transaction is a (spi, write_buf, read_buf, callback)
+// tuple held in a global FIFO.  Ports whose SPI protocol implements
+// transfer_start/transfer_poll run the head transaction in the background
+// (eg via DMA) while the VM keeps executing; other ports execute
+// transactions synchronously when the queue is pumped.  Completion
+// callbacks are invoked from the pump with the SPI object as argument.
+
+STATIC void machine_spi_txn_complete(mp_obj_t txn) {
+    mp_obj_t *items;
+    mp_obj_get_array_fixed_n(txn, 4, &items);
+    if (items[3] != mp_const_none) {
+        mp_call_function_1(items[3], items[0]);
+    }
+}
+
+// Advance the queue: reap a completed in-flight transaction and start queued
+// ones; with wait=true don't return until all transactions have finished.
+STATIC void machine_spi_txn_pump(bool wait) {
+    for (;;) {
+        mp_obj_t active = MP_STATE_VM(machine_spi_txn_active);
+        if (active != MP_OBJ_NULL) {
+            mp_obj_t *items;
+            mp_obj_get_array_fixed_n(active, 4, &items);
+            mp_obj_base_t *s = (mp_obj_base_t *)MP_OBJ_TO_PTR(items[0]);
+            mp_machine_spi_p_t *spi_p = (mp_machine_spi_p_t *)s->type->protocol;
+            if (!spi_p->transfer_poll(s)) {
+                if (!wait) {
+                    return;
+                }
+                continue;
+            }
+            MP_STATE_VM(machine_spi_txn_active) = MP_OBJ_NULL;
+            machine_spi_txn_complete(active);
+            continue;
+        }
+
+        if (MP_STATE_VM(machine_spi_txn_queue) == MP_OBJ_NULL) {
+            return;
+        }
+        mp_obj_list_t *queue = MP_OBJ_TO_PTR(MP_STATE_VM(machine_spi_txn_queue));
+        if (queue->len == 0) {
+            return;
+        }
+        mp_obj_t txn = queue->items[0];
+        queue->len -= 1;
+        memmove(queue->items, queue->items + 1, queue->len * sizeof(mp_obj_t));
+        queue->items[queue->len] = MP_OBJ_NULL;
+
+        mp_obj_t *items;
+        mp_obj_get_array_fixed_n(txn, 4, &items);
+        mp_obj_base_t *s = (mp_obj_base_t *)MP_OBJ_TO_PTR(items[0]);
+        mp_machine_spi_p_t *spi_p = (mp_machine_spi_p_t *)s->type->protocol;
+        mp_buffer_info_t src;
+        mp_get_buffer_raise(items[1], &src, MP_BUFFER_READ);
+        uint8_t *dest = NULL;
+        if (items[2] != mp_const_none) {
+            mp_buffer_info_t destinfo;
+            mp_get_buffer_raise(items[2], &destinfo, MP_BUFFER_WRITE);
+            dest = destinfo.buf;
+        }
+        if (spi_p->transfer_start != NULL && spi_p->transfer_poll != NULL) {
+            spi_p->transfer_start(s, src.len, src.buf, dest);
+            MP_STATE_VM(machine_spi_txn_active) = txn;
+        } else {
+            spi_p->transfer(s, src.len, src.buf, dest);
+            machine_spi_txn_complete(txn);
+        }
+    }
+}
+
+STATIC size_t machine_spi_txn_pending(void) {
+    size_t n = MP_STATE_VM(machine_spi_txn_active) != MP_OBJ_NULL;
+    if (MP_STATE_VM(machine_spi_txn_queue) != MP_OBJ_NULL) {
+        n += ((mp_obj_list_t *)MP_OBJ_TO_PTR(MP_STATE_VM(machine_spi_txn_queue)))->len;
+    }
+    return n;
+}
+
+STATIC mp_obj_t machine_spi_queue_transfer(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t src;
+    mp_get_buffer_raise(args[1], &src, MP_BUFFER_READ);
+    mp_obj_t rd = (n_args > 2) ? args[2] : mp_const_none;
+    if (rd != mp_const_none) {
+        mp_buffer_info_t dest;
+        mp_get_buffer_raise(rd, &dest, MP_BUFFER_WRITE);
+        if (src.len != dest.len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("buffers must be the same length"));
+        }
+    }
+    mp_obj_t cb = (n_args > 3) ? args[3] : mp_const_none;
+    if (cb != mp_const_none && !mp_obj_is_callable(cb)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("callback must be callable"));
+    }
+    if (MP_STATE_VM(machine_spi_txn_queue) == MP_OBJ_NULL) {
+        MP_STATE_VM(machine_spi_txn_queue) = mp_obj_new_list(0, NULL);
+    }
+    mp_obj_t txn[4] = { args[0], args[1], rd, cb };
+    mp_obj_list_append(MP_STATE_VM(machine_spi_txn_queue), mp_obj_new_tuple(4, txn));
+    machine_spi_txn_pump(false);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(machine_spi_queue_transfer_obj, 2, 4, machine_spi_queue_transfer);
+
+STATIC mp_obj_t machine_spi_poll(mp_obj_t self) {
+    (void)self;
+    machine_spi_txn_pump(false);
+    return MP_OBJ_NEW_SMALL_INT(machine_spi_txn_pending());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(machine_spi_poll_obj, machine_spi_poll);
+
+STATIC mp_obj_t machine_spi_pending(mp_obj_t self) {
+    (void)self;
+    return MP_OBJ_NEW_SMALL_INT(machine_spi_txn_pending());
+}
+MP_DEFINE_CONST_FUN_OBJ_1(machine_spi_pending_obj, machine_spi_pending);
+
+STATIC mp_obj_t machine_spi_flush(mp_obj_t self) {
+    (void)self;
+    machine_spi_txn_pump(true);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(machine_spi_flush_obj, machine_spi_flush);
+
+#endif // MICROPY_PY_MACHINE_SPI_ASYNC
+
 STATIC const mp_rom_map_elem_t machine_spi_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&machine_spi_init_obj) },
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&machine_spi_deinit_obj) },
@@ -111,6 +240,12 @@ STATIC const mp_rom_map_elem_t machine_spi_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_machine_spi_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_machine_spi_write_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_readinto), MP_ROM_PTR(&mp_machine_spi_write_readinto_obj) },
+    #if MICROPY_PY_MACHINE_SPI_ASYNC
+    { MP_ROM_QSTR(MP_QSTR_queue_transfer), MP_ROM_PTR(&machine_spi_queue_transfer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_poll), MP_ROM_PTR(&machine_spi_poll_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pending), MP_ROM_PTR(&machine_spi_pending_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&machine_spi_flush_obj) },
+    #endif
 
     { MP_ROM_QSTR(MP_QSTR_MSB), MP_ROM_INT(MICROPY_PY_MACHINE_SPI_MSB) },
     { MP_ROM_QSTR(MP_QSTR_LSB), MP_ROM_INT(MICROPY_PY_MACHINE_SPI_LSB) },
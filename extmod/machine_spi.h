@@ -48,6 +48,14 @@ typedef struct _mp_machine_spi_p_t {
     void (*init)(mp_obj_base_t *obj, size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
     void (*deinit)(mp_obj_base_t *obj); // can be NULL
     void (*transfer)(mp_obj_base_t *obj, size_t len, const uint8_t *src, uint8_t *dest);
+    #if MICROPY_PY_MACHINE_SPI_ASYNC
+    // optional support for queued transfers, eg via DMA; both can be NULL,
+    // in which case queued transfers fall back to the blocking transfer slot.
+    // transfer_start begins a transfer in the background and transfer_poll
+    // returns true once it has completed.
+    void (*transfer_start)(mp_obj_base_t *obj, size_t len, const uint8_t *src, uint8_t *dest);
+    bool (*transfer_poll)(mp_obj_base_t *obj);
+    #endif
 } mp_machine_spi_p_t;
 
 typedef struct _mp_machine_soft_spi_obj_t {
@@ -66,6 +66,7 @@
 typedef struct {
     mp_obj_base_t base;
     mp_obj_t irq_handler;
+    uint32_t irq_trigger;
     #if !MICROPY_PY_BLUETOOTH_USE_SYNC_EVENTS
     bool irq_scheduled;
     mp_obj_t irq_data_tuple;
@@ -219,18 +220,14 @@ STATIC mp_int_t bluetooth_uuid_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bu
 STATIC void ringbuf_put_uuid(ringbuf_t *ringbuf, mp_obj_bluetooth_uuid_t *uuid) {
     assert(ringbuf_free(ringbuf) >= (size_t)uuid->type + 1);
     ringbuf_put(ringbuf, uuid->type);
-    for (int i = 0; i < uuid->type; ++i) {
-        ringbuf_put(ringbuf, uuid->data[i]);
-    }
+    ringbuf_put_bytes(ringbuf, uuid->data, uuid->type);
 }
 
 STATIC void ringbuf_get_uuid(ringbuf_t *ringbuf, mp_obj_bluetooth_uuid_t *uuid) {
     assert(ringbuf_avail(ringbuf) >= 1);
     uuid->type = ringbuf_get(ringbuf);
     assert(ringbuf_avail(ringbuf) >= uuid->type);
-    for (int i = 0; i < uuid->type; ++i) {
-        uuid->data[i] = ringbuf_get(ringbuf);
-    }
+    ringbuf_get_bytes(ringbuf, uuid->data, uuid->type);
 }
 #endif // MICROPY_PY_BLUETOOTH_ENABLE_CENTRAL_MODE
 
@@ -259,6 +256,7 @@ STATIC mp_obj_t bluetooth_ble_make_new(const mp_obj_type_t *type, size_t n_args,
         o->base.type = &mp_type_bluetooth_ble;
 
         o->irq_handler = mp_const_none;
+        o->irq_trigger = ~(uint32_t)0;
 
         #if !MICROPY_PY_BLUETOOTH_USE_SYNC_EVENTS
         // Pre-allocate the event data tuple to prevent needing to allocate in the IRQ handler.
@@ -420,21 +418,31 @@ STATIC mp_obj_t bluetooth_ble_config(size_t n_args, const mp_obj_t *args, mp_map
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(bluetooth_ble_config_obj, 1, bluetooth_ble_config);
 
-STATIC mp_obj_t bluetooth_ble_irq(mp_obj_t self_in, mp_obj_t handler_in) {
-    (void)self_in;
+STATIC mp_obj_t bluetooth_ble_irq(size_t n_args, const mp_obj_t *args) {
+    mp_obj_t handler_in = args[1];
     if (handler_in != mp_const_none && !mp_obj_is_callable(handler_in)) {
         mp_raise_ValueError(MP_ERROR_TEXT("invalid handler"));
     }
 
+    // Optional trigger mask: bit (1 << event) enables that event, default all
+    // events.  Unwanted events (e.g. scan results when only connect/disconnect
+    // matter) are then dropped at the point they are raised, before any data
+    // is copied into the ringbuf.
+    uint32_t trigger = ~(uint32_t)0;
+    if (n_args == 3) {
+        trigger = mp_obj_get_int_truncated(args[2]);
+    }
+
     // Update the callback.
     MICROPY_PY_BLUETOOTH_ENTER
     mp_obj_bluetooth_ble_t *o = MP_OBJ_TO_PTR(MP_STATE_VM(bluetooth));
     o->irq_handler = handler_in;
+    o->irq_trigger = trigger;
     MICROPY_PY_BLUETOOTH_EXIT
 
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(bluetooth_ble_irq_obj, bluetooth_ble_irq);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bluetooth_ble_irq_obj, 2, 3, bluetooth_ble_irq);
 
 // ----------------------------------------------------------------------------
 // Bluetooth object: GAP
@@ -997,9 +1005,7 @@ STATIC void ringbuf_extract(ringbuf_t *ringbuf, mp_obj_tuple_t *data_tuple, size
     }
     if (bytes_addr) {
         bytes_addr->len = 6;
-        for (size_t i = 0; i < bytes_addr->len; ++i) {
-            ((uint8_t *)bytes_addr->items)[i] = ringbuf_get(ringbuf);
-        }
+        ringbuf_get_bytes(ringbuf, (uint8_t *)bytes_addr->items, bytes_addr->len);
         data_tuple->items[j++] = MP_OBJ_FROM_PTR(bytes_addr);
     }
     for (size_t i = 0; i < n_i8; ++i) {
@@ -1017,9 +1023,7 @@ STATIC void ringbuf_extract(ringbuf_t *ringbuf, mp_obj_tuple_t *data_tuple, size
     // that's what's available here.
     if (bytes_data) {
         bytes_data->len = ringbuf_get16(ringbuf);
-        for (size_t i = 0; i < bytes_data->len; ++i) {
-            ((uint8_t *)bytes_data->items)[i] = ringbuf_get(ringbuf);
-        }
+        ringbuf_get_bytes(ringbuf, (uint8_t *)bytes_data->items, bytes_data->len);
         data_tuple->items[j++] = MP_OBJ_FROM_PTR(bytes_data);
     }
 
@@ -1120,6 +1124,10 @@ STATIC mp_obj_t invoke_irq_handler(uint16_t event,
     if (o->irq_handler == mp_const_none) {
         return mp_const_none;
     }
+    if (!((o->irq_trigger >> event) & 1)) {
+        // Event not enabled by the trigger mask; same result as no handler.
+        return mp_const_none;
+    }
 
     mp_obj_array_t mv_addr;
     mp_obj_array_t mv_data[2];
@@ -1345,6 +1353,12 @@ STATIC bool enqueue_irq(mp_obj_bluetooth_ble_t *o, size_t len, uint8_t event) {
         return false;
     }
 
+    // Filter events the handler hasn't subscribed to before they take up any
+    // room in the ringbuf (scan results in particular arrive continuously).
+    if (!((o->irq_trigger >> event) & 1)) {
+        return false;
+    }
+
     // Check if there is enough room for <event-type><payload>.
     if (ringbuf_free(&o->ringbuf) < len + 1) {
         // Ringbuffer doesn't have room (and is therefore non-empty).
@@ -1379,7 +1393,12 @@ STATIC void schedule_ringbuf(mp_uint_t atomic_state) {
     if (!o->irq_scheduled) {
         o->irq_scheduled = true;
         MICROPY_PY_BLUETOOTH_EXIT
+        #if MICROPY_SCHEDULER_PRIORITY
+        // BLE events are latency sensitive; jump the queue of bulk callbacks.
+        mp_sched_schedule_priority(MP_OBJ_FROM_PTR(&bluetooth_ble_invoke_irq_obj), mp_const_none);
+        #else
         mp_sched_schedule(MP_OBJ_FROM_PTR(&bluetooth_ble_invoke_irq_obj), mp_const_none);
+        #endif
     } else {
         MICROPY_PY_BLUETOOTH_EXIT
     }
@@ -1391,9 +1410,7 @@ void mp_bluetooth_gap_on_connected_disconnected(uint8_t event, uint16_t conn_han
     if (enqueue_irq(o, 2 + 1 + 6, event)) {
         ringbuf_put16(&o->ringbuf, conn_handle);
         ringbuf_put(&o->ringbuf, addr_type);
-        for (int i = 0; i < 6; ++i) {
-            ringbuf_put(&o->ringbuf, addr[i]);
-        }
+        ringbuf_put_bytes(&o->ringbuf, addr, 6);
     }
     schedule_ringbuf(atomic_state);
 }
@@ -1464,9 +1481,7 @@ void mp_bluetooth_gap_on_scan_result(uint8_t addr_type, const uint8_t *addr, uin
     data_len = MIN(o->irq_data_data_alloc, data_len);
     if (enqueue_irq(o, 1 + 6 + 1 + 1 + 2 + data_len, MP_BLUETOOTH_IRQ_SCAN_RESULT)) {
         ringbuf_put(&o->ringbuf, addr_type);
-        for (int i = 0; i < 6; ++i) {
-            ringbuf_put(&o->ringbuf, addr[i]);
-        }
+        ringbuf_put_bytes(&o->ringbuf, addr, 6);
         // The adv_type will get extracted as an int8_t but that's ok because valid values are 0x00-0x04.
         ringbuf_put(&o->ringbuf, adv_type);
         // Note conversion of int8_t rssi to uint8_t. Must un-convert on the way out.
@@ -1474,9 +1489,7 @@ void mp_bluetooth_gap_on_scan_result(uint8_t addr_type, const uint8_t *addr, uin
         // Length field is 16-bit.
         data_len = MIN(UINT16_MAX, data_len);
         ringbuf_put16(&o->ringbuf, data_len);
-        for (size_t i = 0; i < data_len; ++i) {
-            ringbuf_put(&o->ringbuf, data[i]);
-        }
+        ringbuf_put_bytes(&o->ringbuf, data, data_len);
     }
     schedule_ringbuf(atomic_state);
 }
@@ -1550,11 +1563,10 @@ void mp_bluetooth_gattc_on_data_available(uint8_t event, uint16_t conn_handle, u
 
         // Copy total_len from the fragments to the ringbuffer.
         uint16_t copied_bytes = 0;
-        for (size_t i = 0; i < num; ++i) {
-            for (size_t j = 0; i < data_len[i] && copied_bytes < total_len; ++j) {
-                ringbuf_put(&o->ringbuf, data[i][j]);
-                ++copied_bytes;
-            }
+        for (size_t i = 0; i < num && copied_bytes < total_len; ++i) {
+            uint16_t n = MIN(data_len[i], (uint16_t)(total_len - copied_bytes));
+            ringbuf_put_bytes(&o->ringbuf, data[i], n);
+            copied_bytes += n;
         }
     }
     schedule_ringbuf(atomic_state);
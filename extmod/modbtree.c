@@ -176,6 +176,30 @@ STATIC mp_obj_t btree_items(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(btree_items_obj, 1, 4, btree_items);
 
+// bulk_put(items): store an iterable of (key, value) pairs in one call,
+// avoiding the per-item method dispatch of a Python put() loop; most
+// effective when the items are already sorted by key.  Returns the number
+// of pairs stored.
+STATIC mp_obj_t btree_bulk_put(mp_obj_t self_in, mp_obj_t items_in) {
+    mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_iter_buf_t iter_buf;
+    mp_obj_t iter = mp_getiter(items_in, &iter_buf);
+    mp_obj_t item;
+    mp_int_t count = 0;
+    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+        mp_obj_t *elems;
+        mp_obj_get_array_fixed_n(item, 2, &elems);
+        DBT key, val;
+        key.data = (void *)mp_obj_str_get_data(elems[0], &key.size);
+        val.data = (void *)mp_obj_str_get_data(elems[1], &val.size);
+        int res = __bt_put(self->db, &key, &val, 0);
+        CHECK_ERROR(res);
+        ++count;
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(btree_bulk_put_obj, btree_bulk_put);
+
 STATIC mp_obj_t btree_getiter(mp_obj_t self_in, mp_obj_iter_buf_t *iter_buf) {
     (void)iter_buf;
     mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
@@ -199,6 +223,10 @@ STATIC mp_obj_t btree_iternext(mp_obj_t self_in) {
     DBT key, val;
     int res;
     bool desc = self->flags & FLAG_DESC;
+    if (self->end_key == MP_OBJ_NULL) {
+        // end_key was reached in a previous call
+        return MP_OBJ_STOP_ITERATION;
+    }
     if (self->start_key != MP_OBJ_NULL) {
         int flags = R_FIRST;
         if (self->start_key != mp_const_none) {
@@ -250,6 +278,33 @@ STATIC mp_obj_t btree_iternext(mp_obj_t self_in) {
     }
 }
 
+// batch(n): fetch up to n elements of the current iteration in one call,
+// returning them in a list (empty at the end of the range).  Use after
+// keys(), values() or items() to cut per-element VM dispatch when scanning
+// large ranges.
+STATIC mp_obj_t btree_batch(mp_obj_t self_in, mp_obj_t n_in) {
+    mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_int_t n = mp_obj_get_int(n_in);
+    if (self->next_flags != 0) {
+        // Adopt the setup from keys(), values() or items(), as getiter does.
+        self->flags = self->next_flags;
+        self->next_flags = 0;
+    }
+    mp_obj_t *items = m_new(mp_obj_t, n);
+    mp_int_t count = 0;
+    while (count < n) {
+        mp_obj_t elem = btree_iternext(self_in);
+        if (elem == MP_OBJ_STOP_ITERATION) {
+            break;
+        }
+        items[count++] = elem;
+    }
+    mp_obj_t list = mp_obj_new_list(count, items);
+    m_del(mp_obj_t, items, n);
+    return list;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(btree_batch_obj, btree_batch);
+
 STATIC mp_obj_t btree_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
     mp_obj_btree_t *self = MP_OBJ_TO_PTR(self_in);
     if (value == MP_OBJ_NULL) {
@@ -305,7 +360,9 @@ STATIC const mp_rom_map_elem_t btree_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&btree_flush_obj) },
     { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&btree_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_put), MP_ROM_PTR(&btree_put_obj) },
+    { MP_ROM_QSTR(MP_QSTR_bulk_put), MP_ROM_PTR(&btree_bulk_put_obj) },
     { MP_ROM_QSTR(MP_QSTR_seq), MP_ROM_PTR(&btree_seq_obj) },
+    { MP_ROM_QSTR(MP_QSTR_batch), MP_ROM_PTR(&btree_batch_obj) },
     { MP_ROM_QSTR(MP_QSTR_keys), MP_ROM_PTR(&btree_keys_obj) },
     { MP_ROM_QSTR(MP_QSTR_values), MP_ROM_PTR(&btree_values_obj) },
     { MP_ROM_QSTR(MP_QSTR_items), MP_ROM_PTR(&btree_items_obj) },
@@ -39,6 +39,10 @@ typedef struct _mp_obj_framebuf_t {
     void *buf;
     uint16_t width, height, stride;
     uint8_t format;
+    #if MICROPY_PY_FRAMEBUF_DIRTY
+    // accumulated dirty bounding box, empty when dirty_x1 <= dirty_x0
+    uint16_t dirty_x0, dirty_y0, dirty_x1, dirty_y1;
+    #endif
 } mp_obj_framebuf_t;
 
 #if !MICROPY_ENABLE_DYNRUNTIME
@@ -263,6 +267,33 @@ STATIC void fill_rect(const mp_obj_framebuf_t *fb, int x, int y, int w, int h, u
     formats[fb->format].fill_rect(fb, x, y, xend - x, yend - y, col);
 }
 
+#if MICROPY_PY_FRAMEBUF_DIRTY
+// Grow the dirty bounding box to cover the given rectangle, clipped to the
+// framebuffer.  Callers pass the unclipped rectangle of the drawing op.
+STATIC void dirty_mark(mp_obj_framebuf_t *fb, int x, int y, int w, int h) {
+    int xend = MIN(fb->width, x + w);
+    int yend = MIN(fb->height, y + h);
+    x = MAX(x, 0);
+    y = MAX(y, 0);
+    if (x >= xend || y >= yend) {
+        return;
+    }
+    if (fb->dirty_x1 <= fb->dirty_x0) {
+        fb->dirty_x0 = x;
+        fb->dirty_y0 = y;
+        fb->dirty_x1 = xend;
+        fb->dirty_y1 = yend;
+    } else {
+        fb->dirty_x0 = MIN(fb->dirty_x0, (uint16_t)x);
+        fb->dirty_y0 = MIN(fb->dirty_y0, (uint16_t)y);
+        fb->dirty_x1 = MAX(fb->dirty_x1, (uint16_t)xend);
+        fb->dirty_y1 = MAX(fb->dirty_y1, (uint16_t)yend);
+    }
+}
+#else
+#define dirty_mark(fb, x, y, w, h)
+#endif
+
 STATIC mp_obj_t framebuf_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 4, 5, false);
 
@@ -303,6 +334,11 @@ STATIC mp_obj_t framebuf_make_new(const mp_obj_type_t *type, size_t n_args, size
             mp_raise_ValueError(MP_ERROR_TEXT("invalid format"));
     }
 
+    #if MICROPY_PY_FRAMEBUF_DIRTY
+    o->dirty_x0 = o->dirty_x1 = 0;
+    o->dirty_y0 = o->dirty_y1 = 0;
+    #endif
+
     return MP_OBJ_FROM_PTR(o);
 }
 
@@ -319,6 +355,7 @@ STATIC mp_obj_t framebuf_fill(mp_obj_t self_in, mp_obj_t col_in) {
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
     mp_int_t col = mp_obj_get_int(col_in);
     formats[self->format].fill_rect(self, 0, 0, self->width, self->height, col);
+    dirty_mark(self, 0, 0, self->width, self->height);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(framebuf_fill_obj, framebuf_fill);
@@ -334,6 +371,7 @@ STATIC mp_obj_t framebuf_fill_rect(size_t n_args, const mp_obj_t *args) {
     mp_int_t col = mp_obj_get_int(args[5]);
 
     fill_rect(self, x, y, width, height, col);
+    dirty_mark(self, x, y, width, height);
 
     return mp_const_none;
 }
@@ -350,6 +388,7 @@ STATIC mp_obj_t framebuf_pixel(size_t n_args, const mp_obj_t *args) {
         } else {
             // set
             setpixel(self, x, y, mp_obj_get_int(args[3]));
+            dirty_mark(self, x, y, 1, 1);
         }
     }
     return mp_const_none;
@@ -366,6 +405,7 @@ STATIC mp_obj_t framebuf_hline(size_t n_args, const mp_obj_t *args) {
     mp_int_t col = mp_obj_get_int(args[4]);
 
     fill_rect(self, x, y, w, 1, col);
+    dirty_mark(self, x, y, w, 1);
 
     return mp_const_none;
 }
@@ -381,6 +421,7 @@ STATIC mp_obj_t framebuf_vline(size_t n_args, const mp_obj_t *args) {
     mp_int_t col = mp_obj_get_int(args[4]);
 
     fill_rect(self, x, y, 1, h, col);
+    dirty_mark(self, x, y, 1, h);
 
     return mp_const_none;
 }
@@ -400,20 +441,15 @@ STATIC mp_obj_t framebuf_rect(size_t n_args, const mp_obj_t *args) {
     fill_rect(self, x, y + h - 1, w, 1, col);
     fill_rect(self, x, y, 1, h, col);
     fill_rect(self, x + w - 1, y, 1, h, col);
+    dirty_mark(self, x, y, w, h);
 
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_rect_obj, 6, 6, framebuf_rect);
 
-STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
-    (void)n_args;
-
-    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(args[0]);
-    mp_int_t x1 = mp_obj_get_int(args[1]);
-    mp_int_t y1 = mp_obj_get_int(args[2]);
-    mp_int_t x2 = mp_obj_get_int(args[3]);
-    mp_int_t y2 = mp_obj_get_int(args[4]);
-    mp_int_t col = mp_obj_get_int(args[5]);
+STATIC void line_draw(mp_obj_framebuf_t *self, mp_int_t x1, mp_int_t y1, mp_int_t x2, mp_int_t y2, mp_int_t col) {
+    dirty_mark(self, MIN(x1, x2), MIN(y1, y2),
+        (x1 > x2 ? x1 - x2 : x2 - x1) + 1, (y1 > y2 ? y1 - y2 : y2 - y1) + 1);
 
     mp_int_t dx = x2 - x1;
     mp_int_t sx;
@@ -472,11 +508,233 @@ STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
     if (0 <= x2 && x2 < self->width && 0 <= y2 && y2 < self->height) {
         setpixel(self, x2, y2, col);
     }
+}
+
+STATIC mp_obj_t framebuf_line(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t x1 = mp_obj_get_int(args[1]);
+    mp_int_t y1 = mp_obj_get_int(args[2]);
+    mp_int_t x2 = mp_obj_get_int(args[3]);
+    mp_int_t y2 = mp_obj_get_int(args[4]);
+    mp_int_t col = mp_obj_get_int(args[5]);
+
+    line_draw(self, x1, y1, x2, y2, col);
 
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_line_obj, 6, 6, framebuf_line);
 
+// Batch drawing primitives.  Coordinates are passed as a buffer of signed
+// 16-bit integers (eg array('h', ...)), so one call rasterizes many
+// primitives without per-segment Python call overhead.
+
+STATIC size_t poly_get_coords(mp_obj_t coords_in, size_t per_item, const int16_t **coords) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(coords_in, &bufinfo, MP_BUFFER_READ);
+    if (bufinfo.typecode != 'h') {
+        mp_raise_ValueError(MP_ERROR_TEXT("coords must be a 16-bit int array"));
+    }
+    *coords = bufinfo.buf;
+    return bufinfo.len / (per_item * sizeof(int16_t));
+}
+
+STATIC mp_obj_t framebuf_polyline(mp_obj_t self_in, mp_obj_t coords_in, mp_obj_t col_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    const int16_t *v;
+    size_t n = poly_get_coords(coords_in, 2, &v);
+    mp_int_t col = mp_obj_get_int(col_in);
+    for (size_t i = 1; i < n; ++i) {
+        line_draw(self, v[2 * i - 2], v[2 * i - 1], v[2 * i], v[2 * i + 1], col);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_polyline_obj, framebuf_polyline);
+
+STATIC mp_obj_t framebuf_fill_poly(mp_obj_t self_in, mp_obj_t coords_in, mp_obj_t col_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    const int16_t *v;
+    size_t n = poly_get_coords(coords_in, 2, &v);
+    mp_int_t col = mp_obj_get_int(col_in);
+    if (n < 3) {
+        return mp_const_none;
+    }
+
+    int ymin = v[1], ymax = v[1];
+    for (size_t i = 1; i < n; ++i) {
+        ymin = MIN(ymin, v[2 * i + 1]);
+        ymax = MAX(ymax, v[2 * i + 1]);
+    }
+    ymin = MAX(ymin, 0);
+    ymax = MIN(ymax, self->height - 1);
+
+    // even-odd scanline fill; the polygon is closed automatically
+    int *nodes = m_new(int, n);
+    for (int y = ymin; y <= ymax; ++y) {
+        size_t n_nodes = 0;
+        for (size_t i = 0; i < n; ++i) {
+            int x1 = v[2 * i], y1 = v[2 * i + 1];
+            size_t j = (i + 1 == n) ? 0 : i + 1;
+            int x2 = v[2 * j], y2 = v[2 * j + 1];
+            if ((y1 <= y && y < y2) || (y2 <= y && y < y1)) {
+                nodes[n_nodes++] = x1 + (y - y1) * (x2 - x1) / (y2 - y1);
+            }
+        }
+        // insertion sort, the edge count per scanline is small
+        for (size_t i = 1; i < n_nodes; ++i) {
+            int x = nodes[i];
+            size_t j = i;
+            for (; j > 0 && nodes[j - 1] > x; --j) {
+                nodes[j] = nodes[j - 1];
+            }
+            nodes[j] = x;
+        }
+        for (size_t i = 0; i + 1 < n_nodes; i += 2) {
+            fill_rect(self, nodes[i], y, nodes[i + 1] - nodes[i] + 1, 1, col);
+        }
+    }
+    m_del(int, nodes, n);
+
+    int xmin = v[0], xmax = v[0];
+    for (size_t i = 1; i < n; ++i) {
+        xmin = MIN(xmin, v[2 * i]);
+        xmax = MAX(xmax, v[2 * i]);
+    }
+    dirty_mark(self, xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_fill_poly_obj, framebuf_fill_poly);
+
+STATIC mp_obj_t framebuf_hlines(mp_obj_t self_in, mp_obj_t coords_in, mp_obj_t col_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    const int16_t *v;
+    size_t n = poly_get_coords(coords_in, 3, &v);
+    mp_int_t col = mp_obj_get_int(col_in);
+    for (size_t i = 0; i < n; ++i, v += 3) {
+        fill_rect(self, v[0], v[1], v[2], 1, col);
+        dirty_mark(self, v[0], v[1], v[2], 1);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_hlines_obj, framebuf_hlines);
+
+STATIC mp_obj_t framebuf_vlines(mp_obj_t self_in, mp_obj_t coords_in, mp_obj_t col_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    const int16_t *v;
+    size_t n = poly_get_coords(coords_in, 3, &v);
+    mp_int_t col = mp_obj_get_int(col_in);
+    for (size_t i = 0; i < n; ++i, v += 3) {
+        fill_rect(self, v[0], v[1], 1, v[2], col);
+        dirty_mark(self, v[0], v[1], 1, v[2]);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_vlines_obj, framebuf_vlines);
+
+// Row-wise blit kernels.  A kernel is selected once per blit based on the
+// (dest, source) format pair, so the inner loop avoids the per-pixel
+// indirect getpixel/setpixel calls of the generic path.
+
+typedef void (*blit_row_t)(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key);
+
+STATIC void blit_row_generic(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    while (w--) {
+        uint32_t col = getpixel(src, sx++, sy);
+        if (col != key) {
+            setpixel(dest, dx, dy, col);
+        }
+        ++dx;
+    }
+}
+
+STATIC void blit_row_mvlsb_to_rgb565(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    const uint8_t *s = &((const uint8_t *)src->buf)[(sy >> 3) * src->stride + sx];
+    unsigned int shift = sy & 0x07;
+    uint16_t *d = &((uint16_t *)dest->buf)[dx + dy * dest->stride];
+    while (w--) {
+        uint32_t col = (*s++ >> shift) & 0x01;
+        if (col != key) {
+            *d = col;
+        }
+        ++d;
+    }
+}
+
+STATIC void blit_row_gs8_to_rgb565(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    const uint8_t *s = &((const uint8_t *)src->buf)[sx + sy * src->stride];
+    uint16_t *d = &((uint16_t *)dest->buf)[dx + dy * dest->stride];
+    while (w--) {
+        uint32_t col = *s++;
+        if (col != key) {
+            *d = col;
+        }
+        ++d;
+    }
+}
+
+STATIC void blit_row_rgb565_key(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    const uint16_t *s = &((const uint16_t *)src->buf)[sx + sy * src->stride];
+    uint16_t *d = &((uint16_t *)dest->buf)[dx + dy * dest->stride];
+    while (w--) {
+        uint32_t col = *s++;
+        if (col != key) {
+            *d = col;
+        }
+        ++d;
+    }
+}
+
+STATIC void blit_row_rgb565_copy(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    (void)key;
+    memcpy(&((uint16_t *)dest->buf)[dx + dy * dest->stride],
+        &((const uint16_t *)src->buf)[sx + sy * src->stride], w * 2);
+}
+
+STATIC void blit_row_gs8_key(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    const uint8_t *s = &((const uint8_t *)src->buf)[sx + sy * src->stride];
+    uint8_t *d = &((uint8_t *)dest->buf)[dx + dy * dest->stride];
+    while (w--) {
+        uint32_t col = *s++;
+        if (col != key) {
+            *d = col;
+        }
+        ++d;
+    }
+}
+
+STATIC void blit_row_gs8_copy(const mp_obj_framebuf_t *dest, unsigned int dx, unsigned int dy,
+    const mp_obj_framebuf_t *src, unsigned int sx, unsigned int sy, unsigned int w, uint32_t key) {
+    (void)key;
+    memcpy(&((uint8_t *)dest->buf)[dx + dy * dest->stride],
+        &((const uint8_t *)src->buf)[sx + sy * src->stride], w);
+}
+
+STATIC blit_row_t blit_select_row_kernel(const mp_obj_framebuf_t *dest, const mp_obj_framebuf_t *src, uint32_t key) {
+    if (dest->format == FRAMEBUF_RGB565) {
+        if (src->format == FRAMEBUF_MVLSB) {
+            return blit_row_mvlsb_to_rgb565;
+        }
+        if (src->format == FRAMEBUF_GS8) {
+            return blit_row_gs8_to_rgb565;
+        }
+        if (src->format == FRAMEBUF_RGB565) {
+            // RGB565 pixels are at most 0xffff so a larger key never matches.
+            return key > 0xffff ? blit_row_rgb565_copy : blit_row_rgb565_key;
+        }
+    } else if (dest->format == FRAMEBUF_GS8 && src->format == FRAMEBUF_GS8) {
+        return key > 0xff ? blit_row_gs8_copy : blit_row_gs8_key;
+    }
+    return blit_row_generic;
+}
+
 STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(args[0]);
     mp_obj_t source_in = mp_obj_cast_to_native_base(args[1], MP_OBJ_FROM_PTR(&mp_type_framebuf));
@@ -510,20 +768,91 @@ STATIC mp_obj_t framebuf_blit(size_t n_args, const mp_obj_t *args) {
     int x0end = MIN(self->width, x + source->width);
     int y0end = MIN(self->height, y + source->height);
 
-    for (; y0 < y0end; ++y0) {
-        int cx1 = x1;
-        for (int cx0 = x0; cx0 < x0end; ++cx0) {
-            uint32_t col = getpixel(source, cx1, y1);
-            if (col != (uint32_t)key) {
-                setpixel(self, cx0, y0, col);
+    dirty_mark(self, x0, y0, x0end - x0, y0end - y0);
+
+    blit_row_t blit_row = blit_select_row_kernel(self, source, (uint32_t)key);
+    for (; y0 < y0end; ++y0, ++y1) {
+        blit_row(self, x0, y0, source, x1, y1, x0end - x0, (uint32_t)key);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_blit_obj, 4, 5, framebuf_blit);
+
+// blit_scaled(src, x, y, scale[, key[, rot]])
+// Draw src enlarged by an integer factor and rotated by rot * 90 degrees
+// clockwise.  Each source pixel is read once and expanded to a scale x scale
+// block through the destination's fill_rect routine, which also clips.
+STATIC mp_obj_t framebuf_blit_scaled(size_t n_args, const mp_obj_t *args) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_obj_t source_in = mp_obj_cast_to_native_base(args[1], MP_OBJ_FROM_PTR(&mp_type_framebuf));
+    if (source_in == MP_OBJ_NULL) {
+        mp_raise_TypeError(NULL);
+    }
+    mp_obj_framebuf_t *source = MP_OBJ_TO_PTR(source_in);
+
+    mp_int_t x = mp_obj_get_int(args[2]);
+    mp_int_t y = mp_obj_get_int(args[3]);
+    mp_int_t scale = mp_obj_get_int(args[4]);
+    if (scale < 1) {
+        mp_raise_ValueError(MP_ERROR_TEXT("scale"));
+    }
+    mp_int_t key = -1;
+    if (n_args > 5) {
+        key = mp_obj_get_int(args[5]);
+    }
+    mp_int_t rot = 0;
+    if (n_args > 6) {
+        rot = mp_obj_get_int(args[6]) & 3;
+    }
+
+    fill_rect_t fr = formats[self->format].fill_rect;
+    for (int sy = 0; sy < source->height; ++sy) {
+        for (int sx = 0; sx < source->width; ++sx) {
+            uint32_t col = getpixel(source, sx, sy);
+            if (col == (uint32_t)key) {
+                continue;
+            }
+            int dx, dy;
+            switch (rot) {
+                default:
+                case 0:
+                    dx = sx;
+                    dy = sy;
+                    break;
+                case 1:
+                    dx = source->height - 1 - sy;
+                    dy = sx;
+                    break;
+                case 2:
+                    dx = source->width - 1 - sx;
+                    dy = source->height - 1 - sy;
+                    break;
+                case 3:
+                    dx = sy;
+                    dy = source->width - 1 - sx;
+                    break;
             }
-            ++cx1;
+            dx = x + dx * scale;
+            dy = y + dy * scale;
+            if (dx + scale <= 0 || dy + scale <= 0 || dx >= self->width || dy >= self->height) {
+                continue;
+            }
+            int xend = MIN(self->width, dx + scale);
+            int yend = MIN(self->height, dy + scale);
+            dx = MAX(dx, 0);
+            dy = MAX(dy, 0);
+            fr(self, dx, dy, xend - dx, yend - dy, col);
         }
-        ++y1;
+    }
+
+    if (rot & 1) {
+        dirty_mark(self, x, y, source->height * scale, source->width * scale);
+    } else {
+        dirty_mark(self, x, y, source->width * scale, source->height * scale);
     }
     return mp_const_none;
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_blit_obj, 4, 5, framebuf_blit);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_blit_scaled_obj, 5, 7, framebuf_blit_scaled);
 
 STATIC mp_obj_t framebuf_scroll(mp_obj_t self_in, mp_obj_t xstep_in, mp_obj_t ystep_in) {
     mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
@@ -553,6 +882,7 @@ STATIC mp_obj_t framebuf_scroll(mp_obj_t self_in, mp_obj_t xstep_in, mp_obj_t ys
             setpixel(self, x, y, getpixel(self, x - xstep, y - ystep));
         }
     }
+    dirty_mark(self, 0, 0, self->width, self->height);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(framebuf_scroll_obj, framebuf_scroll);
@@ -568,6 +898,8 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
         col = mp_obj_get_int(args[4]);
     }
 
+    dirty_mark(self, x0, y0, 8 * (mp_int_t)strlen(str), 8);
+
     // loop over chars
     for (; *str; ++str) {
         // get char and make sure its in range of font
@@ -581,6 +913,27 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
         for (int j = 0; j < 8; j++, x0++) {
             if (0 <= x0 && x0 < self->width) { // clip x
                 uint vline_data = chr_data[j]; // each byte is a column of 8 pixels, LSB at top
+                if (self->format == FRAMEBUF_MVLSB && 0 <= y0 && y0 + 8 <= self->height) {
+                    // fully visible column in MVLSB: the glyph column has the same
+                    // layout as the destination, so write it with two byte ops
+                    uint8_t *b = &((uint8_t *)self->buf)[(y0 >> 3) * self->stride + x0];
+                    unsigned int shift = y0 & 0x07;
+                    unsigned int bits = vline_data << shift;
+                    if (col != 0) {
+                        b[0] |= bits;
+                    } else {
+                        b[0] &= ~bits;
+                    }
+                    if (shift) {
+                        b += self->stride;
+                        if (col != 0) {
+                            b[0] |= bits >> 8;
+                        } else {
+                            b[0] &= ~(bits >> 8);
+                        }
+                    }
+                    continue;
+                }
                 for (int y = y0; vline_data; vline_data >>= 1, y++) { // scan over vertical column
                     if (vline_data & 1) { // only draw if pixel set
                         if (0 <= y && y < self->height) { // clip y
@@ -595,6 +948,31 @@ STATIC mp_obj_t framebuf_text(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(framebuf_text_obj, 4, 5, framebuf_text);
 
+#if MICROPY_PY_FRAMEBUF_DIRTY
+STATIC mp_obj_t framebuf_get_dirty(mp_obj_t self_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->dirty_x1 <= self->dirty_x0) {
+        return mp_const_none;
+    }
+    mp_obj_t tuple[4] = {
+        MP_OBJ_NEW_SMALL_INT(self->dirty_x0),
+        MP_OBJ_NEW_SMALL_INT(self->dirty_y0),
+        MP_OBJ_NEW_SMALL_INT(self->dirty_x1 - self->dirty_x0),
+        MP_OBJ_NEW_SMALL_INT(self->dirty_y1 - self->dirty_y0),
+    };
+    return mp_obj_new_tuple(4, tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(framebuf_get_dirty_obj, framebuf_get_dirty);
+
+STATIC mp_obj_t framebuf_clear_dirty(mp_obj_t self_in) {
+    mp_obj_framebuf_t *self = MP_OBJ_TO_PTR(self_in);
+    self->dirty_x0 = self->dirty_x1 = 0;
+    self->dirty_y0 = self->dirty_y1 = 0;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(framebuf_clear_dirty_obj, framebuf_clear_dirty);
+#endif
+
 #if !MICROPY_ENABLE_DYNRUNTIME
 STATIC const mp_rom_map_elem_t framebuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&framebuf_fill_obj) },
@@ -604,9 +982,18 @@ STATIC const mp_rom_map_elem_t framebuf_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_vline), MP_ROM_PTR(&framebuf_vline_obj) },
     { MP_ROM_QSTR(MP_QSTR_rect), MP_ROM_PTR(&framebuf_rect_obj) },
     { MP_ROM_QSTR(MP_QSTR_line), MP_ROM_PTR(&framebuf_line_obj) },
+    { MP_ROM_QSTR(MP_QSTR_polyline), MP_ROM_PTR(&framebuf_polyline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill_poly), MP_ROM_PTR(&framebuf_fill_poly_obj) },
+    { MP_ROM_QSTR(MP_QSTR_hlines), MP_ROM_PTR(&framebuf_hlines_obj) },
+    { MP_ROM_QSTR(MP_QSTR_vlines), MP_ROM_PTR(&framebuf_vlines_obj) },
     { MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&framebuf_blit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blit_scaled), MP_ROM_PTR(&framebuf_blit_scaled_obj) },
     { MP_ROM_QSTR(MP_QSTR_scroll), MP_ROM_PTR(&framebuf_scroll_obj) },
     { MP_ROM_QSTR(MP_QSTR_text), MP_ROM_PTR(&framebuf_text_obj) },
+    #if MICROPY_PY_FRAMEBUF_DIRTY
+    { MP_ROM_QSTR(MP_QSTR_get_dirty), MP_ROM_PTR(&framebuf_get_dirty_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear_dirty), MP_ROM_PTR(&framebuf_clear_dirty_obj) },
+    #endif
 };
 STATIC MP_DEFINE_CONST_DICT(framebuf_locals_dict, framebuf_locals_dict_table);
 
@@ -637,6 +1024,11 @@ STATIC mp_obj_t legacy_framebuffer1(size_t n_args, const mp_obj_t *args) {
         o->stride = o->width;
     }
 
+    #if MICROPY_PY_FRAMEBUF_DIRTY
+    o->dirty_x0 = o->dirty_x1 = 0;
+    o->dirty_y0 = o->dirty_y1 = 0;
+    #endif
+
     return MP_OBJ_FROM_PTR(o);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(legacy_framebuffer1_obj, 3, 4, legacy_framebuffer1);
@@ -65,6 +65,14 @@
 // because we ignore option levels for efficiency.
 #define IP_ADD_MEMBERSHIP 0x400
 
+// TCP-level and further socket-level options, also made globally distinct
+// (lwip/sockets.h, where the POSIX values would come from, isn't used here).
+#define MOD_LWIP_TCP_NODELAY (0x801)
+#define MOD_LWIP_TCP_KEEPIDLE (0x802)
+#define MOD_LWIP_TCP_KEEPINTVL (0x803)
+#define MOD_LWIP_TCP_KEEPCNT (0x804)
+#define MOD_LWIP_SO_RCVBUF (0x805)
+
 // For compatibilily with older lwIP versions.
 #ifndef ip_set_option
 #define ip_set_option(pcb, opt)   ((pcb)->so_options |= (opt))
@@ -984,14 +992,14 @@ STATIC mp_obj_t lwip_socket_accept(mp_obj_t self_in) {
             m_del_obj(lwip_socket_obj_t, socket2);
             mp_raise_OSError(MP_EAGAIN);
         } else if (socket->timeout != -1) {
-            mp_uint_t retries = socket->timeout / 100;
+            mp_uint_t start = mp_hal_ticks_ms();
             while (*incoming_connection == NULL) {
                 MICROPY_PY_LWIP_EXIT
-                if (retries-- == 0) {
+                if (mp_hal_ticks_ms() - start > socket->timeout) {
                     m_del_obj(lwip_socket_obj_t, socket2);
                     mp_raise_OSError(MP_ETIMEDOUT);
                 }
-                mp_hal_delay_ms(100);
+                poll_sockets();
                 MICROPY_PY_LWIP_REENTER
             }
         } else {
@@ -1078,18 +1086,18 @@ STATIC mp_obj_t lwip_socket_connect(mp_obj_t self_in, mp_obj_t addr_in) {
             MICROPY_PY_LWIP_EXIT
 
             // And now we wait...
-            if (socket->timeout != -1) {
-                for (mp_uint_t retries = socket->timeout / 100; retries--;) {
-                    mp_hal_delay_ms(100);
-                    if (socket->state != STATE_CONNECTING) {
-                        break;
-                    }
-                }
+            if (socket->timeout == 0) {
+                // Non-blocking connect: completion is signalled through
+                // poll/ioctl when _lwip_tcp_connected fires.
                 if (socket->state == STATE_CONNECTING) {
                     mp_raise_OSError(MP_EINPROGRESS);
                 }
             } else {
+                mp_uint_t start = mp_hal_ticks_ms();
                 while (socket->state == STATE_CONNECTING) {
+                    if (socket->timeout != -1 && mp_hal_ticks_ms() - start > socket->timeout) {
+                        mp_raise_OSError(MP_EINPROGRESS);
+                    }
                     poll_sockets();
                 }
             }
@@ -1194,6 +1202,38 @@ STATIC mp_obj_t lwip_socket_recv(mp_obj_t self_in, mp_obj_t len_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(lwip_socket_recv_obj, lwip_socket_recv);
 
+// Like recv() but reads into a caller-supplied buffer, so the data is copied
+// straight out of the incoming pbuf without an intermediate bytes object.
+STATIC mp_obj_t lwip_socket_recv_into(mp_obj_t self_in, mp_obj_t buf_in) {
+    lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(self_in);
+    int _errno;
+
+    lwip_socket_check_connected(socket);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+
+    mp_uint_t ret = 0;
+    switch (socket->type) {
+        case MOD_NETWORK_SOCK_STREAM: {
+            ret = lwip_tcp_receive(socket, bufinfo.buf, bufinfo.len, &_errno);
+            break;
+        }
+        case MOD_NETWORK_SOCK_DGRAM:
+        #if MICROPY_PY_LWIP_SOCK_RAW
+        case MOD_NETWORK_SOCK_RAW:
+        #endif
+            ret = lwip_raw_udp_receive(socket, bufinfo.buf, bufinfo.len, NULL, NULL, &_errno);
+            break;
+    }
+    if (ret == -1) {
+        mp_raise_OSError(_errno);
+    }
+
+    return mp_obj_new_int_from_uint(ret);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(lwip_socket_recv_into_obj, lwip_socket_recv_into);
+
 STATIC mp_obj_t lwip_socket_sendto(mp_obj_t self_in, mp_obj_t data_in, mp_obj_t addr_in) {
     lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(self_in);
     int _errno;
@@ -1357,13 +1397,62 @@ STATIC mp_obj_t lwip_socket_setsockopt(size_t n_args, const mp_obj_t *args) {
 
     switch (opt) {
         // level: SOL_SOCKET
-        case SOF_REUSEADDR: {
+        case SOF_REUSEADDR:
+        case SOF_KEEPALIVE: {
             mp_int_t val = mp_obj_get_int(args[3]);
             // Options are common for UDP and TCP pcb's.
             if (val) {
-                ip_set_option(socket->pcb.tcp, SOF_REUSEADDR);
+                ip_set_option(socket->pcb.tcp, opt);
             } else {
-                ip_reset_option(socket->pcb.tcp, SOF_REUSEADDR);
+                ip_reset_option(socket->pcb.tcp, opt);
+            }
+            break;
+        }
+
+        // level: IPPROTO_TCP (plus SO_RCVBUF, which also only makes sense
+        // for TCP here: it sizes the pcb's receive window)
+        case MOD_LWIP_TCP_NODELAY:
+        case MOD_LWIP_TCP_KEEPIDLE:
+        #if LWIP_TCP_KEEPALIVE
+        case MOD_LWIP_TCP_KEEPINTVL:
+        case MOD_LWIP_TCP_KEEPCNT:
+        #endif
+        case MOD_LWIP_SO_RCVBUF: {
+            mp_int_t val = mp_obj_get_int(args[3]);
+            if (socket->type != MOD_NETWORK_SOCK_STREAM || socket->pcb.tcp == NULL) {
+                mp_raise_OSError(MP_EINVAL);
+            }
+            struct tcp_pcb *pcb = socket->pcb.tcp;
+            switch (opt) {
+                case MOD_LWIP_TCP_NODELAY:
+                    // disabling Nagle avoids the classic interaction with the
+                    // peer's delayed ACK on small request/response traffic
+                    if (val) {
+                        tcp_nagle_disable(pcb);
+                    } else {
+                        tcp_nagle_enable(pcb);
+                    }
+                    break;
+                case MOD_LWIP_TCP_KEEPIDLE:
+                    pcb->keep_idle = val * 1000; // value in seconds
+                    break;
+                #if LWIP_TCP_KEEPALIVE
+                case MOD_LWIP_TCP_KEEPINTVL:
+                    pcb->keep_intvl = val * 1000; // value in seconds
+                    break;
+                case MOD_LWIP_TCP_KEEPCNT:
+                    pcb->keep_cnt = val;
+                    break;
+                #endif
+                case MOD_LWIP_SO_RCVBUF:
+                    // The window can only be kept at or below the compile-time
+                    // TCP_WND that lwIP's buffers are provisioned for.
+                    if (val < 1 || val > TCP_WND) {
+                        mp_raise_OSError(MP_EINVAL);
+                    }
+                    pcb->rcv_wnd = val;
+                    pcb->rcv_ann_wnd = val;
+                    break;
             }
             break;
         }
@@ -1391,6 +1480,33 @@ STATIC mp_obj_t lwip_socket_setsockopt(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(lwip_socket_setsockopt_obj, 4, 4, lwip_socket_setsockopt);
 
+// Return the low-level state of a TCP connection for diagnosis, as the tuple
+// (state, nrtx, rto, cwnd, ssthresh, snd_wnd, rcv_wnd).  For a listening
+// socket only (state,) is returned, as listen pcb's are a truncated struct
+// without the remaining fields.
+STATIC mp_obj_t lwip_socket_stats(mp_obj_t self_in) {
+    lwip_socket_obj_t *socket = MP_OBJ_TO_PTR(self_in);
+    if (socket->type != MOD_NETWORK_SOCK_STREAM || socket->pcb.tcp == NULL) {
+        mp_raise_OSError(MP_EINVAL);
+    }
+    struct tcp_pcb *pcb = socket->pcb.tcp;
+    if (pcb->state == LISTEN) {
+        mp_obj_t state = MP_OBJ_NEW_SMALL_INT(pcb->state);
+        return mp_obj_new_tuple(1, &state);
+    }
+    mp_obj_t tuple[7] = {
+        MP_OBJ_NEW_SMALL_INT(pcb->state),
+        MP_OBJ_NEW_SMALL_INT(pcb->nrtx),
+        MP_OBJ_NEW_SMALL_INT(pcb->rto),
+        MP_OBJ_NEW_SMALL_INT(pcb->cwnd),
+        MP_OBJ_NEW_SMALL_INT(pcb->ssthresh),
+        MP_OBJ_NEW_SMALL_INT(pcb->snd_wnd),
+        MP_OBJ_NEW_SMALL_INT(pcb->rcv_wnd),
+    };
+    return mp_obj_new_tuple(7, tuple);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(lwip_socket_stats_obj, lwip_socket_stats);
+
 STATIC mp_obj_t lwip_socket_makefile(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
     return args[0];
@@ -1469,9 +1585,12 @@ STATIC mp_uint_t lwip_socket_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_
                 // raw socket is writable
                 ret |= MP_STREAM_POLL_WR;
             #endif
-            } else if (socket->pcb.tcp != NULL && tcp_sndbuf(socket->pcb.tcp) > 0) {
-                // TCP socket is writable
-                // Note: pcb.tcp==NULL if state<0, and in this case we can't call tcp_sndbuf
+            } else if (socket->state != STATE_CONNECTING
+                       && socket->pcb.tcp != NULL && tcp_sndbuf(socket->pcb.tcp) > 0) {
+                // TCP socket is writable, but only once the connection is
+                // established; this lets a non-blocking connect be awaited
+                // with poll, waking when _lwip_tcp_connected (or an error
+                // callback) fires instead of reporting a false writable.
                 ret |= MP_STREAM_POLL_WR;
             }
         }
@@ -1557,12 +1676,14 @@ STATIC const mp_rom_map_elem_t lwip_socket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_connect), MP_ROM_PTR(&lwip_socket_connect_obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&lwip_socket_send_obj) },
     { MP_ROM_QSTR(MP_QSTR_recv), MP_ROM_PTR(&lwip_socket_recv_obj) },
+    { MP_ROM_QSTR(MP_QSTR_recv_into), MP_ROM_PTR(&lwip_socket_recv_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendto), MP_ROM_PTR(&lwip_socket_sendto_obj) },
     { MP_ROM_QSTR(MP_QSTR_recvfrom), MP_ROM_PTR(&lwip_socket_recvfrom_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendall), MP_ROM_PTR(&lwip_socket_sendall_obj) },
     { MP_ROM_QSTR(MP_QSTR_settimeout), MP_ROM_PTR(&lwip_socket_settimeout_obj) },
     { MP_ROM_QSTR(MP_QSTR_setblocking), MP_ROM_PTR(&lwip_socket_setblocking_obj) },
     { MP_ROM_QSTR(MP_QSTR_setsockopt), MP_ROM_PTR(&lwip_socket_setsockopt_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&lwip_socket_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_makefile), MP_ROM_PTR(&lwip_socket_makefile_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
@@ -1759,9 +1880,19 @@ STATIC const mp_rom_map_elem_t mp_module_lwip_globals_table[] = {
 
     { MP_ROM_QSTR(MP_QSTR_SOL_SOCKET), MP_ROM_INT(1) },
     { MP_ROM_QSTR(MP_QSTR_SO_REUSEADDR), MP_ROM_INT(SOF_REUSEADDR) },
+    { MP_ROM_QSTR(MP_QSTR_SO_KEEPALIVE), MP_ROM_INT(SOF_KEEPALIVE) },
+    { MP_ROM_QSTR(MP_QSTR_SO_RCVBUF), MP_ROM_INT(MOD_LWIP_SO_RCVBUF) },
 
     { MP_ROM_QSTR(MP_QSTR_IPPROTO_IP), MP_ROM_INT(0) },
     { MP_ROM_QSTR(MP_QSTR_IP_ADD_MEMBERSHIP), MP_ROM_INT(IP_ADD_MEMBERSHIP) },
+
+    { MP_ROM_QSTR(MP_QSTR_IPPROTO_TCP), MP_ROM_INT(6) },
+    { MP_ROM_QSTR(MP_QSTR_TCP_NODELAY), MP_ROM_INT(MOD_LWIP_TCP_NODELAY) },
+    { MP_ROM_QSTR(MP_QSTR_TCP_KEEPIDLE), MP_ROM_INT(MOD_LWIP_TCP_KEEPIDLE) },
+    #if LWIP_TCP_KEEPALIVE
+    { MP_ROM_QSTR(MP_QSTR_TCP_KEEPINTVL), MP_ROM_INT(MOD_LWIP_TCP_KEEPINTVL) },
+    { MP_ROM_QSTR(MP_QSTR_TCP_KEEPCNT), MP_ROM_INT(MOD_LWIP_TCP_KEEPCNT) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_lwip_globals, mp_module_lwip_globals_table);
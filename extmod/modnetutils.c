@@ -0,0 +1,90 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/runtime.h"
+
+#if MICROPY_PY_NETUTILS
+
+#include "shared/netutils/netutils.h"
+
+// Address family constants, with the usual values from the socket module.
+#define MOD_NETUTILS_AF_INET (2)
+#define MOD_NETUTILS_AF_INET6 (10)
+
+STATIC mp_obj_t mod_netutils_inet_pton(mp_obj_t family_in, mp_obj_t addr_in) {
+    mp_int_t family = mp_obj_get_int(family_in);
+    uint8_t ip[NETUTILS_IPV6ADDR_BUFSIZE];
+    if (family == MOD_NETUTILS_AF_INET) {
+        netutils_parse_ipv4_addr(addr_in, ip, NETUTILS_BIG);
+        return mp_obj_new_bytes(ip, NETUTILS_IPV4ADDR_BUFSIZE);
+    } else if (family == MOD_NETUTILS_AF_INET6) {
+        netutils_parse_ipv6_addr(addr_in, ip);
+        return mp_obj_new_bytes(ip, NETUTILS_IPV6ADDR_BUFSIZE);
+    } else {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid arguments"));
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_netutils_inet_pton_obj, mod_netutils_inet_pton);
+
+STATIC mp_obj_t mod_netutils_inet_ntop(mp_obj_t family_in, mp_obj_t packed_in) {
+    mp_int_t family = mp_obj_get_int(family_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(packed_in, &bufinfo, MP_BUFFER_READ);
+    if (family == MOD_NETUTILS_AF_INET && bufinfo.len == NETUTILS_IPV4ADDR_BUFSIZE) {
+        return netutils_format_ipv4_addr(bufinfo.buf, NETUTILS_BIG);
+    } else if (family == MOD_NETUTILS_AF_INET6 && bufinfo.len == NETUTILS_IPV6ADDR_BUFSIZE) {
+        return netutils_format_ipv6_addr(bufinfo.buf);
+    } else {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid arguments"));
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_netutils_inet_ntop_obj, mod_netutils_inet_ntop);
+
+// Returns the RFC 1071 Internet checksum of the buffer, as a number whose
+// high byte is the first byte to go on the wire.
+STATIC mp_obj_t mod_netutils_checksum(mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    return MP_OBJ_NEW_SMALL_INT(netutils_checksum(bufinfo.buf, bufinfo.len));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_netutils_checksum_obj, mod_netutils_checksum);
+
+STATIC const mp_rom_map_elem_t mp_module_netutils_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_netutils) },
+    { MP_ROM_QSTR(MP_QSTR_inet_pton), MP_ROM_PTR(&mod_netutils_inet_pton_obj) },
+    { MP_ROM_QSTR(MP_QSTR_inet_ntop), MP_ROM_PTR(&mod_netutils_inet_ntop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_checksum), MP_ROM_PTR(&mod_netutils_checksum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_AF_INET), MP_ROM_INT(MOD_NETUTILS_AF_INET) },
+    { MP_ROM_QSTR(MP_QSTR_AF_INET6), MP_ROM_INT(MOD_NETUTILS_AF_INET6) },
+};
+STATIC MP_DEFINE_CONST_DICT(mp_module_netutils_globals, mp_module_netutils_globals_table);
+
+const mp_obj_module_t mp_module_netutils = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&mp_module_netutils_globals,
+};
+
+#endif // MICROPY_PY_NETUTILS
@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "py/runtime.h"
 #include "py/mphal.h"
 
 /******************************************************************************/
@@ -43,6 +44,25 @@
 #define TIMING_WRITE2 (50)
 #define TIMING_WRITE3 (10)
 
+#if MICROPY_PY_ONEWIRE_PORT_IMPL
+
+// The port provides the timing-critical bus primitives, typically driven by
+// a timer or RMT-style peripheral so the CPU isn't busy-waiting with IRQs
+// disabled for every bit.  They must produce the waveforms described by the
+// TIMING_* values above.  The buffer forms let a backend run whole bytes
+// back-to-back in hardware.
+int mp_hal_onewire_reset(mp_hal_pin_obj_t pin);
+int mp_hal_onewire_readbit(mp_hal_pin_obj_t pin);
+void mp_hal_onewire_writebit(mp_hal_pin_obj_t pin, int value);
+void mp_hal_onewire_readinto(mp_hal_pin_obj_t pin, uint8_t *buf, size_t len);
+void mp_hal_onewire_write(mp_hal_pin_obj_t pin, const uint8_t *buf, size_t len);
+
+#define onewire_bus_reset mp_hal_onewire_reset
+#define onewire_bus_readbit mp_hal_onewire_readbit
+#define onewire_bus_writebit mp_hal_onewire_writebit
+
+#else
+
 STATIC int onewire_bus_reset(mp_hal_pin_obj_t pin) {
     mp_hal_pin_od_low(pin);
     mp_hal_delay_us(TIMING_RESET1);
@@ -81,6 +101,39 @@ STATIC void onewire_bus_writebit(mp_hal_pin_obj_t pin, int value) {
     mp_hal_quiet_timing_exit(i);
 }
 
+#endif // MICROPY_PY_ONEWIRE_PORT_IMPL
+
+// Whole-buffer transfers: one call from Python per transaction rather than
+// one per bit, and the point where a hardware backend batches bytes.
+
+STATIC void onewire_bus_readinto(mp_hal_pin_obj_t pin, uint8_t *buf, size_t len) {
+    #if MICROPY_PY_ONEWIRE_PORT_IMPL
+    mp_hal_onewire_readinto(pin, buf, len);
+    #else
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t value = 0;
+        for (int b = 0; b < 8; ++b) {
+            value |= onewire_bus_readbit(pin) << b;
+        }
+        buf[i] = value;
+    }
+    #endif
+}
+
+STATIC void onewire_bus_write(mp_hal_pin_obj_t pin, const uint8_t *buf, size_t len) {
+    #if MICROPY_PY_ONEWIRE_PORT_IMPL
+    mp_hal_onewire_write(pin, buf, len);
+    #else
+    for (size_t i = 0; i < len; ++i) {
+        int value = buf[i];
+        for (int b = 0; b < 8; ++b) {
+            onewire_bus_writebit(pin, value & 1);
+            value >>= 1;
+        }
+    }
+    #endif
+}
+
 /******************************************************************************/
 // MicroPython bindings
 
@@ -121,6 +174,22 @@ STATIC mp_obj_t onewire_writebyte(mp_obj_t pin_in, mp_obj_t value_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(onewire_writebyte_obj, onewire_writebyte);
 
+STATIC mp_obj_t onewire_readinto(mp_obj_t pin_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    onewire_bus_readinto(mp_hal_get_pin_obj(pin_in), bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(onewire_readinto_obj, onewire_readinto);
+
+STATIC mp_obj_t onewire_write(mp_obj_t pin_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    onewire_bus_write(mp_hal_get_pin_obj(pin_in), bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(onewire_write_obj, onewire_write);
+
 STATIC mp_obj_t onewire_crc8(mp_obj_t data) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
@@ -151,6 +220,8 @@ STATIC const mp_rom_map_elem_t onewire_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readbyte), MP_ROM_PTR(&onewire_readbyte_obj) },
     { MP_ROM_QSTR(MP_QSTR_writebit), MP_ROM_PTR(&onewire_writebit_obj) },
     { MP_ROM_QSTR(MP_QSTR_writebyte), MP_ROM_PTR(&onewire_writebyte_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&onewire_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&onewire_write_obj) },
     { MP_ROM_QSTR(MP_QSTR_crc8), MP_ROM_PTR(&onewire_crc8_obj) },
 };
 
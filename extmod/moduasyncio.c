@@ -26,7 +26,10 @@
 
 #include "py/runtime.h"
 #include "py/smallint.h"
+#include "py/gc.h"
+#include "py/objgenerator.h"
 #include "py/pairheap.h"
+#include "py/stream.h"
 #include "py/mphal.h"
 
 #if MICROPY_PY_UASYNCIO
@@ -42,22 +45,82 @@
     (task)->state == TASK_STATE_DONE_NOT_WAITED_ON \
     || (task)->state == TASK_STATE_DONE_WAS_WAITED_ON)
 
+#define TASK_PRIORITY_DEFAULT (1)
+#define TASK_PRIORITY_MAX (2)
+
 typedef struct _mp_obj_task_t {
     mp_pairheap_t pairheap;
     mp_obj_t coro;
     mp_obj_t data;
     mp_obj_t state;
     mp_obj_t ph_key;
+    uint32_t qseq; // push order, breaks ties between equal ph_key in TaskQueue
+    uint8_t priority; // ready-lane of the task, 0 is the highest
+    #if MICROPY_PY_UASYNCIO_STATS
+    uint32_t resume_count; // times the run loop resumed this task
+    uint32_t run_us; // cumulative time spent running, in us
+    uint32_t max_slice_us; // longest single resume, in us
+    uint32_t wait_ms; // cumulative time spent runnable but not running, in ms
+    #endif
 } mp_obj_task_t;
 
+// With priority lanes enabled, ready tasks sit in one FIFO per priority and
+// higher lanes drain first; once a non-empty lane has been bypassed
+// TQ_STARVE_LIMIT times in a row it gets the next pop, bounding how long
+// high-priority churn can starve bulk work.  Otherwise a single FIFO.
+#if MICROPY_PY_UASYNCIO_PRIORITY_LANES
+#define TQ_NUM_LANES (TASK_PRIORITY_MAX + 1)
+#define TQ_STARVE_LIMIT (8)
+#define TASK_LANE(task) ((task)->priority)
+#else
+#define TQ_NUM_LANES (1)
+#define TASK_LANE(task) (0)
+#endif
+
+// The queue is split in two: tasks that are ready to run now sit on a FIFO
+// with O(1) push/pop (most pushes are ready-now and need no ordering), and
+// only tasks with a timed wait pay the pairing-heap discipline.  A ready
+// task is linked through its (otherwise unused) pairheap.next pointer.
 typedef struct _mp_obj_task_queue_t {
     mp_obj_base_t base;
-    mp_obj_task_t *heap;
+    mp_obj_task_t *heap; // tasks with a timed wait, ordered by ph_key
+    mp_obj_task_t *ready_head[TQ_NUM_LANES]; // ready-now tasks, in FIFO order
+    mp_obj_task_t *ready_tail[TQ_NUM_LANES];
+    uint32_t push_seq; // stamped into each pushed task's qseq
+    #if MICROPY_PY_UASYNCIO_PRIORITY_LANES
+    uint8_t starve[TQ_NUM_LANES]; // consecutive pops that bypassed this lane
+    #endif
+    #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+    mp_obj_task_t **wheel; // slot table, allocated on first sub-second timer
+    mp_obj_task_t *wheel_min; // cached earliest wheel entry, NULL if unknown
+    uint16_t wheel_count;
+    #endif
 } mp_obj_task_queue_t;
 
+#define TASK_READY_NEXT(task) ((mp_obj_task_t *)(task)->pairheap.next)
+
+#if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+// Sub-second timers go on a timing wheel: 64 slots of 16ms covering a 1024ms
+// horizon, each an unsorted doubly-linked list, giving O(1) insert and cancel
+// for the high-churn short timeouts (eg per-request deadlines) that would
+// otherwise pay pairing-heap discipline.  Longer sleeps stay in the heap.
+// A wheel entry is linked through pairheap.next/child (forward/back) and
+// marked by pointing pairheap.child_last at the queue, which can never be a
+// valid heap link.
+#define WHEEL_SLOT_SHIFT (4)
+#define WHEEL_SLOTS (64)
+#define WHEEL_HORIZON_MS (WHEEL_SLOTS << WHEEL_SLOT_SHIFT)
+#define WHEEL_NEXT(task) ((mp_obj_task_t *)(task)->pairheap.next)
+#define WHEEL_PREV(task) ((mp_obj_task_t *)(task)->pairheap.child)
+#define WHEEL_MARK(task) ((task)->pairheap.child_last)
+#define WHEEL_SLOT(key) ((MP_OBJ_SMALL_INT_VALUE(key) >> WHEEL_SLOT_SHIFT) & (WHEEL_SLOTS - 1))
+#endif
+
 STATIC const mp_obj_type_t task_queue_type;
 STATIC const mp_obj_type_t task_type;
 
+STATIC void sleepgen_init(void);
+
 STATIC mp_obj_t task_queue_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
 
 /******************************************************************************/
@@ -90,16 +153,151 @@ STATIC mp_obj_t task_queue_make_new(const mp_obj_type_t *type, size_t n_args, si
     mp_obj_task_queue_t *self = m_new_obj(mp_obj_task_queue_t);
     self->base.type = type;
     self->heap = (mp_obj_task_t *)mp_pairheap_new(task_lt);
+    for (size_t i = 0; i < TQ_NUM_LANES; ++i) {
+        self->ready_head[i] = NULL;
+        self->ready_tail[i] = NULL;
+        #if MICROPY_PY_UASYNCIO_PRIORITY_LANES
+        self->starve[i] = 0;
+        #endif
+    }
+    self->push_seq = 0;
+    #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+    self->wheel = NULL;
+    self->wheel_min = NULL;
+    self->wheel_count = 0;
+    #endif
     return MP_OBJ_FROM_PTR(self);
 }
 
+// True if t1 should pop before t2: earlier deadline, push order on ties.
+STATIC bool task_queue_before(mp_obj_task_t *t1, mp_obj_task_t *t2) {
+    mp_int_t d = ticks_diff(t1->ph_key, t2->ph_key);
+    return d < 0 || (d == 0 && (int32_t)(t1->qseq - t2->qseq) < 0);
+}
+
+#if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+
+STATIC void task_queue_wheel_insert(mp_obj_task_queue_t *self, mp_obj_task_t *task) {
+    if (self->wheel == NULL) {
+        self->wheel = m_new0(mp_obj_task_t *, WHEEL_SLOTS);
+    }
+    size_t slot = WHEEL_SLOT(task->ph_key);
+    task->pairheap.child = NULL;
+    task->pairheap.next = TASK_PAIRHEAP(self->wheel[slot]);
+    if (self->wheel[slot] != NULL) {
+        self->wheel[slot]->pairheap.child = &task->pairheap;
+    }
+    self->wheel[slot] = task;
+    WHEEL_MARK(task) = (mp_pairheap_t *)self;
+    ++self->wheel_count;
+    if (self->wheel_count == 1
+        || (self->wheel_min != NULL && task_queue_before(task, self->wheel_min))) {
+        self->wheel_min = task;
+    }
+}
+
+STATIC void task_queue_wheel_unlink(mp_obj_task_queue_t *self, mp_obj_task_t *task) {
+    if (WHEEL_PREV(task) != NULL) {
+        WHEEL_PREV(task)->pairheap.next = task->pairheap.next;
+    } else {
+        self->wheel[WHEEL_SLOT(task->ph_key)] = WHEEL_NEXT(task);
+    }
+    if (WHEEL_NEXT(task) != NULL) {
+        WHEEL_NEXT(task)->pairheap.child = task->pairheap.child;
+    }
+    task->pairheap.child = NULL;
+    task->pairheap.next = NULL;
+    WHEEL_MARK(task) = NULL;
+    --self->wheel_count;
+    if (self->wheel_min == task) {
+        self->wheel_min = NULL; // recomputed lazily on the next peek/pop
+    }
+}
+
+// Earliest entry on the wheel, or NULL if the wheel is empty.  O(1) while
+// the cached min is valid; a full scan of the live entries otherwise.
+STATIC mp_obj_task_t *task_queue_wheel_min(mp_obj_task_queue_t *self) {
+    if (self->wheel_count != 0 && self->wheel_min == NULL) {
+        mp_obj_task_t *min = NULL;
+        for (size_t i = 0; i < WHEEL_SLOTS; ++i) {
+            for (mp_obj_task_t *t = self->wheel[i]; t != NULL; t = WHEEL_NEXT(t)) {
+                if (min == NULL || task_queue_before(t, min)) {
+                    min = t;
+                }
+            }
+        }
+        self->wheel_min = min;
+    }
+    return self->wheel_min;
+}
+
+#endif // MICROPY_PY_UASYNCIO_TIMER_WHEEL
+
+// Lane the next ready pop comes from, or TQ_NUM_LANES if all are empty.
+// A lane that has been bypassed TQ_STARVE_LIMIT times in a row wins over
+// higher lanes.  Pure selection: peek and pop must agree on the lane.
+STATIC size_t task_queue_ready_lane(mp_obj_task_queue_t *self) {
+    #if MICROPY_PY_UASYNCIO_PRIORITY_LANES
+    for (size_t i = 0; i < TQ_NUM_LANES; ++i) {
+        if (self->ready_head[i] != NULL && self->starve[i] >= TQ_STARVE_LIMIT) {
+            return i;
+        }
+    }
+    #endif
+    for (size_t i = 0; i < TQ_NUM_LANES; ++i) {
+        if (self->ready_head[i] != NULL) {
+            return i;
+        }
+    }
+    return TQ_NUM_LANES;
+}
+
+STATIC mp_obj_task_t *task_queue_ready_head(mp_obj_task_queue_t *self) {
+    size_t lane = task_queue_ready_lane(self);
+    return lane == TQ_NUM_LANES ? NULL : self->ready_head[lane];
+}
+
+// Append a ready-now task to the tail of its lane's FIFO.
+STATIC void task_queue_ready_push(mp_obj_task_queue_t *self, mp_obj_task_t *task) {
+    size_t lane = TASK_LANE(task);
+    task->pairheap.next = NULL;
+    if (self->ready_head[lane] == NULL) {
+        self->ready_head[lane] = task;
+    } else {
+        self->ready_tail[lane]->pairheap.next = &task->pairheap;
+    }
+    self->ready_tail[lane] = task;
+}
+
+// Return the next task to run: the earliest of the FIFO head, the heap
+// root and the timing wheel by ph_key, breaking equal-tick ties by push
+// order so the split queues pop in exactly the order the single heap
+// used to.
+STATIC mp_obj_task_t *task_queue_next(mp_obj_task_queue_t *self) {
+    mp_obj_task_t *head = self->heap;
+    #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+    mp_obj_task_t *wmin = task_queue_wheel_min(self);
+    if (wmin != NULL && (head == NULL || task_queue_before(wmin, head))) {
+        head = wmin;
+    }
+    #endif
+    mp_obj_task_t *ready = task_queue_ready_head(self);
+    if (head == NULL) {
+        return ready;
+    }
+    if (ready == NULL || task_queue_before(head, ready)) {
+        return head;
+    }
+    return ready;
+}
+
 STATIC mp_obj_t task_queue_peek(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    if (self->heap == NULL) {
+    mp_obj_task_t *head = task_queue_next(self);
+    if (head == NULL) {
         return mp_const_none;
-    } else {
-        return MP_OBJ_FROM_PTR(self->heap);
     }
+    return MP_OBJ_FROM_PTR(head);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_peek_obj, task_queue_peek);
 
@@ -107,24 +305,65 @@ STATIC mp_obj_t task_queue_push_sorted(size_t n_args, const mp_obj_t *args) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(args[0]);
     mp_obj_task_t *task = MP_OBJ_TO_PTR(args[1]);
     task->data = mp_const_none;
+    task->qseq = self->push_seq++;
     if (n_args == 2) {
+        // Ready to run now: append to the FIFO, no ordering needed.
         task->ph_key = ticks();
+        task_queue_ready_push(self, task);
     } else {
         assert(mp_obj_is_small_int(args[2]));
         task->ph_key = args[2];
+        mp_int_t dt = ticks_diff(task->ph_key, ticks());
+        if (dt <= 0) {
+            // Deadline already passed (eg sleep_ms(0) yields): the task is
+            // ready now, so it can take the FIFO fast path and, with
+            // priority lanes enabled, its lane.
+            task_queue_ready_push(self, task);
+            return mp_const_none;
+        }
+        #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+        // Sub-second deadlines go on the wheel; but its slot table is
+        // allocated on first use, so don't trigger that with the heap locked.
+        if (dt < WHEEL_HORIZON_MS && (self->wheel != NULL || !gc_is_locked())) {
+            task_queue_wheel_insert(self, task);
+            return mp_const_none;
+        }
+        #endif
+        self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
     }
-    self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(task_queue_push_sorted_obj, 2, 3, task_queue_push_sorted);
 
 STATIC mp_obj_t task_queue_pop_head(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_obj_task_t *head = (mp_obj_task_t *)mp_pairheap_peek(task_lt, &self->heap->pairheap);
+    mp_obj_task_t *head = task_queue_next(self);
     if (head == NULL) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty heap"));
     }
-    self->heap = (mp_obj_task_t *)mp_pairheap_pop(task_lt, &self->heap->pairheap);
+    #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+    if (self->wheel != NULL && WHEEL_MARK(head) == (mp_pairheap_t *)self) {
+        task_queue_wheel_unlink(self, head);
+    } else
+    #endif
+    if (head == self->heap) {
+        self->heap = (mp_obj_task_t *)mp_pairheap_pop(task_lt, &head->pairheap);
+    } else {
+        size_t lane = task_queue_ready_lane(self);
+        self->ready_head[lane] = TASK_READY_NEXT(head);
+        head->pairheap.next = NULL;
+        if (self->ready_head[lane] == NULL) {
+            self->ready_tail[lane] = NULL;
+        }
+        #if MICROPY_PY_UASYNCIO_PRIORITY_LANES
+        self->starve[lane] = 0;
+        for (size_t j = lane + 1; j < TQ_NUM_LANES; ++j) {
+            if (self->ready_head[j] != NULL && self->starve[j] < TQ_STARVE_LIMIT) {
+                ++self->starve[j];
+            }
+        }
+        #endif
+    }
     return MP_OBJ_FROM_PTR(head);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_pop_head_obj, task_queue_pop_head);
@@ -132,11 +371,62 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_pop_head_obj, task_queue_pop_head);
 STATIC mp_obj_t task_queue_remove(mp_obj_t self_in, mp_obj_t task_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_task_t *task = MP_OBJ_TO_PTR(task_in);
-    self->heap = (mp_obj_task_t *)mp_pairheap_delete(task_lt, &self->heap->pairheap, &task->pairheap);
+    // Unlink the task from the ready FIFO if it's there, else it's in the heap.
+    for (size_t lane = 0; lane < TQ_NUM_LANES; ++lane) {
+        mp_obj_task_t *prev = NULL;
+        for (mp_obj_task_t *t = self->ready_head[lane]; t != NULL; prev = t, t = TASK_READY_NEXT(t)) {
+            if (t == task) {
+                if (prev == NULL) {
+                    self->ready_head[lane] = TASK_READY_NEXT(task);
+                } else {
+                    prev->pairheap.next = task->pairheap.next;
+                }
+                task->pairheap.next = NULL;
+                if (self->ready_tail[lane] == task) {
+                    self->ready_tail[lane] = prev;
+                }
+                return mp_const_none;
+            }
+        }
+    }
+    #if MICROPY_PY_UASYNCIO_TIMER_WHEEL
+    if (self->wheel != NULL && WHEEL_MARK(task) == (mp_pairheap_t *)self) {
+        task_queue_wheel_unlink(self, task);
+        return mp_const_none;
+    }
+    #endif
+    self->heap = (mp_obj_task_t *)mp_pairheap_delete(task_lt, TASK_PAIRHEAP(self->heap), &task->pairheap);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(task_queue_remove_obj, task_queue_remove);
 
+// Move every task on src's ready FIFO to the tail of dst's in one list
+// splice, restamping each task as push_head would so ordering against dst's
+// timed entries stays correct.  Used for bulk wakeups (eg Event.set).
+STATIC void task_queue_splice(mp_obj_task_queue_t *src, mp_obj_task_queue_t *dst) {
+    mp_obj_t now = ticks();
+    // A waiting task sits in the lane matching its own priority, so each
+    // src lane splices onto the same dst lane.
+    for (size_t lane = 0; lane < TQ_NUM_LANES; ++lane) {
+        if (src->ready_head[lane] == NULL) {
+            continue;
+        }
+        for (mp_obj_task_t *t = src->ready_head[lane]; t != NULL; t = TASK_READY_NEXT(t)) {
+            t->data = mp_const_none;
+            t->ph_key = now;
+            t->qseq = dst->push_seq++;
+        }
+        if (dst->ready_head[lane] == NULL) {
+            dst->ready_head[lane] = src->ready_head[lane];
+        } else {
+            dst->ready_tail[lane]->pairheap.next = &src->ready_head[lane]->pairheap;
+        }
+        dst->ready_tail[lane] = src->ready_tail[lane];
+        src->ready_head[lane] = NULL;
+        src->ready_tail[lane] = NULL;
+    }
+}
+
 STATIC const mp_rom_map_elem_t task_queue_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_peek), MP_ROM_PTR(&task_queue_peek_obj) },
     { MP_ROM_QSTR(MP_QSTR_push_sorted), MP_ROM_PTR(&task_queue_push_sorted_obj) },
@@ -168,9 +458,21 @@ STATIC mp_obj_t task_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
     self->data = mp_const_none;
     self->state = TASK_STATE_RUNNING_NOT_WAITED_ON;
     self->ph_key = MP_OBJ_NEW_SMALL_INT(0);
+    self->priority = TASK_PRIORITY_DEFAULT;
+    #if MICROPY_PY_UASYNCIO_STATS
+    self->resume_count = 0;
+    self->run_us = 0;
+    self->max_slice_us = 0;
+    self->wait_ms = 0;
+    #endif
     if (n_args == 2) {
         uasyncio_context = args[1];
     }
+    if (MP_STATE_VM(uasyncio_sleep_singleton) == MP_OBJ_NULL) {
+        // Pre-create the sleep singleton so sleep_ms never has to allocate
+        // while tasks are running (eg with the heap locked).
+        sleepgen_init();
+    }
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -243,6 +545,18 @@ STATIC void task_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
             dest[1] = self_in;
         } else if (attr == MP_QSTR_ph_key) {
             dest[0] = self->ph_key;
+        } else if (attr == MP_QSTR_priority) {
+            dest[0] = MP_OBJ_NEW_SMALL_INT(self->priority);
+        #if MICROPY_PY_UASYNCIO_STATS
+        } else if (attr == MP_QSTR_resume_count) {
+            dest[0] = mp_obj_new_int_from_uint(self->resume_count);
+        } else if (attr == MP_QSTR_run_us) {
+            dest[0] = mp_obj_new_int_from_uint(self->run_us);
+        } else if (attr == MP_QSTR_max_slice_us) {
+            dest[0] = mp_obj_new_int_from_uint(self->max_slice_us);
+        } else if (attr == MP_QSTR_wait_ms) {
+            dest[0] = mp_obj_new_int_from_uint(self->wait_ms);
+        #endif
         }
     } else if (dest[1] != MP_OBJ_NULL) {
         // Store
@@ -252,6 +566,15 @@ STATIC void task_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
         } else if (attr == MP_QSTR_state) {
             self->state = dest[1];
             dest[0] = MP_OBJ_NULL;
+        } else if (attr == MP_QSTR_priority) {
+            mp_int_t prio = mp_obj_get_int(dest[1]);
+            if (prio < 0) {
+                prio = 0;
+            } else if (prio > TASK_PRIORITY_MAX) {
+                prio = TASK_PRIORITY_MAX;
+            }
+            self->priority = prio;
+            dest[0] = MP_OBJ_NULL;
         }
     }
 }
@@ -294,6 +617,736 @@ STATIC const mp_obj_type_t task_type = {
     .iternext = task_iternext,
 };
 
+/******************************************************************************/
+// Event class
+
+// C version of uasyncio's Event: set() wakes all waiting tasks by splicing
+// the event's whole waiting list onto the run queue instead of moving tasks
+// one at a time, so broadcasting to N waiters doesn't cost N queue
+// operations.  With the scheduler enabled, isr_set() makes the event usable
+// from a hard IRQ or another thread by deferring set() to scheduler context.
+
+typedef struct _mp_obj_event_t {
+    mp_obj_base_t base;
+    bool state; // false=unset; true=set
+    mp_obj_t waiting; // TaskQueue of tasks waiting on completion of this event
+} mp_obj_event_t;
+
+STATIC mp_obj_t event_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void)args;
+    mp_arg_check_num(n_args, n_kw, 0, 0, false);
+    mp_obj_event_t *self = m_new_obj(mp_obj_event_t);
+    self->base.type = type;
+    self->state = false;
+    self->waiting = task_queue_make_new(&task_queue_type, 0, 0, NULL);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC mp_obj_t event_is_set(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(self->state);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_is_set_obj, event_is_set);
+
+STATIC mp_obj_t event_set(mp_obj_t self_in) {
+    // Event becomes set, schedule any tasks waiting on it.
+    // Note: This must not be called from anything except the thread running
+    // the asyncio loop (use isr_set() for that).
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_task_queue_t *waiting = MP_OBJ_TO_PTR(self->waiting);
+    if (task_queue_ready_head(waiting) != NULL) {
+        // There's a waiter, so a task exists and the context must be set.
+        mp_obj_t _task_queue = mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR__task_queue));
+        task_queue_splice(waiting, MP_OBJ_TO_PTR(_task_queue));
+    }
+    self->state = true;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_set_obj, event_set);
+
+#if MICROPY_ENABLE_SCHEDULER
+STATIC mp_obj_t event_isr_set(mp_obj_t self_in) {
+    // Defer set() to scheduler context so the task queues are only touched
+    // between bytecodes, making this safe from hard IRQs and other threads.
+    if (!mp_sched_schedule(MP_OBJ_FROM_PTR(&event_set_obj), self_in)) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("schedule queue full"));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_isr_set_obj, event_isr_set);
+#endif
+
+STATIC mp_obj_t event_clear(mp_obj_t self_in) {
+    mp_obj_event_t *self = MP_OBJ_TO_PTR(self_in);
+    self->state = false;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_clear_obj, event_clear);
+
+// The awaitable returned by Event.wait(): yields once with the calling task
+// on the event's waiting queue if the event is unset, like the Python
+// implementation's generator but without allocating one per wait.
+
+typedef struct _mp_obj_event_wait_t {
+    mp_obj_base_t base;
+    mp_obj_event_t *event;
+    bool queued; // whether the calling task has been queued on the event
+} mp_obj_event_wait_t;
+
+STATIC mp_obj_t event_wait_iternext(mp_obj_t self_in) {
+    mp_obj_event_wait_t *self = MP_OBJ_TO_PTR(self_in);
+    if (!self->queued && !self->event->state) {
+        // Event not set, put the calling task on the event's waiting queue.
+        mp_obj_t cur_task = mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR_cur_task));
+        mp_obj_t args[2] = { self->event->waiting, cur_task };
+        task_queue_push_sorted(2, args);
+        // Set the task's data to the event's queue so it can be removed if needed.
+        ((mp_obj_task_t *)MP_OBJ_TO_PTR(cur_task))->data = self->event->waiting;
+        self->queued = true;
+        return mp_const_none;
+    }
+    mp_obj_t result = mp_const_true;
+    nlr_raise(mp_obj_new_exception_args(&mp_type_StopIteration, 1, &result));
+}
+
+// A send method so the awaitable can be wrapped in a Task (eg by wait_for);
+// completion is signalled by iternext raising StopIteration, which is just
+// what send() must do.
+STATIC mp_obj_t event_wait_send(mp_obj_t self_in, mp_obj_t value) {
+    (void)value;
+    return event_wait_iternext(self_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(event_wait_send_obj, event_wait_send);
+
+STATIC const mp_rom_map_elem_t event_wait_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&event_wait_send_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(event_wait_locals_dict, event_wait_locals_dict_table);
+
+STATIC const mp_obj_type_t event_wait_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_EventWait,
+    .getiter = mp_identity_getiter,
+    .iternext = event_wait_iternext,
+    .locals_dict = (mp_obj_dict_t *)&event_wait_locals_dict,
+};
+
+STATIC mp_obj_t event_wait(mp_obj_t self_in) {
+    mp_obj_event_wait_t *wait = m_new_obj(mp_obj_event_wait_t);
+    wait->base.type = &event_wait_type;
+    wait->event = MP_OBJ_TO_PTR(self_in);
+    wait->queued = false;
+    return MP_OBJ_FROM_PTR(wait);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(event_wait_obj, event_wait);
+
+STATIC const mp_rom_map_elem_t event_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_is_set), MP_ROM_PTR(&event_is_set_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set), MP_ROM_PTR(&event_set_obj) },
+    #if MICROPY_ENABLE_SCHEDULER
+    { MP_ROM_QSTR(MP_QSTR_isr_set), MP_ROM_PTR(&event_isr_set_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&event_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&event_wait_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(event_locals_dict, event_locals_dict_table);
+
+STATIC const mp_obj_type_t event_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Event,
+    .make_new = event_make_new,
+    .locals_dict = (mp_obj_dict_t *)&event_locals_dict,
+};
+
+/******************************************************************************/
+// Sleep awaitable
+
+// C version of core.py's sleep_ms/SingletonGenerator: a single reused
+// awaitable that schedules the current task on the run queue at the given
+// deadline (in the task's embedded pairheap node) and then finishes via the
+// optimised StopIteration return, so a sleep allocates nothing at all.
+
+typedef struct _mp_obj_sleepgen_t {
+    mp_obj_base_t base;
+    mp_obj_t state; // time to schedule the awaiting task at, or none
+} mp_obj_sleepgen_t;
+
+STATIC mp_obj_t sleepgen_iternext(mp_obj_t self_in) {
+    mp_obj_sleepgen_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->state != mp_const_none) {
+        mp_obj_t cur_task = mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR_cur_task));
+        mp_obj_t args[3] = { mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR__task_queue)), cur_task, self->state };
+        task_queue_push_sorted(3, args);
+        self->state = mp_const_none;
+        return mp_const_none;
+    }
+    // Finished: raise StopIteration(None) without allocating an exception.
+    MP_STATE_THREAD(stop_iteration_arg) = MP_OBJ_NULL;
+    return MP_OBJ_STOP_ITERATION;
+}
+
+STATIC const mp_obj_type_t sleepgen_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_SleepGen,
+    .getiter = mp_identity_getiter,
+    .iternext = sleepgen_iternext,
+};
+
+// Create the singleton.  Called from Task creation as well as sleep_ms so
+// that by the time a task can sleep no allocation is needed, even with the
+// heap locked.
+STATIC void sleepgen_init(void) {
+    mp_obj_sleepgen_t *sgen = m_new_obj(mp_obj_sleepgen_t);
+    sgen->base.type = &sleepgen_type;
+    sgen->state = mp_const_none;
+    MP_STATE_VM(uasyncio_sleep_singleton) = MP_OBJ_FROM_PTR(sgen);
+}
+
+STATIC mp_obj_t uasyncio_sleep_ms(mp_obj_t t_in) {
+    if (MP_STATE_VM(uasyncio_sleep_singleton) == MP_OBJ_NULL) {
+        sleepgen_init();
+    }
+    mp_obj_sleepgen_t *sgen = MP_OBJ_TO_PTR(MP_STATE_VM(uasyncio_sleep_singleton));
+    // The awaitable must have been consumed by a previous await already.
+    assert(sgen->state == mp_const_none);
+    mp_int_t t = mp_obj_get_int(t_in);
+    if (t < 0) {
+        t = 0;
+    }
+    sgen->state = MP_OBJ_NEW_SMALL_INT((MP_OBJ_SMALL_INT_VALUE(ticks()) + t) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
+    return MP_OBJ_FROM_PTR(sgen);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_sleep_ms_obj, uasyncio_sleep_ms);
+
+/******************************************************************************/
+// ThreadSafeQueue class
+
+#if MICROPY_PY_UASYNCIO_TSQUEUE
+
+// A fixed-size inbox for handing objects from a producer thread (or
+// scheduler/IRQ context) to a task in the uasyncio loop, without going
+// through mp_sched_schedule and a Python trampoline per item.  put() is a
+// plain ring-buffer store; concurrent producers are serialized by the GIL.
+// The consumer side is a pollable stream that reads ready when the queue is
+// non-empty, so get() waits on the IOQueue like any other stream.  On ports
+// whose poller blocks on file descriptors the queue owns a pipe and put()
+// writes a byte to wake the poll.
+
+#if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "py/mperrno.h"
+
+typedef struct _mp_obj_tsqueue_t {
+    mp_obj_base_t base;
+    uint16_t alloc; // number of ring slots, one more than the capacity
+    volatile uint16_t head; // next slot to pop; written only by the consumer
+    volatile uint16_t tail; // next slot to fill; written only by producers
+    mp_obj_t *ring;
+    #if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+    int fd[2]; // read and write ends of the wakeup pipe
+    #endif
+} mp_obj_tsqueue_t;
+
+STATIC mp_obj_t tsqueue_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    mp_uint_t size = mp_obj_get_int(args[0]);
+    mp_obj_tsqueue_t *self = m_new_obj(mp_obj_tsqueue_t);
+    self->base.type = type;
+    self->alloc = size + 1;
+    self->head = 0;
+    self->tail = 0;
+    self->ring = m_new0(mp_obj_t, self->alloc);
+    #if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+    if (pipe(self->fd) != 0) {
+        mp_raise_OSError(errno);
+    }
+    fcntl(self->fd[0], F_SETFL, fcntl(self->fd[0], F_GETFL) | O_NONBLOCK);
+    fcntl(self->fd[1], F_SETFL, fcntl(self->fd[1], F_GETFL) | O_NONBLOCK);
+    #endif
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC mp_obj_t tsqueue_put(mp_obj_t self_in, mp_obj_t obj) {
+    mp_obj_tsqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    uint16_t tail = self->tail;
+    uint16_t next = (uint16_t)((tail + 1) % self->alloc);
+    if (next == self->head) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("queue overflow"));
+    }
+    self->ring[tail] = obj;
+    self->tail = next;
+    #if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+    // Wake the consumer if its loop is blocked in poll.  If the pipe is full
+    // then a wakeup is already pending and the EAGAIN can be ignored.
+    byte b = 0;
+    int ret = write(self->fd[1], &b, 1);
+    (void)ret;
+    #endif
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(tsqueue_put_obj, tsqueue_put);
+
+// The awaitable returned by ThreadSafeQueue.get(): pops an object if one is
+// ready, otherwise waits for the queue to poll readable.
+
+typedef struct _mp_obj_tsqueue_get_t {
+    mp_obj_base_t base;
+    mp_obj_tsqueue_t *queue;
+} mp_obj_tsqueue_get_t;
+
+STATIC mp_obj_t tsqueue_get_iternext(mp_obj_t self_in) {
+    mp_obj_tsqueue_get_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_tsqueue_t *q = self->queue;
+    #if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+    // Drain pending wakeup bytes; the ring alone says whether data is ready.
+    byte buf[16];
+    while (read(q->fd[0], buf, sizeof(buf)) == sizeof(buf)) {
+    }
+    #endif
+    if (q->head != q->tail) {
+        uint16_t head = q->head;
+        mp_obj_t obj = q->ring[head];
+        q->ring[head] = MP_OBJ_NULL; // so we don't retain a pointer
+        q->head = (uint16_t)((head + 1) % q->alloc);
+        nlr_raise(mp_obj_new_exception_args(&mp_type_StopIteration, 1, &obj));
+    }
+    // Queue empty: wait for a producer to post something.
+    mp_obj_t io_queue = mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR__io_queue));
+    mp_obj_t dest[3];
+    mp_load_method(io_queue, MP_QSTR_queue_read, dest);
+    dest[2] = MP_OBJ_FROM_PTR(q);
+    mp_call_method_n_kw(1, 0, dest);
+    return mp_const_none;
+}
+
+STATIC mp_obj_t tsqueue_get_send(mp_obj_t self_in, mp_obj_t value) {
+    (void)value;
+    return tsqueue_get_iternext(self_in);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(tsqueue_get_send_obj, tsqueue_get_send);
+
+STATIC const mp_rom_map_elem_t tsqueue_get_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&tsqueue_get_send_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(tsqueue_get_locals_dict, tsqueue_get_locals_dict_table);
+
+STATIC const mp_obj_type_t tsqueue_get_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ThreadSafeQueueGet,
+    .getiter = mp_identity_getiter,
+    .iternext = tsqueue_get_iternext,
+    .locals_dict = (mp_obj_dict_t *)&tsqueue_get_locals_dict,
+};
+
+STATIC mp_obj_t tsqueue_get(mp_obj_t self_in) {
+    mp_obj_tsqueue_get_t *get = m_new_obj(mp_obj_tsqueue_get_t);
+    get->base.type = &tsqueue_get_type;
+    get->queue = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_FROM_PTR(get);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(tsqueue_get_obj, tsqueue_get);
+
+STATIC mp_uint_t tsqueue_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_tsqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    if (request == MP_STREAM_POLL) {
+        return self->head != self->tail ? arg & MP_STREAM_POLL_RD : 0;
+    }
+    #if MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+    if (request == MP_STREAM_GET_FILENO) {
+        return self->fd[0];
+    }
+    #endif
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+STATIC const mp_rom_map_elem_t tsqueue_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_put), MP_ROM_PTR(&tsqueue_put_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&tsqueue_get_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(tsqueue_locals_dict, tsqueue_locals_dict_table);
+
+STATIC const mp_stream_p_t tsqueue_stream_p = {
+    .ioctl = tsqueue_ioctl,
+};
+
+STATIC const mp_obj_type_t tsqueue_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ThreadSafeQueue,
+    .make_new = tsqueue_make_new,
+    .protocol = &tsqueue_stream_p,
+    .locals_dict = (mp_obj_dict_t *)&tsqueue_locals_dict,
+};
+
+#endif // MICROPY_PY_UASYNCIO_TSQUEUE
+
+/******************************************************************************/
+// StreamAwaitable class
+
+#if MICROPY_PY_UASYNCIO_STREAM
+
+// A native awaitable performing non-blocking stream IO.  It behaves like a
+// coroutine: each resume by the scheduler tries to make progress with
+// non-blocking stream calls and either completes (raising StopIteration
+// carrying the result) or queues the current task on the uasyncio IOQueue
+// and yields.  This keeps the per-chunk read/write loop out of Python
+// bytecode; uasyncio's Stream class uses these when available.
+
+#define STREAM_AWAITABLE_OP_READ (0)
+#define STREAM_AWAITABLE_OP_READLINE (1)
+#define STREAM_AWAITABLE_OP_WRITE (2)
+
+typedef struct _mp_obj_stream_awaitable_t {
+    mp_obj_base_t base;
+    mp_obj_t stream;
+    uint8_t op;
+    bool queued; // whether the current task has been queued on the IOQueue
+    bool read_all; // OP_READ with a negative size
+    vstr_t vstr; // accumulates data for the read ops
+    size_t read_len; // requested read amount for OP_READ
+    mp_obj_t write_buf_obj; // keeps the written object alive for OP_WRITE
+    size_t write_pos;
+    size_t write_len;
+} mp_obj_stream_awaitable_t;
+
+STATIC const mp_obj_type_t stream_awaitable_type;
+
+// Queue the current task to be woken when the stream is readable/writable.
+STATIC void stream_awaitable_wait(mp_obj_stream_awaitable_t *self) {
+    mp_obj_t io_queue = mp_obj_dict_get(uasyncio_context, MP_OBJ_NEW_QSTR(MP_QSTR__io_queue));
+    mp_obj_t dest[3];
+    mp_load_method(io_queue,
+        self->op == STREAM_AWAITABLE_OP_WRITE ? MP_QSTR_queue_write : MP_QSTR_queue_read, dest);
+    dest[2] = self->stream;
+    mp_call_method_n_kw(1, 0, dest);
+    self->queued = true;
+}
+
+STATIC NORETURN void stream_awaitable_finish(mp_obj_t result) {
+    nlr_raise(mp_obj_new_exception_args(&mp_type_StopIteration, 1, &result));
+}
+
+STATIC mp_obj_t stream_awaitable_iternext(mp_obj_t self_in) {
+    mp_obj_stream_awaitable_t *self = MP_OBJ_TO_PTR(self_in);
+    const mp_stream_p_t *stream_p = mp_get_stream(self->stream);
+    if (!self->queued) {
+        // First resume: nothing to do for an empty write, otherwise poll the
+        // stream before touching it (like the Python implementation) so a
+        // blocking stream can't stall the scheduler.
+        if (self->op == STREAM_AWAITABLE_OP_WRITE && self->write_len == 0) {
+            stream_awaitable_finish(mp_const_none);
+        }
+        stream_awaitable_wait(self);
+        return mp_const_none;
+    }
+    int errcode;
+    if (self->op == STREAM_AWAITABLE_OP_READ) {
+        if (self->read_all) {
+            // read whatever is available, in chunks, until the stream would block
+            for (;;) {
+                vstr_hint_size(&self->vstr, 64);
+                mp_uint_t ret = stream_p->read(self->stream,
+                    self->vstr.buf + self->vstr.len, self->vstr.alloc - self->vstr.len, &errcode);
+                if (ret == MP_STREAM_ERROR) {
+                    if (mp_is_nonblocking_error(errcode)) {
+                        if (self->vstr.len == 0) {
+                            // spurious wake-up; wait for more
+                            stream_awaitable_wait(self);
+                            return mp_const_none;
+                        }
+                        break;
+                    }
+                    mp_raise_OSError(errcode);
+                }
+                if (ret == 0) {
+                    // EOF
+                    break;
+                }
+                self->vstr.len += ret;
+            }
+        } else {
+            mp_uint_t ret = stream_p->read(self->stream, self->vstr.buf, self->read_len, &errcode);
+            if (ret == MP_STREAM_ERROR) {
+                if (mp_is_nonblocking_error(errcode)) {
+                    stream_awaitable_wait(self);
+                    return mp_const_none;
+                }
+                mp_raise_OSError(errcode);
+            }
+            self->vstr.len = ret;
+        }
+        stream_awaitable_finish(mp_obj_new_str_from_vstr(&mp_type_bytes, &self->vstr));
+    } else if (self->op == STREAM_AWAITABLE_OP_READLINE) {
+        for (;;) {
+            byte c;
+            mp_uint_t ret = stream_p->read(self->stream, &c, 1, &errcode);
+            if (ret == MP_STREAM_ERROR) {
+                if (mp_is_nonblocking_error(errcode)) {
+                    stream_awaitable_wait(self);
+                    return mp_const_none;
+                }
+                mp_raise_OSError(errcode);
+            }
+            if (ret == 0) {
+                // EOF: return what was collected so far
+                break;
+            }
+            vstr_add_byte(&self->vstr, c);
+            if (c == '\n') {
+                break;
+            }
+        }
+        stream_awaitable_finish(mp_obj_new_str_from_vstr(&mp_type_bytes, &self->vstr));
+    } else {
+        // OP_WRITE: keep writing until it's all out or the stream is full
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(self->write_buf_obj, &bufinfo, MP_BUFFER_READ);
+        while (self->write_pos < self->write_len) {
+            mp_uint_t ret = stream_p->write(self->stream,
+                (const uint8_t *)bufinfo.buf + self->write_pos, self->write_len - self->write_pos, &errcode);
+            if (ret == MP_STREAM_ERROR) {
+                if (mp_is_nonblocking_error(errcode)) {
+                    stream_awaitable_wait(self);
+                    return mp_const_none;
+                }
+                mp_raise_OSError(errcode);
+            }
+            self->write_pos += ret;
+        }
+        stream_awaitable_finish(mp_const_none);
+    }
+}
+
+STATIC const mp_obj_type_t stream_awaitable_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_StreamAwaitable,
+    .getiter = mp_identity_getiter,
+    .iternext = stream_awaitable_iternext,
+};
+
+STATIC mp_obj_stream_awaitable_t *stream_awaitable_new(mp_obj_t stream, uint8_t op) {
+    mp_obj_stream_awaitable_t *self = m_new_obj(mp_obj_stream_awaitable_t);
+    self->base.type = &stream_awaitable_type;
+    self->stream = stream;
+    self->op = op;
+    self->queued = false;
+    return self;
+}
+
+STATIC mp_obj_t uasyncio_stream_read(mp_obj_t stream_in, mp_obj_t n_in) {
+    mp_get_stream_raise(stream_in, MP_STREAM_OP_READ);
+    mp_obj_stream_awaitable_t *self = stream_awaitable_new(stream_in, STREAM_AWAITABLE_OP_READ);
+    mp_int_t n = mp_obj_get_int(n_in);
+    if (n < 0) {
+        self->read_all = true;
+        vstr_init(&self->vstr, 16);
+    } else {
+        self->read_all = false;
+        self->read_len = n;
+        // +1 so the final shrink to len+1 bytes never needs to grow the buffer
+        vstr_init(&self->vstr, n + 1);
+    }
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(uasyncio_stream_read_obj, uasyncio_stream_read);
+
+STATIC mp_obj_t uasyncio_stream_readline(mp_obj_t stream_in) {
+    mp_get_stream_raise(stream_in, MP_STREAM_OP_READ);
+    mp_obj_stream_awaitable_t *self = stream_awaitable_new(stream_in, STREAM_AWAITABLE_OP_READLINE);
+    vstr_init(&self->vstr, 16);
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_stream_readline_obj, uasyncio_stream_readline);
+
+STATIC mp_obj_t uasyncio_stream_write(mp_obj_t stream_in, mp_obj_t buf_in) {
+    mp_get_stream_raise(stream_in, MP_STREAM_OP_WRITE);
+    mp_obj_stream_awaitable_t *self = stream_awaitable_new(stream_in, STREAM_AWAITABLE_OP_WRITE);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    self->write_buf_obj = buf_in;
+    self->write_pos = 0;
+    self->write_len = bufinfo.len;
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(uasyncio_stream_write_obj, uasyncio_stream_write);
+
+#endif // MICROPY_PY_UASYNCIO_STREAM
+
+/******************************************************************************/
+// Native run loop
+
+// C version of core.py's run_until_complete: pop the next task, resume its
+// coroutine via mp_resume and route the outcome, so a task switch executes
+// no Python bytecode and task completion needs no exception throw/catch for
+// the common (native generator) case.  IO polling and the exception handler
+// still call back into core.py.  State is shared with the Python code via
+// uasyncio_context, the core.py globals captured by the Task constructor.
+
+STATIC mp_obj_t uasyncio_run_until_complete(mp_obj_t main_task_in) {
+    mp_obj_t context = uasyncio_context;
+    mp_obj_t task_queue_in = mp_obj_dict_get(context, MP_OBJ_NEW_QSTR(MP_QSTR__task_queue));
+    mp_obj_task_queue_t *tq = MP_OBJ_TO_PTR(task_queue_in);
+    mp_obj_t io_queue = mp_obj_dict_get(context, MP_OBJ_NEW_QSTR(MP_QSTR__io_queue));
+    mp_obj_t cancelled_error = mp_obj_dict_get(context, MP_OBJ_NEW_QSTR(MP_QSTR_CancelledError));
+
+    for (;;) {
+        // Wait until the head of the task queue is ready to run.
+        mp_int_t dt = 1;
+        while (dt > 0) {
+            dt = -1;
+            mp_obj_task_t *t = task_queue_next(tq);
+            if (t != NULL) {
+                // A task is waiting; ph_key is the time to schedule it at.
+                dt = ticks_diff(t->ph_key, ticks());
+                if (dt < 0) {
+                    dt = 0;
+                }
+            } else if (!mp_obj_is_true(mp_load_attr(io_queue, MP_QSTR_map))) {
+                // No tasks can be woken so finished running.
+                return mp_const_none;
+            }
+            mp_obj_t dest[3];
+            mp_load_method(io_queue, MP_QSTR_wait_io_event, dest);
+            dest[2] = MP_OBJ_NEW_SMALL_INT(dt);
+            mp_call_method_n_kw(1, 0, dest);
+        }
+
+        // Get the next task to run and continue it.
+        mp_obj_t t_in = task_queue_pop_head(task_queue_in);
+        mp_obj_task_t *t = MP_OBJ_TO_PTR(t_in);
+        mp_obj_dict_store(context, MP_OBJ_NEW_QSTR(MP_QSTR_cur_task), t_in);
+
+        #if MICROPY_PY_UASYNCIO_STATS
+        // Time the task sat runnable without running: measured from ph_key,
+        // which is the push time for ready pushes and the deadline for
+        // timed ones.
+        mp_int_t late = ticks_diff(ticks(), t->ph_key);
+        if (late > 0) {
+            t->wait_ms += late;
+        }
+        mp_uint_t slice_start_us = mp_hal_ticks_us();
+        #endif
+
+        // Resume the coroutine; it's responsible for rescheduling itself.  If
+        // the task was cancelled while queued then throw the pending exception
+        // into it instead.  mp_resume reports completion of a native generator
+        // in its return kind, so no exception is allocated or caught here; an
+        // nlr catch is still needed for non-generator coroutines.
+        mp_obj_t exc = t->data;
+        mp_vm_return_kind_t kind;
+        mp_obj_t ret;
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            if (!mp_obj_is_true(exc)) {
+                kind = mp_resume(t->coro, mp_const_none, MP_OBJ_NULL, &ret);
+            } else {
+                // The task was cancelled, or is finished with an unretrieved
+                // exception and was pushed back on the run queue; throwing
+                // into it raises StopIteration and the handling below runs
+                // the call_exception_handler function.
+                t->data = mp_const_none;
+                if (mp_obj_is_type(t->coro, &mp_type_gen_instance)) {
+                    // Throw like coro.throw() does: send_value must be None so
+                    // that a just-started generator accepts the exception.
+                    kind = mp_obj_gen_resume(t->coro, mp_const_none, exc, &ret);
+                } else {
+                    kind = mp_resume(t->coro, MP_OBJ_NULL, exc, &ret);
+                }
+            }
+            nlr_pop();
+        } else {
+            kind = MP_VM_RETURN_EXCEPTION;
+            ret = MP_OBJ_FROM_PTR(nlr.ret_val);
+        }
+
+        #if MICROPY_PY_UASYNCIO_STATS
+        uint32_t slice_us = (uint32_t)(mp_hal_ticks_us() - slice_start_us);
+        ++t->resume_count;
+        t->run_us += slice_us;
+        if (slice_us > t->max_slice_us) {
+            t->max_slice_us = slice_us;
+        }
+        #endif
+
+        if (kind == MP_VM_RETURN_YIELD) {
+            continue;
+        }
+
+        // The task is done.  Let anything that's neither a CancelledError nor
+        // an Exception (eg KeyboardInterrupt) propagate to the caller.
+        bool is_stop = kind == MP_VM_RETURN_NORMAL;
+        bool is_cancel = false;
+        if (!is_stop) {
+            mp_obj_t exc_type = MP_OBJ_FROM_PTR(mp_obj_get_type(ret));
+            is_stop = mp_obj_is_subclass_fast(exc_type, MP_OBJ_FROM_PTR(&mp_type_StopIteration));
+            is_cancel = mp_obj_is_subclass_fast(exc_type, cancelled_error);
+            if (!is_cancel && !mp_obj_is_subclass_fast(exc_type, MP_OBJ_FROM_PTR(&mp_type_Exception))) {
+                nlr_raise(ret);
+            }
+        }
+
+        // If it's the main task then the loop should stop.
+        if (t_in == main_task_in) {
+            if (kind == MP_VM_RETURN_NORMAL) {
+                return ret;
+            }
+            if (is_stop) {
+                return mp_obj_exception_get_value(ret);
+            }
+            nlr_raise(ret);
+        }
+
+        if (!TASK_IS_DONE(t)) {
+            // Task was running but is now finished.
+            bool waiting = false;
+            if (t->state == TASK_STATE_RUNNING_NOT_WAITED_ON) {
+                // Task is not await'ed on (yet).
+                t->state = TASK_STATE_DONE_NOT_WAITED_ON;
+            } else {
+                // Schedule any tasks waiting on the completion of this task.
+                mp_obj_task_queue_t *wq = MP_OBJ_TO_PTR(t->state);
+                while (task_queue_next(wq) != NULL) {
+                    mp_obj_t args[2] = { task_queue_in, task_queue_pop_head(t->state) };
+                    task_queue_push_sorted(2, args);
+                    waiting = true;
+                }
+                t->state = TASK_STATE_DONE_WAS_WAITED_ON;
+            }
+            if (!waiting && !is_stop && !is_cancel) {
+                // An exception ended this detached task, so queue it for
+                // later execution to handle the uncaught exception if no
+                // other task retrieves the exception in the meantime.
+                mp_obj_t args[2] = { task_queue_in, t_in };
+                task_queue_push_sorted(2, args);
+            }
+            // Save the outcome of the coroutine to pass up to anything
+            // awaiting it; a plain return is wrapped in a StopIteration so
+            // Task.__next__ can raise it into the awaiting task.
+            if (kind == MP_VM_RETURN_NORMAL) {
+                t->data = ret == mp_const_none
+                    ? mp_obj_new_exception(&mp_type_StopIteration)
+                    : mp_obj_new_exception_args(&mp_type_StopIteration, 1, &ret);
+            } else {
+                t->data = ret;
+            }
+        } else if (t->state == TASK_STATE_DONE_NOT_WAITED_ON) {
+            // Task is already finished and nothing await'ed on it, so call
+            // the exception handler with the exception that was thrown in.
+            mp_obj_t exc_context = mp_obj_dict_get(context, MP_OBJ_NEW_QSTR(MP_QSTR__exc_context));
+            mp_obj_subscr(exc_context, MP_OBJ_NEW_QSTR(MP_QSTR_exception), exc);
+            mp_obj_subscr(exc_context, MP_OBJ_NEW_QSTR(MP_QSTR_future), t_in);
+            mp_obj_t dest[3];
+            mp_load_method(mp_obj_dict_get(context, MP_OBJ_NEW_QSTR(MP_QSTR_Loop)), MP_QSTR_call_exception_handler, dest);
+            dest[2] = exc_context;
+            mp_call_method_n_kw(1, 0, dest);
+        }
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(uasyncio_run_until_complete_obj, uasyncio_run_until_complete);
+
 /******************************************************************************/
 // C-level uasyncio module
 
@@ -301,6 +1354,17 @@ STATIC const mp_rom_map_elem_t mp_module_uasyncio_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR__uasyncio) },
     { MP_ROM_QSTR(MP_QSTR_TaskQueue), MP_ROM_PTR(&task_queue_type) },
     { MP_ROM_QSTR(MP_QSTR_Task), MP_ROM_PTR(&task_type) },
+    { MP_ROM_QSTR(MP_QSTR_Event), MP_ROM_PTR(&event_type) },
+    #if MICROPY_PY_UASYNCIO_TSQUEUE
+    { MP_ROM_QSTR(MP_QSTR_ThreadSafeQueue), MP_ROM_PTR(&tsqueue_type) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_run_until_complete), MP_ROM_PTR(&uasyncio_run_until_complete_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sleep_ms), MP_ROM_PTR(&uasyncio_sleep_ms_obj) },
+    #if MICROPY_PY_UASYNCIO_STREAM
+    { MP_ROM_QSTR(MP_QSTR_stream_read), MP_ROM_PTR(&uasyncio_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stream_readline), MP_ROM_PTR(&uasyncio_stream_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stream_write), MP_ROM_PTR(&uasyncio_stream_write_obj) },
+    #endif
 };
 STATIC MP_DEFINE_CONST_DICT(mp_module_uasyncio_globals, mp_module_uasyncio_globals_table);
 
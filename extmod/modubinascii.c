@@ -33,6 +33,31 @@
 
 #if MICROPY_PY_UBINASCII
 
+STATIC const char mod_binascii_hexdigits[16] = "0123456789abcdef";
+
+// Convert len bytes to 2*len hex digits.  Works two input bytes at a time:
+// the four nibbles are spread across a 32-bit word and converted to ASCII
+// in parallel, avoiding a table load per nibble.
+STATIC void mod_binascii_hexlify_kernel(const byte *in, size_t len, byte *out) {
+    while (len >= 2) {
+        uint32_t v = ((uint32_t)in[0] << 8) | in[1];
+        uint32_t x = ((v & 0xf000) << 12) | ((v & 0x0f00) << 8) | ((v & 0x00f0) << 4) | (v & 0x000f);
+        // per-byte flag for nibbles above 9, then 0-9 -> '0'-'9', 10-15 -> 'a'-'f'
+        uint32_t gt9 = ((x + 0x06060606) & 0x10101010) >> 4;
+        x += 0x30303030 + gt9 * ('a' - '0' - 10);
+        *out++ = x >> 24;
+        *out++ = x >> 16;
+        *out++ = x >> 8;
+        *out++ = x;
+        in += 2;
+        len -= 2;
+    }
+    if (len) {
+        *out++ = mod_binascii_hexdigits[*in >> 4];
+        *out = mod_binascii_hexdigits[*in & 0xf];
+    }
+}
+
 STATIC mp_obj_t mod_binascii_hexlify(size_t n_args, const mp_obj_t *args) {
     // First argument is the data to convert.
     // Second argument is an optional separator to be used between values.
@@ -55,25 +80,40 @@ STATIC mp_obj_t mod_binascii_hexlify(size_t n_args, const mp_obj_t *args) {
     }
     vstr_init_len(&vstr, out_len);
     byte *in = bufinfo.buf, *out = (byte *)vstr.buf;
-    for (mp_uint_t i = bufinfo.len; i--;) {
-        byte d = (*in >> 4);
-        if (d > 9) {
-            d += 'a' - '9' - 1;
-        }
-        *out++ = d + '0';
-        d = (*in++ & 0xf);
-        if (d > 9) {
-            d += 'a' - '9' - 1;
-        }
-        *out++ = d + '0';
-        if (sep != NULL && i != 0) {
-            *out++ = *sep;
+    if (sep == NULL) {
+        mod_binascii_hexlify_kernel(in, bufinfo.len, out);
+    } else {
+        for (mp_uint_t i = bufinfo.len; i--;) {
+            byte b = *in++;
+            *out++ = mod_binascii_hexdigits[b >> 4];
+            *out++ = mod_binascii_hexdigits[b & 0xf];
+            if (i != 0) {
+                *out++ = *sep;
+            }
         }
     }
     return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_binascii_hexlify_obj, 1, 2, mod_binascii_hexlify);
 
+#if MICROPY_PY_UBINASCII_HEXLIFY_INTO
+// hexlify_into(data, buf): hexlify data into a caller-provided buffer,
+// avoiding an output allocation per call; returns the number of bytes
+// written (2 * len(data))
+STATIC mp_obj_t mod_binascii_hexlify_into(mp_obj_t data_in, mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data_in, &bufinfo, MP_BUFFER_READ);
+    mp_buffer_info_t outinfo;
+    mp_get_buffer_raise(buf_in, &outinfo, MP_BUFFER_WRITE);
+    if (outinfo.len < 2 * bufinfo.len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("output too small"));
+    }
+    mod_binascii_hexlify_kernel(bufinfo.buf, bufinfo.len, outinfo.buf);
+    return mp_obj_new_int_from_uint(2 * bufinfo.len);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_binascii_hexlify_into_obj, mod_binascii_hexlify_into);
+#endif
+
 STATIC mp_obj_t mod_binascii_unhexlify(mp_obj_t data) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
@@ -172,45 +212,28 @@ STATIC mp_obj_t mod_binascii_b2a_base64(mp_obj_t data) {
     vstr_t vstr;
     vstr_init_len(&vstr, ((bufinfo.len != 0) ? (((bufinfo.len - 1) / 3) + 1) * 4 : 0) + 1);
 
-    // First pass, we convert input buffer to numeric base 64 values
+    // Encode 3 input bytes to 4 output characters in a single table-driven pass
+    static const char base64_table[64] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     byte *in = bufinfo.buf, *out = (byte *)vstr.buf;
     mp_uint_t i;
     for (i = bufinfo.len; i >= 3; i -= 3) {
-        *out++ = (in[0] & 0xFC) >> 2;
-        *out++ = (in[0] & 0x03) << 4 | (in[1] & 0xF0) >> 4;
-        *out++ = (in[1] & 0x0F) << 2 | (in[2] & 0xC0) >> 6;
-        *out++ = in[2] & 0x3F;
+        *out++ = base64_table[(in[0] & 0xFC) >> 2];
+        *out++ = base64_table[(in[0] & 0x03) << 4 | (in[1] & 0xF0) >> 4];
+        *out++ = base64_table[(in[1] & 0x0F) << 2 | (in[2] & 0xC0) >> 6];
+        *out++ = base64_table[in[2] & 0x3F];
         in += 3;
     }
     if (i != 0) {
-        *out++ = (in[0] & 0xFC) >> 2;
+        *out++ = base64_table[(in[0] & 0xFC) >> 2];
         if (i == 2) {
-            *out++ = (in[0] & 0x03) << 4 | (in[1] & 0xF0) >> 4;
-            *out++ = (in[1] & 0x0F) << 2;
+            *out++ = base64_table[(in[0] & 0x03) << 4 | (in[1] & 0xF0) >> 4];
+            *out++ = base64_table[(in[1] & 0x0F) << 2];
         } else {
-            *out++ = (in[0] & 0x03) << 4;
-            *out++ = 64;
+            *out++ = base64_table[(in[0] & 0x03) << 4];
+            *out++ = '=';
         }
-        *out = 64;
-    }
-
-    // Second pass, we convert number base 64 values to actual base64 ascii encoding
-    out = (byte *)vstr.buf;
-    for (mp_uint_t j = vstr.len - 1; j--;) {
-        if (*out < 26) {
-            *out += 'A';
-        } else if (*out < 52) {
-            *out += 'a' - 26;
-        } else if (*out < 62) {
-            *out += '0' - 52;
-        } else if (*out == 62) {
-            *out = '+';
-        } else if (*out == 63) {
-            *out = '/';
-        } else {
-            *out = '=';
-        }
-        out++;
+        *out++ = '=';
     }
     *out = '\n';
     return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
@@ -224,7 +247,8 @@ STATIC mp_obj_t mod_binascii_crc32(size_t n_args, const mp_obj_t *args) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
     uint32_t crc = (n_args > 1) ? mp_obj_get_int_truncated(args[1]) : 0;
-    crc = uzlib_crc32(bufinfo.buf, bufinfo.len, crc ^ 0xffffffff);
+    MP_THREAD_GIL_RELEASED(bufinfo.len >= 1024,
+        crc = uzlib_crc32(bufinfo.buf, bufinfo.len, crc ^ 0xffffffff));
     return mp_obj_new_int_from_uint(crc ^ 0xffffffff);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_binascii_crc32_obj, 1, 2, mod_binascii_crc32);
@@ -233,6 +257,9 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_binascii_crc32_obj, 1, 2, mod_bin
 STATIC const mp_rom_map_elem_t mp_module_binascii_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ubinascii) },
     { MP_ROM_QSTR(MP_QSTR_hexlify), MP_ROM_PTR(&mod_binascii_hexlify_obj) },
+    #if MICROPY_PY_UBINASCII_HEXLIFY_INTO
+    { MP_ROM_QSTR(MP_QSTR_hexlify_into), MP_ROM_PTR(&mod_binascii_hexlify_into_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_unhexlify), MP_ROM_PTR(&mod_binascii_unhexlify_obj) },
     { MP_ROM_QSTR(MP_QSTR_a2b_base64), MP_ROM_PTR(&mod_binascii_a2b_base64_obj) },
     { MP_ROM_QSTR(MP_QSTR_b2a_base64), MP_ROM_PTR(&mod_binascii_b2a_base64_obj) },
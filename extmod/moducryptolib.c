@@ -54,13 +54,30 @@ struct ctr_params {
     uint8_t encrypted_counter[16];
 };
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_SSL_AXTLS && !MICROPY_PY_UCRYPTOLIB_PORT_IMPL
 #include "lib/axtls/crypto/crypto.h"
 
 #define AES_CTX_IMPL AES_CTX
 #endif
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UCRYPTOLIB_PORT_IMPL
+// The port provides the AES implementation (typically a hardware engine,
+// possibly using DMA for the bulk CBC/CTR cases): mp_hal_aes_context_t
+// defined in mphalport.h, and the mp_hal_aes_* functions declared below.
+#include "py/mphal.h"
+
+void mp_hal_aes_set_key(mp_hal_aes_context_t *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]);
+void mp_hal_aes_start(mp_hal_aes_context_t *ctx, bool encrypt);
+void mp_hal_aes_ecb(mp_hal_aes_context_t *ctx, const uint8_t in[16], uint8_t out[16], bool encrypt);
+void mp_hal_aes_cbc(mp_hal_aes_context_t *ctx, const uint8_t *in, uint8_t *out, size_t len, bool encrypt);
+#if MICROPY_PY_UCRYPTOLIB_CTR
+void mp_hal_aes_ctr(mp_hal_aes_context_t *ctx, const uint8_t *in, uint8_t *out, size_t len, size_t *offset, uint8_t encrypted_counter[16]);
+#endif
+
+#define AES_CTX_IMPL mp_hal_aes_context_t
+#endif
+
+#if MICROPY_SSL_MBEDTLS && !MICROPY_PY_UCRYPTOLIB_PORT_IMPL
 #include <mbedtls/aes.h>
 
 // we can't run mbedtls AES key schedule until we know whether we're used for encrypt or decrypt.
@@ -102,7 +119,33 @@ static inline struct ctr_params *ctr_params_from_aes(mp_obj_aes_t *o) {
     return (struct ctr_params *)&o[1];
 }
 
-#if MICROPY_SSL_AXTLS
+#if MICROPY_PY_UCRYPTOLIB_PORT_IMPL
+STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
+    assert(16 == keysize || 32 == keysize);
+    mp_hal_aes_set_key(ctx, key, keysize, iv);
+}
+
+STATIC void aes_final_set_key_impl(AES_CTX_IMPL *ctx, bool encrypt) {
+    mp_hal_aes_start(ctx, encrypt);
+}
+
+STATIC void aes_process_ecb_impl(AES_CTX_IMPL *ctx, const uint8_t in[16], uint8_t out[16], bool encrypt) {
+    mp_hal_aes_ecb(ctx, in, out, encrypt);
+}
+
+STATIC void aes_process_cbc_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *out, size_t in_len, bool encrypt) {
+    mp_hal_aes_cbc(ctx, in, out, in_len, encrypt);
+}
+
+#if MICROPY_PY_UCRYPTOLIB_CTR
+STATIC void aes_process_ctr_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *out, size_t in_len, struct ctr_params *ctr_params) {
+    mp_hal_aes_ctr(ctx, in, out, in_len, &ctr_params->offset, ctr_params->encrypted_counter);
+}
+#endif
+
+#endif
+
+#if MICROPY_SSL_AXTLS && !MICROPY_PY_UCRYPTOLIB_PORT_IMPL
 STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
     assert(16 == keysize || 32 == keysize);
     AES_set_key(ctx, key, iv, (16 == keysize) ? AES_MODE_128 : AES_MODE_256);
@@ -168,7 +211,7 @@ STATIC void aes_process_ctr_impl(AES_CTX_IMPL *ctx, const uint8_t *in, uint8_t *
 
 #endif
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_SSL_MBEDTLS && !MICROPY_PY_UCRYPTOLIB_PORT_IMPL
 STATIC void aes_initial_set_key_impl(AES_CTX_IMPL *ctx, const uint8_t *key, size_t keysize, const uint8_t iv[16]) {
     ctx->u.init_data.keysize = keysize;
     memcpy(ctx->u.init_data.key, key, keysize);
@@ -305,6 +348,13 @@ STATIC mp_obj_t aes_process(size_t n_args, const mp_obj_t *args, bool encrypt) {
         }
     }
 
+    // The cipher core below is pure C over pinned buffers, so release the
+    // GIL around it for large inputs and let other threads keep running.
+    bool release_gil = in_bufinfo.len >= 256;
+    if (release_gil) {
+        MP_THREAD_GIL_EXIT();
+    }
+
     switch (self->block_mode) {
         case UCRYPTOLIB_MODE_ECB: {
             uint8_t *in = in_bufinfo.buf, *out = out_buf_ptr;
@@ -327,6 +377,10 @@ STATIC mp_obj_t aes_process(size_t n_args, const mp_obj_t *args, bool encrypt) {
         #endif
     }
 
+    if (release_gil) {
+        MP_THREAD_GIL_ENTER();
+    }
+
     if (out_buf != MP_OBJ_NULL) {
         return out_buf;
     }
@@ -87,22 +87,40 @@ typedef struct _mp_obj_uctypes_struct_t {
     mp_obj_t desc;
     byte *addr;
     uint32_t flags;
+    #if MICROPY_PY_UCTYPES_ATTR_CACHE
+    // MRU cache of the last attribute resolved in the descriptor dict, so
+    // repeated access to the same field skips the dict lookup.  Assumes the
+    // descriptor isn't mutated while structs built from it are in use.
+    qstr last_attr;
+    mp_obj_t last_deref;
+    #endif
 } mp_obj_uctypes_struct_t;
 
 STATIC NORETURN void syntax_error(void) {
     mp_raise_TypeError(MP_ERROR_TEXT("syntax error in uctypes descriptor"));
 }
 
+STATIC mp_obj_uctypes_struct_t *uctypes_struct_new(mp_obj_t desc, byte *addr, uint32_t flags) {
+    mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
+    o->base.type = &uctypes_struct_type;
+    o->desc = desc;
+    o->addr = addr;
+    o->flags = flags;
+    #if MICROPY_PY_UCTYPES_ATTR_CACHE
+    o->last_attr = (qstr)0;
+    o->last_deref = MP_OBJ_NULL;
+    #endif
+    return o;
+}
+
 STATIC mp_obj_t uctypes_struct_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    (void)type;
     mp_arg_check_num(n_args, n_kw, 2, 3, false);
-    mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-    o->base.type = type;
-    o->addr = (void *)(uintptr_t)mp_obj_int_get_truncated(args[0]);
-    o->desc = args[1];
-    o->flags = LAYOUT_NATIVE;
+    uint32_t flags = LAYOUT_NATIVE;
     if (n_args == 3) {
-        o->flags = mp_obj_get_int(args[2]);
+        flags = mp_obj_get_int(args[2]);
     }
+    mp_obj_uctypes_struct_t *o = uctypes_struct_new(args[1], (void *)(uintptr_t)mp_obj_int_get_truncated(args[0]), flags);
     return MP_OBJ_FROM_PTR(o);
 }
 
@@ -387,7 +405,18 @@ STATIC mp_obj_t uctypes_struct_attr_op(mp_obj_t self_in, qstr attr, mp_obj_t set
         mp_raise_TypeError(MP_ERROR_TEXT("struct: no fields"));
     }
 
-    mp_obj_t deref = mp_obj_dict_get(self->desc, MP_OBJ_NEW_QSTR(attr));
+    mp_obj_t deref;
+    #if MICROPY_PY_UCTYPES_ATTR_CACHE
+    if (attr == self->last_attr) {
+        deref = self->last_deref;
+    } else {
+        deref = mp_obj_dict_get(self->desc, MP_OBJ_NEW_QSTR(attr));
+        self->last_attr = attr;
+        self->last_deref = deref;
+    }
+    #else
+    deref = mp_obj_dict_get(self->desc, MP_OBJ_NEW_QSTR(attr));
+    #endif
     if (mp_obj_is_small_int(deref)) {
         mp_int_t offset = MP_OBJ_SMALL_INT_VALUE(deref);
         mp_uint_t val_type = GET_TYPE(offset, VAL_TYPE_BITS);
@@ -463,11 +492,7 @@ STATIC mp_obj_t uctypes_struct_attr_op(mp_obj_t self_in, qstr attr, mp_obj_t set
 
     switch (agg_type) {
         case STRUCT: {
-            mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-            o->base.type = &uctypes_struct_type;
-            o->desc = sub->items[1];
-            o->addr = self->addr + offset;
-            o->flags = self->flags;
+            mp_obj_uctypes_struct_t *o = uctypes_struct_new(sub->items[1], self->addr + offset, self->flags);
             return MP_OBJ_FROM_PTR(o);
         }
         case ARRAY: {
@@ -479,11 +504,7 @@ STATIC mp_obj_t uctypes_struct_attr_op(mp_obj_t self_in, qstr attr, mp_obj_t set
             MP_FALLTHROUGH
         }
         case PTR: {
-            mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-            o->base.type = &uctypes_struct_type;
-            o->desc = MP_OBJ_FROM_PTR(sub);
-            o->addr = self->addr + offset;
-            o->flags = self->flags;
+            mp_obj_uctypes_struct_t *o = uctypes_struct_new(MP_OBJ_FROM_PTR(sub), self->addr + offset, self->flags);
             return MP_OBJ_FROM_PTR(o);
         }
     }
@@ -552,11 +573,7 @@ STATIC mp_obj_t uctypes_struct_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_ob
             } else if (value == MP_OBJ_SENTINEL) {
                 mp_uint_t dummy = 0;
                 mp_uint_t size = uctypes_struct_size(t->items[2], self->flags, &dummy);
-                mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-                o->base.type = &uctypes_struct_type;
-                o->desc = t->items[2];
-                o->addr = self->addr + size * index;
-                o->flags = self->flags;
+                mp_obj_uctypes_struct_t *o = uctypes_struct_new(t->items[2], self->addr + size * index, self->flags);
                 return MP_OBJ_FROM_PTR(o);
             } else {
                 return MP_OBJ_NULL; // op not supported
@@ -570,11 +587,7 @@ STATIC mp_obj_t uctypes_struct_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_ob
             } else {
                 mp_uint_t dummy = 0;
                 mp_uint_t size = uctypes_struct_size(t->items[1], self->flags, &dummy);
-                mp_obj_uctypes_struct_t *o = m_new_obj(mp_obj_uctypes_struct_t);
-                o->base.type = &uctypes_struct_type;
-                o->desc = t->items[1];
-                o->addr = p + size * index;
-                o->flags = self->flags;
+                mp_obj_uctypes_struct_t *o = uctypes_struct_new(t->items[1], p + size * index, self->flags);
                 return MP_OBJ_FROM_PTR(o);
             }
         }
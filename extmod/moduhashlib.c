@@ -37,7 +37,15 @@
 
 #if MICROPY_PY_UHASHLIB_SHA256
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UHASHLIB_SHA256_PORT_IMPL
+// The port provides the SHA-256 implementation (typically a hardware
+// engine): mp_hal_sha256_context_t defined in mphalport.h, and the
+// mp_hal_sha256_* functions declared below.
+#include "py/mphal.h"
+void mp_hal_sha256_init(mp_hal_sha256_context_t *ctx);
+void mp_hal_sha256_update(mp_hal_sha256_context_t *ctx, const uint8_t *data, size_t len);
+void mp_hal_sha256_final(mp_hal_sha256_context_t *ctx, uint8_t digest[32]);
+#elif MICROPY_SSL_MBEDTLS
 #include "mbedtls/sha256.h"
 #else
 #include "lib/crypto-algorithms/sha256.h"
@@ -58,6 +66,11 @@
 
 #endif
 
+// Hashing is pure C code over a pinned buffer, so updates at least this
+// big run with the GIL released; below it the two GIL transitions would
+// cost more than they save.
+#define UHASHLIB_GIL_MIN_LEN (512)
+
 typedef struct _mp_obj_hash_t {
     mp_obj_base_t base;
     bool final; // if set, update and digest raise an exception
@@ -70,10 +83,92 @@ static void uhashlib_ensure_not_final(mp_obj_hash_t *self) {
     }
 }
 
+#if MICROPY_PY_UHASHLIB_UPDATE_FROM
+
+#include "py/stream.h"
+
+typedef void (*uhashlib_update_raw_t)(mp_obj_hash_t *self, const byte *data, size_t len);
+
+// Shared implementation of hash.update_from(stream, nbytes=-1): pump up to
+// nbytes (to EOF if negative or None) from the stream straight into the
+// hash through a small stack buffer, so no bytes object is created per
+// chunk.  Returns the number of bytes hashed.
+STATIC mp_obj_t uhashlib_update_from_helper(size_t n_args, const mp_obj_t *args, uhashlib_update_raw_t update_raw) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(args[0]);
+    uhashlib_ensure_not_final(self);
+    mp_int_t remain = -1;
+    if (n_args > 2 && args[2] != mp_const_none) {
+        remain = mp_obj_get_int(args[2]);
+    }
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(args[1], MP_STREAM_OP_READ);
+    byte buf[256];
+    mp_uint_t total = 0;
+    while (remain != 0) {
+        mp_uint_t to_read = sizeof(buf);
+        if (remain > 0 && (mp_uint_t)remain < to_read) {
+            to_read = remain;
+        }
+        int errcode;
+        mp_uint_t out_sz = stream_p->read(args[1], buf, to_read, &errcode);
+        if (out_sz == MP_STREAM_ERROR) {
+            mp_raise_OSError(errcode);
+        }
+        if (out_sz == 0) {
+            break;
+        }
+        update_raw(self, buf, out_sz);
+        total += out_sz;
+        if (remain > 0) {
+            remain -= out_sz;
+        }
+    }
+    return mp_obj_new_int_from_uint(total);
+}
+
+#endif // MICROPY_PY_UHASHLIB_UPDATE_FROM
+
 #if MICROPY_PY_UHASHLIB_SHA256
 STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg);
 
-#if MICROPY_SSL_MBEDTLS
+#if MICROPY_PY_UHASHLIB_SHA256_PORT_IMPL
+
+STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    mp_obj_hash_t *o = m_new_obj_var(mp_obj_hash_t, char, sizeof(mp_hal_sha256_context_t));
+    o->base.type = type;
+    o->final = false;
+    mp_hal_sha256_init((mp_hal_sha256_context_t *)o->state);
+    if (n_args == 1) {
+        uhashlib_sha256_update(MP_OBJ_FROM_PTR(o), args[0]);
+    }
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC void uhashlib_sha256_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        mp_hal_sha256_update((mp_hal_sha256_context_t *)self->state, data, len));
+}
+
+STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    uhashlib_ensure_not_final(self);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
+    uhashlib_sha256_update_raw(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+
+STATIC mp_obj_t uhashlib_sha256_digest(mp_obj_t self_in) {
+    mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
+    uhashlib_ensure_not_final(self);
+    self->final = true;
+    vstr_t vstr;
+    vstr_init_len(&vstr, 32);
+    mp_hal_sha256_final((mp_hal_sha256_context_t *)self->state, (uint8_t *)vstr.buf);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+
+#elif MICROPY_SSL_MBEDTLS
 
 #if MBEDTLS_VERSION_NUMBER < 0x02070000
 #define mbedtls_sha256_starts_ret mbedtls_sha256_starts
@@ -94,12 +189,17 @@ STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_arg
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_sha256_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        mbedtls_sha256_update_ret((mbedtls_sha256_context *)&self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    mbedtls_sha256_update_ret((mbedtls_sha256_context *)&self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_sha256_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -129,12 +229,17 @@ STATIC mp_obj_t uhashlib_sha256_make_new(const mp_obj_type_t *type, size_t n_arg
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_sha256_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        sha256_update((CRYAL_SHA256_CTX *)self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_sha256_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    sha256_update((CRYAL_SHA256_CTX *)self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_sha256_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -149,11 +254,21 @@ STATIC mp_obj_t uhashlib_sha256_digest(mp_obj_t self_in) {
 }
 #endif
 
+#if MICROPY_PY_UHASHLIB_UPDATE_FROM
+STATIC mp_obj_t uhashlib_sha256_update_from(size_t n_args, const mp_obj_t *args) {
+    return uhashlib_update_from_helper(n_args, args, uhashlib_sha256_update_raw);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(uhashlib_sha256_update_from_obj, 2, 3, uhashlib_sha256_update_from);
+#endif
+
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(uhashlib_sha256_update_obj, uhashlib_sha256_update);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(uhashlib_sha256_digest_obj, uhashlib_sha256_digest);
 
 STATIC const mp_rom_map_elem_t uhashlib_sha256_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&uhashlib_sha256_update_obj) },
+    #if MICROPY_PY_UHASHLIB_UPDATE_FROM
+    { MP_ROM_QSTR(MP_QSTR_update_from), MP_ROM_PTR(&uhashlib_sha256_update_from_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_digest), MP_ROM_PTR(&uhashlib_sha256_digest_obj) },
 };
 
@@ -183,12 +298,17 @@ STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args,
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_sha1_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        SHA1_Update((SHA1_CTX *)self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    SHA1_Update((SHA1_CTX *)self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_sha1_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -224,12 +344,17 @@ STATIC mp_obj_t uhashlib_sha1_make_new(const mp_obj_type_t *type, size_t n_args,
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_sha1_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        mbedtls_sha1_update_ret((mbedtls_sha1_context *)self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_sha1_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    mbedtls_sha1_update_ret((mbedtls_sha1_context *)self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_sha1_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -245,11 +370,21 @@ STATIC mp_obj_t uhashlib_sha1_digest(mp_obj_t self_in) {
 }
 #endif
 
+#if MICROPY_PY_UHASHLIB_UPDATE_FROM
+STATIC mp_obj_t uhashlib_sha1_update_from(size_t n_args, const mp_obj_t *args) {
+    return uhashlib_update_from_helper(n_args, args, uhashlib_sha1_update_raw);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(uhashlib_sha1_update_from_obj, 2, 3, uhashlib_sha1_update_from);
+#endif
+
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(uhashlib_sha1_update_obj, uhashlib_sha1_update);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(uhashlib_sha1_digest_obj, uhashlib_sha1_digest);
 
 STATIC const mp_rom_map_elem_t uhashlib_sha1_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&uhashlib_sha1_update_obj) },
+    #if MICROPY_PY_UHASHLIB_UPDATE_FROM
+    { MP_ROM_QSTR(MP_QSTR_update_from), MP_ROM_PTR(&uhashlib_sha1_update_from_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_digest), MP_ROM_PTR(&uhashlib_sha1_digest_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(uhashlib_sha1_locals_dict, uhashlib_sha1_locals_dict_table);
@@ -278,12 +413,17 @@ STATIC mp_obj_t uhashlib_md5_make_new(const mp_obj_type_t *type, size_t n_args,
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_md5_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        MD5_Update((MD5_CTX *)self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_md5_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    MD5_Update((MD5_CTX *)self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_md5_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -319,12 +459,17 @@ STATIC mp_obj_t uhashlib_md5_make_new(const mp_obj_type_t *type, size_t n_args,
     return MP_OBJ_FROM_PTR(o);
 }
 
+STATIC void uhashlib_md5_update_raw(mp_obj_hash_t *self, const byte *data, size_t len) {
+    MP_THREAD_GIL_RELEASED(len >= UHASHLIB_GIL_MIN_LEN,
+        mbedtls_md5_update_ret((mbedtls_md5_context *)self->state, data, len));
+}
+
 STATIC mp_obj_t uhashlib_md5_update(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_hash_t *self = MP_OBJ_TO_PTR(self_in);
     uhashlib_ensure_not_final(self);
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
-    mbedtls_md5_update_ret((mbedtls_md5_context *)self->state, bufinfo.buf, bufinfo.len);
+    uhashlib_md5_update_raw(self, bufinfo.buf, bufinfo.len);
     return mp_const_none;
 }
 
@@ -340,11 +485,21 @@ STATIC mp_obj_t uhashlib_md5_digest(mp_obj_t self_in) {
 }
 #endif // MICROPY_SSL_MBEDTLS
 
+#if MICROPY_PY_UHASHLIB_UPDATE_FROM
+STATIC mp_obj_t uhashlib_md5_update_from(size_t n_args, const mp_obj_t *args) {
+    return uhashlib_update_from_helper(n_args, args, uhashlib_md5_update_raw);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(uhashlib_md5_update_from_obj, 2, 3, uhashlib_md5_update_from);
+#endif
+
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(uhashlib_md5_update_obj, uhashlib_md5_update);
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(uhashlib_md5_digest_obj, uhashlib_md5_digest);
 
 STATIC const mp_rom_map_elem_t uhashlib_md5_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&uhashlib_md5_update_obj) },
+    #if MICROPY_PY_UHASHLIB_UPDATE_FROM
+    { MP_ROM_QSTR(MP_QSTR_update_from), MP_ROM_PTR(&uhashlib_md5_update_from_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_digest), MP_ROM_PTR(&uhashlib_md5_digest_obj) },
 };
 STATIC MP_DEFINE_CONST_DICT(uhashlib_md5_locals_dict, uhashlib_md5_locals_dict_table);
@@ -25,6 +25,7 @@
  */
 
 #include "py/objlist.h"
+#include "py/objtuple.h"
 #include "py/runtime.h"
 
 #if MICROPY_PY_UHEAPQ
@@ -38,12 +39,44 @@ STATIC mp_obj_list_t *uheapq_get_heap(mp_obj_t heap_in) {
     return MP_OBJ_TO_PTR(heap_in);
 }
 
-STATIC void uheapq_heap_siftdown(mp_obj_list_t *heap, mp_uint_t start_pos, mp_uint_t pos) {
+// As mp_binary_op(MP_BINARY_OP_LESS, ...) but with a fast path for small-int
+// entries and for the common (small-int priority, item) tuple entries, which
+// skips the generic dispatch (and, for tuples, the element-wise compare when
+// the priorities alone decide the order).
+STATIC mp_obj_t uheapq_binop_less(mp_obj_t a, mp_obj_t b) {
+    if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+        return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b) ? mp_const_true : mp_const_false;
+    }
+    if (mp_obj_is_type(a, &mp_type_tuple) && mp_obj_is_type(b, &mp_type_tuple)) {
+        mp_obj_tuple_t *ta = MP_OBJ_TO_PTR(a);
+        mp_obj_tuple_t *tb = MP_OBJ_TO_PTR(b);
+        if (ta->len != 0 && tb->len != 0
+            && mp_obj_is_small_int(ta->items[0]) && mp_obj_is_small_int(tb->items[0])
+            && ta->items[0] != tb->items[0]) {
+            return MP_OBJ_SMALL_INT_VALUE(ta->items[0]) < MP_OBJ_SMALL_INT_VALUE(tb->items[0]) ? mp_const_true : mp_const_false;
+        }
+        // equal priorities: fall through to the full lexicographic compare
+    }
+    return mp_binary_op(MP_BINARY_OP_LESS, a, b);
+}
+
+// true if a sorts before b in the heap order; max_heap inverts the order and
+// is used by the bounded heaps that nlargest/nsmallest maintain
+STATIC bool uheapq_heap_before(mp_obj_t a, mp_obj_t b, bool max_heap) {
+    if (max_heap) {
+        mp_obj_t t = a;
+        a = b;
+        b = t;
+    }
+    return uheapq_binop_less(a, b) == mp_const_true;
+}
+
+STATIC void uheapq_heap_siftdown(mp_obj_list_t *heap, mp_uint_t start_pos, mp_uint_t pos, bool max_heap) {
     mp_obj_t item = heap->items[pos];
     while (pos > start_pos) {
         mp_uint_t parent_pos = (pos - 1) >> 1;
         mp_obj_t parent = heap->items[parent_pos];
-        if (mp_binary_op(MP_BINARY_OP_LESS, item, parent) == mp_const_true) {
+        if (uheapq_heap_before(item, parent, max_heap)) {
             heap->items[pos] = parent;
             pos = parent_pos;
         } else {
@@ -53,27 +86,33 @@ STATIC void uheapq_heap_siftdown(mp_obj_list_t *heap, mp_uint_t start_pos, mp_ui
     heap->items[pos] = item;
 }
 
-STATIC void uheapq_heap_siftup(mp_obj_list_t *heap, mp_uint_t pos) {
+STATIC void uheapq_heap_siftup(mp_obj_list_t *heap, mp_uint_t pos, bool max_heap) {
     mp_uint_t start_pos = pos;
     mp_uint_t end_pos = heap->len;
     mp_obj_t item = heap->items[pos];
     for (mp_uint_t child_pos = 2 * pos + 1; child_pos < end_pos; child_pos = 2 * pos + 1) {
-        // choose right child if it's <= left child
-        if (child_pos + 1 < end_pos && mp_binary_op(MP_BINARY_OP_LESS, heap->items[child_pos], heap->items[child_pos + 1]) == mp_const_false) {
+        // choose right child if it sorts at or before the left child
+        if (child_pos + 1 < end_pos && !uheapq_heap_before(heap->items[child_pos], heap->items[child_pos + 1], max_heap)) {
             child_pos += 1;
         }
-        // bubble up the smaller child
+        // bubble up the chosen child
         heap->items[pos] = heap->items[child_pos];
         pos = child_pos;
     }
     heap->items[pos] = item;
-    uheapq_heap_siftdown(heap, start_pos, pos);
+    uheapq_heap_siftdown(heap, start_pos, pos, max_heap);
+}
+
+STATIC void uheapq_heapify(mp_obj_list_t *heap, bool max_heap) {
+    for (mp_uint_t i = heap->len / 2; i > 0;) {
+        uheapq_heap_siftup(heap, --i, max_heap);
+    }
 }
 
 STATIC mp_obj_t mod_uheapq_heappush(mp_obj_t heap_in, mp_obj_t item) {
     mp_obj_list_t *heap = uheapq_get_heap(heap_in);
     mp_obj_list_append(heap_in, item);
-    uheapq_heap_siftdown(heap, 0, heap->len - 1);
+    uheapq_heap_siftdown(heap, 0, heap->len - 1, false);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_uheapq_heappush_obj, mod_uheapq_heappush);
@@ -88,27 +127,110 @@ STATIC mp_obj_t mod_uheapq_heappop(mp_obj_t heap_in) {
     heap->items[0] = heap->items[heap->len];
     heap->items[heap->len] = MP_OBJ_NULL; // so we don't retain a pointer
     if (heap->len) {
-        uheapq_heap_siftup(heap, 0);
+        uheapq_heap_siftup(heap, 0, false);
     }
     return item;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_uheapq_heappop_obj, mod_uheapq_heappop);
 
-STATIC mp_obj_t mod_uheapq_heapify(mp_obj_t heap_in) {
+// push then pop in one operation, sifting at most once
+STATIC mp_obj_t mod_uheapq_heappushpop(mp_obj_t heap_in, mp_obj_t item) {
     mp_obj_list_t *heap = uheapq_get_heap(heap_in);
-    for (mp_uint_t i = heap->len / 2; i > 0;) {
-        uheapq_heap_siftup(heap, --i);
+    if (heap->len != 0 && uheapq_binop_less(heap->items[0], item) == mp_const_true) {
+        mp_obj_t t = heap->items[0];
+        heap->items[0] = item;
+        item = t;
+        uheapq_heap_siftup(heap, 0, false);
     }
+    return item;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_uheapq_heappushpop_obj, mod_uheapq_heappushpop);
+
+// pop then push in one operation; unlike heappushpop the pushed item is
+// never returned, so the heap size is unchanged
+STATIC mp_obj_t mod_uheapq_heapreplace(mp_obj_t heap_in, mp_obj_t item) {
+    mp_obj_list_t *heap = uheapq_get_heap(heap_in);
+    if (heap->len == 0) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty heap"));
+    }
+    mp_obj_t ret = heap->items[0];
+    heap->items[0] = item;
+    uheapq_heap_siftup(heap, 0, false);
+    return ret;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_uheapq_heapreplace_obj, mod_uheapq_heapreplace);
+
+STATIC mp_obj_t mod_uheapq_heapify(mp_obj_t heap_in) {
+    uheapq_heapify(uheapq_get_heap(heap_in), false);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_uheapq_heapify_obj, mod_uheapq_heapify);
 
+// Common implementation of nsmallest/nlargest: keep the n best entries seen
+// so far in a bounded heap whose order is inverted relative to the output,
+// so the worst kept entry sits at the root ready to be displaced.  Memory is
+// O(n) regardless of the length of the iterable.
+STATIC mp_obj_t uheapq_select(mp_obj_t n_in, mp_obj_t iterable, bool largest) {
+    mp_int_t n = mp_obj_get_int(n_in);
+    if (n < 0) {
+        n = 0;
+    }
+    bool max_heap = !largest;
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    mp_obj_list_t *heap = MP_OBJ_TO_PTR(list);
+    mp_obj_iter_buf_t iter_buf;
+    mp_obj_t iter = mp_getiter(iterable, &iter_buf);
+    mp_obj_t item;
+    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+        if (heap->len < (size_t)n) {
+            mp_obj_list_append(list, item);
+            if (heap->len == (size_t)n) {
+                uheapq_heapify(heap, max_heap);
+            }
+        } else if (n != 0 && uheapq_heap_before(item, heap->items[0], largest)) {
+            heap->items[0] = item;
+            uheapq_heap_siftup(heap, 0, max_heap);
+        }
+    }
+    if (heap->len != (size_t)n) {
+        // the iterable ran out before the heap filled, so it's not ordered yet
+        uheapq_heapify(heap, max_heap);
+    }
+    // repeatedly pop the root (the worst kept entry) to the end, leaving the
+    // list sorted in the output order: ascending for nsmallest, descending
+    // for nlargest
+    size_t total = heap->len;
+    while (heap->len > 1) {
+        mp_obj_t root = heap->items[0];
+        heap->len -= 1;
+        heap->items[0] = heap->items[heap->len];
+        heap->items[heap->len] = root;
+        uheapq_heap_siftup(heap, 0, max_heap);
+    }
+    heap->len = total;
+    return list;
+}
+
+STATIC mp_obj_t mod_uheapq_nsmallest(mp_obj_t n_in, mp_obj_t iterable) {
+    return uheapq_select(n_in, iterable, false);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_uheapq_nsmallest_obj, mod_uheapq_nsmallest);
+
+STATIC mp_obj_t mod_uheapq_nlargest(mp_obj_t n_in, mp_obj_t iterable) {
+    return uheapq_select(n_in, iterable, true);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_uheapq_nlargest_obj, mod_uheapq_nlargest);
+
 #if !MICROPY_ENABLE_DYNRUNTIME
 STATIC const mp_rom_map_elem_t mp_module_uheapq_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uheapq) },
     { MP_ROM_QSTR(MP_QSTR_heappush), MP_ROM_PTR(&mod_uheapq_heappush_obj) },
     { MP_ROM_QSTR(MP_QSTR_heappop), MP_ROM_PTR(&mod_uheapq_heappop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heappushpop), MP_ROM_PTR(&mod_uheapq_heappushpop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_heapreplace), MP_ROM_PTR(&mod_uheapq_heapreplace_obj) },
     { MP_ROM_QSTR(MP_QSTR_heapify), MP_ROM_PTR(&mod_uheapq_heapify_obj) },
+    { MP_ROM_QSTR(MP_QSTR_nsmallest), MP_ROM_PTR(&mod_uheapq_nsmallest_obj) },
+    { MP_ROM_QSTR(MP_QSTR_nlargest), MP_ROM_PTR(&mod_uheapq_nlargest_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_uheapq_globals, mp_module_uheapq_globals_table);
@@ -25,6 +25,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/objlist.h"
 #include "py/objstringio.h"
@@ -34,6 +35,37 @@
 
 #if MICROPY_PY_UJSON
 
+// dump() writes straight to the stream, but the JSON printer emits many
+// tiny pieces (separators, quotes, single numbers); batch them through a
+// small stack buffer so a big object doesn't become a write call per token.
+typedef struct _ujson_dump_buf_t {
+    mp_obj_t stream_obj;
+    size_t len;
+    byte buf[64];
+} ujson_dump_buf_t;
+
+STATIC void ujson_dump_flush(ujson_dump_buf_t *b) {
+    if (b->len != 0) {
+        mp_stream_write_adaptor(MP_OBJ_TO_PTR(b->stream_obj), (const char *)b->buf, b->len);
+        b->len = 0;
+    }
+}
+
+STATIC void ujson_dump_print_strn(void *data, const char *str, size_t len) {
+    ujson_dump_buf_t *b = (ujson_dump_buf_t *)data;
+    if (len >= sizeof(b->buf)) {
+        // Piece bigger than the buffer: pass it through directly.
+        ujson_dump_flush(b);
+        mp_stream_write_adaptor(MP_OBJ_TO_PTR(b->stream_obj), str, len);
+        return;
+    }
+    if (b->len + len > sizeof(b->buf)) {
+        ujson_dump_flush(b);
+    }
+    memcpy(b->buf + b->len, str, len);
+    b->len += len;
+}
+
 #if MICROPY_PY_UJSON_SEPARATORS
 
 enum {
@@ -70,10 +102,12 @@ STATIC mp_obj_t mod_ujson_dump_helper(size_t n_args, const mp_obj_t *pos_args, m
         return mp_obj_new_str_from_vstr(&mp_type_str, &vstr);
     } else {
         // dump(obj, stream)
-        print_ext.base.data = MP_OBJ_TO_PTR(pos_args[1]);
-        print_ext.base.print_strn = mp_stream_write_adaptor;
         mp_get_stream_raise(pos_args[1], MP_STREAM_OP_WRITE);
+        ujson_dump_buf_t dbuf = {pos_args[1], 0, {0}};
+        print_ext.base.data = &dbuf;
+        print_ext.base.print_strn = ujson_dump_print_strn;
         mp_obj_print_helper(&print_ext.base, pos_args[0], PRINT_JSON);
+        ujson_dump_flush(&dbuf);
         return mp_const_none;
     }
 }
@@ -92,8 +126,10 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mod_ujson_dumps_obj, 1, mod_ujson_dumps);
 
 STATIC mp_obj_t mod_ujson_dump(mp_obj_t obj, mp_obj_t stream) {
     mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
-    mp_print_t print = {MP_OBJ_TO_PTR(stream), mp_stream_write_adaptor};
+    ujson_dump_buf_t dbuf = {stream, 0, {0}};
+    mp_print_t print = {&dbuf, ujson_dump_print_strn};
     mp_obj_print_helper(&print, obj, PRINT_JSON);
+    ujson_dump_flush(&dbuf);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_ujson_dump_obj, mod_ujson_dump);
@@ -145,18 +181,127 @@ STATIC byte ujson_stream_next(ujson_stream_t *s) {
     return s->cur;
 }
 
-STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
-    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
-    vstr_t vstr;
-    vstr_init(&vstr, 8);
+// Parse one scalar (null, false, true, number or string).  cur is its first
+// character, already consumed from the stream; on return s->cur holds the
+// first character after the scalar.  Returns MP_OBJ_NULL on a syntax error.
+// With intern_str, a string is returned as a qstr: object keys repeat across
+// records, so interning makes every occurrence after the first allocation
+// free instead of a fresh heap string per record.
+STATIC mp_obj_t ujson_parse_scalar(ujson_stream_t *s, vstr_t *vstr, byte cur, bool intern_str) {
+    switch (cur) {
+        case 'n':
+            if (S_CUR(*s) == 'u' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 'l') {
+                S_NEXT(*s);
+                return mp_const_none;
+            }
+            return MP_OBJ_NULL;
+        case 'f':
+            if (S_CUR(*s) == 'a' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 's' && S_NEXT(*s) == 'e') {
+                S_NEXT(*s);
+                return mp_const_false;
+            }
+            return MP_OBJ_NULL;
+        case 't':
+            if (S_CUR(*s) == 'r' && S_NEXT(*s) == 'u' && S_NEXT(*s) == 'e') {
+                S_NEXT(*s);
+                return mp_const_true;
+            }
+            return MP_OBJ_NULL;
+        case '"':
+            vstr_reset(vstr);
+            for (; !S_END(*s) && S_CUR(*s) != '"';) {
+                byte c = S_CUR(*s);
+                if (c == '\\') {
+                    c = S_NEXT(*s);
+                    switch (c) {
+                        case 'b':
+                            c = 0x08;
+                            break;
+                        case 'f':
+                            c = 0x0c;
+                            break;
+                        case 'n':
+                            c = 0x0a;
+                            break;
+                        case 'r':
+                            c = 0x0d;
+                            break;
+                        case 't':
+                            c = 0x09;
+                            break;
+                        case 'u': {
+                            mp_uint_t num = 0;
+                            for (int i = 0; i < 4; i++) {
+                                c = (S_NEXT(*s) | 0x20) - '0';
+                                if (c > 9) {
+                                    c -= ('a' - ('9' + 1));
+                                }
+                                num = (num << 4) | c;
+                            }
+                            vstr_add_char(vstr, num);
+                            goto str_cont;
+                        }
+                    }
+                }
+                vstr_add_byte(vstr, c);
+            str_cont:
+                S_NEXT(*s);
+            }
+            if (S_END(*s)) {
+                return MP_OBJ_NULL;
+            }
+            S_NEXT(*s);
+            if (intern_str) {
+                return MP_OBJ_NEW_QSTR(qstr_from_strn(vstr->buf, vstr->len));
+            }
+            return mp_obj_new_str(vstr->buf, vstr->len);
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9': {
+            bool flt = false;
+            vstr_reset(vstr);
+            for (;;) {
+                vstr_add_byte(vstr, cur);
+                cur = S_CUR(*s);
+                if (cur == '.' || cur == 'E' || cur == 'e') {
+                    flt = true;
+                } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
+                    // pass
+                } else {
+                    break;
+                }
+                S_NEXT(*s);
+            }
+            if (flt) {
+                return mp_parse_num_decimal(vstr->buf, vstr->len, false, false, NULL);
+            } else {
+                return mp_parse_num_integer(vstr->buf, vstr->len, 10, NULL);
+            }
+        }
+        default:
+            return MP_OBJ_NULL;
+    }
+}
+
+// Parse one complete JSON value from s, whose cur must hold the value's
+// first character (or leading whitespace).  With check_eof, also require
+// that nothing but whitespace follows it.
+STATIC mp_obj_t ujson_load_value(ujson_stream_t *s_in, vstr_t *vstr, bool check_eof) {
+    ujson_stream_t s = *s_in;
     mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
     stack.len = 0;
     stack.items = NULL;
     mp_obj_t stack_top = MP_OBJ_NULL;
     const mp_obj_type_t *stack_top_type = NULL;
     mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
     for (;;) {
     cont:
         if (S_END(s)) {
@@ -174,108 +319,6 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
             case '\n':
             case '\r':
                 goto cont;
-            case 'n':
-                if (S_CUR(s) == 'u' && S_NEXT(s) == 'l' && S_NEXT(s) == 'l') {
-                    S_NEXT(s);
-                    next = mp_const_none;
-                } else {
-                    goto fail;
-                }
-                break;
-            case 'f':
-                if (S_CUR(s) == 'a' && S_NEXT(s) == 'l' && S_NEXT(s) == 's' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_false;
-                } else {
-                    goto fail;
-                }
-                break;
-            case 't':
-                if (S_CUR(s) == 'r' && S_NEXT(s) == 'u' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_true;
-                } else {
-                    goto fail;
-                }
-                break;
-            case '"':
-                vstr_reset(&vstr);
-                for (; !S_END(s) && S_CUR(s) != '"';) {
-                    byte c = S_CUR(s);
-                    if (c == '\\') {
-                        c = S_NEXT(s);
-                        switch (c) {
-                            case 'b':
-                                c = 0x08;
-                                break;
-                            case 'f':
-                                c = 0x0c;
-                                break;
-                            case 'n':
-                                c = 0x0a;
-                                break;
-                            case 'r':
-                                c = 0x0d;
-                                break;
-                            case 't':
-                                c = 0x09;
-                                break;
-                            case 'u': {
-                                mp_uint_t num = 0;
-                                for (int i = 0; i < 4; i++) {
-                                    c = (S_NEXT(s) | 0x20) - '0';
-                                    if (c > 9) {
-                                        c -= ('a' - ('9' + 1));
-                                    }
-                                    num = (num << 4) | c;
-                                }
-                                vstr_add_char(&vstr, num);
-                                goto str_cont;
-                            }
-                        }
-                    }
-                    vstr_add_byte(&vstr, c);
-                str_cont:
-                    S_NEXT(s);
-                }
-                if (S_END(s)) {
-                    goto fail;
-                }
-                S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
-                break;
-            case '-':
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9': {
-                bool flt = false;
-                vstr_reset(&vstr);
-                for (;;) {
-                    vstr_add_byte(&vstr, cur);
-                    cur = S_CUR(s);
-                    if (cur == '.' || cur == 'E' || cur == 'e') {
-                        flt = true;
-                    } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
-                        // pass
-                    } else {
-                        break;
-                    }
-                    S_NEXT(s);
-                }
-                if (flt) {
-                    next = mp_parse_num_decimal(vstr.buf, vstr.len, false, false, NULL);
-                } else {
-                    next = mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
-                }
-                break;
-            }
             case '[':
                 next = mp_obj_new_list(0, NULL);
                 enter = true;
@@ -299,8 +342,16 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
                 stack_top_type = mp_obj_get_type(stack_top);
                 goto cont;
             }
-            default:
-                goto fail;
+            default: {
+                // A string directly inside a dict with no pending key is a key.
+                bool is_key = stack_top != MP_OBJ_NULL && stack_top_type == &mp_type_dict
+                    && stack_key == MP_OBJ_NULL;
+                next = ujson_parse_scalar(&s, vstr, cur, is_key && cur == '"');
+                if (next == MP_OBJ_NULL) {
+                    goto fail;
+                }
+                break;
+            }
         }
         if (stack_top == MP_OBJ_NULL) {
             stack_top = next;
@@ -337,24 +388,37 @@ STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
         }
     }
 success:
-    // eat trailing whitespace
-    while (unichar_isspace(S_CUR(s))) {
-        S_NEXT(s);
-    }
-    if (!S_END(s)) {
-        // unexpected chars
-        goto fail;
+    if (check_eof) {
+        // eat trailing whitespace
+        while (unichar_isspace(S_CUR(s))) {
+            S_NEXT(s);
+        }
+        if (!S_END(s)) {
+            // unexpected chars
+            goto fail;
+        }
     }
     if (stack_top == MP_OBJ_NULL || stack.len != 0) {
         // not exactly 1 object
         goto fail;
     }
-    vstr_clear(&vstr);
+    *s_in = s;
     return stack_top;
 
 fail:
     mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
 }
+
+STATIC mp_obj_t mod_ujson_load(mp_obj_t stream_obj) {
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+    ujson_stream_t s = {stream_obj, stream_p->read, 0, 0};
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    S_NEXT(s);
+    mp_obj_t ret = ujson_load_value(&s, &vstr, true);
+    vstr_clear(&vstr);
+    return ret;
+}
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_load_obj, mod_ujson_load);
 
 STATIC mp_obj_t mod_ujson_loads(mp_obj_t obj) {
@@ -366,12 +430,177 @@ STATIC mp_obj_t mod_ujson_loads(mp_obj_t obj) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_loads_obj, mod_ujson_loads);
 
+#if MICROPY_PY_UJSON_TOKENIZE
+
+// Incremental event-based parser: tokenize(stream) returns an iterator
+// yielding one event name per JSON token ("start_map", "end_map",
+// "start_array", "end_array", "key", "value"), with the payload of the
+// last key/value event in the .value attribute.  Nothing is built in
+// memory beyond the current scalar, so walking a document needs O(depth)
+// RAM; call .load() mid-iteration to materialise just the next value (eg
+// the subtree under a key of interest) with the tree parser above.
+
+#define TOKENIZE_MAX_DEPTH (32) // containers tracked in a 32-bit mask
+
+typedef struct _ujson_tokenize_t {
+    mp_obj_base_t base;
+    ujson_stream_t s;
+    vstr_t vstr; // scratch for scalar parsing
+    uint32_t is_dict; // bit d set if the container at depth d+1 is a dict
+    uint8_t depth;
+    bool expect_key; // inside a dict, the next scalar must be a key
+    bool done; // a complete top-level value has been consumed
+    mp_obj_t value; // payload of the most recent key/value event
+} ujson_tokenize_t;
+
+STATIC const mp_obj_type_t ujson_tokenize_type;
+
+STATIC bool ujson_tokenize_in_dict(ujson_tokenize_t *self) {
+    return self->depth > 0 && (self->is_dict & (1 << (self->depth - 1))) != 0;
+}
+
+STATIC mp_obj_t ujson_tokenize_iternext(mp_obj_t self_in) {
+    ujson_tokenize_t *self = MP_OBJ_TO_PTR(self_in);
+    for (;;) {
+        byte cur = S_CUR(self->s);
+        if (cur == ',' || cur == ':' || unichar_isspace(cur)) {
+            S_NEXT(self->s);
+            continue;
+        }
+        break;
+    }
+    if (S_END(self->s)) {
+        if (self->depth == 0 && self->done) {
+            return MP_OBJ_STOP_ITERATION;
+        }
+        // truncated document
+        goto fail;
+    }
+    if (self->depth == 0 && self->done) {
+        // trailing non-whitespace after the document
+        goto fail;
+    }
+    byte cur = S_CUR(self->s);
+    switch (cur) {
+        case '{':
+        case '[':
+            if (self->depth >= TOKENIZE_MAX_DEPTH) {
+                mp_raise_ValueError(MP_ERROR_TEXT("JSON nested too deep"));
+            }
+            S_NEXT(self->s);
+            if (cur == '{') {
+                self->is_dict |= 1 << self->depth;
+                self->expect_key = true;
+            } else {
+                self->is_dict &= ~(1 << self->depth);
+                self->expect_key = false;
+            }
+            ++self->depth;
+            return MP_OBJ_NEW_QSTR(cur == '{' ? MP_QSTR_start_map : MP_QSTR_start_array);
+        case '}':
+        case ']': {
+            if (self->depth == 0 || ujson_tokenize_in_dict(self) != (cur == '}')) {
+                goto fail;
+            }
+            S_NEXT(self->s);
+            --self->depth;
+            if (self->depth == 0) {
+                self->done = true;
+            }
+            self->expect_key = ujson_tokenize_in_dict(self);
+            return MP_OBJ_NEW_QSTR(cur == '}' ? MP_QSTR_end_map : MP_QSTR_end_array);
+        }
+        default: {
+            bool is_key = ujson_tokenize_in_dict(self) && self->expect_key;
+            if (is_key && cur != '"') {
+                goto fail;
+            }
+            S_NEXT(self->s);
+            mp_obj_t value = ujson_parse_scalar(&self->s, &self->vstr, cur, is_key);
+            if (value == MP_OBJ_NULL) {
+                goto fail;
+            }
+            self->value = value;
+            if (self->depth == 0) {
+                self->done = true;
+            } else if (ujson_tokenize_in_dict(self)) {
+                self->expect_key = !is_key;
+            }
+            return MP_OBJ_NEW_QSTR(is_key ? MP_QSTR_key : MP_QSTR_value);
+        }
+    }
+fail:
+    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+}
+
+// Materialise the next complete value (scalar or whole subtree) from the
+// current position, leaving the tokenizer just after it.
+STATIC mp_obj_t ujson_tokenize_load(mp_obj_t self_in) {
+    ujson_tokenize_t *self = MP_OBJ_TO_PTR(self_in);
+    if ((self->depth == 0 && self->done) || self->expect_key) {
+        // nothing left, or positioned where a dict key belongs
+        mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+    }
+    mp_obj_t ret = ujson_load_value(&self->s, &self->vstr, false);
+    if (self->depth == 0) {
+        self->done = true;
+    } else if (ujson_tokenize_in_dict(self)) {
+        self->expect_key = true;
+    }
+    return ret;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(ujson_tokenize_load_method_obj, ujson_tokenize_load);
+
+STATIC void ujson_tokenize_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    ujson_tokenize_t *self = MP_OBJ_TO_PTR(self_in);
+    if (dest[0] == MP_OBJ_NULL) {
+        if (attr == MP_QSTR_value) {
+            dest[0] = self->value;
+        } else if (attr == MP_QSTR_load) {
+            dest[0] = MP_OBJ_FROM_PTR(&ujson_tokenize_load_method_obj);
+            dest[1] = self_in;
+        }
+    }
+}
+
+STATIC const mp_obj_type_t ujson_tokenize_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_tokenize,
+    .attr = ujson_tokenize_attr,
+    .getiter = mp_identity_getiter,
+    .iternext = ujson_tokenize_iternext,
+};
+
+STATIC mp_obj_t mod_ujson_tokenize(mp_obj_t stream_obj) {
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
+    ujson_tokenize_t *self = m_new_obj(ujson_tokenize_t);
+    self->base.type = &ujson_tokenize_type;
+    self->s.stream_obj = stream_obj;
+    self->s.read = stream_p->read;
+    self->s.errcode = 0;
+    self->s.cur = 0;
+    vstr_init(&self->vstr, 8);
+    self->is_dict = 0;
+    self->depth = 0;
+    self->expect_key = false;
+    self->done = false;
+    self->value = mp_const_none;
+    S_NEXT(self->s);
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ujson_tokenize_obj, mod_ujson_tokenize);
+
+#endif // MICROPY_PY_UJSON_TOKENIZE
+
 STATIC const mp_rom_map_elem_t mp_module_ujson_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ujson) },
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_ujson_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_ujson_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_ujson_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_ujson_loads_obj) },
+    #if MICROPY_PY_UJSON_TOKENIZE
+    { MP_ROM_QSTR(MP_QSTR_tokenize), MP_ROM_PTR(&mod_ujson_tokenize_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_ujson_globals, mp_module_ujson_globals_table);
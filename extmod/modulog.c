@@ -0,0 +1,257 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// ulog: allocation-free logging with deferred formatting.
+//
+// ulog.log(level, fmt, ...) does nothing but an integer compare when level is
+// below the configured threshold, and otherwise captures fmt and up to
+// MICROPY_PY_ULOG_MAX_ARGS arguments by reference into a preallocated record
+// ring, so the hot path never allocates.  Formatting is deferred to
+// ulog.drain(), which renders each record straight to the configured stream
+// (fmt supports the "{}" placeholder and "{{"/"}}" escapes).  When the ring
+// overflows the oldest records are dropped and the drop is reported on the
+// next drain.
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/mpprint.h"
+
+#if MICROPY_PY_ULOG
+
+#define ULOG_LEVEL_DEBUG (10)
+#define ULOG_LEVEL_INFO (20)
+#define ULOG_LEVEL_WARNING (30)
+#define ULOG_LEVEL_ERROR (40)
+#define ULOG_LEVEL_CRITICAL (50)
+
+typedef struct _ulog_record_t {
+    uint16_t level;
+    uint16_t n_args;
+    mp_obj_t fmt;
+    mp_obj_t args[MICROPY_PY_ULOG_MAX_ARGS];
+} ulog_record_t;
+
+typedef struct _mp_ulog_state_t {
+    mp_obj_t stream; // drain destination, MP_OBJ_NULL for mp_plat_print
+    uint16_t level;
+    uint16_t head; // oldest record
+    uint16_t count; // number of valid records
+    uint16_t sched; // a drain is already scheduled
+    size_t dropped; // records lost to ring overflow since the last drain
+    ulog_record_t ring[MICROPY_PY_ULOG_RING_LEN];
+} mp_ulog_state_t;
+
+// forward declaration so log can schedule a drain
+STATIC mp_obj_t mod_ulog_drain(size_t n_args, const mp_obj_t *args);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_drain_obj, 0, 1, mod_ulog_drain);
+
+STATIC mp_ulog_state_t *ulog_get_state(void) {
+    mp_ulog_state_t *state = MP_STATE_VM(ulog_state);
+    if (state == NULL) {
+        // allocate the record ring once; logging itself never allocates
+        state = m_new_obj(mp_ulog_state_t);
+        state->stream = MP_OBJ_NULL;
+        state->level = ULOG_LEVEL_WARNING;
+        state->head = 0;
+        state->count = 0;
+        state->sched = 0;
+        state->dropped = 0;
+        MP_STATE_VM(ulog_state) = state;
+    }
+    return state;
+}
+
+STATIC mp_obj_t ulog_log_common(mp_int_t level, size_t n_args, const mp_obj_t *args) {
+    mp_ulog_state_t *state = MP_STATE_VM(ulog_state);
+    if (level < (state == NULL ? ULOG_LEVEL_WARNING : state->level)) {
+        // this compare is the entire cost of a disabled record
+        return mp_const_none;
+    }
+    state = ulog_get_state();
+    size_t pos = (state->head + state->count) % MICROPY_PY_ULOG_RING_LEN;
+    if (state->count == MICROPY_PY_ULOG_RING_LEN) {
+        // ring full: drop the oldest record
+        state->head = (state->head + 1) % MICROPY_PY_ULOG_RING_LEN;
+        state->dropped++;
+    } else {
+        state->count++;
+    }
+    ulog_record_t *rec = &state->ring[pos];
+    rec->level = level;
+    rec->n_args = n_args - 1;
+    rec->fmt = args[0];
+    for (size_t i = 0; i < n_args - 1; i++) {
+        rec->args[i] = args[i + 1];
+    }
+    #if MICROPY_ENABLE_SCHEDULER
+    if (!state->sched) {
+        // drain from the scheduler so the records don't sit until a manual
+        // drain; if the queue is full the records just wait for the next one
+        state->sched = mp_sched_schedule(MP_OBJ_FROM_PTR(&mod_ulog_drain_obj), mp_const_none);
+    }
+    #endif
+    return mp_const_none;
+}
+
+STATIC mp_obj_t mod_ulog_log(size_t n_args, const mp_obj_t *args) {
+    return ulog_log_common(mp_obj_get_int(args[0]), n_args - 1, args + 1);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_log_obj, 2, 2 + MICROPY_PY_ULOG_MAX_ARGS, mod_ulog_log);
+
+STATIC mp_obj_t mod_ulog_debug(size_t n_args, const mp_obj_t *args) {
+    return ulog_log_common(ULOG_LEVEL_DEBUG, n_args, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_debug_obj, 1, 1 + MICROPY_PY_ULOG_MAX_ARGS, mod_ulog_debug);
+
+STATIC mp_obj_t mod_ulog_info(size_t n_args, const mp_obj_t *args) {
+    return ulog_log_common(ULOG_LEVEL_INFO, n_args, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_info_obj, 1, 1 + MICROPY_PY_ULOG_MAX_ARGS, mod_ulog_info);
+
+STATIC mp_obj_t mod_ulog_warning(size_t n_args, const mp_obj_t *args) {
+    return ulog_log_common(ULOG_LEVEL_WARNING, n_args, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_warning_obj, 1, 1 + MICROPY_PY_ULOG_MAX_ARGS, mod_ulog_warning);
+
+STATIC mp_obj_t mod_ulog_error(size_t n_args, const mp_obj_t *args) {
+    return ulog_log_common(ULOG_LEVEL_ERROR, n_args, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_ulog_error_obj, 1, 1 + MICROPY_PY_ULOG_MAX_ARGS, mod_ulog_error);
+
+STATIC mp_obj_t mod_ulog_set_level(mp_obj_t level_in) {
+    ulog_get_state()->level = mp_obj_get_int(level_in);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ulog_set_level_obj, mod_ulog_set_level);
+
+STATIC mp_obj_t mod_ulog_set_stream(mp_obj_t stream_in) {
+    mp_get_stream_raise(stream_in, MP_STREAM_OP_WRITE);
+    ulog_get_state()->stream = stream_in;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_ulog_set_stream_obj, mod_ulog_set_stream);
+
+STATIC void ulog_print_level(const mp_print_t *print, int level) {
+    static const char *const names[] = {"DEBUG", "INFO", "WARNING", "ERROR", "CRITICAL"};
+    if (level % 10 == 0 && level >= ULOG_LEVEL_DEBUG && level <= ULOG_LEVEL_CRITICAL) {
+        mp_printf(print, "%s:", names[level / 10 - 1]);
+    } else {
+        mp_printf(print, "%d:", level);
+    }
+}
+
+// Render fmt with "{}" placeholders taking successive args; "{{" and "}}"
+// are literal braces.  This is the subset of str.format that can be printed
+// without allocating.
+STATIC void ulog_print_record(const mp_print_t *print, ulog_record_t *rec) {
+    ulog_print_level(print, rec->level);
+    size_t fmt_len;
+    const char *p = mp_obj_str_get_data(rec->fmt, &fmt_len);
+    const char *top = p + fmt_len;
+    size_t arg = 0;
+    while (p < top) {
+        const char *q = p;
+        while (q < top && *q != '{' && *q != '}') {
+            q++;
+        }
+        print->print_strn(print->data, p, q - p);
+        if (q == top) {
+            break;
+        }
+        if (*q == '{' && q + 1 < top && q[1] == '}' && arg < rec->n_args) {
+            mp_obj_print_helper(print, rec->args[arg++], PRINT_STR);
+            q += 2;
+        } else if (q + 1 < top && q[1] == *q) {
+            print->print_strn(print->data, q, 1);
+            q += 2;
+        } else {
+            print->print_strn(print->data, q, 1);
+            q += 1;
+        }
+        p = q;
+    }
+    print->print_strn(print->data, "\n", 1);
+}
+
+STATIC mp_obj_t mod_ulog_drain(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    (void)args;
+    mp_ulog_state_t *state = MP_STATE_VM(ulog_state);
+    if (state == NULL) {
+        return MP_OBJ_NEW_SMALL_INT(0);
+    }
+    state->sched = 0;
+    mp_print_t print;
+    if (state->stream == MP_OBJ_NULL) {
+        print = mp_plat_print;
+    } else {
+        print.data = MP_OBJ_TO_PTR(state->stream);
+        print.print_strn = mp_stream_write_adaptor;
+    }
+    if (state->dropped != 0) {
+        mp_printf(&print, "ulog: %u records dropped\n", (unsigned)state->dropped);
+        state->dropped = 0;
+    }
+    size_t n = 0;
+    while (state->count > 0) {
+        // take the record out of the ring before printing, in case printing
+        // an argument runs Python code that logs more records
+        ulog_record_t rec = state->ring[state->head];
+        memset(&state->ring[state->head], 0, sizeof(ulog_record_t));
+        state->head = (state->head + 1) % MICROPY_PY_ULOG_RING_LEN;
+        state->count--;
+        ulog_print_record(&print, &rec);
+        n++;
+    }
+    return MP_OBJ_NEW_SMALL_INT(n);
+}
+
+STATIC const mp_rom_map_elem_t mp_module_ulog_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ulog) },
+    { MP_ROM_QSTR(MP_QSTR_log), MP_ROM_PTR(&mod_ulog_log_obj) },
+    { MP_ROM_QSTR(MP_QSTR_debug), MP_ROM_PTR(&mod_ulog_debug_obj) },
+    { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_PTR(&mod_ulog_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_warning), MP_ROM_PTR(&mod_ulog_warning_obj) },
+    { MP_ROM_QSTR(MP_QSTR_error), MP_ROM_PTR(&mod_ulog_error_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_level), MP_ROM_PTR(&mod_ulog_set_level_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_stream), MP_ROM_PTR(&mod_ulog_set_stream_obj) },
+    { MP_ROM_QSTR(MP_QSTR_drain), MP_ROM_PTR(&mod_ulog_drain_obj) },
+    { MP_ROM_QSTR(MP_QSTR_DEBUG), MP_ROM_INT(ULOG_LEVEL_DEBUG) },
+    { MP_ROM_QSTR(MP_QSTR_INFO), MP_ROM_INT(ULOG_LEVEL_INFO) },
+    { MP_ROM_QSTR(MP_QSTR_WARNING), MP_ROM_INT(ULOG_LEVEL_WARNING) },
+    { MP_ROM_QSTR(MP_QSTR_ERROR), MP_ROM_INT(ULOG_LEVEL_ERROR) },
+    { MP_ROM_QSTR(MP_QSTR_CRITICAL), MP_ROM_INT(ULOG_LEVEL_CRITICAL) },
+};
+STATIC MP_DEFINE_CONST_DICT(mp_module_ulog_globals, mp_module_ulog_globals_table);
+
+const mp_obj_module_t mp_module_ulog = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&mp_module_ulog_globals,
+};
+
+#endif // MICROPY_PY_ULOG
@@ -0,0 +1,229 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// uparallel: data-parallel map over worker threads.
+//
+// uparallel.map(fun, n[, workers]) calls fun(i) for i in range(n) using
+// several threads and returns the results as a list of length n.  The
+// index range is divided into chunks that idle threads claim dynamically
+// from a shared counter, so uneven per-index work still balances.  The
+// calling thread participates as one of the workers.  Speedup requires a
+// build that runs threads without the GIL (MICROPY_PY_THREAD_GIL=0);
+// with the GIL the calls are serialised but the semantics are the same.
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stackctrl.h"
+#include "py/mphal.h"
+
+#if MICROPY_PY_UPARALLEL
+
+#if !MICROPY_PY_THREAD
+#error "MICROPY_PY_UPARALLEL requires MICROPY_PY_THREAD"
+#endif
+
+#include "py/mpthread.h"
+
+// The job lives on the caller's C stack, which outlives the workers and is
+// scanned by the GC, so fun/results/exc are kept alive for the duration.
+typedef struct _uparallel_job_t {
+    mp_thread_mutex_t mutex; // protects next and exc
+    mp_obj_dict_t *dict_locals;
+    mp_obj_dict_t *dict_globals;
+    mp_obj_t fun;
+    mp_obj_t *results;
+    size_t len;
+    size_t chunk;
+    size_t next;
+    mp_obj_t exc; // first uncaught exception from any worker
+    volatile size_t n_running; // worker threads not yet finished
+    size_t stack_size;
+} uparallel_job_t;
+
+// Claim the next chunk of indices; returns [*begin, *end) which is empty
+// when there is no work left (or another worker raised an exception).
+STATIC bool uparallel_claim(uparallel_job_t *job, size_t *begin, size_t *end) {
+    mp_thread_mutex_lock(&job->mutex, 1);
+    size_t b = job->next;
+    if (job->exc != MP_OBJ_NULL) {
+        b = job->len;
+    }
+    size_t e = b + job->chunk;
+    if (e > job->len) {
+        e = job->len;
+    }
+    job->next = e;
+    mp_thread_mutex_unlock(&job->mutex);
+    *begin = b;
+    *end = e;
+    return b < e;
+}
+
+STATIC void uparallel_run(uparallel_job_t *job) {
+    size_t i, end;
+    while (uparallel_claim(job, &i, &end)) {
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            for (; i < end; i++) {
+                job->results[i] = mp_call_function_1(job->fun, MP_OBJ_NEW_SMALL_INT(i));
+            }
+            nlr_pop();
+        } else {
+            // record the first exception and let all workers wind down
+            mp_thread_mutex_lock(&job->mutex, 1);
+            if (job->exc == MP_OBJ_NULL) {
+                job->exc = MP_OBJ_FROM_PTR(nlr.ret_val);
+            }
+            mp_thread_mutex_unlock(&job->mutex);
+            return;
+        }
+    }
+}
+
+// Execution begins here for a worker thread; modelled on thread_entry in
+// py/modthread.c but running a fixed loop instead of a user function.
+STATIC void *uparallel_worker(void *job_in) {
+    uparallel_job_t *job = (uparallel_job_t *)job_in;
+
+    mp_state_thread_t ts;
+    mp_thread_set_state(&ts);
+
+    mp_stack_set_top(&ts + 1); // need to include ts in root-pointer scan
+    mp_stack_set_limit(job->stack_size);
+
+    #if MICROPY_ENABLE_PYSTACK
+    // TODO threading and pystack is not fully supported, for now just make a small stack
+    mp_obj_t mini_pystack[128];
+    mp_pystack_init(mini_pystack, &mini_pystack[128]);
+    #endif
+
+    // The GC starts off unlocked on this thread.
+    ts.gc_lock_depth = 0;
+
+    ts.mp_pending_exception = MP_OBJ_NULL;
+
+    #if MICROPY_OPT_CODE_STATE_POOL
+    memset(ts.code_state_pool, 0, sizeof(ts.code_state_pool));
+    #endif
+
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    memset(ts.gc_block_cache, 0, sizeof(ts.gc_block_cache));
+    memset(ts.gc_block_cache_len, 0, sizeof(ts.gc_block_cache_len));
+    #endif
+
+    mp_locals_set(job->dict_locals);
+    mp_globals_set(job->dict_globals);
+
+    MP_THREAD_GIL_ENTER();
+
+    mp_thread_start();
+
+    uparallel_run(job);
+
+    mp_thread_mutex_lock(&job->mutex, 1);
+    job->n_running -= 1;
+    mp_thread_mutex_unlock(&job->mutex);
+
+    mp_thread_finish();
+
+    MP_THREAD_GIL_EXIT();
+
+    return NULL;
+}
+
+STATIC mp_obj_t mod_uparallel_map(size_t n_args, const mp_obj_t *args) {
+    mp_int_t len = mp_obj_get_int(args[1]);
+    if (len < 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("range must be non-negative"));
+    }
+
+    mp_int_t n_workers = MICROPY_PY_UPARALLEL_WORKERS;
+    if (n_args > 2) {
+        n_workers = mp_obj_get_int(args[2]);
+        if (n_workers < 1) {
+            mp_raise_ValueError(MP_ERROR_TEXT("workers must be >= 1"));
+        }
+    }
+    // no point having more workers than indices; the caller is one worker
+    if (n_workers > len) {
+        n_workers = len > 0 ? len : 1;
+    }
+
+    mp_obj_t res = mp_obj_new_list(len, NULL);
+    size_t res_len;
+    uparallel_job_t job;
+    mp_obj_list_get(res, &res_len, &job.results);
+    for (size_t i = 0; i < res_len; i++) {
+        job.results[i] = mp_const_none;
+    }
+
+    mp_thread_mutex_init(&job.mutex);
+    job.dict_locals = mp_locals_get();
+    job.dict_globals = mp_globals_get();
+    job.fun = args[0];
+    job.len = len;
+    // aim for a few chunks per worker so uneven work still balances
+    job.chunk = len / (n_workers * 4) + 1;
+    job.next = 0;
+    job.exc = MP_OBJ_NULL;
+    job.n_running = 0;
+    job.stack_size = 0; // let the port pick its default
+
+    for (mp_int_t i = 0; i < n_workers - 1; i++) {
+        job.n_running += 1;
+        mp_thread_create(uparallel_worker, &job, &job.stack_size);
+    }
+
+    // the calling thread works too
+    uparallel_run(&job);
+
+    // wait for the workers to drain; the job must stay live until they do
+    while (job.n_running != 0) {
+        MICROPY_EVENT_POLL_HOOK
+    }
+
+    if (job.exc != MP_OBJ_NULL) {
+        nlr_raise(job.exc);
+    }
+
+    return res;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uparallel_map_obj, 2, 3, mod_uparallel_map);
+
+STATIC const mp_rom_map_elem_t mp_module_uparallel_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uparallel) },
+    { MP_ROM_QSTR(MP_QSTR_map), MP_ROM_PTR(&mod_uparallel_map_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_module_uparallel_globals, mp_module_uparallel_globals_table);
+
+const mp_obj_module_t mp_module_uparallel = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&mp_module_uparallel_globals,
+};
+
+#endif // MICROPY_PY_UPARALLEL
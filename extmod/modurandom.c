@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "py/runtime.h"
+#include "extmod/modurandom.h"
 
 #if MICROPY_PY_URANDOM
 
@@ -38,47 +39,81 @@
 #define SEED_ON_IMPORT (0)
 #endif
 
-// Yasmarang random number generator
-// by Ilya Levin
-// http://www.literatecode.com/yasmarang
+// xoshiro128** random number generator
+// by David Blackman and Sebastiano Vigna
+// http://prng.di.unimi.it/xoshiro128starstar.c
 // Public Domain
 
 #if !MICROPY_ENABLE_DYNRUNTIME
 #if SEED_ON_IMPORT
-// If the state is seeded on import then keep these variables in the BSS.
-STATIC uint32_t yasmarang_pad, yasmarang_n, yasmarang_d;
-STATIC uint8_t yasmarang_dat;
+// If the state is seeded on import then keep it in the BSS (__init__ seeds
+// it before first use; the all-zero state is never drawn from).
+STATIC uint32_t xoshiro128_state[4];
 #else
-// Without seed-on-import these variables must be initialised via the data section.
-STATIC uint32_t yasmarang_pad = 0xeda4baba, yasmarang_n = 69, yasmarang_d = 233;
-STATIC uint8_t yasmarang_dat = 0;
+// Without seed-on-import the state must be initialised via the data section;
+// these values are what seed(0) produces.
+STATIC uint32_t xoshiro128_state[4] = {0x92ca2f0e, 0x3cd6e3f3, 0x1b147dcc, 0x4c081dbf};
 #endif
 #endif
 
-STATIC uint32_t yasmarang(void) {
-    yasmarang_pad += yasmarang_dat + yasmarang_d * yasmarang_n;
-    yasmarang_pad = (yasmarang_pad << 3) + (yasmarang_pad >> 29);
-    yasmarang_n = yasmarang_pad | 2;
-    yasmarang_d ^= (yasmarang_pad << 31) + (yasmarang_pad >> 1);
-    yasmarang_dat ^= (char)yasmarang_pad ^ (yasmarang_d >> 8) ^ 1;
+static inline uint32_t xoshiro128_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+STATIC uint32_t xoshiro128(void) {
+    uint32_t *s = xoshiro128_state;
+    uint32_t result = xoshiro128_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = xoshiro128_rotl(s[3], 11);
+
+    return result;
+}
 
-    return yasmarang_pad ^ (yasmarang_d << 5) ^ (yasmarang_pad >> 18) ^ (yasmarang_dat << 1);
-}  /* yasmarang */
+// End of xoshiro128**
 
-// End of Yasmarang
+STATIC void xoshiro128_seed(uint32_t seed) {
+    // Expand the 32-bit seed with splitmix32 so that similar seeds don't
+    // produce correlated states and the all-zero state can't occur.
+    for (size_t i = 0; i < 4; i++) {
+        seed += 0x9e3779b9;
+        uint32_t z = seed;
+        z = (z ^ (z >> 16)) * 0x85ebca6b;
+        z = (z ^ (z >> 13)) * 0xc2b2ae35;
+        xoshiro128_state[i] = z ^ (z >> 16);
+    }
+}
+
+STATIC void xoshiro128_fill(byte *buf, size_t len) {
+    while (len >= 4) {
+        uint32_t r = xoshiro128();
+        memcpy(buf, &r, 4);
+        buf += 4;
+        len -= 4;
+    }
+    if (len != 0) {
+        uint32_t r = xoshiro128();
+        memcpy(buf, &r, len);
+    }
+}
 
 #if MICROPY_PY_URANDOM_EXTRA_FUNCS
 
 // returns an unsigned integer below the given argument
 // n must not be zero
-STATIC uint32_t yasmarang_randbelow(uint32_t n) {
+STATIC uint32_t xoshiro128_randbelow(uint32_t n) {
     uint32_t mask = 1;
     while ((n & mask) < n) {
         mask = (mask << 1) | 1;
     }
     uint32_t r;
     do {
-        r = yasmarang() & mask;
+        r = xoshiro128() & mask;
     } while (r >= n);
     return r;
 }
@@ -96,10 +131,18 @@ STATIC mp_obj_t mod_urandom_getrandbits(mp_obj_t num_in) {
     uint32_t mask = ~0;
     // Beware of C undefined behavior when shifting by >= than bit size
     mask >>= (32 - n);
-    return mp_obj_new_int_from_uint(yasmarang() & mask);
+    return mp_obj_new_int_from_uint(xoshiro128() & mask);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_urandom_getrandbits_obj, mod_urandom_getrandbits);
 
+STATIC mp_obj_t mod_urandom_fill(mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    xoshiro128_fill(bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_urandom_fill_obj, mod_urandom_fill);
+
 STATIC mp_obj_t mod_urandom_seed(size_t n_args, const mp_obj_t *args) {
     mp_uint_t seed;
     if (n_args == 0 || args[0] == mp_const_none) {
@@ -111,10 +154,7 @@ STATIC mp_obj_t mod_urandom_seed(size_t n_args, const mp_obj_t *args) {
     } else {
         seed = mp_obj_get_int_truncated(args[0]);
     }
-    yasmarang_pad = seed;
-    yasmarang_n = 69;
-    yasmarang_d = 233;
-    yasmarang_dat = 0;
+    xoshiro128_seed(seed);
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_urandom_seed_obj, 0, 1, mod_urandom_seed);
@@ -126,7 +166,7 @@ STATIC mp_obj_t mod_urandom_randrange(size_t n_args, const mp_obj_t *args) {
     if (n_args == 1) {
         // range(stop)
         if (start > 0) {
-            return mp_obj_new_int(yasmarang_randbelow(start));
+            return mp_obj_new_int(xoshiro128_randbelow(start));
         } else {
             goto error;
         }
@@ -135,7 +175,7 @@ STATIC mp_obj_t mod_urandom_randrange(size_t n_args, const mp_obj_t *args) {
         if (n_args == 2) {
             // range(start, stop)
             if (start < stop) {
-                return mp_obj_new_int(start + yasmarang_randbelow(stop - start));
+                return mp_obj_new_int(start + xoshiro128_randbelow(stop - start));
             } else {
                 goto error;
             }
@@ -151,7 +191,7 @@ STATIC mp_obj_t mod_urandom_randrange(size_t n_args, const mp_obj_t *args) {
                 goto error;
             }
             if (n > 0) {
-                return mp_obj_new_int(start + step * yasmarang_randbelow(n));
+                return mp_obj_new_int(start + step * xoshiro128_randbelow(n));
             } else {
                 goto error;
             }
@@ -167,7 +207,7 @@ STATIC mp_obj_t mod_urandom_randint(mp_obj_t a_in, mp_obj_t b_in) {
     mp_int_t a = mp_obj_get_int(a_in);
     mp_int_t b = mp_obj_get_int(b_in);
     if (a <= b) {
-        return mp_obj_new_int(a + yasmarang_randbelow(b - a + 1));
+        return mp_obj_new_int(a + xoshiro128_randbelow(b - a + 1));
     } else {
         mp_raise_ValueError(NULL);
     }
@@ -177,7 +217,7 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_urandom_randint_obj, mod_urandom_randint);
 STATIC mp_obj_t mod_urandom_choice(mp_obj_t seq) {
     mp_int_t len = mp_obj_get_int(mp_obj_len(seq));
     if (len > 0) {
-        return mp_obj_subscr(seq, mp_obj_new_int(yasmarang_randbelow(len)), MP_OBJ_SENTINEL);
+        return mp_obj_subscr(seq, mp_obj_new_int(xoshiro128_randbelow(len)), MP_OBJ_SENTINEL);
     } else {
         mp_raise_type(&mp_type_IndexError);
     }
@@ -186,28 +226,28 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_urandom_choice_obj, mod_urandom_choice);
 
 #if MICROPY_PY_BUILTINS_FLOAT
 
-// returns a number in the range [0..1) using Yasmarang to fill in the fraction bits
-STATIC mp_float_t yasmarang_float(void) {
+// returns a number in the range [0..1) using the PRNG to fill in the fraction bits
+STATIC mp_float_t xoshiro128_float(void) {
     mp_float_union_t u;
     u.p.sgn = 0;
     u.p.exp = (1 << (MP_FLOAT_EXP_BITS - 1)) - 1;
     if (MP_FLOAT_FRAC_BITS <= 32) {
-        u.p.frc = yasmarang();
+        u.p.frc = xoshiro128();
     } else {
-        u.p.frc = ((uint64_t)yasmarang() << 32) | (uint64_t)yasmarang();
+        u.p.frc = ((uint64_t)xoshiro128() << 32) | (uint64_t)xoshiro128();
     }
     return u.f - 1;
 }
 
 STATIC mp_obj_t mod_urandom_random(void) {
-    return mp_obj_new_float(yasmarang_float());
+    return mp_obj_new_float(xoshiro128_float());
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_urandom_random_obj, mod_urandom_random);
 
 STATIC mp_obj_t mod_urandom_uniform(mp_obj_t a_in, mp_obj_t b_in) {
     mp_float_t a = mp_obj_get_float(a_in);
     mp_float_t b = mp_obj_get_float(b_in);
-    return mp_obj_new_float(a + (b - a) * yasmarang_float());
+    return mp_obj_new_float(a + (b - a) * xoshiro128_float());
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_urandom_uniform_obj, mod_urandom_uniform);
 
@@ -230,12 +270,27 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(mod_urandom___init___obj, mod_urandom___init__)
 #endif
 
 #if !MICROPY_ENABLE_DYNRUNTIME
+// C-callable interface to the shared PRNG, for other modules that need cheap
+// (non-cryptographic) randomness in bulk.
+uint32_t mp_urandom_u32(void) {
+    return xoshiro128();
+}
+
+void mp_urandom_fill(void *buf, size_t len) {
+    xoshiro128_fill(buf, len);
+}
+
+void mp_urandom_seed(uint32_t seed) {
+    xoshiro128_seed(seed);
+}
+
 STATIC const mp_rom_map_elem_t mp_module_urandom_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_urandom) },
     #if SEED_ON_IMPORT
     { MP_ROM_QSTR(MP_QSTR___init__), MP_ROM_PTR(&mod_urandom___init___obj) },
     #endif
     { MP_ROM_QSTR(MP_QSTR_getrandbits), MP_ROM_PTR(&mod_urandom_getrandbits_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fill), MP_ROM_PTR(&mod_urandom_fill_obj) },
     { MP_ROM_QSTR(MP_QSTR_seed), MP_ROM_PTR(&mod_urandom_seed_obj) },
     #if MICROPY_PY_URANDOM_EXTRA_FUNCS
     { MP_ROM_QSTR(MP_QSTR_randrange), MP_ROM_PTR(&mod_urandom_randrange_obj) },
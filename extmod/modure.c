@@ -177,6 +177,169 @@ STATIC void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+#if MICROPY_PY_URE_PIKEVM
+
+// Pike VM executor for the re1.5 bytecode: advances every alternative in
+// lock step over the input, so matching takes linear time in the input
+// length even for patterns that make the backtracking engine take
+// exponential time on a non-match.  Each queued thread carries its own
+// snapshot of the capture pointers, and threads are kept in priority
+// order so the result (including captures) is the same as the
+// backtracking engine's leftmost-greedy answer.
+
+typedef struct _ure_pike_threads_t {
+    int n;
+    const char **pc; // per-thread program counter, [prog->len]
+    const char **caps; // per-thread capture snapshots, [prog->len * nsubp]
+} ure_pike_threads_t;
+
+typedef struct _ure_pike_state_t {
+    ByteProg *prog;
+    Subject *input;
+    int nsubp;
+    int gen; // current scheduling round
+    int *mark; // [prog->bytelen], round a pc was last queued in, for dedup
+} ure_pike_state_t;
+
+// Add the closure of pc to list l: follow non-consuming instructions now,
+// queueing each consumer (or Match) reached, first (highest-priority)
+// arrival at a pc wins.  scratch holds the capture set of the spawning
+// thread and is restored around Save branches.
+STATIC void ure_pike_addthread(ure_pike_state_t *st, ure_pike_threads_t *l, const char *pc, const char **scratch, const char *sp) {
+    re1_5_stack_chk();
+    if (st->mark[pc - st->prog->insts] == st->gen) {
+        return;
+    }
+    st->mark[pc - st->prog->insts] = st->gen;
+    switch (*pc) {
+        case Jmp:
+            ure_pike_addthread(st, l, pc + 2 + (signed char)pc[1], scratch, sp);
+            break;
+        case Split:
+            ure_pike_addthread(st, l, pc + 2, scratch, sp);
+            ure_pike_addthread(st, l, pc + 2 + (signed char)pc[1], scratch, sp);
+            break;
+        case RSplit:
+            ure_pike_addthread(st, l, pc + 2 + (signed char)pc[1], scratch, sp);
+            ure_pike_addthread(st, l, pc + 2, scratch, sp);
+            break;
+        case Save: {
+            int off = (unsigned char)pc[1];
+            if (off >= st->nsubp) {
+                ure_pike_addthread(st, l, pc + 2, scratch, sp);
+            } else {
+                const char *old = scratch[off];
+                scratch[off] = sp;
+                ure_pike_addthread(st, l, pc + 2, scratch, sp);
+                scratch[off] = old;
+            }
+            break;
+        }
+        case Bol:
+            if (sp == st->input->begin) {
+                ure_pike_addthread(st, l, pc + 1, scratch, sp);
+            }
+            break;
+        case Eol:
+            if (sp == st->input->end) {
+                ure_pike_addthread(st, l, pc + 1, scratch, sp);
+            }
+            break;
+        default: {
+            // Consumer or Match: queue with a snapshot of the captures.
+            const char **caps = l->caps + l->n * st->nsubp;
+            memcpy(caps, scratch, st->nsubp * sizeof(char *));
+            l->pc[l->n++] = pc;
+            break;
+        }
+    }
+}
+
+STATIC int ure_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int is_anchored) {
+    ure_pike_state_t st = {prog, input, nsubp, 1, m_new0(int, prog->bytelen)};
+    ure_pike_threads_t lists[2];
+    for (int i = 0; i < 2; ++i) {
+        lists[i].n = 0;
+        lists[i].pc = m_new(const char *, prog->len);
+        lists[i].caps = m_new(const char *, prog->len * nsubp);
+    }
+    ure_pike_threads_t *clist = &lists[0];
+    ure_pike_threads_t *nlist = &lists[1];
+
+    const char **scratch = m_new(const char *, nsubp);
+    memcpy(scratch, subp, nsubp * sizeof(char *));
+
+    int matched = 0;
+    const char *sp = input->begin;
+    ure_pike_addthread(&st, clist, HANDLE_ANCHORED(prog->insts, is_anchored), scratch, sp);
+    while (clist->n != 0) {
+        ++st.gen;
+        nlist->n = 0;
+        for (int i = 0; i < clist->n; ++i) {
+            const char *pc = clist->pc[i];
+            const char **caps = clist->caps + i * nsubp;
+            if (inst_is_consumer(*pc) && sp >= input->end) {
+                continue;
+            }
+            switch (*pc) {
+                case Char:
+                    if (*sp == pc[1]) {
+                        ure_pike_addthread(&st, nlist, pc + 2, caps, sp + 1);
+                    }
+                    break;
+                case Any:
+                    ure_pike_addthread(&st, nlist, pc + 1, caps, sp + 1);
+                    break;
+                case Class:
+                case ClassNot:
+                    if (_re1_5_classmatch(pc + 1, sp)) {
+                        ure_pike_addthread(&st, nlist, pc + 2 + (unsigned char)pc[1] * 2, caps, sp + 1);
+                    }
+                    break;
+                case NamedClass:
+                    if (_re1_5_namedclassmatch(pc + 1, sp)) {
+                        ure_pike_addthread(&st, nlist, pc + 2, caps, sp + 1);
+                    }
+                    break;
+                case Match:
+                    // Record the match and cut the lower-priority threads;
+                    // a surviving higher-priority thread (already stepped)
+                    // may still overwrite this with its own, longer match.
+                    memcpy(subp, caps, nsubp * sizeof(char *));
+                    matched = 1;
+                    goto cut;
+            }
+        }
+    cut:;
+        ure_pike_threads_t *tmp = clist;
+        clist = nlist;
+        nlist = tmp;
+        if (sp >= input->end) {
+            break;
+        }
+        ++sp;
+    }
+
+    m_del(const char *, scratch, nsubp);
+    for (int i = 0; i < 2; ++i) {
+        m_del(const char *, lists[i].pc, prog->len);
+        m_del(const char *, lists[i].caps, prog->len * nsubp);
+    }
+    m_del(int, st.mark, prog->bytelen);
+    return matched;
+}
+
+#endif // MICROPY_PY_URE_PIKEVM
+
+// Run the compiled pattern over the subject with the configured engine.
+STATIC int ure_exec_prog(ByteProg *prog, Subject *subj, const char **caps, int caps_num, int is_anchored) {
+    #if MICROPY_PY_URE_PIKEVM
+    return ure_pikevm(prog, subj, caps, caps_num, is_anchored);
+    #else
+    return re1_5_recursiveloopprog(prog, subj, caps, caps_num, is_anchored);
+    #endif
+}
+
 STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
     mp_obj_re_t *self;
@@ -193,7 +356,7 @@ STATIC mp_obj_t ure_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char *, caps_num);
     // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
     memset((char *)match->caps, 0, caps_num * sizeof(char *));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
+    int res = ure_exec_prog(&self->re, &subj, match->caps, caps_num, is_anchored);
     if (res == 0) {
         m_del_var(mp_obj_match_t, char *, caps_num, match);
         return mp_const_none;
@@ -215,6 +378,74 @@ STATIC mp_obj_t re_search(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_search_obj, 2, 4, re_search);
 
+#if MICROPY_PY_URE_FINDITER
+
+// Iterator over all non-overlapping matches in a string.  The scan resumes
+// from the end of the previous match instead of restarting, so one pass
+// covers the whole buffer, and the single match object owned by the
+// iterator is recycled for each result: a yielded match is only valid
+// until the next iteration step.
+typedef struct _mp_obj_re_finditer_t {
+    mp_obj_base_t base;
+    mp_obj_t re; // keep the compiled regex alive
+    Subject subj; // remaining, unscanned part of the input
+    mp_obj_match_t *match; // reused for each yielded match
+} mp_obj_re_finditer_t;
+
+STATIC mp_obj_t re_finditer_iternext(mp_obj_t self_in) {
+    mp_obj_re_finditer_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_re_t *re = MP_OBJ_TO_PTR(self->re);
+    int caps_num = (re->re.sub + 1) * 2;
+    if (self->subj.begin > self->subj.end) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
+    memset((char *)self->match->caps, 0, caps_num * sizeof(char *));
+    int res = ure_exec_prog(&re->re, &self->subj, self->match->caps, caps_num, false);
+    if (!res) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    // Resume after this match, stepping one byte past an empty match
+    // so it isn't found again forever.
+    const char *end = self->match->caps[1];
+    self->subj.begin = end == self->match->caps[0] ? end + 1 : end;
+    return MP_OBJ_FROM_PTR(self->match);
+}
+
+#if !MICROPY_ENABLE_DYNRUNTIME
+STATIC const mp_obj_type_t re_finditer_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_finditer,
+    .getiter = mp_identity_getiter,
+    .iternext = re_finditer_iternext,
+};
+#endif
+
+STATIC mp_obj_t re_finditer(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    mp_obj_re_t *self;
+    if (mp_obj_is_type(args[0], &re_type)) {
+        self = MP_OBJ_TO_PTR(args[0]);
+    } else {
+        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
+    }
+    mp_obj_re_finditer_t *iter = m_new_obj(mp_obj_re_finditer_t);
+    iter->base.type = &re_finditer_type;
+    iter->re = MP_OBJ_FROM_PTR(self);
+    size_t len;
+    iter->subj.begin = mp_obj_str_get_data(args[1], &len);
+    iter->subj.end = iter->subj.begin + len;
+    int caps_num = (self->re.sub + 1) * 2;
+    iter->match = m_new_obj_var(mp_obj_match_t, char *, caps_num);
+    iter->match->base.type = &match_type;
+    iter->match->num_matches = caps_num / 2; // caps_num counts start and end pointers
+    iter->match->str = args[1];
+    return MP_OBJ_FROM_PTR(iter);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_finditer_obj, 2, 2, re_finditer);
+
+#endif // MICROPY_PY_URE_FINDITER
+
 STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     mp_obj_re_t *self = MP_OBJ_TO_PTR(args[0]);
     Subject subj;
@@ -234,7 +465,7 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char **)caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = ure_exec_prog(&self->re, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -294,7 +525,7 @@ STATIC mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char *)match->caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = ure_exec_prog(&self->re, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -384,6 +615,9 @@ STATIC const mp_rom_map_elem_t re_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_match), MP_ROM_PTR(&re_match_obj) },
     { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&re_search_obj) },
     { MP_ROM_QSTR(MP_QSTR_split), MP_ROM_PTR(&re_split_obj) },
+    #if MICROPY_PY_URE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&re_finditer_obj) },
+    #endif
     #if MICROPY_PY_URE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
     #endif
@@ -401,6 +635,24 @@ STATIC const mp_obj_type_t re_type = {
 
 STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
     (void)n_args;
+    #if MICROPY_PY_URE_CACHE_SIZE > 0
+    // Look the pattern up in the MRU cache of compiled regexes; compiled
+    // regexes are immutable so the same object can be handed out again.
+    // Compiles with explicit flags (debug dumps) bypass the cache.
+    mp_obj_t *cache = MP_STATE_VM(ure_cache);
+    if (n_args == 1) {
+        for (size_t i = 0; i < MICROPY_PY_URE_CACHE_SIZE && cache[2 * i] != MP_OBJ_NULL; ++i) {
+            if (mp_obj_get_type(cache[2 * i]) == mp_obj_get_type(args[0])
+                && mp_obj_equal(cache[2 * i], args[0])) {
+                mp_obj_t compiled = cache[2 * i + 1];
+                memmove(&cache[2], &cache[0], 2 * i * sizeof(mp_obj_t));
+                cache[0] = args[0];
+                cache[1] = compiled;
+                return compiled;
+            }
+        }
+    }
+    #endif
     const char *re_str = mp_obj_str_get_str(args[0]);
     int size = re1_5_sizecode(re_str);
     if (size == -1) {
@@ -424,6 +676,14 @@ STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
         re1_5_dumpcode(&o->re);
     }
     #endif
+    #if MICROPY_PY_URE_CACHE_SIZE > 0
+    if (n_args == 1) {
+        // Insert at the front, evicting the least-recently-used entry.
+        memmove(&cache[2], &cache[0], 2 * (MICROPY_PY_URE_CACHE_SIZE - 1) * sizeof(mp_obj_t));
+        cache[0] = args[0];
+        cache[1] = MP_OBJ_FROM_PTR(o);
+    }
+    #endif
     return MP_OBJ_FROM_PTR(o);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_re_compile_obj, 1, 2, mod_re_compile);
@@ -434,6 +694,9 @@ STATIC const mp_rom_map_elem_t mp_module_re_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_compile), MP_ROM_PTR(&mod_re_compile_obj) },
     { MP_ROM_QSTR(MP_QSTR_match), MP_ROM_PTR(&re_match_obj) },
     { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&re_search_obj) },
+    #if MICROPY_PY_URE_FINDITER
+    { MP_ROM_QSTR(MP_QSTR_finditer), MP_ROM_PTR(&re_finditer_obj) },
+    #endif
     #if MICROPY_PY_URE_SUB
     { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&re_sub_obj) },
     #endif
@@ -64,10 +64,62 @@ struct ssl_args {
     mp_arg_val_t server_side;
     mp_arg_val_t server_hostname;
     mp_arg_val_t do_handshake;
+    mp_arg_val_t max_frag_len;
 };
 
 STATIC const mp_obj_type_t ussl_socket_type;
 
+#if MICROPY_PY_USSL_SESSION_CACHE_LEN
+
+// Small cache of recently negotiated TLS sessions, keyed by server hostname,
+// so that reconnecting to the same peer can resume instead of running a full
+// handshake.  The session structs are owned by mbedtls (not the uPy heap).
+typedef struct _ussl_session_entry_t {
+    char host[48]; // empty string means the slot is free
+    mbedtls_ssl_session session;
+} ussl_session_entry_t;
+
+STATIC ussl_session_entry_t ussl_session_cache[MICROPY_PY_USSL_SESSION_CACHE_LEN];
+STATIC uint8_t ussl_session_evict;
+
+STATIC ussl_session_entry_t *ussl_session_lookup(const char *host) {
+    for (size_t i = 0; i < MICROPY_PY_USSL_SESSION_CACHE_LEN; i++) {
+        if (strcmp(ussl_session_cache[i].host, host) == 0) {
+            return &ussl_session_cache[i];
+        }
+    }
+    return NULL;
+}
+
+STATIC void ussl_session_store(const char *host, mbedtls_ssl_context *ssl) {
+    if (strlen(host) >= sizeof(ussl_session_cache[0].host)) {
+        // hostname too long to cache
+        return;
+    }
+    ussl_session_entry_t *entry = ussl_session_lookup(host);
+    if (entry == NULL) {
+        for (size_t i = 0; i < MICROPY_PY_USSL_SESSION_CACHE_LEN; i++) {
+            if (ussl_session_cache[i].host[0] == '\0') {
+                entry = &ussl_session_cache[i];
+                break;
+            }
+        }
+        if (entry == NULL) {
+            // all slots taken, evict round-robin
+            entry = &ussl_session_cache[ussl_session_evict];
+            ussl_session_evict = (ussl_session_evict + 1) % MICROPY_PY_USSL_SESSION_CACHE_LEN;
+        }
+        strcpy(entry->host, host);
+    }
+    mbedtls_ssl_session_free(&entry->session);
+    if (mbedtls_ssl_get_session(ssl, &entry->session) != 0) {
+        // failed to snapshot the session; free the slot
+        entry->host[0] = '\0';
+    }
+}
+
+#endif // MICROPY_PY_USSL_SESSION_CACHE_LEN
+
 #ifdef MBEDTLS_DEBUG_C
 STATIC void mbedtls_debug(void *ctx, int level, const char *file, int line, const char *str) {
     (void)ctx;
@@ -197,13 +249,47 @@ STATIC mp_obj_ssl_socket_t *socket_new(mp_obj_t sock, struct ssl_args *args) {
     mbedtls_ssl_conf_dbg(&o->conf, mbedtls_debug, NULL);
     #endif
 
+    if (args->max_frag_len.u_int != 0) {
+        // Negotiate a smaller maximum record size with the peer, so that
+        // builds using mbedtls's variable-length I/O buffers don't pay the
+        // full 16KB per direction for short-message connections.
+        #ifdef MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+        unsigned char mfl_code;
+        switch (args->max_frag_len.u_int) {
+            case 512:
+                mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+                break;
+            case 1024:
+                mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+                break;
+            case 2048:
+                mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+                break;
+            case 4096:
+                mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+                break;
+            default:
+                ret = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+                goto cleanup;
+        }
+        ret = mbedtls_ssl_conf_max_frag_len(&o->conf, mfl_code);
+        if (ret != 0) {
+            goto cleanup;
+        }
+        #else
+        ret = MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+        goto cleanup;
+        #endif
+    }
+
     ret = mbedtls_ssl_setup(&o->ssl, &o->conf);
     if (ret != 0) {
         goto cleanup;
     }
 
+    const char *sni = NULL;
     if (args->server_hostname.u_obj != mp_const_none) {
-        const char *sni = mp_obj_str_get_str(args->server_hostname.u_obj);
+        sni = mp_obj_str_get_str(args->server_hostname.u_obj);
         ret = mbedtls_ssl_set_hostname(&o->ssl, sni);
         if (ret != 0) {
             goto cleanup;
@@ -237,12 +323,28 @@ STATIC mp_obj_ssl_socket_t *socket_new(mp_obj_t sock, struct ssl_args *args) {
         }
     }
 
+    #if MICROPY_PY_USSL_SESSION_CACHE_LEN
+    if (!args->server_side.u_bool && sni != NULL) {
+        ussl_session_entry_t *entry = ussl_session_lookup(sni);
+        if (entry != NULL) {
+            // Offer the cached session for resumption; if the server declines
+            // (or this fails) the handshake below falls back to a full one.
+            mbedtls_ssl_set_session(&o->ssl, &entry->session);
+        }
+    }
+    #endif
+
     if (args->do_handshake.u_bool) {
         while ((ret = mbedtls_ssl_handshake(&o->ssl)) != 0) {
             if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
                 goto cleanup;
             }
         }
+        #if MICROPY_PY_USSL_SESSION_CACHE_LEN
+        if (!args->server_side.u_bool && sni != NULL) {
+            ussl_session_store(sni, &o->ssl);
+        }
+        #endif
     }
 
     return o;
@@ -262,6 +364,8 @@ cleanup:
         mp_raise_ValueError(MP_ERROR_TEXT("invalid key"));
     } else if (ret == MBEDTLS_ERR_X509_BAD_INPUT_DATA) {
         mp_raise_ValueError(MP_ERROR_TEXT("invalid cert"));
+    } else if (ret == MBEDTLS_ERR_SSL_BAD_INPUT_DATA) {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid max_frag_len"));
     } else {
         mbedtls_raise_error(ret);
     }
@@ -393,6 +497,7 @@ STATIC mp_obj_t mod_ssl_wrap_socket(size_t n_args, const mp_obj_t *pos_args, mp_
         { MP_QSTR_server_side, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_server_hostname, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_do_handshake, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_max_frag_len, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
     };
 
     // TODO: Check that sock implements stream protocol
@@ -164,6 +164,44 @@ STATIC mp_obj_t mod_utimeq_heappop(mp_obj_t heap_in, mp_obj_t list_ref) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mod_utimeq_heappop_obj, mod_utimeq_heappop);
 
+// Whether an entry scheduled at item->time is due at time t, using the same
+// ring arithmetic as time_less_than.
+STATIC bool time_due(struct qentry *item, mp_uint_t t) {
+    mp_uint_t res = t - item->time;
+    if ((mp_int_t)res < 0) {
+        res += MODULO;
+    }
+    return res < (MODULO / 2);
+}
+
+// Pop every entry that is due at time t, appending callback and args of each
+// (in scheduling order) to the given list.  Returns the number of entries
+// popped.  Draining all due events in one call saves a method call, argument
+// checks and a result tuple per event compared to looping over pop().
+STATIC mp_obj_t mod_utimeq_pop_all_due(mp_obj_t heap_in, mp_obj_t time_in, mp_obj_t list_ref) {
+    mp_obj_utimeq_t *heap = utimeq_get_heap(heap_in);
+    if (!mp_obj_is_type(list_ref, &mp_type_list)) {
+        mp_raise_TypeError(NULL);
+    }
+    mp_uint_t t = MP_OBJ_SMALL_INT_VALUE(time_in);
+    mp_uint_t count = 0;
+    while (heap->len != 0 && time_due(&heap->items[0], t)) {
+        struct qentry *item = &heap->items[0];
+        mp_obj_list_append(list_ref, item->callback);
+        mp_obj_list_append(list_ref, item->args);
+        heap->len -= 1;
+        heap->items[0] = heap->items[heap->len];
+        heap->items[heap->len].callback = MP_OBJ_NULL; // so we don't retain a pointer
+        heap->items[heap->len].args = MP_OBJ_NULL;
+        if (heap->len) {
+            utimeq_heap_siftup(heap, 0);
+        }
+        count++;
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(mod_utimeq_pop_all_due_obj, mod_utimeq_pop_all_due);
+
 STATIC mp_obj_t mod_utimeq_peektime(mp_obj_t heap_in) {
     mp_obj_utimeq_t *heap = utimeq_get_heap(heap_in);
     if (heap->len == 0) {
@@ -202,6 +240,7 @@ STATIC mp_obj_t utimeq_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
 STATIC const mp_rom_map_elem_t utimeq_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_push), MP_ROM_PTR(&mod_utimeq_heappush_obj) },
     { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&mod_utimeq_heappop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pop_all_due), MP_ROM_PTR(&mod_utimeq_pop_all_due_obj) },
     { MP_ROM_QSTR(MP_QSTR_peektime), MP_ROM_PTR(&mod_utimeq_peektime_obj) },
     #if DEBUG
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_utimeq_dump_obj) },
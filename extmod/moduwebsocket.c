@@ -34,6 +34,14 @@
 
 #if MICROPY_PY_UWEBSOCKET
 
+// Frames whose header plus payload fit in this buffer are sent with a single
+// write to the underlying stream, so a frame doesn't cost two TCP segments;
+// larger payloads are written separately after the header.  Set to 0 to
+// compile out the buffer.
+#ifndef MICROPY_PY_UWEBSOCKET_FRAMEBUF
+#define MICROPY_PY_UWEBSOCKET_FRAMEBUF (264)
+#endif
+
 enum { FRAME_HEADER, FRAME_OPT, PAYLOAD, CONTROL };
 
 enum { BLOCKING_WRITE = 0x80 };
@@ -238,9 +246,25 @@ STATIC mp_uint_t websocket_write(mp_obj_t self_in, const void *buf, mp_uint_t si
         mp_call_method_n_kw(1, 0, dest);
     }
 
-    mp_uint_t out_sz = mp_stream_write_exactly(self->sock, header, hdr_sz, errcode);
-    if (*errcode == 0) {
-        out_sz = mp_stream_write_exactly(self->sock, buf, size, errcode);
+    mp_uint_t out_sz;
+    #if MICROPY_PY_UWEBSOCKET_FRAMEBUF
+    if (hdr_sz + size <= MICROPY_PY_UWEBSOCKET_FRAMEBUF) {
+        // Ports that don't have much available stack can make this static
+        #if MICROPY_PY_UWEBSOCKET_STATIC_FRAMEBUF
+        static
+        #endif
+        byte framebuf[MICROPY_PY_UWEBSOCKET_FRAMEBUF];
+        memcpy(framebuf, header, hdr_sz);
+        memcpy(framebuf + hdr_sz, buf, size);
+        mp_stream_write_exactly(self->sock, framebuf, hdr_sz + size, errcode);
+        out_sz = size;
+    } else
+    #endif
+    {
+        out_sz = mp_stream_write_exactly(self->sock, header, hdr_sz, errcode);
+        if (*errcode == 0) {
+            out_sz = mp_stream_write_exactly(self->sock, buf, size, errcode);
+        }
     }
 
     if (self->opts & BLOCKING_WRITE) {
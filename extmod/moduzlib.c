@@ -44,8 +44,11 @@
 typedef struct _mp_obj_decompio_t {
     mp_obj_base_t base;
     mp_obj_t src_stream;
+    mp_obj_t dict_obj; // caller-provided window, or MP_OBJ_NULL
     TINF_DATA decomp;
     bool eof;
+    uint16_t src_buf_size;
+    byte src_buf[0]; // src_buf_size bytes of source read buffer
 } mp_obj_decompio_t;
 
 STATIC int read_src_stream(TINF_DATA *data) {
@@ -55,26 +58,53 @@ STATIC int read_src_stream(TINF_DATA *data) {
 
     const mp_stream_p_t *stream = mp_get_stream(self->src_stream);
     int err;
-    byte c;
-    mp_uint_t out_sz = stream->read(self->src_stream, &c, 1, &err);
+    mp_uint_t out_sz = stream->read(self->src_stream, self->src_buf, self->src_buf_size, &err);
     if (out_sz == MP_STREAM_ERROR) {
         mp_raise_OSError(err);
     }
     if (out_sz == 0) {
         mp_raise_type(&mp_type_EOFError);
     }
-    return c;
+    // Serve any bytes beyond the first directly from the buffer, without
+    // coming back through this callback.
+    data->source = self->src_buf + 1;
+    data->source_limit = self->src_buf + out_sz;
+    return self->src_buf[0];
 }
 
 STATIC mp_obj_t decompio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    mp_arg_check_num(n_args, n_kw, 1, 2, false);
+    mp_arg_check_num(n_args, n_kw, 1, 3, false);
     mp_get_stream_raise(args[0], MP_STREAM_OP_READ);
-    mp_obj_decompio_t *o = m_new_obj(mp_obj_decompio_t);
+
+    // Optional third arg is the source read buffer size.  The default of 1
+    // byte per read never consumes input beyond the end of the compressed
+    // stream; a bigger buffer reads the source in blocks, which is much
+    // faster but over-reads a stream that has trailing data.
+    mp_int_t src_buf_size = 1;
+    if (n_args > 2) {
+        src_buf_size = mp_obj_get_int(args[2]);
+        if (src_buf_size < 1 || src_buf_size > UINT16_MAX) {
+            mp_raise_ValueError(MP_ERROR_TEXT("buffer size"));
+        }
+    }
+
+    mp_obj_decompio_t *o = m_new_obj_var(mp_obj_decompio_t, byte, src_buf_size);
     o->base.type = type;
     memset(&o->decomp, 0, sizeof(o->decomp));
     o->decomp.readSource = read_src_stream;
     o->src_stream = args[0];
+    o->dict_obj = MP_OBJ_NULL;
     o->eof = false;
+    o->src_buf_size = src_buf_size;
+
+    mp_buffer_info_t dictinfo;
+    if (n_args > 1 && mp_get_buffer(args[1], &dictinfo, MP_BUFFER_RW)) {
+        // Caller-provided window buffer; the stream is raw DEFLATE data
+        // with a window of the size of the buffer.
+        o->dict_obj = args[1];
+        uzlib_uncompress_init(&o->decomp, dictinfo.buf, dictinfo.len);
+        return MP_OBJ_FROM_PTR(o);
+    }
 
     mp_int_t dict_opt = 0;
     int dict_sz;
@@ -146,6 +176,271 @@ STATIC const mp_obj_type_t decompio_type = {
 };
 #endif
 
+#if MICROPY_PY_UZLIB_COMPRESS
+
+// DEFLATE encoder emitting a single fixed-Huffman block, with greedy LZ77
+// matching bounded by a configurable window.  Matches are found within the
+// buffer passed to each write()/compress() call, so memory use is one hash
+// table of recent positions plus a small output batch buffer, independent
+// of how much data flows through.
+
+#define UZLIB_COMP_HASH_BITS (8)
+#define UZLIB_COMP_HASH_SIZE (1 << UZLIB_COMP_HASH_BITS)
+
+// base values and extra-bit counts for length codes 257-285 (lengths 3-258)
+STATIC const uint16_t uzlib_comp_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+STATIC const uint8_t uzlib_comp_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+// base values and extra-bit counts for distance codes 0-29 (dists 1-32768)
+STATIC const uint16_t uzlib_comp_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+STATIC const uint8_t uzlib_comp_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+typedef struct _uzlib_comp_t {
+    mp_obj_t dest_stream; // MP_OBJ_NULL to collect into vstr instead
+    vstr_t *vstr;
+    uint32_t bitbuf;
+    uint8_t bitcount;
+    bool zlib; // emit zlib header/adler32 trailer
+    uint32_t adler;
+    uint32_t window; // maximum match distance
+    size_t outlen;
+    byte outbuf[64];
+    size_t hash[UZLIB_COMP_HASH_SIZE]; // position of last occurrence, biased by 1
+} uzlib_comp_t;
+
+STATIC void uzlib_comp_flush(uzlib_comp_t *c) {
+    if (c->outlen > 0) {
+        if (c->dest_stream != MP_OBJ_NULL) {
+            mp_stream_write_adaptor(MP_OBJ_TO_PTR(c->dest_stream), (const char *)c->outbuf, c->outlen);
+        } else {
+            vstr_add_strn(c->vstr, (const char *)c->outbuf, c->outlen);
+        }
+        c->outlen = 0;
+    }
+}
+
+STATIC void uzlib_comp_out_byte(uzlib_comp_t *c, byte b) {
+    if (c->outlen == sizeof(c->outbuf)) {
+        uzlib_comp_flush(c);
+    }
+    c->outbuf[c->outlen++] = b;
+}
+
+// append bits LSB-first, as DEFLATE packs them
+STATIC void uzlib_comp_put_bits(uzlib_comp_t *c, uint32_t val, int n) {
+    c->bitbuf |= val << c->bitcount;
+    c->bitcount += n;
+    while (c->bitcount >= 8) {
+        uzlib_comp_out_byte(c, c->bitbuf & 0xff);
+        c->bitbuf >>= 8;
+        c->bitcount -= 8;
+    }
+}
+
+// append a Huffman code, whose bits go into the stream MSB-first
+STATIC void uzlib_comp_put_code(uzlib_comp_t *c, uint32_t code, int n) {
+    while (n--) {
+        uzlib_comp_put_bits(c, (code >> n) & 1, 1);
+    }
+}
+
+// fixed-Huffman code for literal/length symbol 0-287
+STATIC void uzlib_comp_put_sym(uzlib_comp_t *c, int sym) {
+    if (sym < 144) {
+        uzlib_comp_put_code(c, 0x30 + sym, 8);
+    } else if (sym < 256) {
+        uzlib_comp_put_code(c, 0x190 + sym - 144, 9);
+    } else if (sym < 280) {
+        uzlib_comp_put_code(c, sym - 256, 7);
+    } else {
+        uzlib_comp_put_code(c, 0xc0 + sym - 280, 8);
+    }
+}
+
+STATIC void uzlib_comp_put_match(uzlib_comp_t *c, size_t len, size_t dist) {
+    int i = 28;
+    while (uzlib_comp_len_base[i] > len) {
+        --i;
+    }
+    uzlib_comp_put_sym(c, 257 + i);
+    uzlib_comp_put_bits(c, len - uzlib_comp_len_base[i], uzlib_comp_len_extra[i]);
+    i = 29;
+    while (uzlib_comp_dist_base[i] > dist) {
+        --i;
+    }
+    uzlib_comp_put_code(c, i, 5); // fixed distance codes are 5 bits
+    uzlib_comp_put_bits(c, dist - uzlib_comp_dist_base[i], uzlib_comp_dist_extra[i]);
+}
+
+STATIC void uzlib_comp_start(uzlib_comp_t *c) {
+    if (c->zlib) {
+        uzlib_comp_out_byte(c, 0x78);
+        uzlib_comp_out_byte(c, 0x9c);
+    }
+    uzlib_comp_put_bits(c, 1, 1); // BFINAL
+    uzlib_comp_put_bits(c, 1, 2); // BTYPE=1, fixed Huffman
+}
+
+STATIC void uzlib_comp_write(uzlib_comp_t *c, const byte *data, size_t len) {
+    if (c->zlib) {
+        c->adler = uzlib_adler32(data, len, c->adler);
+    }
+    memset(c->hash, 0, sizeof(c->hash));
+    for (size_t i = 0; i < len;) {
+        if (i + 3 <= len) {
+            size_t h = (data[i] * 33 * 33 + data[i + 1] * 33 + data[i + 2]) & (UZLIB_COMP_HASH_SIZE - 1);
+            size_t cand = c->hash[h]; // biased by 1 so 0 means empty
+            c->hash[h] = i + 1;
+            if (cand != 0 && i + 1 - cand <= c->window
+                && memcmp(&data[cand - 1], &data[i], 3) == 0) {
+                size_t mlen = 3;
+                size_t max = len - i < 258 ? len - i : 258;
+                while (mlen < max && data[cand - 1 + mlen] == data[i + mlen]) {
+                    ++mlen;
+                }
+                uzlib_comp_put_match(c, mlen, i + 1 - cand);
+                i += mlen;
+                continue;
+            }
+        }
+        uzlib_comp_put_sym(c, data[i]);
+        ++i;
+    }
+}
+
+STATIC void uzlib_comp_finish(uzlib_comp_t *c) {
+    uzlib_comp_put_sym(c, 256); // end of block
+    if (c->bitcount > 0) {
+        uzlib_comp_out_byte(c, c->bitbuf & 0xff);
+        c->bitbuf = 0;
+        c->bitcount = 0;
+    }
+    if (c->zlib) {
+        for (int i = 24; i >= 0; i -= 8) {
+            uzlib_comp_out_byte(c, (c->adler >> i) & 0xff);
+        }
+    }
+    uzlib_comp_flush(c);
+}
+
+// parse a wbits argument: positive for zlib framing, negative for raw
+// DEFLATE, magnitude 5-15 bounding the match window
+STATIC void uzlib_comp_init(uzlib_comp_t *c, mp_obj_t wbits_in) {
+    mp_int_t wbits = 15;
+    if (wbits_in != MP_OBJ_NULL) {
+        wbits = mp_obj_get_int(wbits_in);
+    }
+    mp_int_t mag = wbits < 0 ? -wbits : wbits;
+    if (mag < 5 || mag > 15) {
+        mp_raise_ValueError(MP_ERROR_TEXT("wbits"));
+    }
+    c->zlib = wbits > 0;
+    c->adler = 1;
+    c->window = 1 << mag;
+    c->bitbuf = 0;
+    c->bitcount = 0;
+    c->outlen = 0;
+}
+
+typedef struct _mp_obj_compio_t {
+    mp_obj_base_t base;
+    bool finished;
+    uzlib_comp_t comp;
+} mp_obj_compio_t;
+
+STATIC mp_obj_t compio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 2, false);
+    mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+    mp_obj_compio_t *o = m_new_obj(mp_obj_compio_t);
+    o->base.type = type;
+    o->finished = false;
+    uzlib_comp_init(&o->comp, n_args > 1 ? args[1] : MP_OBJ_NULL);
+    o->comp.dest_stream = args[0];
+    uzlib_comp_start(&o->comp);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_uint_t compio_write(mp_obj_t o_in, const void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    if (o->finished) {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+    uzlib_comp_write(&o->comp, buf, size);
+    return size;
+}
+
+STATIC mp_uint_t compio_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_compio_t *o = MP_OBJ_TO_PTR(o_in);
+    (void)arg;
+    if (request == MP_STREAM_CLOSE) {
+        // terminate the DEFLATE stream; the underlying stream stays open
+        if (!o->finished) {
+            o->finished = true;
+            uzlib_comp_finish(&o->comp);
+        }
+        return 0;
+    }
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+#if !MICROPY_ENABLE_DYNRUNTIME
+STATIC const mp_rom_map_elem_t compio_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(compio_locals_dict, compio_locals_dict_table);
+#endif
+
+STATIC const mp_stream_p_t compio_stream_p = {
+    .write = compio_write,
+    .ioctl = compio_ioctl,
+};
+
+#if !MICROPY_ENABLE_DYNRUNTIME
+STATIC const mp_obj_type_t compio_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_CompIO,
+    .make_new = compio_make_new,
+    .protocol = &compio_stream_p,
+    .locals_dict = (void *)&compio_locals_dict,
+};
+#endif
+
+STATIC mp_obj_t mod_uzlib_compress(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    uzlib_comp_t *comp = m_new_obj(uzlib_comp_t);
+    vstr_t vstr;
+    vstr_init(&vstr, bufinfo.len / 2 + 8);
+    uzlib_comp_init(comp, n_args > 1 ? args[1] : MP_OBJ_NULL);
+    comp->dest_stream = MP_OBJ_NULL;
+    comp->vstr = &vstr;
+    uzlib_comp_start(comp);
+    uzlib_comp_write(comp, bufinfo.buf, bufinfo.len);
+    uzlib_comp_finish(comp);
+    m_del_obj(uzlib_comp_t, comp);
+    return mp_obj_new_str_from_vstr(&mp_type_bytes, &vstr);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_compress_obj, 1, 2, mod_uzlib_compress);
+
+#endif // MICROPY_PY_UZLIB_COMPRESS
+
 STATIC mp_obj_t mod_uzlib_decompress(size_t n_args, const mp_obj_t *args) {
     mp_obj_t data = args[0];
     mp_buffer_info_t bufinfo;
@@ -179,7 +474,10 @@ STATIC mp_obj_t mod_uzlib_decompress(size_t n_args, const mp_obj_t *args) {
     }
 
     while (1) {
-        st = uzlib_uncompress_chksum(decomp);
+        // the source is a pinned in-memory buffer (no read callback), so
+        // each bounded decompress step can run with the GIL released
+        MP_THREAD_GIL_RELEASED(bufinfo.len >= 256,
+            st = uzlib_uncompress_chksum(decomp));
         if (st < 0) {
             goto error;
         }
@@ -205,10 +503,44 @@ error:
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_decompress_obj, 1, 3, mod_uzlib_decompress);
 
+// crc32(data, crc=0) and adler32(data, adler=1), compatible with CPython's
+// zlib/binascii versions, using the table-driven routines that are already
+// compiled in for stream checksum verification.
+
+STATIC mp_obj_t mod_uzlib_crc32(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    uint32_t crc = 0;
+    if (n_args > 1) {
+        crc = mp_obj_get_int_truncated(args[1]);
+    }
+    // uzlib_crc32 works on the inverted value
+    crc = ~uzlib_crc32(bufinfo.buf, bufinfo.len, ~crc);
+    return mp_obj_new_int_from_uint(crc);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_crc32_obj, 1, 2, mod_uzlib_crc32);
+
+STATIC mp_obj_t mod_uzlib_adler32(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    uint32_t sum = 1;
+    if (n_args > 1) {
+        sum = mp_obj_get_int_truncated(args[1]);
+    }
+    return mp_obj_new_int_from_uint(uzlib_adler32(bufinfo.buf, bufinfo.len, sum));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_uzlib_adler32_obj, 1, 2, mod_uzlib_adler32);
+
 #if !MICROPY_ENABLE_DYNRUNTIME
 STATIC const mp_rom_map_elem_t mp_module_uzlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uzlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&mod_uzlib_decompress_obj) },
+    #if MICROPY_PY_UZLIB_COMPRESS
+    { MP_ROM_QSTR(MP_QSTR_compress), MP_ROM_PTR(&mod_uzlib_compress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_CompIO), MP_ROM_PTR(&compio_type) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_crc32), MP_ROM_PTR(&mod_uzlib_crc32_obj) },
+    { MP_ROM_QSTR(MP_QSTR_adler32), MP_ROM_PTR(&mod_uzlib_adler32_obj) },
     { MP_ROM_QSTR(MP_QSTR_DecompIO), MP_ROM_PTR(&decompio_type) },
 };
 
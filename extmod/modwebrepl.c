@@ -44,6 +44,13 @@
 #define DEBUG_printf(...) (void)0
 #endif
 
+// Number of file chunks sent per client ack in a windowed GET_FILE transfer
+// (requested by setting FLAG_WINDOWED in the operation header); set to 0 to
+// compile out windowed transfer support.
+#ifndef MICROPY_PY_WEBREPL_WINDOW
+#define MICROPY_PY_WEBREPL_WINDOW (8)
+#endif
+
 struct webrepl_file {
     char sig[2];
     char type;
@@ -55,6 +62,7 @@ struct webrepl_file {
 } __attribute__((packed));
 
 enum { PUT_FILE = 1, GET_FILE, GET_VER };
+enum { FLAG_WINDOWED = 1 };
 enum { STATE_PASSWD, STATE_NORMAL };
 
 typedef struct _mp_obj_webrepl_t {
@@ -63,6 +71,10 @@ typedef struct _mp_obj_webrepl_t {
     byte state;
     byte hdr_to_recv;
     uint32_t data_to_recv;
+    #if MICROPY_PY_WEBREPL_WINDOW
+    byte windowed;
+    uint32_t window_crc;
+    #endif
     struct webrepl_file hdr;
     mp_obj_t cur_file;
 } mp_obj_webrepl_t;
@@ -93,6 +105,21 @@ STATIC void write_webrepl_resp(mp_obj_t websock, uint16_t code) {
     write_webrepl(websock, buf, sizeof(buf));
 }
 
+#if MICROPY_PY_WEBREPL_WINDOW
+// Standard CRC-32 (same polynomial and pre/post-conditioning as
+// binascii.crc32), computed bitwise to avoid carrying a table.
+STATIC uint32_t webrepl_crc32(uint32_t crc, const byte *buf, size_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xedb88320 : 0);
+        }
+    }
+    return ~crc;
+}
+#endif
+
 STATIC mp_obj_t webrepl_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 1, 2, false);
     mp_get_stream_raise(args[0], MP_STREAM_OP_READ | MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
@@ -126,6 +153,11 @@ STATIC int write_file_chunk(mp_obj_webrepl_t *self) {
     }
     readbuf[0] = out_sz;
     readbuf[1] = out_sz >> 8;
+    #if MICROPY_PY_WEBREPL_WINDOW
+    if (self->windowed) {
+        self->window_crc = webrepl_crc32(self->window_crc, readbuf + 2, out_sz);
+    }
+    #endif
     DEBUG_printf("webrepl: Sending %d bytes of file\n", out_sz);
     write_webrepl(self->sock, readbuf, 2 + out_sz);
     return out_sz;
@@ -170,6 +202,9 @@ STATIC void handle_op(mp_obj_webrepl_t *self) {
         self->data_to_recv = self->hdr.size;
         check_file_op_finished(self);
     } else if (self->hdr.type == GET_FILE) {
+        #if MICROPY_PY_WEBREPL_WINDOW
+        self->windowed = self->hdr.flags & FLAG_WINDOWED;
+        #endif
         self->data_to_recv = 1;
     }
 }
@@ -180,7 +215,7 @@ STATIC mp_uint_t webrepl_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *
     mp_uint_t out_sz;
     do {
         out_sz = _webrepl_read(self_in, buf, size, errcode);
-    } while (out_sz == -2);
+    } while (out_sz == (mp_uint_t)-2);
     return out_sz;
 }
 
@@ -264,7 +299,6 @@ STATIC mp_uint_t _webrepl_read(mp_obj_t self_in, void *buf, mp_uint_t size, int
 
         if (self->hdr.type == PUT_FILE) {
             DEBUG_printf("webrepl: Writing %lu bytes to file\n", buf_sz);
-            int err;
             mp_uint_t res = mp_stream_write_exactly(self->cur_file, filebuf, buf_sz, &err);
             if (err != 0 || res != buf_sz) {
                 assert(0);
@@ -273,8 +307,27 @@ STATIC mp_uint_t _webrepl_read(mp_obj_t self_in, void *buf, mp_uint_t size, int
             assert(buf_sz == 1);
             assert(self->data_to_recv == 0);
             assert(filebuf[0] == 0);
-            mp_uint_t out_sz = write_file_chunk(self);
-            if (out_sz != 0) {
+            mp_uint_t chunk_sz;
+            #if MICROPY_PY_WEBREPL_WINDOW
+            if (self->windowed) {
+                // Send a whole window of chunks per client ack, followed by
+                // the CRC of the window's data, instead of one chunk per ack.
+                self->window_crc = 0;
+                for (int i = 0; i < MICROPY_PY_WEBREPL_WINDOW; i++) {
+                    chunk_sz = write_file_chunk(self);
+                    if (chunk_sz == 0 || chunk_sz == (mp_uint_t)MP_STREAM_ERROR) {
+                        break;
+                    }
+                }
+                uint32_t crc = self->window_crc;
+                byte crcbuf[4] = {crc, crc >> 8, crc >> 16, crc >> 24};
+                write_webrepl(self->sock, crcbuf, sizeof(crcbuf));
+            } else
+            #endif
+            {
+                chunk_sz = write_file_chunk(self);
+            }
+            if (chunk_sz != 0) {
                 self->data_to_recv = 1;
             }
         }
@@ -12,6 +12,8 @@ _attrs = {
     "Event": "event",
     "ThreadSafeFlag": "event",
     "Lock": "lock",
+    "FileStream": "fileio",
+    "open": "fileio",
     "open_connection": "stream",
     "start_server": "stream",
     "StreamReader": "stream",
@@ -10,6 +10,19 @@ try:
 except:
     from .task import TaskQueue, Task
 
+# Native scheduling loop, which resumes coroutines without executing Python
+# bytecode per task switch; falls back to the Python loop below if absent
+try:
+    from _uasyncio import run_until_complete as _native_run_until_complete
+except (ImportError, AttributeError):
+    _native_run_until_complete = None
+
+# Inbox for posting objects from another thread into this loop, if available
+try:
+    from _uasyncio import ThreadSafeQueue
+except (ImportError, AttributeError):
+    pass
+
 
 ################################################################################
 # Exceptions
@@ -50,11 +63,16 @@ class SingletonGenerator:
 
 
 # Pause task execution for the given time (integer in milliseconds, uPy extension)
-# Use a SingletonGenerator to do it without allocating on the heap
-def sleep_ms(t, sgen=SingletonGenerator()):
-    assert sgen.state is None
-    sgen.state = ticks_add(ticks(), max(0, t))
-    return sgen
+# Use a SingletonGenerator to do it without allocating on the heap; prefer the
+# C version, which also keeps the schedule/finish steps out of Python bytecode
+try:
+    from _uasyncio import sleep_ms
+except (ImportError, AttributeError):
+
+    def sleep_ms(t, sgen=SingletonGenerator()):
+        assert sgen.state is None
+        sgen.state = ticks_add(ticks(), max(0, t))
+        return sgen
 
 
 # Pause task execution for the given time (in seconds)
@@ -137,11 +155,14 @@ def _promote_to_task(aw):
     return aw if isinstance(aw, Task) else create_task(aw)
 
 
-# Create and schedule a new task from a coroutine
-def create_task(coro):
+# Create and schedule a new task from a coroutine; priority selects the
+# task's ready-lane when the scheduler has priority lanes enabled (0 is the
+# highest), and is stored but otherwise ignored when it doesn't
+def create_task(coro, priority=1):
     if not hasattr(coro, "send"):
         raise TypeError("coroutine expected")
     t = Task(coro, globals())
+    t.priority = priority
     _task_queue.push_head(t)
     return t
 
@@ -149,6 +170,8 @@ def create_task(coro):
 # Keep scheduling tasks until there are none left to schedule
 def run_until_complete(main_task=None):
     global cur_task
+    if _native_run_until_complete:
+        return _native_run_until_complete(main_task)
     excs_all = (CancelledError, Exception)  # To prevent heap allocation in loop
     excs_stop = (CancelledError, StopIteration)  # To prevent heap allocation in loop
     while True:
@@ -0,0 +1,87 @@
+# MicroPython uasyncio module
+# MIT license; Copyright (c) 2019-2020 Damien P. George
+
+from . import core
+import builtins
+
+# File reads and writes block the VM for the whole transfer, so a large
+# read from slow media stalls every other task.  FileStream splits the
+# transfer into chunk-sized steps and reschedules the task between steps,
+# letting other tasks run while the media works through the request.
+
+
+class FileStream:
+    def __init__(self, f, chunk=512):
+        self.f = f
+        self.chunk = chunk
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, exc_type, exc, tb):
+        self.close()
+
+    def close(self):
+        self.f.close()
+
+    async def wait_closed(self):
+        self.f.close()
+
+    def seek(self, offset, whence=0):
+        return self.f.seek(offset, whence)
+
+    def tell(self):
+        return self.f.tell()
+
+    async def read(self, n=-1):
+        r = b""
+        while n != 0:
+            sz = self.chunk if n < 0 or n > self.chunk else n
+            r2 = self.f.read(sz)
+            if not r2:
+                break
+            r += r2
+            if n > 0:
+                n -= len(r2)
+            if len(r2) < sz:
+                break  # short read means end of file
+            await core.sleep_ms(0)
+        return r
+
+    async def readinto(self, buf):
+        mv = memoryview(buf)
+        off = 0
+        while off < len(mv):
+            sz = min(self.chunk, len(mv) - off)
+            r = self.f.readinto(mv[off : off + sz])
+            if not r:
+                break
+            off += r
+            if r < sz:
+                break
+            await core.sleep_ms(0)
+        return off
+
+    async def readline(self):
+        await core.sleep_ms(0)
+        return self.f.readline()
+
+    async def write(self, buf):
+        mv = memoryview(buf)
+        off = 0
+        while off < len(mv):
+            ret = self.f.write(mv[off : off + self.chunk])
+            if ret:
+                off += ret
+            if off < len(mv):
+                await core.sleep_ms(0)
+        return off
+
+    async def flush(self):
+        await core.sleep_ms(0)
+        self.f.flush()
+
+
+# Open a file and wrap it in a FileStream
+async def open(path, mode="rb", chunk=512):
+    return FileStream(builtins.open(path, mode), chunk)
@@ -5,6 +5,7 @@ freeze(
         "uasyncio/__init__.py",
         "uasyncio/core.py",
         "uasyncio/event.py",
+        "uasyncio/fileio.py",
         "uasyncio/funcs.py",
         "uasyncio/lock.py",
         "uasyncio/stream.py",
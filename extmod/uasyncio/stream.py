@@ -3,6 +3,13 @@
 
 from . import core
 
+# Prefer the native awaitable stream helpers, which run the per-chunk
+# read/write loops in C instead of yielding through Python per chunk
+try:
+    from _uasyncio import stream_read, stream_readline, stream_write
+except ImportError:
+    stream_read = None
+
 
 class Stream:
     def __init__(self, s, e={}):
@@ -26,9 +33,16 @@ class Stream:
         # TODO yield?
         self.s.close()
 
-    async def read(self, n):
-        yield core._io_queue.queue_read(self.s)
-        return self.s.read(n)
+    if stream_read:
+
+        def read(self, n):
+            return stream_read(self.s, n)
+
+    else:
+
+        async def read(self, n):
+            yield core._io_queue.queue_read(self.s)
+            return self.s.read(n)
 
     async def readinto(self, buf):
         yield core._io_queue.queue_read(self.s)
@@ -46,27 +60,43 @@ class Stream:
                 n -= len(r2)
         return r
 
-    async def readline(self):
-        l = b""
-        while True:
-            yield core._io_queue.queue_read(self.s)
-            l2 = self.s.readline()  # may do multiple reads but won't block
-            l += l2
-            if not l2 or l[-1] == 10:  # \n (check l in case l2 is str)
-                return l
+    if stream_read:
+
+        def readline(self):
+            return stream_readline(self.s)
+
+    else:
+
+        async def readline(self):
+            l = b""
+            while True:
+                yield core._io_queue.queue_read(self.s)
+                l2 = self.s.readline()  # may do multiple reads but won't block
+                l += l2
+                if not l2 or l[-1] == 10:  # \n (check l in case l2 is str)
+                    return l
 
     def write(self, buf):
         self.out_buf += buf
 
-    async def drain(self):
-        mv = memoryview(self.out_buf)
-        off = 0
-        while off < len(mv):
-            yield core._io_queue.queue_write(self.s)
-            ret = self.s.write(mv[off:])
-            if ret is not None:
-                off += ret
-        self.out_buf = b""
+    if stream_read:
+
+        def drain(self):
+            buf = self.out_buf
+            self.out_buf = b""
+            return stream_write(self.s, buf)
+
+    else:
+
+        async def drain(self):
+            mv = memoryview(self.out_buf)
+            off = 0
+            while off < len(mv):
+                yield core._io_queue.queue_write(self.s)
+                ret = self.s.write(mv[off:])
+                if ret is not None:
+                    off += ret
+            self.out_buf = b""
 
 
 # Stream can be used for both reading and writing to save code size
@@ -32,11 +32,16 @@
 #include "py/objtuple.h"
 #include "py/objarray.h"
 #include "py/stream.h"
+#include "py/ringbuf.h"
 #include "extmod/misc.h"
 #include "shared/runtime/interrupt_char.h"
 
 #if MICROPY_PY_OS_DUPTERM
 
+#if MICROPY_PY_OS_DUPTERM_TX_BUF
+STATIC mp_obj_t dupterm_tx_drain(mp_obj_t arg);
+#endif
+
 void mp_uos_deactivate(size_t dupterm_idx, const char *msg, mp_obj_t exc) {
     mp_obj_t term = MP_STATE_VM(dupterm_objs[dupterm_idx]);
     MP_STATE_VM(dupterm_objs[dupterm_idx]) = MP_OBJ_NULL;
@@ -93,6 +98,11 @@ uintptr_t mp_uos_dupterm_poll(uintptr_t poll_flags) {
 }
 
 int mp_uos_dupterm_rx_chr(void) {
+    #if MICROPY_PY_OS_DUPTERM_TX_BUF
+    // Make sure buffered output (eg a prompt) is visible before reading.
+    dupterm_tx_drain(mp_const_none);
+    #endif
+
     for (size_t idx = 0; idx < MICROPY_PY_OS_DUPTERM; ++idx) {
         if (MP_STATE_VM(dupterm_objs[idx]) == MP_OBJ_NULL) {
             continue;
@@ -147,7 +157,8 @@ int mp_uos_dupterm_rx_chr(void) {
     return -1;
 }
 
-void mp_uos_dupterm_tx_strn(const char *str, size_t len) {
+// Write the data out to all active dupterm streams, blocking as needed.
+STATIC void mp_uos_dupterm_tx_write(const char *str, size_t len) {
     for (size_t idx = 0; idx < MICROPY_PY_OS_DUPTERM; ++idx) {
         if (MP_STATE_VM(dupterm_objs[idx]) == MP_OBJ_NULL) {
             continue;
@@ -172,6 +183,78 @@ void mp_uos_dupterm_tx_strn(const char *str, size_t len) {
     }
 }
 
+#if MICROPY_PY_OS_DUPTERM_TX_BUF
+
+// Pending output is queued here by mp_uos_dupterm_tx_strn and written to the
+// dupterm streams by dupterm_tx_drain, which runs via the scheduler between
+// VM opcodes.  Only byte data is stored so the buffer can live outside the
+// GC heap.
+STATIC uint8_t dupterm_tx_buf_mem[MICROPY_PY_OS_DUPTERM_TX_BUF];
+STATIC ringbuf_t dupterm_tx_buf = {dupterm_tx_buf_mem, sizeof(dupterm_tx_buf_mem), 0, 0};
+STATIC volatile bool dupterm_tx_scheduled;
+
+STATIC mp_obj_t dupterm_tx_drain(mp_obj_t arg) {
+    (void)arg;
+    dupterm_tx_scheduled = false;
+    uint8_t chunk[48];
+    for (;;) {
+        size_t n = ringbuf_avail(&dupterm_tx_buf);
+        if (n == 0) {
+            return mp_const_none;
+        }
+        if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
+        }
+        ringbuf_get_bytes(&dupterm_tx_buf, chunk, n);
+        mp_uos_dupterm_tx_write((const char *)chunk, n);
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(dupterm_tx_drain_obj, dupterm_tx_drain);
+
+void mp_uos_dupterm_tx_strn(const char *str, size_t len) {
+    // Avoid buffering (and scheduling) when there's no active dupterm slot.
+    bool any_active = false;
+    for (size_t idx = 0; idx < MICROPY_PY_OS_DUPTERM; ++idx) {
+        if (MP_STATE_VM(dupterm_objs[idx]) != MP_OBJ_NULL) {
+            any_active = true;
+            break;
+        }
+    }
+    if (!any_active) {
+        return;
+    }
+
+    while (len > 0) {
+        size_t n = ringbuf_free(&dupterm_tx_buf);
+        if (n == 0) {
+            // Buffer full: write it out now rather than dropping data.
+            dupterm_tx_drain(mp_const_none);
+            continue;
+        }
+        if (n > len) {
+            n = len;
+        }
+        ringbuf_put_bytes(&dupterm_tx_buf, (const uint8_t *)str, n);
+        str += n;
+        len -= n;
+        if (!dupterm_tx_scheduled) {
+            dupterm_tx_scheduled = mp_sched_schedule(MP_OBJ_FROM_PTR(&dupterm_tx_drain_obj), mp_const_none);
+            if (!dupterm_tx_scheduled) {
+                // Schedule queue is full; don't hold on to the data.
+                dupterm_tx_drain(mp_const_none);
+            }
+        }
+    }
+}
+
+#else
+
+void mp_uos_dupterm_tx_strn(const char *str, size_t len) {
+    mp_uos_dupterm_tx_write(str, len);
+}
+
+#endif // MICROPY_PY_OS_DUPTERM_TX_BUF
+
 STATIC mp_obj_t mp_uos_dupterm(size_t n_args, const mp_obj_t *args) {
     mp_int_t idx = 0;
     if (n_args == 2) {
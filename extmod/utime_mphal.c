@@ -64,6 +64,31 @@ STATIC mp_obj_t time_sleep_us(mp_obj_t arg) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_utime_sleep_us_obj, time_sleep_us);
 
+// Signed difference between two wrapped ticks values (see time_ticks_diff).
+STATIC mp_int_t ticks_ms_diff(mp_uint_t end, mp_uint_t start) {
+    return ((end - start + MICROPY_PY_UTIME_TICKS_PERIOD / 2) & (MICROPY_PY_UTIME_TICKS_PERIOD - 1))
+           - MICROPY_PY_UTIME_TICKS_PERIOD / 2;
+}
+
+// Block until the given ticks_ms deadline (eg from ticks_add) has passed,
+// instead of callers polling ticks_diff in a sleep_ms(1) loop.  The wait goes
+// through mp_hal_delay_ms so pending events keep being serviced and ports can
+// drop to their low-power timer.  Returns how many ms the wakeup overshot the
+// deadline; a deadline already in the past returns immediately.
+STATIC mp_obj_t time_wait_until(mp_obj_t deadline_in) {
+    // we assume that the argument comes from ticks_ms/ticks_add so is a small int
+    mp_uint_t deadline = MP_OBJ_SMALL_INT_VALUE(deadline_in);
+    mp_uint_t now = mp_hal_ticks_ms() & (MICROPY_PY_UTIME_TICKS_PERIOD - 1);
+    mp_int_t remaining = ticks_ms_diff(deadline, now);
+    if (remaining > 0) {
+        mp_hal_delay_ms(remaining);
+    }
+    now = mp_hal_ticks_ms() & (MICROPY_PY_UTIME_TICKS_PERIOD - 1);
+    mp_int_t late = ticks_ms_diff(now, deadline);
+    return MP_OBJ_NEW_SMALL_INT(late > 0 ? late : 0);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(mp_utime_wait_until_obj, time_wait_until);
+
 STATIC mp_obj_t time_ticks_ms(void) {
     return MP_OBJ_NEW_SMALL_INT(mp_hal_ticks_ms() & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
 }
@@ -198,6 +198,64 @@ STATIC mp_obj_t mp_vfs_autodetect(mp_obj_t bdev_obj) {
     mp_raise_OSError(MP_ENODEV);
 }
 
+#if MICROPY_VFS_STAT_CACHE
+
+#define STAT_CACHE(i) (MP_STATE_VM(vfs_stat_cache)[i])
+
+enum {
+    MP_VFS_STAT_CACHE_KIND_STAT,
+    MP_VFS_STAT_CACHE_KIND_STATVFS,
+};
+
+// Drop every cached result; needed when path resolution itself may change
+// (mount/umount can shadow or expose paths on other mounts).
+STATIC void mp_vfs_stat_cache_clear(void) {
+    memset(&STAT_CACHE(0), 0, sizeof(MP_STATE_VM(vfs_stat_cache)));
+}
+
+// Invalidate cached results below a mount after a write through it
+STATIC void mp_vfs_stat_cache_invalidate(mp_vfs_mount_t *vfs) {
+    if (vfs != MP_VFS_NONE && vfs != MP_VFS_ROOT) {
+        ++vfs->stat_gen;
+    }
+}
+
+// Only absolute string paths on a real mount are cached, so that entries
+// stay valid across chdir
+STATIC bool mp_vfs_stat_cache_can_cache(mp_vfs_mount_t *vfs, mp_obj_t path_in) {
+    if (vfs == MP_VFS_NONE || vfs == MP_VFS_ROOT || !mp_obj_is_str(path_in)) {
+        return false;
+    }
+    return mp_obj_str_get_str(path_in)[0] == '/';
+}
+
+STATIC mp_obj_t mp_vfs_stat_cache_lookup(mp_vfs_mount_t *vfs, mp_obj_t path_in, uint8_t kind) {
+    for (size_t i = 0; i < MICROPY_VFS_STAT_CACHE_SIZE; ++i) {
+        if (STAT_CACHE(i).path != MP_OBJ_NULL
+            && STAT_CACHE(i).vfs == vfs
+            && STAT_CACHE(i).gen == vfs->stat_gen
+            && STAT_CACHE(i).kind == kind
+            && mp_obj_equal(STAT_CACHE(i).path, path_in)) {
+            return STAT_CACHE(i).result;
+        }
+    }
+    return MP_OBJ_NULL;
+}
+
+STATIC void mp_vfs_stat_cache_insert(mp_vfs_mount_t *vfs, mp_obj_t path_in, uint8_t kind, mp_obj_t result) {
+    uint8_t i = MP_STATE_VM(vfs_stat_cache_next);
+    MP_STATE_VM(vfs_stat_cache_next) = (i + 1) % MICROPY_VFS_STAT_CACHE_SIZE;
+    STAT_CACHE(i).path = path_in;
+    STAT_CACHE(i).result = result;
+    STAT_CACHE(i).vfs = vfs;
+    STAT_CACHE(i).gen = vfs->stat_gen;
+    STAT_CACHE(i).kind = kind;
+}
+
+#undef STAT_CACHE
+
+#endif // MICROPY_VFS_STAT_CACHE
+
 mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_readonly, ARG_mkfs };
     static const mp_arg_t allowed_args[] = {
@@ -229,6 +287,9 @@ mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
     vfs->len = mnt_len;
     vfs->obj = vfs_obj;
     vfs->next = NULL;
+    #if MICROPY_VFS_STAT_CACHE
+    vfs->stat_gen = 0;
+    #endif
 
     // call the underlying object to do any mounting operation
     mp_vfs_proxy_call(vfs, MP_QSTR_mount, 2, (mp_obj_t *)&args);
@@ -257,6 +318,14 @@ mp_obj_t mp_vfs_mount(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
     }
     *vfsp = vfs;
 
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    // import path resolutions may have changed
+    MP_STATE_VM(mp_import_stat_cache) = MP_OBJ_NULL;
+    #endif
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_clear();
+    #endif
+
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mp_vfs_mount_obj, 2, mp_vfs_mount);
@@ -289,6 +358,14 @@ mp_obj_t mp_vfs_umount(mp_obj_t mnt_in) {
     // call the underlying object to do any unmounting operation
     mp_vfs_proxy_call(vfs, MP_QSTR_umount, 0, NULL);
 
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    // import path resolutions may have changed
+    MP_STATE_VM(mp_import_stat_cache) = MP_OBJ_NULL;
+    #endif
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_clear();
+    #endif
+
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_umount_obj, mp_vfs_umount);
@@ -315,6 +392,16 @@ mp_obj_t mp_vfs_open(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
     #endif
 
     mp_vfs_mount_t *vfs = lookup_path(args[ARG_file].u_obj, &args[ARG_file].u_obj);
+    #if MICROPY_VFS_STAT_CACHE
+    // any mode that can modify the filesystem invalidates cached stat results
+    const char *mode = mp_obj_str_get_str(args[ARG_mode].u_obj);
+    for (; *mode; ++mode) {
+        if (*mode == 'w' || *mode == 'a' || *mode == 'x' || *mode == 'l' || *mode == '+') {
+            mp_vfs_stat_cache_invalidate(vfs);
+            break;
+        }
+    }
+    #endif
     return mp_vfs_proxy_call(vfs, MP_QSTR_open, 2, (mp_obj_t *)&args);
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(mp_vfs_open_obj, 0, mp_vfs_open);
@@ -338,6 +425,12 @@ mp_obj_t mp_vfs_chdir(mp_obj_t path_in) {
         mp_vfs_proxy_call(vfs, MP_QSTR_chdir, 1, &path_out);
     }
     MP_STATE_VM(vfs_cur) = vfs;
+
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    // relative import paths now resolve against the new directory
+    MP_STATE_VM(mp_import_stat_cache) = MP_OBJ_NULL;
+    #endif
+
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_chdir_obj, mp_vfs_chdir);
@@ -371,6 +464,7 @@ typedef struct _mp_vfs_ilistdir_it_t {
     } cur;
     bool is_str;
     bool is_iter;
+    mp_obj_t reuse_result; // preallocated result tuple, or MP_OBJ_NULL
 } mp_vfs_ilistdir_it_t;
 
 STATIC mp_obj_t mp_vfs_ilistdir_it_iternext(mp_obj_t self_in) {
@@ -387,13 +481,23 @@ STATIC mp_obj_t mp_vfs_ilistdir_it_iternext(mp_obj_t self_in) {
         self->cur.vfs = vfs->next;
         if (vfs->len == 1) {
             // vfs is mounted at root dir, delegate to it
-            mp_obj_t root = MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
             self->is_iter = true;
-            self->cur.iter = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &root);
+            if (self->reuse_result != MP_OBJ_NULL) {
+                mp_obj_t args[2] = { MP_OBJ_NEW_QSTR(MP_QSTR__slash_), mp_const_true };
+                self->cur.iter = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 2, args);
+            } else {
+                mp_obj_t root = MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
+                self->cur.iter = mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &root);
+            }
             return mp_iternext(self->cur.iter);
         } else {
             // a mounted directory
-            mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(3, NULL));
+            mp_obj_tuple_t *t;
+            if (self->reuse_result != MP_OBJ_NULL) {
+                t = MP_OBJ_TO_PTR(self->reuse_result);
+            } else {
+                t = MP_OBJ_TO_PTR(mp_obj_new_tuple(3, NULL));
+            }
             t->items[0] = mp_obj_new_str_of_type(
                 self->is_str ? &mp_type_str : &mp_type_bytes,
                 (const byte *)vfs->str + 1, vfs->len - 1);
@@ -404,13 +508,18 @@ STATIC mp_obj_t mp_vfs_ilistdir_it_iternext(mp_obj_t self_in) {
     }
 }
 
+// With the optional second argument true the iterator reuses a single
+// result tuple, refilled on each step, so large directories can be
+// scanned without a heap allocation per entry.  As with uselect's
+// ipoll, an entry must be copied if it's needed after the next step.
 mp_obj_t mp_vfs_ilistdir(size_t n_args, const mp_obj_t *args) {
     mp_obj_t path_in;
-    if (n_args == 1) {
+    if (n_args >= 1) {
         path_in = args[0];
     } else {
         path_in = MP_OBJ_NEW_QSTR(MP_QSTR_);
     }
+    bool reuse = n_args == 2 && mp_obj_is_true(args[1]);
 
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
@@ -423,12 +532,17 @@ mp_obj_t mp_vfs_ilistdir(size_t n_args, const mp_obj_t *args) {
         iter->cur.vfs = MP_STATE_VM(vfs_mount_table);
         iter->is_str = mp_obj_get_type(path_in) == &mp_type_str;
         iter->is_iter = false;
+        iter->reuse_result = reuse ? mp_obj_new_tuple(3, NULL) : MP_OBJ_NULL;
         return MP_OBJ_FROM_PTR(iter);
     }
 
+    if (reuse) {
+        mp_obj_t call_args[2] = { path_out, mp_const_true };
+        return mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 2, call_args);
+    }
     return mp_vfs_proxy_call(vfs, MP_QSTR_ilistdir, 1, &path_out);
 }
-MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_vfs_ilistdir_obj, 0, 1, mp_vfs_ilistdir);
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_vfs_ilistdir_obj, 0, 2, mp_vfs_ilistdir);
 
 mp_obj_t mp_vfs_listdir(size_t n_args, const mp_obj_t *args) {
     mp_obj_t iter = mp_vfs_ilistdir(n_args, args);
@@ -447,6 +561,9 @@ mp_obj_t mp_vfs_mkdir(mp_obj_t path_in) {
     if (vfs == MP_VFS_ROOT || (vfs != MP_VFS_NONE && !strcmp(mp_obj_str_get_str(path_out), "/"))) {
         mp_raise_OSError(MP_EEXIST);
     }
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_invalidate(vfs);
+    #endif
     return mp_vfs_proxy_call(vfs, MP_QSTR_mkdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
@@ -454,6 +571,9 @@ MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_mkdir_obj, mp_vfs_mkdir);
 mp_obj_t mp_vfs_remove(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_invalidate(vfs);
+    #endif
     return mp_vfs_proxy_call(vfs, MP_QSTR_remove, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_remove_obj, mp_vfs_remove);
@@ -466,6 +586,9 @@ mp_obj_t mp_vfs_rename(mp_obj_t old_path_in, mp_obj_t new_path_in) {
         // can't rename across filesystems
         mp_raise_OSError(MP_EPERM);
     }
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_invalidate(old_vfs);
+    #endif
     return mp_vfs_proxy_call(old_vfs, MP_QSTR_rename, 2, args);
 }
 MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
@@ -473,6 +596,9 @@ MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_rename_obj, mp_vfs_rename);
 mp_obj_t mp_vfs_rmdir(mp_obj_t path_in) {
     mp_obj_t path_out;
     mp_vfs_mount_t *vfs = lookup_path(path_in, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    mp_vfs_stat_cache_invalidate(vfs);
+    #endif
     return mp_vfs_proxy_call(vfs, MP_QSTR_rmdir, 1, &path_out);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_rmdir_obj, mp_vfs_rmdir);
@@ -488,7 +614,22 @@ mp_obj_t mp_vfs_stat(mp_obj_t path_in) {
         }
         return MP_OBJ_FROM_PTR(t);
     }
-    return mp_vfs_proxy_call(vfs, MP_QSTR_stat, 1, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    bool can_cache = mp_vfs_stat_cache_can_cache(vfs, path_in);
+    if (can_cache) {
+        mp_obj_t ret = mp_vfs_stat_cache_lookup(vfs, path_in, MP_VFS_STAT_CACHE_KIND_STAT);
+        if (ret != MP_OBJ_NULL) {
+            return ret;
+        }
+    }
+    #endif
+    mp_obj_t ret = mp_vfs_proxy_call(vfs, MP_QSTR_stat, 1, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    if (can_cache) {
+        mp_vfs_stat_cache_insert(vfs, path_in, MP_VFS_STAT_CACHE_KIND_STAT, ret);
+    }
+    #endif
+    return ret;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_stat_obj, mp_vfs_stat);
 
@@ -521,7 +662,22 @@ mp_obj_t mp_vfs_statvfs(mp_obj_t path_in) {
         // VFS mounted at root so delegate the call to it
         path_out = MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
     }
-    return mp_vfs_proxy_call(vfs, MP_QSTR_statvfs, 1, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    bool can_cache = mp_vfs_stat_cache_can_cache(vfs, path_in);
+    if (can_cache) {
+        mp_obj_t ret = mp_vfs_stat_cache_lookup(vfs, path_in, MP_VFS_STAT_CACHE_KIND_STATVFS);
+        if (ret != MP_OBJ_NULL) {
+            return ret;
+        }
+    }
+    #endif
+    mp_obj_t ret = mp_vfs_proxy_call(vfs, MP_QSTR_statvfs, 1, &path_out);
+    #if MICROPY_VFS_STAT_CACHE
+    if (can_cache) {
+        mp_vfs_stat_cache_insert(vfs, path_in, MP_VFS_STAT_CACHE_KIND_STATVFS, ret);
+    }
+    #endif
+    return ret;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_statvfs_obj, mp_vfs_statvfs);
 
@@ -51,6 +51,7 @@
 #define MP_BLOCKDEV_IOCTL_BLOCK_COUNT   (4)
 #define MP_BLOCKDEV_IOCTL_BLOCK_SIZE    (5)
 #define MP_BLOCKDEV_IOCTL_BLOCK_ERASE   (6)
+#define MP_BLOCKDEV_IOCTL_BLOCK_TRIM    (7)
 
 // At the moment the VFS protocol just has import_stat, but could be extended to other methods
 typedef struct _mp_vfs_proto_t {
@@ -70,6 +71,10 @@ typedef struct _mp_vfs_blockdev_t {
             mp_obj_t count[2];
         } old;
     } u;
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    // lazily allocated block cache; see extmod/vfs_blockdev.c
+    struct _mp_vfs_blockdev_cache_t *cache;
+    #endif
 } mp_vfs_blockdev_t;
 
 typedef struct _mp_vfs_mount_t {
@@ -77,6 +82,9 @@ typedef struct _mp_vfs_mount_t {
     size_t len;
     mp_obj_t obj;
     struct _mp_vfs_mount_t *next;
+    #if MICROPY_VFS_STAT_CACHE
+    uint32_t stat_gen; // bumped by any write through this mount; see vfs_stat_cache
+    #endif
 } mp_vfs_mount_t;
 
 void mp_vfs_blockdev_init(mp_vfs_blockdev_t *self, mp_obj_t bdev);
@@ -85,6 +93,9 @@ int mp_vfs_blockdev_read_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t b
 int mp_vfs_blockdev_write(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, const uint8_t *buf);
 int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, const uint8_t *buf);
 mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t arg);
+#if MICROPY_VFS_BLOCKDEV_TRIM
+void mp_vfs_blockdev_trim(mp_vfs_blockdev_t *self, mp_obj_t owner, size_t block_num, size_t num_blocks);
+#endif
 
 mp_vfs_mount_t *mp_vfs_lookup_path(const char *path, const char **path_out);
 mp_import_stat_t mp_vfs_import_stat(const char *path);
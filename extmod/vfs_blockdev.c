@@ -24,6 +24,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "py/binary.h"
 #include "py/objarray.h"
@@ -44,9 +46,12 @@ void mp_vfs_blockdev_init(mp_vfs_blockdev_t *self, mp_obj_t bdev) {
         mp_load_method_maybe(bdev, MP_QSTR_sync, self->u.old.sync);
         mp_load_method(bdev, MP_QSTR_count, self->u.old.count);
     }
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    self->cache = NULL;
+    #endif
 }
 
-int mp_vfs_blockdev_read(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, uint8_t *buf) {
+STATIC int mp_vfs_blockdev_read_raw(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, uint8_t *buf) {
     if (self->flags & MP_BLOCKDEV_FLAG_NATIVE) {
         mp_uint_t (*f)(uint8_t *, uint32_t, uint32_t) = (void *)(uintptr_t)self->readblocks[2];
         return f(buf, block_num, num_blocks);
@@ -60,7 +65,162 @@ int mp_vfs_blockdev_read(mp_vfs_blockdev_t *self, size_t block_num, size_t num_b
     }
 }
 
+STATIC int mp_vfs_blockdev_write_raw(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, const uint8_t *buf) {
+    if (self->flags & MP_BLOCKDEV_FLAG_NATIVE) {
+        mp_uint_t (*f)(const uint8_t *, uint32_t, uint32_t) = (void *)(uintptr_t)self->writeblocks[2];
+        return f(buf, block_num, num_blocks);
+    } else {
+        mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, num_blocks *self->block_size, (void *)buf};
+        self->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(block_num);
+        self->writeblocks[3] = MP_OBJ_FROM_PTR(&ar);
+        mp_call_method_n_kw(2, 0, self->writeblocks);
+        // TODO handle error return
+        return 0;
+    }
+}
+
+#if MICROPY_VFS_BLOCKDEV_CACHE
+
+// A write-back cache of consecutive blocks sitting between the filesystem
+// and the block device.  A miss fills the whole window with one readblocks
+// call and sequential writes coalesce into one writeblocks call, so
+// sector-at-a-time filesystem access (eg FatFS) turns into multi-block
+// device transfers.  The buffer is a single GC-heap allocation which never
+// moves, so it can be handed to DMA-driven block devices.
+typedef struct _mp_vfs_blockdev_cache_t {
+    uint8_t *buf; // num * block_size bytes
+    size_t base; // first block held in the window
+    size_t valid; // number of valid blocks in the window, 0 if empty
+    size_t num; // window capacity in blocks
+    size_t dev_count; // total blocks on the device, 0 if unknown
+    uint8_t dirty[MICROPY_VFS_BLOCKDEV_CACHE_SIZE];
+} mp_vfs_blockdev_cache_t;
+
+STATIC mp_vfs_blockdev_cache_t *mp_vfs_blockdev_cache_get(mp_vfs_blockdev_t *self) {
+    mp_vfs_blockdev_cache_t *cache = self->cache;
+    if (cache == NULL) {
+        cache = m_new_obj(mp_vfs_blockdev_cache_t);
+        cache->buf = m_new(uint8_t, MICROPY_VFS_BLOCKDEV_CACHE_SIZE * self->block_size);
+        cache->valid = 0;
+        cache->num = MICROPY_VFS_BLOCKDEV_CACHE_SIZE;
+        // without a block count, reads past the end of the device would be
+        // needed to fill the window, so then cache only the requested block
+        mp_obj_t ret = mp_vfs_blockdev_ioctl(self, MP_BLOCKDEV_IOCTL_BLOCK_COUNT, 0);
+        cache->dev_count = (ret == mp_const_none) ? 0 : mp_obj_get_int(ret);
+        self->cache = cache;
+    }
+    return cache;
+}
+
+// Write all dirty blocks in the window back to the device, one writeblocks
+// call per contiguous dirty run.
+STATIC int mp_vfs_blockdev_cache_flush(mp_vfs_blockdev_t *self) {
+    mp_vfs_blockdev_cache_t *cache = self->cache;
+    if (cache == NULL) {
+        return 0;
+    }
+    size_t i = 0;
+    while (i < cache->valid) {
+        if (cache->dirty[i]) {
+            size_t j = i + 1;
+            while (j < cache->valid && cache->dirty[j]) {
+                ++j;
+            }
+            int ret = mp_vfs_blockdev_write_raw(self, cache->base + i, j - i, cache->buf + i * self->block_size);
+            if (ret != 0) {
+                return ret;
+            }
+            memset(&cache->dirty[i], 0, j - i);
+            i = j;
+        } else {
+            ++i;
+        }
+    }
+    return 0;
+}
+
+// Drop the window, writing back any dirty blocks first.
+STATIC int mp_vfs_blockdev_cache_drop(mp_vfs_blockdev_t *self) {
+    int ret = mp_vfs_blockdev_cache_flush(self);
+    if (self->cache != NULL) {
+        self->cache->valid = 0;
+    }
+    return ret;
+}
+
+STATIC int mp_vfs_blockdev_cache_read_block(mp_vfs_blockdev_t *self, size_t block_num, uint8_t *buf) {
+    mp_vfs_blockdev_cache_t *cache = mp_vfs_blockdev_cache_get(self);
+    if (!(block_num >= cache->base && block_num < cache->base + cache->valid)) {
+        // miss: write back any dirty blocks then refill starting at block_num
+        int ret = mp_vfs_blockdev_cache_drop(self);
+        if (ret != 0) {
+            return ret;
+        }
+        size_t n = 1;
+        if (cache->dev_count != 0 && block_num < cache->dev_count) {
+            n = MIN(cache->num, cache->dev_count - block_num);
+        }
+        ret = mp_vfs_blockdev_read_raw(self, block_num, n, cache->buf);
+        if (ret != 0) {
+            return ret;
+        }
+        cache->base = block_num;
+        cache->valid = n;
+        memset(cache->dirty, 0, n);
+    }
+    memcpy(buf, cache->buf + (block_num - cache->base) * self->block_size, self->block_size);
+    return 0;
+}
+
+STATIC int mp_vfs_blockdev_cache_write_block(mp_vfs_blockdev_t *self, size_t block_num, const uint8_t *buf) {
+    mp_vfs_blockdev_cache_t *cache = mp_vfs_blockdev_cache_get(self);
+    size_t idx;
+    if (block_num >= cache->base && block_num < cache->base + cache->valid) {
+        idx = block_num - cache->base;
+    } else if (cache->valid != 0 && block_num == cache->base + cache->valid && cache->valid < cache->num) {
+        // extend the window so sequential writes coalesce into one flush
+        idx = cache->valid++;
+    } else {
+        int ret = mp_vfs_blockdev_cache_drop(self);
+        if (ret != 0) {
+            return ret;
+        }
+        cache->base = block_num;
+        cache->valid = 1;
+        idx = 0;
+    }
+    memcpy(cache->buf + idx * self->block_size, buf, self->block_size);
+    cache->dirty[idx] = 1;
+    return 0;
+}
+
+#endif // MICROPY_VFS_BLOCKDEV_CACHE
+
+int mp_vfs_blockdev_read(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, uint8_t *buf) {
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    if (self->block_size != 0) {
+        if (num_blocks == 1) {
+            return mp_vfs_blockdev_cache_read_block(self, block_num, buf);
+        }
+        // multi-block reads go straight to the device; make sure the window
+        // doesn't hold newer data for any of the requested blocks
+        int ret = mp_vfs_blockdev_cache_drop(self);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    #endif
+    return mp_vfs_blockdev_read_raw(self, block_num, num_blocks, buf);
+}
+
 int mp_vfs_blockdev_read_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, uint8_t *buf) {
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    // the extended interface isn't cached; make sure the device is current
+    int ret0 = mp_vfs_blockdev_cache_drop(self);
+    if (ret0 != 0) {
+        return ret0;
+    }
+    #endif
     mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, len, buf};
     self->readblocks[2] = MP_OBJ_NEW_SMALL_INT(block_num);
     self->readblocks[3] = MP_OBJ_FROM_PTR(&ar);
@@ -79,17 +239,20 @@ int mp_vfs_blockdev_write(mp_vfs_blockdev_t *self, size_t block_num, size_t num_
         return -MP_EROFS;
     }
 
-    if (self->flags & MP_BLOCKDEV_FLAG_NATIVE) {
-        mp_uint_t (*f)(const uint8_t *, uint32_t, uint32_t) = (void *)(uintptr_t)self->writeblocks[2];
-        return f(buf, block_num, num_blocks);
-    } else {
-        mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, num_blocks *self->block_size, (void *)buf};
-        self->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(block_num);
-        self->writeblocks[3] = MP_OBJ_FROM_PTR(&ar);
-        mp_call_method_n_kw(2, 0, self->writeblocks);
-        // TODO handle error return
-        return 0;
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    if (self->block_size != 0) {
+        if (num_blocks == 1) {
+            return mp_vfs_blockdev_cache_write_block(self, block_num, buf);
+        }
+        // multi-block writes go straight to the device; drop the window
+        // first so stale dirty blocks can't overwrite this data later
+        int ret = mp_vfs_blockdev_cache_drop(self);
+        if (ret != 0) {
+            return ret;
+        }
     }
+    #endif
+    return mp_vfs_blockdev_write_raw(self, block_num, num_blocks, buf);
 }
 
 int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, const uint8_t *buf) {
@@ -98,6 +261,13 @@ int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t
         return -MP_EROFS;
     }
 
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    // the extended interface isn't cached; make sure the device is current
+    int ret0 = mp_vfs_blockdev_cache_drop(self);
+    if (ret0 != 0) {
+        return ret0;
+    }
+    #endif
     mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, len, (void *)buf};
     self->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(block_num);
     self->writeblocks[3] = MP_OBJ_FROM_PTR(&ar);
@@ -110,7 +280,81 @@ int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t
     }
 }
 
+#if MICROPY_VFS_BLOCKDEV_TRIM
+
+// Tell the device that a range of blocks no longer holds live data, so it
+// can pre-erase them and keep a pool of erased blocks ready for writes.
+// Devices that don't understand the op simply ignore it (return None).
+STATIC void mp_vfs_blockdev_trim_raw(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks) {
+    while (num_blocks--) {
+        mp_vfs_blockdev_ioctl(self, MP_BLOCKDEV_IOCTL_BLOCK_TRIM, block_num++);
+    }
+}
+
+#if MICROPY_ENABLE_SCHEDULER
+
+#define TRIM_QUEUE(i) (MP_STATE_VM(vfs_blockdev_trim_queue)[(i) % MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE])
+
+// Deliver the queued trim ranges, so the filesystem delete that queued
+// them returns without waiting for the device to do any erase work.
+STATIC mp_obj_t mp_vfs_blockdev_trim_run(mp_obj_t arg) {
+    (void)arg;
+    while (MP_STATE_VM(vfs_blockdev_trim_len) != 0) {
+        uint8_t head = MP_STATE_VM(vfs_blockdev_trim_head);
+        mp_vfs_blockdev_t *bdev = TRIM_QUEUE(head).bdev;
+        uint32_t block = TRIM_QUEUE(head).block;
+        uint32_t count = TRIM_QUEUE(head).count;
+        TRIM_QUEUE(head).owner = MP_OBJ_NULL;
+        MP_STATE_VM(vfs_blockdev_trim_head) = (head + 1) % MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE;
+        --MP_STATE_VM(vfs_blockdev_trim_len);
+        mp_vfs_blockdev_trim_raw(bdev, block, count);
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_blockdev_trim_run_obj, mp_vfs_blockdev_trim_run);
+
+#endif // MICROPY_ENABLE_SCHEDULER
+
+void mp_vfs_blockdev_trim(mp_vfs_blockdev_t *self, mp_obj_t owner, size_t block_num, size_t num_blocks) {
+    if (!(self->flags & MP_BLOCKDEV_FLAG_HAVE_IOCTL) || num_blocks == 0) {
+        // only the new block protocol can receive the trim op
+        return;
+    }
+    #if MICROPY_ENABLE_SCHEDULER
+    if (MP_STATE_VM(vfs_blockdev_trim_len) < MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE) {
+        uint8_t tail = MP_STATE_VM(vfs_blockdev_trim_head) + MP_STATE_VM(vfs_blockdev_trim_len);
+        TRIM_QUEUE(tail).owner = owner;
+        TRIM_QUEUE(tail).bdev = self;
+        TRIM_QUEUE(tail).block = block_num;
+        TRIM_QUEUE(tail).count = num_blocks;
+        ++MP_STATE_VM(vfs_blockdev_trim_len);
+        if (mp_sched_schedule(MP_OBJ_FROM_PTR(&mp_vfs_blockdev_trim_run_obj), mp_const_none)) {
+            return;
+        }
+        // scheduler queue is full; fall through and deliver now
+        TRIM_QUEUE(tail).owner = MP_OBJ_NULL;
+        --MP_STATE_VM(vfs_blockdev_trim_len);
+    }
+    #else
+    (void)owner;
+    #endif
+    mp_vfs_blockdev_trim_raw(self, block_num, num_blocks);
+}
+
+#undef TRIM_QUEUE
+
+#endif // MICROPY_VFS_BLOCKDEV_TRIM
+
 mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t arg) {
+    #if MICROPY_VFS_BLOCKDEV_CACHE
+    if (cmd == MP_BLOCKDEV_IOCTL_SYNC || cmd == MP_BLOCKDEV_IOCTL_DEINIT) {
+        // write back any cached data before the device syncs/shuts down
+        mp_vfs_blockdev_cache_drop(self);
+    } else if (cmd == MP_BLOCKDEV_IOCTL_INIT && self->cache != NULL) {
+        // (re)initialising the device invalidates anything cached
+        self->cache->valid = 0;
+    }
+    #endif
     if (self->flags & MP_BLOCKDEV_FLAG_HAVE_IOCTL) {
         // New protocol with ioctl
         self->u.ioctl[2] = MP_OBJ_NEW_SMALL_INT(cmd);
@@ -0,0 +1,715 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Read-only VFS backed by a "bundle": a single blob of memory (typically a
+// byte string frozen into flash) holding many small files behind a sorted
+// index.  Compared to a general-purpose filesystem this has no per-file
+// block overhead, lookup is a binary search over the index rather than a
+// directory walk, and entries can optionally be deflate-compressed.  Files
+// stored uncompressed are read directly from the bundle without copying,
+// which also allows .mpy files to be executed in place.
+//
+// Bundle images are created with tools/mpbundle.py.  The layout, all
+// little-endian and with offsets relative to the start of the bundle, is:
+//
+//     uint32  magic "MPB1"
+//     uint32  number of entries
+//     entry[] index, 16 bytes each, sorted by strcmp of the entry name
+//     names   concatenated NUL-terminated paths (no leading slash)
+//     data    file contents
+//
+// Directories are implicit: "lib" exists if some entry is named "lib/...".
+
+#include <stdio.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/objstr.h"
+#include "py/mperrno.h"
+#include "extmod/vfs.h"
+#include "extmod/vfs_bundle.h"
+
+#if MICROPY_VFS && MICROPY_VFS_BUNDLE
+
+#if MICROPY_PY_UZLIB
+// The decompressor implementation is compiled as part of extmod/moduzlib.c.
+#include "lib/uzlib/tinf.h"
+#endif
+
+#define BUNDLE_MAGIC (0x3142504d) // "MPB1"
+
+// Set in file_len when the entry data is a raw deflate stream
+#define BUNDLE_FLAG_COMPRESSED (0x80000000)
+
+typedef struct _mp_vfs_bundle_entry_t {
+    uint32_t name_off;
+    uint32_t data_off;
+    uint32_t data_len; // length of (possibly compressed) data in the bundle
+    uint32_t file_len; // uncompressed length, with BUNDLE_FLAG_COMPRESSED in the top bit
+} mp_vfs_bundle_entry_t;
+
+typedef struct _mp_obj_vfs_bundle_t {
+    mp_obj_base_t base;
+    mp_obj_t blob; // object providing the bundle data, retained so it's not reclaimed
+    const uint8_t *data;
+    size_t size;
+    size_t count;
+    const mp_vfs_bundle_entry_t *index;
+    vstr_t cur_dir;
+} mp_obj_vfs_bundle_t;
+
+typedef struct _mp_obj_vfs_bundle_file_t {
+    mp_obj_base_t base;
+    mp_obj_t vfs; // retains the bundle while the file is open
+    const uint8_t *data; // NULL when closed
+    size_t size;
+    size_t pos;
+    bool mapped; // data points into the bundle itself, not a heap buffer
+} mp_obj_vfs_bundle_file_t;
+
+STATIC const char *mp_vfs_bundle_entry_name(mp_obj_vfs_bundle_t *self, size_t i) {
+    return (const char *)&self->data[self->index[i].name_off];
+}
+
+// Strip the leading slashes that make_path produces; bundle entry names are
+// stored without them so that the root directory is simply the empty string.
+STATIC const char *mp_vfs_bundle_strip_path(const char *path) {
+    while (*path == '/') {
+        ++path;
+    }
+    return path;
+}
+
+STATIC const char *mp_vfs_bundle_make_path(mp_obj_vfs_bundle_t *self, mp_obj_t path_in) {
+    const char *path = mp_obj_str_get_str(path_in);
+    if (path[0] != '/') {
+        size_t l = vstr_len(&self->cur_dir);
+        if (l > 0) {
+            vstr_add_str(&self->cur_dir, path);
+            path = vstr_null_terminated_str(&self->cur_dir);
+            self->cur_dir.len = l;
+        }
+    }
+    return path;
+}
+
+// Find the first index entry whose name is >= the directory prefix "path/"
+// (all entries within that directory then follow contiguously).
+STATIC size_t mp_vfs_bundle_dir_lower_bound(mp_obj_vfs_bundle_t *self, const char *path, size_t len) {
+    size_t lo = 0;
+    size_t hi = self->count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        const char *name = mp_vfs_bundle_entry_name(self, mid);
+        int cmp = strncmp(name, path, len);
+        if (cmp == 0) {
+            cmp = (uint8_t)name[len] - (uint8_t)'/';
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+STATIC bool mp_vfs_bundle_is_dir(mp_obj_vfs_bundle_t *self, const char *path, size_t len) {
+    if (len == 0) {
+        return true; // the root always exists
+    }
+    size_t i = mp_vfs_bundle_dir_lower_bound(self, path, len);
+    if (i < self->count) {
+        const char *name = mp_vfs_bundle_entry_name(self, i);
+        return strncmp(name, path, len) == 0 && name[len] == '/';
+    }
+    return false;
+}
+
+// Look up path (relative to the bundle root, no leading slash).  Returns
+// MP_IMPORT_STAT_FILE with *entry_out set, MP_IMPORT_STAT_DIR for an implied
+// directory, or MP_IMPORT_STAT_NO_EXIST.
+STATIC mp_import_stat_t mp_vfs_bundle_search(mp_obj_vfs_bundle_t *self, const char *path, const mp_vfs_bundle_entry_t **entry_out) {
+    size_t lo = 0;
+    size_t hi = self->count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        int cmp = strcmp(mp_vfs_bundle_entry_name(self, mid), path);
+        if (cmp == 0) {
+            if (entry_out != NULL) {
+                *entry_out = &self->index[mid];
+            }
+            return MP_IMPORT_STAT_FILE;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (mp_vfs_bundle_is_dir(self, path, strlen(path))) {
+        return MP_IMPORT_STAT_DIR;
+    }
+    return MP_IMPORT_STAT_NO_EXIST;
+}
+
+STATIC mp_obj_t mp_vfs_bundle_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+    const uint8_t *data = bufinfo.buf;
+    if (bufinfo.len < 8
+        || ((uintptr_t)data & 3) != 0
+        || ((uint32_t *)data)[0] != BUNDLE_MAGIC) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+    size_t count = ((uint32_t *)data)[1];
+    if (8 + count * sizeof(mp_vfs_bundle_entry_t) > bufinfo.len) {
+        mp_raise_OSError(MP_ENODEV);
+    }
+
+    mp_obj_vfs_bundle_t *self = m_new_obj(mp_obj_vfs_bundle_t);
+    self->base.type = type;
+    self->blob = args[0];
+    self->data = data;
+    self->size = bufinfo.len;
+    self->count = count;
+    self->index = (const mp_vfs_bundle_entry_t *)(data + 8);
+    vstr_init(&self->cur_dir, 16);
+    vstr_add_byte(&self->cur_dir, '/');
+    return MP_OBJ_FROM_PTR(self);
+}
+
+STATIC mp_obj_t mp_vfs_bundle_file_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode_in) {
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(self_in);
+
+    const mp_obj_type_t *type = &mp_type_vfs_bundle_textio;
+    const char *mode_str = mp_obj_str_get_str(mode_in);
+    for (; *mode_str; ++mode_str) {
+        switch (*mode_str) {
+            case 'r':
+                break;
+            case 'w':
+            case 'x':
+            case 'a':
+            case '+':
+                mp_raise_OSError(MP_EROFS);
+                break;
+            #if MICROPY_PY_IO_FILEIO
+            case 'b':
+                type = &mp_type_vfs_bundle_fileio;
+                break;
+            #endif
+            case 't':
+                type = &mp_type_vfs_bundle_textio;
+                break;
+        }
+    }
+
+    const char *path = mp_vfs_bundle_strip_path(mp_vfs_bundle_make_path(self, path_in));
+    const mp_vfs_bundle_entry_t *entry;
+    mp_import_stat_t stat = mp_vfs_bundle_search(self, path, &entry);
+    if (stat == MP_IMPORT_STAT_NO_EXIST) {
+        mp_raise_OSError(MP_ENOENT);
+    }
+    if (stat == MP_IMPORT_STAT_DIR) {
+        mp_raise_OSError(MP_EISDIR);
+    }
+
+    mp_obj_vfs_bundle_file_t *o = m_new_obj(mp_obj_vfs_bundle_file_t);
+    o->base.type = type;
+    o->vfs = self_in;
+    o->size = entry->file_len & ~BUNDLE_FLAG_COMPRESSED;
+    o->pos = 0;
+
+    if (entry->file_len & BUNDLE_FLAG_COMPRESSED) {
+        #if MICROPY_PY_UZLIB
+        // Inflate the whole entry up front; with the full output buffer
+        // available no dictionary is needed (matches reference the dest
+        // buffer directly).
+        byte *buf = m_new(byte, o->size);
+        TINF_DATA *decomp = m_new_obj(TINF_DATA);
+        memset(decomp, 0, sizeof(*decomp));
+        uzlib_uncompress_init(decomp, NULL, 0);
+        decomp->source = &self->data[entry->data_off];
+        decomp->source_limit = decomp->source + entry->data_len;
+        decomp->dest = buf;
+        decomp->dest_limit = buf + o->size;
+        int st;
+        do {
+            st = uzlib_uncompress(decomp);
+        } while (st == TINF_OK && decomp->dest < decomp->dest_limit);
+        bool ok = (st == TINF_DONE || st == TINF_OK) && decomp->dest == buf + o->size;
+        m_del_obj(TINF_DATA, decomp);
+        if (!ok) {
+            mp_raise_OSError(MP_EIO);
+        }
+        o->data = buf;
+        o->mapped = false;
+        #else
+        mp_raise_OSError(MP_EOPNOTSUPP);
+        #endif
+    } else {
+        o->data = &self->data[entry->data_off];
+        o->mapped = true;
+    }
+
+    return MP_OBJ_FROM_PTR(o);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(mp_vfs_bundle_open_obj, mp_vfs_bundle_file_open);
+
+typedef struct _mp_vfs_bundle_ilistdir_it_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    bool is_str;
+    mp_obj_vfs_bundle_t *vfs;
+    size_t index;
+    vstr_t prefix; // directory prefix including trailing slash (empty for root)
+    mp_obj_t reuse_result; // preallocated result tuple, or MP_OBJ_NULL
+} mp_vfs_bundle_ilistdir_it_t;
+
+STATIC mp_obj_t mp_vfs_bundle_ilistdir_it_iternext(mp_obj_t self_in) {
+    mp_vfs_bundle_ilistdir_it_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_vfs_bundle_t *vfs = self->vfs;
+    size_t prefix_len = vstr_len(&self->prefix);
+
+    if (self->index >= vfs->count) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    const char *name = mp_vfs_bundle_entry_name(vfs, self->index);
+    if (strncmp(name, vstr_str(&self->prefix), prefix_len) != 0) {
+        // Sorted index: once the prefix no longer matches the directory is done
+        return MP_OBJ_STOP_ITERATION;
+    }
+
+    const char *rel = name + prefix_len;
+    const char *slash = strchr(rel, '/');
+    size_t rel_len;
+    uint32_t mode;
+    uint32_t size;
+    if (slash == NULL) {
+        // A file directly in this directory
+        const mp_vfs_bundle_entry_t *entry = &vfs->index[self->index];
+        rel_len = strlen(rel);
+        mode = MP_S_IFREG;
+        size = entry->file_len & ~BUNDLE_FLAG_COMPRESSED;
+        ++self->index;
+    } else {
+        // A sub-directory; skip all entries below it so it's reported once
+        rel_len = slash - rel;
+        mode = MP_S_IFDIR;
+        size = 0;
+        size_t skip_len = prefix_len + rel_len + 1;
+        do {
+            ++self->index;
+        } while (self->index < vfs->count
+                 && strncmp(mp_vfs_bundle_entry_name(vfs, self->index), name, skip_len) == 0);
+    }
+
+    mp_obj_tuple_t *t;
+    if (self->reuse_result != MP_OBJ_NULL) {
+        t = MP_OBJ_TO_PTR(self->reuse_result);
+    } else {
+        t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+    }
+    if (self->is_str) {
+        t->items[0] = mp_obj_new_str(rel, rel_len);
+    } else {
+        t->items[0] = mp_obj_new_bytes((const byte *)rel, rel_len);
+    }
+    t->items[1] = MP_OBJ_NEW_SMALL_INT(mode);
+    t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // no inode number
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(size);
+
+    return MP_OBJ_FROM_PTR(t);
+}
+
+STATIC mp_obj_t mp_vfs_bundle_ilistdir_func(size_t n_args, const mp_obj_t *args) {
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(args[0]);
+    bool is_str_type = true;
+    const char *path;
+    if (n_args == 2) {
+        if (mp_obj_get_type(args[1]) == &mp_type_bytes) {
+            is_str_type = false;
+        }
+        path = mp_vfs_bundle_make_path(self, args[1]);
+    } else {
+        path = vstr_null_terminated_str(&self->cur_dir);
+    }
+    path = mp_vfs_bundle_strip_path(path);
+    size_t path_len = strlen(path);
+    while (path_len > 0 && path[path_len - 1] == '/') {
+        --path_len;
+    }
+
+    if (path_len != 0 && !mp_vfs_bundle_is_dir(self, path, path_len)) {
+        if (mp_vfs_bundle_search(self, path, NULL) == MP_IMPORT_STAT_FILE) {
+            mp_raise_OSError(MP_ENOTDIR);
+        }
+        mp_raise_OSError(MP_ENOENT);
+    }
+
+    mp_vfs_bundle_ilistdir_it_t *iter = m_new_obj(mp_vfs_bundle_ilistdir_it_t);
+    iter->base.type = &mp_type_polymorph_iter;
+    iter->iternext = mp_vfs_bundle_ilistdir_it_iternext;
+    iter->is_str = is_str_type;
+    iter->vfs = self;
+    if (n_args == 3 && mp_obj_is_true(args[2])) {
+        // refill a single result tuple on each iteration step
+        iter->reuse_result = mp_obj_new_tuple(4, NULL);
+    } else {
+        iter->reuse_result = MP_OBJ_NULL;
+    }
+    // Take a copy of the prefix since cur_dir may change while iterating
+    vstr_init(&iter->prefix, path_len + 2);
+    vstr_add_strn(&iter->prefix, path, path_len);
+    if (path_len != 0) {
+        vstr_add_byte(&iter->prefix, '/');
+    }
+    iter->index = mp_vfs_bundle_dir_lower_bound(self, path, path_len);
+    return MP_OBJ_FROM_PTR(iter);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_vfs_bundle_ilistdir_obj, 1, 3, mp_vfs_bundle_ilistdir_func);
+
+STATIC mp_obj_t mp_vfs_bundle_chdir(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(self_in);
+
+    // Keep the old path so it can be restored if the new one doesn't exist
+    // (unlike a real filesystem there's nothing here to resolve "." and ".."
+    // against, so the check has to happen after normalisation below).
+    vstr_t old_dir;
+    vstr_init(&old_dir, vstr_len(&self->cur_dir));
+    vstr_add_strn(&old_dir, vstr_str(&self->cur_dir), vstr_len(&self->cur_dir));
+
+    // Update cur_dir with new path
+    const char *path = mp_vfs_bundle_make_path(self, path_in);
+    if (path == vstr_str(&self->cur_dir)) {
+        self->cur_dir.len = strlen(path);
+    } else {
+        vstr_reset(&self->cur_dir);
+        vstr_add_str(&self->cur_dir, path);
+    }
+
+    // If not at root add trailing / to make it easy to build paths
+    // and then normalise the path
+    if (vstr_len(&self->cur_dir) != 1) {
+        vstr_add_byte(&self->cur_dir, '/');
+
+        #define CWD_LEN (vstr_len(&self->cur_dir))
+        size_t to = 1;
+        size_t from = 1;
+        char *cwd = vstr_str(&self->cur_dir);
+        while (from < CWD_LEN) {
+            for (; cwd[from] == '/' && from < CWD_LEN; ++from) {
+                // Scan for the start
+            }
+            if (from > to) {
+                // Found excessive slash chars, squeeze them out
+                vstr_cut_out_bytes(&self->cur_dir, to, from - to);
+                from = to;
+            }
+            for (; cwd[from] != '/' && from < CWD_LEN; ++from) {
+                // Scan for the next /
+            }
+            if ((from - to) == 1 && cwd[to] == '.') {
+                // './', ignore
+                vstr_cut_out_bytes(&self->cur_dir, to, ++from - to);
+                from = to;
+            } else if ((from - to) == 2 && cwd[to] == '.' && cwd[to + 1] == '.') {
+                // '../', skip back
+                if (to > 1) {
+                    // Only skip back if not at the tip
+                    for (--to; to > 1 && cwd[to - 1] != '/'; --to) {
+                        // Skip back
+                    }
+                }
+                vstr_cut_out_bytes(&self->cur_dir, to, ++from - to);
+                from = to;
+            } else {
+                // Normal element, keep it and just move the offset
+                to = ++from;
+            }
+        }
+        #undef CWD_LEN
+    }
+
+    // Check the normalised path exists
+    const char *p = mp_vfs_bundle_strip_path(vstr_null_terminated_str(&self->cur_dir));
+    size_t l = strlen(p);
+    while (l > 0 && p[l - 1] == '/') {
+        --l;
+    }
+    if (!mp_vfs_bundle_is_dir(self, p, l)) {
+        vstr_reset(&self->cur_dir);
+        vstr_add_strn(&self->cur_dir, vstr_str(&old_dir), vstr_len(&old_dir));
+        vstr_clear(&old_dir);
+        mp_raise_OSError(MP_ENOENT);
+    }
+
+    vstr_clear(&old_dir);
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_bundle_chdir_obj, mp_vfs_bundle_chdir);
+
+STATIC mp_obj_t mp_vfs_bundle_getcwd(mp_obj_t self_in) {
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(self_in);
+    if (vstr_len(&self->cur_dir) == 1) {
+        return MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
+    } else {
+        // don't include trailing /
+        return mp_obj_new_str(self->cur_dir.buf, self->cur_dir.len - 1);
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_bundle_getcwd_obj, mp_vfs_bundle_getcwd);
+
+STATIC mp_obj_t mp_vfs_bundle_stat(mp_obj_t self_in, mp_obj_t path_in) {
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(self_in);
+    const char *path = mp_vfs_bundle_strip_path(mp_vfs_bundle_make_path(self, path_in));
+    const mp_vfs_bundle_entry_t *entry = NULL;
+    mp_import_stat_t stat = mp_vfs_bundle_search(self, path, &entry);
+    if (stat == MP_IMPORT_STAT_NO_EXIST) {
+        mp_raise_OSError(MP_ENOENT);
+    }
+
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(stat == MP_IMPORT_STAT_FILE ? MP_S_IFREG : MP_S_IFDIR); // st_mode
+    t->items[1] = MP_OBJ_NEW_SMALL_INT(0); // st_ino
+    t->items[2] = MP_OBJ_NEW_SMALL_INT(0); // st_dev
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(0); // st_nlink
+    t->items[4] = MP_OBJ_NEW_SMALL_INT(0); // st_uid
+    t->items[5] = MP_OBJ_NEW_SMALL_INT(0); // st_gid
+    t->items[6] = mp_obj_new_int_from_uint(entry == NULL ? 0 : (entry->file_len & ~BUNDLE_FLAG_COMPRESSED)); // st_size
+    t->items[7] = MP_OBJ_NEW_SMALL_INT(0); // st_atime
+    t->items[8] = MP_OBJ_NEW_SMALL_INT(0); // st_mtime
+    t->items[9] = MP_OBJ_NEW_SMALL_INT(0); // st_ctime
+
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_bundle_stat_obj, mp_vfs_bundle_stat);
+
+STATIC mp_obj_t mp_vfs_bundle_statvfs(mp_obj_t self_in, mp_obj_t path_in) {
+    (void)path_in;
+    mp_obj_vfs_bundle_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(10, NULL));
+    t->items[0] = MP_OBJ_NEW_SMALL_INT(1); // f_bsize
+    t->items[1] = t->items[0]; // f_frsize
+    t->items[2] = mp_obj_new_int_from_uint(self->size); // f_blocks
+    t->items[3] = MP_OBJ_NEW_SMALL_INT(0); // f_bfree
+    t->items[4] = MP_OBJ_NEW_SMALL_INT(0); // f_bavail
+    t->items[5] = mp_obj_new_int_from_uint(self->count); // f_files
+    t->items[6] = MP_OBJ_NEW_SMALL_INT(0); // f_ffree
+    t->items[7] = MP_OBJ_NEW_SMALL_INT(0); // f_favail
+    t->items[8] = MP_OBJ_NEW_SMALL_INT(0); // f_flags
+    t->items[9] = MP_OBJ_NEW_SMALL_INT(255); // f_namemax
+
+    return MP_OBJ_FROM_PTR(t);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_vfs_bundle_statvfs_obj, mp_vfs_bundle_statvfs);
+
+STATIC mp_obj_t mp_vfs_bundle_mount(mp_obj_t self_in, mp_obj_t readonly, mp_obj_t mkfs) {
+    (void)self_in;
+    (void)readonly; // always read-only
+    (void)mkfs;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_3(mp_vfs_bundle_mount_obj, mp_vfs_bundle_mount);
+
+STATIC mp_obj_t mp_vfs_bundle_umount(mp_obj_t self_in) {
+    (void)self_in;
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_vfs_bundle_umount_obj, mp_vfs_bundle_umount);
+
+STATIC const mp_rom_map_elem_t mp_vfs_bundle_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_open), MP_ROM_PTR(&mp_vfs_bundle_open_obj) },
+    { MP_ROM_QSTR(MP_QSTR_ilistdir), MP_ROM_PTR(&mp_vfs_bundle_ilistdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_chdir), MP_ROM_PTR(&mp_vfs_bundle_chdir_obj) },
+    { MP_ROM_QSTR(MP_QSTR_getcwd), MP_ROM_PTR(&mp_vfs_bundle_getcwd_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stat), MP_ROM_PTR(&mp_vfs_bundle_stat_obj) },
+    { MP_ROM_QSTR(MP_QSTR_statvfs), MP_ROM_PTR(&mp_vfs_bundle_statvfs_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mount), MP_ROM_PTR(&mp_vfs_bundle_mount_obj) },
+    { MP_ROM_QSTR(MP_QSTR_umount), MP_ROM_PTR(&mp_vfs_bundle_umount_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(mp_vfs_bundle_locals_dict, mp_vfs_bundle_locals_dict_table);
+
+STATIC mp_import_stat_t mp_vfs_bundle_import_stat(void *self_in, const char *path) {
+    mp_obj_vfs_bundle_t *self = self_in;
+    mp_obj_str_t path_obj = { { &mp_type_str }, 0, 0, (const byte *)path };
+    path = mp_vfs_bundle_strip_path(mp_vfs_bundle_make_path(self, MP_OBJ_FROM_PTR(&path_obj)));
+    return mp_vfs_bundle_search(self, path, NULL);
+}
+
+STATIC const mp_vfs_proto_t mp_vfs_bundle_proto = {
+    .import_stat = mp_vfs_bundle_import_stat,
+};
+
+const mp_obj_type_t mp_type_vfs_bundle = {
+    { &mp_type_type },
+    .name = MP_QSTR_VfsBundle,
+    .make_new = mp_vfs_bundle_make_new,
+    .protocol = &mp_vfs_bundle_proto,
+    .locals_dict = (mp_obj_dict_t *)&mp_vfs_bundle_locals_dict,
+};
+
+// File object
+
+STATIC void mp_vfs_bundle_file_check_open(mp_obj_vfs_bundle_file_t *self) {
+    if (self->data == NULL) {
+        mp_raise_ValueError(NULL);
+    }
+}
+
+STATIC void mp_vfs_bundle_file_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    (void)self_in;
+    (void)kind;
+    mp_printf(print, "<io.%s>", mp_obj_get_type_str(self_in));
+}
+
+STATIC mp_obj_t mp_vfs_bundle_file___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    return mp_stream_close(args[0]);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_vfs_bundle_file___exit___obj, 4, 4, mp_vfs_bundle_file___exit__);
+
+STATIC mp_uint_t mp_vfs_bundle_file_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    (void)errcode;
+    mp_obj_vfs_bundle_file_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_vfs_bundle_file_check_open(self);
+    mp_uint_t remain = self->size - self->pos;
+    if (size > remain) {
+        size = remain;
+    }
+    memcpy(buf, self->data + self->pos, size);
+    self->pos += size;
+    return size;
+}
+
+STATIC mp_uint_t mp_vfs_bundle_file_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    (void)self_in;
+    (void)buf;
+    (void)size;
+    *errcode = MP_EROFS;
+    return MP_STREAM_ERROR;
+}
+
+STATIC mp_uint_t mp_vfs_bundle_file_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_vfs_bundle_file_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if (request != MP_STREAM_CLOSE) {
+        mp_vfs_bundle_file_check_open(self);
+    }
+
+    if (request == MP_STREAM_SEEK) {
+        struct mp_stream_seek_t *s = (struct mp_stream_seek_t *)(uintptr_t)arg;
+        mp_off_t off = s->offset;
+        if (s->whence == MP_SEEK_CUR) {
+            off += self->pos;
+        } else if (s->whence == MP_SEEK_END) {
+            off += self->size;
+        }
+        if ((mp_off_t)off < 0 || (size_t)off > self->size) {
+            *errcode = MP_EINVAL;
+            return MP_STREAM_ERROR;
+        }
+        self->pos = off;
+        s->offset = off;
+        return 0;
+    } else if (request == MP_STREAM_FLUSH) {
+        return 0;
+    } else if (request == MP_STREAM_CLOSE) {
+        self->data = NULL;
+        self->vfs = MP_OBJ_NULL;
+        return 0;
+    } else if (request == MP_STREAM_GET_BUFFER && self->mapped) {
+        // Only entries stored uncompressed can expose the underlying bundle
+        // memory; it stays valid for as long as the bundle is mounted.
+        struct mp_stream_buffer_t *b = (struct mp_stream_buffer_t *)(uintptr_t)arg;
+        b->buf = self->data;
+        b->len = self->size;
+        return 0;
+    } else {
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+}
+
+STATIC const mp_rom_map_elem_t mp_vfs_bundle_file_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&mp_stream_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seek), MP_ROM_PTR(&mp_stream_seek_obj) },
+    { MP_ROM_QSTR(MP_QSTR_tell), MP_ROM_PTR(&mp_stream_tell_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&mp_identity_obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&mp_vfs_bundle_file___exit___obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(mp_vfs_bundle_file_locals_dict, mp_vfs_bundle_file_locals_dict_table);
+
+#if MICROPY_PY_IO_FILEIO
+STATIC const mp_stream_p_t mp_vfs_bundle_fileio_stream_p = {
+    .read = mp_vfs_bundle_file_read,
+    .write = mp_vfs_bundle_file_write,
+    .ioctl = mp_vfs_bundle_file_ioctl,
+    .can_get_buffer = true,
+};
+
+const mp_obj_type_t mp_type_vfs_bundle_fileio = {
+    { &mp_type_type },
+    .name = MP_QSTR_FileIO,
+    .print = mp_vfs_bundle_file_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .protocol = &mp_vfs_bundle_fileio_stream_p,
+    .locals_dict = (mp_obj_dict_t *)&mp_vfs_bundle_file_locals_dict,
+};
+#endif
+
+STATIC const mp_stream_p_t mp_vfs_bundle_textio_stream_p = {
+    .read = mp_vfs_bundle_file_read,
+    .write = mp_vfs_bundle_file_write,
+    .ioctl = mp_vfs_bundle_file_ioctl,
+    .is_text = true,
+    .can_get_buffer = true,
+};
+
+const mp_obj_type_t mp_type_vfs_bundle_textio = {
+    { &mp_type_type },
+    .name = MP_QSTR_TextIOWrapper,
+    .print = mp_vfs_bundle_file_print,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .protocol = &mp_vfs_bundle_textio_stream_p,
+    .locals_dict = (mp_obj_dict_t *)&mp_vfs_bundle_file_locals_dict,
+};
+
+#endif // MICROPY_VFS && MICROPY_VFS_BUNDLE
@@ -121,6 +121,7 @@ typedef struct _mp_vfs_fat_ilistdir_it_t {
     mp_fun_1_t iternext;
     bool is_str;
     FF_DIR dir;
+    mp_obj_t reuse_result; // preallocated result tuple, or MP_OBJ_NULL
 } mp_vfs_fat_ilistdir_it_t;
 
 STATIC mp_obj_t mp_vfs_fat_ilistdir_it_iternext(mp_obj_t self_in) {
@@ -138,7 +139,12 @@ STATIC mp_obj_t mp_vfs_fat_ilistdir_it_iternext(mp_obj_t self_in) {
         // Note that FatFS already filters . and .., so we don't need to
 
         // make 4-tuple with info about this entry
-        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+        mp_obj_tuple_t *t;
+        if (self->reuse_result != MP_OBJ_NULL) {
+            t = MP_OBJ_TO_PTR(self->reuse_result);
+        } else {
+            t = MP_OBJ_TO_PTR(mp_obj_new_tuple(4, NULL));
+        }
         if (self->is_str) {
             t->items[0] = mp_obj_new_str(fn, strlen(fn));
         } else {
@@ -181,6 +187,12 @@ STATIC mp_obj_t fat_vfs_ilistdir_func(size_t n_args, const mp_obj_t *args) {
     iter->base.type = &mp_type_polymorph_iter;
     iter->iternext = mp_vfs_fat_ilistdir_it_iternext;
     iter->is_str = is_str_type;
+    if (n_args == 3 && mp_obj_is_true(args[2])) {
+        // refill a single result tuple on each iteration step
+        iter->reuse_result = mp_obj_new_tuple(4, NULL);
+    } else {
+        iter->reuse_result = MP_OBJ_NULL;
+    }
     FRESULT res = f_opendir(&self->fatfs, &iter->dir, path);
     if (res != FR_OK) {
         mp_raise_OSError(fresult_to_errno_table[res]);
@@ -188,7 +200,7 @@ STATIC mp_obj_t fat_vfs_ilistdir_func(size_t n_args, const mp_obj_t *args) {
 
     return MP_OBJ_FROM_PTR(iter);
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fat_vfs_ilistdir_obj, 1, 2, fat_vfs_ilistdir_func);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(fat_vfs_ilistdir_obj, 1, 3, fat_vfs_ilistdir_func);
 
 STATIC mp_obj_t fat_vfs_remove_internal(mp_obj_t vfs_in, mp_obj_t path_in, mp_int_t attr) {
     mp_obj_fat_vfs_t *self = MP_OBJ_TO_PTR(vfs_in);
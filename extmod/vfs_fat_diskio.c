@@ -147,6 +147,15 @@ DRESULT disk_ioctl(
             *((DWORD *)buff) = 1; // erase block size in units of sector size
             return RES_OK;
 
+        #if FF_USE_TRIM && MICROPY_VFS_BLOCKDEV_TRIM
+        case CTRL_TRIM: {
+            // Propagate freed sectors to the block device so it can pre-erase them.
+            DWORD *rng = (DWORD *)buff; // first and last sector of the freed area
+            mp_vfs_blockdev_trim(&vfs->blockdev, MP_OBJ_FROM_PTR(vfs), rng[0], rng[1] - rng[0] + 1);
+            return RES_OK;
+        }
+        #endif
+
         case IOCTL_INIT:
         case IOCTL_STATUS: {
             DSTATUS stat;
@@ -32,14 +32,16 @@
 
 #if MICROPY_VFS && (MICROPY_VFS_LFS1 || MICROPY_VFS_LFS2)
 
-enum { LFS_MAKE_ARG_bdev, LFS_MAKE_ARG_readsize, LFS_MAKE_ARG_progsize, LFS_MAKE_ARG_lookahead, LFS_MAKE_ARG_mtime };
+enum { LFS_MAKE_ARG_bdev, LFS_MAKE_ARG_readsize, LFS_MAKE_ARG_progsize, LFS_MAKE_ARG_lookahead, LFS_MAKE_ARG_cachesize, LFS_MAKE_ARG_mtime, LFS_MAKE_ARG_autosync };
 
 static const mp_arg_t lfs_make_allowed_args[] = {
     { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
     { MP_QSTR_readsize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 32} },
     { MP_QSTR_progsize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 32} },
     { MP_QSTR_lookahead, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 32} },
+    { MP_QSTR_cachesize, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} }, // 0 means 4*max(readsize, progsize); unused by lfs1
     { MP_QSTR_mtime, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+    { MP_QSTR_autosync, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} }, // bytes between group commits for 'l' mode files; 0 means explicit sync only; unused by lfs1
 };
 
 #if MICROPY_VFS_LFS1
@@ -108,6 +110,7 @@ typedef struct _mp_obj_vfs_lfs2_t {
     mp_obj_base_t base;
     mp_vfs_blockdev_t blockdev;
     bool enable_mtime;
+    uint32_t autosync; // bytes appended between group commits in log mode; 0 for explicit sync only
     vstr_t cur_dir;
     struct lfs2_config config;
     lfs2_t lfs;
@@ -117,6 +120,8 @@ typedef struct _mp_obj_vfs_lfs2_file_t {
     mp_obj_base_t base;
     mp_obj_vfs_lfs2_t *vfs;
     uint8_t mtime[8];
+    bool log_mode; // opened with 'l': append records, commit metadata in groups
+    uint32_t unsynced; // bytes appended since the last metadata commit
     lfs2_file_t file;
     struct lfs2_file_config cfg;
     struct lfs2_attr attrs[1];
@@ -48,6 +48,9 @@ mp_obj_t MP_VFS_LFSx(file_open)(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mod
     MP_OBJ_VFS_LFSx *self = MP_OBJ_TO_PTR(self_in);
 
     int flags = 0;
+    #if LFS_BUILD_VERSION == 2
+    bool log_mode = false;
+    #endif
     const mp_obj_type_t *type = &MP_TYPE_VFS_LFSx_(_textio);
     const char *mode_str = mp_obj_str_get_str(mode_in);
     for (; *mode_str; ++mode_str) {
@@ -65,6 +68,16 @@ mp_obj_t MP_VFS_LFSx(file_open)(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mod
             case 'a':
                 new_flags = LFSx_MACRO(_O_WRONLY) | LFSx_MACRO(_O_CREAT) | LFSx_MACRO(_O_APPEND);
                 break;
+            #if LFS_BUILD_VERSION == 2
+            case 'l':
+                // Logging append mode: as for 'a' but metadata is only committed when
+                // the "autosync" byte threshold is reached, or on an explicit flush()
+                // or close().  This batches metadata updates across many appended
+                // records, reducing flash wear and per-record latency.
+                new_flags = LFSx_MACRO(_O_WRONLY) | LFSx_MACRO(_O_CREAT) | LFSx_MACRO(_O_APPEND);
+                log_mode = true;
+                break;
+            #endif
             case '+':
                 flags |= LFSx_MACRO(_O_RDWR);
                 break;
@@ -102,6 +115,8 @@ mp_obj_t MP_VFS_LFSx(file_open)(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mod
     o->cfg.buffer = &o->file_buffer[0];
 
     #if LFS_BUILD_VERSION == 2
+    o->log_mode = log_mode;
+    o->unsynced = 0;
     if (self->enable_mtime) {
         lfs_get_mtime(&o->mtime[0]);
         o->attrs[0].type = LFS_ATTR_MTIME;
@@ -152,6 +167,19 @@ STATIC mp_uint_t MP_VFS_LFSx(file_write)(mp_obj_t self_in, const void *buf, mp_u
         *errcode = -sz;
         return MP_STREAM_ERROR;
     }
+    #if LFS_BUILD_VERSION == 2
+    if (self->log_mode) {
+        self->unsynced += sz;
+        if (self->vfs->autosync != 0 && self->unsynced >= self->vfs->autosync) {
+            int res = LFSx_API(file_sync)(&self->vfs->lfs, &self->file);
+            if (res < 0) {
+                *errcode = -res;
+                return MP_STREAM_ERROR;
+            }
+            self->unsynced = 0;
+        }
+    }
+    #endif
     return sz;
 }
 
@@ -182,6 +210,9 @@ STATIC mp_uint_t MP_VFS_LFSx(file_ioctl)(mp_obj_t self_in, mp_uint_t request, ui
             *errcode = -res;
             return MP_STREAM_ERROR;
         }
+        #if LFS_BUILD_VERSION == 2
+        self->unsynced = 0;
+        #endif
         return 0;
     } else if (request == MP_STREAM_CLOSE) {
         if (self->vfs == NULL) {
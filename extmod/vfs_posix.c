@@ -162,6 +162,7 @@ typedef struct _vfs_posix_ilistdir_it_t {
     mp_fun_1_t iternext;
     bool is_str;
     DIR *dir;
+    mp_obj_t reuse_result; // preallocated result tuple, or MP_OBJ_NULL
 } vfs_posix_ilistdir_it_t;
 
 STATIC mp_obj_t vfs_posix_ilistdir_it_iternext(mp_obj_t self_in) {
@@ -189,7 +190,12 @@ STATIC mp_obj_t vfs_posix_ilistdir_it_iternext(mp_obj_t self_in) {
         }
 
         // make 3-tuple with info about this entry
-        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(3, NULL));
+        mp_obj_tuple_t *t;
+        if (self->reuse_result != MP_OBJ_NULL) {
+            t = MP_OBJ_TO_PTR(self->reuse_result);
+        } else {
+            t = MP_OBJ_TO_PTR(mp_obj_new_tuple(3, NULL));
+        }
 
         if (self->is_str) {
             t->items[0] = mp_obj_new_str(fn, strlen(fn));
@@ -224,12 +230,19 @@ STATIC mp_obj_t vfs_posix_ilistdir_it_iternext(mp_obj_t self_in) {
     }
 }
 
-STATIC mp_obj_t vfs_posix_ilistdir(mp_obj_t self_in, mp_obj_t path_in) {
-    mp_obj_vfs_posix_t *self = MP_OBJ_TO_PTR(self_in);
+STATIC mp_obj_t vfs_posix_ilistdir(size_t n_args, const mp_obj_t *args) {
+    mp_obj_vfs_posix_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_obj_t path_in = args[1];
     vfs_posix_ilistdir_it_t *iter = m_new_obj(vfs_posix_ilistdir_it_t);
     iter->base.type = &mp_type_polymorph_iter;
     iter->iternext = vfs_posix_ilistdir_it_iternext;
     iter->is_str = mp_obj_get_type(path_in) == &mp_type_str;
+    if (n_args == 3 && mp_obj_is_true(args[2])) {
+        // refill a single result tuple on each iteration step
+        iter->reuse_result = mp_obj_new_tuple(3, NULL);
+    } else {
+        iter->reuse_result = MP_OBJ_NULL;
+    }
     const char *path = vfs_posix_get_path_str(self, path_in);
     if (path[0] == '\0') {
         path = ".";
@@ -242,7 +255,7 @@ STATIC mp_obj_t vfs_posix_ilistdir(mp_obj_t self_in, mp_obj_t path_in) {
     }
     return MP_OBJ_FROM_PTR(iter);
 }
-STATIC MP_DEFINE_CONST_FUN_OBJ_2(vfs_posix_ilistdir_obj, vfs_posix_ilistdir);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(vfs_posix_ilistdir_obj, 2, 3, vfs_posix_ilistdir);
 
 typedef struct _mp_obj_listdir_t {
     mp_obj_base_t base;
@@ -38,7 +38,7 @@ typedef struct _mp_reader_vfs_t {
     mp_obj_t file;
     uint16_t len;
     uint16_t pos;
-    byte buf[24];
+    byte buf[MICROPY_READER_BUF_SIZE];
 } mp_reader_vfs_t;
 
 STATIC mp_uint_t mp_reader_vfs_readbyte(void *data) {
@@ -70,13 +70,28 @@ STATIC void mp_reader_vfs_close(void *data) {
 }
 
 void mp_reader_new_file(mp_reader_t *reader, const char *filename) {
-    mp_reader_vfs_t *rf = m_new_obj(mp_reader_vfs_t);
     mp_obj_t args[2] = {
         mp_obj_new_str(filename, strlen(filename)),
         MP_OBJ_NEW_QSTR(MP_QSTR_rb),
     };
-    rf->file = mp_vfs_open(MP_ARRAY_SIZE(args), &args[0], (mp_map_t *)&mp_const_empty_map);
+    mp_obj_t file = mp_vfs_open(MP_ARRAY_SIZE(args), &args[0], (mp_map_t *)&mp_const_empty_map);
     int errcode;
+
+    #if MICROPY_VFS_BUNDLE
+    // If the file's contents are directly addressable (eg it lives in a
+    // memory-mapped bundle) then use a memory reader on them: no buffering,
+    // and persistent code can then be loaded in place.
+    struct mp_stream_buffer_t sbuf;
+    if (mp_get_stream(file)->can_get_buffer
+        && mp_get_stream(file)->ioctl(file, MP_STREAM_GET_BUFFER, (uintptr_t)&sbuf, &errcode) == 0) {
+        mp_stream_close(file);
+        mp_reader_new_mem(reader, sbuf.buf, sbuf.len, 0);
+        return;
+    }
+    #endif
+
+    mp_reader_vfs_t *rf = m_new_obj(mp_reader_vfs_t);
+    rf->file = file;
     rf->len = mp_stream_rw(rf->file, rf->buf, sizeof(rf->buf), &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
     if (errcode != 0) {
         mp_raise_OSError(errcode);
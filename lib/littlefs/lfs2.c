@@ -4213,6 +4213,41 @@ static lfs2_ssize_t lfs2_fs_rawsize(lfs2_t *lfs2) {
     return size;
 }
 
+#ifndef LFS2_READONLY
+static int lfs2_fs_rawgc(lfs2_t *lfs2) {
+    // force consistency first, this resolves any pending moves/orphans
+    // now instead of during a later write
+    int err = lfs2_fs_forceconsistency(lfs2);
+    if (err) {
+        return err;
+    }
+
+    // iterate over all metadata pairs and compact any that are nearly
+    // full, so that the compaction cost is not paid by a later commit
+    lfs2_mdir_t mdir = {.tail = {0, 1}};
+    while (!lfs2_pair_isnull(mdir.tail)) {
+        err = lfs2_dir_fetch(lfs2, &mdir, mdir.tail);
+        if (err) {
+            return err;
+        }
+
+        // not erased? past the same threshold commits use to compact early?
+        if (!mdir.erased || mdir.off > lfs2->cfg->block_size
+                - lfs2->cfg->block_size/8) {
+            // the easiest way to trigger a compaction is to mark the
+            // mdir as unerased and commit with no attrs
+            mdir.erased = false;
+            err = lfs2_dir_commit(lfs2, &mdir, NULL, 0);
+            if (err) {
+                return err;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif
+
 #ifdef LFS2_MIGRATE
 ////// Migration from littelfs v1 below this //////
 
@@ -5359,6 +5394,22 @@ int lfs2_fs_traverse(lfs2_t *lfs2, int (*cb)(void *, lfs2_block_t), void *data)
     return err;
 }
 
+#ifndef LFS2_READONLY
+int lfs2_fs_gc(lfs2_t *lfs2) {
+    int err = LFS2_LOCK(lfs2->cfg);
+    if (err) {
+        return err;
+    }
+    LFS2_TRACE("lfs2_fs_gc(%p)", (void*)lfs2);
+
+    err = lfs2_fs_rawgc(lfs2);
+
+    LFS2_TRACE("lfs2_fs_gc -> %d", err);
+    LFS2_UNLOCK(lfs2->cfg);
+    return err;
+}
+#endif
+
 #ifdef LFS2_MIGRATE
 int lfs2_migrate(lfs2_t *lfs2, const struct lfs2_config *cfg) {
     int err = LFS2_LOCK(cfg);
@@ -664,6 +664,17 @@ lfs2_ssize_t lfs2_fs_size(lfs2_t *lfs2);
 // Returns a negative error code on failure.
 int lfs2_fs_traverse(lfs2_t *lfs2, int (*cb)(void*, lfs2_block_t), void *data);
 
+#ifndef LFS2_READONLY
+// Attempt any janitorial work that would otherwise be deferred
+//
+// This resolves any pending moves or orphans and compacts metadata pairs
+// that are nearly full, so that this work does not need to happen during
+// a later write. Useful to call when the system is otherwise idle.
+//
+// Returns a negative error code on failure.
+int lfs2_fs_gc(lfs2_t *lfs2);
+#endif
+
 #ifndef LFS2_READONLY
 #ifdef LFS2_MIGRATE
 // Attempts to migrate a previous version of littlefs
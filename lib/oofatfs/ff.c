@@ -2379,38 +2379,69 @@ static FRESULT dir_read (
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
 
-static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
-    DIR* dp                 /* Pointer to the directory object with the file name */
+#if FF_DIR_CACHE_SIZE
+/* Number of entries one probe of a cached offset may examine: a full LFN
+/  sequence plus its SFN entry, or just the one entry without LFN support. */
+#if FF_USE_LFN
+#define DIR_CACHE_PROBE_LIMIT (FF_MAX_LFN / 13 + 2)
+#else
+#define DIR_CACHE_PROBE_LIMIT 1
+#endif
+
+static WORD dir_cache_hash (   /* Hash of the name stored in the directory object */
+    DIR* dp
 )
 {
-    FRESULT res;
-    FATFS *fs = dp->obj.fs;
-    BYTE c;
+    WORD h = 0;
+    UINT i;
 #if FF_USE_LFN
-    BYTE a, ord, sum;
+    if (!(dp->fn[NSFLAG] & NS_NOLFN)) {
+        WCHAR *lfn = dp->obj.fs->lfnbuf;
+        for (i = 0; lfn[i]; i++) h = h * 31 + lfn[i];
+        return h;
+    }
 #endif
+    for (i = 0; i < 11; i++) h = h * 31 + dp->fn[i];
+    return h;
+}
 
-    res = dir_sdi(dp, 0);           /* Rewind directory object */
-    if (res != FR_OK) return res;
-#if FF_FS_EXFAT
-    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
-        BYTE nc;
-        UINT di, ni;
-        WORD hash = xname_sum(fs->lfnbuf);      /* Hash value of the name to find */
+static void dir_cache_insert (
+    FATFS* fs,
+    DWORD dclust,   /* Start cluster of the directory holding the entry */
+    WORD hash,      /* Hash of the looked-up name */
+    DWORD ofs       /* Offset of the entry in the directory */
+)
+{
+    fs->dir_cache[fs->dir_cache_next].dclust = dclust;
+    fs->dir_cache[fs->dir_cache_next].ofs = ofs;
+    fs->dir_cache[fs->dir_cache_next].hash = hash;
+    fs->dir_cache_next = (fs->dir_cache_next + 1) % FF_DIR_CACHE_SIZE;
+}
 
-        while ((res = DIR_READ_FILE(dp)) == FR_OK) {    /* Read an item */
-#if FF_MAX_LFN < 255
-            if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;            /* Skip comparison if inaccessible object name */
-#endif
-            if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) continue;  /* Skip comparison if hash mismatched */
-            for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) { /* Compare the name */
-                if ((di % SZDIRE) == 0) di += 2;
-                if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
-            }
-            if (nc == 0 && !fs->lfnbuf[ni]) break;  /* Name matched? */
-        }
-        return res;
+static void dir_cache_invalidate (  /* Drop cached entries of one directory (writes) or all (re-mount) */
+    FATFS* fs,
+    DWORD dclust,   /* Start cluster of the modified directory */
+    int all         /* Non-zero: invalidate the whole cache */
+)
+{
+    UINT i;
+    for (i = 0; i < FF_DIR_CACHE_SIZE; i++) {
+        if (all || fs->dir_cache[i].dclust == dclust) fs->dir_cache[i].ofs = 0xFFFFFFFF;
     }
+    if (all) fs->dir_cache_next = 0;
+}
+#endif /* FF_DIR_CACHE_SIZE */
+
+static FRESULT dir_find_scan (  /* FR_OK(0):succeeded, !=0:error */
+    DIR* dp,                /* Pointer to the directory object with the file name */
+    UINT limit              /* Max number of entries to examine (0:no limit) */
+)
+{
+    FRESULT res;
+    FATFS *fs = dp->obj.fs;
+    BYTE c;
+#if FF_USE_LFN
+    BYTE a, ord, sum;
 #endif
     /* On the FAT/FAT32 volume */
 #if FF_USE_LFN
@@ -2446,6 +2477,7 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
         dp->obj.attr = dp->dir[DIR_Attr] & AM_MASK;
         if (!(dp->dir[DIR_Attr] & AM_VOL) && !mem_cmp(dp->dir, dp->fn, 11)) break;  /* Is it a valid entry? */
 #endif
+        if (limit != 0 && --limit == 0) { res = FR_NO_FILE; break; }    /* Probe of a cached offset is bounded */
         res = dir_next(dp, 0);  /* Next entry */
     } while (res == FR_OK);
 
@@ -2453,6 +2485,71 @@ static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
 }
 
 
+static FRESULT dir_find (   /* FR_OK(0):succeeded, !=0:error */
+    DIR* dp                 /* Pointer to the directory object with the file name */
+)
+{
+    FRESULT res;
+#if FF_FS_EXFAT || FF_DIR_CACHE_SIZE
+    FATFS *fs = dp->obj.fs;
+#endif
+#if FF_DIR_CACHE_SIZE
+    WORD hash;
+    UINT i;
+#endif
+
+    res = dir_sdi(dp, 0);           /* Rewind directory object */
+    if (res != FR_OK) return res;
+#if FF_FS_EXFAT
+    if (fs->fs_type == FS_EXFAT) {  /* On the exFAT volume */
+        BYTE nc;
+        UINT di, ni;
+        WORD hash = xname_sum(fs->lfnbuf);      /* Hash value of the name to find */
+
+        while ((res = DIR_READ_FILE(dp)) == FR_OK) {    /* Read an item */
+#if FF_MAX_LFN < 255
+            if (fs->dirbuf[XDIR_NumName] > FF_MAX_LFN) continue;            /* Skip comparison if inaccessible object name */
+#endif
+            if (ld_word(fs->dirbuf + XDIR_NameHash) != hash) continue;  /* Skip comparison if hash mismatched */
+            for (nc = fs->dirbuf[XDIR_NumName], di = SZDIRE * 2, ni = 0; nc; nc--, di += 2, ni++) { /* Compare the name */
+                if ((di % SZDIRE) == 0) di += 2;
+                if (ff_wtoupper(ld_word(fs->dirbuf + di)) != ff_wtoupper(fs->lfnbuf[ni])) break;
+            }
+            if (nc == 0 && !fs->lfnbuf[ni]) break;  /* Name matched? */
+        }
+        return res;
+    }
+#endif
+#if FF_DIR_CACHE_SIZE
+    hash = dir_cache_hash(dp);
+    for (i = 0; i < FF_DIR_CACHE_SIZE; i++) {   /* Try cached entry offsets for this name first */
+        if (fs->dir_cache[i].ofs == 0xFFFFFFFF) continue;
+        if (fs->dir_cache[i].dclust != dp->obj.sclust || fs->dir_cache[i].hash != hash) continue;
+        if (dir_sdi(dp, fs->dir_cache[i].ofs) == FR_OK) {
+            res = dir_find_scan(dp, DIR_CACHE_PROBE_LIMIT); /* Verify the name at the cached offset */
+            if (res == FR_OK) return FR_OK;
+            if (res != FR_NO_FILE) return res;  /* Disk error */
+        }
+        fs->dir_cache[i].ofs = 0xFFFFFFFF;      /* Stale entry, drop it */
+        res = dir_sdi(dp, 0);                   /* Rewind for the full scan */
+        if (res != FR_OK) return res;
+        break;
+    }
+    res = dir_find_scan(dp, 0);
+    if (res == FR_OK) {         /* Remember where the entry was found */
+#if FF_USE_LFN
+        dir_cache_insert(fs, dp->obj.sclust, hash, dp->blk_ofs != 0xFFFFFFFF ? dp->blk_ofs : dp->dptr);
+#else
+        dir_cache_insert(fs, dp->obj.sclust, hash, dp->dptr);
+#endif
+    }
+    return res;
+#else
+    return dir_find_scan(dp, 0);
+#endif
+}
+
+
 
 
 #if !FF_FS_READONLY
@@ -2466,6 +2563,9 @@ static FRESULT dir_register (   /* FR_OK:succeeded, FR_DENIED:no free entry or t
 {
     FRESULT res;
     FATFS *fs = dp->obj.fs;
+#if FF_DIR_CACHE_SIZE
+    dir_cache_invalidate(fs, dp->obj.sclust, 0);    /* Directory is about to change */
+#endif
 #if FF_USE_LFN      /* LFN configuration */
     UINT n, nlen, nent;
     BYTE sn[12], sum;
@@ -2572,6 +2672,9 @@ static FRESULT dir_remove ( /* FR_OK:Succeeded, FR_DISK_ERR:A disk error */
 {
     FRESULT res;
     FATFS *fs = dp->obj.fs;
+#if FF_DIR_CACHE_SIZE
+    dir_cache_invalidate(fs, dp->obj.sclust, 0);    /* Directory is about to change */
+#endif
 #if FF_USE_LFN      /* LFN configuration */
     DWORD last = dp->dptr;
 
@@ -3138,6 +3241,9 @@ static FRESULT find_volume (    /* FR_OK(0): successful, !=0: an error occurred
     /* Following code attempts to mount the volume. (analyze BPB and initialize the filesystem object) */
 
     fs->fs_type = 0;                    /* Clear the filesystem object */
+#if FF_DIR_CACHE_SIZE
+    dir_cache_invalidate(fs, 0, 1);     /* Cached entry offsets are no longer valid */
+#endif
     disk_ioctl(fs->drv, IOCTL_INIT, &stat); /* Initialize the physical drive */
     if (stat & STA_NOINIT) {            /* Check if the initialization succeeded */
         return FR_NOT_READY;            /* Failed to initialize due to no medium or hard error */
@@ -162,6 +162,14 @@ typedef struct {
     DWORD   bitbase;        /* Allocation bitmap base sector */
 #endif
     DWORD   winsect;        /* Current sector appearing in the win[] */
+#if FF_DIR_CACHE_SIZE
+    struct {
+        DWORD   dclust;     /* Start cluster of the directory holding the entry */
+        DWORD   ofs;        /* Offset of the entry in the directory (0xFFFFFFFF:invalid) */
+        WORD    hash;       /* Hash of the name the entry was found with */
+    } dir_cache[FF_DIR_CACHE_SIZE]; /* Cache of recently found directory entries */
+    UINT    dir_cache_next; /* Round-robin insertion point into dir_cache[] */
+#endif
     BYTE    win[FF_MAX_SS]; /* Disk access window for Directory, FAT (and file data at tiny cfg) */
 } FATFS;
 
@@ -259,7 +259,11 @@
 /  GET_SECTOR_SIZE command. */
 
 
+#ifdef MICROPY_FATFS_USE_TRIM
+#define FF_USE_TRIM     (MICROPY_FATFS_USE_TRIM)
+#else
 #define FF_USE_TRIM     0
+#endif
 /* This option switches support for ATA-TRIM. (0:Disable or 1:Enable)
 /  To enable Trim function, also CTRL_TRIM command should be implemented to the
 /  disk_ioctl() function. */
@@ -299,6 +303,17 @@
 /  Note that enabling exFAT discards ANSI C (C89) compatibility. */
 
 
+#ifdef MICROPY_FATFS_DIR_CACHE_SIZE
+#define FF_DIR_CACHE_SIZE (MICROPY_FATFS_DIR_CACHE_SIZE)
+#else
+#define FF_DIR_CACHE_SIZE 0
+#endif
+/* This option sets the number of entries in the per-volume cache of recently
+/  found directory entries, used to skip the linear directory scan when the
+/  same name is looked up again (repeated open/stat in large directories).
+/  Each entry costs 10 bytes in the FATFS object.  0 disables the cache. */
+
+
 #ifdef MICROPY_FATFS_NORTC
 #define FF_FS_NORTC (MICROPY_FATFS_NORTC)
 #else
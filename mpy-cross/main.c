@@ -31,12 +31,15 @@
 
 #include "py/compile.h"
 #include "py/persistentcode.h"
+#include "py/bc0.h"
 #include "py/runtime.h"
 #include "py/gc.h"
 #include "py/stackctrl.h"
 #include "genhdr/mpversion.h"
 #ifdef _WIN32
 #include "ports/windows/fmode.h"
+#else
+#include <sys/wait.h>
 #endif
 
 // Command line options, with their defaults
@@ -95,13 +98,93 @@ STATIC int compile_and_save(const char *file, const char *output_file, const cha
     }
 }
 
+// Compile several files into a single .mpy whose outer code executes each
+// module's body in turn.  Because everything is saved in one stream the qstr
+// window deduplicates identifiers the modules have in common, so the combined
+// file is smaller than the separate ones and the strings are interned once at
+// load time.
+STATIC int compile_and_save_combined(const char **files, int n_files, const char *output_file) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        // compile each input file to a raw code, collected in a constant table
+        mp_uint_t *const_table = m_new(mp_uint_t, n_files);
+        for (int i = 0; i < n_files; i++) {
+            mp_lexer_t *lex = mp_lexer_new_from_file(files[i]);
+            qstr source_name = lex->source_name;
+            #if MICROPY_PY___FILE__
+            mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
+            #endif
+            mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+            const_table[i] = (mp_uint_t)(uintptr_t)mp_compile_to_raw_code(&parse_tree, source_name, false);
+        }
+
+        // Build bytecode for the outer module: a minimal prelude (one state
+        // slot, no args) followed by code to make and call a function from
+        // each sub-raw-code in sequence.
+        vstr_t bc;
+        vstr_init(&bc, 8 + 8 * n_files);
+        qstr outer_name = qstr_from_str(output_file);
+        vstr_add_byte(&bc, 0); // prelude signature
+        vstr_add_byte(&bc, 4 << 1); // prelude size: 4 info bytes, no cells
+        vstr_add_byte(&bc, outer_name & 0xff); // simple_name
+        vstr_add_byte(&bc, (outer_name >> 8) & 0xff);
+        vstr_add_byte(&bc, outer_name & 0xff); // source_file
+        vstr_add_byte(&bc, (outer_name >> 8) & 0xff);
+        for (int i = 0; i < n_files; i++) {
+            vstr_add_byte(&bc, MP_BC_MAKE_FUNCTION);
+            // var-uint index of the sub-raw-code
+            if (i >= (1 << 14)) {
+                vstr_add_byte(&bc, 0x80 | ((i >> 14) & 0x7f));
+            }
+            if (i >= (1 << 7)) {
+                vstr_add_byte(&bc, 0x80 | ((i >> 7) & 0x7f));
+            }
+            vstr_add_byte(&bc, i & 0x7f);
+            vstr_add_byte(&bc, MP_BC_CALL_FUNCTION);
+            vstr_add_byte(&bc, 0); // no arguments
+            vstr_add_byte(&bc, MP_BC_POP_TOP);
+        }
+        vstr_add_byte(&bc, MP_BC_LOAD_CONST_NONE);
+        vstr_add_byte(&bc, MP_BC_RETURN_VALUE);
+
+        mp_raw_code_t *rc = mp_emit_glue_new_raw_code();
+        rc->kind = MP_CODE_BYTECODE;
+        rc->scope_flags = 0;
+        rc->fun_data = (const byte *)bc.buf;
+        rc->fun_data_len = bc.len;
+        rc->const_table = const_table;
+        rc->n_obj = 0;
+        rc->n_raw_code = n_files;
+
+        mp_raw_code_save_file(rc, output_file);
+
+        nlr_pop();
+        return 0;
+    } else {
+        // uncaught exception
+        mp_obj_print_exception(&mp_stderr_print, (mp_obj_t)nlr.ret_val);
+        return 1;
+    }
+}
+
+// Compile every step'th file of the given list, starting at the first.
+STATIC int compile_files(const char **files, int n_files, int step) {
+    int ret = 0;
+    for (int i = 0; i < n_files; i += step) {
+        ret |= compile_and_save(files[i], NULL, NULL);
+    }
+    return ret;
+}
+
 STATIC int usage(char **argv) {
     printf(
-        "usage: %s [<opts>] [-X <implopt>] <input filename>\n"
+        "usage: %s [<opts>] [-X <implopt>] <input filenames...>\n"
         "Options:\n"
         "--version : show version information\n"
-        "-o : output file for compiled bytecode (defaults to input with .mpy extension)\n"
+        "-o : output file for compiled bytecode (defaults to input with .mpy extension);\n"
+        "     with multiple input files, combines them all into the one output file\n"
         "-s : source filename to embed in the compiled bytecode (defaults to input file)\n"
+        "-j : number of processes to compile with when multiple files are given\n"
         "-v : verbose (trace various operations); can be multiple\n"
         "-O[N] : apply bytecode optimizations of level N\n"
         "\n"
@@ -221,9 +304,11 @@ MP_NOINLINE int main_(int argc, char **argv) {
     mp_dynamic_compiler.nlr_buf_num_regs = 0;
     #endif
 
-    const char *input_file = NULL;
+    const char **input_files = malloc(argc * sizeof(char *));
+    int n_input_files = 0;
     const char *output_file = NULL;
     const char *source_file = NULL;
+    int num_jobs = 1;
 
     // parse main options
     for (int a = 1; a < argc; a++) {
@@ -256,6 +341,16 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 }
                 a += 1;
                 source_file = argv[a];
+            } else if (strcmp(argv[a], "-j") == 0) {
+                if (a + 1 >= argc) {
+                    exit(usage(argv));
+                }
+                a += 1;
+                char *end;
+                num_jobs = strtol(argv[a], &end, 0);
+                if (*end || num_jobs < 1) {
+                    return usage(argv);
+                }
             } else if (strncmp(argv[a], "-msmall-int-bits=", sizeof("-msmall-int-bits=") - 1) == 0) {
                 char *end;
                 mp_dynamic_compiler.small_int_bits =
@@ -308,20 +403,68 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 return usage(argv);
             }
         } else {
-            if (input_file != NULL) {
-                mp_printf(&mp_stderr_print, "multiple input files\n");
-                exit(1);
-            }
-            input_file = argv[a];
+            input_files[n_input_files++] = argv[a];
         }
     }
 
-    if (input_file == NULL) {
+    if (n_input_files == 0) {
         mp_printf(&mp_stderr_print, "no input file\n");
         exit(1);
     }
 
-    int ret = compile_and_save(input_file, output_file, source_file);
+    int ret;
+    if (n_input_files == 1) {
+        ret = compile_and_save(input_files[0], output_file, source_file);
+    } else if (output_file != NULL) {
+        // batch mode with -o: combine all files into a single .mpy that
+        // shares one qstr window across the modules
+        if (source_file != NULL) {
+            mp_printf(&mp_stderr_print, "option -s requires a single input file\n");
+            exit(1);
+        }
+        ret = compile_and_save_combined(input_files, n_input_files, output_file);
+    } else {
+        // batch mode: compile each file to its default .mpy name
+        if (source_file != NULL) {
+            mp_printf(&mp_stderr_print, "option -s requires a single input file\n");
+            exit(1);
+        }
+        if (num_jobs > n_input_files) {
+            num_jobs = n_input_files;
+        }
+        #ifndef _WIN32
+        if (num_jobs > 1) {
+            // Fork a worker per job, each compiling an interleaved subset of
+            // the files.  Processes rather than threads are used because the
+            // runtime (GC heap, qstr pool, VM state) is global and has no
+            // locking; each worker gets a copy-on-write view of the
+            // initialised state and they share nothing thereafter.
+            fflush(NULL);
+            pid_t *pids = malloc(num_jobs * sizeof(pid_t));
+            for (int w = 0; w < num_jobs; w++) {
+                pids[w] = fork();
+                if (pids[w] == 0) {
+                    exit(compile_files(input_files + w, n_input_files - w, num_jobs) & 0xff);
+                } else if (pids[w] < 0) {
+                    perror("fork");
+                    exit(1);
+                }
+            }
+            ret = 0;
+            for (int w = 0; w < num_jobs; w++) {
+                int status;
+                waitpid(pids[w], &status, 0);
+                if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                    ret = 1;
+                }
+            }
+            free(pids);
+        } else
+        #endif
+        {
+            ret = compile_files(input_files, n_input_files, 1);
+        }
+    }
 
     #if MICROPY_PY_MICROPYTHON_MEM_INFO
     if (mp_verbose_flag) {
@@ -363,6 +363,9 @@ STATIC mp_obj_t machine_pin_irq(size_t n_args, const mp_obj_t *pos_args, mp_map_
         DisableIRQ(irq_num);
         GPIO_PortDisableInterrupts(self->gpio, 1U << self->pin);
 
+        if (args[ARG_hard].u_bool) {
+            mp_irq_check_hard_handler(args[ARG_handler].u_obj);
+        }
         // Update IRQ data.
         irq->base.handler = args[ARG_handler].u_obj;
         irq->base.ishard = args[ARG_hard].u_bool;
@@ -345,6 +345,9 @@ STATIC mp_obj_t machine_pin_irq(size_t n_args, const mp_obj_t *pos_args, mp_map_
         // Disable all IRQs while data is updated.
         gpio_set_irq_enabled(self->id, GPIO_IRQ_ALL, false);
 
+        if (args[ARG_hard].u_bool) {
+            mp_irq_check_hard_handler(args[ARG_handler].u_obj);
+        }
         // Update IRQ data.
         irq->base.handler = args[ARG_handler].u_obj;
         irq->base.ishard = args[ARG_hard].u_bool;
@@ -106,6 +106,9 @@ int main(int argc, char **argv) {
         readline_init0();
         machine_pin_init();
         rp2_pio_init();
+        #if MICROPY_PY_THREAD
+        rp2_core1_init();
+        #endif
 
         // Execute _boot.py to set up the filesystem.
         pyexec_frozen_module("_boot.py");
@@ -139,6 +142,7 @@ int main(int argc, char **argv) {
         rp2_pio_deinit();
         machine_pin_deinit();
         #if MICROPY_PY_THREAD
+        rp2_core1_deinit();
         mp_thread_deinit();
         #endif
         gc_sweep_all();
@@ -27,6 +27,7 @@
 #include "py/runtime.h"
 #include "py/mphal.h"
 #include "shared/runtime/pyexec.h"
+#include "extmod/machine_atomic.h"
 #include "extmod/machine_i2c.h"
 #include "extmod/machine_mem.h"
 #include "extmod/machine_pulse.h"
@@ -154,11 +155,19 @@ STATIC const mp_rom_map_elem_t machine_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_enable_irq),          MP_ROM_PTR(&machine_enable_irq_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_time_pulse_us),       MP_ROM_PTR(&machine_time_pulse_us_obj) },
+    { MP_ROM_QSTR(MP_QSTR_time_pulses_us),      MP_ROM_PTR(&machine_time_pulses_us_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_mem8),                MP_ROM_PTR(&machine_mem8_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem16),               MP_ROM_PTR(&machine_mem16_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem32),               MP_ROM_PTR(&machine_mem32_obj) },
 
+    #if MICROPY_PY_MACHINE_ATOMIC
+    { MP_ROM_QSTR(MP_QSTR_atomic_load),         MP_ROM_PTR(&machine_atomic_load_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_store),        MP_ROM_PTR(&machine_atomic_store_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_add),          MP_ROM_PTR(&machine_atomic_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_cas),          MP_ROM_PTR(&machine_atomic_cas_obj) },
+    #endif
+
     { MP_ROM_QSTR(MP_QSTR_ADC),                 MP_ROM_PTR(&machine_adc_type) },
     { MP_ROM_QSTR(MP_QSTR_I2C),                 MP_ROM_PTR(&machine_hw_i2c_type) },
     { MP_ROM_QSTR(MP_QSTR_SoftI2C),             MP_ROM_PTR(&mp_machine_soft_i2c_type) },
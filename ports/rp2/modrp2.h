@@ -35,4 +35,13 @@ extern const mp_obj_type_t rp2_state_machine_type;
 void rp2_pio_init(void);
 void rp2_pio_deinit(void);
 
+#if MICROPY_PY_THREAD
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(rp2_core1_run_obj);
+MP_DECLARE_CONST_FUN_OBJ_0(rp2_core1_busy_obj);
+MP_DECLARE_CONST_FUN_OBJ_0(rp2_core1_close_obj);
+
+void rp2_core1_init(void);
+void rp2_core1_deinit(void);
+#endif
+
 #endif // MICROPY_INCLUDED_RP2_MODRP2_H
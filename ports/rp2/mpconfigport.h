@@ -128,6 +128,7 @@
 #define MICROPY_PY_URANDOM_SEED_INIT_FUNC       (rosc_random_u32())
 #define MICROPY_PY_USELECT                      (1)
 #define MICROPY_PY_MACHINE                      (1)
+#define MICROPY_PY_MACHINE_ATOMIC               (1)
 #define MICROPY_PY_MACHINE_PIN_MAKE_NEW         mp_pin_make_new
 #define MICROPY_PY_MACHINE_PULSE                (1)
 #define MICROPY_PY_MACHINE_I2C                  (1)
@@ -177,6 +178,7 @@ extern const struct _mp_obj_module_t mp_module_utime;
     void *rp2_state_machine_irq_obj[8]; \
     void *rp2_uart_rx_buffer[2]; \
     void *rp2_uart_tx_buffer[2]; \
+    mp_obj_t rp2_core1_job[3]; \
 
 #define MP_STATE_PORT MP_STATE_VM
 
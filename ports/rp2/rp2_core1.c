@@ -0,0 +1,201 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020-2021 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Offload of viper/native functions to core1.
+//
+// rp2.core1_run(fun, arg, callback) hands one function call to a persistent
+// dispatcher running on the second core, leaving the VM free on core0.  The
+// dispatcher is launched lazily through the normal thread machinery, so it
+// is mutually exclusive with _thread (whichever claims core1 first wins),
+// its stack is traced by the GC, and running without the GIL both cores
+// execute concurrently.  Jobs are handed over via the inter-core FIFO and
+// the result is posted back by scheduling the callback on core0.
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "py/mpthread.h"
+#include "py/stackctrl.h"
+#include "modrp2.h"
+#include "pico/multicore.h"
+
+#if MICROPY_PY_THREAD
+
+// Commands sent to the dispatcher through the inter-core FIFO.
+#define CORE1_CMD_EXIT (0)
+#define CORE1_CMD_RUN (1)
+
+// Indices into the rp2_core1_job root-pointer array.
+#define JOB_FUN (0)
+#define JOB_ARG (1)
+#define JOB_CALLBACK (2)
+
+STATIC volatile bool core1_dispatcher_running = false;
+STATIC volatile bool core1_job_pending = false;
+STATIC size_t core1_dispatcher_stack_size = 0;
+
+STATIC void *core1_dispatcher(void *arg_in) {
+    // Execution begins here on core1, mirroring modthread.c:thread_entry.
+    (void)arg_in;
+
+    mp_state_thread_t ts;
+    mp_thread_set_state(&ts);
+
+    mp_stack_set_top(&ts + 1); // need to include ts in root-pointer scan
+    mp_stack_set_limit(core1_dispatcher_stack_size);
+
+    ts.gc_lock_depth = 0;
+    ts.mp_pending_exception = MP_OBJ_NULL;
+
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+    ts.current_code_state = NULL;
+    #endif
+    #if MICROPY_CPU_PROFILE
+    ts.cpu_prof_countdown = 0;
+    #endif
+
+    #if MICROPY_OPT_CODE_STATE_POOL
+    memset(ts.code_state_pool, 0, sizeof(ts.code_state_pool));
+    #endif
+
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    memset(ts.gc_block_cache, 0, sizeof(ts.gc_block_cache));
+    memset(ts.gc_block_cache_len, 0, sizeof(ts.gc_block_cache_len));
+    #endif
+
+    mp_locals_set(mp_state_ctx.thread.dict_locals);
+    mp_globals_set(mp_state_ctx.thread.dict_globals);
+
+    MP_THREAD_GIL_ENTER();
+    mp_thread_start();
+
+    for (;;) {
+        uint32_t cmd = multicore_fifo_pop_blocking();
+        if (cmd == CORE1_CMD_EXIT) {
+            break;
+        }
+
+        mp_obj_t fun = MP_STATE_PORT(rp2_core1_job)[JOB_FUN];
+        mp_obj_t arg = MP_STATE_PORT(rp2_core1_job)[JOB_ARG];
+        mp_obj_t callback = MP_STATE_PORT(rp2_core1_job)[JOB_CALLBACK];
+        mp_obj_t result = mp_const_none;
+
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            result = mp_call_function_1(fun, arg);
+            nlr_pop();
+        } else {
+            // uncaught exception: report it and deliver None to the callback
+            mp_printf(MICROPY_ERROR_PRINTER, "Unhandled exception in core1 function ");
+            mp_obj_print_helper(MICROPY_ERROR_PRINTER, fun, PRINT_REPR);
+            mp_printf(MICROPY_ERROR_PRINTER, "\n");
+            mp_obj_print_exception(MICROPY_ERROR_PRINTER, MP_OBJ_FROM_PTR(nlr.ret_val));
+        }
+
+        if (callback != mp_const_none) {
+            // post the result back to core0; the result stays rooted via
+            // this stack until it lands in the schedule queue
+            while (!mp_sched_schedule(callback, result)) {
+                mp_hal_delay_us(100);
+            }
+        }
+
+        core1_job_pending = false;
+    }
+
+    core1_job_pending = false;
+    core1_dispatcher_running = false;
+
+    mp_thread_finish();
+    MP_THREAD_GIL_EXIT();
+
+    return NULL;
+}
+
+STATIC mp_obj_t rp2_core1_run(size_t n_args, const mp_obj_t *args) {
+    if (!mp_obj_is_native_fun(args[0])) {
+        mp_raise_ValueError(MP_ERROR_TEXT("expecting a viper/native function"));
+    }
+    if (core1_job_pending) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("core1 busy"));
+    }
+
+    if (!core1_dispatcher_running) {
+        // claim core1 for the dispatcher; raises OSError if a thread has it
+        core1_dispatcher_stack_size = 0;
+        mp_thread_create(core1_dispatcher, NULL, &core1_dispatcher_stack_size);
+        core1_dispatcher_running = true;
+    }
+
+    MP_STATE_PORT(rp2_core1_job)[JOB_FUN] = args[0];
+    MP_STATE_PORT(rp2_core1_job)[JOB_ARG] = n_args > 1 ? args[1] : mp_const_none;
+    MP_STATE_PORT(rp2_core1_job)[JOB_CALLBACK] = n_args > 2 ? args[2] : mp_const_none;
+    core1_job_pending = true;
+
+    multicore_fifo_push_blocking(CORE1_CMD_RUN);
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rp2_core1_run_obj, 1, 3, rp2_core1_run);
+
+STATIC mp_obj_t rp2_core1_busy(void) {
+    return mp_obj_new_bool(core1_job_pending);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(rp2_core1_busy_obj, rp2_core1_busy);
+
+// Wait for the current job to finish, then stop the dispatcher and release
+// core1 so it can be used by _thread again.
+STATIC mp_obj_t rp2_core1_close(void) {
+    if (core1_dispatcher_running) {
+        while (core1_job_pending) {
+            MICROPY_EVENT_POLL_HOOK
+        }
+        multicore_fifo_push_blocking(CORE1_CMD_EXIT);
+        while (core1_dispatcher_running) {
+            MICROPY_EVENT_POLL_HOOK
+        }
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(rp2_core1_close_obj, rp2_core1_close);
+
+void rp2_core1_init(void) {
+    core1_dispatcher_running = false;
+    core1_job_pending = false;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(MP_STATE_PORT(rp2_core1_job)); ++i) {
+        MP_STATE_PORT(rp2_core1_job)[i] = mp_const_none;
+    }
+}
+
+void rp2_core1_deinit(void) {
+    // The soft-reset path resets core1 via mp_thread_deinit, so just clear
+    // the dispatcher state rather than asking it to exit.
+    core1_dispatcher_running = false;
+    core1_job_pending = false;
+}
+
+#endif // MICROPY_PY_THREAD
@@ -329,6 +329,9 @@ STATIC mp_obj_t rp2_pio_irq(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
         // Disable all IRQs while data is updated.
         irq_set_enabled(self->irq, false);
 
+        if (args[ARG_hard].u_bool) {
+            mp_irq_check_hard_handler(args[ARG_handler].u_obj);
+        }
         // Update IRQ data.
         irq->base.handler = args[ARG_handler].u_obj;
         irq->base.ishard = args[ARG_hard].u_bool;
@@ -763,6 +766,9 @@ STATIC mp_obj_t rp2_state_machine_irq(size_t n_args, const mp_obj_t *pos_args, m
         // Disable all IRQs while data is updated.
         irq_set_enabled(self->irq, false);
 
+        if (args[ARG_hard].u_bool) {
+            mp_irq_check_hard_handler(args[ARG_handler].u_obj);
+        }
         // Update IRQ data.
         irq->base.handler = args[ARG_handler].u_obj;
         irq->base.ishard = args[ARG_hard].u_bool;
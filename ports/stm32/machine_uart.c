@@ -494,6 +494,9 @@ STATIC mp_obj_t pyb_uart_irq(size_t n_args, const mp_obj_t *pos_args, mp_map_t *
         }
 
         // Reconfigure user IRQs
+        if (args[MP_IRQ_ARG_INIT_hard].u_bool) {
+            mp_irq_check_hard_handler(handler);
+        }
         uart_irq_config(self, false);
         self->mp_irq_obj->handler = handler;
         self->mp_irq_obj->ishard = args[MP_IRQ_ARG_INIT_hard].u_bool;
@@ -408,6 +408,7 @@ STATIC const mp_rom_map_elem_t machine_module_globals_table[] = {
 
     #if MICROPY_PY_MACHINE_PULSE
     { MP_ROM_QSTR(MP_QSTR_time_pulse_us),       MP_ROM_PTR(&machine_time_pulse_us_obj) },
+    { MP_ROM_QSTR(MP_QSTR_time_pulses_us),      MP_ROM_PTR(&machine_time_pulses_us_obj) },
     #endif
 
     { MP_ROM_QSTR(MP_QSTR_mem8),                MP_ROM_PTR(&machine_mem8_obj) },
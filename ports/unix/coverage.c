@@ -514,6 +514,20 @@ STATIC mp_obj_t extra_coverage(void) {
             mp_obj_print_exception(&mp_plat_print, MP_OBJ_FROM_PTR(nlr.ret_val));
         }
         mp_handle_pending(true);
+
+        #if MICROPY_SCHEDULER_PRIORITY
+        // priority lane: callbacks jump ahead of already-queued bulk ones
+        mp_sched_lock();
+        mp_sched_schedule(MP_OBJ_FROM_PTR(&mp_builtin_print_obj), MP_OBJ_NEW_SMALL_INT(0));
+        mp_sched_schedule(MP_OBJ_FROM_PTR(&mp_builtin_print_obj), MP_OBJ_NEW_SMALL_INT(1));
+        for (int i = 0; i < 5; ++i) {
+            mp_printf(&mp_plat_print, "sched_pri(%d)=%d\n", i, mp_sched_schedule_priority(MP_OBJ_FROM_PTR(&mp_builtin_print_obj), MP_OBJ_NEW_SMALL_INT(100 + i)));
+        }
+        mp_sched_unlock();
+        while (mp_sched_num_pending()) {
+            mp_handle_pending(true);
+        }
+        #endif
     }
 
     // ringbuf
@@ -87,11 +87,27 @@ typedef struct _mp_obj_ffivar_t {
 //    ffi_type *type;
 } mp_obj_ffivar_t;
 
+// Per-argument conversion codes, precompiled from the argtype characters at
+// func() creation so the call path switches on a small int per argument
+// instead of re-deciding from the type string on every invocation.
+enum {
+    FFI_CONV_OBJ,    // 'O': pass the mp_obj_t itself
+    FFI_CONV_FLOAT,  // 'f'
+    FFI_CONV_DOUBLE, // 'd'
+    FFI_CONV_INT8,   // 'b'/'B'
+    FFI_CONV_INT16,  // 'h'/'H'
+    FFI_CONV_INT32,  // 'i'/'I'
+    FFI_CONV_LONG,   // 'l'/'L'
+    FFI_CONV_INT64,  // 'q'/'Q'
+    FFI_CONV_FFIARG, // pointers and everything else: full-width ffi_arg
+};
+
 typedef struct _mp_obj_ffifunc_t {
     mp_obj_base_t base;
     void *func;
     char rettype;
     const char *argtypes;
+    uint8_t *conv;
     ffi_cif cif;
     ffi_type *params[];
 } mp_obj_ffifunc_t;
@@ -153,6 +169,36 @@ STATIC ffi_type *char2ffi_type(char c) {
     }
 }
 
+STATIC uint8_t char2conv_code(char c) {
+    switch (c) {
+        case 'O':
+            return FFI_CONV_OBJ;
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            return FFI_CONV_FLOAT;
+        case 'd':
+            return FFI_CONV_DOUBLE;
+        #endif
+        case 'b':
+        case 'B':
+            return FFI_CONV_INT8;
+        case 'h':
+        case 'H':
+            return FFI_CONV_INT16;
+        case 'i':
+        case 'I':
+            return FFI_CONV_INT32;
+        case 'l':
+        case 'L':
+            return FFI_CONV_LONG;
+        case 'q':
+        case 'Q':
+            return FFI_CONV_INT64;
+        default:
+            return FFI_CONV_FFIARG;
+    }
+}
+
 STATIC ffi_type *get_ffi_type(mp_obj_t o_in) {
     if (mp_obj_is_str(o_in)) {
         const char *s = mp_obj_str_get_str(o_in);
@@ -232,12 +278,14 @@ STATIC mp_obj_t make_func(mp_obj_t rettype_in, void *func, mp_obj_t argtypes_in)
     o->func = func;
     o->rettype = *rettype;
     o->argtypes = argtypes;
+    o->conv = m_new(uint8_t, nparams);
 
     mp_obj_iter_buf_t iter_buf;
     mp_obj_t iterable = mp_getiter(argtypes_in, &iter_buf);
     mp_obj_t item;
     int i = 0;
     while ((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+        o->conv[i] = char2conv_code(argtypes[i]);
         o->params[i++] = get_ffi_type(item);
     }
 
@@ -268,6 +316,41 @@ STATIC mp_obj_t mod_ffi_func(mp_obj_t rettype, mp_obj_t addr_in, mp_obj_t argtyp
 }
 MP_DEFINE_CONST_FUN_OBJ_3(mod_ffi_func_obj, mod_ffi_func);
 
+// Spare libffi closures recycled from freed callback objects.
+// ffi_closure_alloc typically maps a whole executable page per closure, so
+// reuse released ones instead of going back to the system allocator each time.
+#define FFI_CLOSURE_POOL_LEN (4)
+
+typedef struct _ffi_closure_pool_entry_t {
+    ffi_closure *clo;
+    void *code;
+} ffi_closure_pool_entry_t;
+
+STATIC ffi_closure_pool_entry_t ffi_closure_pool[FFI_CLOSURE_POOL_LEN];
+
+STATIC ffi_closure *ffi_closure_pool_alloc(void **code) {
+    for (size_t i = 0; i < FFI_CLOSURE_POOL_LEN; i++) {
+        if (ffi_closure_pool[i].clo != NULL) {
+            ffi_closure *clo = ffi_closure_pool[i].clo;
+            *code = ffi_closure_pool[i].code;
+            ffi_closure_pool[i].clo = NULL;
+            return clo;
+        }
+    }
+    return ffi_closure_alloc(sizeof(ffi_closure), code);
+}
+
+STATIC void ffi_closure_pool_free(ffi_closure *clo, void *code) {
+    for (size_t i = 0; i < FFI_CLOSURE_POOL_LEN; i++) {
+        if (ffi_closure_pool[i].clo == NULL) {
+            ffi_closure_pool[i].clo = clo;
+            ffi_closure_pool[i].code = code;
+            return;
+        }
+    }
+    ffi_closure_free(clo);
+}
+
 STATIC void call_py_func(ffi_cif *cif, void *ret, void **args, void *user_data) {
     mp_obj_t pyargs[cif->nargs];
     mp_obj_fficallback_t *o = user_data;
@@ -334,10 +417,10 @@ STATIC mp_obj_t mod_ffi_callback(size_t n_args, const mp_obj_t *pos_args, mp_map
     const char *rettype = mp_obj_str_get_str(rettype_in);
 
     mp_int_t nparams = MP_OBJ_SMALL_INT_VALUE(mp_obj_len_maybe(paramtypes_in));
-    mp_obj_fficallback_t *o = m_new_obj_var(mp_obj_fficallback_t, ffi_type *, nparams);
+    mp_obj_fficallback_t *o = m_new_obj_var_with_finaliser(mp_obj_fficallback_t, ffi_type *, nparams);
     o->base.type = &fficallback_type;
 
-    o->clo = ffi_closure_alloc(sizeof(ffi_closure), &o->func);
+    o->clo = ffi_closure_pool_alloc(&o->func);
 
     o->rettype = *rettype;
     o->pyfunc = func_in;
@@ -492,14 +575,39 @@ STATIC mp_obj_t ffifunc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
     const char *argtype = self->argtypes;
     for (uint i = 0; i < n_args; i++, argtype++) {
         mp_obj_t a = args[i];
-        if (*argtype == 'O') {
+        uint8_t conv = self->conv[i];
+        if (conv == FFI_CONV_OBJ) {
             values[i].ffi = (ffi_arg)(intptr_t)a;
         #if MICROPY_PY_BUILTINS_FLOAT
-        } else if (*argtype == 'f') {
+        } else if (conv == FFI_CONV_FLOAT) {
             values[i].flt = mp_obj_get_float_to_f(a);
-        } else if (*argtype == 'd') {
+        } else if (conv == FFI_CONV_DOUBLE) {
             values[i].dbl = mp_obj_get_float_to_d(a);
         #endif
+        } else if (mp_obj_is_small_int(a)) {
+            // fast path for the overwhelmingly common case: store the value
+            // directly at the width the conversion plan precomputed
+            mp_int_t val = MP_OBJ_SMALL_INT_VALUE(a);
+            switch (conv) {
+                case FFI_CONV_INT8:
+                    values[i].B = val;
+                    break;
+                case FFI_CONV_INT16:
+                    values[i].H = val;
+                    break;
+                case FFI_CONV_INT32:
+                    values[i].I = val;
+                    break;
+                case FFI_CONV_LONG:
+                    values[i].L = val;
+                    break;
+                case FFI_CONV_INT64:
+                    values[i].Q = val;
+                    break;
+                default:
+                    values[i].ffi = val;
+                    break;
+            }
         } else if (a == mp_const_none) {
             values[i].ffi = 0;
         } else if (mp_obj_is_int(a)) {
@@ -553,7 +661,18 @@ STATIC mp_obj_t fficallback_cfun(mp_obj_t self_in) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(fficallback_cfun_obj, fficallback_cfun);
 
+STATIC mp_obj_t fficallback_del(mp_obj_t self_in) {
+    mp_obj_fficallback_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->clo != NULL) {
+        ffi_closure_pool_free(self->clo, self->func);
+        self->clo = NULL;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(fficallback_del_obj, fficallback_del);
+
 STATIC const mp_rom_map_elem_t fficallback_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&fficallback_del_obj) },
     { MP_ROM_QSTR(MP_QSTR_cfun), MP_ROM_PTR(&fficallback_cfun_obj) }
 };
 STATIC MP_DEFINE_CONST_DICT(fficallback_locals_dict, fficallback_locals_dict_table);
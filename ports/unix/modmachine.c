@@ -31,9 +31,11 @@
 #include "py/runtime.h"
 #include "py/obj.h"
 
+#include "extmod/machine_atomic.h"
 #include "extmod/machine_mem.h"
 #include "extmod/machine_pinbase.h"
 #include "extmod/machine_signal.h"
+#include "extmod/machine_pingroup.h"
 #include "extmod/machine_pulse.h"
 
 #if MICROPY_PLAT_DEV_MEM
@@ -92,14 +94,25 @@ STATIC const mp_rom_map_elem_t machine_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mem16), MP_ROM_PTR(&machine_mem16_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem32), MP_ROM_PTR(&machine_mem32_obj) },
 
+    #if MICROPY_PY_MACHINE_ATOMIC
+    { MP_ROM_QSTR(MP_QSTR_atomic_load), MP_ROM_PTR(&machine_atomic_load_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_store), MP_ROM_PTR(&machine_atomic_store_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_add), MP_ROM_PTR(&machine_atomic_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_atomic_cas), MP_ROM_PTR(&machine_atomic_cas_obj) },
+    #endif
+
     #ifdef MICROPY_UNIX_MACHINE_IDLE
     { MP_ROM_QSTR(MP_QSTR_idle), MP_ROM_PTR(&machine_idle_obj) },
     #endif
 
     { MP_ROM_QSTR(MP_QSTR_PinBase), MP_ROM_PTR(&machine_pinbase_type) },
     { MP_ROM_QSTR(MP_QSTR_Signal), MP_ROM_PTR(&machine_signal_type) },
+    #if MICROPY_PY_MACHINE_PINGROUP
+    { MP_ROM_QSTR(MP_QSTR_PinGroup), MP_ROM_PTR(&machine_pin_group_type) },
+    #endif
     #if MICROPY_PY_MACHINE_PULSE
     { MP_ROM_QSTR(MP_QSTR_time_pulse_us), MP_ROM_PTR(&machine_time_pulse_us_obj) },
+    { MP_ROM_QSTR(MP_QSTR_time_pulses_us), MP_ROM_PTR(&machine_time_pulses_us_obj) },
     #endif
 };
 
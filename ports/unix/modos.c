@@ -40,11 +40,16 @@
 
 #include "py/runtime.h"
 #include "py/objtuple.h"
+#include "py/stream.h"
 #include "py/mphal.h"
 #include "py/mpthread.h"
 #include "extmod/vfs.h"
 #include "extmod/misc.h"
 
+#if MICROPY_STREAMS_SENDFILE && defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
 #ifdef __ANDROID__
 #define USE_STATFS 1
 #endif
@@ -305,6 +310,63 @@ STATIC mp_obj_t mod_os_errno(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_os_errno_obj, 0, 1, mod_os_errno);
 
+#if MICROPY_STREAMS_SENDFILE
+// sendfile(dest, src, count=-1): copy count bytes (default: until EOF) from
+// the src stream to the dest stream.  When both streams expose a file
+// descriptor and src is a regular file this uses the sendfile(2) zero-copy
+// path, otherwise it falls back to the generic buffered stream copy.
+STATIC mp_obj_t mod_os_sendfile(size_t n_args, const mp_obj_t *args) {
+    #if defined(__linux__)
+    const mp_stream_p_t *dest_p = mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
+    const mp_stream_p_t *src_p = mp_get_stream_raise(args[1], MP_STREAM_OP_READ | MP_STREAM_OP_IOCTL);
+    int error;
+    mp_uint_t dest_fd = dest_p->ioctl(args[0], MP_STREAM_GET_FILENO, 0, &error);
+    mp_uint_t src_fd = src_p->ioctl(args[1], MP_STREAM_GET_FILENO, 0, &error);
+    struct stat st;
+    if (dest_fd != MP_STREAM_ERROR && src_fd != MP_STREAM_ERROR
+        && fstat(src_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        mp_uint_t limit = (mp_uint_t)-1;
+        if (n_args == 3) {
+            mp_int_t count = mp_obj_get_int(args[2]);
+            if (count >= 0) {
+                limit = count;
+            }
+        }
+        mp_uint_t total = 0;
+        while (total < limit) {
+            size_t chunk = 0x100000; // 1MiB per syscall so Ctrl-C stays responsive
+            if (limit - total < chunk) {
+                chunk = limit - total;
+            }
+            MP_THREAD_GIL_EXIT();
+            ssize_t n = sendfile(dest_fd, src_fd, NULL, chunk);
+            MP_THREAD_GIL_ENTER();
+            if (n < 0) {
+                if (total == 0 && (errno == EINVAL || errno == ENOSYS)) {
+                    // This fd pairing isn't supported by the kernel; use the
+                    // generic copy instead.
+                    goto fallback;
+                }
+                if (errno == EAGAIN && total != 0) {
+                    break;
+                }
+                mp_raise_OSError(errno);
+            }
+            if (n == 0) {
+                // EOF on src
+                break;
+            }
+            total += n;
+        }
+        return mp_obj_new_int_from_uint(total);
+    }
+fallback:;
+    #endif
+    return mp_stream_sendfile(n_args, args);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_os_sendfile_obj, 2, 3, mod_os_sendfile);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_os_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uos) },
     { MP_ROM_QSTR(MP_QSTR_errno), MP_ROM_PTR(&mod_os_errno_obj) },
@@ -321,6 +383,9 @@ STATIC const mp_rom_map_elem_t mp_module_os_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_unsetenv), MP_ROM_PTR(&mod_os_unsetenv_obj) },
     { MP_ROM_QSTR(MP_QSTR_mkdir), MP_ROM_PTR(&mod_os_mkdir_obj) },
     { MP_ROM_QSTR(MP_QSTR_ilistdir), MP_ROM_PTR(&mod_os_ilistdir_obj) },
+    #if MICROPY_STREAMS_SENDFILE
+    { MP_ROM_QSTR(MP_QSTR_sendfile), MP_ROM_PTR(&mod_os_sendfile_obj) },
+    #endif
     #if MICROPY_PY_OS_DUPTERM
     { MP_ROM_QSTR(MP_QSTR_dupterm), MP_ROM_PTR(&mp_uos_dupterm_obj) },
     #endif
@@ -31,6 +31,7 @@
 #include "extmod/vfs_posix.h"
 #include "extmod/vfs_fat.h"
 #include "extmod/vfs_lfs.h"
+#include "extmod/vfs_bundle.h"
 
 #if MICROPY_VFS
 
@@ -82,6 +83,9 @@ STATIC const mp_rom_map_elem_t uos_vfs_module_globals_table[] = {
     #if MICROPY_VFS_LFS2
     { MP_ROM_QSTR(MP_QSTR_VfsLfs2), MP_ROM_PTR(&mp_type_vfs_lfs2) },
     #endif
+    #if MICROPY_VFS_BUNDLE
+    { MP_ROM_QSTR(MP_QSTR_VfsBundle), MP_ROM_PTR(&mp_type_vfs_bundle) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(uos_vfs_module_globals, uos_vfs_module_globals_table);
@@ -36,6 +36,10 @@
 #include <stdio.h>
 #include <errno.h>
 #include <poll.h>
+#if MICROPY_PY_USELECT_EPOLL
+#include <unistd.h>
+#include <sys/epoll.h>
+#endif
 
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -67,8 +71,38 @@ typedef struct _mp_obj_poll_t {
     int flags;
     // callee-owned tuple
     mp_obj_t ret_tuple;
+    #if MICROPY_PY_USELECT_EPOLL
+    // The kernel pushes ready fds into evs, so returning results doesn't
+    // need to re-scan all registered entries.  Each epoll event carries the
+    // index of its entry in entries/obj_map.
+    int epoll_fd;
+    struct epoll_event *evs;
+    #endif
 } mp_obj_poll_t;
 
+#if MICROPY_PY_USELECT_EPOLL
+
+// Note: the code below passes poll() event masks straight to epoll and
+// back; on Linux EPOLLIN/EPOLLOUT/EPOLLERR/EPOLLHUP have the same values
+// as their poll() counterparts.
+
+STATIC void poll_epoll_ctl(mp_obj_poll_t *self, int op, int fd, uint32_t events, uint32_t idx) {
+    struct epoll_event ev = { .events = events, .data = { .u32 = idx } };
+    if (epoll_ctl(self->epoll_fd, op, fd, &ev) == -1) {
+        mp_raise_OSError(errno);
+    }
+}
+
+// Implements FLAG_ONESHOT: stop the kernel reporting this entry until its
+// events are set again (POLLERR/POLLHUP are still reported, as with poll()).
+STATIC void poll_epoll_oneshot(mp_obj_poll_t *self, uint32_t idx) {
+    self->entries[idx].events = 0;
+    struct epoll_event ev = { .events = 0, .data = { .u32 = idx } };
+    epoll_ctl(self->epoll_fd, EPOLL_CTL_MOD, self->entries[idx].fd, &ev);
+}
+
+#endif
+
 STATIC int get_fd(mp_obj_t fdlike) {
     if (mp_obj_is_obj(fdlike)) {
         const mp_stream_p_t *stream_p = mp_get_stream_raise(fdlike, MP_STREAM_OP_IOCTL);
@@ -101,6 +135,9 @@ STATIC mp_obj_t poll_register(size_t n_args, const mp_obj_t *args) {
         int entry_fd = entry->fd;
         if (entry_fd == fd) {
             entry->events = flags;
+            #if MICROPY_PY_USELECT_EPOLL
+            poll_epoll_ctl(self, EPOLL_CTL_MOD, fd, flags, entry - self->entries);
+            #endif
             return mp_const_false;
         }
         if (entry_fd == -1) {
@@ -114,6 +151,9 @@ STATIC mp_obj_t poll_register(size_t n_args, const mp_obj_t *args) {
             if (self->obj_map) {
                 self->obj_map = m_renew(mp_obj_t, self->obj_map, self->alloc, self->alloc + 4);
             }
+            #if MICROPY_PY_USELECT_EPOLL
+            self->evs = m_renew(struct epoll_event, self->evs, self->alloc, self->alloc + 4);
+            #endif
             self->alloc += 4;
         }
         free_slot = &self->entries[self->len++];
@@ -129,6 +169,9 @@ STATIC mp_obj_t poll_register(size_t n_args, const mp_obj_t *args) {
     free_slot->fd = fd;
     free_slot->events = flags;
     free_slot->revents = 0;
+    #if MICROPY_PY_USELECT_EPOLL
+    poll_epoll_ctl(self, EPOLL_CTL_ADD, fd, flags, free_slot - self->entries);
+    #endif
     return mp_const_true;
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(poll_register_obj, 2, 3, poll_register);
@@ -140,6 +183,12 @@ STATIC mp_obj_t poll_unregister(mp_obj_t self_in, mp_obj_t obj_in) {
     int fd = get_fd(obj_in);
     for (int i = self->len - 1; i >= 0; i--) {
         if (entries->fd == fd) {
+            #if MICROPY_PY_USELECT_EPOLL
+            // ignore errors: the fd may have been closed already, in which
+            // case the kernel dropped it from the epoll set itself
+            struct epoll_event ev;
+            epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+            #endif
             entries->fd = -1;
             if (self->obj_map) {
                 self->obj_map[entries - self->entries] = MP_OBJ_NULL;
@@ -162,6 +211,9 @@ STATIC mp_obj_t poll_modify(mp_obj_t self_in, mp_obj_t obj_in, mp_obj_t eventmas
     for (int i = self->len - 1; i >= 0; i--) {
         if (entries->fd == fd) {
             entries->events = mp_obj_get_int(eventmask_in);
+            #if MICROPY_PY_USELECT_EPOLL
+            poll_epoll_ctl(self, EPOLL_CTL_MOD, fd, entries->events, entries - self->entries);
+            #endif
             return mp_const_none;
         }
         entries++;
@@ -193,7 +245,11 @@ STATIC int poll_poll_internal(size_t n_args, const mp_obj_t *args) {
     self->flags = flags;
 
     int n_ready;
+    #if MICROPY_PY_USELECT_EPOLL
+    MP_HAL_RETRY_SYSCALL(n_ready, epoll_wait(self->epoll_fd, self->evs, self->alloc, timeout), mp_raise_OSError(err));
+    #else
     MP_HAL_RETRY_SYSCALL(n_ready, poll(self->entries, self->len, timeout), mp_raise_OSError(err));
+    #endif
     return n_ready;
 }
 
@@ -209,6 +265,24 @@ STATIC mp_obj_t poll_poll(size_t n_args, const mp_obj_t *args) {
     mp_obj_poll_t *self = MP_OBJ_TO_PTR(args[0]);
 
     mp_obj_list_t *ret_list = MP_OBJ_TO_PTR(mp_obj_new_list(n_ready, NULL));
+    #if MICROPY_PY_USELECT_EPOLL
+    // the kernel delivered just the ready entries; no need to scan the rest
+    for (int i = 0; i < n_ready; i++) {
+        uint32_t idx = self->evs[i].data.u32;
+        mp_obj_tuple_t *t = MP_OBJ_TO_PTR(mp_obj_new_tuple(2, NULL));
+        // If there's an object stored, return it, otherwise raw fd
+        if (self->obj_map && self->obj_map[idx] != MP_OBJ_NULL) {
+            t->items[0] = self->obj_map[idx];
+        } else {
+            t->items[0] = MP_OBJ_NEW_SMALL_INT(self->entries[idx].fd);
+        }
+        t->items[1] = MP_OBJ_NEW_SMALL_INT(self->evs[i].events);
+        ret_list->items[i] = MP_OBJ_FROM_PTR(t);
+        if (self->flags & FLAG_ONESHOT) {
+            poll_epoll_oneshot(self, idx);
+        }
+    }
+    #else
     int ret_i = 0;
     struct pollfd *entries = self->entries;
     for (int i = 0; i < self->len; i++, entries++) {
@@ -227,6 +301,7 @@ STATIC mp_obj_t poll_poll(size_t n_args, const mp_obj_t *args) {
             }
         }
     }
+    #endif
 
     return MP_OBJ_FROM_PTR(ret_list);
 }
@@ -256,6 +331,22 @@ STATIC mp_obj_t poll_iternext(mp_obj_t self_in) {
 
     self->iter_cnt--;
 
+    #if MICROPY_PY_USELECT_EPOLL
+    struct epoll_event *ev = &self->evs[self->iter_idx++];
+    uint32_t idx = ev->data.u32;
+    mp_obj_tuple_t *t = MP_OBJ_TO_PTR(self->ret_tuple);
+    // If there's an object stored, return it, otherwise raw fd
+    if (self->obj_map && self->obj_map[idx] != MP_OBJ_NULL) {
+        t->items[0] = self->obj_map[idx];
+    } else {
+        t->items[0] = MP_OBJ_NEW_SMALL_INT(self->entries[idx].fd);
+    }
+    t->items[1] = MP_OBJ_NEW_SMALL_INT(ev->events);
+    if (self->flags & FLAG_ONESHOT) {
+        poll_epoll_oneshot(self, idx);
+    }
+    return MP_OBJ_FROM_PTR(t);
+    #else
     struct pollfd *entries = self->entries + self->iter_idx;
     for (int i = self->iter_idx; i < self->len; i++, entries++) {
         self->iter_idx++;
@@ -278,7 +369,20 @@ STATIC mp_obj_t poll_iternext(mp_obj_t self_in) {
     assert(!"inconsistent number of poll active entries");
     self->iter_cnt = 0;
     return MP_OBJ_STOP_ITERATION;
+    #endif
+}
+
+#if MICROPY_PY_USELECT_EPOLL
+STATIC mp_obj_t poll_close(mp_obj_t self_in) {
+    mp_obj_poll_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->epoll_fd != -1) {
+        close(self->epoll_fd);
+        self->epoll_fd = -1;
+    }
+    return mp_const_none;
 }
+MP_DEFINE_CONST_FUN_OBJ_1(poll_close_obj, poll_close);
+#endif
 
 #if DEBUG
 STATIC mp_obj_t poll_dump(mp_obj_t self_in) {
@@ -305,6 +409,10 @@ STATIC const mp_rom_map_elem_t poll_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_modify), MP_ROM_PTR(&poll_modify_obj) },
     { MP_ROM_QSTR(MP_QSTR_poll), MP_ROM_PTR(&poll_poll_obj) },
     { MP_ROM_QSTR(MP_QSTR_ipoll), MP_ROM_PTR(&poll_ipoll_obj) },
+    #if MICROPY_PY_USELECT_EPOLL
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&poll_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&poll_close_obj) },
+    #endif
     #if DEBUG
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&poll_dump_obj) },
     #endif
@@ -324,7 +432,14 @@ STATIC mp_obj_t select_poll(size_t n_args, const mp_obj_t *args) {
     if (n_args > 0) {
         alloc = mp_obj_get_int(args[0]);
     }
+    #if MICROPY_PY_USELECT_EPOLL
+    if (alloc < 1) {
+        alloc = 1;
+    }
+    mp_obj_poll_t *poll = m_new_obj_with_finaliser(mp_obj_poll_t);
+    #else
     mp_obj_poll_t *poll = m_new_obj(mp_obj_poll_t);
+    #endif
     poll->base.type = &mp_type_poll;
     poll->entries = m_new(struct pollfd, alloc);
     poll->alloc = alloc;
@@ -332,6 +447,13 @@ STATIC mp_obj_t select_poll(size_t n_args, const mp_obj_t *args) {
     poll->obj_map = NULL;
     poll->iter_cnt = 0;
     poll->ret_tuple = MP_OBJ_NULL;
+    #if MICROPY_PY_USELECT_EPOLL
+    poll->epoll_fd = epoll_create(alloc);
+    if (poll->epoll_fd == -1) {
+        mp_raise_OSError(errno);
+    }
+    poll->evs = m_new(struct epoll_event, alloc);
+    #endif
     return MP_OBJ_FROM_PTR(poll);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_select_poll_obj, 0, 1, select_poll);
@@ -33,6 +33,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
@@ -124,6 +125,23 @@ STATIC mp_uint_t socket_write(mp_obj_t o_in, const void *buf, mp_uint_t size, in
     return (mp_uint_t)r;
 }
 
+#if MICROPY_STREAMS_WRITEV
+STATIC mp_uint_t socket_writev(mp_obj_t o_in, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode) {
+    mp_obj_socket_t *o = MP_OBJ_TO_PTR(o_in);
+    ssize_t r;
+    // mp_stream_iovec_t is layout-compatible with struct iovec
+    MP_HAL_RETRY_SYSCALL(r, writev(o->fd, (const struct iovec *)iov, iovcnt), {
+        if (err == EAGAIN && o->blocking) {
+            err = MP_ETIMEDOUT;
+        }
+
+        *errcode = err;
+        return MP_STREAM_ERROR;
+    });
+    return (mp_uint_t)r;
+}
+#endif
+
 STATIC mp_uint_t socket_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
     mp_obj_socket_t *self = MP_OBJ_TO_PTR(o_in);
     (void)arg;
@@ -252,6 +270,34 @@ STATIC mp_obj_t socket_recv(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(socket_recv_obj, 2, 3, socket_recv);
 
+// Like recv() but receives into a caller-supplied buffer, avoiding the
+// allocation (and copy into) of an intermediate bytes object.
+STATIC mp_obj_t socket_recv_into(size_t n_args, const mp_obj_t *args) {
+    mp_obj_socket_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
+    size_t sz = bufinfo.len;
+    int flags = 0;
+
+    if (n_args > 2) {
+        mp_int_t nbytes = MP_OBJ_SMALL_INT_VALUE(args[2]);
+        if (nbytes != 0) {
+            if ((size_t)nbytes > bufinfo.len) {
+                mp_raise_ValueError(MP_ERROR_TEXT("nbytes exceeds buffer length"));
+            }
+            sz = nbytes;
+        }
+        if (n_args > 3) {
+            flags = MP_OBJ_SMALL_INT_VALUE(args[3]);
+        }
+    }
+
+    ssize_t out_sz;
+    MP_HAL_RETRY_SYSCALL(out_sz, recv(self->fd, bufinfo.buf, sz, flags), mp_raise_OSError(err));
+    return MP_OBJ_NEW_SMALL_INT(out_sz);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(socket_recv_into_obj, 2, 4, socket_recv_into);
+
 STATIC mp_obj_t socket_recvfrom(size_t n_args, const mp_obj_t *args) {
     mp_obj_socket_t *self = MP_OBJ_TO_PTR(args[0]);
     int sz = MP_OBJ_SMALL_INT_VALUE(args[1]);
@@ -460,11 +506,15 @@ STATIC const mp_rom_map_elem_t usocket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
     { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    #if MICROPY_STREAMS_WRITEV
+    { MP_ROM_QSTR(MP_QSTR_writev), MP_ROM_PTR(&mp_stream_writev_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_connect), MP_ROM_PTR(&socket_connect_obj) },
     { MP_ROM_QSTR(MP_QSTR_bind), MP_ROM_PTR(&socket_bind_obj) },
     { MP_ROM_QSTR(MP_QSTR_listen), MP_ROM_PTR(&socket_listen_obj) },
     { MP_ROM_QSTR(MP_QSTR_accept), MP_ROM_PTR(&socket_accept_obj) },
     { MP_ROM_QSTR(MP_QSTR_recv), MP_ROM_PTR(&socket_recv_obj) },
+    { MP_ROM_QSTR(MP_QSTR_recv_into), MP_ROM_PTR(&socket_recv_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_recvfrom), MP_ROM_PTR(&socket_recvfrom_obj) },
     { MP_ROM_QSTR(MP_QSTR_send), MP_ROM_PTR(&socket_send_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendto), MP_ROM_PTR(&socket_sendto_obj) },
@@ -480,6 +530,9 @@ STATIC const mp_stream_p_t usocket_stream_p = {
     .read = socket_read,
     .write = socket_write,
     .ioctl = socket_ioctl,
+    #if MICROPY_STREAMS_WRITEV
+    .writev = socket_writev,
+    #endif
 };
 
 const mp_obj_type_t mp_type_socket = {
@@ -55,6 +55,15 @@
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (1)
 #define MICROPY_COMP_RETURN_IF_EXPR (1)
 #define MICROPY_ENABLE_GC           (1)
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define MICROPY_GC_THREAD_BLOCK_CACHE (1)
+#define MICROPY_PY_THREAD_SAFE_CONTAINERS (1)
+#endif
+#define MICROPY_PY_THREAD_POOL      (MICROPY_PY_THREAD)
+// takes effect in the variants that enable the scheduler
+#define MICROPY_SCHEDULER_LOCKFREE  (1)
+#define MICROPY_LAZY_EXC_MSG        (1)
+#define MICROPY_PREALLOC_EXC        (1)
 #define MICROPY_ENABLE_FINALISER    (1)
 #define MICROPY_STACK_CHECK         (1)
 #define MICROPY_MALLOC_USES_ALLOCATED_SIZE (1)
@@ -64,10 +73,13 @@
 // check stdout a chance to pass, etc.
 #define MICROPY_DEBUG_PRINTER       (&mp_stderr_print)
 #define MICROPY_READER_POSIX        (1)
+#define MICROPY_READER_POSIX_MMAP   (1)
 #define MICROPY_USE_READLINE_HISTORY (1)
 #define MICROPY_HELPER_REPL         (1)
 #define MICROPY_REPL_EMACS_KEYS     (1)
 #define MICROPY_REPL_AUTO_INDENT    (1)
+#define MICROPY_REPL_BRACKETED_PASTE (1)
+#define MICROPY_REPL_HIST_SEARCH    (1)
 #define MICROPY_HELPER_LEXER_UNIX   (1)
 #define MICROPY_ENABLE_SOURCE_LINE  (1)
 #ifndef MICROPY_FLOAT_IMPL
@@ -78,7 +90,11 @@
 #define MICROPY_STREAMS_NON_BLOCK   (1)
 #endif
 #define MICROPY_STREAMS_POSIX_API   (1)
+#define MICROPY_STREAMS_WRITEV      (1)
+#define MICROPY_STREAMS_SENDFILE    (1)
 #define MICROPY_OPT_COMPUTED_GOTO   (1)
+#define MICROPY_OPT_PRINT_BATCHING  (1)
+#define MICROPY_OPT_LIST_SORT_STABLE (1)
 #ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (1)
 #endif
@@ -142,25 +158,49 @@
 #define MICROPY_PY_UTIME_MP_HAL     (1)
 #define MICROPY_PY_UERRNO           (1)
 #define MICROPY_PY_UCTYPES          (1)
+#define MICROPY_PY_UCTYPES_ATTR_CACHE (1)
 #define MICROPY_PY_UZLIB            (1)
+#define MICROPY_PY_UZLIB_COMPRESS   (1)
 #define MICROPY_PY_UJSON            (1)
+#define MICROPY_PY_UJSON_TOKENIZE   (1)
 #define MICROPY_PY_URE              (1)
+#define MICROPY_PY_URE_CACHE_SIZE   (8)
+#define MICROPY_PY_URE_FINDITER     (1)
+#define MICROPY_PY_URE_PIKEVM       (1)
 #define MICROPY_PY_UHEAPQ           (1)
+#define MICROPY_PY_UPARALLEL        (MICROPY_PY_THREAD)
+#define MICROPY_PY_NETUTILS         (1)
+#define MICROPY_PY_ULOG             (1)
 #define MICROPY_PY_UTIMEQ           (1)
+// uasyncio's ThreadSafeQueue, with a pipe wakeup since the poller here
+// blocks on real file descriptors (only built if a variant enables uasyncio)
+#define MICROPY_PY_UASYNCIO_TSQUEUE (1)
+#define MICROPY_PY_UASYNCIO_TSQUEUE_PIPE (1)
 #define MICROPY_PY_UHASHLIB         (1)
+#define MICROPY_PY_UHASHLIB_UPDATE_FROM (1)
 #if MICROPY_PY_USSL
 #define MICROPY_PY_UHASHLIB_MD5     (1)
 #define MICROPY_PY_UHASHLIB_SHA1    (1)
 #define MICROPY_PY_UCRYPTOLIB       (1)
 #endif
 #define MICROPY_PY_UBINASCII        (1)
+#define MICROPY_PY_UBINASCII_HEXLIFY_INTO (1)
 #define MICROPY_PY_UBINASCII_CRC32  (1)
 #define MICROPY_PY_URANDOM          (1)
 #ifndef MICROPY_PY_USELECT_POSIX
 #define MICROPY_PY_USELECT_POSIX    (1)
 #endif
+// Use the Linux epoll backend for uselect, so the kernel pushes ready fds
+// instead of every registered entry being re-scanned per poll call.  Off by
+// default because epoll can't watch regular files and won't report POLLNVAL
+// for an fd closed while registered.
+#ifndef MICROPY_PY_USELECT_EPOLL
+#define MICROPY_PY_USELECT_EPOLL    (0)
+#endif
 #define MICROPY_PY_UWEBSOCKET       (1)
 #define MICROPY_PY_MACHINE          (1)
+#define MICROPY_PY_MACHINE_ATOMIC   (1)
+#define MICROPY_PY_MACHINE_PINGROUP (1)
 #define MICROPY_PY_MACHINE_PULSE    (1)
 #define MICROPY_MACHINE_MEM_GET_READ_ADDR   mod_machine_mem_get_addr
 #define MICROPY_MACHINE_MEM_GET_WRITE_ADDR  mod_machine_mem_get_addr
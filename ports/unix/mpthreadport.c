@@ -235,6 +235,13 @@ void mp_thread_create(void *(*entry)(void *), void *arg, size_t *stack_size) {
         goto er;
     }
 
+    // adjust stack_size to provide room to recover from hitting the limit;
+    // this must be done before the thread is created because the new thread
+    // reads *stack_size to set its stack limit, and doing it afterwards races
+    // with that (losing the race means the limit check can never trigger
+    // before the stack really overflows)
+    *stack_size -= THREAD_STACK_OVERFLOW_MARGIN;
+
     mp_thread_unix_begin_atomic_section();
 
     // create thread
@@ -245,9 +252,6 @@ void mp_thread_create(void *(*entry)(void *), void *arg, size_t *stack_size) {
         goto er;
     }
 
-    // adjust stack_size to provide room to recover from hitting the limit
-    *stack_size -= THREAD_STACK_OVERFLOW_MARGIN;
-
     // add thread to linked list of all threads
     thread_t *th = malloc(sizeof(thread_t));
     th->id = id;
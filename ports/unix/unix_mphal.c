@@ -103,12 +103,14 @@ void mp_hal_stdio_mode_raw(void) {
     termios.c_lflag = 0;
     termios.c_cc[VMIN] = 1;
     termios.c_cc[VTIME] = 0;
-    tcsetattr(0, TCSAFLUSH, &termios);
+    // TCSADRAIN, not TCSAFLUSH, so input typed (or pasted) ahead while a
+    // statement executes is not discarded by the mode change
+    tcsetattr(0, TCSADRAIN, &termios);
 }
 
 void mp_hal_stdio_mode_orig(void) {
     // restore terminal settings
-    tcsetattr(0, TCSAFLUSH, &orig_termios);
+    tcsetattr(0, TCSADRAIN, &orig_termios);
 }
 
 #endif
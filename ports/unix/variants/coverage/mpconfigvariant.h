@@ -34,11 +34,14 @@
 #define MICROPY_OPT_MATH_FACTORIAL     (1)
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (1)
 #define MICROPY_ENABLE_SCHEDULER       (1)
+#define MICROPY_SCHEDULER_PRIORITY     (1)
 #define MICROPY_READER_VFS             (1)
 #define MICROPY_REPL_EMACS_WORDS_MOVE  (1)
 #define MICROPY_REPL_EMACS_EXTRA_WORDS_MOVE (1)
 #define MICROPY_WARNINGS_CATEGORY      (1)
 #define MICROPY_MODULE_GETATTR         (1)
+#define MICROPY_MODULE_BUILTIN_INIT    (1)
+#define MICROPY_MODULE_DEFER_BUILTIN_INIT (1)
 #define MICROPY_PY_DELATTR_SETATTR     (1)
 #define MICROPY_PY_ALL_INPLACE_SPECIAL_METHODS (1)
 #define MICROPY_PY_REVERSE_SPECIAL_METHODS (1)
@@ -58,11 +61,15 @@
 #define MICROPY_PY_URE_MATCH_SPAN_START_END (1)
 #define MICROPY_PY_URE_SUB             (1)
 #define MICROPY_VFS_POSIX              (1)
+#define MICROPY_VFS_BUNDLE             (1)
 #define MICROPY_PY_FRAMEBUF            (1)
+#define MICROPY_PY_FRAMEBUF_DIRTY      (1)
 #define MICROPY_PY_COLLECTIONS_NAMEDTUPLE__ASDICT (1)
 #define MICROPY_PY_UCRYPTOLIB          (1)
 #define MICROPY_PY_UCRYPTOLIB_CTR      (1)
 #define MICROPY_PY_MICROPYTHON_HEAP_LOCKED (1)
+#define MICROPY_PY_WEBREPL             (1)
+#define MICROPY_TRACE                  (1)
 
 // use vfs's functions for import stat and builtin open
 #define mp_import_stat mp_vfs_import_stat
@@ -232,6 +232,9 @@ STATIC mp_obj_t machine_pin_irq(size_t n_args, const mp_obj_t *pos_args, mp_map_
             mp_raise_OSError(-ret);
         }
 
+        if (args[ARG_hard].u_bool) {
+            mp_irq_check_hard_handler(args[ARG_handler].u_obj);
+        }
         self->irq->base.handler = args[ARG_handler].u_obj;
         self->irq->base.ishard = args[ARG_hard].u_bool;
 
@@ -76,8 +76,32 @@ void mp_arg_check_num_sig(size_t n_args, size_t n_kw, uint32_t sig) {
     }
 }
 
+// Look up the given qstr in the kwargs map by scanning its slots, starting at
+// *scan and remembering where the match was found.  Callers almost always pass
+// keywords in the same order as the allowed_args table declares them, so
+// successive lookups usually hit on the first probe instead of rescanning the
+// whole table (mp_map_lookup restarts from slot 0 on a fixed table each time).
+STATIC mp_map_elem_t *mp_arg_lookup_kw(mp_map_t *kws, qstr qst, size_t *scan) {
+    mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
+    size_t j = *scan;
+    for (size_t n = 0; n < kws->alloc; n++, j++) {
+        if (j >= kws->alloc) {
+            j = 0;
+        }
+        mp_map_elem_t *elem = &kws->table[j];
+        // As in mp_map_lookup, non-qstr keys (from a **dict of uninterned
+        // strings) fall back to a full equality check.
+        if (mp_map_slot_is_filled(kws, j) && (elem->key == key || mp_obj_equal(elem->key, key))) {
+            *scan = j + 1;
+            return elem;
+        }
+    }
+    return NULL;
+}
+
 void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n_allowed, const mp_arg_t *allowed, mp_arg_val_t *out_vals) {
     size_t pos_found = 0, kws_found = 0;
+    size_t kws_scan = 0;
     for (size_t i = 0; i < n_allowed; i++) {
         mp_obj_t given_arg;
         if (i < n_pos) {
@@ -87,7 +111,12 @@ void mp_arg_parse_all(size_t n_pos, const mp_obj_t *pos, mp_map_t *kws, size_t n
             pos_found++;
             given_arg = pos[i];
         } else {
-            mp_map_elem_t *kw = mp_map_lookup(kws, MP_OBJ_NEW_QSTR(allowed[i].qst), MP_MAP_LOOKUP);
+            mp_map_elem_t *kw = NULL;
+            if (kws_found < kws->used) {
+                // Only scan while some given kwargs remain unmatched, so the
+                // (common) trailing run of defaulted args costs no lookups.
+                kw = mp_arg_lookup_kw(kws, allowed[i].qst, &kws_scan);
+            }
             if (kw == NULL) {
                 if (allowed[i].flags & MP_ARG_REQUIRED) {
                     #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
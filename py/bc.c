@@ -140,6 +140,19 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     code_state->sp = &code_state->state[0] - 1;
     code_state->exc_sp_idx = 0;
 
+    // Fast path for the most common kind of call: exactly the right number of
+    // positional arguments, no keyword arguments, and nothing special about
+    // the function signature.  The caller's values go straight into the top
+    // of the state and only the remaining slots need to be zeroed.
+    if (n_kw == 0 && n_args == n_pos_args && n_kwonly_args == 0
+        && (scope_flags & (MP_SCOPE_FLAG_VARARGS | MP_SCOPE_FLAG_VARKEYWORDS | MP_SCOPE_FLAG_DEFKWARGS)) == 0) {
+        for (size_t i = 0; i < n_args; i++) {
+            code_state->state[n_state - 1 - i] = args[i];
+        }
+        memset(code_state->state, 0, (n_state - n_args) * sizeof(*code_state->state));
+        goto prelude_size;
+    }
+
     // zero out the local stack to begin with
     memset(code_state->state, 0, n_state * sizeof(*code_state->state));
 
@@ -197,16 +210,28 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
         // get pointer to arg_names array
         const mp_obj_t *arg_names = (const mp_obj_t *)self->const_table;
 
+        // Keyword arguments are almost always passed in declaration order, so
+        // resume each scan of arg_names just after the previous match (with
+        // wrap-around); then the common case needs only one comparison per
+        // keyword instead of a full linear scan.
+        const size_t n_arg_names = n_pos_args + n_kwonly_args;
+        size_t j_prev = 0;
+
         for (size_t i = 0; i < n_kw; i++) {
             // the keys in kwargs are expected to be qstr objects
             mp_obj_t wanted_arg_name = kwargs[2 * i];
-            for (size_t j = 0; j < n_pos_args + n_kwonly_args; j++) {
+            for (size_t jj = 0; jj < n_arg_names; jj++) {
+                size_t j = j_prev + jj;
+                if (j >= n_arg_names) {
+                    j -= n_arg_names;
+                }
                 if (wanted_arg_name == arg_names[j]) {
                     if (code_state->state[n_state - 1 - j] != MP_OBJ_NULL) {
                         mp_raise_msg_varg(&mp_type_TypeError,
                             MP_ERROR_TEXT("function got multiple values for argument '%q'"), MP_OBJ_QSTR_VALUE(wanted_arg_name));
                     }
                     code_state->state[n_state - 1 - j] = kwargs[2 * i + 1];
+                    j_prev = j + 1;
                     goto continue2;
                 }
             }
@@ -274,6 +299,7 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     }
 
     // read the size part of the prelude
+    prelude_size:;
     const byte *ip = code_state->ip;
     MP_BC_PRELUDE_SIZE_DECODE(ip);
 
@@ -300,15 +326,16 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     dump_args(code_state->state, n_state);
 }
 
-#if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE
+#if MICROPY_PERSISTENT_CODE_LOAD || MICROPY_PERSISTENT_CODE_SAVE || MICROPY_OPT_VM_SUPERINSTRUCTIONS
 
 // The following table encodes the number of bytes that a specific opcode
 // takes up.  Some opcodes have an extra byte, defined by MP_BC_MASK_EXTRA_BYTE.
-// There are 4 special opcodes that have an extra byte only when
+// There are 5 special opcodes that have an extra byte only when
 // MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE is enabled (and they take a qstr):
 //     MP_BC_LOAD_NAME
 //     MP_BC_LOAD_GLOBAL
 //     MP_BC_LOAD_ATTR
+//     MP_BC_LOAD_METHOD
 //     MP_BC_STORE_ATTR
 uint mp_opcode_format(const byte *ip, size_t *opcode_size, bool count_var_uint) {
     uint f = MP_BC_FORMAT(*ip);
@@ -318,6 +345,7 @@ uint mp_opcode_format(const byte *ip, size_t *opcode_size, bool count_var_uint)
             if (*ip == MP_BC_LOAD_NAME
                 || *ip == MP_BC_LOAD_GLOBAL
                 || *ip == MP_BC_LOAD_ATTR
+                || *ip == MP_BC_LOAD_METHOD
                 || *ip == MP_BC_STORE_ATTR) {
                 ip += 1;
             }
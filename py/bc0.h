@@ -56,7 +56,7 @@
 #define MP_BC_UNARY_OP_MULTI                (0xd0) // OOOOOOO
 #define MP_BC_BINARY_OP_MULTI               (0xd7) //        OOOOOOOOO
 //                                          (0xe0) // OOOOOOOOOOOOOOOO
-//                                          (0xf0) // OOOOOOOOOO------
+//                                          (0xf0) // OOOOOOOOOO-FFFF-
 
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM (64)
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS (16)
@@ -147,4 +147,15 @@
 #define MP_BC_IMPORT_FROM                   (MP_BC_BASE_QSTR_O + 0x0c) // qstr
 #define MP_BC_IMPORT_STAR                   (MP_BC_BASE_BYTE_E + 0x09)
 
+// These opcodes are never emitted by the compiler and never appear in .mpy
+// files; with MICROPY_OPT_VM_SUPERINSTRUCTIONS enabled they are created at
+// bytecode-load time by fusing hot opcode pairs in-place (see py/emitglue.c).
+// They live in the free space above MP_BC_BINARY_OP_MULTI and decode as
+// format BYTE; their extra operand bytes are known only to the VM.
+#define MP_BC_LOAD_FAST_LOAD_FAST           (0xfb) // byte holds two 4-bit local numbers
+#define MP_BC_LOAD_FAST_BINARY_OP           (0xfc) // byte holds 2-bit local number and 6-bit binary op
+#define MP_BC_BINARY_OP_POP_JUMP_IF_TRUE    (0xfd) // byte holds binary op; then rel byte code offset, 16-bit signed, in excess
+#define MP_BC_BINARY_OP_POP_JUMP_IF_FALSE   (0xfe) // byte holds binary op; then rel byte code offset, 16-bit signed, in excess
+#define MP_BC_BINARY_OP_STORE_FAST          (0xff) // byte holds two 4-bit source local numbers; then binary op byte; then dest local number byte
+
 #endif // MICROPY_INCLUDED_PY_BC0_H
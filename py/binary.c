@@ -216,24 +216,9 @@ long long mp_binary_get_int(size_t size, bool is_signed, bool big_endian, const
 }
 
 #define is_signed(typecode) (typecode > 'Z')
-mp_obj_t mp_binary_get_val(char struct_type, char val_type, byte *p_base, byte **ptr) {
-    byte *p = *ptr;
-    size_t align;
-
-    size_t size = mp_binary_get_size(struct_type, val_type, &align);
-    if (struct_type == '@') {
-        // Align p relative to p_base
-        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
-        #if MP_ENDIANNESS_LITTLE
-        struct_type = '<';
-        #else
-        struct_type = '>';
-        #endif
-    }
-    *ptr = p + size;
-
-    long long val = mp_binary_get_int(size, is_signed(val_type), (struct_type == '>'), p);
 
+// Convert a raw value, as read by mp_binary_get_int, to an object
+STATIC mp_obj_t mp_binary_make_obj(char val_type, long long val) {
     if (val_type == 'O') {
         return (mp_obj_t)(mp_uint_t)val;
     } else if (val_type == 'S') {
@@ -266,6 +251,52 @@ mp_obj_t mp_binary_get_val(char struct_type, char val_type, byte *p_base, byte *
     }
 }
 
+mp_obj_t mp_binary_get_val(char struct_type, char val_type, byte *p_base, byte **ptr) {
+    byte *p = *ptr;
+    size_t align;
+
+    size_t size = mp_binary_get_size(struct_type, val_type, &align);
+    if (struct_type == '@') {
+        // Align p relative to p_base
+        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
+        #if MP_ENDIANNESS_LITTLE
+        struct_type = '<';
+        #else
+        struct_type = '>';
+        #endif
+    }
+    *ptr = p + size;
+
+    return mp_binary_make_obj(val_type, mp_binary_get_int(size, is_signed(val_type), (struct_type == '>'), p));
+}
+
+// Bulk version of mp_binary_get_val: convert n homogeneous elements in one
+// call, resolving the element size, alignment and byte order only once.
+// For '@' formats the native element size is a multiple of its alignment,
+// so aligning once before the run keeps every element aligned.
+void mp_binary_get_val_n(char struct_type, char val_type, size_t n, byte *p_base, byte **ptr, mp_obj_t *dest) {
+    byte *p = *ptr;
+    size_t align;
+
+    size_t size = mp_binary_get_size(struct_type, val_type, &align);
+    if (struct_type == '@') {
+        // Align p relative to p_base
+        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
+        #if MP_ENDIANNESS_LITTLE
+        struct_type = '<';
+        #else
+        struct_type = '>';
+        #endif
+    }
+
+    bool sgn = is_signed(val_type);
+    bool big_endian = struct_type == '>';
+    for (size_t i = 0; i < n; i++, p += size) {
+        dest[i] = mp_binary_make_obj(val_type, mp_binary_get_int(size, sgn, big_endian, p));
+    }
+    *ptr = p;
+}
+
 void mp_binary_set_int(size_t val_sz, bool big_endian, byte *dest, mp_uint_t val) {
     if (MP_ENDIANNESS_LITTLE && !big_endian) {
         memcpy(dest, &val, val_sz);
@@ -285,22 +316,9 @@ void mp_binary_set_int(size_t val_sz, bool big_endian, byte *dest, mp_uint_t val
     }
 }
 
-void mp_binary_set_val(char struct_type, char val_type, mp_obj_t val_in, byte *p_base, byte **ptr) {
-    byte *p = *ptr;
-    size_t align;
-
-    size_t size = mp_binary_get_size(struct_type, val_type, &align);
-    if (struct_type == '@') {
-        // Align p relative to p_base
-        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
-        if (MP_ENDIANNESS_LITTLE) {
-            struct_type = '<';
-        } else {
-            struct_type = '>';
-        }
-    }
-    *ptr = p + size;
-
+// Store an object as a raw value at p; struct_type must be resolved to
+// '<' or '>' and size must come from mp_binary_get_size
+STATIC void mp_binary_set_from_obj(char struct_type, char val_type, size_t size, mp_obj_t val_in, byte *p) {
     mp_uint_t val;
     switch (val_type) {
         case 'O':
@@ -355,6 +373,47 @@ void mp_binary_set_val(char struct_type, char val_type, mp_obj_t val_in, byte *p
     mp_binary_set_int(MIN((size_t)size, sizeof(val)), struct_type == '>', p, val);
 }
 
+void mp_binary_set_val(char struct_type, char val_type, mp_obj_t val_in, byte *p_base, byte **ptr) {
+    byte *p = *ptr;
+    size_t align;
+
+    size_t size = mp_binary_get_size(struct_type, val_type, &align);
+    if (struct_type == '@') {
+        // Align p relative to p_base
+        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
+        if (MP_ENDIANNESS_LITTLE) {
+            struct_type = '<';
+        } else {
+            struct_type = '>';
+        }
+    }
+    *ptr = p + size;
+
+    mp_binary_set_from_obj(struct_type, val_type, size, val_in, p);
+}
+
+// Bulk version of mp_binary_set_val; see mp_binary_get_val_n
+void mp_binary_set_val_n(char struct_type, char val_type, size_t n, byte *p_base, byte **ptr, const mp_obj_t *src) {
+    byte *p = *ptr;
+    size_t align;
+
+    size_t size = mp_binary_get_size(struct_type, val_type, &align);
+    if (struct_type == '@') {
+        // Align p relative to p_base
+        p = p_base + (uintptr_t)MP_ALIGN(p - p_base, align);
+        if (MP_ENDIANNESS_LITTLE) {
+            struct_type = '<';
+        } else {
+            struct_type = '>';
+        }
+    }
+
+    for (size_t i = 0; i < n; i++, p += size) {
+        mp_binary_set_from_obj(struct_type, val_type, size, src[i], p);
+    }
+    *ptr = p;
+}
+
 void mp_binary_set_val_array(char typecode, void *p, size_t index, mp_obj_t val_in) {
     switch (typecode) {
         #if MICROPY_PY_BUILTINS_FLOAT
@@ -35,6 +35,10 @@
 #include "py/runtime.h"
 #include "py/builtin.h"
 #include "py/frozenmod.h"
+#if MICROPY_MODULE_COMPILE_CACHE
+#include "py/reader.h"
+#include "py/stream.h"
+#endif
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
@@ -57,13 +61,33 @@ bool mp_obj_is_package(mp_obj_t module) {
 // Stat either frozen or normal module by a given path
 // (whatever is available, if at all).
 STATIC mp_import_stat_t mp_import_stat_any(const char *path) {
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    // Check the cache of previous results (including non-existence) before
+    // going to the filesystem, which may be slow to stat.
+    mp_obj_t cache = MP_STATE_VM(mp_import_stat_cache);
+    if (cache == MP_OBJ_NULL) {
+        cache = mp_obj_new_dict(8);
+        MP_STATE_VM(mp_import_stat_cache) = cache;
+    }
+    mp_map_t *cache_map = mp_obj_dict_get_map(cache);
+    mp_obj_t key = mp_obj_new_str(path, strlen(path));
+    mp_map_elem_t *elem = mp_map_lookup(cache_map, key, MP_MAP_LOOKUP);
+    if (elem != NULL) {
+        return MP_OBJ_SMALL_INT_VALUE(elem->value);
+    }
+    #endif
+    mp_import_stat_t st;
     #if MICROPY_MODULE_FROZEN
-    mp_import_stat_t st = mp_frozen_stat(path);
-    if (st != MP_IMPORT_STAT_NO_EXIST) {
-        return st;
+    st = mp_frozen_stat(path);
+    if (st == MP_IMPORT_STAT_NO_EXIST)
+    #endif
+    {
+        st = mp_import_stat(path);
     }
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    mp_map_lookup(cache_map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = MP_OBJ_NEW_SMALL_INT(st);
     #endif
-    return mp_import_stat(path);
+    return st;
 }
 
 STATIC mp_import_stat_t stat_file_py_or_mpy(vstr_t *path) {
@@ -142,12 +166,18 @@ STATIC void do_load_from_lexer(mp_obj_t module_obj, mp_lexer_t *lex) {
 }
 #endif
 
-#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY
+#if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY || MICROPY_MODULE_COMPILE_CACHE
 STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, const char *source_name) {
     (void)source_name;
 
     #if MICROPY_PY___FILE__
-    mp_store_attr(module_obj, MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(source_name)));
+    #if MICROPY_MODULE_LAZY
+    // a deferred module has its __file__ set at import time, not here
+    if (source_name != NULL)
+    #endif
+    {
+        mp_store_attr(module_obj, MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(source_name)));
+    }
     #endif
 
     // execute the module in its context
@@ -177,8 +207,94 @@ STATIC void do_execute_raw_code(mp_obj_t module_obj, mp_raw_code_t *raw_code, co
         nlr_jump(nlr.ret_val);
     }
 }
+
+#if MICROPY_MODULE_LAZY
+void mp_module_run_lazy(mp_obj_t module) {
+    mp_obj_module_t *self = MP_OBJ_TO_PTR(module);
+    const void *code = self->lazy_code;
+    // clear the pending code first so a recursive attribute access (eg by the
+    // module body importing itself) doesn't execute it twice
+    self->lazy_code = NULL;
+    #if MICROPY_MODULE_LAZY_MPY
+    if (mp_obj_is_qstr((mp_obj_t)code)) {
+        // a deferred .mpy file; load it from the filesystem now
+        mp_raw_code_t *raw_code = mp_raw_code_load_file(qstr_str(MP_OBJ_QSTR_VALUE((mp_obj_t)code)));
+        do_execute_raw_code(module, raw_code, NULL);
+        return;
+    }
+    #endif
+    do_execute_raw_code(module, (mp_raw_code_t *)code, NULL);
+}
+#endif
 #endif
 
+#if MICROPY_MODULE_COMPILE_CACHE
+// Hash the contents of a source file, with the same scheme as
+// qstr_compute_hash but over the whole file and without masking.
+STATIC uint32_t compile_cache_source_hash(const char *filename) {
+    mp_reader_t reader;
+    mp_reader_new_file(&reader, filename);
+    uint32_t hash = 5381;
+    for (mp_uint_t c; (c = reader.readbyte(reader.data)) != MP_READER_EOF;) {
+        hash = hash * 33 ^ c;
+    }
+    reader.close(reader.data);
+    return hash;
+}
+
+// Try to load and execute the cached code for a source file.  Returns false
+// without raising if the cache is missing, was built from different source
+// (hash mismatch), or can't be loaded (eg .mpy version/feature mismatch).
+STATIC bool do_load_from_cache(mp_obj_t module_obj, const char *cache_file, uint32_t source_hash, const char *source_name) {
+    mp_raw_code_t *raw_code;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_reader_t reader;
+        mp_reader_new_file(&reader, cache_file);
+        uint32_t stored_hash = 0;
+        for (int i = 0; i < 4; i++) {
+            mp_uint_t c = reader.readbyte(reader.data);
+            if (c == MP_READER_EOF) {
+                stored_hash = ~source_hash;
+                break;
+            }
+            stored_hash |= (uint32_t)c << (i * 8);
+        }
+        if (stored_hash != source_hash) {
+            reader.close(reader.data);
+            nlr_pop();
+            return false;
+        }
+        raw_code = mp_raw_code_load(&reader); // closes the reader
+        nlr_pop();
+    } else {
+        // stale or corrupt cache, or no cache at all; compile instead
+        return false;
+    }
+    do_execute_raw_code(module_obj, raw_code, source_name);
+    return true;
+}
+
+// Save freshly compiled code to the cache file.  Best-effort: any error
+// (eg read-only filesystem) is swallowed and the import continues.
+STATIC void do_save_to_cache(mp_raw_code_t *raw_code, const char *cache_file, uint32_t source_hash) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t open_args[2] = {
+            mp_obj_new_str(cache_file, strlen(cache_file)),
+            MP_OBJ_NEW_QSTR(MP_QSTR_wb),
+        };
+        mp_obj_t cache = mp_builtin_open(MP_ARRAY_SIZE(open_args), open_args, (mp_map_t *)&mp_const_empty_map);
+        char hash_bytes[4] = {source_hash & 0xff, (source_hash >> 8) & 0xff, (source_hash >> 16) & 0xff, (source_hash >> 24) & 0xff};
+        mp_stream_write_adaptor(MP_OBJ_TO_PTR(cache), hash_bytes, sizeof(hash_bytes));
+        mp_print_t print = {MP_OBJ_TO_PTR(cache), mp_stream_write_adaptor};
+        mp_raw_code_save(raw_code, &print);
+        mp_stream_close(cache);
+        nlr_pop();
+    }
+}
+#endif // MICROPY_MODULE_COMPILE_CACHE
+
 STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     #if MICROPY_MODULE_FROZEN || MICROPY_ENABLE_COMPILER || (MICROPY_PERSISTENT_CODE_LOAD && MICROPY_HAS_FILE_READER)
     char *file_str = vstr_null_terminated_str(file);
@@ -204,7 +320,16 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     // its data) in the list of frozen files, execute it.
     #if MICROPY_MODULE_FROZEN_MPY
     if (frozen_type == MP_FROZEN_MPY) {
+        #if MICROPY_MODULE_FROZEN_LAZY
+        // Defer execution of the module body until the first attribute load
+        // on the module object; just record what needs to be executed.
+        #if MICROPY_PY___FILE__
+        mp_store_attr(module_obj, MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(file_str)));
+        #endif
+        ((mp_obj_module_t *)MP_OBJ_TO_PTR(module_obj))->lazy_code = modref;
+        #else
         do_execute_raw_code(module_obj, modref, file_str);
+        #endif
         return;
     }
     #endif
@@ -213,8 +338,17 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     // the correct format and, if so, load and execute the file.
     #if MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD
     if (file_str[file->len - 3] == 'm') {
+        #if MICROPY_MODULE_LAZY_MPY
+        // Don't even read the file yet; record its name and defer loading and
+        // executing it until the first attribute load on the module object.
+        #if MICROPY_PY___FILE__
+        mp_store_attr(module_obj, MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(file_str)));
+        #endif
+        ((mp_obj_module_t *)MP_OBJ_TO_PTR(module_obj))->lazy_code = (const void *)MP_OBJ_NEW_QSTR(qstr_from_str(file_str));
+        #else
         mp_raw_code_t *raw_code = mp_raw_code_load_file(file_str);
         do_execute_raw_code(module_obj, raw_code, file_str);
+        #endif
         return;
     }
     #endif
@@ -222,6 +356,34 @@ STATIC void do_load(mp_obj_t module_obj, vstr_t *file) {
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
     {
+        #if MICROPY_MODULE_COMPILE_CACHE
+        if (file->len > 3 && strcmp(file_str + file->len - 3, ".py") == 0) {
+            uint32_t source_hash = compile_cache_source_hash(file_str);
+
+            // the cache file sits next to the source, with extension .mpc
+            vstr_t cache_vstr;
+            vstr_init(&cache_vstr, file->len + 2);
+            vstr_add_strn(&cache_vstr, file_str, file->len - 2);
+            vstr_add_str(&cache_vstr, "mpc");
+            const char *cache_str = vstr_null_terminated_str(&cache_vstr);
+
+            if (do_load_from_cache(module_obj, cache_str, source_hash, file_str)) {
+                vstr_clear(&cache_vstr);
+                return;
+            }
+
+            // compile the source, save the result for next time, then run it
+            mp_lexer_t *lex = mp_lexer_new_from_file(file_str);
+            qstr source_name = lex->source_name;
+            mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+            mp_raw_code_t *raw_code = mp_compile_to_raw_code(&parse_tree, source_name, false);
+            do_save_to_cache(raw_code, cache_str, source_hash);
+            vstr_clear(&cache_vstr);
+            do_execute_raw_code(module_obj, raw_code, file_str);
+            return;
+        }
+        #endif
+
         mp_lexer_t *lex = mp_lexer_new_from_file(file_str);
         do_load_from_lexer(module_obj, lex);
         return;
@@ -370,6 +532,7 @@ mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args) {
             DEBUG_printf("Previous path: =%.*s=\n", vstr_len(&path), vstr_str(&path));
 
             // find the file corresponding to the module name
+            bool created = false;
             mp_import_stat_t stat;
             if (vstr_len(&path) == 0) {
                 // first module in the dotted-name; search for a directory or file
@@ -403,14 +566,14 @@ mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args) {
                     #endif
                 }
             } else {
-                // found the file, so get the module
-                module_obj = mp_module_get(mod_name);
+                // found the file, so get the module, claiming it atomically
+                // if it's not loaded yet so that when several threads import
+                // the same module only one of them executes its body
+                module_obj = mp_obj_module_claim(mod_name, &created);
             }
 
-            if (module_obj == MP_OBJ_NULL) {
-                // module not already loaded, so load it!
-
-                module_obj = mp_obj_new_module(mod_name);
+            if (created) {
+                // this thread created the module, so load it!
 
                 // if args[3] (fromtuple) has magic value False, set up
                 // this module for command-line "-m" option (set module's
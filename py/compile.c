@@ -61,6 +61,14 @@ typedef enum {
 
 #define NEED_METHOD_TABLE MICROPY_EMIT_NATIVE
 
+#if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+// maximum number of loads hoisted out of the enclosing loops at any one time,
+// and maximum number of distinct candidate/assigned names tracked while
+// scanning one loop body (a body with more than this is left unoptimised)
+#define MICROPY_COMP_HOIST_MAX_ACTIVE (8)
+#define MICROPY_COMP_HOIST_MAX_SCAN (16)
+#endif
+
 #if NEED_METHOD_TABLE
 
 // we need a method table to do the lookup for the emitter functions
@@ -179,6 +187,17 @@ typedef struct _compiler_t {
     scope_t *scope_head;
     scope_t *scope_cur;
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    // stack of loads hoisted out of the enclosing loops; loads of base(.attr)
+    // within those loops are rewritten to load the synthetic local instead
+    size_t hoist_num;
+    struct {
+        qstr base;  // identifier at the start of the hoisted load
+        qstr attr;  // attribute loaded from base, or MP_QSTRnull for a bare name
+        qstr local; // synthetic local that holds the pre-loaded value
+    } hoist[MICROPY_COMP_HOIST_MAX_ACTIVE];
+    #endif
+
     emit_t *emit;                                   // current emitter
     #if NEED_METHOD_TABLE
     const emit_method_table_t *emit_method_table;   // current emit method table
@@ -193,7 +212,7 @@ typedef struct _compiler_t {
 STATIC void compile_error_set_line(compiler_t *comp, mp_parse_node_t pn) {
     // if the line of the error is unknown then try to update it from the pn
     if (comp->compile_error_line == 0 && MP_PARSE_NODE_IS_STRUCT(pn)) {
-        comp->compile_error_line = ((mp_parse_node_struct_t *)pn)->source_line;
+        comp->compile_error_line = MP_PARSE_NODE_STRUCT_SOURCE_LINE((mp_parse_node_struct_t *)pn);
     }
 }
 
@@ -317,6 +336,351 @@ STATIC void compile_delete_id(compiler_t *comp, qstr qst) {
     }
 }
 
+#if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+
+// Scan state for one loop body: candidate loads that could be hoisted, and
+// names/attributes the body assigns or deletes (which block hoisting).  An
+// entry with attr=MP_QSTRnull refers to the bare name.
+typedef struct _hoist_scan_t {
+    size_t num_cand;
+    size_t num_unsafe;
+    struct { qstr base; qstr attr; } cand[MICROPY_COMP_HOIST_MAX_SCAN];
+    struct { qstr base; qstr attr; } unsafe[MICROPY_COMP_HOIST_MAX_SCAN];
+    bool give_up; // set when the body is too big or contains a construct we don't track
+} hoist_scan_t;
+
+STATIC void hoist_scan_add_cand(hoist_scan_t *scan, qstr base, qstr attr) {
+    for (size_t i = 0; i < scan->num_cand; i++) {
+        if (scan->cand[i].base == base && scan->cand[i].attr == attr) {
+            return;
+        }
+    }
+    if (scan->num_cand >= MICROPY_COMP_HOIST_MAX_SCAN) {
+        scan->give_up = true;
+        return;
+    }
+    scan->cand[scan->num_cand].base = base;
+    scan->cand[scan->num_cand].attr = attr;
+    scan->num_cand++;
+}
+
+STATIC void hoist_scan_add_unsafe(hoist_scan_t *scan, qstr base, qstr attr) {
+    for (size_t i = 0; i < scan->num_unsafe; i++) {
+        if (scan->unsafe[i].base == base && scan->unsafe[i].attr == attr) {
+            return;
+        }
+    }
+    if (scan->num_unsafe >= MICROPY_COMP_HOIST_MAX_SCAN) {
+        scan->give_up = true;
+        return;
+    }
+    scan->unsafe[scan->num_unsafe].base = base;
+    scan->unsafe[scan->num_unsafe].attr = attr;
+    scan->num_unsafe++;
+}
+
+STATIC void hoist_scan_expr(hoist_scan_t *scan, mp_parse_node_t pn);
+
+// mark everything bound by an assignment/deletion target as unsafe to hoist
+STATIC void hoist_scan_target(hoist_scan_t *scan, mp_parse_node_t pn) {
+    if (MP_PARSE_NODE_IS_NULL(pn)) {
+        return;
+    }
+    if (MP_PARSE_NODE_IS_ID(pn)) {
+        hoist_scan_add_unsafe(scan, MP_PARSE_NODE_LEAF_ARG(pn), MP_QSTRnull);
+        return;
+    }
+    if (!MP_PARSE_NODE_IS_STRUCT(pn)) {
+        return;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+    switch (MP_PARSE_NODE_STRUCT_KIND(pns)) {
+        case PN_atom_expr_normal: {
+            // the base and any subscripts are loads; only "base.attr" (exactly
+            // one period trailer off a plain name) rebinds something we track
+            size_t num_trail = 1;
+            mp_parse_node_struct_t **pns_trail = (mp_parse_node_struct_t **)&pns->nodes[1];
+            if (MP_PARSE_NODE_STRUCT_KIND(pns_trail[0]) == PN_atom_expr_trailers) {
+                num_trail = MP_PARSE_NODE_STRUCT_NUM_NODES(pns_trail[0]);
+                pns_trail = (mp_parse_node_struct_t **)&pns_trail[0]->nodes[0];
+            }
+            if (MP_PARSE_NODE_IS_ID(pns->nodes[0])
+                && num_trail == 1
+                && MP_PARSE_NODE_STRUCT_KIND(pns_trail[0]) == PN_trailer_period) {
+                hoist_scan_add_unsafe(scan, MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]),
+                    MP_PARSE_NODE_LEAF_ARG(pns_trail[0]->nodes[0]));
+            } else {
+                hoist_scan_expr(scan, pns->nodes[0]);
+            }
+            for (size_t i = 0; i < num_trail; i++) {
+                if (MP_PARSE_NODE_STRUCT_KIND(pns_trail[i]) != PN_trailer_period) {
+                    hoist_scan_expr(scan, (mp_parse_node_t)pns_trail[i]);
+                }
+            }
+            break;
+        }
+        case PN_star_expr:
+            hoist_scan_target(scan, pns->nodes[0]);
+            break;
+        case PN_testlist_star_expr:
+        case PN_exprlist:
+        case PN_testlist_comp:
+        case PN_atom_paren:
+        case PN_atom_bracket: {
+            size_t n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
+            for (size_t i = 0; i < n; i++) {
+                hoist_scan_target(scan, pns->nodes[i]);
+            }
+            break;
+        }
+        default:
+            // unrecognised target form: be safe and don't hoist this loop
+            scan->give_up = true;
+            break;
+    }
+}
+
+// walk a statement/expression subtree collecting candidate loads and
+// assignment targets; does not descend into nested scopes
+STATIC void hoist_scan_expr(hoist_scan_t *scan, mp_parse_node_t pn) {
+    if (scan->give_up || MP_PARSE_NODE_IS_NULL(pn)) {
+        return;
+    }
+    if (MP_PARSE_NODE_IS_LEAF(pn)) {
+        if (MP_PARSE_NODE_IS_ID(pn) && MP_PARSE_NODE_LEAF_ARG(pn) != MP_QSTR_super) {
+            hoist_scan_add_cand(scan, MP_PARSE_NODE_LEAF_ARG(pn), MP_QSTRnull);
+        }
+        return;
+    }
+    if (!MP_PARSE_NODE_IS_STRUCT(pn)) {
+        return;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+    switch (MP_PARSE_NODE_STRUCT_KIND(pns)) {
+        case PN_atom_expr_normal: {
+            size_t num_trail = 1;
+            mp_parse_node_struct_t **pns_trail = (mp_parse_node_struct_t **)&pns->nodes[1];
+            if (MP_PARSE_NODE_STRUCT_KIND(pns_trail[0]) == PN_atom_expr_trailers) {
+                num_trail = MP_PARSE_NODE_STRUCT_NUM_NODES(pns_trail[0]);
+                pns_trail = (mp_parse_node_struct_t **)&pns_trail[0]->nodes[0];
+            }
+            if (MP_PARSE_NODE_IS_ID(pns->nodes[0])
+                && MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]) != MP_QSTR_super
+                && MP_PARSE_NODE_STRUCT_KIND(pns_trail[0]) == PN_trailer_period) {
+                hoist_scan_add_cand(scan, MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]),
+                    MP_PARSE_NODE_LEAF_ARG(pns_trail[0]->nodes[0]));
+            } else {
+                hoist_scan_expr(scan, pns->nodes[0]);
+            }
+            for (size_t i = 0; i < num_trail; i++) {
+                if (MP_PARSE_NODE_STRUCT_KIND(pns_trail[i]) != PN_trailer_period) {
+                    hoist_scan_expr(scan, (mp_parse_node_t)pns_trail[i]);
+                }
+            }
+            break;
+        }
+        case PN_expr_stmt:
+            if (MP_PARSE_NODE_IS_NULL(pns->nodes[1])) {
+                hoist_scan_expr(scan, pns->nodes[0]);
+            } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_annassign)) {
+                mp_parse_node_struct_t *pns1 = (mp_parse_node_struct_t *)pns->nodes[1];
+                hoist_scan_target(scan, pns->nodes[0]);
+                hoist_scan_expr(scan, pns1->nodes[0]); // annotation
+                hoist_scan_expr(scan, pns1->nodes[1]); // value (may be NULL)
+            } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_expr_stmt_augassign)) {
+                mp_parse_node_struct_t *pns1 = (mp_parse_node_struct_t *)pns->nodes[1];
+                hoist_scan_target(scan, pns->nodes[0]);
+                hoist_scan_expr(scan, pns1->nodes[1]);
+            } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[1], PN_expr_stmt_assign_list)) {
+                mp_parse_node_struct_t *pns1 = (mp_parse_node_struct_t *)pns->nodes[1];
+                size_t n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns1);
+                hoist_scan_target(scan, pns->nodes[0]);
+                for (size_t i = 0; i + 1 < n; i++) {
+                    hoist_scan_target(scan, pns1->nodes[i]);
+                }
+                hoist_scan_expr(scan, pns1->nodes[n - 1]);
+            } else {
+                // single assignment; nodes[1] is the value
+                hoist_scan_target(scan, pns->nodes[0]);
+                hoist_scan_expr(scan, pns->nodes[1]);
+            }
+            break;
+        case PN_for_stmt:
+            hoist_scan_target(scan, pns->nodes[0]);
+            hoist_scan_expr(scan, pns->nodes[1]);
+            hoist_scan_expr(scan, pns->nodes[2]);
+            hoist_scan_expr(scan, pns->nodes[3]);
+            break;
+        case PN_comp_for:
+            // iterable is evaluated in this scope; target and the rest of the
+            // comprehension run in their own scope
+            hoist_scan_target(scan, pns->nodes[0]);
+            hoist_scan_expr(scan, pns->nodes[1]);
+            break;
+        case PN_funcdef:
+        case PN_classdef:
+            // binds the name; the body is a separate scope
+            hoist_scan_add_unsafe(scan, MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]), MP_QSTRnull);
+            break;
+        case PN_lambdef:
+        case PN_lambdef_nocond:
+            // separate scope
+            break;
+        case PN_del_stmt:
+            hoist_scan_target(scan, pns->nodes[0]);
+            break;
+        case PN_global_stmt:
+        case PN_nonlocal_stmt: {
+            mp_parse_node_t pn_names = pns->nodes[0];
+            if (MP_PARSE_NODE_IS_ID(pn_names)) {
+                hoist_scan_add_unsafe(scan, MP_PARSE_NODE_LEAF_ARG(pn_names), MP_QSTRnull);
+            } else if (MP_PARSE_NODE_IS_STRUCT(pn_names)) {
+                mp_parse_node_struct_t *pns1 = (mp_parse_node_struct_t *)pn_names;
+                size_t n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns1);
+                for (size_t i = 0; i < n; i++) {
+                    if (MP_PARSE_NODE_IS_ID(pns1->nodes[i])) {
+                        hoist_scan_add_unsafe(scan, MP_PARSE_NODE_LEAF_ARG(pns1->nodes[i]), MP_QSTRnull);
+                    }
+                }
+            }
+            break;
+        }
+        case PN_import_name:
+        case PN_import_from:
+            // binds names in ways we don't track
+            scan->give_up = true;
+            break;
+        case PN_try_stmt_as_name:
+            hoist_scan_expr(scan, pns->nodes[0]);
+            hoist_scan_target(scan, pns->nodes[1]);
+            break;
+        case PN_with_item:
+            hoist_scan_expr(scan, pns->nodes[0]);
+            hoist_scan_target(scan, pns->nodes[1]);
+            break;
+        case PN_namedexpr_test:
+            hoist_scan_target(scan, pns->nodes[0]);
+            hoist_scan_expr(scan, pns->nodes[1]);
+            break;
+        case PN_const_object:
+            // nodes hold a raw object, not parse nodes
+            break;
+        default: {
+            size_t n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
+            for (size_t i = 0; i < n; i++) {
+                hoist_scan_expr(scan, pns->nodes[i]);
+            }
+            break;
+        }
+    }
+}
+
+STATIC bool hoist_is_unsafe(hoist_scan_t *scan, qstr base, qstr attr) {
+    for (size_t i = 0; i < scan->num_unsafe; i++) {
+        // an unsafe bare name blocks both the name and any attribute off it
+        if (scan->unsafe[i].base == base
+            && (scan->unsafe[i].attr == MP_QSTRnull || scan->unsafe[i].attr == attr)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+STATIC qstr compile_hoist_find(compiler_t *comp, qstr base, qstr attr) {
+    for (size_t i = 0; i < comp->hoist_num; i++) {
+        if (comp->hoist[i].base == base && comp->hoist[i].attr == attr) {
+            return comp->hoist[i].local;
+        }
+    }
+    return MP_QSTRnull;
+}
+
+// Called at the head of a for/while loop: scan the body (and the condition,
+// for while loops) for loads that can't change while the loop runs, evaluate
+// each once into a synthetic local, and activate the rewrite entries.  The
+// synthetic names start with '*' so they can never clash with real
+// identifiers, and are derived from the load so all compiler passes agree on
+// them.  Returns the previous depth of the hoist stack, to be passed to
+// compile_hoist_loop_end once the loop (but not its else clause) is compiled.
+STATIC size_t compile_hoist_loop_start(compiler_t *comp, mp_parse_node_t pn_target, mp_parse_node_t pn_cond, mp_parse_node_t pn_body) {
+    size_t hoist_start = comp->hoist_num;
+    if (comp->scope_cur->kind != SCOPE_FUNCTION) {
+        return hoist_start;
+    }
+
+    hoist_scan_t scan;
+    memset(&scan, 0, sizeof(scan));
+    hoist_scan_target(&scan, pn_target);
+    hoist_scan_expr(&scan, pn_cond);
+    hoist_scan_expr(&scan, pn_body);
+    if (scan.give_up) {
+        return hoist_start;
+    }
+
+    for (size_t i = 0; i < scan.num_cand && comp->hoist_num < MICROPY_COMP_HOIST_MAX_ACTIVE; i++) {
+        qstr base = scan.cand[i].base;
+        qstr attr = scan.cand[i].attr;
+        if (hoist_is_unsafe(&scan, base, attr)
+            || compile_hoist_find(comp, base, attr) != MP_QSTRnull) {
+            continue;
+        }
+
+        // Decide from the base's id kind whether the load is invariant.  On
+        // the scope pass kinds aren't resolved yet, so accept every name that
+        // might still resolve to an acceptable kind (this can only waste a
+        // local slot); on the emit passes kinds are final and the decision is
+        // the same for each pass.
+        id_info_t *id = scope_find(comp->scope_cur, base);
+        bool ok;
+        if (comp->pass == MP_PASS_SCOPE) {
+            ok = id == NULL
+                || id->kind == ID_INFO_KIND_UNDECIDED
+                || id->kind == ID_INFO_KIND_GLOBAL_IMPLICIT
+                || (attr != MP_QSTRnull && id->kind == ID_INFO_KIND_LOCAL);
+        } else {
+            ok = id != NULL
+                && (id->kind == ID_INFO_KIND_GLOBAL_IMPLICIT
+                    || (attr != MP_QSTRnull && id->kind == ID_INFO_KIND_LOCAL));
+        }
+        if (!ok) {
+            continue;
+        }
+
+        // build the synthetic local name: "*base" or "*base.attr"
+        vstr_t vstr;
+        vstr_init(&vstr, 16);
+        vstr_add_byte(&vstr, '*');
+        vstr_add_str(&vstr, qstr_str(base));
+        if (attr != MP_QSTRnull) {
+            vstr_add_byte(&vstr, '.');
+            vstr_add_str(&vstr, qstr_str(attr));
+        }
+        qstr local = qstr_from_strn(vstr.buf, vstr.len);
+        vstr_clear(&vstr);
+
+        // evaluate the load once, before the loop (on the scope pass this just
+        // registers the base and the synthetic local with the scope)
+        compile_load_id(comp, base);
+        if (attr != MP_QSTRnull) {
+            EMIT_ARG(attr, attr, MP_EMIT_ATTR_LOAD);
+        }
+        compile_store_id(comp, local);
+
+        comp->hoist[comp->hoist_num].base = base;
+        comp->hoist[comp->hoist_num].attr = attr;
+        comp->hoist[comp->hoist_num].local = local;
+        comp->hoist_num++;
+    }
+
+    return hoist_start;
+}
+
+STATIC void compile_hoist_loop_end(compiler_t *comp, size_t hoist_start) {
+    comp->hoist_num = hoist_start;
+}
+
+#endif // MICROPY_COMP_HOIST_LOOP_INVARIANTS
+
 STATIC void c_tuple(compiler_t *comp, mp_parse_node_t pn, mp_parse_node_struct_t *pns_list) {
     int total = 0;
     if (!MP_PARSE_NODE_IS_NULL(pn)) {
@@ -1397,6 +1761,9 @@ STATIC void compile_while_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     START_BREAK_CONTINUE_BLOCK
 
     if (!mp_parse_node_is_const_false(pns->nodes[0])) { // optimisation: don't emit anything for "while False"
+        #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+        size_t hoist_start = compile_hoist_loop_start(comp, MP_PARSE_NODE_NULL, pns->nodes[0], pns->nodes[1]);
+        #endif
         uint top_label = comp_next_label(comp);
         if (!mp_parse_node_is_const_true(pns->nodes[0])) { // optimisation: don't jump to cond for "while True"
             EMIT_ARG(jump, continue_label);
@@ -1405,6 +1772,9 @@ STATIC void compile_while_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
         compile_node(comp, pns->nodes[1]); // body
         EMIT_ARG(label_assign, continue_label);
         c_if_cond(comp, pns->nodes[0], true, top_label); // condition
+        #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+        compile_hoist_loop_end(comp, hoist_start);
+        #endif
     }
 
     // break/continue apply to outer loop (if any) in the else block
@@ -1434,6 +1804,10 @@ STATIC void compile_while_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
 STATIC void compile_for_stmt_optimised_range(compiler_t *comp, mp_parse_node_t pn_var, mp_parse_node_t pn_start, mp_parse_node_t pn_end, mp_parse_node_t pn_step, mp_parse_node_t pn_body, mp_parse_node_t pn_else) {
     START_BREAK_CONTINUE_BLOCK
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    size_t hoist_start = compile_hoist_loop_start(comp, pn_var, MP_PARSE_NODE_NULL, pn_body);
+    #endif
+
     uint top_label = comp_next_label(comp);
     uint entry_label = comp_next_label(comp);
 
@@ -1461,6 +1835,7 @@ STATIC void compile_for_stmt_optimised_range(compiler_t *comp, mp_parse_node_t p
     // compile: var + step
     compile_node(comp, pn_step);
     EMIT_ARG(binary_op, MP_BINARY_OP_INPLACE_ADD);
+    reserve_labels_for_native(comp, 2); // used by native's binary_op
 
     EMIT_ARG(label_assign, entry_label);
 
@@ -1480,6 +1855,10 @@ STATIC void compile_for_stmt_optimised_range(compiler_t *comp, mp_parse_node_t p
     }
     EMIT_ARG(pop_jump_if, true, top_label);
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    compile_hoist_loop_end(comp, hoist_start);
+    #endif
+
     // break/continue apply to outer loop (if any) in the else block
     END_BREAK_CONTINUE_BLOCK
 
@@ -1573,6 +1952,10 @@ STATIC void compile_for_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     START_BREAK_CONTINUE_BLOCK
     comp->break_label |= MP_EMIT_BREAK_FROM_FOR;
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    size_t hoist_start = compile_hoist_loop_start(comp, pns->nodes[0], MP_PARSE_NODE_NULL, pns->nodes[2]);
+    #endif
+
     uint pop_label = comp_next_label(comp);
 
     compile_node(comp, pns->nodes[1]); // iterator
@@ -1587,6 +1970,10 @@ STATIC void compile_for_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     EMIT_ARG(label_assign, pop_label);
     EMIT(for_iter_end);
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    compile_hoist_loop_end(comp, hoist_start);
+    #endif
+
     // break/continue apply to outer loop (if any) in the else block
     END_BREAK_CONTINUE_BLOCK
 
@@ -1619,7 +2006,7 @@ STATIC void compile_try_except(compiler_t *comp, mp_parse_node_t pn_body, int n_
         qstr qstr_exception_local = 0;
         uint end_finally_label = comp_next_label(comp);
         #if MICROPY_PY_SYS_SETTRACE
-        EMIT_ARG(set_source_line, pns_except->source_line);
+        EMIT_ARG(set_source_line, MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns_except));
         #endif
 
         if (MP_PARSE_NODE_IS_NULL(pns_except->nodes[0])) {
@@ -2037,6 +2424,7 @@ STATIC void compile_expr_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
             mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pns1->nodes[0]);
             mp_binary_op_t op = MP_BINARY_OP_INPLACE_OR + (tok - MP_TOKEN_DEL_PIPE_EQUAL);
             EMIT_ARG(binary_op, op);
+            reserve_labels_for_native(comp, 2); // used by native's binary_op
             c_assign(comp, pns->nodes[0], ASSIGN_AUG_STORE); // lhs store for aug assign
         } else if (kind == PN_expr_stmt_assign_list) {
             int rhs = MP_PARSE_NODE_STRUCT_NUM_NODES(pns1) - 1;
@@ -2252,6 +2640,7 @@ STATIC void compile_term(compiler_t *comp, mp_parse_node_struct_t *pns) {
         mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pns->nodes[i]);
         mp_binary_op_t op = MP_BINARY_OP_LSHIFT + (tok - MP_TOKEN_OP_DBL_LESS);
         EMIT_ARG(binary_op, op);
+        reserve_labels_for_native(comp, 2); // used by native's binary_op
     }
 }
 
@@ -2269,11 +2658,9 @@ STATIC void compile_factor_2(compiler_t *comp, mp_parse_node_struct_t *pns) {
 }
 
 STATIC void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *pns) {
-    // compile the subject of the expression
-    compile_node(comp, pns->nodes[0]);
-
     // compile_atom_expr_await may call us with a NULL node
     if (MP_PARSE_NODE_IS_NULL(pns->nodes[1])) {
+        compile_node(comp, pns->nodes[0]);
         return;
     }
 
@@ -2288,6 +2675,24 @@ STATIC void compile_atom_expr_normal(compiler_t *comp, mp_parse_node_struct_t *p
     // the current index into the array of trailers
     size_t i = 0;
 
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    // if base.attr was hoisted out of an enclosing loop then load the
+    // synthetic local instead of the base and the first trailer
+    if (comp->hoist_num != 0
+        && MP_PARSE_NODE_IS_ID(pns->nodes[0])
+        && MP_PARSE_NODE_STRUCT_KIND(pns_trail[0]) == PN_trailer_period) {
+        qstr local = compile_hoist_find(comp, MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]),
+            MP_PARSE_NODE_LEAF_ARG(pns_trail[0]->nodes[0]));
+        if (local != MP_QSTRnull) {
+            compile_load_id(comp, local);
+            i = 1;
+        }
+    }
+    if (i == 0)
+    #endif
+    // compile the subject of the expression
+    compile_node(comp, pns->nodes[0]);
+
     // handle special super() call
     if (comp->scope_cur->kind == SCOPE_FUNCTION
         && MP_PARSE_NODE_IS_ID(pns->nodes[0])
@@ -2829,9 +3234,19 @@ STATIC void compile_node(compiler_t *comp, mp_parse_node_t pn) {
     } else if (MP_PARSE_NODE_IS_LEAF(pn)) {
         uintptr_t arg = MP_PARSE_NODE_LEAF_ARG(pn);
         switch (MP_PARSE_NODE_LEAF_KIND(pn)) {
-            case MP_PARSE_NODE_ID:
+            case MP_PARSE_NODE_ID: {
+                #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+                // use the pre-loaded value if this name was hoisted out of an
+                // enclosing loop
+                qstr local = compile_hoist_find(comp, arg, MP_QSTRnull);
+                if (local != MP_QSTRnull) {
+                    compile_load_id(comp, local);
+                    break;
+                }
+                #endif
                 compile_load_id(comp, arg);
                 break;
+            }
             case MP_PARSE_NODE_STRING:
                 EMIT_ARG(load_const_str, arg);
                 break;
@@ -2858,7 +3273,7 @@ STATIC void compile_node(compiler_t *comp, mp_parse_node_t pn) {
         }
     } else {
         mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
-        EMIT_ARG(set_source_line, pns->source_line);
+        EMIT_ARG(set_source_line, MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns));
         assert(MP_PARSE_NODE_STRUCT_KIND(pns) <= PN_const_object);
         compile_function_t f = compile_function[MP_PARSE_NODE_STRUCT_KIND(pns)];
         f(comp, pns);
@@ -3067,6 +3482,9 @@ STATIC void compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
     comp->pass = pass;
     comp->scope_cur = scope;
     comp->next_label = 0;
+    #if MICROPY_COMP_HOIST_LOOP_INVARIANTS
+    comp->hoist_num = 0;
+    #endif
     EMIT_ARG(start_pass, pass, scope);
     reserve_labels_for_native(comp, 6); // used by native's start_pass
 
@@ -3121,7 +3539,7 @@ STATIC void compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
         assert(MP_PARSE_NODE_STRUCT_NUM_NODES(pns) == 3);
 
         // Set the source line number for the start of the lambda
-        EMIT_ARG(set_source_line, pns->source_line);
+        EMIT_ARG(set_source_line, MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns));
 
         // work out number of parameters, keywords and default parameters, and add them to the id_info array
         // must be done before compiling the body so that arguments are numbered first (for LOAD_FAST etc)
@@ -3158,7 +3576,7 @@ STATIC void compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
         }
 
         // Set the source line number for the start of the comprehension
-        EMIT_ARG(set_source_line, pns->source_line);
+        EMIT_ARG(set_source_line, MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns));
 
         if (scope->kind == SCOPE_LIST_COMP) {
             EMIT_ARG(build, 0, MP_EMIT_BUILD_LIST);
@@ -3200,7 +3618,7 @@ STATIC void compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
         }
 
         #if MICROPY_PY_SYS_SETTRACE
-        EMIT_ARG(set_source_line, pns->source_line);
+        EMIT_ARG(set_source_line, MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns));
         #endif
         compile_load_id(comp, MP_QSTR___name__);
         compile_store_id(comp, MP_QSTR___module__);
@@ -3396,7 +3814,7 @@ STATIC void compile_scope_inline_asm(compiler_t *comp, scope_t *scope, pass_kind
     if (comp->compile_error != MP_OBJ_NULL) {
         // inline assembler had an error; set line for its exception
     inline_asm_error:
-        comp->compile_error_line = pns->source_line;
+        comp->compile_error_line = MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns);
     }
 }
 #endif
@@ -3413,6 +3831,10 @@ STATIC void scope_compute_things(scope_t *scope) {
                     id_info_t temp = *id_param;
                     *id_param = *id;
                     *id = temp;
+                    #if MICROPY_OPT_SCOPE_ID_INDEX
+                    scope_id_index_sync(scope, id_param);
+                    scope_id_index_sync(scope, id);
+                    #endif
                 }
                 break;
             } else if (id_param == NULL && id->flags == ID_FLAG_IS_PARAM) {
@@ -439,7 +439,7 @@ void mp_emit_bc_end_pass(emit_t *emit) {
 
     } else if (emit->pass == MP_PASS_EMIT) {
         mp_emit_glue_assign_bytecode(emit->scope->raw_code, emit->code_base,
-            #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS
+            #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS || MICROPY_OPT_VM_SUPERINSTRUCTIONS
             emit->code_info_size + emit->bytecode_size,
             #endif
             emit->const_table,
@@ -568,6 +568,9 @@ void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
 void mp_emit_bc_load_method(emit_t *emit, qstr qst, bool is_super) {
     int stack_adj = 1 - 2 * is_super;
     emit_write_bytecode_byte_qstr(emit, stack_adj, is_super ? MP_BC_LOAD_SUPER_METHOD : MP_BC_LOAD_METHOD, qst);
+    if (!is_super && MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE_DYNAMIC) {
+        emit_write_bytecode_raw_byte(emit, 0);
+    }
 }
 
 void mp_emit_bc_load_build_class(emit_t *emit) {
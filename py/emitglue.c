@@ -33,6 +33,7 @@
 
 #include "py/emitglue.h"
 #include "py/runtime0.h"
+#include "py/bc0.h"
 #include "py/bc.h"
 #include "py/profile.h"
 
@@ -50,6 +51,119 @@
 mp_uint_t mp_verbose_flag = 0;
 #endif
 
+#if MICROPY_OPT_VM_SUPERINSTRUCTIONS
+
+#if MICROPY_PERSISTENT_CODE_SAVE
+#error "MICROPY_OPT_VM_SUPERINSTRUCTIONS is incompatible with MICROPY_PERSISTENT_CODE_SAVE"
+#endif
+
+static bool fuse_offset_is_signed(byte op) {
+    return op == MP_BC_JUMP
+           || op == MP_BC_POP_JUMP_IF_TRUE
+           || op == MP_BC_POP_JUMP_IF_FALSE
+           || op == MP_BC_JUMP_IF_TRUE_OR_POP
+           || op == MP_BC_JUMP_IF_FALSE_OR_POP
+           || op == MP_BC_UNWIND_JUMP;
+}
+
+// Rewrite hot opcode pairs in-place into single fused opcodes, so the VM pays
+// one dispatch instead of two for them.  The rewrite never changes the size
+// or position of any instruction: the first opcode byte of a pair becomes the
+// fused opcode and the second opcode byte is reused to carry the operands, so
+// all branch offsets remain valid.  A pair is only fused if no branch targets
+// its second opcode.
+static void mp_emit_glue_fuse_bytecode(byte *code, size_t len) {
+    // Skip the prelude to find the opcode stream.
+    const byte *ip = code;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    (void)scope_flags;
+    ip += n_info + n_cell;
+    #if !MICROPY_PERSISTENT_CODE
+    ip = MP_ALIGN(ip, sizeof(mp_uint_t));
+    #endif
+    byte *bc_start = (byte *)ip;
+    byte *bc_end = code + len;
+    size_t bc_len = bc_end - bc_start;
+
+    // Pass 1: mark all branch targets so a fused pair never hides one.
+    byte *targets = m_new0(byte, (bc_len + 7) / 8);
+    for (const byte *p = bc_start; p < bc_end;) {
+        size_t sz;
+        uint f = mp_opcode_format(p, &sz, true);
+        if (f == MP_BC_FORMAT_OFFSET) {
+            ptrdiff_t off = p[1] | (p[2] << 8);
+            if (fuse_offset_is_signed(*p)) {
+                off -= 0x8000;
+            }
+            const byte *t = p + 3 + off;
+            if (t >= bc_start && t < bc_end) {
+                targets[(t - bc_start) >> 3] |= 1 << ((t - bc_start) & 7);
+            }
+        }
+        p += sz;
+    }
+
+    // Pass 2: fuse pairs.
+    for (byte *p = bc_start; p < bc_end;) {
+        size_t sz;
+        mp_opcode_format(p, &sz, true);
+        byte *q = p + sz;
+        if (sz != 1 || q >= bc_end
+            || (targets[(q - bc_start) >> 3] & (1 << ((q - bc_start) & 7)))) {
+            p = q;
+            continue;
+        }
+        byte op0 = p[0];
+        byte op1 = q[0];
+        if (op0 >= MP_BC_LOAD_FAST_MULTI && op0 < MP_BC_LOAD_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM) {
+            if (op1 >= MP_BC_LOAD_FAST_MULTI && op1 < MP_BC_LOAD_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM) {
+                // Check for the full three-address pattern, LOAD_FAST;
+                // LOAD_FAST; BINARY_OP; STORE_FAST, and fuse all four
+                // opcodes so that e.g. "a = b + c" is a single dispatch.
+                byte *q2 = q + 1;
+                if (q2 + 1 < bc_end
+                    && !(targets[(q2 - bc_start) >> 3] & (1 << ((q2 - bc_start) & 7)))
+                    && !(targets[(q2 + 1 - bc_start) >> 3] & (1 << ((q2 + 1 - bc_start) & 7)))
+                    && q2[0] >= MP_BC_BINARY_OP_MULTI && q2[0] < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM
+                    && q2[1] >= MP_BC_STORE_FAST_MULTI && q2[1] < MP_BC_STORE_FAST_MULTI + MP_BC_STORE_FAST_MULTI_NUM) {
+                    p[0] = MP_BC_BINARY_OP_STORE_FAST;
+                    p[1] = (op0 - MP_BC_LOAD_FAST_MULTI) << 4 | (op1 - MP_BC_LOAD_FAST_MULTI);
+                    p[2] = q2[0] - MP_BC_BINARY_OP_MULTI;
+                    p[3] = q2[1] - MP_BC_STORE_FAST_MULTI;
+                    p = q2 + 2;
+                    continue;
+                }
+                p[0] = MP_BC_LOAD_FAST_LOAD_FAST;
+                p[1] = (op0 - MP_BC_LOAD_FAST_MULTI) << 4 | (op1 - MP_BC_LOAD_FAST_MULTI);
+                p = q + 1;
+                continue;
+            }
+            if (op0 < MP_BC_LOAD_FAST_MULTI + 4
+                && op1 >= MP_BC_BINARY_OP_MULTI && op1 < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM) {
+                p[0] = MP_BC_LOAD_FAST_BINARY_OP;
+                p[1] = (op0 - MP_BC_LOAD_FAST_MULTI) << 6 | (op1 - MP_BC_BINARY_OP_MULTI);
+                p = q + 1;
+                continue;
+            }
+        } else if (op0 >= MP_BC_BINARY_OP_MULTI && op0 < MP_BC_BINARY_OP_MULTI + MP_BINARY_OP_EXCEPTION_MATCH
+                   && (op1 == MP_BC_POP_JUMP_IF_TRUE || op1 == MP_BC_POP_JUMP_IF_FALSE)) {
+            // Fuse a comparison with the conditional jump that consumes its
+            // result; the 16-bit offset stays in place at p[2]/p[3].
+            p[0] = op1 == MP_BC_POP_JUMP_IF_TRUE
+                ? MP_BC_BINARY_OP_POP_JUMP_IF_TRUE : MP_BC_BINARY_OP_POP_JUMP_IF_FALSE;
+            p[1] = op0 - MP_BC_BINARY_OP_MULTI;
+            p = q + 3;
+            continue;
+        }
+        p = q;
+    }
+
+    m_del(byte, targets, (bc_len + 7) / 8);
+}
+
+#endif // MICROPY_OPT_VM_SUPERINSTRUCTIONS
+
 mp_raw_code_t *mp_emit_glue_new_raw_code(void) {
     mp_raw_code_t *rc = m_new0(mp_raw_code_t, 1);
     rc->kind = MP_CODE_RESERVED;
@@ -60,7 +174,7 @@ mp_raw_code_t *mp_emit_glue_new_raw_code(void) {
 }
 
 void mp_emit_glue_assign_bytecode(mp_raw_code_t *rc, const byte *code,
-    #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS
+    #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS || MICROPY_OPT_VM_SUPERINSTRUCTIONS
     size_t len,
     #endif
     const mp_uint_t *const_table,
@@ -95,6 +209,13 @@ void mp_emit_glue_assign_bytecode(mp_raw_code_t *rc, const byte *code,
         mp_bytecode_print(&mp_plat_print, rc, code, len, const_table);
     }
     #endif
+
+    #if MICROPY_OPT_VM_SUPERINSTRUCTIONS
+    // The bytecode always lives in RAM here: it came from either the bytecode
+    // emitter or the .mpy loader (frozen code doesn't pass through this
+    // function), so it can be rewritten in-place.
+    mp_emit_glue_fuse_bytecode((byte *)code, len);
+    #endif
 }
 
 #if MICROPY_EMIT_MACHINE_CODE
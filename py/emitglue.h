@@ -86,7 +86,7 @@ typedef struct _mp_raw_code_t {
 mp_raw_code_t *mp_emit_glue_new_raw_code(void);
 
 void mp_emit_glue_assign_bytecode(mp_raw_code_t *rc, const byte *code,
-    #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS
+    #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS || MICROPY_OPT_VM_SUPERINSTRUCTIONS
     size_t len,
     #endif
     const mp_uint_t *const_table,
@@ -214,8 +214,31 @@ STATIC const opcode_table_3arg_t opcode_table_3arg[] = {
     {MP_QSTR_or_, RRR, 0, 2},
     {MP_QSTR_xor, RRR, 0, 3},
     {MP_QSTR_add, RRR, 0, 8},
+    {MP_QSTR_addx2, RRR, 0, 9},
+    {MP_QSTR_addx4, RRR, 0, 10},
+    {MP_QSTR_addx8, RRR, 0, 11},
     {MP_QSTR_sub, RRR, 0, 12},
+    {MP_QSTR_subx2, RRR, 0, 13},
+    {MP_QSTR_subx4, RRR, 0, 14},
+    {MP_QSTR_subx8, RRR, 0, 15},
+    {MP_QSTR_src, RRR, 1, 8},
+    {MP_QSTR_mul16u, RRR, 1, 12},
+    {MP_QSTR_mul16s, RRR, 1, 13},
     {MP_QSTR_mull, RRR, 2, 8},
+    {MP_QSTR_muluh, RRR, 2, 10},
+    {MP_QSTR_mulsh, RRR, 2, 11},
+    {MP_QSTR_quou, RRR, 2, 12},
+    {MP_QSTR_quos, RRR, 2, 13},
+    {MP_QSTR_remu, RRR, 2, 14},
+    {MP_QSTR_rems, RRR, 2, 15},
+    {MP_QSTR_min, RRR, 3, 4},
+    {MP_QSTR_max, RRR, 3, 5},
+    {MP_QSTR_minu, RRR, 3, 6},
+    {MP_QSTR_maxu, RRR, 3, 7},
+    {MP_QSTR_moveqz, RRR, 3, 8},
+    {MP_QSTR_movnez, RRR, 3, 9},
+    {MP_QSTR_movltz, RRR, 3, 10},
+    {MP_QSTR_movgez, RRR, 3, 11},
 
     // load/store/addi opcodes: reg, reg, imm
     // upper nibble of type encodes the range of the immediate arg
@@ -263,6 +286,14 @@ STATIC void emit_inline_xtensa_op(emit_inline_asm_t *emit, qstr op, mp_uint_t n_
         } else if (op == MP_QSTR_jx) {
             uint r0 = get_arg_reg(emit, op_str, pn_args[0]);
             asm_xtensa_op_jx(&emit->as, r0);
+        } else if (op == MP_QSTR_ssr || op == MP_QSTR_ssl) {
+            // set shift-amount register for right/left shifts by sll/srl/sra/src
+            uint r0 = get_arg_reg(emit, op_str, pn_args[0]);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 0, 4, op == MP_QSTR_ssl, r0, 0));
+        } else if (op == MP_QSTR_ssai) {
+            // set shift-amount register to an immediate
+            mp_uint_t sa = get_arg_i(emit, op_str, pn_args[0], 0, 31);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 0, 4, 4, sa & 0xf, (sa >> 4) & 0x1));
         } else {
             goto unknown_op;
         }
@@ -283,11 +314,45 @@ STATIC void emit_inline_xtensa_op(emit_inline_asm_t *emit, qstr op, mp_uint_t n_
             // for convenience we emit l32r if the integer doesn't fit in movi
             uint32_t imm = get_arg_i(emit, op_str, pn_args[1], 0, 0);
             asm_xtensa_mov_reg_i32(&emit->as, r0, imm);
+        } else if (op == MP_QSTR_neg || op == MP_QSTR_abs_) {
+            uint r1 = get_arg_reg(emit, op_str, pn_args[1]);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 0, 6, r0, op == MP_QSTR_abs_, r1));
+        } else if (op == MP_QSTR_nsa || op == MP_QSTR_nsau) {
+            uint r1 = get_arg_reg(emit, op_str, pn_args[1]);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 0, 4, op == MP_QSTR_nsau ? 15 : 14, r1, r0));
+        } else if (op == MP_QSTR_sll) {
+            // shift amount comes from the shift-amount register (see ssl/ssai)
+            uint r1 = get_arg_reg(emit, op_str, pn_args[1]);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 1, 10, r0, r1, 0));
+        } else if (op == MP_QSTR_srl || op == MP_QSTR_sra) {
+            uint r1 = get_arg_reg(emit, op_str, pn_args[1]);
+            asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 1, op == MP_QSTR_sra ? 11 : 9, r0, 0, r1));
         } else {
             goto unknown_op;
         }
 
     } else if (n_args == 3) {
+        if (op == MP_QSTR_slli || op == MP_QSTR_srai || op == MP_QSTR_srli || op == MP_QSTR_sext) {
+            // shift/sign-extend opcodes with an immediate shift amount, which
+            // is split across the instruction fields in an opcode-specific way
+            uint r0 = get_arg_reg(emit, op_str, pn_args[0]);
+            uint r1 = get_arg_reg(emit, op_str, pn_args[1]);
+            if (op == MP_QSTR_slli) {
+                mp_uint_t sa = 32 - get_arg_i(emit, op_str, pn_args[2], 1, 31);
+                asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 1, 0 | ((sa >> 4) & 0x1), r0, r1, sa & 0xf));
+            } else if (op == MP_QSTR_srai) {
+                mp_uint_t sa = get_arg_i(emit, op_str, pn_args[2], 0, 31);
+                asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 1, 2 | ((sa >> 4) & 0x1), r0, sa & 0xf, r1));
+            } else if (op == MP_QSTR_srli) {
+                mp_uint_t sa = get_arg_i(emit, op_str, pn_args[2], 0, 15);
+                asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 1, 4, r0, sa, r1));
+            } else {
+                mp_uint_t imm = get_arg_i(emit, op_str, pn_args[2], 7, 22);
+                asm_xtensa_op24(&emit->as, ASM_XTENSA_ENCODE_RRR(0, 3, 2, r0, r1, imm - 7));
+            }
+            return;
+        }
+
         // search table for 3 arg instructions
         for (uint i = 0; i < MP_ARRAY_SIZE(opcode_table_3arg); i++) {
             const opcode_table_3arg_t *o = &opcode_table_3arg[i];
@@ -60,6 +60,12 @@
 // wrapper around everything in this file
 #if N_X64 || N_X86 || N_THUMB || N_ARM || N_XTENSA || N_XTENSAWIN
 
+// Whether to emit an inline speculative small-int fast path for + and - on
+// object operands, with a fallback to the runtime call.  Only the object
+// representations where a small int is ((val << 1) | 1) are supported.
+#define NATIVE_SMALLINT_ARITH (MICROPY_EMIT_NATIVE_SMALLINT_ARITH \
+    && (MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_A || MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_C))
+
 // C stack layout for native functions:
 //  0:                          nlr_buf_t [optional]
 //  emit->code_state_start:     mp_code_state_t
@@ -71,6 +77,7 @@
 //
 //  Then REG_GENERATOR_STATE points to:
 //  0=emit->code_state_start:   mp_code_state_t
+//  SIZEOF_CODE_STATE:          pending exception, unwind, return value (3 words)
 //  emit->stack_start:          Python object stack             | emit->n_state
 //                              locals (reversed, L0 at end)    |
 //
@@ -131,6 +138,18 @@
 #define LOCAL_IDX_GEN_PC(emit) ((emit)->code_state_start + OFFSETOF_CODE_STATE_IP)
 #define LOCAL_IDX_LOCAL_VAR(emit, local_num) ((emit)->stack_start + (emit)->n_state - 1 - (local_num))
 
+// The pending exception (an exception propagating through a finally block, or
+// MP_OBJ_NULL/None if there is none), any unwind-jump target, and the value of
+// a return statement that is unwinding through a finally all live in transient
+// C-stack slots (or on a reusable part of the Python stack), so for generators
+// they must be saved into the persistent generator state across a yield.  The
+// first three words of state are reserved for this (note: the first word is
+// also used to hold the exception at function exit, by which time the pending
+// exception is dead).
+#define LOCAL_IDX_GEN_PENDING_EXC(emit) (OFFSETOF_CODE_STATE_STATE + 0)
+#define LOCAL_IDX_GEN_PENDING_UNWIND(emit) (OFFSETOF_CODE_STATE_STATE + 1)
+#define LOCAL_IDX_GEN_PENDING_RET_VAL(emit) (OFFSETOF_CODE_STATE_STATE + 2)
+
 #define REG_GENERATOR_STATE (REG_LOCAL_3)
 
 #define EMIT_NATIVE_VIPER_TYPE_ERROR(emit, ...) do { \
@@ -154,6 +173,9 @@ typedef enum {
     VTYPE_PTR8 = 0x00 | MP_NATIVE_TYPE_PTR8,
     VTYPE_PTR16 = 0x00 | MP_NATIVE_TYPE_PTR16,
     VTYPE_PTR32 = 0x00 | MP_NATIVE_TYPE_PTR32,
+    #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+    VTYPE_FLOAT = 0x00 | MP_NATIVE_TYPE_FLOAT,
+    #endif
 
     VTYPE_PTR_NONE = 0x50 | MP_NATIVE_TYPE_PTR,
 
@@ -179,6 +201,10 @@ STATIC qstr vtype_to_qstr(vtype_kind_t vtype) {
             return MP_QSTR_ptr16;
         case VTYPE_PTR32:
             return MP_QSTR_ptr32;
+        #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+        case VTYPE_FLOAT:
+            return MP_QSTR_fp;
+        #endif
         case VTYPE_PTR_NONE:
         default:
             return MP_QSTR_None;
@@ -216,6 +242,15 @@ struct _emit_t {
     mp_uint_t local_vtype_alloc;
     vtype_kind_t *local_vtype;
 
+    // Number of times each local is accessed, counted in the first pass and
+    // used in later passes to decide which locals are cached in registers.
+    uint16_t *local_use_count;
+
+    // local_reg_map[i] is the number of the local cached in reg_local_table[i];
+    // only the first local_reg_count entries are valid.
+    uint16_t local_reg_map[REG_LOCAL_NUM];
+    uint8_t local_reg_count;
+
     mp_uint_t stack_info_alloc;
     stack_info_t *stack_info;
     vtype_kind_t saved_stack_vtype;
@@ -249,12 +284,32 @@ struct _emit_t {
     ASM_T *as;
 };
 
-STATIC const uint8_t reg_local_table[REG_LOCAL_NUM] = {REG_LOCAL_1, REG_LOCAL_2, REG_LOCAL_3};
+STATIC const uint8_t reg_local_table[REG_LOCAL_NUM] = {
+    REG_LOCAL_1, REG_LOCAL_2, REG_LOCAL_3,
+    #if REG_LOCAL_NUM >= 4
+    REG_LOCAL_4,
+    #endif
+    #if REG_LOCAL_NUM >= 5
+    REG_LOCAL_5,
+    #endif
+};
 
 STATIC void emit_native_global_exc_entry(emit_t *emit);
 STATIC void emit_native_global_exc_exit(emit_t *emit);
 STATIC void emit_native_load_const_obj(emit_t *emit, mp_obj_t obj);
 
+// Returns the register caching the given local, or -1 if it lives in memory.
+STATIC int emit_native_local_to_reg(emit_t *emit, mp_uint_t local_num) {
+    if (CAN_USE_REGS_FOR_LOCALS(emit)) {
+        for (size_t i = 0; i < emit->local_reg_count; ++i) {
+            if (emit->local_reg_map[i] == local_num) {
+                return reg_local_table[i];
+            }
+        }
+    }
+    return -1;
+}
+
 emit_t *EXPORT_FUN(new)(mp_obj_t * error_slot, uint *label_slot, mp_uint_t max_num_labels) {
     emit_t *emit = m_new0(emit_t, 1);
     emit->error_slot = error_slot;
@@ -272,6 +327,7 @@ void EXPORT_FUN(free)(emit_t * emit) {
     mp_asm_base_deinit(&emit->as->base, false);
     m_del_obj(ASM_T, emit->as);
     m_del(exc_stack_entry_t, emit->exc_stack, emit->exc_stack_alloc);
+    m_del(uint16_t, emit->local_use_count, emit->local_vtype_alloc);
     m_del(vtype_kind_t, emit->local_vtype, emit->local_vtype_alloc);
     m_del(stack_info_t, emit->stack_info, emit->stack_info_alloc);
     m_del_obj(emit_t, emit);
@@ -370,12 +426,48 @@ STATIC void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
     emit->last_emit_was_return_value = false;
     emit->scope = scope;
 
-    // allocate memory for keeping track of the types of locals
+    // allocate memory for keeping track of the types and use counts of locals
     if (emit->local_vtype_alloc < scope->num_locals) {
         emit->local_vtype = m_renew(vtype_kind_t, emit->local_vtype, emit->local_vtype_alloc, scope->num_locals);
+        emit->local_use_count = m_renew(uint16_t, emit->local_use_count, emit->local_vtype_alloc, scope->num_locals);
         emit->local_vtype_alloc = scope->num_locals;
     }
 
+    // Decide which locals are cached in registers.  The first pass counts
+    // accesses to each local, and later passes assign the registers to the
+    // most used locals (except for viper code, where the calling convention
+    // relies on the first locals being in the first registers).
+    emit->local_reg_count = REG_LOCAL_NUM;
+    for (size_t i = 0; i < REG_LOCAL_NUM; ++i) {
+        emit->local_reg_map[i] = i;
+    }
+    if (pass == MP_PASS_STACK_SIZE) {
+        memset(emit->local_use_count, 0, scope->num_locals * sizeof(*emit->local_use_count));
+    } else if (!emit->do_viper_types) {
+        size_t slot = 0;
+        while (slot < REG_LOCAL_NUM) {
+            // find the most used local that doesn't yet have a register
+            int best = -1;
+            for (size_t i = 0; i < scope->num_locals; ++i) {
+                if (emit->local_use_count[i] == 0) {
+                    continue;
+                }
+                bool taken = false;
+                for (size_t j = 0; j < slot; ++j) {
+                    taken = taken || emit->local_reg_map[j] == i;
+                }
+                if (!taken && (best < 0 || emit->local_use_count[i] > emit->local_use_count[best])) {
+                    best = i;
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+            emit->local_reg_map[slot++] = best;
+        }
+        emit->local_reg_count = slot;
+    }
+
     // set default type for arguments
     mp_uint_t num_args = emit->scope->num_pos_args + emit->scope->num_kwonly_args;
     if (scope->scope_flags & MP_SCOPE_FLAG_VARARGS) {
@@ -430,9 +522,11 @@ STATIC void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
             if (num_locals_in_regs > REG_LOCAL_NUM) {
                 num_locals_in_regs = REG_LOCAL_NUM;
             }
-            // Need a spot for REG_LOCAL_3 if 4 or more args (see below)
-            if (scope->num_pos_args >= 4) {
-                --num_locals_in_regs;
+            // Need a spot for REG_LOCAL_3 if 4 or more args (see below).  Only
+            // locals 0 and 1 can go without a slot, because slots are allocated
+            // contiguously from the end and local 2 must be backed by one.
+            if (scope->num_pos_args >= 4 && num_locals_in_regs > 2) {
+                num_locals_in_regs = 2;
             }
         }
 
@@ -511,7 +605,10 @@ STATIC void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
 
         if (emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) {
             emit->code_state_start = 0;
-            emit->stack_start = SIZEOF_CODE_STATE;
+            // Reserve 3 words at the start of the state for the pending
+            // exception, unwind-jump target and return value, all of which
+            // must be saved across a yield
+            emit->stack_start = SIZEOF_CODE_STATE + 3;
             #if N_PRELUDE_AS_BYTES_OBJ
             // Load index of prelude bytes object in const_table
             mp_asm_base_data(&emit->as->base, ASM_WORD_SIZE, (uintptr_t)(emit->scope->num_pos_args + emit->scope->num_kwonly_args + 1));
@@ -588,6 +685,51 @@ STATIC void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
             // Set code_state.n_state (only works on little endian targets due to n_state being uint16_t)
             emit_native_mov_state_imm_via(emit, emit->code_state_start + offsetof(mp_code_state_t, n_state) / sizeof(uintptr_t), emit->n_state, REG_ARG_1);
 
+            // For simple signatures, emit an inline fast path that stores the
+            // arguments directly into the state and skips the (relatively
+            // expensive) call to mp_setup_code_state.  Only worth it for a
+            // small number of args/locals, otherwise the emitted code is too
+            // big.  Labels label_slot+4/+5 are free here (they are only used
+            // by the viper entry above).
+            bool has_cell_locals = false;
+            for (mp_uint_t i = 0; i < scope->id_info_len; i++) {
+                if (scope->id_info[i].kind == ID_INFO_KIND_CELL) {
+                    has_cell_locals = true;
+                }
+            }
+            #if MICROPY_STACKLESS || MICROPY_PY_SYS_SETTRACE
+            bool fast_entry = false; // mp_setup_code_state inits extra code_state fields
+            #else
+            bool fast_entry = !has_cell_locals
+                && scope->num_kwonly_args == 0 && scope->num_def_pos_args == 0
+                && (scope->scope_flags & (MP_SCOPE_FLAG_VARARGS | MP_SCOPE_FLAG_VARKEYWORDS | MP_SCOPE_FLAG_DEFKWARGS)) == 0
+                && scope->num_pos_args <= 4 && scope->num_locals <= 8;
+            #endif
+            (void)has_cell_locals;
+
+            if (fast_entry) {
+                // Take the slow path if there are keyword args or the wrong number of positional args
+                ASM_JUMP_IF_REG_NONZERO(emit->as, REG_PARENT_ARG_3, *emit->label_slot + 4, true);
+                ASM_MOV_REG_IMM(emit->as, REG_PARENT_ARG_1, scope->num_pos_args);
+                ASM_XOR_REG_REG(emit->as, REG_PARENT_ARG_1, REG_PARENT_ARG_2);
+                ASM_JUMP_IF_REG_NONZERO(emit->as, REG_PARENT_ARG_1, *emit->label_slot + 4, true);
+
+                // Store arguments into their local slots
+                for (int i = 0; i < scope->num_pos_args; i++) {
+                    ASM_LOAD_REG_REG_OFFSET(emit->as, REG_PARENT_ARG_1, REG_PARENT_ARG_4, i);
+                    ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_LOCAL_VAR(emit, i), REG_PARENT_ARG_1);
+                }
+
+                // Clear the remaining locals, as mp_setup_code_state would
+                ASM_XOR_REG_REG(emit->as, REG_PARENT_ARG_1, REG_PARENT_ARG_1);
+                for (int i = scope->num_pos_args; i < scope->num_locals; i++) {
+                    ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_LOCAL_VAR(emit, i), REG_PARENT_ARG_1);
+                }
+
+                ASM_JUMP(emit->as, *emit->label_slot + 5);
+                mp_asm_base_label_assign(&emit->as->base, *emit->label_slot + 4);
+            }
+
             // Put address of code_state into first arg
             ASM_MOV_REG_LOCAL_ADDR(emit->as, REG_ARG_1, emit->code_state_start);
 
@@ -610,14 +752,18 @@ STATIC void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
             #else
             ASM_CALL_IND(emit->as, MP_F_SETUP_CODE_STATE);
             #endif
+
+            if (fast_entry) {
+                mp_asm_base_label_assign(&emit->as->base, *emit->label_slot + 5);
+            }
         }
 
         emit_native_global_exc_entry(emit);
 
         // cache some locals in registers, but only if no exception handlers
         if (CAN_USE_REGS_FOR_LOCALS(emit)) {
-            for (int i = 0; i < REG_LOCAL_NUM && i < scope->num_locals; ++i) {
-                ASM_MOV_REG_LOCAL(emit->as, reg_local_table[i], LOCAL_IDX_LOCAL_VAR(emit, i));
+            for (int i = 0; i < emit->local_reg_count && emit->local_reg_map[i] < scope->num_locals; ++i) {
+                ASM_MOV_REG_LOCAL(emit->as, reg_local_table[i], LOCAL_IDX_LOCAL_VAR(emit, emit->local_reg_map[i]));
             }
         }
 
@@ -659,6 +805,11 @@ STATIC void emit_native_end_pass(emit_t *emit) {
         emit->prelude_offset = mp_asm_base_get_code_pos(&emit->as->base);
 
         size_t n_state = emit->n_state;
+        if (emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) {
+            // Account for the 3 words of pending exception/unwind/return
+            // state, so the generator object is allocated big enough
+            n_state += 3;
+        }
         size_t n_exc_stack = 0; // exc-stack not needed for native code
         MP_BC_PRELUDE_SIG_ENCODE(n_state, n_exc_stack, emit->scope, emit_native_write_code_info_byte, emit);
 
@@ -1300,6 +1451,16 @@ STATIC void emit_native_global_exc_entry(emit_t *emit) {
 }
 
 STATIC void emit_native_global_exc_exit(emit_t *emit) {
+    if (emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) {
+        // Generator return path, the target of the unwind in return_value:
+        // load the saved return value and kind, then fall through to exit
+        emit_native_label_assign(emit, emit->exit_label + 4);
+        emit_native_mov_reg_state_addr(emit, REG_TEMP0, LOCAL_IDX_GEN_PENDING_RET_VAL(emit));
+        emit_native_mov_state_reg(emit, OFFSETOF_CODE_STATE_SP, REG_TEMP0);
+        ASM_MOV_REG_IMM(emit->as, REG_TEMP0, MP_VM_RETURN_NORMAL);
+        ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_RET_VAL(emit), REG_TEMP0);
+    }
+
     // Label for end of function
     emit_native_label_assign(emit, emit->exit_label);
 
@@ -1442,9 +1603,13 @@ STATIC void emit_native_load_fast(emit_t *emit, qstr qst, mp_uint_t local_num) {
     if (vtype == VTYPE_UNBOUND) {
         EMIT_NATIVE_VIPER_TYPE_ERROR(emit, MP_ERROR_TEXT("local '%q' used before type known"), qst);
     }
+    if (emit->pass == MP_PASS_STACK_SIZE && emit->local_use_count[local_num] < UINT16_MAX) {
+        ++emit->local_use_count[local_num];
+    }
     emit_native_pre(emit);
-    if (local_num < REG_LOCAL_NUM && CAN_USE_REGS_FOR_LOCALS(emit)) {
-        emit_post_push_reg(emit, vtype, reg_local_table[local_num]);
+    int reg = emit_native_local_to_reg(emit, local_num);
+    if (reg >= 0) {
+        emit_post_push_reg(emit, vtype, reg);
     } else {
         need_reg_single(emit, REG_TEMP0, 0);
         emit_native_mov_reg_state(emit, REG_TEMP0, LOCAL_IDX_LOCAL_VAR(emit, local_num));
@@ -1560,6 +1725,8 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
             int reg_base = REG_ARG_1;
             int reg_index = REG_ARG_2;
             emit_pre_pop_reg_flexible(emit, &vtype_base, &reg_base, reg_index, reg_index);
+            need_reg_single(emit, reg_index, 0);
+            need_reg_single(emit, REG_RET, 0);
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
@@ -1623,6 +1790,7 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
             int reg_index = REG_ARG_2;
             emit_pre_pop_reg_flexible(emit, &vtype_index, &reg_index, REG_ARG_1, REG_ARG_1);
             emit_pre_pop_reg(emit, &vtype_base, REG_ARG_1);
+            need_reg_single(emit, REG_RET, 0);
             if (vtype_index != VTYPE_INT && vtype_index != VTYPE_UINT) {
                 EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                     MP_ERROR_TEXT("can't load with '%q' index"), vtype_to_qstr(vtype_index));
@@ -1630,24 +1798,52 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb ldrb r1, [r2, r3]
+                    #if N_THUMB
+                    asm_thumb_ldrb_rlo_rlo_rlo(emit->as, REG_RET, REG_ARG_1, reg_index); // load from (base+index)
+                    break;
+                    #elif N_ARM
+                    asm_arm_ldrb_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index); // load from (base+index)
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
-                    ASM_LOAD8_REG_REG(emit->as, REG_RET, REG_ARG_1); // store value to (base+index)
+                    ASM_LOAD8_REG_REG(emit->as, REG_RET, REG_ARG_1); // load from (base+index)
                     break;
                 }
                 case VTYPE_PTR16: {
                     // pointer to 16-bit memory
+                    #if N_THUMB
+                    asm_thumb_lsl_rlo_rlo_i5(emit->as, REG_RET, reg_index, 1); // scale index by 2
+                    asm_thumb_ldrh_rlo_rlo_rlo(emit->as, REG_RET, REG_ARG_1, REG_RET); // load from (base+2*index)
+                    break;
+                    #elif N_ARM
+                    asm_arm_ldrh_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index); // load from (base+2*index)
+                    break;
+                    #elif N_XTENSA || N_XTENSAWIN
+                    asm_xtensa_op_addx2(emit->as, REG_ARG_1, reg_index, REG_ARG_1); // add 2*index to base
+                    #else
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
+                    #endif
                     ASM_LOAD16_REG_REG(emit->as, REG_RET, REG_ARG_1); // load from (base+2*index)
                     break;
                 }
                 case VTYPE_PTR32: {
                     // pointer to word-size memory
+                    #if N_THUMB
+                    asm_thumb_lsl_rlo_rlo_i5(emit->as, REG_RET, reg_index, 2); // scale index by 4
+                    asm_thumb_ldr_rlo_rlo_rlo(emit->as, REG_RET, REG_ARG_1, REG_RET); // load from (base+4*index)
+                    break;
+                    #elif N_ARM
+                    asm_arm_ldr_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index); // load from (base+4*index)
+                    break;
+                    #elif N_XTENSA || N_XTENSAWIN
+                    asm_xtensa_op_addx4(emit->as, REG_ARG_1, reg_index, REG_ARG_1); // add 4*index to base
+                    #else
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
+                    #endif
                     ASM_LOAD32_REG_REG(emit->as, REG_RET, REG_ARG_1); // load from (base+4*index)
                     break;
                 }
@@ -1661,9 +1857,13 @@ STATIC void emit_native_load_subscr(emit_t *emit) {
 }
 
 STATIC void emit_native_store_fast(emit_t *emit, qstr qst, mp_uint_t local_num) {
+    if (emit->pass == MP_PASS_STACK_SIZE && emit->local_use_count[local_num] < UINT16_MAX) {
+        ++emit->local_use_count[local_num];
+    }
     vtype_kind_t vtype;
-    if (local_num < REG_LOCAL_NUM && CAN_USE_REGS_FOR_LOCALS(emit)) {
-        emit_pre_pop_reg(emit, &vtype, reg_local_table[local_num]);
+    int reg = emit_native_local_to_reg(emit, local_num);
+    if (reg >= 0) {
+        emit_pre_pop_reg(emit, &vtype, reg);
     } else {
         emit_pre_pop_reg(emit, &vtype, REG_TEMP0);
         emit_native_mov_state_reg(emit, LOCAL_IDX_LOCAL_VAR(emit, local_num), REG_TEMP0);
@@ -1776,6 +1976,7 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
             #else
             emit_pre_pop_reg_flexible(emit, &vtype_value, &reg_value, reg_base, reg_index);
             #endif
+            need_reg_single(emit, reg_index, 0);
             if (vtype_value != VTYPE_BOOL && vtype_value != VTYPE_INT && vtype_value != VTYPE_UINT) {
                 EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                     MP_ERROR_TEXT("can't store '%q'"), vtype_to_qstr(vtype_value));
@@ -1870,8 +2071,10 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb strb r1, [r2, r3]
-                    #if N_ARM
+                    #if N_THUMB
+                    asm_thumb_strb_rlo_rlo_rlo(emit->as, reg_value, REG_ARG_1, reg_index); // store value to (base+index)
+                    break;
+                    #elif N_ARM
                     asm_arm_strb_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
                     #endif
@@ -1881,9 +2084,20 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                 }
                 case VTYPE_PTR16: {
                     // pointer to 16-bit memory
-                    #if N_ARM
+                    #if N_THUMB
+                    if (reg_index != REG_RET && reg_value != REG_RET) {
+                        need_reg_single(emit, REG_RET, 0);
+                        asm_thumb_lsl_rlo_rlo_i5(emit->as, REG_RET, reg_index, 1); // scale index by 2
+                        asm_thumb_strh_rlo_rlo_rlo(emit->as, reg_value, REG_ARG_1, REG_RET); // store value to (base+2*index)
+                        break;
+                    }
+                    #elif N_ARM
                     asm_arm_strh_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    #elif N_XTENSA || N_XTENSAWIN
+                    asm_xtensa_op_addx2(emit->as, REG_ARG_1, reg_index, REG_ARG_1); // add 2*index to base
+                    ASM_STORE16_REG_REG(emit->as, reg_value, REG_ARG_1); // store value to (base+2*index)
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1892,9 +2106,20 @@ STATIC void emit_native_store_subscr(emit_t *emit) {
                 }
                 case VTYPE_PTR32: {
                     // pointer to 32-bit memory
-                    #if N_ARM
+                    #if N_THUMB
+                    if (reg_index != REG_RET && reg_value != REG_RET) {
+                        need_reg_single(emit, REG_RET, 0);
+                        asm_thumb_lsl_rlo_rlo_i5(emit->as, REG_RET, reg_index, 2); // scale index by 4
+                        asm_thumb_str_rlo_rlo_rlo(emit->as, reg_value, REG_ARG_1, REG_RET); // store value to (base+4*index)
+                        break;
+                    }
+                    #elif N_ARM
                     asm_arm_str_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    #elif N_XTENSA || N_XTENSAWIN
+                    asm_xtensa_op_addx4(emit->as, REG_ARG_1, reg_index, REG_ARG_1); // add 4*index to base
+                    ASM_STORE32_REG_REG(emit->as, reg_value, REG_ARG_1); // store value to (base+4*index)
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -2303,6 +2528,19 @@ STATIC void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
     if (vtype == VTYPE_PYOBJ) {
         emit_call_with_imm_arg(emit, MP_F_UNARY_OP, op, REG_ARG_1);
         emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
+    #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+    } else if (vtype == VTYPE_FLOAT && (op == MP_UNARY_OP_POSITIVE || op == MP_UNARY_OP_NEGATIVE)) {
+        if (op == MP_UNARY_OP_POSITIVE) {
+            emit_post_push_reg(emit, VTYPE_FLOAT, REG_ARG_2);
+        } else {
+            // compute 0.0 - x; the raw bits of 0.0 are all zero
+            need_reg_single(emit, REG_ARG_3, 0);
+            ASM_MOV_REG_REG(emit->as, REG_ARG_3, REG_ARG_2);
+            ASM_MOV_REG_IMM(emit->as, REG_ARG_2, 0);
+            emit_call_with_imm_arg(emit, MP_F_NATIVE_FLOAT_BINARY_OP, MP_BINARY_OP_SUBTRACT, REG_ARG_1);
+            emit_post_push_reg(emit, VTYPE_FLOAT, REG_RET);
+        }
+    #endif
     } else {
         adjust_stack(emit, 1);
         EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
@@ -2310,10 +2548,103 @@ STATIC void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
     }
 }
 
+#if NATIVE_SMALLINT_ARITH
+// Emit a speculative inline fast path for + and - on two small ints: check the
+// tag bits of both operands and do the arithmetic inline with an overflow
+// check, falling back to the mp_binary_op call if anything doesn't fit.  On
+// entry the operands are in REG_ARG_2/REG_ARG_3 and on exit the result is in
+// REG_RET, just like the runtime call.  Uses REG_TEMP0 and the two Python
+// stack slots just vacated by the operands as scratch (some archs have no
+// other free register).
+// Note: 2 labels are reserved for this, starting at *emit->label_slot.
+STATIC void emit_native_smallint_arith(emit_t *emit, mp_binary_op_t op) {
+    mp_uint_t fallback_label = *emit->label_slot;
+    mp_uint_t done_label = *emit->label_slot + 1;
+
+    // Spill any stack entries cached in registers now, so the spills are
+    // emitted on both paths below
+    need_reg_all(emit);
+
+    // Save the operands for the fallback call
+    size_t local_lhs = emit->stack_start + emit->stack_size;
+    size_t local_rhs = emit->stack_start + emit->stack_size + 1;
+    emit_native_mov_state_reg(emit, local_lhs, REG_ARG_2);
+    emit_native_mov_state_reg(emit, local_rhs, REG_ARG_3);
+
+    // Fall back if the tag bits of both operands are not set
+    ASM_MOV_REG_IMM(emit->as, REG_TEMP0, 1);
+    ASM_AND_REG_REG(emit->as, REG_TEMP0, REG_ARG_2);
+    ASM_AND_REG_REG(emit->as, REG_TEMP0, REG_ARG_3);
+    ASM_JUMP_IF_REG_ZERO(emit->as, REG_TEMP0, fallback_label, true);
+
+    if (op == MP_BINARY_OP_ADD || op == MP_BINARY_OP_INPLACE_ADD) {
+        // lhs + (rhs - 1) gives the tagged result directly, and has signed
+        // machine overflow exactly when the result doesn't fit in a small int
+        ASM_SUB_REG_REG(emit->as, REG_ARG_2, REG_TEMP0); // lhs - 1
+        ASM_MOV_REG_REG(emit->as, REG_TEMP0, REG_ARG_2);
+        ASM_ADD_REG_REG(emit->as, REG_ARG_2, REG_ARG_3); // tagged result
+        // overflow iff (res ^ (lhs - 1)) & (res ^ rhs) has its sign bit set
+        ASM_XOR_REG_REG(emit->as, REG_TEMP0, REG_ARG_2);
+        ASM_XOR_REG_REG(emit->as, REG_ARG_3, REG_ARG_2);
+        ASM_AND_REG_REG(emit->as, REG_TEMP0, REG_ARG_3);
+    } else {
+        // lhs - rhs gives twice the result value, and has signed machine
+        // overflow exactly when the result doesn't fit in a small int
+        ASM_MOV_REG_REG(emit->as, REG_TEMP0, REG_ARG_2);
+        ASM_XOR_REG_REG(emit->as, REG_TEMP0, REG_ARG_3); // lhs ^ rhs
+        ASM_SUB_REG_REG(emit->as, REG_ARG_2, REG_ARG_3); // 2 * result
+        // overflow iff (lhs ^ rhs) & (res ^ lhs) has its sign bit set
+        emit_native_mov_reg_state(emit, REG_ARG_3, local_lhs);
+        ASM_XOR_REG_REG(emit->as, REG_ARG_3, REG_ARG_2);
+        ASM_AND_REG_REG(emit->as, REG_TEMP0, REG_ARG_3);
+    }
+    ASM_MOV_REG_IMM(emit->as, REG_ARG_3, (mp_uint_t)1 << (8 * ASM_WORD_SIZE - 1));
+    ASM_AND_REG_REG(emit->as, REG_TEMP0, REG_ARG_3);
+    ASM_JUMP_IF_REG_NONZERO(emit->as, REG_TEMP0, fallback_label, false);
+    if (op != MP_BINARY_OP_ADD && op != MP_BINARY_OP_INPLACE_ADD) {
+        // Tag the result of the subtraction
+        ASM_MOV_REG_IMM(emit->as, REG_ARG_3, 1);
+        ASM_ADD_REG_REG(emit->as, REG_ARG_2, REG_ARG_3);
+    }
+    ASM_MOV_REG_REG(emit->as, REG_RET, REG_ARG_2);
+    ASM_JUMP(emit->as, done_label);
+
+    // Fall back to the runtime call, restoring the original operands
+    mp_asm_base_label_assign(&emit->as->base, fallback_label);
+    emit_native_mov_reg_state(emit, REG_ARG_2, local_lhs);
+    emit_native_mov_reg_state(emit, REG_ARG_3, local_rhs);
+    emit_call_with_imm_arg(emit, MP_F_BINARY_OP, op, REG_ARG_1);
+
+    mp_asm_base_label_assign(&emit->as->base, done_label);
+}
+#endif
+
 STATIC void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
     DEBUG_printf("binary_op(" UINT_FMT ")\n", op);
     vtype_kind_t vtype_lhs = peek_vtype(emit, 1);
     vtype_kind_t vtype_rhs = peek_vtype(emit, 0);
+    #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+    if (vtype_lhs == VTYPE_FLOAT && vtype_rhs == VTYPE_FLOAT) {
+        // for floats, inplace and normal ops are equivalent, so use just normal ops
+        if (MP_BINARY_OP_INPLACE_OR <= op && op <= MP_BINARY_OP_INPLACE_POWER) {
+            op += MP_BINARY_OP_OR - MP_BINARY_OP_INPLACE_OR;
+        }
+        if (op == MP_BINARY_OP_ADD || op == MP_BINARY_OP_SUBTRACT
+            || op == MP_BINARY_OP_MULTIPLY || op == MP_BINARY_OP_TRUE_DIVIDE
+            || (MP_BINARY_OP_LESS <= op && op <= MP_BINARY_OP_NOT_EQUAL)) {
+            // dispatch to the runtime helper, passing the raw float bits
+            emit_pre_pop_reg_reg(emit, &vtype_rhs, REG_ARG_3, &vtype_lhs, REG_ARG_2);
+            emit_call_with_imm_arg(emit, MP_F_NATIVE_FLOAT_BINARY_OP, op, REG_ARG_1);
+            bool is_cmp = MP_BINARY_OP_LESS <= op && op <= MP_BINARY_OP_NOT_EQUAL;
+            emit_post_push_reg(emit, is_cmp ? VTYPE_BOOL : VTYPE_FLOAT, REG_RET);
+        } else {
+            adjust_stack(emit, -1);
+            EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                MP_ERROR_TEXT("binary op %q not implemented"), mp_binary_op_method_name[op]);
+        }
+        return;
+    }
+    #endif
     if ((vtype_lhs == VTYPE_INT || vtype_lhs == VTYPE_UINT)
         && (vtype_rhs == VTYPE_INT || vtype_rhs == VTYPE_UINT)) {
         // for integers, inplace and normal ops are equivalent, so use just normal ops
@@ -2559,7 +2890,15 @@ STATIC void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
             invert = true;
             op = MP_BINARY_OP_IS;
         }
-        emit_call_with_imm_arg(emit, MP_F_BINARY_OP, op, REG_ARG_1);
+        #if NATIVE_SMALLINT_ARITH
+        if (op == MP_BINARY_OP_ADD || op == MP_BINARY_OP_INPLACE_ADD
+            || op == MP_BINARY_OP_SUBTRACT || op == MP_BINARY_OP_INPLACE_SUBTRACT) {
+            emit_native_smallint_arith(emit, op);
+        } else
+        #endif
+        {
+            emit_call_with_imm_arg(emit, MP_F_BINARY_OP, op, REG_ARG_1);
+        }
         if (invert) {
             ASM_MOV_REG_REG(emit->as, REG_ARG_2, REG_RET);
             emit_call_with_imm_arg(emit, MP_F_UNARY_OP, MP_UNARY_OP_NOT, REG_ARG_1);
@@ -2740,6 +3079,9 @@ STATIC void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
             case VTYPE_PTR8:
             case VTYPE_PTR16:
             case VTYPE_PTR32:
+            #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+            case VTYPE_FLOAT:
+            #endif
             case VTYPE_PTR_NONE:
                 emit_fold_stack_top(emit, REG_ARG_1);
                 emit_post_top_set_vtype(emit, vtype_cast);
@@ -2782,16 +3124,19 @@ STATIC void emit_native_return_value(emit_t *emit) {
     DEBUG_printf("return_value\n");
 
     if (emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) {
-        // Save pointer to current stack position for caller to access return value
-        emit_get_stack_pointer_to_reg_for_pop(emit, REG_TEMP0, 1);
-        emit_native_mov_state_reg(emit, OFFSETOF_CODE_STATE_SP, REG_TEMP0);
-
-        // Put return type in return value slot
-        ASM_MOV_REG_IMM(emit->as, REG_TEMP0, MP_VM_RETURN_NORMAL);
-        ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_RET_VAL(emit), REG_TEMP0);
+        // Save the return value in the persistent state: the stack slot it
+        // occupies may be reused by a finally block on the way out (and is
+        // lost entirely if such a finally contains a yield).  The return
+        // kind and sp are only set at the return exit point below the
+        // unwind, because LOCAL_IDX_RET_VAL aliases an nlr reg-save slot
+        // and writing it here would corrupt the registers restored if a
+        // finally on the way out raises
+        vtype_kind_t vtype;
+        emit_pre_pop_reg(emit, &vtype, REG_TEMP0);
+        emit_native_mov_state_reg(emit, LOCAL_IDX_GEN_PENDING_RET_VAL(emit), REG_TEMP0);
 
         // Do the unwinding jump to get to the return handler
-        emit_native_unwind_jump(emit, emit->exit_label, emit->exc_stack_size);
+        emit_native_unwind_jump(emit, emit->exit_label + 4, emit->exc_stack_size);
         emit->last_emit_was_return_value = true;
         return;
     }
@@ -2861,13 +3206,30 @@ STATIC void emit_native_yield(emit_t *emit, int kind) {
         //     for item in generator:
         //         yield item
 
+        // Save the pending exception for when the loop finishes; while the
+        // loop runs LOCAL_IDX_EXC_VAL carries any value injected into this
+        // generator by throw/close (refreshed on each resume by the entry
+        // code), so it must start out clear
+        ASM_MOV_REG_LOCAL(emit->as, REG_TEMP0, LOCAL_IDX_EXC_VAL(emit));
+        emit_native_mov_state_reg(emit, LOCAL_IDX_GEN_PENDING_EXC(emit), REG_TEMP0);
+        ASM_MOV_REG_IMM(emit->as, REG_TEMP0, (mp_uint_t)MP_OBJ_NULL);
+        ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_EXC_VAL(emit), REG_TEMP0);
+
         // Jump to start of loop
         emit_native_jump(emit, *emit->label_slot + 2);
 
         // Label for top of loop
         emit_native_label_assign(emit, *emit->label_slot + 1);
+    } else {
+        // Save the pending exception, to restore on resume
+        ASM_MOV_REG_LOCAL(emit->as, REG_TEMP0, LOCAL_IDX_EXC_VAL(emit));
+        emit_native_mov_state_reg(emit, LOCAL_IDX_GEN_PENDING_EXC(emit), REG_TEMP0);
     }
 
+    // Save any unwind-jump target, to restore on resume
+    ASM_MOV_REG_LOCAL(emit->as, REG_TEMP0, LOCAL_IDX_EXC_HANDLER_UNWIND(emit));
+    emit_native_mov_state_reg(emit, LOCAL_IDX_GEN_PENDING_UNWIND(emit), REG_TEMP0);
+
     // Save pointer to current stack position for caller to access yielded value
     emit_get_stack_pointer_to_reg_for_pop(emit, REG_TEMP0, 1);
     emit_native_mov_state_reg(emit, OFFSETOF_CODE_STATE_SP, REG_TEMP0);
@@ -2900,11 +3262,18 @@ STATIC void emit_native_yield(emit_t *emit, int kind) {
         }
     }
 
+    // Restore any unwind-jump target (saved above, before the yield)
+    emit_native_mov_reg_state(emit, REG_TEMP0, LOCAL_IDX_GEN_PENDING_UNWIND(emit));
+    ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_EXC_HANDLER_UNWIND(emit), REG_TEMP0);
+
     emit_native_adjust_stack_size(emit, 1); // send_value
 
     if (kind == MP_EMIT_YIELD_VALUE) {
-        // Check LOCAL_IDX_EXC_VAL for any injected value
+        // Check LOCAL_IDX_EXC_VAL for any injected value, restoring the
+        // pending exception in its place
         ASM_MOV_REG_LOCAL(emit->as, REG_ARG_1, LOCAL_IDX_EXC_VAL(emit));
+        emit_native_mov_reg_state(emit, REG_ARG_2, LOCAL_IDX_GEN_PENDING_EXC(emit));
+        ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_EXC_VAL(emit), REG_ARG_2);
         emit_call(emit, MP_F_NATIVE_RAISE);
     } else {
         // Label loop entry
@@ -2922,6 +3291,10 @@ STATIC void emit_native_yield(emit_t *emit, int kind) {
         // If returned non-zero then generator continues
         ASM_JUMP_IF_REG_NONZERO(emit->as, REG_RET, *emit->label_slot + 1, true);
 
+        // Delegate generator is exhausted; restore the pending exception
+        emit_native_mov_reg_state(emit, REG_TEMP0, LOCAL_IDX_GEN_PENDING_EXC(emit));
+        ASM_MOV_LOCAL_REG(emit->as, LOCAL_IDX_EXC_VAL(emit), REG_TEMP0);
+
         // Pop exhausted gen, replace with ret_value
         emit_native_adjust_stack_size(emit, 1); // ret_value
         emit_fold_stack_top(emit, REG_ARG_1);
@@ -111,6 +111,36 @@ static const FPTYPE g_neg_pow[] = {
     MICROPY_FLOAT_CONST(1e-32), MICROPY_FLOAT_CONST(1e-16), MICROPY_FLOAT_CONST(1e-8), MICROPY_FLOAT_CONST(1e-4), MICROPY_FLOAT_CONST(1e-2), MICROPY_FLOAT_CONST(1e-1)
 };
 
+#if MICROPY_FLOAT_FORMAT_FAST
+
+// Digits are extracted from the mantissa in batches of FPCHUNK_MAX: one
+// float multiply brings the batch into the integer part, and the individual
+// digits then come out with integer divisions.  FPCHUNK_MAX is chosen so
+// the batched integer is always exactly representable in FPTYPE.
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT
+#define FPCHUNK_MAX 7 // 10^7 < 2^24
+typedef int32_t fpchunk_int_t;
+#else
+#define FPCHUNK_MAX 15 // 10^15 < 2^53
+typedef int64_t fpchunk_int_t;
+#endif
+
+static const FPTYPE g_chunk_pow[FPCHUNK_MAX] = {
+    FPCONST(1e0), FPCONST(1e1), FPCONST(1e2), FPCONST(1e3), FPCONST(1e4), FPCONST(1e5), FPCONST(1e6),
+    #if FPCHUNK_MAX > 7
+    FPCONST(1e7), FPCONST(1e8), FPCONST(1e9), FPCONST(1e10), FPCONST(1e11), FPCONST(1e12), FPCONST(1e13), FPCONST(1e14),
+    #endif
+};
+
+static const fpchunk_int_t g_chunk_div[FPCHUNK_MAX] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000,
+    #if FPCHUNK_MAX > 7
+    10000000, 100000000, 1000000000, 10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+    #endif
+};
+
+#endif // MICROPY_FLOAT_FORMAT_FAST
+
 int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, char sign) {
 
     char *s = buf;
@@ -337,6 +367,30 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
     }
 
     // Print the digits of the mantissa
+    #if MICROPY_FLOAT_FORMAT_FAST
+    for (int i = 0; i < num_digits;) {
+        int chunk = num_digits - i;
+        if (chunk > FPCHUNK_MAX) {
+            chunk = FPCHUNK_MAX;
+        }
+        FPTYPE scaled = f * g_chunk_pow[chunk - 1];
+        fpchunk_int_t d = (fpchunk_int_t)scaled;
+        if (d < 0) {
+            d = 0;
+        }
+        f = (scaled - (FPTYPE)d) * FPCONST(10.0);
+        fpchunk_int_t div = g_chunk_div[chunk - 1];
+        for (int j = 0; j < chunk; ++j, --dec) {
+            *s++ = '0' + (char)(d / div);
+            d %= div;
+            div /= 10;
+            if (dec == 0 && prec > 0) {
+                *s++ = '.';
+            }
+        }
+        i += chunk;
+    }
+    #else
     for (int i = 0; i < num_digits; ++i, --dec) {
         int32_t d = (int32_t)f;
         if (d < 0) {
@@ -350,6 +404,7 @@ int mp_format_float(FPTYPE f, char *buf, size_t buf_size, char fmt, int prec, ch
         f -= (FPTYPE)d;
         f *= FPCONST(10.0);
     }
+    #endif
 
     // Round
     // If we print non-exponential format (i.e. 'f'), but a digit we're going
@@ -31,6 +31,7 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
+#include "py/trace.h"
 
 #if MICROPY_ENABLE_GC
 
@@ -97,6 +98,40 @@
 #define FTB_CLEAR(block) do { MP_STATE_MEM(gc_finaliser_table_start)[(block) / BLOCKS_PER_FTB] &= (~(1 << ((block) & 7))); } while (0)
 #endif
 
+#if MICROPY_GC_GENERATIONAL
+// YTB = young table byte
+// if set, then the corresponding head block was allocated since the last collection
+
+#define BLOCKS_PER_YTB (8)
+
+#define YTB_GET(block) ((MP_STATE_MEM(gc_young_table_start)[(block) / BLOCKS_PER_YTB] >> ((block) & 7)) & 1)
+#define YTB_SET(block) do { MP_STATE_MEM(gc_young_table_start)[(block) / BLOCKS_PER_YTB] |= (1 << ((block) & 7)); } while (0)
+#define YTB_CLEAR(block) do { MP_STATE_MEM(gc_young_table_start)[(block) / BLOCKS_PER_YTB] &= (~(1 << ((block) & 7))); } while (0)
+
+#define YTB_LEN_BYTES ((MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB + BLOCKS_PER_YTB - 1) / BLOCKS_PER_YTB)
+#endif
+
+#if MICROPY_GC_DEFERRED_FINALISER
+
+#if !MICROPY_ENABLE_FINALISER || !MICROPY_ENABLE_SCHEDULER
+#error "MICROPY_GC_DEFERRED_FINALISER requires MICROPY_ENABLE_FINALISER and MICROPY_ENABLE_SCHEDULER"
+#endif
+
+// PTB = pending-finaliser table byte
+// if set, then the corresponding block has a finaliser waiting to be run
+
+#define BLOCKS_PER_PTB (8)
+
+#define PTB_GET(block) ((MP_STATE_MEM(gc_pending_final_table_start)[(block) / BLOCKS_PER_PTB] >> ((block) & 7)) & 1)
+#define PTB_SET(block) do { MP_STATE_MEM(gc_pending_final_table_start)[(block) / BLOCKS_PER_PTB] |= (1 << ((block) & 7)); } while (0)
+#define PTB_CLEAR(block) do { MP_STATE_MEM(gc_pending_final_table_start)[(block) / BLOCKS_PER_PTB] &= (~(1 << ((block) & 7))); } while (0)
+#endif
+
+#if MICROPY_GC_LARGE_FROM_TOP && MICROPY_GC_LARGE_FROM_TOP_BLOCKS <= MICROPY_ATB_INDICES
+// the free-block hints assume the forward scan covers all hinted size classes
+#error "MICROPY_GC_LARGE_FROM_TOP_BLOCKS must be bigger than MICROPY_ATB_INDICES"
+#endif
+
 #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
 #define GC_ENTER() mp_thread_mutex_lock(&MP_STATE_MEM(gc_mutex), 1)
 #define GC_EXIT() mp_thread_mutex_unlock(&MP_STATE_MEM(gc_mutex))
@@ -111,32 +146,55 @@ void gc_init(void *start, void *end) {
     end = (void *)((uintptr_t)end & (~(BYTES_PER_BLOCK - 1)));
     DEBUG_printf("Initializing GC heap: %p..%p = " UINT_FMT " bytes\n", start, end, (byte *)end - (byte *)start);
 
-    // calculate parameters for GC (T=total, A=alloc table, F=finaliser table, P=pool; all in bytes):
-    // T = A + F + P
+    // calculate parameters for GC (T=total, A=alloc table, F=finaliser table,
+    // Y=young table, D=pending-finaliser table, P=pool; all in bytes):
+    // T = A + F + Y + D + P
     //     F = A * BLOCKS_PER_ATB / BLOCKS_PER_FTB
+    //     Y = A * BLOCKS_PER_ATB / BLOCKS_PER_YTB
+    //     D = A * BLOCKS_PER_ATB / BLOCKS_PER_PTB
     //     P = A * BLOCKS_PER_ATB * BYTES_PER_BLOCK
-    // => T = A * (1 + BLOCKS_PER_ATB / BLOCKS_PER_FTB + BLOCKS_PER_ATB * BYTES_PER_BLOCK)
     size_t total_byte_len = (byte *)end - (byte *)start;
+    size_t bits_per_atb_byte = MP_BITS_PER_BYTE + MP_BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK;
     #if MICROPY_ENABLE_FINALISER
-    MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len * MP_BITS_PER_BYTE / (MP_BITS_PER_BYTE + MP_BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB + MP_BITS_PER_BYTE * BLOCKS_PER_ATB * BYTES_PER_BLOCK);
-    #else
-    MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len / (1 + MP_BITS_PER_BYTE / 2 * BYTES_PER_BLOCK);
+    bits_per_atb_byte += MP_BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_FTB;
+    #endif
+    #if MICROPY_GC_GENERATIONAL
+    bits_per_atb_byte += MP_BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_YTB;
     #endif
+    #if MICROPY_GC_DEFERRED_FINALISER
+    bits_per_atb_byte += MP_BITS_PER_BYTE * BLOCKS_PER_ATB / BLOCKS_PER_PTB;
+    #endif
+    MP_STATE_MEM(gc_alloc_table_byte_len) = total_byte_len * MP_BITS_PER_BYTE / bits_per_atb_byte;
 
     MP_STATE_MEM(gc_alloc_table_start) = (byte *)start;
 
+    // lay out the side tables (if any) directly after the alloc table
+    byte *table_end = MP_STATE_MEM(gc_alloc_table_start) + MP_STATE_MEM(gc_alloc_table_byte_len);
+
     #if MICROPY_ENABLE_FINALISER
     size_t gc_finaliser_table_byte_len = (MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB + BLOCKS_PER_FTB - 1) / BLOCKS_PER_FTB;
-    MP_STATE_MEM(gc_finaliser_table_start) = MP_STATE_MEM(gc_alloc_table_start) + MP_STATE_MEM(gc_alloc_table_byte_len);
+    MP_STATE_MEM(gc_finaliser_table_start) = table_end;
+    table_end += gc_finaliser_table_byte_len;
+    #endif
+
+    #if MICROPY_GC_GENERATIONAL
+    size_t gc_young_table_byte_len = YTB_LEN_BYTES;
+    MP_STATE_MEM(gc_young_table_start) = table_end;
+    table_end += gc_young_table_byte_len;
+    #endif
+
+    #if MICROPY_GC_DEFERRED_FINALISER
+    size_t gc_pending_final_table_byte_len = (MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB + BLOCKS_PER_PTB - 1) / BLOCKS_PER_PTB;
+    MP_STATE_MEM(gc_pending_final_table_start) = table_end;
+    table_end += gc_pending_final_table_byte_len;
     #endif
 
     size_t gc_pool_block_len = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
     MP_STATE_MEM(gc_pool_start) = (byte *)end - gc_pool_block_len * BYTES_PER_BLOCK;
     MP_STATE_MEM(gc_pool_end) = end;
 
-    #if MICROPY_ENABLE_FINALISER
-    assert(MP_STATE_MEM(gc_pool_start) >= MP_STATE_MEM(gc_finaliser_table_start) + gc_finaliser_table_byte_len);
-    #endif
+    assert(MP_STATE_MEM(gc_pool_start) >= table_end);
+    (void)table_end;
 
     // clear ATBs
     memset(MP_STATE_MEM(gc_alloc_table_start), 0, MP_STATE_MEM(gc_alloc_table_byte_len));
@@ -146,8 +204,23 @@ void gc_init(void *start, void *end) {
     memset(MP_STATE_MEM(gc_finaliser_table_start), 0, gc_finaliser_table_byte_len);
     #endif
 
-    // set last free ATB index to start of heap
-    MP_STATE_MEM(gc_last_free_atb_index) = 0;
+    #if MICROPY_GC_GENERATIONAL
+    // clear YTBs
+    memset(MP_STATE_MEM(gc_young_table_start), 0, gc_young_table_byte_len);
+    MP_STATE_MEM(gc_do_minor_collect) = 0;
+    #endif
+
+    #if MICROPY_GC_DEFERRED_FINALISER
+    // clear PTBs
+    memset(MP_STATE_MEM(gc_pending_final_table_start), 0, gc_pending_final_table_byte_len);
+    MP_STATE_MEM(gc_pending_finaliser_count) = 0;
+    MP_STATE_MEM(gc_pending_finaliser_scan) = 0;
+    #endif
+
+    // set first free ATB indices to start of heap
+    for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
+        MP_STATE_MEM(gc_first_free_atb_index)[i] = 0;
+    }
 
     // unlock the GC
     MP_STATE_THREAD(gc_lock_depth) = 0;
@@ -159,6 +232,10 @@ void gc_init(void *start, void *end) {
     // by default, maxuint for gc threshold, effectively turning gc-by-threshold off
     MP_STATE_MEM(gc_alloc_threshold) = (size_t)-1;
     MP_STATE_MEM(gc_alloc_amount) = 0;
+    #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+    // adaptive re-arming of the threshold is off until set via gc.tune()
+    MP_STATE_MEM(gc_threshold_growth) = 0;
+    #endif
     #endif
 
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
@@ -267,12 +344,23 @@ STATIC void gc_sweep(void) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
     #endif
+    #if MICROPY_TRACE
+    MP_STATE_MEM(gc_trace_swept_blocks) = 0;
+    #endif
+    #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+    size_t live_blocks = 0;
+    #endif
     // free unmarked heads and their tails
     int free_tail = 0;
     for (size_t block = 0; block < MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; block++) {
         switch (ATB_GET_KIND(block)) {
             case AT_HEAD:
-                #if MICROPY_ENABLE_FINALISER
+                #if MICROPY_GC_DEFERRED_FINALISER
+                // Finalisable objects were queued and resurrected by
+                // gc_queue_finalisers, so any finalisable block reaching here
+                // never had its type set; just clear the flag.
+                FTB_CLEAR(block);
+                #elif MICROPY_ENABLE_FINALISER
                 if (FTB_GET(block)) {
                     mp_obj_base_t *obj = (mp_obj_base_t *)PTR_FROM_BLOCK(block);
                     if (obj->type != NULL) {
@@ -305,28 +393,79 @@ STATIC void gc_sweep(void) {
             case AT_TAIL:
                 if (free_tail) {
                     ATB_ANY_TO_FREE(block);
+                    #if MICROPY_TRACE
+                    MP_STATE_MEM(gc_trace_swept_blocks)++;
+                    #endif
                     #if CLEAR_ON_SWEEP
                     memset((void *)PTR_FROM_BLOCK(block), 0, BYTES_PER_BLOCK);
                     #endif
                 }
+                #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+                else {
+                    live_blocks++;
+                }
+                #endif
                 break;
 
             case AT_MARK:
                 ATB_MARK_TO_HEAD(block);
                 free_tail = 0;
+                #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+                live_blocks++;
+                #endif
                 break;
         }
     }
+
+    #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+    if (MP_STATE_MEM(gc_threshold_growth) != 0) {
+        // Re-arm the allocation threshold so the next automatic collection
+        // happens once the heap has grown by the configured percentage of
+        // the memory that survived this one, with a floor to avoid
+        // collecting on every allocation when little or nothing survived.
+        size_t threshold = live_blocks * MP_STATE_MEM(gc_threshold_growth) / 100;
+        if (threshold < 64) {
+            threshold = 64;
+        }
+        MP_STATE_MEM(gc_alloc_threshold) = threshold;
+    }
+    #endif
 }
 
 void gc_collect_start(void) {
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
+    #if MICROPY_TRACE
+    mp_trace_event(MP_TRACE_EV_GC_START, 0, 0, 0);
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
 
+    #if MICROPY_GC_GENERATIONAL
+    if (MP_STATE_MEM(gc_do_minor_collect)) {
+        // Minor collection: treat every block allocated before the last
+        // collection as live.  First mark all old heads in a linear pass,
+        // then scan the contents of each old block for references into the
+        // young generation.  Since every old block is scanned, all
+        // old-to-young references are found and no write barrier is needed.
+        // The old object graph is never traced, so the pause is bounded by
+        // a linear scan of the heap plus the live young objects.
+        size_t n_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+        for (size_t block = 0; block < n_blocks; block++) {
+            if (ATB_GET_KIND(block) == AT_HEAD && !YTB_GET(block)) {
+                ATB_HEAD_TO_MARK(block);
+            }
+        }
+        for (size_t block = 0; block < n_blocks; block++) {
+            if (ATB_GET_KIND(block) == AT_MARK && !YTB_GET(block)) {
+                gc_mark_subtree(block);
+            }
+        }
+    }
+    #endif
+
     // Trace root pointers.  This relies on the root pointers being organised
     // correctly in the mp_state_ctx structure.  We scan nlr_top, dict_locals,
     // dict_globals, then the root pointer section of mp_state_vm.
@@ -367,19 +506,116 @@ void gc_collect_root(void **ptrs, size_t len) {
     }
 }
 
+#if MICROPY_GC_DEFERRED_FINALISER
+// Find unreachable finalisable objects and queue their finalisers to be run
+// later from mp_handle_pending, instead of during the sweep.  Each such
+// object is marked, along with everything reachable from it, so that it
+// stays intact until its finaliser has run; the memory is then reclaimed by
+// a subsequent collection (the finaliser clears the FTB bit).  Queueing is
+// done in two passes so that a finalisable object referenced by another
+// finalisable object is queued in the same cycle, before the marking of its
+// referrer's subtree hides it.
+STATIC void gc_queue_finalisers(void) {
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    for (size_t block = 0; block < total_blocks; block++) {
+        if (ATB_GET_KIND(block) == AT_HEAD && FTB_GET(block)
+            && ((mp_obj_base_t *)PTR_FROM_BLOCK(block))->type != NULL
+            && !PTB_GET(block)) {
+            PTB_SET(block);
+            MP_STATE_MEM(gc_pending_finaliser_count)++;
+            if (block < MP_STATE_MEM(gc_pending_finaliser_scan)) {
+                MP_STATE_MEM(gc_pending_finaliser_scan) = block;
+            }
+        }
+    }
+    for (size_t block = 0; block < total_blocks; block++) {
+        if (ATB_GET_KIND(block) == AT_HEAD && PTB_GET(block)) {
+            ATB_HEAD_TO_MARK(block);
+            gc_mark_subtree(block);
+        }
+    }
+    if (MP_STATE_MEM(gc_pending_finaliser_count) != 0 && MP_STATE_VM(sched_state) == MP_SCHED_IDLE) {
+        // make the VM call mp_handle_pending so the queue gets drained
+        MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
+    }
+}
+
+// Run at most one queued finaliser; called from mp_handle_pending_tail with
+// the scheduler locked, so the call cannot re-enter itself.
+void gc_finaliser_run_one(void) {
+    GC_ENTER();
+    mp_obj_base_t *obj = NULL;
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    size_t block = MP_STATE_MEM(gc_pending_finaliser_scan);
+    while (MP_STATE_MEM(gc_pending_finaliser_count) != 0 && block < total_blocks) {
+        if (PTB_GET(block)) {
+            // Clear the flags first so the finaliser runs exactly once; the
+            // object is kept alive during the call by the C-stack reference.
+            PTB_CLEAR(block);
+            FTB_CLEAR(block);
+            MP_STATE_MEM(gc_pending_finaliser_count)--;
+            obj = (mp_obj_base_t *)PTR_FROM_BLOCK(block);
+            block++;
+            break;
+        }
+        block++;
+    }
+    MP_STATE_MEM(gc_pending_finaliser_scan) = block;
+    GC_EXIT();
+    if (obj != NULL) {
+        mp_obj_t dest[2];
+        mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
+        if (dest[0] != MP_OBJ_NULL) {
+            mp_call_function_1_protected(dest[0], dest[1]);
+        }
+    }
+}
+#endif // MICROPY_GC_DEFERRED_FINALISER
+
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
+    #if MICROPY_GC_DEFERRED_FINALISER
+    gc_queue_finalisers();
+    gc_deal_with_stack_overflow();
+    #endif
     gc_sweep();
-    MP_STATE_MEM(gc_last_free_atb_index) = 0;
+    #if MICROPY_GC_GENERATIONAL
+    // promote all surviving blocks to the old generation
+    memset(MP_STATE_MEM(gc_young_table_start), 0, YTB_LEN_BYTES);
+    MP_STATE_MEM(gc_do_minor_collect) = 0;
+    #endif
+    for (size_t i = 0; i < MICROPY_ATB_INDICES; i++) {
+        MP_STATE_MEM(gc_first_free_atb_index)[i] = 0;
+    }
+    #if MICROPY_TRACE
+    mp_trace_event(MP_TRACE_EV_GC_END, 0, MP_STATE_MEM(gc_trace_swept_blocks) * BYTES_PER_BLOCK, 0);
+    #endif
     MP_STATE_THREAD(gc_lock_depth)--;
     GC_EXIT();
 }
 
+#if MICROPY_GC_GENERATIONAL
+// Run a minor collection, which only reclaims blocks allocated since the
+// last collection (of either kind).  The port's gc_collect is reused so the
+// roots (including the C stack and registers) are scanned as usual.
+void gc_collect_minor(void) {
+    MP_STATE_MEM(gc_do_minor_collect) = 1;
+    gc_collect();
+    MP_STATE_MEM(gc_do_minor_collect) = 0;
+}
+#endif
+
 void gc_sweep_all(void) {
     GC_ENTER();
     MP_STATE_THREAD(gc_lock_depth)++;
     MP_STATE_MEM(gc_stack_overflow) = 0;
     gc_collect_end();
+    #if MICROPY_GC_DEFERRED_FINALISER
+    // this is a full shutdown/reset of the heap, so don't defer anything
+    while (MP_STATE_MEM(gc_pending_finaliser_count) != 0) {
+        gc_finaliser_run_one();
+    }
+    #endif
 }
 
 void gc_info(gc_info_t *info) {
@@ -446,6 +682,78 @@ void gc_info(gc_info_t *info) {
     GC_EXIT();
 }
 
+#if MICROPY_GC_THREAD_BLOCK_CACHE
+// Refill the calling thread's cache of free chunks of n_blocks blocks
+// (1 or 2).  The chunks are marked as allocated and zeroed here, under the
+// GC lock, so that taking one out of the cache later is a plain array pop
+// with no locking.  The cache itself lives in the thread's root pointer
+// section, which keeps the chunks alive across collections run by other
+// threads.
+STATIC void gc_thread_block_cache_refill(size_t n_blocks) {
+    #if MICROPY_GC_ALLOC_THRESHOLD
+    // cached chunks bypass the threshold check in gc_alloc, so apply it here
+    if (MP_STATE_MEM(gc_auto_collect_enabled) && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
+        gc_collect();
+    }
+    #endif
+
+    void **cache = &MP_STATE_THREAD(gc_block_cache)[n_blocks - 1][0];
+    size_t n_found = 0;
+
+    GC_ENTER();
+
+    size_t total_blocks = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB;
+    size_t n_free = 0;
+    size_t bl = MP_STATE_MEM(gc_first_free_atb_index)[n_blocks - 1] * BLOCKS_PER_ATB;
+    for (; bl < total_blocks; bl++) {
+        if (ATB_GET_KIND(bl) != AT_FREE) {
+            n_free = 0;
+            continue;
+        }
+        if (++n_free < n_blocks) {
+            continue;
+        }
+
+        // take the run of n_blocks free blocks ending at bl
+        size_t start_block = bl - n_blocks + 1;
+        ATB_FREE_TO_HEAD(start_block);
+        #if MICROPY_GC_GENERATIONAL
+        YTB_SET(start_block);
+        #endif
+        for (size_t b = start_block + 1; b <= bl; b++) {
+            ATB_FREE_TO_TAIL(b);
+        }
+        void *chunk = (void *)(MP_STATE_MEM(gc_pool_start) + start_block * BYTES_PER_BLOCK);
+        // zero the whole chunk now so the pop doesn't need to, and so a
+        // mark pass that reaches it via the cache retains nothing stale
+        memset(chunk, 0, n_blocks * BYTES_PER_BLOCK);
+        cache[n_found++] = chunk;
+        n_free = 0;
+        if (n_found == MICROPY_GC_THREAD_BLOCK_CACHE_SIZE) {
+            break;
+        }
+    }
+
+    // Every free run of n_blocks blocks fully before this point was
+    // consumed, so the hints for this size class and all larger ones can
+    // advance past it (cf the equivalent update in gc_alloc).
+    size_t next_free_atb = (bl + 1) / BLOCKS_PER_ATB;
+    for (size_t size_class = n_blocks - 1; size_class < MICROPY_ATB_INDICES; size_class++) {
+        if (MP_STATE_MEM(gc_first_free_atb_index)[size_class] < next_free_atb) {
+            MP_STATE_MEM(gc_first_free_atb_index)[size_class] = next_free_atb;
+        }
+    }
+
+    #if MICROPY_GC_ALLOC_THRESHOLD
+    MP_STATE_MEM(gc_alloc_amount) += n_found * n_blocks;
+    #endif
+
+    GC_EXIT();
+
+    MP_STATE_THREAD(gc_block_cache_len)[n_blocks - 1] = n_found;
+}
+#endif // MICROPY_GC_THREAD_BLOCK_CACHE
+
 void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     bool has_finaliser = alloc_flags & GC_ALLOC_FLAG_HAS_FINALISER;
     size_t n_blocks = ((n_bytes + BYTES_PER_BLOCK - 1) & (~(BYTES_PER_BLOCK - 1))) / BYTES_PER_BLOCK;
@@ -456,11 +764,36 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         return NULL;
     }
 
+    #if MICROPY_TRACE
+    mp_trace_alloc(n_blocks);
+    #endif
+
     // check if GC is locked
     if (MP_STATE_THREAD(gc_lock_depth) > 0) {
         return NULL;
     }
 
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    // fast path: serve small allocations from the per-thread cache of
+    // pre-marked, pre-zeroed chunks, without taking the GC lock
+    if (n_blocks <= 2 && !has_finaliser) {
+        size_t *len = &MP_STATE_THREAD(gc_block_cache_len)[n_blocks - 1];
+        if (*len == 0) {
+            gc_thread_block_cache_refill(n_blocks);
+        }
+        if (*len != 0) {
+            void **slot = &MP_STATE_THREAD(gc_block_cache)[n_blocks - 1][--(*len)];
+            void *ret_ptr = *slot;
+            // clear the slot so it can't keep a dead object alive later
+            *slot = NULL;
+            DEBUG_printf("gc_alloc(%p) from thread cache\n", ret_ptr);
+            return ret_ptr;
+        }
+        // the refill found nothing: fall through to the locked path, which
+        // can run a collection and retry
+    }
+    #endif
+
     GC_ENTER();
 
     size_t i;
@@ -468,6 +801,9 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     size_t start_block;
     size_t n_free;
     int collected = !MP_STATE_MEM(gc_auto_collect_enabled);
+    #if MICROPY_GC_GENERATIONAL
+    int minor_collected = collected;
+    #endif
 
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
@@ -480,9 +816,30 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
 
     for (;;) {
 
+        #if MICROPY_GC_LARGE_FROM_TOP
+        if (n_blocks >= MICROPY_GC_LARGE_FROM_TOP_BLOCKS) {
+            // look for a run of n_blocks available blocks, starting from the
+            // top of the heap, so large buffers cluster away from the
+            // small-object churn at the bottom
+            n_free = 0;
+            for (size_t bl = MP_STATE_MEM(gc_alloc_table_byte_len) * BLOCKS_PER_ATB; bl > 0;) {
+                bl--;
+                if (ATB_GET_KIND(bl) == AT_FREE) {
+                    if (++n_free >= n_blocks) {
+                        i = bl + n_blocks - 1;
+                        goto found;
+                    }
+                } else {
+                    n_free = 0;
+                }
+            }
+            goto not_found;
+        }
+        #endif
+
         // look for a run of n_blocks available blocks
         n_free = 0;
-        for (i = MP_STATE_MEM(gc_last_free_atb_index); i < MP_STATE_MEM(gc_alloc_table_byte_len); i++) {
+        for (i = MP_STATE_MEM(gc_first_free_atb_index)[MIN(n_blocks, MICROPY_ATB_INDICES) - 1]; i < MP_STATE_MEM(gc_alloc_table_byte_len); i++) {
             byte a = MP_STATE_MEM(gc_alloc_table_start)[i];
             // *FORMAT-OFF*
             if (ATB_0_IS_FREE(a)) { if (++n_free >= n_blocks) { i = i * BLOCKS_PER_ATB + 0; goto found; } } else { n_free = 0; }
@@ -492,8 +849,21 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             // *FORMAT-ON*
         }
 
+        #if MICROPY_GC_LARGE_FROM_TOP
+    not_found:;
+        #endif
         GC_EXIT();
         // nothing found!
+        #if MICROPY_GC_GENERATIONAL
+        if (!minor_collected) {
+            // try a cheap minor collection before falling back to a full one
+            minor_collected = 1;
+            DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering minor GC\n", n_bytes);
+            gc_collect_minor();
+            GC_ENTER();
+            continue;
+        }
+        #endif
         if (collected) {
             return NULL;
         }
@@ -509,18 +879,30 @@ found:
     end_block = i;
     start_block = i - n_free + 1;
 
-    // Set last free ATB index to block after last block we found, for start of
-    // next scan.  To reduce fragmentation, we only do this if we were looking
-    // for a single free block, which guarantees that there are no free blocks
-    // before this one.  Also, whenever we free or shink a block we must check
-    // if this index needs adjusting (see gc_realloc and gc_free).
-    if (n_free == 1) {
-        MP_STATE_MEM(gc_last_free_atb_index) = (i + 1) / BLOCKS_PER_ATB;
+    // The scan just proved that no run of n_blocks free blocks starts before
+    // this one, and hence neither does any longer run, so the hints for this
+    // size class and all larger ones can be advanced past the allocation.
+    // This doesn't hold for allocations bigger than the largest size class,
+    // since that class also covers smaller runs that may have been skipped.
+    // Whenever we free or shrink a block we must check if these indices need
+    // adjusting (see gc_realloc and gc_free).
+    if (n_blocks <= MICROPY_ATB_INDICES) {
+        size_t next_free_atb = (i + 1) / BLOCKS_PER_ATB;
+        for (size_t size_class = n_blocks - 1; size_class < MICROPY_ATB_INDICES; size_class++) {
+            if (MP_STATE_MEM(gc_first_free_atb_index)[size_class] < next_free_atb) {
+                MP_STATE_MEM(gc_first_free_atb_index)[size_class] = next_free_atb;
+            }
+        }
     }
 
     // mark first block as used head
     ATB_FREE_TO_HEAD(start_block);
 
+    #if MICROPY_GC_GENERATIONAL
+    // new blocks start out in the young generation
+    YTB_SET(start_block);
+    #endif
+
     // mark rest of blocks as used tail
     // TODO for a run of many blocks can make this more efficient
     for (size_t bl = start_block + 1; bl <= end_block; bl++) {
@@ -604,9 +986,23 @@ void gc_free(void *ptr) {
         FTB_CLEAR(block);
         #endif
 
-        // set the last_free pointer to this block if it's earlier in the heap
-        if (block / BLOCKS_PER_ATB < MP_STATE_MEM(gc_last_free_atb_index)) {
-            MP_STATE_MEM(gc_last_free_atb_index) = block / BLOCKS_PER_ATB;
+        #if MICROPY_GC_GENERATIONAL
+        YTB_CLEAR(block);
+        #endif
+
+        #if MICROPY_GC_DEFERRED_FINALISER
+        if (PTB_GET(block)) {
+            PTB_CLEAR(block);
+            MP_STATE_MEM(gc_pending_finaliser_count)--;
+        }
+        #endif
+
+        // roll back the first-free pointers if this block is earlier in the heap,
+        // since a run of any length may now start here
+        for (size_t size_class = 0; size_class < MICROPY_ATB_INDICES; size_class++) {
+            if (block / BLOCKS_PER_ATB < MP_STATE_MEM(gc_first_free_atb_index)[size_class]) {
+                MP_STATE_MEM(gc_first_free_atb_index)[size_class] = block / BLOCKS_PER_ATB;
+            }
         }
 
         // free head and all of its tail blocks
@@ -739,9 +1135,12 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
             ATB_ANY_TO_FREE(bl);
         }
 
-        // set the last_free pointer to end of this block if it's earlier in the heap
-        if ((block + new_blocks) / BLOCKS_PER_ATB < MP_STATE_MEM(gc_last_free_atb_index)) {
-            MP_STATE_MEM(gc_last_free_atb_index) = (block + new_blocks) / BLOCKS_PER_ATB;
+        // roll back the first-free pointers to the end of this block if it's
+        // earlier in the heap, since a run of any length may now start there
+        for (size_t size_class = 0; size_class < MICROPY_ATB_INDICES; size_class++) {
+            if ((block + new_blocks) / BLOCKS_PER_ATB < MP_STATE_MEM(gc_first_free_atb_index)[size_class]) {
+                MP_STATE_MEM(gc_first_free_atb_index)[size_class] = (block + new_blocks) / BLOCKS_PER_ATB;
+            }
         }
 
         GC_EXIT();
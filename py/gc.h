@@ -43,9 +43,19 @@ void gc_collect_start(void);
 void gc_collect_root(void **ptrs, size_t len);
 void gc_collect_end(void);
 
+#if MICROPY_GC_GENERATIONAL
+// Run a minor collection, only reclaiming blocks allocated since the last collection.
+void gc_collect_minor(void);
+#endif
+
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
+#if MICROPY_GC_DEFERRED_FINALISER
+// Run at most one finaliser queued by the collector (see mp_handle_pending).
+void gc_finaliser_run_one(void);
+#endif
+
 enum {
     GC_ALLOC_FLAG_HAS_FINALISER = 1,
 };
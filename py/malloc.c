@@ -82,7 +82,28 @@ STATIC void *realloc_ext(void *ptr, size_t n_bytes, bool allow_move) {
 
 #endif // MICROPY_ENABLE_GC
 
+#if MICROPY_MEM_PROFILE
+// Count down the sampling interval and, when it expires, record the size
+// and caller PC of this allocation in the ring buffer.  Called from the
+// m_malloc entry points with __builtin_return_address(0), so pc identifies
+// the allocation site.
+void m_prof_record(size_t num_bytes, const void *pc) {
+    if (MP_STATE_MEM(prof_countdown) == 0) {
+        MP_STATE_MEM(prof_countdown) = MICROPY_MEM_PROFILE_INTERVAL - 1;
+        m_prof_sample_t *s = &MP_STATE_MEM(prof_ring)[MP_STATE_MEM(prof_n_samples)++ % MICROPY_MEM_PROFILE_RING_LEN];
+        s->pc = pc;
+        s->size = num_bytes;
+    } else {
+        MP_STATE_MEM(prof_countdown)--;
+    }
+}
+#define M_PROF_RECORD(num_bytes) m_prof_record((num_bytes), __builtin_return_address(0))
+#else
+#define M_PROF_RECORD(num_bytes)
+#endif
+
 void *m_malloc(size_t num_bytes) {
+    M_PROF_RECORD(num_bytes);
     void *ptr = malloc(num_bytes);
     if (ptr == NULL && num_bytes != 0) {
         m_malloc_fail(num_bytes);
@@ -97,6 +118,7 @@ void *m_malloc(size_t num_bytes) {
 }
 
 void *m_malloc_maybe(size_t num_bytes) {
+    M_PROF_RECORD(num_bytes);
     void *ptr = malloc(num_bytes);
     #if MICROPY_MEM_STATS
     MP_STATE_MEM(total_bytes_allocated) += num_bytes;
@@ -109,6 +131,7 @@ void *m_malloc_maybe(size_t num_bytes) {
 
 #if MICROPY_ENABLE_FINALISER
 void *m_malloc_with_finaliser(size_t num_bytes) {
+    M_PROF_RECORD(num_bytes);
     void *ptr = malloc_with_finaliser(num_bytes);
     if (ptr == NULL && num_bytes != 0) {
         m_malloc_fail(num_bytes);
@@ -207,6 +230,87 @@ void m_free(void *ptr)
     #endif
 }
 
+// Arena allocator: memory is handed out sequentially from large chunks and
+// only ever freed wholesale (see comment in py/misc.h).
+
+struct _m_arena_chunk_t {
+    size_t alloc;
+    union {
+        size_t used; // while the chunk is being filled
+        m_arena_chunk_t *next; // once the chunk is retired
+    } union_;
+    byte data[];
+};
+
+void m_arena_init(m_arena_t *arena, size_t chunk_alloc) {
+    arena->cur = NULL;
+    arena->done = NULL;
+    arena->chunk_alloc = chunk_alloc;
+}
+
+// Shrink the current chunk to its used size and put it on the done chain.
+STATIC void m_arena_retire_cur(m_arena_t *arena) {
+    m_arena_chunk_t *chunk = arena->cur;
+    (void)m_renew_maybe(byte, chunk, sizeof(m_arena_chunk_t) + chunk->alloc,
+        sizeof(m_arena_chunk_t) + chunk->union_.used, false);
+    chunk->alloc = chunk->union_.used;
+    chunk->union_.next = arena->done;
+    arena->done = chunk;
+    arena->cur = NULL;
+}
+
+void *m_arena_alloc(m_arena_t *arena, size_t num_bytes) {
+    m_arena_chunk_t *chunk = arena->cur;
+
+    if (chunk != NULL && chunk->union_.used + num_bytes > chunk->alloc) {
+        // not enough room at end of current chunk so try to grow it in place
+        m_arena_chunk_t *new_data = (m_arena_chunk_t *)m_renew_maybe(byte, chunk,
+            sizeof(m_arena_chunk_t) + chunk->alloc,
+            sizeof(m_arena_chunk_t) + chunk->alloc + num_bytes, false);
+        if (new_data == NULL) {
+            // could not grow existing memory; retire the chunk and start a new one
+            m_arena_retire_cur(arena);
+            chunk = NULL;
+        } else {
+            // could grow existing memory
+            chunk->alloc += num_bytes;
+        }
+    }
+
+    if (chunk == NULL) {
+        // no current chunk, allocate a new chunk
+        size_t alloc = arena->chunk_alloc;
+        if (alloc < num_bytes) {
+            alloc = num_bytes;
+        }
+        chunk = (m_arena_chunk_t *)m_new(byte, sizeof(m_arena_chunk_t) + alloc);
+        chunk->alloc = alloc;
+        chunk->union_.used = 0;
+        arena->cur = chunk;
+    }
+
+    byte *ret = chunk->data + chunk->union_.used;
+    chunk->union_.used += num_bytes;
+    return ret;
+}
+
+m_arena_chunk_t *m_arena_finish(m_arena_t *arena) {
+    if (arena->cur != NULL) {
+        m_arena_retire_cur(arena);
+    }
+    m_arena_chunk_t *chunk = arena->done;
+    arena->done = NULL;
+    return chunk;
+}
+
+void m_arena_chunk_free_all(m_arena_chunk_t *chunk) {
+    while (chunk != NULL) {
+        m_arena_chunk_t *next = chunk->union_.next;
+        m_del(byte, chunk, sizeof(m_arena_chunk_t) + chunk->alloc);
+        chunk = next;
+    }
+}
+
 #if MICROPY_MEM_STATS
 size_t m_get_total_bytes_allocated(void) {
     return MP_STATE_MEM(total_bytes_allocated);
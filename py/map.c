@@ -75,6 +75,7 @@ void mp_map_init(mp_map_t *map, size_t n) {
     }
     map->used = 0;
     map->all_keys_are_qstrs = 1;
+    map->all_keys_are_small_ints = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
 }
@@ -83,6 +84,7 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->alloc = n;
     map->used = n;
     map->all_keys_are_qstrs = 1;
+    map->all_keys_are_small_ints = 0;
     map->is_fixed = 1;
     map->is_ordered = 1;
     map->table = (mp_map_elem_t *)table;
@@ -103,20 +105,21 @@ void mp_map_clear(mp_map_t *map) {
     map->alloc = 0;
     map->used = 0;
     map->all_keys_are_qstrs = 1;
+    map->all_keys_are_small_ints = 1;
     map->is_fixed = 0;
     map->table = NULL;
 }
 
-STATIC void mp_map_rehash(mp_map_t *map) {
+STATIC void mp_map_resize(mp_map_t *map, size_t new_alloc) {
     size_t old_alloc = map->alloc;
-    size_t new_alloc = get_hash_alloc_greater_or_equal_to(map->alloc + 1);
-    DEBUG_printf("mp_map_rehash(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
+    DEBUG_printf("mp_map_resize(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
     mp_map_elem_t *old_table = map->table;
     mp_map_elem_t *new_table = m_new0(mp_map_elem_t, new_alloc);
     // If we reach this point, table resizing succeeded, now we can edit the old map.
     map->alloc = new_alloc;
     map->used = 0;
     map->all_keys_are_qstrs = 1;
+    map->all_keys_are_small_ints = 1;
     map->table = new_table;
     for (size_t i = 0; i < old_alloc; i++) {
         if (old_table[i].key != MP_OBJ_NULL && old_table[i].key != MP_OBJ_SENTINEL) {
@@ -126,6 +129,23 @@ STATIC void mp_map_rehash(mp_map_t *map) {
     m_del(mp_map_elem_t, old_table, old_alloc);
 }
 
+STATIC void mp_map_rehash(mp_map_t *map) {
+    mp_map_resize(map, get_hash_alloc_greater_or_equal_to(map->alloc + 1));
+}
+
+#if MICROPY_MAP_SHRINK_ON_DELETE
+// Shrink the table if it has become very sparse, so that iteration and
+// memory use track the number of entries rather than the high-water mark.
+// Must only be called once any element pointer previously returned by
+// mp_map_lookup is no longer needed, since the table is reallocated.
+void mp_map_shrink_maybe(mp_map_t *map) {
+    if (!map->is_fixed && !map->is_ordered
+        && map->alloc > 12 && map->used * 4 < map->alloc) {
+        mp_map_resize(map, get_hash_alloc_greater_or_equal_to(map->used * 2));
+    }
+}
+#endif
+
 // MP_MAP_LOOKUP behaviour:
 //  - returns NULL if not found, else the slot it was found in with key,value non-null
 // MP_MAP_LOOKUP_ADD_IF_NOT_FOUND behaviour:
@@ -153,6 +173,12 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
             // lookup because we know that the index will never be found.
             return NULL;
         }
+    } else if (map->all_keys_are_small_ints && mp_obj_is_small_int(index)) {
+        // Equal small ints are always the identical object, so a map sealed
+        // to small-int keys probed with a small int needs no dispatch.  Other
+        // index types (eg bool, float, big int) can still equal a small int
+        // and take the full comparison below.
+        compare_only_ptrs = true;
     }
 
     // if the map is an ordered array then we must do a brute force linear search
@@ -190,6 +216,9 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         if (!mp_obj_is_qstr(index)) {
             map->all_keys_are_qstrs = 0;
         }
+        if (!mp_obj_is_small_int(index)) {
+            map->all_keys_are_small_ints = 0;
+        }
         return elem;
         #else
         return NULL;
@@ -206,10 +235,12 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         }
     }
 
-    // get hash of index, with fast path for common case of qstr
+    // get hash of index, with fast paths for common cases of qstr and small int
     mp_uint_t hash;
     if (mp_obj_is_qstr(index)) {
         hash = qstr_hash(MP_OBJ_QSTR_VALUE(index));
+    } else if (mp_obj_is_small_int(index)) {
+        hash = MP_OBJ_SMALL_INT_VALUE(index);
     } else {
         hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
     }
@@ -222,6 +253,15 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
         if (slot->key == MP_OBJ_NULL) {
             // found NULL slot, so index is not in table
             if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+                #if MICROPY_MAP_MAX_LOAD_PERCENT < 100
+                // grow the table early to keep probe runs short; at the
+                // default of 100 this folds away and the table fills
+                // completely before growing, minimising RAM
+                if ((map->used + 1) * 100 > map->alloc * MICROPY_MAP_MAX_LOAD_PERCENT) {
+                    mp_map_rehash(map);
+                    return mp_map_lookup(map, index, lookup_kind);
+                }
+                #endif
                 map->used += 1;
                 if (avail_slot == NULL) {
                     avail_slot = slot;
@@ -231,6 +271,9 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                 if (!mp_obj_is_qstr(index)) {
                     map->all_keys_are_qstrs = 0;
                 }
+                if (!mp_obj_is_small_int(index)) {
+                    map->all_keys_are_small_ints = 0;
+                }
                 return avail_slot;
             } else {
                 return NULL;
@@ -249,6 +292,17 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                 if (map->table[(pos + 1) % map->alloc].key == MP_OBJ_NULL) {
                     // optimisation if next slot is empty
                     slot->key = MP_OBJ_NULL;
+                    // any contiguous run of deleted slots before this one is
+                    // now also unreachable by a probe (every probe through
+                    // them would stop at this empty slot), so free them too
+                    size_t prev = pos;
+                    for (;;) {
+                        prev = (prev + map->alloc - 1) % map->alloc;
+                        if (map->table[prev].key != MP_OBJ_SENTINEL) {
+                            break;
+                        }
+                        map->table[prev].key = MP_OBJ_NULL;
+                    }
                 } else {
                     slot->key = MP_OBJ_SENTINEL;
                 }
@@ -271,6 +325,9 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
                     if (!mp_obj_is_qstr(index)) {
                         map->all_keys_are_qstrs = 0;
                     }
+                    if (!mp_obj_is_small_int(index)) {
+                        map->all_keys_are_small_ints = 0;
+                    }
                     return avail_slot;
                 } else {
                     // not enough room in table, rehash it
@@ -291,6 +348,7 @@ mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t
 #if MICROPY_PY_BUILTINS_SET
 
 void mp_set_init(mp_set_t *set, size_t n) {
+    set->all_keys_are_small_ints = 1;
     set->alloc = n;
     set->used = 0;
     set->table = m_new0(mp_obj_t, set->alloc);
@@ -321,10 +379,21 @@ mp_obj_t mp_set_lookup(mp_set_t *set, mp_obj_t index, mp_map_lookup_kind_t looku
             return MP_OBJ_NULL;
         }
     }
-    mp_uint_t hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
+    // get hash of index, with fast path for the common case of small int
+    mp_uint_t hash;
+    if (mp_obj_is_small_int(index)) {
+        hash = MP_OBJ_SMALL_INT_VALUE(index);
+    } else {
+        hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
+    }
     size_t pos = hash % set->alloc;
     size_t start_pos = pos;
     mp_obj_t *avail_slot = NULL;
+    // Equal small ints are always the identical object, so a set sealed to
+    // small-int elements probed with a small int needs no dispatch.  Other
+    // index types (eg bool, float, big int) can still equal a small int and
+    // take the full comparison.
+    bool compare_only_ptrs = set->all_keys_are_small_ints && mp_obj_is_small_int(index);
     for (;;) {
         mp_obj_t elem = set->table[pos];
         if (elem == MP_OBJ_NULL) {
@@ -335,6 +404,9 @@ mp_obj_t mp_set_lookup(mp_set_t *set, mp_obj_t index, mp_map_lookup_kind_t looku
                 }
                 set->used++;
                 *avail_slot = index;
+                if (!mp_obj_is_small_int(index)) {
+                    set->all_keys_are_small_ints = 0;
+                }
                 return index;
             } else {
                 return MP_OBJ_NULL;
@@ -344,7 +416,7 @@ mp_obj_t mp_set_lookup(mp_set_t *set, mp_obj_t index, mp_map_lookup_kind_t looku
             if (avail_slot == NULL) {
                 avail_slot = &set->table[pos];
             }
-        } else if (mp_obj_equal(elem, index)) {
+        } else if (elem == index || (!compare_only_ptrs && mp_obj_equal(elem, index))) {
             // found index
             if (lookup_kind & MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
                 // delete element
@@ -352,6 +424,16 @@ mp_obj_t mp_set_lookup(mp_set_t *set, mp_obj_t index, mp_map_lookup_kind_t looku
                 if (set->table[(pos + 1) % set->alloc] == MP_OBJ_NULL) {
                     // optimisation if next slot is empty
                     set->table[pos] = MP_OBJ_NULL;
+                    // free any run of deleted slots before this one as well,
+                    // since every probe through them stops at this empty slot
+                    size_t prev = pos;
+                    for (;;) {
+                        prev = (prev + set->alloc - 1) % set->alloc;
+                        if (set->table[prev] != MP_OBJ_SENTINEL) {
+                            break;
+                        }
+                        set->table[prev] = MP_OBJ_NULL;
+                    }
                 } else {
                     set->table[pos] = MP_OBJ_SENTINEL;
                 }
@@ -369,6 +451,9 @@ mp_obj_t mp_set_lookup(mp_set_t *set, mp_obj_t index, mp_map_lookup_kind_t looku
                     // there was an available slot, so use that
                     set->used++;
                     *avail_slot = index;
+                    if (!mp_obj_is_small_int(index)) {
+                        set->all_keys_are_small_ints = 0;
+                    }
                     return index;
                 } else {
                     // not enough room in table, rehash it
@@ -403,6 +488,7 @@ mp_obj_t mp_set_remove_first(mp_set_t *set) {
 
 void mp_set_clear(mp_set_t *set) {
     m_del(mp_obj_t, set->table, set->alloc);
+    set->all_keys_are_small_ints = 1;
     set->alloc = 0;
     set->used = 0;
     set->table = NULL;
@@ -108,6 +108,39 @@ size_t m_get_current_bytes_allocated(void);
 size_t m_get_peak_bytes_allocated(void);
 #endif
 
+#if MICROPY_MEM_PROFILE
+// A sample taken by the heap profiler: the PC of the m_malloc caller and
+// the number of bytes it requested.
+typedef struct _m_prof_sample_t {
+    const void *pc;
+    size_t size;
+} m_prof_sample_t;
+void m_prof_record(size_t num_bytes, const void *pc);
+#endif
+
+/** memory arena *************************************************/
+
+// An arena allocates small pieces of memory sequentially within larger
+// chunks, for transient structures (eg the parse tree) that are built up
+// incrementally and then discarded wholesale.  Chunks are obtained from the
+// general allocator, so on GC builds the contents of an arena are still
+// scanned conservatively for root pointers.
+
+typedef struct _m_arena_chunk_t m_arena_chunk_t;
+
+typedef struct _m_arena_t {
+    m_arena_chunk_t *cur; // chunk currently being filled, or NULL
+    m_arena_chunk_t *done; // chain of retired chunks
+    size_t chunk_alloc; // default data size of a new chunk, in bytes
+} m_arena_t;
+
+void m_arena_init(m_arena_t *arena, size_t chunk_alloc);
+void *m_arena_alloc(m_arena_t *arena, size_t num_bytes);
+// Trim the current chunk, return the chain of all chunks and reset the arena.
+m_arena_chunk_t *m_arena_finish(m_arena_t *arena);
+// Free a chain of chunks, as returned by m_arena_finish.
+void m_arena_chunk_free_all(m_arena_chunk_t *chunk);
+
 /** array helpers ***********************************************/
 
 // get the number of elements in a fixed-size array
@@ -416,7 +416,23 @@ STATIC mp_obj_t mp_builtin_print(size_t n_args, const mp_obj_t *pos_args, mp_map
 
     #if MICROPY_PY_IO && MICROPY_PY_SYS_STDFILES
     mp_get_stream_raise(u.args[ARG_file].u_obj, MP_STREAM_OP_WRITE);
-    mp_print_t print = {MP_OBJ_TO_PTR(u.args[ARG_file].u_obj), mp_stream_write_adaptor};
+    mp_print_t stream_print = {MP_OBJ_TO_PTR(u.args[ARG_file].u_obj), mp_stream_write_adaptor};
+    const mp_print_t *print = &stream_print;
+    #else
+    const mp_print_t *print = &mp_plat_print;
+    #endif
+
+    #if MICROPY_OPT_PRINT_BATCHING
+    // Batch fragments when printing to the console; an explicit file object
+    // keeps one write call per fragment, like CPython.
+    mp_batch_print_t batch;
+    mp_batch_print_init(&batch, print);
+    #if MICROPY_PY_IO && MICROPY_PY_SYS_STDFILES
+    if (u.args[ARG_file].u_obj == MP_OBJ_FROM_PTR(&mp_sys_stdout_obj))
+    #endif
+    {
+        print = &batch.base;
+    }
     #endif
 
     // extract the objects first because we are going to use the other part of the union
@@ -427,22 +443,14 @@ STATIC mp_obj_t mp_builtin_print(size_t n_args, const mp_obj_t *pos_args, mp_map
 
     for (size_t i = 0; i < n_args; i++) {
         if (i > 0) {
-            #if MICROPY_PY_IO && MICROPY_PY_SYS_STDFILES
-            mp_stream_write_adaptor(print.data, sep_data, u.len[0]);
-            #else
-            mp_print_strn(&mp_plat_print, sep_data, u.len[0], 0, 0, 0);
-            #endif
+            print->print_strn(print->data, sep_data, u.len[0]);
         }
-        #if MICROPY_PY_IO && MICROPY_PY_SYS_STDFILES
-        mp_obj_print_helper(&print, pos_args[i], PRINT_STR);
-        #else
-        mp_obj_print_helper(&mp_plat_print, pos_args[i], PRINT_STR);
-        #endif
+        mp_obj_print_helper(print, pos_args[i], PRINT_STR);
     }
-    #if MICROPY_PY_IO && MICROPY_PY_SYS_STDFILES
-    mp_stream_write_adaptor(print.data, end_data, u.len[1]);
-    #else
-    mp_print_strn(&mp_plat_print, end_data, u.len[1], 0, 0, 0);
+    print->print_strn(print->data, end_data, u.len[1]);
+
+    #if MICROPY_OPT_PRINT_BATCHING
+    mp_batch_print_flush(&batch);
     #endif
     return mp_const_none;
 }
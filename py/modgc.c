@@ -41,6 +41,19 @@ STATIC mp_obj_t py_gc_collect(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(gc_collect_obj, py_gc_collect);
 
+#if MICROPY_GC_GENERATIONAL
+// collect_minor(): run a minor garbage collection
+STATIC mp_obj_t py_gc_collect_minor(void) {
+    gc_collect_minor();
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_collected));
+    #else
+    return mp_const_none;
+    #endif
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_collect_minor_obj, py_gc_collect_minor);
+#endif
+
 // disable(): disable the garbage collector
 STATIC mp_obj_t gc_disable(void) {
     MP_STATE_MEM(gc_auto_collect_enabled) = 0;
@@ -93,11 +106,33 @@ STATIC mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
+
+#if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+// tune([growth]): query or set the heap-growth percentage of the automatic
+// collection policy.  With a non-zero value, each collection re-arms the
+// threshold to trigger after the heap grows by that percentage of the data
+// that survived the collection; 0 reverts to a fixed gc.threshold().
+STATIC mp_obj_t gc_tune(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_threshold_growth));
+    }
+    mp_int_t val = mp_obj_get_int(args[0]);
+    if (val < 0) {
+        val = 0;
+    }
+    MP_STATE_MEM(gc_threshold_growth) = val;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_tune_obj, 0, 1, gc_tune);
+#endif
 #endif
 
 STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
+    #if MICROPY_GC_GENERATIONAL
+    { MP_ROM_QSTR(MP_QSTR_collect_minor), MP_ROM_PTR(&gc_collect_minor_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_disable), MP_ROM_PTR(&gc_disable_obj) },
     { MP_ROM_QSTR(MP_QSTR_enable), MP_ROM_PTR(&gc_enable_obj) },
     { MP_ROM_QSTR(MP_QSTR_isenabled), MP_ROM_PTR(&gc_isenabled_obj) },
@@ -105,6 +140,9 @@ STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mem_alloc), MP_ROM_PTR(&gc_mem_alloc_obj) },
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
+    #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+    { MP_ROM_QSTR(MP_QSTR_tune), MP_ROM_PTR(&gc_tune_obj) },
+    #endif
     #endif
 };
 
@@ -204,6 +204,99 @@ STATIC const mp_obj_type_t mp_type_bufwriter = {
 };
 #endif // MICROPY_PY_IO_BUFFEREDWRITER
 
+#if MICROPY_PY_IO_BUFFEREDREADER
+typedef struct _mp_obj_bufreader_t {
+    mp_obj_base_t base;
+    mp_obj_t stream;
+    size_t alloc;
+    size_t len; // number of valid bytes in buf
+    size_t pos; // read cursor within buf
+    byte buf[0];
+} mp_obj_bufreader_t;
+
+STATIC mp_obj_t bufreader_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 2, 2, false);
+    mp_get_stream_raise(args[0], MP_STREAM_OP_READ);
+    size_t alloc = mp_obj_get_int(args[1]);
+    mp_obj_bufreader_t *o = m_new_obj_var(mp_obj_bufreader_t, byte, alloc);
+    o->base.type = type;
+    o->stream = args[0];
+    o->alloc = alloc;
+    o->len = 0;
+    o->pos = 0;
+    return o;
+}
+
+STATIC mp_uint_t bufreader_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_bufreader_t *self = MP_OBJ_TO_PTR(self_in);
+    const mp_stream_p_t *stream_p = mp_get_stream(self->stream);
+    byte *dest = buf;
+    mp_uint_t org_size = size;
+    *errcode = 0;
+
+    while (size > 0) {
+        // serve from the readahead buffer first
+        mp_uint_t rem = self->len - self->pos;
+        if (rem != 0) {
+            if (rem > size) {
+                rem = size;
+            }
+            memcpy(dest, self->buf + self->pos, rem);
+            self->pos += rem;
+            dest += rem;
+            size -= rem;
+            continue;
+        }
+
+        // buffer is empty: requests of at least a whole buffer bypass it
+        if (size >= self->alloc) {
+            mp_uint_t out_sz = stream_p->read(self->stream, dest, size, errcode);
+            if (out_sz == MP_STREAM_ERROR) {
+                // return data already copied, if any; the error recurs anyway
+                break;
+            }
+            return org_size - size + out_sz;
+        }
+
+        // refill the buffer with a single underlying read
+        mp_uint_t out_sz = stream_p->read(self->stream, self->buf, self->alloc, errcode);
+        if (out_sz == MP_STREAM_ERROR || out_sz == 0) {
+            // error or EOF; return data already copied, if any
+            break;
+        }
+        self->len = out_sz;
+        self->pos = 0;
+    }
+
+    if (org_size == size && *errcode != 0) {
+        return MP_STREAM_ERROR;
+    }
+    return org_size - size;
+}
+
+STATIC const mp_rom_map_elem_t bufreader_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readline), MP_ROM_PTR(&mp_stream_unbuffered_readline_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readlines), MP_ROM_PTR(&mp_stream_unbuffered_readlines_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(bufreader_locals_dict, bufreader_locals_dict_table);
+
+STATIC const mp_stream_p_t bufreader_stream_p = {
+    .read = bufreader_read,
+};
+
+STATIC const mp_obj_type_t mp_type_bufreader = {
+    { &mp_type_type },
+    .name = MP_QSTR_BufferedReader,
+    .make_new = bufreader_make_new,
+    .getiter = mp_identity_getiter,
+    .iternext = mp_stream_unbuffered_iter,
+    .protocol = &bufreader_stream_p,
+    .locals_dict = (mp_obj_dict_t *)&bufreader_locals_dict,
+};
+#endif // MICROPY_PY_IO_BUFFEREDREADER
+
 #if MICROPY_PY_IO_RESOURCE_STREAM
 STATIC mp_obj_t resource_stream(mp_obj_t package_in, mp_obj_t path_in) {
     VSTR_FIXED(path_buf, MICROPY_ALLOC_PATH_MAX);
@@ -272,6 +365,9 @@ STATIC const mp_rom_map_elem_t mp_module_io_globals_table[] = {
     #if MICROPY_PY_IO_BUFFEREDWRITER
     { MP_ROM_QSTR(MP_QSTR_BufferedWriter), MP_ROM_PTR(&mp_type_bufwriter) },
     #endif
+    #if MICROPY_PY_IO_BUFFEREDREADER
+    { MP_ROM_QSTR(MP_QSTR_BufferedReader), MP_ROM_PTR(&mp_type_bufreader) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_io_globals, mp_module_io_globals_table);
@@ -25,11 +25,14 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "py/builtin.h"
+#include "py/compile.h"
 #include "py/stackctrl.h"
 #include "py/runtime.h"
 #include "py/gc.h"
+#include "py/trace.h"
 #include "py/mphal.h"
 
 // Various builtins specific to MicroPython runtime,
@@ -45,6 +48,45 @@ STATIC mp_obj_t mp_micropython_opt_level(size_t n_args, const mp_obj_t *args) {
     }
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_opt_level_obj, 0, 1, mp_micropython_opt_level);
+
+#if MICROPY_EMIT_NATIVE
+// Set the default emitter, used for code without a per-function annotation;
+// this allows subsequently imported modules to be compiled to native code.
+// With no argument, return the name of the current default emitter.
+STATIC mp_obj_t mp_micropython_emit(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        qstr q;
+        switch (MP_STATE_VM(default_emit_opt)) {
+            case MP_EMIT_OPT_NATIVE_PYTHON:
+                q = MP_QSTR_native;
+                break;
+            case MP_EMIT_OPT_VIPER:
+                q = MP_QSTR_viper;
+                break;
+            default:
+                q = MP_QSTR_bytecode;
+                break;
+        }
+        return MP_OBJ_NEW_QSTR(q);
+    } else {
+        switch (mp_obj_str_get_qstr(args[0])) {
+            case MP_QSTR_bytecode:
+                MP_STATE_VM(default_emit_opt) = MP_EMIT_OPT_BYTECODE;
+                break;
+            case MP_QSTR_native:
+                MP_STATE_VM(default_emit_opt) = MP_EMIT_OPT_NATIVE_PYTHON;
+                break;
+            case MP_QSTR_viper:
+                MP_STATE_VM(default_emit_opt) = MP_EMIT_OPT_VIPER;
+                break;
+            default:
+                mp_raise_ValueError(MP_ERROR_TEXT("invalid emitter"));
+        }
+        return mp_const_none;
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_emit_obj, 0, 1, mp_micropython_emit);
+#endif
 #endif
 
 #if MICROPY_PY_MICROPYTHON_MEM_INFO
@@ -107,6 +149,72 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_qstr_info_obj, 0, 1, m
 
 #endif // MICROPY_PY_MICROPYTHON_MEM_INFO
 
+#if MICROPY_MEM_PROFILE
+STATIC mp_obj_t mp_micropython_mem_prof_dump(size_t n_args, const mp_obj_t *args) {
+    (void)args;
+    size_t n = MP_STATE_MEM(prof_n_samples);
+    mp_printf(&mp_plat_print, "mem prof: " UINT_FMT " allocations sampled (1 in %u)\n",
+        (mp_uint_t)n, (uint)MICROPY_MEM_PROFILE_INTERVAL);
+    size_t len = n < MICROPY_MEM_PROFILE_RING_LEN ? n : MICROPY_MEM_PROFILE_RING_LEN;
+    for (size_t i = 0; i < len; i++) {
+        const m_prof_sample_t *s = &MP_STATE_MEM(prof_ring)[(n - len + i) % MICROPY_MEM_PROFILE_RING_LEN];
+        mp_printf(&mp_plat_print, "pc=%p size=" UINT_FMT "\n", s->pc, (mp_uint_t)s->size);
+    }
+    if (n_args == 1) {
+        // arg given means reset the profiler
+        MP_STATE_MEM(prof_n_samples) = 0;
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_mem_prof_dump_obj, 0, 1, mp_micropython_mem_prof_dump);
+#endif
+
+#if MICROPY_CPU_PROFILE
+// Emit the sampled call stacks in collapsed-stack format
+// ("outer;inner count"), ready for flamegraph tooling.  Identical stacks
+// are aggregated, so the output has at most one line per distinct stack.
+STATIC mp_obj_t mp_micropython_cpu_prof_dump(size_t n_args, const mp_obj_t *args) {
+    (void)args;
+    size_t n = MP_STATE_VM(cpu_prof_n_samples);
+    mp_printf(&mp_plat_print, "cpu prof: " UINT_FMT " stacks sampled (1 in %u poll points)\n",
+        (mp_uint_t)n, (uint)MICROPY_CPU_PROFILE_INTERVAL);
+    size_t len = n < MICROPY_CPU_PROFILE_RING_LEN ? n : MICROPY_CPU_PROFILE_RING_LEN;
+    for (size_t i = 0; i < len; i++) {
+        const qstr *stack = MP_STATE_VM(cpu_prof_ring)[i];
+        // count matching stacks, skipping this one if already printed
+        size_t count = 0;
+        for (size_t j = 0; j < len; j++) {
+            if (memcmp(MP_STATE_VM(cpu_prof_ring)[j], stack, sizeof(MP_STATE_VM(cpu_prof_ring)[i])) == 0) {
+                if (j < i) {
+                    count = 0;
+                    break;
+                }
+                count++;
+            }
+        }
+        if (count == 0) {
+            continue;
+        }
+        // the sample is recorded leaf first; print it outermost first
+        size_t depth = 0;
+        while (depth < MICROPY_CPU_PROFILE_MAX_DEPTH && stack[depth] != 0) {
+            depth++;
+        }
+        for (size_t d = depth; d > 0; d--) {
+            mp_printf(&mp_plat_print, "%q%s", stack[d - 1], d > 1 ? ";" : "");
+        }
+        mp_printf(&mp_plat_print, " " UINT_FMT "\n", (mp_uint_t)count);
+    }
+    if (n_args == 1) {
+        // arg given means reset the profiler
+        MP_STATE_VM(cpu_prof_n_samples) = 0;
+        memset(MP_STATE_VM(cpu_prof_ring), 0, sizeof(MP_STATE_VM(cpu_prof_ring)));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_cpu_prof_dump_obj, 0, 1, mp_micropython_cpu_prof_dump);
+#endif
+
 #if MICROPY_PY_MICROPYTHON_STACK_USE
 STATIC mp_obj_t mp_micropython_stack_use(void) {
     return MP_OBJ_NEW_SMALL_INT(mp_stack_usage());
@@ -146,6 +254,24 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_heap_locked_obj, mp_micropython_
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_alloc_emergency_exception_buf_obj, mp_alloc_emergency_exception_buf);
 #endif
 
+#if MICROPY_DEBUG_VM_OPCODE_STATS
+STATIC mp_obj_t mp_micropython_opcode_stats(size_t n_args, const mp_obj_t *args) {
+    (void)args;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(MP_STATE_VM(vm_opcode_count)); ++i) {
+        if (MP_STATE_VM(vm_opcode_count)[i] != 0) {
+            mp_printf(&mp_plat_print, "opcode 0x%02x: " UINT_FMT "\n",
+                (uint)i, (mp_uint_t)MP_STATE_VM(vm_opcode_count)[i]);
+        }
+    }
+    if (n_args == 1) {
+        // arg given means reset the counters
+        memset(MP_STATE_VM(vm_opcode_count), 0, sizeof(MP_STATE_VM(vm_opcode_count)));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_opcode_stats_obj, 0, 1, mp_micropython_opcode_stats);
+#endif
+
 #if MICROPY_KBD_EXCEPTION
 STATIC mp_obj_t mp_micropython_kbd_intr(mp_obj_t int_chr_in) {
     mp_hal_set_interrupt_char(mp_obj_get_int(int_chr_in));
@@ -162,6 +288,14 @@ STATIC mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
+
+// Number of callbacks dropped so far because the schedule queue was full.
+// Callers like mp_sched_schedule from an ISR can't raise, so this counter
+// is the only record that something was lost.
+STATIC mp_obj_t mp_micropython_schedule_drops(void) {
+    return mp_obj_new_int_from_uint(MP_STATE_VM(sched_drops));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_schedule_drops_obj, mp_micropython_schedule_drops);
 #endif
 
 STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
@@ -169,6 +303,9 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_const), MP_ROM_PTR(&mp_identity_obj) },
     #if MICROPY_ENABLE_COMPILER
     { MP_ROM_QSTR(MP_QSTR_opt_level), MP_ROM_PTR(&mp_micropython_opt_level_obj) },
+    #if MICROPY_EMIT_NATIVE
+    { MP_ROM_QSTR(MP_QSTR_emit), MP_ROM_PTR(&mp_micropython_emit_obj) },
+    #endif
     #endif
     #if MICROPY_PY_MICROPYTHON_MEM_INFO
     #if MICROPY_MEM_STATS
@@ -179,6 +316,12 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_mem_info), MP_ROM_PTR(&mp_micropython_mem_info_obj) },
     { MP_ROM_QSTR(MP_QSTR_qstr_info), MP_ROM_PTR(&mp_micropython_qstr_info_obj) },
     #endif
+    #if MICROPY_MEM_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_mem_prof_dump), MP_ROM_PTR(&mp_micropython_mem_prof_dump_obj) },
+    #endif
+    #if MICROPY_CPU_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_cpu_prof_dump), MP_ROM_PTR(&mp_micropython_cpu_prof_dump_obj) },
+    #endif
     #if MICROPY_PY_MICROPYTHON_STACK_USE
     { MP_ROM_QSTR(MP_QSTR_stack_use), MP_ROM_PTR(&mp_micropython_stack_use_obj) },
     #endif
@@ -195,11 +338,18 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_heap_locked), MP_ROM_PTR(&mp_micropython_heap_locked_obj) },
     #endif
     #endif
+    #if MICROPY_DEBUG_VM_OPCODE_STATS
+    { MP_ROM_QSTR(MP_QSTR_opcode_stats), MP_ROM_PTR(&mp_micropython_opcode_stats_obj) },
+    #endif
     #if MICROPY_KBD_EXCEPTION
     { MP_ROM_QSTR(MP_QSTR_kbd_intr), MP_ROM_PTR(&mp_micropython_kbd_intr_obj) },
     #endif
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
+    { MP_ROM_QSTR(MP_QSTR_schedule_drops), MP_ROM_PTR(&mp_micropython_schedule_drops_obj) },
+    #endif
+    #if MICROPY_TRACE
+    { MP_ROM_QSTR(MP_QSTR_trace_drain), MP_ROM_PTR(&mp_micropython_trace_drain_obj) },
     #endif
 };
 
@@ -164,10 +164,8 @@ STATIC mp_obj_t struct_unpack_from(size_t n_args, const mp_obj_t *args) {
             p += cnt;
             res->items[i++] = item;
         } else {
-            while (cnt--) {
-                item = mp_binary_get_val(fmt_type, *fmt, p_base, &p);
-                res->items[i++] = item;
-            }
+            mp_binary_get_val_n(fmt_type, *fmt, cnt, p_base, &p, &res->items[i]);
+            i += cnt;
         }
         fmt++;
     }
@@ -204,9 +202,11 @@ STATIC void struct_pack_into_internal(mp_obj_t fmt_in, byte *p, size_t n_args, c
             p += cnt;
         } else {
             // If we run out of args then we just finish; CPython would raise struct.error
-            while (cnt-- && i < n_args) {
-                mp_binary_set_val(fmt_type, *fmt, args[i++], p_base, &p);
+            if (cnt > n_args - i) {
+                cnt = n_args - i;
             }
+            mp_binary_set_val_n(fmt_type, *fmt, cnt, p_base, &p, &args[i]);
+            i += cnt;
         }
         fmt++;
     }
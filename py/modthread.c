@@ -34,6 +34,10 @@
 
 #include "py/mpthread.h"
 
+#if MICROPY_PY_THREAD_POOL
+#include "py/mphal.h"
+#endif
+
 #if MICROPY_DEBUG_VERBOSE // print debugging info
 #define DEBUG_PRINT (1)
 #define DEBUG_printf DEBUG_printf
@@ -144,6 +148,247 @@ STATIC mp_obj_t mod_thread_stack_size(size_t n_args, const mp_obj_t *args) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_thread_stack_size_obj, 0, 1, mod_thread_stack_size);
 
+#if MICROPY_PY_THREAD_POOL
+
+/****************************************************************/
+// Worker pool
+//
+// A fixed set of worker threads created up-front, taking tasks from a
+// shared queue.  The workers and their stacks persist for the lifetime
+// of the pool, so submitting a task costs a queue operation instead of
+// a thread spawn.
+
+STATIC const mp_obj_type_t mp_type_thread_pool;
+
+typedef struct _mp_obj_thread_pool_t {
+    mp_obj_base_t base;
+    mp_thread_mutex_t mutex;
+    mp_obj_dict_t *dict_locals;
+    mp_obj_dict_t *dict_globals;
+    size_t stack_size;
+    uint16_t alloc; // capacity of the task queue
+    uint16_t head;
+    volatile uint16_t len;
+    volatile uint16_t n_workers; // workers that have not yet exited
+    volatile uint16_t n_busy; // tasks currently executing
+    volatile bool shutdown;
+    mp_obj_t queue[]; // alloc pairs of (function, arg)
+} mp_obj_thread_pool_t;
+
+STATIC void *thread_pool_worker(void *pool_in) {
+    // Execution begins here for each pool worker.  We do not have the GIL.
+    // The pool object stays reachable by the GC via this pointer on our
+    // stack for as long as the worker runs.
+
+    mp_obj_thread_pool_t *pool = (mp_obj_thread_pool_t *)pool_in;
+
+    mp_state_thread_t ts;
+    mp_thread_set_state(&ts);
+
+    mp_stack_set_top(&ts + 1); // need to include ts in root-pointer scan
+    mp_stack_set_limit(pool->stack_size);
+
+    #if MICROPY_ENABLE_PYSTACK
+    // TODO threading and pystack is not fully supported, for now just make a small stack
+    mp_obj_t mini_pystack[128];
+    mp_pystack_init(mini_pystack, &mini_pystack[128]);
+    #endif
+
+    // The GC starts off unlocked on this thread.
+    ts.gc_lock_depth = 0;
+
+    ts.mp_pending_exception = MP_OBJ_NULL;
+
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+    ts.current_code_state = NULL;
+    #endif
+    #if MICROPY_CPU_PROFILE
+    ts.cpu_prof_countdown = 0;
+    #endif
+
+    #if MICROPY_OPT_CODE_STATE_POOL
+    memset(ts.code_state_pool, 0, sizeof(ts.code_state_pool));
+    #endif
+
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    // The block cache starts off empty on this thread.
+    memset(ts.gc_block_cache, 0, sizeof(ts.gc_block_cache));
+    memset(ts.gc_block_cache_len, 0, sizeof(ts.gc_block_cache_len));
+    #endif
+
+    // set locals and globals from the creating context
+    mp_locals_set(pool->dict_locals);
+    mp_globals_set(pool->dict_globals);
+
+    MP_THREAD_GIL_ENTER();
+
+    // signal that we are set up and running
+    mp_thread_start();
+
+    DEBUG_printf("[thread pool] worker start ts=%p pool=%p\n", &ts, pool);
+
+    for (;;) {
+        // take the next task, if there is one
+        mp_obj_t fun = MP_OBJ_NULL;
+        mp_obj_t arg = MP_OBJ_NULL;
+        mp_thread_mutex_lock(&pool->mutex, 1);
+        if (pool->len != 0) {
+            size_t i = 2 * pool->head;
+            fun = pool->queue[i];
+            arg = pool->queue[i + 1];
+            pool->queue[i] = MP_OBJ_NULL;
+            pool->queue[i + 1] = MP_OBJ_NULL;
+            pool->head = (pool->head + 1) % pool->alloc;
+            --pool->len;
+            ++pool->n_busy;
+        }
+        mp_thread_mutex_unlock(&pool->mutex);
+
+        if (fun == MP_OBJ_NULL) {
+            // the queue is drained before shutdown is acted on, so close()
+            // runs all tasks submitted before it
+            if (pool->shutdown) {
+                break;
+            }
+            MICROPY_EVENT_POLL_HOOK
+            continue;
+        }
+
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_call_function_1(fun, arg);
+            nlr_pop();
+        } else {
+            // uncaught exception: report it and carry on with the next task
+            mp_obj_base_t *exc = (mp_obj_base_t *)nlr.ret_val;
+            if (mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(exc->type), MP_OBJ_FROM_PTR(&mp_type_SystemExit))) {
+                // swallow exception silently
+            } else {
+                mp_printf(MICROPY_ERROR_PRINTER, "Unhandled exception in pool task ");
+                mp_obj_print_helper(MICROPY_ERROR_PRINTER, fun, PRINT_REPR);
+                mp_printf(MICROPY_ERROR_PRINTER, "\n");
+                mp_obj_print_exception(MICROPY_ERROR_PRINTER, MP_OBJ_FROM_PTR(exc));
+            }
+        }
+
+        mp_thread_mutex_lock(&pool->mutex, 1);
+        --pool->n_busy;
+        mp_thread_mutex_unlock(&pool->mutex);
+    }
+
+    DEBUG_printf("[thread pool] worker finish ts=%p pool=%p\n", &ts, pool);
+
+    mp_thread_mutex_lock(&pool->mutex, 1);
+    --pool->n_workers;
+    mp_thread_mutex_unlock(&pool->mutex);
+
+    // signal that we are finished
+    mp_thread_finish();
+
+    MP_THREAD_GIL_EXIT();
+
+    return NULL;
+}
+
+STATIC mp_obj_t thread_pool_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 2, false);
+    mp_int_t n_workers = mp_obj_get_int(args[0]);
+    if (n_workers < 1 || n_workers > UINT16_MAX) {
+        mp_raise_ValueError(MP_ERROR_TEXT("invalid number of workers"));
+    }
+    mp_int_t qlen;
+    if (n_args == 2) {
+        qlen = mp_obj_get_int(args[1]);
+        if (qlen < 1 || qlen > UINT16_MAX) {
+            mp_raise_ValueError(MP_ERROR_TEXT("invalid queue length"));
+        }
+    } else {
+        qlen = 4 * n_workers;
+    }
+
+    mp_obj_thread_pool_t *pool = m_new_obj_var(mp_obj_thread_pool_t, mp_obj_t, 2 * qlen);
+    pool->base.type = type;
+    mp_thread_mutex_init(&pool->mutex);
+    pool->dict_locals = mp_locals_get();
+    pool->dict_globals = mp_globals_get();
+    pool->stack_size = thread_stack_size;
+    pool->alloc = qlen;
+    pool->head = 0;
+    pool->len = 0;
+    pool->n_workers = n_workers;
+    pool->n_busy = 0;
+    pool->shutdown = false;
+    for (size_t i = 0; i < 2 * (size_t)qlen; ++i) {
+        pool->queue[i] = MP_OBJ_NULL;
+    }
+
+    // spawn the workers; all share the stack size resolved by the first create
+    for (mp_int_t i = 0; i < n_workers; ++i) {
+        mp_thread_create(thread_pool_worker, pool, &pool->stack_size);
+    }
+
+    return MP_OBJ_FROM_PTR(pool);
+}
+
+STATIC mp_obj_t thread_pool_submit(size_t n_args, const mp_obj_t *args) {
+    mp_obj_thread_pool_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_obj_t arg = n_args == 3 ? args[2] : mp_const_none;
+    for (;;) {
+        if (self->shutdown) {
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("pool is closed"));
+        }
+        mp_thread_mutex_lock(&self->mutex, 1);
+        if (self->len < self->alloc) {
+            size_t i = 2 * ((self->head + self->len) % self->alloc);
+            self->queue[i] = args[1];
+            self->queue[i + 1] = arg;
+            ++self->len;
+            mp_thread_mutex_unlock(&self->mutex);
+            return mp_const_none;
+        }
+        mp_thread_mutex_unlock(&self->mutex);
+        // queue full: wait for a worker to take a task
+        MICROPY_EVENT_POLL_HOOK
+    }
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(thread_pool_submit_obj, 2, 3, thread_pool_submit);
+
+STATIC mp_obj_t thread_pool_wait(mp_obj_t self_in) {
+    mp_obj_thread_pool_t *self = MP_OBJ_TO_PTR(self_in);
+    while (self->len != 0 || self->n_busy != 0) {
+        MICROPY_EVENT_POLL_HOOK
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(thread_pool_wait_obj, thread_pool_wait);
+
+STATIC mp_obj_t thread_pool_close(mp_obj_t self_in) {
+    mp_obj_thread_pool_t *self = MP_OBJ_TO_PTR(self_in);
+    self->shutdown = true;
+    while (self->n_workers != 0) {
+        MICROPY_EVENT_POLL_HOOK
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(thread_pool_close_obj, thread_pool_close);
+
+STATIC const mp_rom_map_elem_t thread_pool_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_submit), MP_ROM_PTR(&thread_pool_submit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&thread_pool_wait_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&thread_pool_close_obj) },
+};
+
+STATIC MP_DEFINE_CONST_DICT(thread_pool_locals_dict, thread_pool_locals_dict_table);
+
+STATIC const mp_obj_type_t mp_type_thread_pool = {
+    { &mp_type_type },
+    .name = MP_QSTR_pool,
+    .make_new = thread_pool_make_new,
+    .locals_dict = (mp_obj_dict_t *)&thread_pool_locals_dict,
+};
+
+#endif // MICROPY_PY_THREAD_POOL
+
 typedef struct _thread_entry_args_t {
     mp_obj_dict_t *dict_locals;
     mp_obj_dict_t *dict_globals;
@@ -176,6 +421,23 @@ STATIC void *thread_entry(void *args_in) {
 
     ts.mp_pending_exception = MP_OBJ_NULL;
 
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+    ts.current_code_state = NULL;
+    #endif
+    #if MICROPY_CPU_PROFILE
+    ts.cpu_prof_countdown = 0;
+    #endif
+
+    #if MICROPY_OPT_CODE_STATE_POOL
+    memset(ts.code_state_pool, 0, sizeof(ts.code_state_pool));
+    #endif
+
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    // The block cache starts off empty on this thread.
+    memset(ts.gc_block_cache, 0, sizeof(ts.gc_block_cache));
+    memset(ts.gc_block_cache_len, 0, sizeof(ts.gc_block_cache_len));
+    #endif
+
     // set locals and globals from the calling context
     mp_locals_set(args->dict_locals);
     mp_globals_set(args->dict_globals);
@@ -292,6 +554,9 @@ STATIC const mp_rom_map_elem_t mp_module_thread_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_start_new_thread), MP_ROM_PTR(&mod_thread_start_new_thread_obj) },
     { MP_ROM_QSTR(MP_QSTR_exit), MP_ROM_PTR(&mod_thread_exit_obj) },
     { MP_ROM_QSTR(MP_QSTR_allocate_lock), MP_ROM_PTR(&mod_thread_allocate_lock_obj) },
+    #if MICROPY_PY_THREAD_POOL
+    { MP_ROM_QSTR(MP_QSTR_pool), MP_ROM_PTR(&mp_type_thread_pool) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_thread_globals, mp_module_thread_globals_table);
@@ -72,6 +72,7 @@ STATIC const mp_obj_dict_t errorcode_dict = {
     .base = {&mp_type_dict},
     .map = {
         .all_keys_are_qstrs = 0, // keys are integers
+        .all_keys_are_small_ints = 1,
         .is_fixed = 1,
         .is_ordered = 1,
         .used = MP_ARRAY_SIZE(errorcode_table),
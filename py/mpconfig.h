@@ -159,6 +159,79 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (1)
 #endif
 
+// Whether to defer finalisers to run outside the collector.  Instead of
+// calling __del__ methods inline during the sweep (which extends the
+// stop-the-world pause by an unbounded amount), unreachable finalisable
+// objects are queued in a 1-bit-per-block side table, kept alive together
+// with everything they reference, and their finalisers are run one at a
+// time from mp_handle_pending; the memory is then reclaimed by a later
+// collection.  Requires MICROPY_ENABLE_FINALISER and
+// MICROPY_ENABLE_SCHEDULER.
+#ifndef MICROPY_GC_DEFERRED_FINALISER
+#define MICROPY_GC_DEFERRED_FINALISER (0)
+#endif
+
+// Support an adaptive automatic-GC policy on top of the allocation
+// threshold: after each collection the threshold is re-armed to trigger
+// once the heap has grown by a configurable percentage of the data that
+// survived that collection, settable at runtime via gc.tune().  Requires
+// MICROPY_GC_ALLOC_THRESHOLD.
+#ifndef MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+#define MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE (0)
+#endif
+
+// Number of size classes for the free-block allocation hints.  Class n
+// (counting from 1) tracks the lowest ATB index at which a run of n free
+// blocks may start, with the last class covering all larger sizes.  More
+// classes speed up allocation on fragmented heaps at the cost of one word
+// of RAM each.
+#ifndef MICROPY_ATB_INDICES
+#define MICROPY_ATB_INDICES (8)
+#endif
+
+// Whether large allocations (MICROPY_GC_LARGE_FROM_TOP_BLOCKS GC blocks or
+// more) are taken from the top of the heap downwards, keeping them away
+// from the small-object churn at the bottom.  This slows the fragmentation
+// of long-running heaps, where interleaved small objects otherwise split up
+// the free runs needed for large buffers.
+#ifndef MICROPY_GC_LARGE_FROM_TOP
+#define MICROPY_GC_LARGE_FROM_TOP (0)
+#endif
+
+// Threshold in GC blocks at and above which an allocation counts as large;
+// must be bigger than MICROPY_ATB_INDICES
+#ifndef MICROPY_GC_LARGE_FROM_TOP_BLOCKS
+#define MICROPY_GC_LARGE_FROM_TOP_BLOCKS (16)
+#endif
+
+// Whether to support generational collection.  Blocks allocated since the
+// last collection are tracked in a 1-bit-per-block side table, and a minor
+// collection treats everything older as live: old blocks are marked in a
+// linear pass and scanned (also linearly) for references into the young
+// generation, so no write barrier is needed and the old object graph is
+// never traced.  Minor collections have much shorter and more predictable
+// pauses on large heaps; garbage in the old generation is only reclaimed
+// by a full gc_collect().  Costs 1 bit of RAM per GC block.
+#ifndef MICROPY_GC_GENERATIONAL
+#define MICROPY_GC_GENERATIONAL (0)
+#endif
+
+// Whether each thread keeps a small cache of free GC blocks.  The cache is
+// refilled in bulk under the GC lock, with the blocks marked allocated and
+// zeroed at that point, so that subsequent 1- and 2-block allocations are
+// served by a plain array pop with no locking.  This cuts contention on
+// the heap mutex in allocation-heavy threaded code; it only makes sense
+// with MICROPY_PY_THREAD enabled and the GIL disabled.
+#ifndef MICROPY_GC_THREAD_BLOCK_CACHE
+#define MICROPY_GC_THREAD_BLOCK_CACHE (0)
+#endif
+
+// Number of chunks of each size class (1 and 2 blocks) held in the
+// per-thread block cache.
+#ifndef MICROPY_GC_THREAD_BLOCK_CACHE_SIZE
+#define MICROPY_GC_THREAD_BLOCK_CACHE_SIZE (8)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -252,6 +325,15 @@
 #define MICROPY_QSTR_BYTES_IN_HASH (2)
 #endif
 
+// Whether to maintain an open-addressing hash table over all qstr pools so
+// that qstr_find_strn is O(1) instead of a linear scan of every pool.  The
+// table is built on the first dynamic intern, covers frozen/const pools too,
+// and is kept below half full; it costs one word per slot of heap.  Useful
+// when there are many qstrs (eg lots of frozen modules).
+#ifndef MICROPY_QSTR_HASH_INDEX
+#define MICROPY_QSTR_HASH_INDEX (0)
+#endif
+
 // Avoid using C stack when making Python function calls. C stack still
 // may be used if there's no free heap.
 #ifndef MICROPY_STACKLESS
@@ -265,6 +347,75 @@
 #define MICROPY_STACKLESS_STRICT (0)
 #endif
 
+// Whether to optimise tail calls in the VM: when a CALL_FUNCTION or
+// CALL_METHOD is immediately followed by RETURN_VALUE and the frame has no
+// active exception handlers, the frame is spliced out of the stackless call
+// chain so tail-recursive Python code runs in constant memory.  Requires
+// MICROPY_STACKLESS; not compatible with MICROPY_PY_SYS_SETTRACE or
+// MICROPY_ENABLE_PYSTACK (frames must then unwind one at a time).
+#ifndef MICROPY_STACKLESS_TAIL_CALL
+#define MICROPY_STACKLESS_TAIL_CALL (0)
+#endif
+
+// Whether to keep a small per-thread cache of recently finished code-state
+// blocks, so calls to functions whose state doesn't fit on the C stack can
+// reuse a block instead of going to the heap allocator every call.
+#ifndef MICROPY_OPT_CODE_STATE_POOL
+#define MICROPY_OPT_CODE_STATE_POOL (0)
+#endif
+
+// Number of entries in the code-state cache.
+#ifndef MICROPY_OPT_CODE_STATE_POOL_SIZE
+#define MICROPY_OPT_CODE_STATE_POOL_SIZE (4)
+#endif
+
+// Whether the VM only saves the instruction pointer (needed when an exception
+// is raised) at opcodes that can actually raise, instead of on every dispatch.
+// This shaves a store off the non-throwing path of each opcode at the cost of
+// a little extra code ROM.
+#ifndef MICROPY_OPT_VM_SELECTIVE_EXC_IP
+#define MICROPY_OPT_VM_SELECTIVE_EXC_IP (0)
+#endif
+
+// Whether to batch the fragments emitted while printing an object into a
+// small C-stack buffer, flushing them to the underlying printer in bulk.
+// Printing a container goes through the print callback at least once per
+// element (plus separators and quoting); batching turns that into a few
+// large writes, which matters when each write is a stream operation.
+#ifndef MICROPY_OPT_PRINT_BATCHING
+#define MICROPY_OPT_PRINT_BATCHING (0)
+#endif
+
+// Size in bytes of the print batching buffer (allocated on the C stack).
+#ifndef MICROPY_OPT_PRINT_BATCH_BUF_SIZE
+#define MICROPY_OPT_PRINT_BATCH_BUF_SIZE (128)
+#endif
+
+// Whether list.sort() uses a stable merge sort with the key function
+// evaluated once per element (CPython semantics).  Costs a temporary
+// array of len/2 (len if a key function is given) during the sort; when
+// disabled an in-place quicksort is used which allocates nothing but is
+// not stable and re-invokes the key function on every comparison.
+#ifndef MICROPY_OPT_LIST_SORT_STABLE
+#define MICROPY_OPT_LIST_SORT_STABLE (0)
+#endif
+
+// Maximum hash-map load in percent before an insertion grows the table.
+// The default of 100 keeps the historical behaviour of filling the table
+// completely before growing, which minimises RAM; lower values (eg 75)
+// keep probe runs short and lookup times stable on large dicts at the
+// cost of a sparser table.
+#ifndef MICROPY_MAP_MAX_LOAD_PERCENT
+#define MICROPY_MAP_MAX_LOAD_PERCENT (100)
+#endif
+
+// Whether to shrink a dict's hash table when deletions leave it below a
+// quarter full, so that iteration and memory use track the number of
+// entries rather than the table's high-water mark.
+#ifndef MICROPY_MAP_SHRINK_ON_DELETE
+#define MICROPY_MAP_SHRINK_ON_DELETE (0)
+#endif
+
 // Don't use alloca calls. As alloca() is not part of ANSI C, this
 // workaround option is provided for compilers lacking this de-facto
 // standard function. The way it works is allocating from heap, and
@@ -378,6 +529,23 @@
 #endif
 #endif
 
+// Whether the native emitter emits an inline speculative small-int fast path
+// for + and - on untyped (object) operands, instead of always calling the
+// runtime.  Only takes effect for object representations A and C.
+#ifndef MICROPY_EMIT_NATIVE_SMALLINT_ARITH
+#define MICROPY_EMIT_NATIVE_SMALLINT_ARITH (1)
+#endif
+
+// Whether native code loaded from a .mpy that lives in directly-addressable,
+// executable memory (eg a buffer in memory-mapped flash) should be executed in
+// place instead of being copied into RAM.  Only text that needs no load-time
+// patching (viper/asm functions without qstr links or relocations) can be used
+// in place; everything else falls back to the RAM copy.  Has no effect on
+// ports that define MP_PLAT_COMMIT_EXEC.
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_XIP
+#define MICROPY_PERSISTENT_CODE_LOAD_XIP (0)
+#endif
+
 /*****************************************************************************/
 /* Compiler configuration                                                    */
 
@@ -406,6 +574,30 @@
 #define MICROPY_COMP_CONST_FOLDING (1)
 #endif
 
+// Whether to extend constant folding to float arithmetic (eg 2.5*4 rewritten
+// as 10.0), string/bytes concatenation with +, and deduplication of equal
+// float/string/bytes constant objects across a module so that repeated
+// literals share one heap object.  True division of numeric constants is
+// also folded (the result is a float).  Saves import time and heap for
+// modules with many computed constants, at some compiler code-size cost.
+#ifndef MICROPY_COMP_CONST_FOLDING_EXTRA
+#define MICROPY_COMP_CONST_FOLDING_EXTRA (0)
+#endif
+
+// Whether the compiler should hoist loop-invariant loads out of for/while
+// loops in functions.  Global names that a loop body only reads, and
+// single-attribute loads (obj.attr) whose base is a read-only global or a
+// local not assigned in the body, are evaluated once into hidden locals
+// before the loop and the loads in the body become LOAD_FAST.  This is the
+// same transformation as the common hand-written "method = obj.method"
+// pattern and has the same caveats: rebinding such a name from outside the
+// loop body (another thread, a called function mutating globals, setattr)
+// is not seen until the loop exits, and attribute descriptors run once
+// up-front even if the loop body never runs.
+#ifndef MICROPY_COMP_HOIST_LOOP_INVARIANTS
+#define MICROPY_COMP_HOIST_LOOP_INVARIANTS (0)
+#endif
+
 // Whether to enable optimisations for constant literals, eg OrderedDict
 #ifndef MICROPY_COMP_CONST_LITERAL
 #define MICROPY_COMP_CONST_LITERAL (1)
@@ -447,6 +639,83 @@
 #define MICROPY_MEM_STATS (0)
 #endif
 
+// Whether to build a sampling heap profiler: every
+// MICROPY_MEM_PROFILE_INTERVAL'th m_malloc records the caller's PC and the
+// requested size in a ring buffer, dumped by micropython.mem_prof_dump().
+// The PCs are symbolised offline (eg with addr2line) against the firmware.
+#ifndef MICROPY_MEM_PROFILE
+#define MICROPY_MEM_PROFILE (0)
+#endif
+
+// Sample every Nth call to m_malloc when MICROPY_MEM_PROFILE is enabled
+#ifndef MICROPY_MEM_PROFILE_INTERVAL
+#define MICROPY_MEM_PROFILE_INTERVAL (64)
+#endif
+
+// Number of samples kept in the profiler's ring buffer
+#ifndef MICROPY_MEM_PROFILE_RING_LEN
+#define MICROPY_MEM_PROFILE_RING_LEN (64)
+#endif
+
+// Whether to build a sampling CPU profiler: every
+// MICROPY_CPU_PROFILE_INTERVAL'th VM poll point records the active bytecode
+// call stack (as qstr'd function names) in a preallocated ring buffer,
+// dumped in collapsed-stack format by micropython.cpu_prof_dump().  Unlike
+// sys.settrace this adds only a counter decrement to the running code.
+#ifndef MICROPY_CPU_PROFILE
+#define MICROPY_CPU_PROFILE (0)
+#endif
+
+// Sample every Nth VM poll point when MICROPY_CPU_PROFILE is enabled
+#ifndef MICROPY_CPU_PROFILE_INTERVAL
+#define MICROPY_CPU_PROFILE_INTERVAL (1024)
+#endif
+
+// Number of stack samples kept in the profiler's ring buffer
+#ifndef MICROPY_CPU_PROFILE_RING_LEN
+#define MICROPY_CPU_PROFILE_RING_LEN (64)
+#endif
+
+// Maximum number of frames recorded per stack sample (deeper frames are cut)
+#ifndef MICROPY_CPU_PROFILE_MAX_DEPTH
+#define MICROPY_CPU_PROFILE_MAX_DEPTH (8)
+#endif
+
+// Whether mp_obj_new_exception_msg_varg captures its format string and
+// arguments instead of formatting eagerly, deferring the printf work until
+// the message is printed or str()'d.  Exception-heavy code whose handlers
+// discard the message then skips formatting entirely.  The visible
+// difference is that such an exception's args[0] is a str-like proxy rather
+// than a real str instance.
+#ifndef MICROPY_LAZY_EXC_MSG
+#define MICROPY_LAZY_EXC_MSG (0)
+#endif
+
+// Maximum captured arguments per message; formats with more (or with
+// directives that aren't word-sized) fall back to eager formatting
+#ifndef MICROPY_LAZY_EXC_MSG_MAX_ARGS
+#define MICROPY_LAZY_EXC_MSG_MAX_ARGS (4)
+#endif
+
+// Whether no-argument raises of a few control-flow exception types
+// (StopIteration, IndexError, KeyError; see mp_prealloc_exc_types in
+// py/objexcept.c) reuse preallocated instances with a fixed traceback
+// buffer, making such raises heap-free.  The trade-off is that two live
+// no-argument instances of the same type are the same object.
+#ifndef MICROPY_PREALLOC_EXC
+#define MICROPY_PREALLOC_EXC (0)
+#endif
+
+// Number of preallocated exception instances; must match the type table
+#ifndef MICROPY_PREALLOC_EXC_NUM
+#define MICROPY_PREALLOC_EXC_NUM (3)
+#endif
+
+// Words of traceback storage per preallocated instance (3 words per frame)
+#ifndef MICROPY_PREALLOC_EXC_TB_LEN
+#define MICROPY_PREALLOC_EXC_TB_LEN (12)
+#endif
+
 // The mp_print_t printer used for debugging output
 #ifndef MICROPY_DEBUG_PRINTER
 #define MICROPY_DEBUG_PRINTER (&mp_plat_print)
@@ -479,6 +748,13 @@
 #define MICROPY_DEBUG_VM_STACK_OVERFLOW (0)
 #endif
 
+// Whether to count how many times each opcode is executed in the VM, for
+// finding dispatch hot spots.  The counters are printed (and optionally
+// reset) with micropython.opcode_stats().
+#ifndef MICROPY_DEBUG_VM_OPCODE_STATS
+#define MICROPY_DEBUG_VM_OPCODE_STATS (0)
+#endif
+
 /*****************************************************************************/
 /* Optimisations                                                             */
 
@@ -491,18 +767,127 @@
 #endif
 
 // Whether to cache result of map lookups in LOAD_NAME, LOAD_GLOBAL, LOAD_ATTR,
-// STORE_ATTR bytecodes.  Uses 1 byte extra RAM for each of these opcodes and
+// LOAD_METHOD, STORE_ATTR bytecodes.  Uses 1 byte extra RAM for each of these opcodes and
 // uses a bit of extra code ROM, but greatly improves lookup speed.
 #ifndef MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (0)
 #endif
 
+// Whether to fuse common opcode pairs (eg LOAD_FAST+LOAD_FAST) into single
+// superinstructions when bytecode is assigned to a raw code object, to reduce
+// dispatch overhead in tight loops.  Uses a bit of extra code ROM.  The fused
+// opcodes are an internal detail of the VM so this option cannot be used
+// together with MICROPY_PERSISTENT_CODE_SAVE.
+#ifndef MICROPY_OPT_VM_SUPERINSTRUCTIONS
+#define MICROPY_OPT_VM_SUPERINSTRUCTIONS (0)
+#endif
+
+// Whether the parser computes, per parse, a table of which tokens each
+// grammar rule can start with, so that alternatives of an or-rule which
+// cannot possibly match the current token are skipped without pushing and
+// popping them on the rule stack.  Speeds up parsing at the cost of about
+// 2.5k of heap during the parse only.
+#ifndef MICROPY_OPT_PARSE_RULE_FIRST_SET
+#define MICROPY_OPT_PARSE_RULE_FIRST_SET (0)
+#endif
+
+// Whether to keep a per-scope hash index over the identifiers seen during
+// scope analysis, so that looking up a name during compilation is O(1)
+// instead of a linear scan of all names in the scope.  Mainly of benefit
+// when compiling machine-generated modules with very many names; uses some
+// extra heap during compilation only.
+#ifndef MICROPY_OPT_SCOPE_ID_INDEX
+#define MICROPY_OPT_SCOPE_ID_INDEX (0)
+#endif
+
+// Whether to cache class attribute lookups in a small global table keyed by
+// (type, attr qstr), so that repeated lookups of inherited methods don't walk
+// the base-class chain probing each locals dict.  The cache is invalidated
+// whenever a class attribute is stored or deleted.  Uses extra RAM for the
+// table (see MICROPY_OPT_MRO_CACHE_SIZE) and a bit of extra code ROM.
+#ifndef MICROPY_OPT_MRO_CACHE
+#define MICROPY_OPT_MRO_CACHE (0)
+#endif
+
+// Number of entries in the class attribute lookup cache; must be a power of 2.
+#ifndef MICROPY_OPT_MRO_CACHE_SIZE
+#define MICROPY_OPT_MRO_CACHE_SIZE (32)
+#endif
+
+// Whether to cache bound method objects so that re-binding the same method
+// to the same object (eg registering obj.callback with a timer every tick)
+// returns the existing object instead of allocating a fresh one.  The cache
+// holds strong references so it can delay collection of up to
+// MICROPY_OPT_BOUND_METH_CACHE_SIZE (self, method) pairs.
+#ifndef MICROPY_OPT_BOUND_METH_CACHE
+#define MICROPY_OPT_BOUND_METH_CACHE (0)
+#endif
+
+// Number of entries in the bound method cache; must be a power of 2.
+#ifndef MICROPY_OPT_BOUND_METH_CACHE_SIZE
+#define MICROPY_OPT_BOUND_METH_CACHE_SIZE (8)
+#endif
+
+// Whether set operations (union, intersection, difference and their
+// in-place forms) walk the other operand's hash table directly when it is
+// also a set, instead of going through the iterator protocol.  Intersection
+// additionally iterates the smaller operand and pre-sizes its result so it
+// never rehashes.  Uses a bit of extra code ROM.
+#ifndef MICROPY_OPT_SET_BULK_OPS
+#define MICROPY_OPT_SET_BULK_OPS (0)
+#endif
+
+// Whether unicode strings remember the position of their last index
+// operation and start the next utf-8 walk from there, making sequential
+// and localised indexing of long strings O(1) amortised instead of O(n)
+// per access.  Costs 2 words per heap string object.  Only takes effect
+// together with MICROPY_PY_BUILTINS_STR_UNICODE.
+#ifndef MICROPY_OPT_STR_INDEX_ANCHOR
+#define MICROPY_OPT_STR_INDEX_ANCHOR (0)
+#endif
+
+// Whether to cache the qstr for each single ASCII character string the
+// first time it is created, so s[i], chr() and character iteration become
+// a table load instead of a search of the qstr pool.  Costs 128 words of
+// RAM in the VM state.
+#ifndef MICROPY_OPT_CHAR_QSTR_CACHE
+#define MICROPY_OPT_CHAR_QSTR_CACHE (0)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (0)
 #endif
 
+// Whether mp_obj_new_float interns recently boxed values: a small cache of
+// float objects is kept, keyed by bit pattern, and boxing a value that's
+// still in the cache reuses the existing (immutable) object instead of
+// allocating.  Only useful on configurations where floats are heap-boxed
+// (ie not MICROPY_OBJ_REPR_C/MICROPY_OBJ_REPR_D).
+#ifndef MICROPY_OPT_FLOAT_INTERN
+#define MICROPY_OPT_FLOAT_INTERN (0)
+#endif
+
+// Number of entries in the float interning cache (must be a power of 2)
+#ifndef MICROPY_OPT_FLOAT_INTERN_CACHE_SIZE
+#define MICROPY_OPT_FLOAT_INTERN_CACHE_SIZE (16)
+#endif
+
+// Whether mpz binary operations try to do the arithmetic in a machine
+// long long first, so results of operations on values that only slightly
+// exceed the small-int range don't need to allocate an mpz.
+#ifndef MICROPY_OPT_MPZ_INT64
+#define MICROPY_OPT_MPZ_INT64 (0)
+#endif
+
+// Whether to use Karatsuba's algorithm when multiplying large mpz numbers,
+// instead of the plain O(n^2) schoolbook loop.  Costs some code size and
+// heap for scratch buffers, but is much faster above a few hundred bits.
+#ifndef MICROPY_OPT_MPZ_KARATSUBA
+#define MICROPY_OPT_MPZ_KARATSUBA (0)
+#endif
+
 
 // Whether math.factorial is large, fast and recursive (1) or small and slow (0).
 #ifndef MICROPY_OPT_MATH_FACTORIAL
@@ -519,6 +904,27 @@
 #define MICROPY_ENABLE_EXTERNAL_IMPORT (1)
 #endif
 
+// Whether imports of .py files keep a compiled-code cache on the filesystem.
+// After a source file is compiled its raw code is saved next to the source
+// as a .mpc file (a 4-byte source hash followed by standard .mpy data), and
+// later imports load the cache instead of recompiling while the source hash
+// still matches.  Requires the compiler, persistent code save and load, and
+// a file reader; cache writes are best-effort (failures, eg on a read-only
+// filesystem, are ignored and the import proceeds normally).
+#ifndef MICROPY_MODULE_COMPILE_CACHE
+#define MICROPY_MODULE_COMPILE_CACHE (0)
+#endif
+
+// Whether the import machinery keeps a cache of filesystem stat results, so
+// repeated probing of the same paths (each import stats every extension on
+// every sys.path entry) doesn't hit the filesystem again.  Negative results
+// are cached too; the cache is cleared when a filesystem is (un)mounted or
+// the current directory is changed, but creating a module file by other
+// means won't be noticed until then.
+#ifndef MICROPY_MODULE_IMPORT_STAT_CACHE
+#define MICROPY_MODULE_IMPORT_STAT_CACHE (0)
+#endif
+
 // Whether to use the POSIX reader for importing files
 #ifndef MICROPY_READER_POSIX
 #define MICROPY_READER_POSIX (0)
@@ -534,6 +940,30 @@
 #define MICROPY_HAS_FILE_READER (MICROPY_READER_POSIX || MICROPY_READER_VFS)
 #endif
 
+// Whether parse-tree struct nodes record the source line of their rule.
+// Disabling saves one word per interior parse node, lowering peak RAM while
+// compiling large scripts, but SyntaxError messages then report line 0 and
+// bytecode line info degrades - so it should only be turned off together
+// with MICROPY_ENABLE_SOURCE_LINE.
+#ifndef MICROPY_PARSE_NODE_SOURCE_LINE
+#define MICROPY_PARSE_NODE_SOURCE_LINE (1)
+#endif
+
+// Size of the buffer used by the POSIX and VFS file readers; each refill is
+// one read/mp_stream_rw call, so a larger buffer means fewer calls when
+// lexing a file.  The buffer only exists while the reader is open.
+#ifndef MICROPY_READER_BUF_SIZE
+#define MICROPY_READER_BUF_SIZE (128)
+#endif
+
+// Whether the POSIX file reader should try to mmap(2) regular files and read
+// from the mapping, avoiding read syscalls and buffer copies while lexing or
+// loading .mpy files.  Falls back to buffered read() for pipes, ttys and
+// anything else that can't be mapped.
+#ifndef MICROPY_READER_POSIX_MMAP
+#define MICROPY_READER_POSIX_MMAP (0)
+#endif
+
 // Hook for the VM at the start of the opcode loop (can contain variable
 // definitions usable by the other hook functions)
 #ifndef MICROPY_VM_HOOK_INIT
@@ -556,6 +986,31 @@
 #define MICROPY_SCHED_HOOK_SCHEDULED
 #endif
 
+// Whether to record garbage collector, allocation and scheduler tracepoints
+// as fixed-size binary records in a small ring, drained to any stream with
+// micropython.trace_drain(stream); tools/mptrace.py decodes the output.
+#ifndef MICROPY_TRACE
+#define MICROPY_TRACE (0)
+#endif
+
+// Number of records in the trace ring (each record is 16 bytes)
+#ifndef MICROPY_TRACE_RING_LEN
+#define MICROPY_TRACE_RING_LEN (128)
+#endif
+
+// Number of power-of-two allocation size classes counted between drains
+#ifndef MICROPY_TRACE_ALLOC_CLASSES
+#define MICROPY_TRACE_ALLOC_CLASSES (8)
+#endif
+
+// Hook for timestamping the phases of start-up; called with a short C-string
+// phase name as each phase begins.  The core marks "mp_init" and
+// "mp_init_done", and ports can call it themselves around their boot scripts
+// to see where cold-boot time goes.
+#ifndef MICROPY_BOOT_PHASE_HOOK
+#define MICROPY_BOOT_PHASE_HOOK(phase)
+#endif
+
 // Whether to include the garbage collector
 #ifndef MICROPY_ENABLE_GC
 #define MICROPY_ENABLE_GC (0)
@@ -639,6 +1094,20 @@
 #define MICROPY_REPL_AUTO_INDENT (0)
 #endif
 
+// Whether to handle terminal bracketed paste (ESC[200~ .. ESC[201~) in the
+// REPL readline: pasted characters are inserted in bulk and echoed once per
+// line instead of a redraw per character, and auto-indent is suspended so
+// pasted code keeps its own indentation.
+#ifndef MICROPY_REPL_BRACKETED_PASTE
+#define MICROPY_REPL_BRACKETED_PASTE (0)
+#endif
+
+// Whether Ctrl-R in the REPL readline searches backwards through the history
+// for an entry beginning with the text before the cursor
+#ifndef MICROPY_REPL_HIST_SEARCH
+#define MICROPY_REPL_HIST_SEARCH (0)
+#endif
+
 // Whether port requires event-driven REPL functions
 #ifndef MICROPY_REPL_EVENT_DRIVEN
 #define MICROPY_REPL_EVENT_DRIVEN (0)
@@ -728,12 +1197,34 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_COMPLEX (MICROPY_PY_BUILTINS_FLOAT)
 #endif
 
+// Whether the viper native emitter supports the "fp" type, which holds a
+// float as its raw bits in an integer register/word, with arithmetic done
+// by single calls into the runtime rather than by boxing to float objects.
+// Requires mp_float_t to fit in a machine word.
+#ifndef MICROPY_EMIT_NATIVE_VIPER_FLOAT
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_FLOAT || defined(__LP64__) || defined(_WIN64)
+#define MICROPY_EMIT_NATIVE_VIPER_FLOAT (MICROPY_EMIT_NATIVE && MICROPY_PY_BUILTINS_FLOAT)
+#else
+#define MICROPY_EMIT_NATIVE_VIPER_FLOAT (0)
+#endif
+#endif
+
 // Whether to provide a high-quality hash for float and complex numbers.
 // Otherwise the default is a very simple but correct hashing function.
 #ifndef MICROPY_FLOAT_HIGH_QUALITY_HASH
 #define MICROPY_FLOAT_HIGH_QUALITY_HASH (0)
 #endif
 
+// Whether mp_format_float should extract mantissa digits in integer batches
+// instead of one float multiply/subtract round-trip per digit.  Costs a
+// small table of constants; worthwhile on targets with software floating
+// point that serialise floats in bulk (e.g. telemetry through json.dumps).
+// Digits beyond the precision of the float type may differ from the
+// default formatter (both methods only approximate them).
+#ifndef MICROPY_FLOAT_FORMAT_FAST
+#define MICROPY_FLOAT_FORMAT_FAST (0)
+#endif
+
 // Enable features which improve CPython compatibility
 // but may lead to more code size/memory usage.
 // TODO: Originally intended as generic category to not
@@ -762,11 +1253,33 @@ typedef double mp_float_t;
 #define MICROPY_STREAMS_POSIX_API (0)
 #endif
 
+// Whether the stream protocol has an optional vectored (scatter/gather)
+// write entry, with a per-segment fallback for streams that don't
+// implement it, and streams expose a writev() method.
+#ifndef MICROPY_STREAMS_WRITEV
+#define MICROPY_STREAMS_WRITEV (0)
+#endif
+
+// Whether to provide the sendfile() helper which copies data from one
+// stream to another via a single reusable buffer, avoiding the per-chunk
+// object allocation and VM dispatch of a Python read/write loop.
+#ifndef MICROPY_STREAMS_SENDFILE
+#define MICROPY_STREAMS_SENDFILE (0)
+#endif
+
 // Whether to call __init__ when importing builtin modules for the first time
 #ifndef MICROPY_MODULE_BUILTIN_INIT
 #define MICROPY_MODULE_BUILTIN_INIT (0)
 #endif
 
+// Whether to defer a builtin module's __init__ from import time to the first
+// attribute load on the module, so boot scripts that import many modules
+// don't pay for initialising the ones they never touch.  Requires
+// MICROPY_MODULE_BUILTIN_INIT.
+#ifndef MICROPY_MODULE_DEFER_BUILTIN_INIT
+#define MICROPY_MODULE_DEFER_BUILTIN_INIT (0)
+#endif
+
 // Whether to support module-level __getattr__ (see PEP 562)
 #ifndef MICROPY_MODULE_GETATTR
 #define MICROPY_MODULE_GETATTR (1)
@@ -787,6 +1300,27 @@ typedef double mp_float_t;
 #define MICROPY_MODULE_FROZEN_MPY (0)
 #endif
 
+// Whether importing a frozen .mpy module should defer execution of the module
+// body until the first attribute load on the module object.  This reduces the
+// cost of importing a package whose __init__ eagerly imports many submodules,
+// at the expense of running module side effects later than CPython would.
+#ifndef MICROPY_MODULE_FROZEN_LAZY
+#define MICROPY_MODULE_FROZEN_LAZY (0)
+#endif
+
+// Whether importing a .mpy file from the filesystem should defer loading and
+// executing it until the first attribute load on the module object.  Like
+// MICROPY_MODULE_FROZEN_LAZY but for runtime-loaded .mpy files; the file is
+// not even read at import time, so it must still exist when first used.
+#ifndef MICROPY_MODULE_LAZY_MPY
+#define MICROPY_MODULE_LAZY_MPY (0)
+#endif
+
+// Convenience macro for whether any form of lazy module execution is enabled
+#ifndef MICROPY_MODULE_LAZY
+#define MICROPY_MODULE_LAZY (MICROPY_MODULE_FROZEN_LAZY || MICROPY_MODULE_LAZY_MPY)
+#endif
+
 // Convenience macro for whether frozen modules are supported
 #ifndef MICROPY_MODULE_FROZEN
 #define MICROPY_MODULE_FROZEN (MICROPY_MODULE_FROZEN_STR || MICROPY_MODULE_FROZEN_MPY)
@@ -826,11 +1360,91 @@ typedef double mp_float_t;
 #define MICROPY_SCHEDULER_DEPTH (4)
 #endif
 
+// Whether mp_sched_schedule enqueues lock-free (requires GCC/Clang
+// __atomic builtins).  Concurrent producers (ISRs, other threads) then
+// reserve ring slots with a compare-and-swap instead of contending on an
+// IRQ-disable critical section; the consumer still drains the queue under
+// the atomic section at VM checkpoints.
+#ifndef MICROPY_SCHEDULER_LOCKFREE
+#define MICROPY_SCHEDULER_LOCKFREE (0)
+#endif
+
+// Whether registering a hard IRQ handler requires it to be a viper/native
+// compiled function (or inline assembler).  Hard handlers run in ISR
+// context with the GC locked, so a bytecode handler can hit an allocation
+// (and raise MemoryError) at the worst possible time; native code with a
+// fixed C-stack frame avoids the VM entirely and gives bounded latency.
+#ifndef MICROPY_IRQ_CHECK_HARD_HANDLER
+#define MICROPY_IRQ_CHECK_HARD_HANDLER (0)
+#endif
+
+// Maximum number of scheduled callbacks to run per VM pending-exception
+// check.  The default of 1 keeps the pause at each checkpoint as short as
+// possible; a larger value amortises the checkpoint overhead when many
+// callbacks are queued, at the cost of a longer worst-case pause.
+#ifndef MICROPY_SCHEDULER_DRAIN_MAX
+#define MICROPY_SCHEDULER_DRAIN_MAX (1)
+#endif
+
+// Whether to provide mp_sched_schedule_priority, a separate high-priority
+// lane that mp_handle_pending drains ahead of the regular queue.  Latency-
+// sensitive callbacks (e.g. the BLE event callback of extmod/modbluetooth.c)
+// then run at the next VM checkpoint even when bulk callbacks are backed up.
+#ifndef MICROPY_SCHEDULER_PRIORITY
+#define MICROPY_SCHEDULER_PRIORITY (0)
+#endif
+
+// Maximum number of entries in the high-priority scheduler lane
+#ifndef MICROPY_SCHEDULER_PRIORITY_DEPTH
+#define MICROPY_SCHEDULER_PRIORITY_DEPTH (4)
+#endif
+
 // Support for generic VFS sub-system
 #ifndef MICROPY_VFS
 #define MICROPY_VFS (0)
 #endif
 
+// Whether to put a write-back cache of consecutive blocks between the
+// filesystems and the block device.  A cache miss fills the whole window
+// with one readblocks call, so sector-at-a-time filesystem access turns
+// into multi-block device transfers.
+#ifndef MICROPY_VFS_BLOCKDEV_CACHE
+#define MICROPY_VFS_BLOCKDEV_CACHE (0)
+#endif
+
+// Number of blocks held by the block-device cache
+#ifndef MICROPY_VFS_BLOCKDEV_CACHE_SIZE
+#define MICROPY_VFS_BLOCKDEV_CACHE_SIZE (8)
+#endif
+
+// Whether block devices are informed of freed blocks.  Filesystem deletes
+// are forwarded to the device as MP_BLOCKDEV_IOCTL_BLOCK_TRIM, delivered
+// from the scheduler (when enabled) so the device can pre-erase freed
+// blocks in the background instead of erasing inside the write path.
+#ifndef MICROPY_VFS_BLOCKDEV_TRIM
+#define MICROPY_VFS_BLOCKDEV_TRIM (0)
+#endif
+
+// Number of trimmed block ranges that can be queued for background delivery
+#ifndef MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE
+#define MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE (4)
+#endif
+
+// Whether uos.stat/statvfs results are cached in the VFS layer.  Entries
+// are keyed on absolute path and invalidated by a per-mount generation
+// counter bumped by any modification made through uos (open for write,
+// remove, rename, mkdir, rmdir); repeatedly statting the same files then
+// costs no filesystem access.  Data written through an already-open file
+// handle is only noticed at the next such modification.
+#ifndef MICROPY_VFS_STAT_CACHE
+#define MICROPY_VFS_STAT_CACHE (0)
+#endif
+
+// Number of entries held by the stat cache
+#ifndef MICROPY_VFS_STAT_CACHE_SIZE
+#define MICROPY_VFS_STAT_CACHE_SIZE (8)
+#endif
+
 // Support for VFS POSIX component, to mount a POSIX filesystem within VFS
 #ifndef MICROPY_VFS
 #define MICROPY_VFS_POSIX (0)
@@ -841,6 +1455,12 @@ typedef double mp_float_t;
 #define MICROPY_VFS_FAT (0)
 #endif
 
+// Support for VFS bundle component, to mount a read-only bundle image
+// (created with tools/mpbundle.py) within VFS
+#ifndef MICROPY_VFS_BUNDLE
+#define MICROPY_VFS_BUNDLE (0)
+#endif
+
 /*****************************************************************************/
 /* Fine control over Python builtins, classes, modules, etc                  */
 
@@ -975,11 +1595,27 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_FROZENSET (0)
 #endif
 
+// Whether to provide the list.reserve(n) method (MicroPython extension).
+// It pre-grows a list's backing store so that appending up to n items does
+// a single allocation instead of repeated doubling reallocations.
+#ifndef MICROPY_PY_LIST_RESERVE
+#define MICROPY_PY_LIST_RESERVE (0)
+#endif
+
 // Whether to support property object
 #ifndef MICROPY_PY_BUILTINS_PROPERTY
 #define MICROPY_PY_BUILTINS_PROPERTY (1)
 #endif
 
+// Whether to honour __slots__ declarations on Python classes (partial
+// support: the declared names are counted once at class creation and used
+// to pre-size the attribute map of each new instance, avoiding the rehash
+// churn and over-allocation of growing it one attribute at a time;
+// attribute assignment is not restricted to the declared names).
+#ifndef MICROPY_PY_SLOTS
+#define MICROPY_PY_SLOTS (0)
+#endif
+
 // Whether to implement the start/stop/step attributes (readback) on
 // the "range" builtin type. Rarely used, and costs ~60 bytes (x86).
 #ifndef MICROPY_PY_BUILTINS_RANGE_ATTRS
@@ -1127,6 +1763,14 @@ typedef double mp_float_t;
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN (0)
 #endif
 
+// Whether to support elementwise arithmetic on array.array (MicroPython
+// extension): a - b, a * b, a * scalar and their in-place forms operate
+// elementwise on the typed buffers, and a @ b computes the dot product.
+// a + b remains concatenation for CPython compatibility.
+#ifndef MICROPY_PY_ARRAY_MATH
+#define MICROPY_PY_ARRAY_MATH (0)
+#endif
+
 // Whether to support attrtuple type (MicroPython extension)
 // It provides space-efficient tuples with attribute access
 #ifndef MICROPY_PY_ATTRTUPLE
@@ -1143,6 +1787,14 @@ typedef double mp_float_t;
 #define MICROPY_PY_COLLECTIONS_DEQUE (0)
 #endif
 
+// Whether to extend "ucollections.deque" into a general double-ended queue:
+// adds appendleft() and pop(), and makes a maxlen of 0 mean "no bound", with
+// the circular buffer growing on demand.  All operations stay O(1), unlike
+// the del lst[0:n] pattern on lists which shifts the whole tail.
+#ifndef MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+#define MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED (0)
+#endif
+
 // Whether to provide "collections.OrderedDict" type
 #ifndef MICROPY_PY_COLLECTIONS_ORDEREDDICT
 #define MICROPY_PY_COLLECTIONS_ORDEREDDICT (0)
@@ -1153,6 +1805,13 @@ typedef double mp_float_t;
 #define MICROPY_PY_COLLECTIONS_NAMEDTUPLE__ASDICT (0)
 #endif
 
+// Whether to build a sorted field-index table for each namedtuple type so
+// that field access binary searches it, instead of scanning the field names
+// linearly on every access.  Uses 2 bytes of RAM per field per type.
+#ifndef MICROPY_PY_COLLECTIONS_NAMEDTUPLE_FIELD_INDEX
+#define MICROPY_PY_COLLECTIONS_NAMEDTUPLE_FIELD_INDEX (0)
+#endif
+
 // Whether to provide "math" module
 #ifndef MICROPY_PY_MATH
 #define MICROPY_PY_MATH (1)
@@ -1244,6 +1903,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_IO_BUFFEREDWRITER (0)
 #endif
 
+// Whether to provide "io.BufferedReader" class
+#ifndef MICROPY_PY_IO_BUFFEREDREADER
+#define MICROPY_PY_IO_BUFFEREDREADER (0)
+#endif
+
 // Whether to provide "struct" module
 #ifndef MICROPY_PY_STRUCT
 #define MICROPY_PY_STRUCT (1)
@@ -1356,12 +2020,79 @@ typedef double mp_float_t;
 #define MICROPY_PY_THREAD_GIL_VM_DIVISOR (32)
 #endif
 
+// Whether each list and dict carries its own mutex, taken around the
+// structural operations (append, pop, store, resize, rehash, ...), so
+// that threads running without the GIL can safely share these containers
+// without Python-level locking.  The GC and qstr pools already have their
+// own locks, so with this enabled pure-compute threads run in parallel.
+// Operations that call back into Python while working on the container
+// (sort, comparisons via __eq__/__hash__ of user classes, iteration
+// bodies) run outside the lock and still need user-level synchronisation,
+// as does C code that accesses the item arrays directly.  Costs one mutex
+// of RAM per container; requires MICROPY_PY_THREAD without the GIL.
+#ifndef MICROPY_PY_THREAD_SAFE_CONTAINERS
+#define MICROPY_PY_THREAD_SAFE_CONTAINERS (0)
+#endif
+
+// Whether to provide _thread.pool, a pool of persistent worker threads
+// with a shared task queue.  Workers and their stacks are allocated once
+// when the pool is created and reused for every submitted task, so the
+// cost of running a short task is one queue operation rather than a full
+// thread spawn (stack allocation plus GC registration).
+#ifndef MICROPY_PY_THREAD_POOL
+#define MICROPY_PY_THREAD_POOL (0)
+#endif
+
 // Extended modules
 
 #ifndef MICROPY_PY_UASYNCIO
 #define MICROPY_PY_UASYNCIO (0)
 #endif
 
+// Whether to provide native awaitable stream read/readline/write helpers in
+// the _uasyncio module; uasyncio's Stream uses them when available so
+// per-chunk scheduling of stream IO stays out of Python bytecode
+#ifndef MICROPY_PY_UASYNCIO_STREAM
+#define MICROPY_PY_UASYNCIO_STREAM (MICROPY_PY_UASYNCIO)
+#endif
+
+// Whether the uasyncio TaskQueue puts sub-second timers on a timing wheel
+// with O(1) insert and cancel, instead of in the pairing heap.  Worth it
+// for workloads that create and cancel many short timeouts (eg per-request
+// deadlines); costs one lazily-allocated 64-pointer table per TaskQueue
+#ifndef MICROPY_PY_UASYNCIO_TIMER_WHEEL
+#define MICROPY_PY_UASYNCIO_TIMER_WHEEL (0)
+#endif
+
+// Whether the uasyncio TaskQueue keeps ready tasks in three priority lanes
+// (0 highest; Task.priority, default 1), draining higher lanes first with an
+// anti-starvation bound so low-priority bulk work still makes progress.
+// Lets hard-latency and bulk coroutines share one loop
+#ifndef MICROPY_PY_UASYNCIO_PRIORITY_LANES
+#define MICROPY_PY_UASYNCIO_PRIORITY_LANES (0)
+#endif
+
+// Whether to provide _uasyncio.ThreadSafeQueue, a fixed-size inbox for
+// posting objects from another thread (or scheduler context) into a
+// uasyncio loop.  Ports whose poller blocks on file descriptors must also
+// set MICROPY_PY_UASYNCIO_TSQUEUE_PIPE so the consumer can be woken
+#ifndef MICROPY_PY_UASYNCIO_TSQUEUE
+#define MICROPY_PY_UASYNCIO_TSQUEUE (0)
+#endif
+
+// Whether ThreadSafeQueue wakes the poller through a POSIX pipe
+#ifndef MICROPY_PY_UASYNCIO_TSQUEUE_PIPE
+#define MICROPY_PY_UASYNCIO_TSQUEUE_PIPE (0)
+#endif
+
+// Whether the native uasyncio run loop keeps per-Task statistics (resume
+// count, cumulative and worst-case slice duration in us, time spent
+// runnable but not running in ms), readable as attributes on the Task.
+// For finding the coroutine that overruns a latency budget in the field
+#ifndef MICROPY_PY_UASYNCIO_STATS
+#define MICROPY_PY_UASYNCIO_STATS (0)
+#endif
+
 #ifndef MICROPY_PY_UCTYPES
 #define MICROPY_PY_UCTYPES (0)
 #endif
@@ -1372,10 +2103,23 @@ typedef double mp_float_t;
 #define MICROPY_PY_UCTYPES_NATIVE_C_TYPES (1)
 #endif
 
+// Whether uctypes struct objects remember the last attribute resolved in
+// their descriptor, skipping the dict lookup on repeated access to the same
+// field (costs two words per struct object; assumes descriptors are not
+// mutated while in use)
+#ifndef MICROPY_PY_UCTYPES_ATTR_CACHE
+#define MICROPY_PY_UCTYPES_ATTR_CACHE (0)
+#endif
+
 #ifndef MICROPY_PY_UZLIB
 #define MICROPY_PY_UZLIB (0)
 #endif
 
+// Whether to provide uzlib.compress and uzlib.CompIO (DEFLATE encoder)
+#ifndef MICROPY_PY_UZLIB_COMPRESS
+#define MICROPY_PY_UZLIB_COMPRESS (0)
+#endif
+
 #ifndef MICROPY_PY_UJSON
 #define MICROPY_PY_UJSON (0)
 #endif
@@ -1385,6 +2129,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_UJSON_SEPARATORS (1)
 #endif
 
+// Whether to provide ujson.tokenize, an incremental event-based parser that
+// walks a JSON stream in O(depth) memory instead of building the object tree
+#ifndef MICROPY_PY_UJSON_TOKENIZE
+#define MICROPY_PY_UJSON_TOKENIZE (0)
+#endif
+
 #ifndef MICROPY_PY_URE
 #define MICROPY_PY_URE (0)
 #endif
@@ -1401,6 +2151,27 @@ typedef double mp_float_t;
 #define MICROPY_PY_URE_MATCH_SPAN_START_END (0)
 #endif
 
+// Whether to provide ure.finditer, iterating over all matches in one pass
+// over the input with a single recycled match object
+#ifndef MICROPY_PY_URE_FINDITER
+#define MICROPY_PY_URE_FINDITER (0)
+#endif
+
+// Size of the most-recently-used cache of compiled regexes kept by
+// ure.compile (and by match/search/sub called with a pattern string), so
+// hot patterns aren't recompiled on every call.  0 disables the cache
+#ifndef MICROPY_PY_URE_CACHE_SIZE
+#define MICROPY_PY_URE_CACHE_SIZE (0)
+#endif
+
+// Whether to execute regexes with a Pike VM (all alternatives advanced in
+// lock step) instead of the backtracking engine, making match time linear
+// in the input length even for patterns that backtrack exponentially.
+// Costs a few temporary allocations per match
+#ifndef MICROPY_PY_URE_PIKEVM
+#define MICROPY_PY_URE_PIKEVM (0)
+#endif
+
 #ifndef MICROPY_PY_URE_SUB
 #define MICROPY_PY_URE_SUB (0)
 #endif
@@ -1409,6 +2180,18 @@ typedef double mp_float_t;
 #define MICROPY_PY_UHEAPQ (0)
 #endif
 
+// Whether to provide "uparallel" module (data-parallel map over worker
+// threads; requires MICROPY_PY_THREAD, and only gives a speedup without
+// the GIL)
+#ifndef MICROPY_PY_UPARALLEL
+#define MICROPY_PY_UPARALLEL (0)
+#endif
+
+// Default number of threads (including the caller) used by uparallel.map
+#ifndef MICROPY_PY_UPARALLEL_WORKERS
+#define MICROPY_PY_UPARALLEL_WORKERS (2)
+#endif
+
 // Optimized heap queue for relative timestamps
 #ifndef MICROPY_PY_UTIMEQ
 #define MICROPY_PY_UTIMEQ (0)
@@ -1430,6 +2213,18 @@ typedef double mp_float_t;
 #define MICROPY_PY_UHASHLIB_SHA256 (1)
 #endif
 
+// Whether the port provides the SHA-256 implementation, e.g. a hardware
+// engine, via mp_hal_sha256_context_t and the mp_hal_sha256_* functions
+#ifndef MICROPY_PY_UHASHLIB_SHA256_PORT_IMPL
+#define MICROPY_PY_UHASHLIB_SHA256_PORT_IMPL (0)
+#endif
+
+// Whether to provide hash.update_from(stream, nbytes), feeding a stream
+// into the hash without creating a bytes object per chunk
+#ifndef MICROPY_PY_UHASHLIB_UPDATE_FROM
+#define MICROPY_PY_UHASHLIB_UPDATE_FROM (0)
+#endif
+
 #ifndef MICROPY_PY_UCRYPTOLIB
 #define MICROPY_PY_UCRYPTOLIB (0)
 #endif
@@ -1439,6 +2234,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_UCRYPTOLIB_CTR (0)
 #endif
 
+// Whether the port provides the AES implementation, e.g. a hardware engine,
+// via mp_hal_aes_context_t and the mp_hal_aes_* functions
+#ifndef MICROPY_PY_UCRYPTOLIB_PORT_IMPL
+#define MICROPY_PY_UCRYPTOLIB_PORT_IMPL (0)
+#endif
+
 #ifndef MICROPY_PY_UCRYPTOLIB_CONSTS
 #define MICROPY_PY_UCRYPTOLIB_CONSTS (0)
 #endif
@@ -1452,6 +2253,11 @@ typedef double mp_float_t;
 #define MICROPY_PY_UBINASCII_CRC32 (0)
 #endif
 
+// Whether to provide ubinascii.hexlify_into, writing into a caller buffer
+#ifndef MICROPY_PY_UBINASCII_HEXLIFY_INTO
+#define MICROPY_PY_UBINASCII_HEXLIFY_INTO (0)
+#endif
+
 #ifndef MICROPY_PY_URANDOM
 #define MICROPY_PY_URANDOM (0)
 #endif
@@ -1470,20 +2276,59 @@ typedef double mp_float_t;
 #define MICROPY_PY_MACHINE_PULSE (0)
 #endif
 
+// Whether to include atomic_load/store/add/cas, atomic operations on
+// 32-bit words in memory; requires a compiler with __atomic builtins
+#ifndef MICROPY_PY_MACHINE_ATOMIC
+#define MICROPY_PY_MACHINE_ATOMIC (0)
+#endif
+
+// Whether to provide machine.PinGroup, mapping several pins to one integer
+#ifndef MICROPY_PY_MACHINE_PINGROUP
+#define MICROPY_PY_MACHINE_PINGROUP (0)
+#endif
+
+// Whether the port provides single-register whole-port access for PinGroup
+#ifndef MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL
+#define MICROPY_PY_MACHINE_PINGROUP_PORT_IMPL (0)
+#endif
+
 #ifndef MICROPY_PY_MACHINE_I2C
 #define MICROPY_PY_MACHINE_I2C (0)
 #endif
 
+// Whether machine.I2C provides multi-message transaction methods
+#ifndef MICROPY_PY_MACHINE_I2C_TRANSACTION
+#define MICROPY_PY_MACHINE_I2C_TRANSACTION (0)
+#endif
+
+// Whether the port provides the onewire bus primitives (eg timer driven)
+#ifndef MICROPY_PY_ONEWIRE_PORT_IMPL
+#define MICROPY_PY_ONEWIRE_PORT_IMPL (0)
+#endif
+
 #ifndef MICROPY_PY_MACHINE_SPI
 #define MICROPY_PY_MACHINE_SPI (0)
 #endif
 
+// Whether machine.SPI provides a queued/asynchronous transfer API
+#ifndef MICROPY_PY_MACHINE_SPI_ASYNC
+#define MICROPY_PY_MACHINE_SPI_ASYNC (0)
+#endif
+
 #ifndef MICROPY_PY_USSL
 #define MICROPY_PY_USSL (0)
 // Whether to add finaliser code to ussl objects
 #define MICROPY_PY_USSL_FINALISER (0)
 #endif
 
+// Number of TLS sessions cached by ussl for session resumption on
+// reconnection to the same hostname (mbedtls backend only, 0 to disable).
+// Resuming skips most of the handshake round-trips and the certificate
+// exchange, which matters on slow or flaky links.
+#ifndef MICROPY_PY_USSL_SESSION_CACHE_LEN
+#define MICROPY_PY_USSL_SESSION_CACHE_LEN (0)
+#endif
+
 #ifndef MICROPY_PY_UWEBSOCKET
 #define MICROPY_PY_UWEBSOCKET (0)
 #endif
@@ -1492,10 +2337,48 @@ typedef double mp_float_t;
 #define MICROPY_PY_FRAMEBUF (0)
 #endif
 
+// Whether FrameBuffer tracks a dirty bounding rectangle across drawing ops
+#ifndef MICROPY_PY_FRAMEBUF_DIRTY
+#define MICROPY_PY_FRAMEBUF_DIRTY (0)
+#endif
+
 #ifndef MICROPY_PY_BTREE
 #define MICROPY_PY_BTREE (0)
 #endif
 
+// Whether to provide the "netutils" module, a thin wrapper around the
+// helpers in shared/netutils (Internet checksum, inet_pton/inet_ntop).
+// Ports enabling this must also compile shared/netutils/netutils.c.
+#ifndef MICROPY_PY_NETUTILS
+#define MICROPY_PY_NETUTILS (0)
+#endif
+
+// Whether to provide the "ulog" module: allocation-free logging into a
+// preallocated record ring with formatting deferred to ulog.drain()
+#ifndef MICROPY_PY_ULOG
+#define MICROPY_PY_ULOG (0)
+#endif
+
+// Number of records in the ulog ring; the oldest are dropped on overflow
+#ifndef MICROPY_PY_ULOG_RING_LEN
+#define MICROPY_PY_ULOG_RING_LEN (16)
+#endif
+
+// Maximum number of arguments captured per ulog record
+#ifndef MICROPY_PY_ULOG_MAX_ARGS
+#define MICROPY_PY_ULOG_MAX_ARGS (4)
+#endif
+
+// Size in bytes of the uos.dupterm output buffer; 0 means unbuffered.  When
+// buffered, mp_uos_dupterm_tx_strn only queues the data and the stream writes
+// run later from a callback scheduled with mp_sched_schedule, so print bursts
+// don't stall the VM waiting on a slow link.  Requires
+// MICROPY_ENABLE_SCHEDULER; if the buffer fills up or the schedule queue is
+// full the data is written out synchronously, never dropped.
+#ifndef MICROPY_PY_OS_DUPTERM_TX_BUF
+#define MICROPY_PY_OS_DUPTERM_TX_BUF (0)
+#endif
+
 /*****************************************************************************/
 /* Hooks for a port to add builtins                                          */
 
@@ -1509,7 +2392,10 @@ typedef double mp_float_t;
 #define MICROPY_PORT_BUILTIN_MODULES
 #endif
 
-// Additional constant definitions for the compiler - see compile.c:mp_constants_table.
+// Additional constant definitions for the compiler - see parse.c:mp_constants_table.
+// Entries are (name, module object) pairs; int and bool attributes of these
+// modules are folded to constants at compile time, and a constant-false bool
+// condition eliminates its "if" block entirely from the emitted bytecode.
 #ifndef MICROPY_PORT_CONSTANTS
 #define MICROPY_PORT_CONSTANTS
 #endif
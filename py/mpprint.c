@@ -50,6 +50,37 @@ STATIC void plat_print_strn(void *env, const char *str, size_t len) {
 
 const mp_print_t mp_plat_print = {NULL, plat_print_strn};
 
+#if MICROPY_OPT_PRINT_BATCHING
+STATIC void batch_print_strn(void *data, const char *str, size_t len) {
+    mp_batch_print_t *batch = data;
+    if (len >= sizeof(batch->buf)) {
+        // Fragment too big to stage, pass it straight through.
+        mp_batch_print_flush(batch);
+        batch->inner->print_strn(batch->inner->data, str, len);
+        return;
+    }
+    if (batch->len + len > sizeof(batch->buf)) {
+        mp_batch_print_flush(batch);
+    }
+    memcpy(batch->buf + batch->len, str, len);
+    batch->len += len;
+}
+
+void mp_batch_print_init(mp_batch_print_t *batch, const mp_print_t *inner) {
+    batch->base.data = batch;
+    batch->base.print_strn = batch_print_strn;
+    batch->inner = inner;
+    batch->len = 0;
+}
+
+void mp_batch_print_flush(mp_batch_print_t *batch) {
+    if (batch->len > 0) {
+        batch->inner->print_strn(batch->inner->data, batch->buf, batch->len);
+        batch->len = 0;
+    }
+}
+#endif
+
 int mp_print_str(const mp_print_t *print, const char *str) {
     size_t len = strlen(str);
     if (len) {
@@ -68,6 +68,21 @@ extern const mp_print_t mp_plat_print;
 extern const mp_print_t mp_sys_stdout_print;
 #endif
 
+#if MICROPY_OPT_PRINT_BATCHING
+// A printer that stages output in a buffer and forwards it to another
+// printer in bulk.  base must remain the first member so a pointer to it
+// can be passed wherever an mp_print_t is expected.
+typedef struct _mp_batch_print_t {
+    mp_print_t base;
+    const mp_print_t *inner;
+    size_t len;
+    char buf[MICROPY_OPT_PRINT_BATCH_BUF_SIZE];
+} mp_batch_print_t;
+
+void mp_batch_print_init(mp_batch_print_t *batch, const mp_print_t *inner);
+void mp_batch_print_flush(mp_batch_print_t *batch);
+#endif
+
 int mp_print_str(const mp_print_t *print, const char *str);
 int mp_print_strn(const mp_print_t *print, const char *str, size_t len, int flags, char fill, int width);
 #if MICROPY_PY_BUILTINS_FLOAT
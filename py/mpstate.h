@@ -62,6 +62,19 @@ typedef struct _mp_sched_item_t {
     mp_obj_t arg;
 } mp_sched_item_t;
 
+#if MICROPY_TRACE
+// One fixed-size binary trace record; the layout (little-endian on all
+// supported targets) is decoded by tools/mptrace.py
+typedef struct _mp_trace_rec_t {
+    uint8_t event;
+    uint8_t pad;
+    uint16_t arg16;
+    uint32_t ticks_us;
+    uint32_t arg0;
+    uint32_t arg1;
+} mp_trace_rec_t;
+#endif
+
 // This structure hold information about the memory allocation system.
 typedef struct _mp_state_mem_t {
     #if MICROPY_MEM_STATS
@@ -70,11 +83,24 @@ typedef struct _mp_state_mem_t {
     size_t peak_bytes_allocated;
     #endif
 
+    #if MICROPY_MEM_PROFILE
+    // sampling heap profiler state (see m_prof_record in py/malloc.c)
+    size_t prof_countdown;
+    size_t prof_n_samples;
+    m_prof_sample_t prof_ring[MICROPY_MEM_PROFILE_RING_LEN];
+    #endif
+
     byte *gc_alloc_table_start;
     size_t gc_alloc_table_byte_len;
     #if MICROPY_ENABLE_FINALISER
     byte *gc_finaliser_table_start;
     #endif
+    #if MICROPY_GC_GENERATIONAL
+    byte *gc_young_table_start;
+    #endif
+    #if MICROPY_GC_DEFERRED_FINALISER
+    byte *gc_pending_final_table_start;
+    #endif
     byte *gc_pool_start;
     byte *gc_pool_end;
 
@@ -86,17 +112,39 @@ typedef struct _mp_state_mem_t {
     // you can still allocate/free memory and also explicitly call gc_collect.
     uint16_t gc_auto_collect_enabled;
 
+    #if MICROPY_GC_GENERATIONAL
+    // If set then the next call to gc_collect_start begins a minor collection.
+    uint16_t gc_do_minor_collect;
+    #endif
+
+    #if MICROPY_GC_DEFERRED_FINALISER
+    // number of queued finalisers, and lowest block at which one may be found
+    size_t gc_pending_finaliser_count;
+    size_t gc_pending_finaliser_scan;
+    #endif
+
     #if MICROPY_GC_ALLOC_THRESHOLD
     size_t gc_alloc_amount;
     size_t gc_alloc_threshold;
+    #if MICROPY_GC_ALLOC_THRESHOLD_ADAPTIVE
+    // heap-growth percentage for re-arming the threshold; 0 disables
+    size_t gc_threshold_growth;
+    #endif
     #endif
 
-    size_t gc_last_free_atb_index;
+    // ATB index at or above which a run of n+1 free blocks may start, one
+    // entry per size class (see gc_alloc); entries are non-decreasing.
+    size_t gc_first_free_atb_index[MICROPY_ATB_INDICES];
 
     #if MICROPY_PY_GC_COLLECT_RETVAL
     size_t gc_collected;
     #endif
 
+    #if MICROPY_TRACE
+    // number of blocks reclaimed by the last sweep, for the GC_END record
+    size_t gc_trace_swept_blocks;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -115,9 +163,22 @@ typedef struct _mp_state_vm_t {
 
     qstr_pool_t *last_pool;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    // hash table over all qstr pools, or NULL to fall back to a linear scan
+    struct _qstr_index_t *qstr_index;
+    #endif
+
     // non-heap memory for creating an exception if we can't allocate RAM
     mp_obj_exception_t mp_emergency_exception_obj;
 
+    #if MICROPY_PREALLOC_EXC
+    // preallocated exception instances and their traceback storage, reused
+    // for no-argument raises of a few control-flow exception types (see
+    // mp_prealloc_exc_types in py/objexcept.c)
+    mp_obj_exception_t prealloc_exc[MICROPY_PREALLOC_EXC_NUM];
+    size_t prealloc_exc_tb[MICROPY_PREALLOC_EXC_NUM][MICROPY_PREALLOC_EXC_TB_LEN];
+    #endif
+
     // memory for exception arguments if we can't allocate RAM
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
     #if MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE > 0
@@ -137,8 +198,55 @@ typedef struct _mp_state_vm_t {
     // dictionary with loaded modules (may be exposed as sys.modules)
     mp_obj_dict_t mp_loaded_modules_dict;
 
+    #if MICROPY_MODULE_DEFER_BUILTIN_INIT
+    // list of builtin modules that have been imported but whose __init__ is
+    // still pending (MP_OBJ_NULL if none)
+    mp_obj_t mp_deferred_builtin_init;
+    #endif
+
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    // dict caching import path stat results (MP_OBJ_NULL if empty); cleared
+    // on mount/umount/chdir
+    mp_obj_t mp_import_stat_cache;
+    #endif
+
+    #if MICROPY_PY_BUILTINS_FLOAT && MICROPY_OPT_FLOAT_INTERN
+    // cache of recently boxed float objects, keyed by value bit pattern;
+    // also acts as the GC root that keeps the cached objects alive
+    mp_obj_t float_intern_cache[MICROPY_OPT_FLOAT_INTERN_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_MRO_CACHE
+    // cache of class attribute lookups; entries whose epoch doesn't match
+    // mro_cache_epoch are stale (the epoch is bumped on class mutation)
+    mp_mro_cache_entry_t mro_cache[MICROPY_OPT_MRO_CACHE_SIZE];
+    size_t mro_cache_epoch;
+    #endif
+
+    #if MICROPY_OPT_BOUND_METH_CACHE
+    // recently created bound method objects, for reuse on re-binding
+    mp_obj_t bound_meth_cache[MICROPY_OPT_BOUND_METH_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_OPT_CHAR_QSTR_CACHE
+    // qstr of each single ASCII character string, filled on first use
+    qstr char_qstr_cache[128];
+    #endif
+
     #if MICROPY_ENABLE_SCHEDULER
     mp_sched_item_t sched_queue[MICROPY_SCHEDULER_DEPTH];
+    #if MICROPY_SCHEDULER_PRIORITY
+    mp_sched_item_t sched_pri_queue[MICROPY_SCHEDULER_PRIORITY_DEPTH];
+    #endif
+    #endif
+
+    #if MICROPY_TRACE
+    // ring of pending trace records plus counters aggregated between drains
+    mp_trace_rec_t trace_ring[MICROPY_TRACE_RING_LEN];
+    size_t trace_head;
+    size_t trace_count;
+    uint32_t trace_drops;
+    uint32_t trace_alloc_class[MICROPY_TRACE_ALLOC_CLASSES];
     #endif
 
     // current exception being handled, for sys.exc_info()
@@ -185,9 +293,52 @@ typedef struct _mp_state_vm_t {
     mp_obj_t lwip_slip_stream;
     #endif
 
+    #if MICROPY_PY_ULOG
+    // the ulog module's preallocated record ring; see extmod/modulog.c
+    struct _mp_ulog_state_t *ulog_state;
+    #endif
+
     #if MICROPY_VFS
     struct _mp_vfs_mount_t *vfs_cur;
     struct _mp_vfs_mount_t *vfs_mount_table;
+    #if MICROPY_VFS_STAT_CACHE
+    // cache of recent uos.stat/statvfs results; see extmod/vfs.c
+    struct {
+        mp_obj_t path; // MP_OBJ_NULL if the slot is empty
+        mp_obj_t result;
+        struct _mp_vfs_mount_t *vfs;
+        uint32_t gen;
+        uint8_t kind;
+    } vfs_stat_cache[MICROPY_VFS_STAT_CACHE_SIZE];
+    uint8_t vfs_stat_cache_next;
+    #endif
+    #if MICROPY_VFS_BLOCKDEV_TRIM
+    // ring of trimmed block ranges awaiting delivery; see extmod/vfs_blockdev.c
+    struct {
+        mp_obj_t owner; // object containing the blockdev, keeps it alive
+        struct _mp_vfs_blockdev_t *bdev;
+        uint32_t block;
+        uint32_t count;
+    } vfs_blockdev_trim_queue[MICROPY_VFS_BLOCKDEV_TRIM_QUEUE_SIZE];
+    uint8_t vfs_blockdev_trim_head;
+    uint8_t vfs_blockdev_trim_len;
+    #endif
+    #endif
+
+    #if MICROPY_PY_UASYNCIO
+    // singleton awaitable reused by every _uasyncio.sleep_ms call
+    mp_obj_t uasyncio_sleep_singleton;
+    #endif
+
+    #if MICROPY_PY_URE_CACHE_SIZE > 0
+    // MRU cache of compiled regexes, (pattern string, compiled re) pairs
+    mp_obj_t ure_cache[2 * MICROPY_PY_URE_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_PY_MACHINE_SPI_ASYNC
+    // list of queued machine.SPI transactions, and the one in flight
+    mp_obj_t machine_spi_txn_queue;
+    mp_obj_t machine_spi_txn_active;
     #endif
 
     #if MICROPY_PY_BLUETOOTH
@@ -198,6 +349,18 @@ typedef struct _mp_state_vm_t {
     // END ROOT POINTER SECTION
     ////////////////////////////////////////////////////////////
 
+    #if MICROPY_DEBUG_VM_OPCODE_STATS
+    // how many times each opcode has been executed (see py/vm.c)
+    size_t vm_opcode_count[256];
+    #endif
+
+    #if MICROPY_CPU_PROFILE
+    // ring of sampled bytecode call stacks, leaf frame first, zero padded
+    // (see mp_cpu_prof_sample in py/profile.c)
+    size_t cpu_prof_n_samples;
+    qstr cpu_prof_ring[MICROPY_CPU_PROFILE_RING_LEN][MICROPY_CPU_PROFILE_MAX_DEPTH];
+    #endif
+
     // pointer and sizes to store interned string data
     // (qstr_last_chunk can be root pointer but is also stored in qstr pool)
     byte *qstr_last_chunk;
@@ -207,6 +370,9 @@ typedef struct _mp_state_vm_t {
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make qstr interning thread-safe.
     mp_thread_mutex_t qstr_mutex;
+    // This mutex makes claiming an entry in mp_loaded_modules_dict atomic,
+    // so concurrent importers agree on who executes a module's body.
+    mp_thread_mutex_t mp_module_mutex;
     #endif
 
     #if MICROPY_ENABLE_COMPILER
@@ -223,9 +389,26 @@ typedef struct _mp_state_vm_t {
 
     #if MICROPY_ENABLE_SCHEDULER
     volatile int16_t sched_state;
+    #if MICROPY_SCHEDULER_LOCKFREE
+    // Free-running enqueue/dequeue counters; the consumer owns sched_head,
+    // producers reserve slots by advancing sched_tail and then publish the
+    // written slot by setting its entry in sched_ready.
+    volatile mp_uint_t sched_head;
+    volatile mp_uint_t sched_tail;
+    volatile uint8_t sched_ready[MICROPY_SCHEDULER_DEPTH];
+    #else
     uint8_t sched_len;
     uint8_t sched_idx;
     #endif
+    #if MICROPY_SCHEDULER_PRIORITY
+    // High-priority lane, drained ahead of sched_queue; always filled under
+    // the atomic section, even when the bulk lane above is lock-free.
+    uint8_t sched_pri_len;
+    uint8_t sched_pri_idx;
+    #endif
+    // Number of callbacks rejected because the queue was full.
+    volatile mp_uint_t sched_drops;
+    #endif
 
     #if MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the VM/runtime thread-safe.
@@ -269,11 +452,37 @@ typedef struct _mp_state_thread_t {
     // If MP_OBJ_STOP_ITERATION is propagated then this holds its argument.
     mp_obj_t stop_iteration_arg;
 
+    #if MICROPY_OPT_CODE_STATE_POOL
+    // Cache of recently finished heap-allocated code-state blocks for fast
+    // reuse by function calls (see py/objfun.c).  The pointers live in the
+    // root section so the GC doesn't reclaim pooled blocks.
+    struct _mp_code_state_t *code_state_pool[MICROPY_OPT_CODE_STATE_POOL_SIZE];
+    size_t code_state_pool_alloc[MICROPY_OPT_CODE_STATE_POOL_SIZE];
+    #endif
+
+    #if MICROPY_GC_THREAD_BLOCK_CACHE
+    // Cache of free 1- and 2-block chunks, refilled in bulk under the GC
+    // lock and then popped without locking (see py/gc.c).  The chunks are
+    // already marked allocated, and the pointers live in the root section
+    // so a collection run by another thread doesn't reclaim them while
+    // they sit in the cache.
+    void *gc_block_cache[2][MICROPY_GC_THREAD_BLOCK_CACHE_SIZE];
+    size_t gc_block_cache_len[2];
+    #endif
+
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
     struct _mp_code_state_t *current_code_state;
     #endif
+
+    #if MICROPY_CPU_PROFILE
+    // countdown to the next stack sample (see mp_cpu_prof_sample)
+    size_t cpu_prof_countdown;
+    #endif
 } mp_state_thread_t;
 
 // This structure combines the above 3 structures.
@@ -53,9 +53,27 @@ void mp_thread_mutex_unlock(mp_thread_mutex_t *mutex);
 #include "py/mpstate.h"
 #define MP_THREAD_GIL_ENTER() mp_thread_mutex_lock(&MP_STATE_VM(gil_mutex), 1)
 #define MP_THREAD_GIL_EXIT() mp_thread_mutex_unlock(&MP_STATE_VM(gil_mutex))
+// Execute the given statement with the GIL released, so other threads keep
+// running while it does.  The statement must be pure computation: it cannot
+// raise, allocate on the uPy heap or touch any uPy object state.  cond lets
+// callers keep the GIL for jobs too small to be worth the two transitions.
+#define MP_THREAD_GIL_RELEASED(cond, stmt) \
+    do { \
+        if (cond) { \
+            MP_THREAD_GIL_EXIT(); \
+            stmt; \
+            MP_THREAD_GIL_ENTER(); \
+        } else { \
+            stmt; \
+        } \
+    } while (0)
 #else
 #define MP_THREAD_GIL_ENTER()
 #define MP_THREAD_GIL_EXIT()
+#define MP_THREAD_GIL_RELEASED(cond, stmt) \
+    do { \
+        stmt; \
+    } while (0)
 #endif
 
 #endif // MICROPY_INCLUDED_PY_MPTHREAD_H
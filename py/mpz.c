@@ -427,12 +427,47 @@ STATIC size_t mpn_mul_dig_add_dig(mpz_dig_t *idig, size_t ilen, mpz_dig_t dmul,
     return idig - oidig;
 }
 
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+// Multiplications where both operands have at least this many digits are
+// done with mpn_mul_karatsuba instead of the schoolbook loop in mpn_mul.
+#define KARATSUBA_THRESHOLD (40)
+
+STATIC size_t mpn_mul_karatsuba(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen);
+
+/* computes i += j in place, propagating the carry upwards
+   assumes enough memory in i, with the digits above j zeroed or valid
+*/
+STATIC void mpn_add_inpl(mpz_dig_t *idig, const mpz_dig_t *jdig, size_t jlen) {
+    mpz_dbl_dig_t carry = 0;
+
+    for (; jlen > 0; --jlen, ++idig, ++jdig) {
+        carry += (mpz_dbl_dig_t)*idig + (mpz_dbl_dig_t)*jdig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+
+    for (; carry != 0; ++idig) {
+        carry += *idig;
+        *idig = carry & DIG_MASK;
+        carry >>= DIG_SIZE;
+    }
+}
+
+#endif
+
 /* computes i = j * k
    returns number of digits in i
    assumes enough memory in i; assumes i is zeroed; assumes normalised j, k
    can have j, k point to same memory
 */
 STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen) {
+    #if MICROPY_OPT_MPZ_KARATSUBA
+    if (jlen >= KARATSUBA_THRESHOLD && klen >= KARATSUBA_THRESHOLD) {
+        return mpn_mul_karatsuba(idig, jdig, jlen, kdig, klen);
+    }
+    #endif
+
     mpz_dig_t *oidig = idig;
     size_t ilen = 0;
 
@@ -457,6 +492,85 @@ STATIC size_t mpn_mul(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *
     return ilen;
 }
 
+#if MICROPY_OPT_MPZ_KARATSUBA
+
+/* computes i = j * k using Karatsuba's algorithm
+   returns number of digits in i
+   assumes enough memory in i (jlen + klen digits); assumes i is zeroed;
+   assumes normalised j, k
+   can have j, k point to same memory
+*/
+STATIC size_t mpn_mul_karatsuba(mpz_dig_t *idig, mpz_dig_t *jdig, size_t jlen, mpz_dig_t *kdig, size_t klen) {
+    // make j the longer operand
+    if (jlen < klen) {
+        mpz_dig_t *tdig = jdig;
+        jdig = kdig;
+        kdig = tdig;
+        size_t tlen = jlen;
+        jlen = klen;
+        klen = tlen;
+    }
+
+    // split point, at half of the longer operand
+    size_t m = (jlen + 1) >> 1;
+
+    // the low part of j may have leading zero digits; strip them so the
+    // recursive calls see a normalised operand
+    size_t j0len = m;
+    while (j0len > 0 && jdig[j0len - 1] == 0) {
+        --j0len;
+    }
+
+    if (klen <= m) {
+        // k lies entirely below the split point: i = j0 * k + (j1 * k << m)
+        mpn_mul(idig, jdig, j0len, kdig, klen);
+        size_t hi_alloc = jlen - m + klen;
+        mpz_dig_t *hi = m_new(mpz_dig_t, hi_alloc);
+        memset(hi, 0, hi_alloc * sizeof(mpz_dig_t));
+        size_t hi_len = mpn_mul(hi, jdig + m, jlen - m, kdig, klen);
+        mpn_add_inpl(idig + m, hi, hi_len);
+        m_del(mpz_dig_t, hi, hi_alloc);
+    } else {
+        size_t k0len = m;
+        while (k0len > 0 && kdig[k0len - 1] == 0) {
+            --k0len;
+        }
+
+        // the low and high products z0 = j0 * k0 and z2 = j1 * k1 don't
+        // overlap, so compute them directly into i
+        size_t z0len = mpn_mul(idig, jdig, j0len, kdig, k0len);
+        size_t z2len = mpn_mul(idig + 2 * m, jdig + m, jlen - m, kdig + m, klen - m);
+
+        // compute the middle term z1 = (j0 + j1) * (k0 + k1) - z0 - z2 in
+        // scratch memory; it's non-negative so mpn_sub below won't borrow
+        size_t tmp_alloc = 2 * (m + 1) + 2 * m + 2;
+        mpz_dig_t *tmp = m_new(mpz_dig_t, tmp_alloc);
+        mpz_dig_t *jsum = tmp;
+        mpz_dig_t *ksum = tmp + m + 1;
+        mpz_dig_t *z1 = tmp + 2 * (m + 1);
+        size_t j1len = jlen - m;
+        size_t k1len = klen - m;
+        size_t jsumlen = j0len >= j1len
+            ? mpn_add(jsum, jdig, j0len, jdig + m, j1len)
+            : mpn_add(jsum, jdig + m, j1len, jdig, j0len);
+        size_t ksumlen = k0len >= k1len
+            ? mpn_add(ksum, kdig, k0len, kdig + m, k1len)
+            : mpn_add(ksum, kdig + m, k1len, kdig, k0len);
+        memset(z1, 0, (2 * m + 2) * sizeof(mpz_dig_t));
+        size_t z1len = mpn_mul(z1, jsum, jsumlen, ksum, ksumlen);
+        z1len = mpn_sub(z1, z1, z1len, idig, z0len);
+        z1len = mpn_sub(z1, z1, z1len, idig + 2 * m, z2len);
+
+        // accumulate the middle term into i
+        mpn_add_inpl(idig + m, z1, z1len);
+        m_del(mpz_dig_t, tmp, tmp_alloc);
+    }
+
+    return mpn_remove_trailing_zeros(idig, idig + jlen + klen);
+}
+
+#endif
+
 /* natural_div - quo * den + new_num = old_num (ie num is replaced with rem)
    assumes den != 0
    assumes num_dig has enough memory to be extended by 1 digit
@@ -1565,6 +1679,26 @@ bool mpz_as_int_checked(const mpz_t *i, mp_int_t *value) {
     return true;
 }
 
+bool mpz_as_ll_checked(const mpz_t *i, long long *value) {
+    unsigned long long val = 0;
+    mpz_dig_t *d = i->dig + i->len;
+
+    while (d-- > i->dig) {
+        if (val > (~(1ULL << 63) >> DIG_SIZE)) {
+            // will overflow
+            return false;
+        }
+        val = (val << DIG_SIZE) | *d;
+    }
+
+    if (i->neg != 0) {
+        val = -val;
+    }
+
+    *value = val;
+    return true;
+}
+
 bool mpz_as_uint_checked(const mpz_t *i, mp_uint_t *value) {
     if (i->neg != 0) {
         // can't represent signed values
@@ -60,6 +60,10 @@ int mp_native_type_from_qstr(qstr qst) {
             return MP_NATIVE_TYPE_PTR16;
         case MP_QSTR_ptr32:
             return MP_NATIVE_TYPE_PTR32;
+        #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+        case MP_QSTR_fp:
+            return MP_NATIVE_TYPE_FLOAT;
+        #endif
         default:
             return -1;
     }
@@ -76,6 +80,18 @@ mp_uint_t mp_native_from_obj(mp_obj_t obj, mp_uint_t type) {
         case MP_NATIVE_TYPE_INT:
         case MP_NATIVE_TYPE_UINT:
             return mp_obj_get_int_truncated(obj);
+        #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: {
+            // the float is held as its raw bits in a machine word
+            union {
+                mp_float_t f;
+                mp_uint_t u;
+            } x;
+            x.u = 0;
+            x.f = mp_obj_get_float(obj);
+            return x.u;
+        }
+        #endif
         default: { // cast obj to a pointer
             mp_buffer_info_t bufinfo;
             if (mp_get_buffer(obj, &bufinfo, MP_BUFFER_READ)) {
@@ -104,6 +120,16 @@ mp_obj_t mp_native_to_obj(mp_uint_t val, mp_uint_t type) {
             return mp_obj_new_int(val);
         case MP_NATIVE_TYPE_UINT:
             return mp_obj_new_int_from_uint(val);
+        #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: {
+            union {
+                mp_float_t f;
+                mp_uint_t u;
+            } x;
+            x.u = val;
+            return mp_obj_new_float(x.f);
+        }
+        #endif
         default: // a pointer
             // we return just the value of the pointer as an integer
             return mp_obj_new_int_from_uint(val);
@@ -227,6 +253,50 @@ STATIC bool mp_native_yield_from(mp_obj_t gen, mp_obj_t send_value, mp_obj_t *re
     return false;
 }
 
+#if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+
+// Binary arithmetic and comparison on viper "fp" values, which hold the raw
+// bits of an mp_float_t in a machine word.  Arithmetic returns raw bits,
+// comparisons return 0/1.
+STATIC mp_uint_t mp_native_float_binary_op(mp_uint_t op, mp_uint_t lhs, mp_uint_t rhs) {
+    union {
+        mp_float_t f;
+        mp_uint_t u;
+    } l, r, res;
+    l.u = lhs;
+    r.u = rhs;
+    res.u = 0;
+    switch (op) {
+        case MP_BINARY_OP_ADD:
+            res.f = l.f + r.f;
+            return res.u;
+        case MP_BINARY_OP_SUBTRACT:
+            res.f = l.f - r.f;
+            return res.u;
+        case MP_BINARY_OP_MULTIPLY:
+            res.f = l.f * r.f;
+            return res.u;
+        case MP_BINARY_OP_TRUE_DIVIDE:
+            res.f = l.f / r.f;
+            return res.u;
+        case MP_BINARY_OP_LESS:
+            return l.f < r.f;
+        case MP_BINARY_OP_MORE:
+            return l.f > r.f;
+        case MP_BINARY_OP_EQUAL:
+            return l.f == r.f;
+        case MP_BINARY_OP_LESS_EQUAL:
+            return l.f <= r.f;
+        case MP_BINARY_OP_MORE_EQUAL:
+            return l.f >= r.f;
+        default:
+            assert(op == MP_BINARY_OP_NOT_EQUAL);
+            return l.f != r.f;
+    }
+}
+
+#endif
+
 #if !MICROPY_PY_BUILTINS_FLOAT
 
 STATIC mp_obj_t mp_obj_new_float_from_f(float f) {
@@ -342,6 +412,9 @@ const mp_fun_table_t mp_fun_table = {
     &mp_stream_readinto_obj,
     &mp_stream_unbuffered_readline_obj,
     &mp_stream_write_obj,
+    #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+    mp_native_float_binary_op,
+    #endif
 };
 
 #endif // MICROPY_EMIT_NATIVE
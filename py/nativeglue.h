@@ -170,8 +170,18 @@ typedef struct _mp_fun_table_t {
     const mp_obj_fun_builtin_var_t *stream_readinto_obj;
     const mp_obj_fun_builtin_var_t *stream_unbuffered_readline_obj;
     const mp_obj_fun_builtin_var_t *stream_write_obj;
+    #if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+    mp_uint_t (*float_binary_op)(mp_uint_t op, mp_uint_t lhs, mp_uint_t rhs);
+    #endif
 } mp_fun_table_t;
 
+#if MICROPY_EMIT_NATIVE_VIPER_FLOAT
+// The index of float_binary_op is computed rather than listed in
+// mp_fun_kind_t because it lives past the entries for the dynamic runtime,
+// whose indices are fixed.
+#define MP_F_NATIVE_FLOAT_BINARY_OP (offsetof(mp_fun_table_t, float_binary_op) / sizeof(void *))
+#endif
+
 extern const mp_fun_table_t mp_fun_table;
 
 #endif // MICROPY_INCLUDED_PY_NATIVEGLUE_H
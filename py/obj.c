@@ -117,7 +117,14 @@ void mp_obj_print_helper(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t
 }
 
 void mp_obj_print(mp_obj_t o_in, mp_print_kind_t kind) {
+    #if MICROPY_OPT_PRINT_BATCHING
+    mp_batch_print_t batch;
+    mp_batch_print_init(&batch, MP_PYTHON_PRINTER);
+    mp_obj_print_helper(&batch.base, o_in, kind);
+    mp_batch_print_flush(&batch);
+    #else
     mp_obj_print_helper(MP_PYTHON_PRINTER, o_in, kind);
+    #endif
 }
 
 // helper function to print an exception with traceback
@@ -33,6 +33,9 @@
 #include "py/qstr.h"
 #include "py/mpprint.h"
 #include "py/runtime0.h"
+#if MICROPY_PY_THREAD_SAFE_CONTAINERS
+#include "py/mpthread.h"
+#endif
 
 // This is the definition of the opaque MicroPython object type.
 // All concrete objects have an encoding within this type and the
@@ -357,6 +360,7 @@ typedef struct _mp_rom_obj_t { mp_const_obj_t o; } mp_rom_obj_t;
 #define MP_DEFINE_CONST_MAP(map_name, table_name) \
     const mp_map_t map_name = { \
         .all_keys_are_qstrs = 1, \
+        .all_keys_are_small_ints = 0, \
         .is_fixed = 1, \
         .is_ordered = 1, \
         .used = MP_ARRAY_SIZE(table_name), \
@@ -369,6 +373,7 @@ typedef struct _mp_rom_obj_t { mp_const_obj_t o; } mp_rom_obj_t;
         .base = {&mp_type_dict}, \
         .map = { \
             .all_keys_are_qstrs = 1, \
+            .all_keys_are_small_ints = 0, \
             .is_fixed = 1, \
             .is_ordered = 1, \
             .used = MP_ARRAY_SIZE(table_name), \
@@ -407,9 +412,10 @@ typedef struct _mp_rom_map_elem_t {
 
 typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
+    size_t all_keys_are_small_ints : 1;
     size_t is_fixed : 1;    // if set, table is fixed/read-only and can't be modified
     size_t is_ordered : 1;  // if set, table is an ordered array, not a hash map
-    size_t used : (8 * sizeof(size_t) - 3);
+    size_t used : (8 * sizeof(size_t) - 4);
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -433,13 +439,19 @@ mp_map_t *mp_map_new(size_t n);
 void mp_map_deinit(mp_map_t *map);
 void mp_map_free(mp_map_t *map);
 mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind);
+#if MICROPY_MAP_SHRINK_ON_DELETE
+void mp_map_shrink_maybe(mp_map_t *map);
+#else
+#define mp_map_shrink_maybe(map) (void)(map)
+#endif
 void mp_map_clear(mp_map_t *map);
 void mp_map_dump(mp_map_t *map);
 
 // Underlying set implementation (not set object)
 
 typedef struct _mp_set_t {
-    size_t alloc;
+    size_t all_keys_are_small_ints : 1;
+    size_t alloc : (8 * sizeof(size_t) - 1);
     size_t used;
     mp_obj_t *table;
 } mp_set_t;
@@ -590,8 +602,27 @@ struct _mp_obj_type_t {
 
     // A dict mapping qstrs to objects local methods/constants/etc.
     struct _mp_obj_dict_t *locals_dict;
+
+    #if MICROPY_PY_SLOTS
+    // Number of attribute names declared via __slots__, including those
+    // inherited from a single base class, resolved once at class creation.
+    // Used to pre-size the members map of new instances; zero when the
+    // class declares no __slots__.
+    uint16_t n_slots;
+    #endif
 };
 
+#if MICROPY_OPT_MRO_CACHE
+// An entry in the class attribute lookup cache; see mp_obj_class_lookup.
+typedef struct _mp_mro_cache_entry_t {
+    const mp_obj_type_t *type; // type the lookup started from; NULL if entry unused
+    qstr attr;
+    const mp_obj_type_t *def_type; // type whose locals_dict holds attr; NULL for a negative entry
+    mp_obj_t value; // raw value from the defining locals_dict
+    size_t epoch; // entry is stale unless this equals mro_cache_epoch
+} mp_mro_cache_entry_t;
+#endif
+
 // Constant types, globally accessible
 extern const mp_obj_type_t mp_type_type;
 extern const mp_obj_type_t mp_type_object;
@@ -753,6 +784,7 @@ mp_obj_t mp_obj_new_exception_msg_vlist(const mp_obj_type_t *exc_type, mp_rom_er
 mp_obj_t mp_obj_new_fun_bc(mp_obj_t def_args, mp_obj_t def_kw_args, const byte *code, const mp_uint_t *const_table);
 mp_obj_t mp_obj_new_fun_native(mp_obj_t def_args_in, mp_obj_t def_kw_args, const void *fun_data, const mp_uint_t *const_table);
 mp_obj_t mp_obj_new_fun_asm(size_t n_args, const void *fun_data, mp_uint_t type_sig);
+bool mp_obj_is_native_fun(mp_obj_t fun_in);
 mp_obj_t mp_obj_new_gen_wrap(mp_obj_t fun);
 mp_obj_t mp_obj_new_closure(mp_obj_t fun, size_t n_closed, const mp_obj_t *closed);
 mp_obj_t mp_obj_new_tuple(size_t n, const mp_obj_t *items);
@@ -907,6 +939,10 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs)
 // dict
 typedef struct _mp_obj_dict_t {
     mp_obj_base_t base;
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // taken around structural operations; not initialised for fixed dicts
+    mp_thread_mutex_t mutex;
+    #endif
     mp_map_t map;
 } mp_obj_dict_t;
 mp_obj_t mp_obj_dict_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
@@ -971,12 +1007,22 @@ mp_obj_t mp_identity_getiter(mp_obj_t self, mp_obj_iter_buf_t *iter_buf);
 typedef struct _mp_obj_module_t {
     mp_obj_base_t base;
     mp_obj_dict_t *globals;
+    #if MICROPY_MODULE_LAZY
+    // raw code (or, as a qstr object, the name of a .mpy file) whose
+    // execution in this module's context is deferred until the first
+    // attribute load on the module (NULL if nothing is pending)
+    const void *lazy_code;
+    #endif
 } mp_obj_module_t;
 static inline mp_obj_dict_t *mp_obj_module_get_globals(mp_obj_t module) {
     return ((mp_obj_module_t *)MP_OBJ_TO_PTR(module))->globals;
 }
 // check if given module object is a package
 bool mp_obj_is_package(mp_obj_t module);
+#if MICROPY_MODULE_LAZY
+// execute a module body whose execution was deferred at import time
+void mp_module_run_lazy(mp_obj_t module);
+#endif
 
 // staticmethod and classmethod types; defined here so we can make const versions
 // this structure is used for instances of both staticmethod and classmethod
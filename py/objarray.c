@@ -273,6 +273,135 @@ STATIC int typecode_for_comparison(int typecode, bool *is_unsigned) {
     return typecode;
 }
 
+#if MICROPY_PY_ARRAY_MATH
+// Elementwise subtract/multiply and dot product on the typed buffers,
+// without boxing each element.  Two-array ops require matching typecode
+// and length; multiply and subtract also accept a scalar rhs.
+STATIC mp_obj_t array_math_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    mp_obj_array_t *lhs = MP_OBJ_TO_PTR(lhs_in);
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW
+    if (lhs->base.type == &mp_type_memoryview) {
+        return MP_OBJ_NULL; // op not supported
+    }
+    #endif
+    char typecode = lhs->typecode;
+    size_t len = lhs->len;
+
+    // rhs must be an array with the same typecode and length, or a scalar
+    mp_obj_array_t *rhs = NULL;
+    if (mp_obj_is_type(rhs_in, &mp_type_array)) {
+        rhs = MP_OBJ_TO_PTR(rhs_in);
+        if (rhs->typecode != typecode || rhs->len != len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("lhs and rhs should be compatible"));
+        }
+    } else if (op == MP_BINARY_OP_MAT_MULTIPLY
+               || !(mp_obj_is_int(rhs_in) || mp_obj_is_float(rhs_in))) {
+        return MP_OBJ_NULL; // op not supported
+    }
+
+    if (op == MP_BINARY_OP_MAT_MULTIPLY) {
+        #define ARRAY_DOT_LOOP(type, acc_type, box) { \
+        const type *l = (const type *)lhs->items; \
+        const type *r = (const type *)rhs->items; \
+        acc_type acc = 0; \
+        for (size_t i = 0; i < len; i++) { \
+            acc += (acc_type)l[i] * (acc_type)r[i]; \
+        } \
+        return box(acc); \
+}
+        switch (typecode) {
+            case 'b':
+                ARRAY_DOT_LOOP(signed char, mp_int_t, MP_OBJ_NEW_SMALL_INT)
+            case 'B':
+                ARRAY_DOT_LOOP(unsigned char, mp_int_t, MP_OBJ_NEW_SMALL_INT)
+            case 'h':
+                ARRAY_DOT_LOOP(short, mp_int_t, mp_obj_new_int)
+            case 'H':
+                ARRAY_DOT_LOOP(unsigned short, mp_int_t, mp_obj_new_int)
+            case 'i':
+                ARRAY_DOT_LOOP(int, mp_int_t, mp_obj_new_int)
+            case 'I':
+                ARRAY_DOT_LOOP(unsigned int, mp_int_t, mp_obj_new_int)
+            case 'l':
+                ARRAY_DOT_LOOP(long, mp_int_t, mp_obj_new_int)
+            case 'L':
+                ARRAY_DOT_LOOP(unsigned long, mp_int_t, mp_obj_new_int)
+            #if MICROPY_PY_BUILTINS_FLOAT
+            case 'f':
+                ARRAY_DOT_LOOP(float, mp_float_t, mp_obj_new_float)
+            case 'd':
+                ARRAY_DOT_LOOP(double, mp_float_t, mp_obj_new_float)
+            #endif
+            default:
+                return MP_OBJ_NULL; // op not supported
+        }
+        #undef ARRAY_DOT_LOOP
+    }
+
+    bool mul = op == MP_BINARY_OP_MULTIPLY || op == MP_BINARY_OP_INPLACE_MULTIPLY;
+    bool inplace = op == MP_BINARY_OP_INPLACE_MULTIPLY || op == MP_BINARY_OP_INPLACE_SUBTRACT;
+    mp_obj_array_t *res = inplace ? lhs : array_new(typecode, len);
+
+    #define ARRAY_ELEM_LOOP(type, get_scalar) { \
+    const type *l = (const type *)lhs->items; \
+    type *d = (type *)res->items; \
+    if (rhs != NULL) { \
+        const type *r = (const type *)rhs->items; \
+        if (mul) { \
+            for (size_t i = 0; i < len; i++) { \
+                d[i] = l[i] * r[i]; \
+            } \
+        } else { \
+            for (size_t i = 0; i < len; i++) { \
+                d[i] = l[i] - r[i]; \
+            } \
+        } \
+    } else { \
+        type s = (type)get_scalar(rhs_in); \
+        if (mul) { \
+            for (size_t i = 0; i < len; i++) { \
+                d[i] = l[i] * s; \
+            } \
+        } else { \
+            for (size_t i = 0; i < len; i++) { \
+                d[i] = l[i] - s; \
+            } \
+        } \
+    } \
+    break; \
+}
+    switch (typecode) {
+        case 'b':
+            ARRAY_ELEM_LOOP(signed char, mp_obj_get_int)
+        case 'B':
+            ARRAY_ELEM_LOOP(unsigned char, mp_obj_get_int)
+        case 'h':
+            ARRAY_ELEM_LOOP(short, mp_obj_get_int)
+        case 'H':
+            ARRAY_ELEM_LOOP(unsigned short, mp_obj_get_int)
+        case 'i':
+            ARRAY_ELEM_LOOP(int, mp_obj_get_int)
+        case 'I':
+            ARRAY_ELEM_LOOP(unsigned int, mp_obj_get_int)
+        case 'l':
+            ARRAY_ELEM_LOOP(long, mp_obj_get_int)
+        case 'L':
+            ARRAY_ELEM_LOOP(unsigned long, mp_obj_get_int)
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            ARRAY_ELEM_LOOP(float, mp_obj_get_float)
+        case 'd':
+            ARRAY_ELEM_LOOP(double, mp_obj_get_float)
+        #endif
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+    #undef ARRAY_ELEM_LOOP
+
+    return inplace ? lhs_in : MP_OBJ_FROM_PTR(res);
+}
+#endif
+
 STATIC mp_obj_t array_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
     mp_obj_array_t *lhs = MP_OBJ_TO_PTR(lhs_in);
     switch (op) {
@@ -356,6 +485,15 @@ STATIC mp_obj_t array_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs
             mp_raise_NotImplementedError(NULL);
         }
 
+        #if MICROPY_PY_ARRAY_MATH
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+        case MP_BINARY_OP_MAT_MULTIPLY:
+            return array_math_op(op, lhs_in, rhs_in);
+        #endif
+
         default:
             return MP_OBJ_NULL; // op not supported
     }
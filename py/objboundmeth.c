@@ -108,9 +108,24 @@ STATIC const mp_obj_type_t mp_type_bound_meth = {
 };
 
 mp_obj_t mp_obj_new_bound_meth(mp_obj_t meth, mp_obj_t self) {
+    #if MICROPY_OPT_BOUND_METH_CACHE
+    // Re-binding the same method to the same object is common when a callback
+    // is registered over and over; return the cached binding if it matches.
+    mp_obj_t *slot = &MP_STATE_VM(bound_meth_cache)[
+        (((uintptr_t)meth >> 3) ^ ((uintptr_t)self >> 3)) & (MICROPY_OPT_BOUND_METH_CACHE_SIZE - 1)];
+    if (*slot != MP_OBJ_NULL) {
+        mp_obj_bound_meth_t *cached = MP_OBJ_TO_PTR(*slot);
+        if (cached->meth == meth && cached->self == self) {
+            return *slot;
+        }
+    }
+    #endif
     mp_obj_bound_meth_t *o = m_new_obj(mp_obj_bound_meth_t);
     o->base.type = &mp_type_bound_meth;
     o->meth = meth;
     o->self = self;
+    #if MICROPY_OPT_BOUND_METH_CACHE
+    *slot = MP_OBJ_FROM_PTR(o);
+    #endif
     return MP_OBJ_FROM_PTR(o);
 }
@@ -40,8 +40,30 @@ typedef struct _mp_obj_deque_t {
     mp_obj_t *items;
     uint32_t flags;
     #define FLAG_CHECK_OVERFLOW 1
+    #define FLAG_UNBOUNDED 2
 } mp_obj_deque_t;
 
+#if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+// Double the buffer of an unbounded deque, linearising the contents at the
+// start so the indices of the caller can't wrap immediately afterwards.
+STATIC void deque_grow(mp_obj_deque_t *self) {
+    size_t new_alloc = self->alloc * 2;
+    mp_obj_t *new_items = m_new0(mp_obj_t, new_alloc);
+    size_t n = 0;
+    for (size_t i = self->i_get; i != self->i_put;) {
+        new_items[n++] = self->items[i];
+        if (++i == self->alloc) {
+            i = 0;
+        }
+    }
+    m_del(mp_obj_t, self->items, self->alloc);
+    self->items = new_items;
+    self->alloc = new_alloc;
+    self->i_get = 0;
+    self->i_put = n;
+}
+#endif
+
 STATIC mp_obj_t deque_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 2, 3, false);
 
@@ -61,12 +83,21 @@ STATIC mp_obj_t deque_make_new(const mp_obj_type_t *type, size_t n_args, size_t
     o->base.type = type;
     o->alloc = maxlen + 1;
     o->i_get = o->i_put = 0;
-    o->items = m_new0(mp_obj_t, o->alloc);
 
     if (n_args > 2) {
         o->flags = mp_obj_get_int(args[2]);
     }
 
+    #if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+    if (maxlen == 0) {
+        // a maxlen of 0 means no bound: start small and grow on demand
+        o->flags |= FLAG_UNBOUNDED;
+        o->alloc = 4;
+    }
+    #endif
+
+    o->items = m_new0(mp_obj_t, o->alloc);
+
     return MP_OBJ_FROM_PTR(o);
 }
 
@@ -101,6 +132,14 @@ STATIC mp_obj_t mp_obj_deque_append(mp_obj_t self_in, mp_obj_t arg) {
         new_i_put = 0;
     }
 
+    #if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+    if ((self->flags & FLAG_UNBOUNDED) && new_i_put == self->i_get) {
+        deque_grow(self);
+        // contents are linear after growing, so no wrap is possible here
+        new_i_put = self->i_put + 1;
+    }
+    #endif
+
     if (self->flags & FLAG_CHECK_OVERFLOW && new_i_put == self->i_get) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("full"));
     }
@@ -118,6 +157,50 @@ STATIC mp_obj_t mp_obj_deque_append(mp_obj_t self_in, mp_obj_t arg) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(deque_append_obj, mp_obj_deque_append);
 
+#if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+STATIC mp_obj_t deque_appendleft(mp_obj_t self_in, mp_obj_t arg) {
+    mp_obj_deque_t *self = MP_OBJ_TO_PTR(self_in);
+
+    size_t new_i_get = (self->i_get == 0 ? self->alloc : self->i_get) - 1;
+
+    if ((self->flags & FLAG_UNBOUNDED) && new_i_get == self->i_put) {
+        deque_grow(self);
+        new_i_get = self->alloc - 1;
+    }
+
+    if (self->flags & FLAG_CHECK_OVERFLOW && new_i_get == self->i_put) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("full"));
+    }
+
+    self->items[new_i_get] = arg;
+    self->i_get = new_i_get;
+
+    if (self->i_put == new_i_get) {
+        // deque is bounded and was full: discard the rightmost item
+        self->i_put = (self->i_put == 0 ? self->alloc : self->i_put) - 1;
+        self->items[self->i_put] = MP_OBJ_NULL;
+    }
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(deque_appendleft_obj, deque_appendleft);
+
+STATIC mp_obj_t deque_pop(mp_obj_t self_in) {
+    mp_obj_deque_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if (self->i_get == self->i_put) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty"));
+    }
+
+    self->i_put = (self->i_put == 0 ? self->alloc : self->i_put) - 1;
+    mp_obj_t ret = self->items[self->i_put];
+    self->items[self->i_put] = MP_OBJ_NULL;
+
+    return ret;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(deque_pop_obj, deque_pop);
+#endif
+
 STATIC mp_obj_t deque_popleft(mp_obj_t self_in) {
     mp_obj_deque_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -148,9 +231,15 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(deque_clear_obj, deque_clear);
 
 STATIC const mp_rom_map_elem_t deque_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&deque_append_obj) },
+    #if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+    { MP_ROM_QSTR(MP_QSTR_appendleft), MP_ROM_PTR(&deque_appendleft_obj) },
+    #endif
     #if 0
     { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&deque_clear_obj) },
     #endif
+    #if MICROPY_PY_COLLECTIONS_DEQUE_EXTENDED
+    { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&deque_pop_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_popleft), MP_ROM_PTR(&deque_popleft_obj) },
 };
 
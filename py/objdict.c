@@ -37,6 +37,7 @@ const mp_obj_dict_t mp_const_empty_dict_obj = {
     .base = { .type = &mp_type_dict },
     .map = {
         .all_keys_are_qstrs = 0,
+        .all_keys_are_small_ints = 0,
         .is_fixed = 1,
         .is_ordered = 1,
         .used = 0,
@@ -47,6 +48,50 @@ const mp_obj_dict_t mp_const_empty_dict_obj = {
 
 STATIC mp_obj_t dict_update(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs);
 
+#if MICROPY_PY_THREAD_SAFE_CONTAINERS
+// Per-dict lock around structural operations; fixed (ROM) dicts are
+// immutable and are never locked (their mutex is not initialised).  See
+// MICROPY_PY_THREAD_SAFE_CONTAINERS in py/mpconfig.h for what is covered.
+#define DICT_ENTER(self) do { if (!(self)->map.is_fixed) { mp_thread_mutex_lock(&(self)->mutex, 1); } } while (0)
+#define DICT_EXIT(self) do { if (!(self)->map.is_fixed) { mp_thread_mutex_unlock(&(self)->mutex); } } while (0)
+
+// Like mp_map_lookup on the dict's map, for use with the dict lock held:
+// if the lookup raises (a failed rehash while growing the table, or a key
+// __eq__/__hash__ that throws) the lock is released before the exception
+// propagates.
+STATIC mp_map_elem_t *dict_map_lookup(mp_obj_dict_t *self, mp_obj_t key, mp_map_lookup_kind_t lookup_kind) {
+    if (self->map.is_fixed) {
+        return mp_map_lookup(&self->map, key, lookup_kind);
+    }
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_map_elem_t *elem = mp_map_lookup(&self->map, key, lookup_kind);
+        nlr_pop();
+        return elem;
+    } else {
+        mp_thread_mutex_unlock(&self->mutex);
+        nlr_jump(nlr.ret_val);
+    }
+}
+
+// As above but for mp_map_shrink_maybe, which reallocates the table.
+STATIC void dict_map_shrink(mp_obj_dict_t *self) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_map_shrink_maybe(&self->map);
+        nlr_pop();
+    } else {
+        mp_thread_mutex_unlock(&self->mutex);
+        nlr_jump(nlr.ret_val);
+    }
+}
+#else
+#define DICT_ENTER(self)
+#define DICT_EXIT(self)
+#define dict_map_lookup(self, key, lookup_kind) mp_map_lookup(&(self)->map, key, lookup_kind)
+#define dict_map_shrink(self) mp_map_shrink_maybe(&(self)->map)
+#endif
+
 // This is a helper function to iterate through a dictionary.  The state of
 // the iteration is held in *cur and should be initialised with zero for the
 // first call.  Will return NULL when no more elements are available.
@@ -147,7 +192,9 @@ STATIC mp_obj_t dict_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_
     mp_obj_dict_t *o = MP_OBJ_TO_PTR(lhs_in);
     switch (op) {
         case MP_BINARY_OP_CONTAINS: {
-            mp_map_elem_t *elem = mp_map_lookup(&o->map, rhs_in, MP_MAP_LOOKUP);
+            DICT_ENTER(o);
+            mp_map_elem_t *elem = dict_map_lookup(o, rhs_in, MP_MAP_LOOKUP);
+            DICT_EXIT(o);
             return mp_obj_new_bool(elem != NULL);
         }
         case MP_BINARY_OP_EQUAL: {
@@ -195,11 +242,15 @@ STATIC mp_obj_t dict_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_
 // Note: Make sure this is inlined in load part of dict_subscr() below.
 mp_obj_t mp_obj_dict_get(mp_obj_t self_in, mp_obj_t index) {
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_map_elem_t *elem = mp_map_lookup(&self->map, index, MP_MAP_LOOKUP);
-    if (elem == NULL) {
+    DICT_ENTER(self);
+    mp_map_elem_t *elem = dict_map_lookup(self, index, MP_MAP_LOOKUP);
+    // fetch the value before unlocking, a concurrent rehash may move the table
+    mp_obj_t value = elem != NULL ? elem->value : MP_OBJ_NULL;
+    DICT_EXIT(self);
+    if (value == MP_OBJ_NULL) {
         mp_raise_type_arg(&mp_type_KeyError, index);
     } else {
-        return elem->value;
+        return value;
     }
 }
 
@@ -211,11 +262,15 @@ STATIC mp_obj_t dict_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
     } else if (value == MP_OBJ_SENTINEL) {
         // load
         mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
-        mp_map_elem_t *elem = mp_map_lookup(&self->map, index, MP_MAP_LOOKUP);
-        if (elem == NULL) {
+        DICT_ENTER(self);
+        mp_map_elem_t *elem = dict_map_lookup(self, index, MP_MAP_LOOKUP);
+        // fetch the value before unlocking, a concurrent rehash may move the table
+        mp_obj_t value2 = elem != NULL ? elem->value : MP_OBJ_NULL;
+        DICT_EXIT(self);
+        if (value2 == MP_OBJ_NULL) {
             mp_raise_type_arg(&mp_type_KeyError, index);
         } else {
-            return elem->value;
+            return value2;
         }
     } else {
         // store
@@ -238,7 +293,9 @@ STATIC mp_obj_t dict_clear(mp_obj_t self_in) {
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
     mp_ensure_not_fixed(self);
 
+    DICT_ENTER(self);
     mp_map_clear(&self->map);
+    DICT_EXIT(self);
 
     return mp_const_none;
 }
@@ -247,14 +304,33 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(dict_clear_obj, dict_clear);
 mp_obj_t mp_obj_dict_copy(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_dict_or_ordereddict(self_in));
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // allocate the copy outside the lock, retrying if the source table
+    // was resized in the meantime
+    mp_obj_t other_out;
+    mp_obj_dict_t *other;
+    for (;;) {
+        size_t alloc = self->map.alloc;
+        other_out = mp_obj_new_dict(alloc);
+        other = MP_OBJ_TO_PTR(other_out);
+        DICT_ENTER(self);
+        if (self->map.alloc == alloc) {
+            break;
+        }
+        DICT_EXIT(self);
+    }
+    #else
     mp_obj_t other_out = mp_obj_new_dict(self->map.alloc);
     mp_obj_dict_t *other = MP_OBJ_TO_PTR(other_out);
+    #endif
     other->base.type = self->base.type;
     other->map.used = self->map.used;
     other->map.all_keys_are_qstrs = self->map.all_keys_are_qstrs;
+    other->map.all_keys_are_small_ints = self->map.all_keys_are_small_ints;
     other->map.is_fixed = 0;
     other->map.is_ordered = self->map.is_ordered;
     memcpy(other->map.table, self->map.table, self->map.alloc * sizeof(mp_map_elem_t));
+    DICT_EXIT(self);
     return other_out;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(dict_copy_obj, mp_obj_dict_copy);
@@ -297,11 +373,13 @@ STATIC mp_obj_t dict_get_helper(size_t n_args, const mp_obj_t *args, mp_map_look
     if (lookup_kind != MP_MAP_LOOKUP) {
         mp_ensure_not_fixed(self);
     }
-    mp_map_elem_t *elem = mp_map_lookup(&self->map, args[1], lookup_kind);
+    DICT_ENTER(self);
+    mp_map_elem_t *elem = dict_map_lookup(self, args[1], lookup_kind);
     mp_obj_t value;
     if (elem == NULL || elem->value == MP_OBJ_NULL) {
         if (n_args == 2) {
             if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
+                DICT_EXIT(self);
                 mp_raise_type_arg(&mp_type_KeyError, args[1]);
             } else {
                 value = mp_const_none;
@@ -316,8 +394,10 @@ STATIC mp_obj_t dict_get_helper(size_t n_args, const mp_obj_t *args, mp_map_look
         value = elem->value;
         if (lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND) {
             elem->value = MP_OBJ_NULL; // so that GC can collect the deleted value
+            dict_map_shrink(self);
         }
     }
+    DICT_EXIT(self);
     return value;
 }
 
@@ -343,6 +423,14 @@ STATIC mp_obj_t dict_popitem(mp_obj_t self_in) {
     if (self->map.used == 0) {
         mp_raise_msg(&mp_type_KeyError, MP_ERROR_TEXT("popitem(): dictionary is empty"));
     }
+    DICT_ENTER(self);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // the emptiness check ran outside the lock, so repeat it
+    if (self->map.used == 0) {
+        DICT_EXIT(self);
+        mp_raise_msg(&mp_type_KeyError, MP_ERROR_TEXT("popitem(): dictionary is empty"));
+    }
+    #endif
     size_t cur = 0;
     #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
     if (self->map.is_ordered) {
@@ -355,6 +443,8 @@ STATIC mp_obj_t dict_popitem(mp_obj_t self_in) {
     mp_obj_t items[] = {next->key, next->value};
     next->key = MP_OBJ_SENTINEL; // must mark key as sentinel to indicate that it was deleted
     next->value = MP_OBJ_NULL;
+    dict_map_shrink(self);
+    DICT_EXIT(self);
     mp_obj_t tuple = mp_obj_new_tuple(2, items);
 
     return tuple;
@@ -377,7 +467,9 @@ STATIC mp_obj_t dict_update(size_t n_args, const mp_obj_t *args, mp_map_t *kwarg
                 size_t cur = 0;
                 mp_map_elem_t *elem = NULL;
                 while ((elem = dict_iter_next((mp_obj_dict_t *)MP_OBJ_TO_PTR(args[1]), &cur)) != NULL) {
-                    mp_map_lookup(&self->map, elem->key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = elem->value;
+                    DICT_ENTER(self);
+                    dict_map_lookup(self, elem->key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = elem->value;
+                    DICT_EXIT(self);
                 }
             }
         } else {
@@ -394,7 +486,9 @@ STATIC mp_obj_t dict_update(size_t n_args, const mp_obj_t *args, mp_map_t *kwarg
                     || stop != MP_OBJ_STOP_ITERATION) {
                     mp_raise_ValueError(MP_ERROR_TEXT("dict update sequence has wrong length"));
                 } else {
-                    mp_map_lookup(&self->map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+                    DICT_ENTER(self);
+                    dict_map_lookup(self, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+                    DICT_EXIT(self);
                 }
             }
         }
@@ -403,7 +497,9 @@ STATIC mp_obj_t dict_update(size_t n_args, const mp_obj_t *args, mp_map_t *kwarg
     // update the dict with any keyword args
     for (size_t i = 0; i < kwargs->alloc; i++) {
         if (mp_map_slot_is_filled(kwargs, i)) {
-            mp_map_lookup(&self->map, kwargs->table[i].key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = kwargs->table[i].value;
+            DICT_ENTER(self);
+            dict_map_lookup(self, kwargs->table[i].key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = kwargs->table[i].value;
+            DICT_EXIT(self);
         }
     }
 
@@ -615,6 +711,9 @@ const mp_obj_type_t mp_type_ordereddict = {
 
 void mp_obj_dict_init(mp_obj_dict_t *dict, size_t n_args) {
     dict->base.type = &mp_type_dict;
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_thread_mutex_init(&dict->mutex);
+    #endif
     mp_map_init(&dict->map, n_args);
 }
 
@@ -633,7 +732,9 @@ mp_obj_t mp_obj_dict_store(mp_obj_t self_in, mp_obj_t key, mp_obj_t value) {
     mp_check_self(mp_obj_is_dict_or_ordereddict(self_in));
     mp_obj_dict_t *self = MP_OBJ_TO_PTR(self_in);
     mp_ensure_not_fixed(self);
-    mp_map_lookup(&self->map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+    DICT_ENTER(self);
+    dict_map_lookup(self, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = value;
+    DICT_EXIT(self);
     return self_in;
 }
 
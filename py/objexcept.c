@@ -198,9 +198,36 @@ void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kin
     mp_obj_tuple_print(print, MP_OBJ_FROM_PTR(o->args), kind);
 }
 
+#if MICROPY_PREALLOC_EXC
+// Exception types whose no-argument raises reuse a preallocated instance,
+// making them heap-free.  Each raise reinitialises the instance, so two
+// live no-argument exceptions of one of these types are the same object.
+STATIC const mp_obj_type_t *const mp_prealloc_exc_types[MICROPY_PREALLOC_EXC_NUM] = {
+    &mp_type_StopIteration,
+    &mp_type_IndexError,
+    &mp_type_KeyError,
+};
+#endif
+
 mp_obj_t mp_obj_exception_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     mp_arg_check_num(n_args, n_kw, 0, MP_OBJ_FUN_ARGS_MAX, false);
 
+    #if MICROPY_PREALLOC_EXC
+    if (n_args == 0 && n_kw == 0) {
+        for (size_t i = 0; i < MICROPY_PREALLOC_EXC_NUM; i++) {
+            if (type == mp_prealloc_exc_types[i]) {
+                mp_obj_exception_t *o = &MP_STATE_VM(prealloc_exc)[i];
+                o->base.type = type;
+                o->args = (mp_obj_tuple_t *)&mp_const_empty_tuple_obj;
+                o->traceback_data = MP_STATE_VM(prealloc_exc_tb)[i];
+                o->traceback_alloc = MICROPY_PREALLOC_EXC_TB_LEN;
+                o->traceback_len = 0;
+                return MP_OBJ_FROM_PTR(o);
+            }
+        }
+    }
+    #endif
+
     // Try to allocate memory for the exception, with fallback to emergency exception object
     mp_obj_exception_t *o_exc = m_new_obj_maybe(mp_obj_exception_t);
     if (o_exc == NULL) {
@@ -462,12 +489,203 @@ mp_obj_t mp_obj_new_exception_msg_varg(const mp_obj_type_t *exc_type, mp_rom_err
     return exc;
 }
 
+#if MICROPY_LAZY_EXC_MSG
+
+// A lazily-formatted exception message: the format string stays in ROM and
+// the arguments are captured as words, so raising costs no printf work; the
+// text is only produced if the message is actually printed or str()'d.  All
+// pointer arguments (%s) at the raise sites are qstr or ROM data, which is
+// what makes deferring them safe.
+typedef struct _mp_obj_lazy_msg_t {
+    mp_obj_base_t base;
+    mp_rom_error_text_t fmt;
+    mp_uint_t args[MICROPY_LAZY_EXC_MSG_MAX_ARGS];
+} mp_obj_lazy_msg_t;
+
+// Check whether fmt only uses directives whose arguments can be captured as
+// single words, and count them.  Width/precision/length modifiers and
+// float directives disqualify the format (the caller then formats eagerly).
+STATIC bool lazy_msg_scan(const char *fmt, size_t *n_args) {
+    size_t n = 0;
+    for (const char *f = fmt; *f != '\0'; ++f) {
+        if (*f != '%') {
+            continue;
+        }
+        ++f;
+        switch (*f) {
+            case '%':
+                break;
+            case 'q':
+            case 'd':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 's':
+            case 'c':
+            case 'p':
+                if (++n > MICROPY_LAZY_EXC_MSG_MAX_ARGS) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    *n_args = n;
+    return true;
+}
+
+STATIC void lazy_msg_format(const mp_print_t *print, mp_obj_lazy_msg_t *o) {
+    const char *fmt = (const char *)o->fmt;
+    #if MICROPY_ROM_TEXT_COMPRESSION
+    byte decompressed[MP_MAX_UNCOMPRESSED_TEXT_LEN];
+    if (MP_IS_COMPRESSED_ROM_STRING(o->fmt)) {
+        mp_decompress_rom_string(decompressed, o->fmt);
+        fmt = (const char *)decompressed;
+    }
+    #endif
+    size_t arg = 0;
+    for (const char *f = fmt; *f != '\0'; ++f) {
+        if (*f != '%') {
+            print->print_strn(print->data, f, 1);
+            continue;
+        }
+        ++f;
+        mp_uint_t word = 0;
+        if (*f != '%') {
+            word = o->args[arg++];
+        }
+        switch (*f) {
+            case '%':
+                mp_print_str(print, "%");
+                break;
+            case 'q':
+                mp_printf(print, "%q", (qstr)word);
+                break;
+            case 'd':
+                mp_printf(print, "%d", (int)word);
+                break;
+            case 'u':
+                mp_printf(print, "%u", (unsigned)word);
+                break;
+            case 'x':
+                mp_printf(print, "%x", (unsigned)word);
+                break;
+            case 'X':
+                mp_printf(print, "%X", (unsigned)word);
+                break;
+            case 's':
+                mp_print_str(print, (const char *)word);
+                break;
+            case 'c':
+                mp_printf(print, "%c", (int)word);
+                break;
+            case 'p':
+                mp_printf(print, "%p", (void *)word);
+                break;
+        }
+    }
+}
+
+STATIC void lazy_msg_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
+    mp_obj_lazy_msg_t *o = MP_OBJ_TO_PTR(o_in);
+    if (kind == PRINT_STR) {
+        lazy_msg_format(print, o);
+    } else {
+        // repr (and json) must quote and escape like a real str, so format
+        // into a buffer first
+        vstr_t vstr;
+        mp_print_t pr;
+        vstr_init_print(&vstr, 16, &pr);
+        lazy_msg_format(&pr, o);
+        if (kind == PRINT_JSON) {
+            mp_str_print_json(print, (const byte *)vstr.buf, vstr.len);
+        } else {
+            mp_str_print_quoted(print, (const byte *)vstr.buf, vstr.len, false);
+        }
+        vstr_clear(&vstr);
+    }
+}
+
+STATIC const mp_obj_type_t mp_type_lazy_msg = {
+    { &mp_type_type },
+    .name = MP_QSTR_str,
+    .print = lazy_msg_print,
+};
+
+// Try to create an exception whose message is captured for later formatting.
+// Returns MP_OBJ_NULL when the format or allocation doesn't allow it, in
+// which case the caller falls back to eager formatting.
+STATIC mp_obj_t mp_obj_new_exception_msg_lazy(const mp_obj_type_t *exc_type, mp_rom_error_text_t fmt, va_list args) {
+    const char *fmt2 = (const char *)fmt;
+    #if MICROPY_ROM_TEXT_COMPRESSION
+    byte decompressed[MP_MAX_UNCOMPRESSED_TEXT_LEN];
+    if (MP_IS_COMPRESSED_ROM_STRING(fmt)) {
+        mp_decompress_rom_string(decompressed, fmt);
+        fmt2 = (const char *)decompressed;
+    }
+    #endif
+
+    size_t n_args;
+    if (!lazy_msg_scan(fmt2, &n_args)) {
+        return MP_OBJ_NULL;
+    }
+
+    mp_obj_lazy_msg_t *o = m_new_obj_maybe(mp_obj_lazy_msg_t);
+    if (o == NULL) {
+        return MP_OBJ_NULL;
+    }
+    o->base.type = &mp_type_lazy_msg;
+    o->fmt = fmt;
+
+    // capture each directive's argument as one word, in order
+    size_t arg = 0;
+    for (const char *f = fmt2; *f != '\0'; ++f) {
+        if (*f != '%') {
+            continue;
+        }
+        ++f;
+        switch (*f) {
+            case 'q':
+                o->args[arg++] = (mp_uint_t)va_arg(args, qstr);
+                break;
+            case 'd':
+            case 'c':
+                o->args[arg++] = (mp_uint_t)(mp_int_t)va_arg(args, int);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+                o->args[arg++] = (mp_uint_t)va_arg(args, unsigned);
+                break;
+            case 's':
+            case 'p':
+                o->args[arg++] = (mp_uint_t)va_arg(args, void *);
+                break;
+        }
+    }
+    (void)n_args;
+
+    mp_obj_t marg = MP_OBJ_FROM_PTR(o);
+    return mp_obj_exception_make_new(exc_type, 1, 0, &marg);
+}
+
+#endif // MICROPY_LAZY_EXC_MSG
+
 mp_obj_t mp_obj_new_exception_msg_vlist(const mp_obj_type_t *exc_type, mp_rom_error_text_t fmt, va_list args) {
     assert(fmt != NULL);
 
     // Check that the given type is an exception type
     assert(exc_type->make_new == mp_obj_exception_make_new);
 
+    #if MICROPY_LAZY_EXC_MSG
+    // Defer the printf work to when (if ever) the message is displayed
+    mp_obj_t lazy_exc = mp_obj_new_exception_msg_lazy(exc_type, fmt, args);
+    if (lazy_exc != MP_OBJ_NULL) {
+        return lazy_exc;
+    }
+    #endif
+
     // Try to allocate memory for the message
     mp_obj_str_t *o_str = m_new_obj_maybe(mp_obj_str_t);
     size_t o_str_alloc = strlen((const char *)fmt) + 1;
@@ -605,6 +823,14 @@ void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qs
             return;
         }
         #endif
+        #if MICROPY_PREALLOC_EXC
+        if (self->traceback_data >= &MP_STATE_VM(prealloc_exc_tb)[0][0]
+            && self->traceback_data < &MP_STATE_VM(prealloc_exc_tb)[0][0] + MICROPY_PREALLOC_EXC_NUM * MICROPY_PREALLOC_EXC_TB_LEN) {
+            // Can't resize a preallocated instance's traceback buffer; keep
+            // the outermost frames that are already recorded
+            return;
+        }
+        #endif
         // be conservative with growing traceback data
         size_t *tb_data = m_renew_maybe(size_t, self->traceback_data, self->traceback_alloc,
             self->traceback_alloc + TRACEBACK_ENTRY_LEN, true);
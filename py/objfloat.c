@@ -187,9 +187,32 @@ const mp_obj_type_t mp_type_float = {
 #if MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_C && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_D
 
 mp_obj_t mp_obj_new_float(mp_float_t value) {
+    #if MICROPY_OPT_FLOAT_INTERN
+    // if this exact bit pattern was boxed recently then reuse that object
+    // (floats are immutable so sharing is safe; keying on the bit pattern
+    // keeps 0.0 and -0.0 distinct)
+    mp_float_union_t u = {.f = value};
+    // hash on the exponent and top mantissa bits; the low mantissa bits are
+    // all zero for common round values so they make a poor cache key
+    size_t h = (size_t)(u.i >> (MP_FLOAT_FRAC_BITS - 8));
+    size_t idx = (h ^ (h >> 4) ^ (h >> 8)) & (MICROPY_OPT_FLOAT_INTERN_CACHE_SIZE - 1);
+    mp_obj_t cached = MP_STATE_VM(float_intern_cache)[idx];
+    if (cached != MP_OBJ_NULL) {
+        mp_float_union_t c = {.f = ((mp_obj_float_t *)MP_OBJ_TO_PTR(cached))->value};
+        if (c.i == u.i) {
+            return cached;
+        }
+    }
+    #endif
+
     mp_obj_float_t *o = m_new(mp_obj_float_t, 1);
     o->base.type = &mp_type_float;
     o->value = value;
+
+    #if MICROPY_OPT_FLOAT_INTERN
+    MP_STATE_VM(float_intern_cache)[idx] = MP_OBJ_FROM_PTR(o);
+    #endif
+
     return MP_OBJ_FROM_PTR(o);
 }
 
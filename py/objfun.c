@@ -195,6 +195,41 @@ STATIC void dump_args(const mp_obj_t *a, size_t sz) {
 // than this will try to use the heap, with fallback to stack allocation.
 #define VM_MAX_STATE_ON_STACK (sizeof(mp_uint_t) * 11)
 
+#if MICROPY_OPT_CODE_STATE_POOL && !MICROPY_ENABLE_PYSTACK
+
+// Take a pooled code-state block with room for at least state_size bytes of
+// state, or return NULL if the pool has no suitable block.  On success
+// state_size is updated to the usable state size of the returned block.
+STATIC mp_code_state_t *code_state_pool_take(size_t *state_size) {
+    size_t alloc = sizeof(mp_code_state_t) + *state_size;
+    for (size_t i = 0; i < MICROPY_OPT_CODE_STATE_POOL_SIZE; i++) {
+        if (MP_STATE_THREAD(code_state_pool)[i] != NULL
+            && MP_STATE_THREAD(code_state_pool_alloc)[i] >= alloc) {
+            mp_code_state_t *code_state = MP_STATE_THREAD(code_state_pool)[i];
+            MP_STATE_THREAD(code_state_pool)[i] = NULL;
+            *state_size = MP_STATE_THREAD(code_state_pool_alloc)[i] - sizeof(mp_code_state_t);
+            return code_state;
+        }
+    }
+    return NULL;
+}
+
+// Return a finished code-state block to the pool, or free it if the pool is
+// full.  The block is cleared so it doesn't keep old objects alive.
+STATIC void code_state_pool_put(mp_code_state_t *code_state, size_t state_size) {
+    for (size_t i = 0; i < MICROPY_OPT_CODE_STATE_POOL_SIZE; i++) {
+        if (MP_STATE_THREAD(code_state_pool)[i] == NULL) {
+            memset(code_state, 0, sizeof(mp_code_state_t) + state_size);
+            MP_STATE_THREAD(code_state_pool)[i] = code_state;
+            MP_STATE_THREAD(code_state_pool_alloc)[i] = sizeof(mp_code_state_t) + state_size;
+            return;
+        }
+    }
+    m_del_var(mp_code_state_t, byte, state_size, code_state);
+}
+
+#endif
+
 #define DECODE_CODESTATE_SIZE(bytecode, n_state_out_var, state_size_out_var) \
     { \
         const uint8_t *ip = bytecode; \
@@ -266,7 +301,13 @@ STATIC mp_obj_t fun_bc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
     code_state = mp_pystack_alloc(sizeof(mp_code_state_t) + state_size);
     #else
     if (state_size > VM_MAX_STATE_ON_STACK) {
-        code_state = m_new_obj_var_maybe(mp_code_state_t, byte, state_size);
+        #if MICROPY_OPT_CODE_STATE_POOL
+        code_state = code_state_pool_take(&state_size);
+        if (code_state == NULL)
+        #endif
+        {
+            code_state = m_new_obj_var_maybe(mp_code_state_t, byte, state_size);
+        }
         #if MICROPY_DEBUG_VM_STACK_OVERFLOW
         if (code_state != NULL) {
             memset(code_state->state, 0, state_size);
@@ -336,7 +377,11 @@ STATIC mp_obj_t fun_bc_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const
     #else
     // free the state if it was allocated on the heap
     if (state_size != 0) {
+        #if MICROPY_OPT_CODE_STATE_POOL
+        code_state_pool_put(code_state, state_size);
+        #else
         m_del_var(mp_code_state_t, byte, state_size, code_state);
+        #endif
     }
     #endif
 
@@ -541,3 +586,23 @@ mp_obj_t mp_obj_new_fun_asm(size_t n_args, const void *fun_data, mp_uint_t type_
 }
 
 #endif // MICROPY_EMIT_INLINE_ASM
+
+// True if fun is compiled machine code: a native/viper-emitted function or
+// inline assembler.  Such functions are called with a fixed C-stack frame,
+// without going through the VM, so they are suitable to run in contexts
+// where the uPy heap is locked (e.g. hard IRQ handlers).
+bool mp_obj_is_native_fun(mp_obj_t fun_in) {
+    const mp_obj_type_t *type = mp_obj_get_type(fun_in);
+    #if MICROPY_EMIT_NATIVE
+    if (type == &mp_type_fun_native) {
+        return true;
+    }
+    #endif
+    #if MICROPY_EMIT_INLINE_ASM
+    if (type == &mp_type_fun_asm) {
+        return true;
+    }
+    #endif
+    (void)type;
+    return false;
+}
@@ -182,9 +182,16 @@ mp_vm_return_kind_t mp_obj_gen_resume(mp_obj_t self_in, mp_obj_t send_value, mp_
     // Mark as running
     self->pend_exc = MP_OBJ_NULL;
 
-    // Set up the correct globals context for the generator and execute it
-    self->code_state.old_globals = mp_globals_get();
-    mp_globals_set(self->code_state.fun_bc->globals);
+    // Set up the correct globals context for the generator and execute it.
+    // Scheduler-style drivers usually resume generators defined in the module
+    // that is currently executing, in which case the globals are already
+    // current and the swap (which goes via the thread state) can be skipped.
+    mp_obj_dict_t *gen_globals = self->code_state.fun_bc->globals;
+    mp_obj_dict_t *old_globals = mp_globals_get();
+    self->code_state.old_globals = old_globals;
+    if (old_globals != gen_globals) {
+        mp_globals_set(gen_globals);
+    }
 
     mp_vm_return_kind_t ret_kind;
 
@@ -201,7 +208,9 @@ mp_vm_return_kind_t mp_obj_gen_resume(mp_obj_t self_in, mp_obj_t send_value, mp_
         ret_kind = mp_execute_bytecode(&self->code_state, throw_value);
     }
 
-    mp_globals_set(self->code_state.old_globals);
+    if (old_globals != gen_globals) {
+        mp_globals_set(old_globals);
+    }
 
     // Mark as not running
     self->pend_exc = mp_const_none;
@@ -171,6 +171,62 @@ mp_obj_t mp_obj_int_unary_op(mp_unary_op_t op, mp_obj_t o_in) {
     }
 }
 
+#if MICROPY_OPT_MPZ_INT64
+// Try to compute lhs <op> rhs directly in a machine long long, for operands
+// that only slightly exceed the small-int range (eg microsecond timestamps).
+// Returns MP_OBJ_NULL if the operands don't fit, the result might not fit,
+// or the op isn't one of the simple arithmetic/bitwise ops handled here.
+STATIC mp_obj_t mp_obj_int_try_ll_binary_op(mp_binary_op_t op, const mpz_t *zlhs, const mpz_t *zrhs) {
+    long long lhs, rhs, res;
+    if (!mpz_as_ll_checked(zlhs, &lhs) || !mpz_as_ll_checked(zrhs, &rhs)) {
+        return MP_OBJ_NULL;
+    }
+    switch (op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            res = (long long)((unsigned long long)lhs + (unsigned long long)rhs);
+            if (((lhs ^ res) & (rhs ^ res)) < 0) {
+                return MP_OBJ_NULL; // overflow
+            }
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            res = (long long)((unsigned long long)lhs - (unsigned long long)rhs);
+            if (((lhs ^ rhs) & (lhs ^ res)) < 0) {
+                return MP_OBJ_NULL; // overflow
+            }
+            break;
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+            // only when the product is guaranteed to fit in 63 bits
+            if (lhs < -(1LL << 31) || lhs > (1LL << 31) || rhs < -(1LL << 31) || rhs > (1LL << 31)) {
+                return MP_OBJ_NULL;
+            }
+            res = lhs * rhs;
+            break;
+        // bitwise ops on two's-complement values give the correct Python result
+        case MP_BINARY_OP_AND:
+        case MP_BINARY_OP_INPLACE_AND:
+            res = lhs & rhs;
+            break;
+        case MP_BINARY_OP_OR:
+        case MP_BINARY_OP_INPLACE_OR:
+            res = lhs | rhs;
+            break;
+        case MP_BINARY_OP_XOR:
+        case MP_BINARY_OP_INPLACE_XOR:
+            res = lhs ^ rhs;
+            break;
+        default:
+            return MP_OBJ_NULL;
+    }
+    if ((long long)(mp_int_t)res == res && MP_SMALL_INT_FITS((mp_int_t)res)) {
+        return MP_OBJ_NEW_SMALL_INT((mp_int_t)res);
+    }
+    return mp_obj_new_int_from_ll(res);
+}
+#endif
+
 mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
     const mpz_t *zlhs;
     const mpz_t *zrhs;
@@ -205,6 +261,13 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
         return mp_obj_int_binary_op_extra_cases(op, lhs_in, rhs_in);
     }
 
+    #if MICROPY_OPT_MPZ_INT64
+    mp_obj_t ll_result = mp_obj_int_try_ll_binary_op(op, zlhs, zrhs);
+    if (ll_result != MP_OBJ_NULL) {
+        return ll_result;
+    }
+    #endif
+
     #if MICROPY_PY_BUILTINS_FLOAT
     if (op == MP_BINARY_OP_TRUE_DIVIDE || op == MP_BINARY_OP_INPLACE_TRUE_DIVIDE) {
         if (mpz_is_zero(zrhs)) {
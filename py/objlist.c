@@ -39,9 +39,57 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args);
 // TODO: Move to mpconfig.h
 #define LIST_MIN_ALLOC 4
 
+#if MICROPY_PY_THREAD_SAFE_CONTAINERS
+// Per-list lock around structural operations; see the description of
+// MICROPY_PY_THREAD_SAFE_CONTAINERS in py/mpconfig.h for what is and is
+// not covered.  Locked sections must not raise, so allocations within
+// them use the _maybe variants and raise only after unlocking.
+#define LIST_ENTER(self) mp_thread_mutex_lock(&(self)->mutex, 1)
+#define LIST_EXIT(self) mp_thread_mutex_unlock(&(self)->mutex)
+#else
+#define LIST_ENTER(self)
+#define LIST_EXIT(self)
+#endif
+
 /******************************************************************************/
 /* list                                                                       */
 
+#if MICROPY_PY_THREAD_SAFE_CONTAINERS
+// Take a consistent copy of the items so read-only operations can scan
+// them with the lock released (the element comparisons may run arbitrary
+// Python code).  The live array must not be scanned without the lock: a
+// concurrent append can m_renew it out from under the scan.  The copy is
+// not allocated under the lock because an allocation can trigger a GC
+// pass and run finalisers.  Returns the snapshot length; the caller owns
+// *items_out (it is NULL when the list was empty).
+STATIC size_t list_snapshot(mp_obj_list_t *self, mp_obj_t **items_out) {
+    LIST_ENTER(self);
+    size_t len = self->len;
+    LIST_EXIT(self);
+    if (len == 0) {
+        *items_out = NULL;
+        return 0;
+    }
+    size_t alloc = len;
+    mp_obj_t *copy = m_new(mp_obj_t, alloc);
+    LIST_ENTER(self);
+    if (len > self->len) {
+        // the list shrank while the copy was being allocated
+        len = self->len;
+    }
+    memcpy(copy, self->items, len * sizeof(mp_obj_t));
+    LIST_EXIT(self);
+    if (len == 0) {
+        m_del(mp_obj_t, copy, alloc);
+        copy = NULL;
+    } else if (len < alloc) {
+        copy = m_renew(mp_obj_t, copy, alloc, len);
+    }
+    *items_out = copy;
+    return len;
+}
+#endif
+
 STATIC void list_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kind_t kind) {
     mp_obj_list_t *o = MP_OBJ_TO_PTR(o_in);
     const char *item_separator = ", ";
@@ -169,12 +217,24 @@ STATIC mp_obj_t list_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
                 mp_raise_NotImplementedError(NULL);
             }
 
+            LIST_ENTER(self);
+            #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+            // the slice was computed outside the lock; clamp it to the
+            // current length in case of concurrent mutation
+            if (slice.stop > (mp_int_t)self->len) {
+                slice.stop = self->len;
+            }
+            if (slice.start > slice.stop) {
+                slice.start = slice.stop;
+            }
+            #endif
             mp_int_t len_adj = slice.start - slice.stop;
             assert(len_adj <= 0);
             mp_seq_replace_slice_no_grow(self->items, self->len, slice.start, slice.stop, self->items /*NULL*/, 0, sizeof(*self->items));
             // Clear "freed" elements at the end of list
             mp_seq_clear(self->items, self->len + len_adj, self->len, sizeof(*self->items));
             self->len += len_adj;
+            LIST_EXIT(self);
             return mp_const_none;
         }
         #endif
@@ -191,12 +251,35 @@ STATIC mp_obj_t list_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
                 return mp_seq_extract_slice(self->len, self->items, &slice);
             }
             mp_obj_list_t *res = list_new(slice.stop - slice.start);
+            #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+            // copy what is still within the current length; a concurrent
+            // shrink may have emptied slots, which must not leak out as
+            // MP_OBJ_NULL
+            LIST_ENTER(self);
+            size_t n_avail = (size_t)slice.start < self->len ? self->len - slice.start : 0;
+            if (n_avail > res->len) {
+                n_avail = res->len;
+            }
+            mp_seq_copy(res->items, self->items + slice.start, n_avail, mp_obj_t);
+            LIST_EXIT(self);
+            for (size_t i = n_avail; i < res->len; i++) {
+                res->items[i] = mp_const_none;
+            }
+            #else
             mp_seq_copy(res->items, self->items + slice.start, res->len, mp_obj_t);
+            #endif
             return MP_OBJ_FROM_PTR(res);
         }
         #endif
         size_t index_val = mp_get_index(self->base.type, self->len, index, false);
+        #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+        LIST_ENTER(self);
+        mp_obj_t value_out = index_val < self->len ? self->items[index_val] : mp_const_none;
+        LIST_EXIT(self);
+        return value_out;
+        #else
         return self->items[index_val];
+        #endif
     } else {
         #if MICROPY_PY_BUILTINS_SLICE
         if (mp_obj_is_type(index, &mp_type_slice)) {
@@ -208,13 +291,34 @@ STATIC mp_obj_t list_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
             if (!mp_seq_get_fast_slice_indexes(self->len, index, &slice_out)) {
                 mp_raise_NotImplementedError(NULL);
             }
+            LIST_ENTER(self);
+            #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+            // the slice was computed outside the lock; clamp it to the
+            // current length in case of concurrent mutation
+            if (slice_out.stop > (mp_int_t)self->len) {
+                slice_out.stop = self->len;
+            }
+            if (slice_out.start > slice_out.stop) {
+                slice_out.start = slice_out.stop;
+            }
+            #endif
             mp_int_t len_adj = value_len - (slice_out.stop - slice_out.start);
             if (len_adj > 0) {
                 if (self->len + len_adj > self->alloc) {
                     // TODO: Might optimize memory copies here by checking if block can
                     // be grown inplace or not
-                    self->items = m_renew(mp_obj_t, self->items, self->alloc, self->len + len_adj);
-                    self->alloc = self->len + len_adj;
+                    size_t new_alloc = self->len + len_adj;
+                    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+                    mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, new_alloc, true);
+                    if (new_items == NULL) {
+                        LIST_EXIT(self);
+                        m_malloc_fail(new_alloc * sizeof(mp_obj_t));
+                    }
+                    self->items = new_items;
+                    #else
+                    self->items = m_renew(mp_obj_t, self->items, self->alloc, new_alloc);
+                    #endif
+                    self->alloc = new_alloc;
                 }
                 mp_seq_replace_slice_grow_inplace(self->items, self->len,
                     slice_out.start, slice_out.stop, value_items, value_len, len_adj, sizeof(*self->items));
@@ -226,6 +330,7 @@ STATIC mp_obj_t list_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
                 // TODO: apply allocation policy re: alloc_size
             }
             self->len += len_adj;
+            LIST_EXIT(self);
             return mp_const_none;
         }
         #endif
@@ -241,12 +346,24 @@ STATIC mp_obj_t list_getiter(mp_obj_t o_in, mp_obj_iter_buf_t *iter_buf) {
 mp_obj_t mp_obj_list_append(mp_obj_t self_in, mp_obj_t arg) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    LIST_ENTER(self);
     if (self->len >= self->alloc) {
-        self->items = m_renew(mp_obj_t, self->items, self->alloc, self->alloc * 2);
-        self->alloc *= 2;
+        size_t new_alloc = self->alloc * 2;
+        #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+        mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, new_alloc, true);
+        if (new_items == NULL) {
+            LIST_EXIT(self);
+            m_malloc_fail(new_alloc * sizeof(mp_obj_t));
+        }
+        self->items = new_items;
+        #else
+        self->items = m_renew(mp_obj_t, self->items, self->alloc, new_alloc);
+        #endif
+        self->alloc = new_alloc;
         mp_seq_clear(self->items, self->len + 1, self->alloc, sizeof(*self->items));
     }
     self->items[self->len++] = arg;
+    LIST_EXIT(self);
     return mp_const_none; // return None, as per CPython
 }
 
@@ -256,15 +373,27 @@ STATIC mp_obj_t list_extend(mp_obj_t self_in, mp_obj_t arg_in) {
         mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
         mp_obj_list_t *arg = MP_OBJ_TO_PTR(arg_in);
 
+        LIST_ENTER(self);
         if (self->len + arg->len > self->alloc) {
             // TODO: use alloc policy for "4"
-            self->items = m_renew(mp_obj_t, self->items, self->alloc, self->len + arg->len + 4);
-            self->alloc = self->len + arg->len + 4;
+            size_t new_alloc = self->len + arg->len + 4;
+            #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+            mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, new_alloc, true);
+            if (new_items == NULL) {
+                LIST_EXIT(self);
+                m_malloc_fail(new_alloc * sizeof(mp_obj_t));
+            }
+            self->items = new_items;
+            #else
+            self->items = m_renew(mp_obj_t, self->items, self->alloc, new_alloc);
+            #endif
+            self->alloc = new_alloc;
             mp_seq_clear(self->items, self->len + arg->len, self->alloc, sizeof(*self->items));
         }
 
         memcpy(self->items + self->len, arg->items, sizeof(mp_obj_t) * arg->len);
         self->len += arg->len;
+        LIST_EXIT(self);
     } else {
         list_extend_from_iter(self_in, arg_in);
     }
@@ -278,18 +407,55 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("pop from empty list"));
     }
     size_t index = mp_get_index(self->base.type, self->len, n_args == 1 ? MP_OBJ_NEW_SMALL_INT(-1) : args[1], false);
+    LIST_ENTER(self);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // the checks above ran outside the lock, so revalidate against
+    // concurrent mutation
+    if (self->len == 0) {
+        LIST_EXIT(self);
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("pop from empty list"));
+    }
+    if (index >= self->len) {
+        index = self->len - 1;
+    }
+    #endif
     mp_obj_t ret = self->items[index];
     self->len -= 1;
     memmove(self->items + index, self->items + index + 1, (self->len - index) * sizeof(mp_obj_t));
     // Clear stale pointer from slot which just got freed to prevent GC issues
     self->items[self->len] = MP_OBJ_NULL;
     if (self->alloc > LIST_MIN_ALLOC && self->alloc > 2 * self->len) {
+        #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+        mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, self->alloc / 2, true);
+        if (new_items != NULL) {
+            self->items = new_items;
+            self->alloc /= 2;
+        }
+        #else
         self->items = m_renew(mp_obj_t, self->items, self->alloc, self->alloc / 2);
         self->alloc /= 2;
+        #endif
     }
+    LIST_EXIT(self);
     return ret;
 }
 
+// Compare two (key) values for the sort, avoiding the full binary-op
+// dispatch for the common cases of small ints and floats.  binop_less_result
+// is mp_const_true for an ascending sort and mp_const_false for descending.
+STATIC bool sort_less(mp_obj_t a, mp_obj_t b, mp_obj_t binop_less_result) {
+    if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+        return (MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b)) == (binop_less_result == mp_const_true);
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (mp_obj_is_float(a) && mp_obj_is_float(b)) {
+        return (mp_obj_get_float(a) < mp_obj_get_float(b)) == (binop_less_result == mp_const_true);
+    }
+    #endif
+    return mp_binary_op(MP_BINARY_OP_LESS, a, b) == binop_less_result;
+}
+
+#if !MICROPY_OPT_LIST_SORT_STABLE
 STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
     MP_STACK_CHECK();
     while (head < tail) {
@@ -298,9 +464,9 @@ STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj
         mp_obj_t v = key_fn == MP_OBJ_NULL ? tail[0] : mp_call_function_1(key_fn, tail[0]); // get pivot using key_fn
         for (;;) {
             do {++h;
-            } while (h < t && mp_binary_op(MP_BINARY_OP_LESS, key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v) == binop_less_result);
+            } while (h < t && sort_less(key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v, binop_less_result));
             do {--t;
-            } while (h < t && mp_binary_op(MP_BINARY_OP_LESS, v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0])) == binop_less_result);
+            } while (h < t && sort_less(v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0]), binop_less_result));
             if (h >= t) {
                 break;
             }
@@ -322,7 +488,93 @@ STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
+#else // MICROPY_OPT_LIST_SORT_STABLE
+
+// Stable merge sort over items.  keys caches the key-function value for each
+// item (computed once, before the sort starts) and is kept in step with
+// items; it's NULL when no key function was given, in which case the items
+// themselves are compared.  tmp provides scratch space for len/2 entries of
+// each array in use.
+STATIC void mp_mergesort(mp_obj_t *items, mp_obj_t *keys, size_t len, mp_obj_t *tmp) {
+    MP_STACK_CHECK();
+    mp_obj_t *cmp = keys != NULL ? keys : items;
+    if (len < 8) {
+        // insertion sort for short runs
+        for (size_t i = 1; i < len; i++) {
+            mp_obj_t it = items[i];
+            mp_obj_t k = cmp[i];
+            size_t j = i;
+            while (j > 0 && sort_less(k, cmp[j - 1], mp_const_true)) {
+                items[j] = items[j - 1];
+                if (keys != NULL) {
+                    keys[j] = keys[j - 1];
+                }
+                j--;
+            }
+            items[j] = it;
+            if (keys != NULL) {
+                keys[j] = k;
+            }
+        }
+        return;
+    }
+
+    size_t half = len / 2;
+    mp_mergesort(items, keys, half, tmp);
+    mp_mergesort(items + half, keys == NULL ? NULL : keys + half, len - half, tmp);
+
+    if (!sort_less(cmp[half], cmp[half - 1], mp_const_true)) {
+        // the two halves are already in order (common for mostly-sorted input)
+        return;
+    }
+
+    // copy the left half out to the scratch buffer and merge back in place
+    memcpy(tmp, items, half * sizeof(mp_obj_t));
+    mp_obj_t *tmp_keys = NULL;
+    if (keys != NULL) {
+        tmp_keys = tmp + half;
+        memcpy(tmp_keys, keys, half * sizeof(mp_obj_t));
+    }
+    mp_obj_t *tmp_cmp = keys != NULL ? tmp_keys : tmp;
+    size_t i = 0, j = half, d = 0;
+    while (i < half && j < len) {
+        // take from the right run only when strictly less, to keep stability
+        if (sort_less(cmp[j], tmp_cmp[i], mp_const_true)) {
+            items[d] = items[j];
+            if (keys != NULL) {
+                keys[d] = keys[j];
+            }
+            j++;
+        } else {
+            items[d] = tmp[i];
+            if (keys != NULL) {
+                keys[d] = tmp_keys[i];
+            }
+            i++;
+        }
+        d++;
+    }
+    // any remaining right-run entries are already in place
+    while (i < half) {
+        items[d] = tmp[i];
+        if (keys != NULL) {
+            keys[d] = tmp_keys[i];
+        }
+        i++;
+        d++;
+    }
+}
+
+STATIC void list_reverse_items(mp_obj_t *items, size_t len) {
+    for (size_t i = 0, j = len - 1; i < j; i++, j--) {
+        mp_obj_t x = items[i];
+        items[i] = items[j];
+        items[j] = x;
+    }
+}
+
+#endif // MICROPY_OPT_LIST_SORT_STABLE
+
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
@@ -340,9 +592,37 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_obj_list_t *self = MP_OBJ_TO_PTR(pos_args[0]);
 
     if (self->len > 1) {
+        mp_obj_t key_fn = args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj;
+        #if MICROPY_OPT_LIST_SORT_STABLE
+        size_t len = self->len;
+        // As CPython does, implement reverse by flipping the list around an
+        // ascending sort, so equal elements keep their relative order.
+        if (args.reverse.u_bool) {
+            list_reverse_items(self->items, len);
+        }
+        // decorate: evaluate the key function once per element, up front
+        mp_obj_t *keys = NULL;
+        if (key_fn != MP_OBJ_NULL) {
+            keys = m_new(mp_obj_t, len);
+            for (size_t i = 0; i < len; i++) {
+                keys[i] = mp_call_function_1(key_fn, self->items[i]);
+            }
+        }
+        size_t tmp_n = (len / 2) * (keys == NULL ? 1 : 2);
+        mp_obj_t *tmp = m_new(mp_obj_t, tmp_n);
+        mp_mergesort(self->items, keys, len, tmp);
+        m_del(mp_obj_t, tmp, tmp_n);
+        if (keys != NULL) {
+            m_del(mp_obj_t, keys, len);
+        }
+        if (args.reverse.u_bool) {
+            list_reverse_items(self->items, len);
+        }
+        #else
+        // Note: quicksort is not stable, unlike Python's defined sort.
         mp_quicksort(self->items, self->items + self->len - 1,
-            args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
-            args.reverse.u_bool ? mp_const_false : mp_const_true);
+            key_fn, args.reverse.u_bool ? mp_const_false : mp_const_true);
+        #endif
     }
 
     return mp_const_none;
@@ -351,29 +631,64 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
 STATIC mp_obj_t list_clear(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    LIST_ENTER(self);
     self->len = 0;
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, LIST_MIN_ALLOC, true);
+    if (new_items != NULL) {
+        self->items = new_items;
+        self->alloc = LIST_MIN_ALLOC;
+    }
+    #else
     self->items = m_renew(mp_obj_t, self->items, self->alloc, LIST_MIN_ALLOC);
     self->alloc = LIST_MIN_ALLOC;
+    #endif
     mp_seq_clear(self->items, 0, self->alloc, sizeof(*self->items));
+    LIST_EXIT(self);
     return mp_const_none;
 }
 
 STATIC mp_obj_t list_copy(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_obj_t *items;
+    size_t len = list_snapshot(self, &items);
+    mp_obj_t res = mp_obj_new_list(len, items);
+    m_del(mp_obj_t, items, len);
+    return res;
+    #else
     return mp_obj_new_list(self->len, self->items);
+    #endif
 }
 
 STATIC mp_obj_t list_count(mp_obj_t self_in, mp_obj_t value) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_obj_t *items;
+    size_t len = list_snapshot(self, &items);
+    mp_obj_t res = mp_seq_count_obj(items, len, value);
+    m_del(mp_obj_t, items, len);
+    return res;
+    #else
     return mp_seq_count_obj(self->items, self->len, value);
+    #endif
 }
 
 STATIC mp_obj_t list_index(size_t n_args, const mp_obj_t *args) {
     mp_check_self(mp_obj_is_type(args[0], &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(args[0]);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_obj_t *items;
+    size_t len = list_snapshot(self, &items);
+    // on "not in sequence" this raises and the snapshot is left to the GC
+    mp_obj_t res = mp_seq_index_obj(items, len, n_args, args);
+    m_del(mp_obj_t, items, len);
+    return res;
+    #else
     return mp_seq_index_obj(self->items, self->len, n_args, args);
+    #endif
 }
 
 STATIC mp_obj_t list_insert(mp_obj_t self_in, mp_obj_t idx, mp_obj_t obj) {
@@ -393,33 +708,108 @@ STATIC mp_obj_t list_insert(mp_obj_t self_in, mp_obj_t idx, mp_obj_t obj) {
 
     mp_obj_list_append(self_in, mp_const_none);
 
+    LIST_ENTER(self);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // the list may have shrunk since the index was computed
+    if ((size_t)index >= self->len) {
+        index = self->len == 0 ? 0 : self->len - 1;
+    }
+    #endif
     for (mp_int_t i = self->len - 1; i > index; i--) {
         self->items[i] = self->items[i - 1];
     }
     self->items[index] = obj;
+    LIST_EXIT(self);
 
     return mp_const_none;
 }
 
 mp_obj_t mp_obj_list_remove(mp_obj_t self_in, mp_obj_t value) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // index-then-pop is not atomic: a concurrent remove at a lower index
+    // shifts the found element and the pop takes the wrong one.  Find a
+    // matching element in a snapshot (the comparison may run arbitrary
+    // Python code so it can't be done under the lock), then unlink that
+    // object by identity under the lock; if it was removed concurrently
+    // in the meantime, rescan.
+    mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    for (;;) {
+        mp_obj_t *items;
+        size_t len = list_snapshot(self, &items);
+        mp_obj_t found = MP_OBJ_NULL;
+        for (size_t i = 0; i < len; i++) {
+            if (mp_obj_equal(items[i], value)) {
+                found = items[i];
+                break;
+            }
+        }
+        m_del(mp_obj_t, items, len);
+        if (found == MP_OBJ_NULL) {
+            mp_raise_ValueError(MP_ERROR_TEXT("object not in sequence"));
+        }
+        LIST_ENTER(self);
+        for (size_t i = 0; i < self->len; i++) {
+            if (self->items[i] == found) {
+                self->len -= 1;
+                memmove(self->items + i, self->items + i + 1, (self->len - i) * sizeof(mp_obj_t));
+                // Clear stale pointer from slot which just got freed to prevent GC issues
+                self->items[self->len] = MP_OBJ_NULL;
+                LIST_EXIT(self);
+                return mp_const_none;
+            }
+        }
+        LIST_EXIT(self);
+    }
+    #else
     mp_obj_t args[] = {self_in, value};
     args[1] = list_index(2, args);
     list_pop(2, args);
 
     return mp_const_none;
+    #endif
 }
 
+#if MICROPY_PY_LIST_RESERVE
+// MicroPython extension: pre-grow the backing store so that building a
+// list of known size does a single allocation instead of repeated
+// doubling reallocations.  len() and contents are unchanged.
+STATIC mp_obj_t list_reserve(mp_obj_t self_in, mp_obj_t n_in) {
+    mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
+    mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_int_t n = mp_obj_get_int(n_in);
+    LIST_ENTER(self);
+    if (n > 0 && (size_t)n > self->alloc) {
+        #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+        mp_obj_t *new_items = m_renew_maybe(mp_obj_t, self->items, self->alloc, n, true);
+        if (new_items == NULL) {
+            LIST_EXIT(self);
+            m_malloc_fail(n * sizeof(mp_obj_t));
+        }
+        self->items = new_items;
+        #else
+        self->items = m_renew(mp_obj_t, self->items, self->alloc, n);
+        #endif
+        self->alloc = n;
+        mp_seq_clear(self->items, self->len, self->alloc, sizeof(*self->items));
+    }
+    LIST_EXIT(self);
+    return mp_const_none;
+}
+#endif
+
 STATIC mp_obj_t list_reverse(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
 
+    LIST_ENTER(self);
     mp_int_t len = self->len;
     for (mp_int_t i = 0; i < len / 2; i++) {
         mp_obj_t a = self->items[i];
         self->items[i] = self->items[len - i - 1];
         self->items[len - i - 1] = a;
     }
+    LIST_EXIT(self);
 
     return mp_const_none;
 }
@@ -433,6 +823,9 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(list_index_obj, 2, 4, list_index);
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(list_insert_obj, list_insert);
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(list_pop_obj, 1, 2, list_pop);
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(list_remove_obj, mp_obj_list_remove);
+#if MICROPY_PY_LIST_RESERVE
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(list_reserve_obj, list_reserve);
+#endif
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(list_reverse_obj, list_reverse);
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(list_sort_obj, 1, mp_obj_list_sort);
 
@@ -446,6 +839,9 @@ STATIC const mp_rom_map_elem_t list_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_insert), MP_ROM_PTR(&list_insert_obj) },
     { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&list_pop_obj) },
     { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&list_remove_obj) },
+    #if MICROPY_PY_LIST_RESERVE
+    { MP_ROM_QSTR(MP_QSTR_reserve), MP_ROM_PTR(&list_reserve_obj) },
+    #endif
     { MP_ROM_QSTR(MP_QSTR_reverse), MP_ROM_PTR(&list_reverse_obj) },
     { MP_ROM_QSTR(MP_QSTR_sort), MP_ROM_PTR(&list_sort_obj) },
 };
@@ -466,6 +862,9 @@ const mp_obj_type_t mp_type_list = {
 
 void mp_obj_list_init(mp_obj_list_t *o, size_t n) {
     o->base.type = &mp_type_list;
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    mp_thread_mutex_init(&o->mutex);
+    #endif
     o->alloc = n < LIST_MIN_ALLOC ? LIST_MIN_ALLOC : n;
     o->len = n;
     o->items = m_new(mp_obj_t, o->alloc);
@@ -504,7 +903,17 @@ void mp_obj_list_set_len(mp_obj_t self_in, size_t len) {
 void mp_obj_list_store(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
     mp_obj_list_t *self = MP_OBJ_TO_PTR(self_in);
     size_t i = mp_get_index(self->base.type, self->len, index, false);
+    LIST_ENTER(self);
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // a concurrent shrink may have invalidated the index; drop the store
+    // rather than write beyond the current length
+    if (i >= self->len) {
+        LIST_EXIT(self);
+        return;
+    }
+    #endif
     self->items[i] = value;
+    LIST_EXIT(self);
 }
 
 /******************************************************************************/
@@ -520,11 +929,14 @@ typedef struct _mp_obj_list_it_t {
 STATIC mp_obj_t list_it_iternext(mp_obj_t self_in) {
     mp_obj_list_it_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_list_t *list = MP_OBJ_TO_PTR(self->list);
+    LIST_ENTER(list);
     if (self->cur < list->len) {
         mp_obj_t o_out = list->items[self->cur];
         self->cur += 1;
+        LIST_EXIT(list);
         return o_out;
     } else {
+        LIST_EXIT(list);
         return MP_OBJ_STOP_ITERATION;
     }
 }
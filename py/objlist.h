@@ -30,6 +30,10 @@
 
 typedef struct _mp_obj_list_t {
     mp_obj_base_t base;
+    #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+    // taken around structural operations (see MICROPY_PY_THREAD_SAFE_CONTAINERS)
+    mp_thread_mutex_t mutex;
+    #endif
     size_t alloc;
     size_t len;
     mp_obj_t *items;
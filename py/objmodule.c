@@ -30,6 +30,7 @@
 #include <assert.h>
 
 #include "py/objmodule.h"
+#include "py/objlist.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
 
@@ -58,8 +59,24 @@ STATIC void module_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kin
     mp_printf(print, "<module '%s'>", module_name);
 }
 
+#if MICROPY_MODULE_DEFER_BUILTIN_INIT
+STATIC void module_run_deferred_init(mp_obj_t self_in);
+#endif
+
 STATIC void module_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     mp_obj_module_t *self = MP_OBJ_TO_PTR(self_in);
+    #if MICROPY_MODULE_DEFER_BUILTIN_INIT
+    if (MP_STATE_VM(mp_deferred_builtin_init) != MP_OBJ_NULL && dest[0] == MP_OBJ_NULL) {
+        module_run_deferred_init(self_in);
+    }
+    #endif
+    #if MICROPY_MODULE_LAZY
+    if (self->lazy_code != NULL && dest[0] == MP_OBJ_NULL) {
+        // this module was imported lazily; execute its body now, on the first
+        // attribute load (stores don't need the body to have run)
+        mp_module_run_lazy(self_in);
+    }
+    #endif
     if (dest[0] == MP_OBJ_NULL) {
         // load attribute
         mp_map_elem_t *elem = mp_map_lookup(&self->globals->map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
@@ -121,6 +138,9 @@ mp_obj_t mp_obj_new_module(qstr module_name) {
     mp_obj_module_t *o = m_new_obj(mp_obj_module_t);
     o->base.type = &mp_type_module;
     o->globals = MP_OBJ_TO_PTR(mp_obj_new_dict(MICROPY_MODULE_DICT_SIZE));
+    #if MICROPY_MODULE_LAZY
+    o->lazy_code = NULL;
+    #endif
 
     // store __name__ entry in the module
     mp_obj_dict_store(MP_OBJ_FROM_PTR(o->globals), MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(module_name));
@@ -132,6 +152,43 @@ mp_obj_t mp_obj_new_module(qstr module_name) {
     return MP_OBJ_FROM_PTR(o);
 }
 
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define MODULE_ENTER() mp_thread_mutex_lock(&MP_STATE_VM(mp_module_mutex), 1)
+#define MODULE_EXIT() mp_thread_mutex_unlock(&MP_STATE_VM(mp_module_mutex))
+#else
+#define MODULE_ENTER()
+#define MODULE_EXIT()
+#endif
+
+// Atomically look up a module by name, creating a fresh module object if one
+// doesn't exist yet.  Sets *created when this call created the module, in
+// which case the caller is responsible for executing the module's body.
+// Making the claim a single step means concurrent importers of the same
+// module agree on one loader; the others see the module while it is still
+// initialising, the same as a circular import.
+mp_obj_t mp_obj_module_claim(qstr module_name, bool *created) {
+    MODULE_ENTER();
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    // creating the module allocates, so don't hold the mutex across a
+    // MemoryError
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) != 0) {
+        MODULE_EXIT();
+        nlr_jump(nlr.ret_val);
+    }
+    #endif
+    mp_obj_t module_obj = mp_module_get(module_name);
+    *created = (module_obj == MP_OBJ_NULL);
+    if (*created) {
+        module_obj = mp_obj_new_module(module_name);
+    }
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    nlr_pop();
+    #endif
+    MODULE_EXIT();
+    return module_obj;
+}
+
 /******************************************************************************/
 // Global module table and related functions
 
@@ -191,6 +248,9 @@ STATIC const mp_rom_map_elem_t mp_builtin_module_table[] = {
     #if MICROPY_PY_UHEAPQ
     { MP_ROM_QSTR(MP_QSTR_uheapq), MP_ROM_PTR(&mp_module_uheapq) },
     #endif
+    #if MICROPY_PY_UPARALLEL
+    { MP_ROM_QSTR(MP_QSTR_uparallel), MP_ROM_PTR(&mp_module_uparallel) },
+    #endif
     #if MICROPY_PY_UTIMEQ
     { MP_ROM_QSTR(MP_QSTR_utimeq), MP_ROM_PTR(&mp_module_utimeq) },
     #endif
@@ -215,6 +275,12 @@ STATIC const mp_rom_map_elem_t mp_builtin_module_table[] = {
     #if MICROPY_PY_LWIP
     { MP_ROM_QSTR(MP_QSTR_lwip), MP_ROM_PTR(&mp_module_lwip) },
     #endif
+    #if MICROPY_PY_NETUTILS
+    { MP_ROM_QSTR(MP_QSTR_netutils), MP_ROM_PTR(&mp_module_netutils) },
+    #endif
+    #if MICROPY_PY_ULOG
+    { MP_ROM_QSTR(MP_QSTR_ulog), MP_ROM_PTR(&mp_module_ulog) },
+    #endif
     #if MICROPY_PY_UWEBSOCKET
     { MP_ROM_QSTR(MP_QSTR_uwebsocket), MP_ROM_PTR(&mp_module_uwebsocket) },
     #endif
@@ -254,7 +320,11 @@ mp_obj_t mp_module_get(qstr module_name) {
         if (el == NULL) {
             return MP_OBJ_NULL;
         }
+        #if MICROPY_MODULE_DEFER_BUILTIN_INIT
+        mp_module_defer_builtin_init(module_name, el->value);
+        #else
         mp_module_call_init(module_name, el->value);
+        #endif
     }
 
     // module found, return it
@@ -295,4 +365,36 @@ void mp_module_call_init(qstr module_name, mp_obj_t module_obj) {
         mp_module_register(module_name, module_obj);
     }
 }
+
+#if MICROPY_MODULE_DEFER_BUILTIN_INIT
+void mp_module_defer_builtin_init(qstr module_name, mp_obj_t module_obj) {
+    // Register the module now so repeat imports don't re-queue it, but hold
+    // off running __init__ until an attribute is first accessed.
+    mp_module_register(module_name, module_obj);
+    if (MP_STATE_VM(mp_deferred_builtin_init) == MP_OBJ_NULL) {
+        MP_STATE_VM(mp_deferred_builtin_init) = mp_obj_new_list(0, NULL);
+    }
+    mp_obj_list_append(MP_STATE_VM(mp_deferred_builtin_init), module_obj);
+}
+
+STATIC void module_run_deferred_init(mp_obj_t self_in) {
+    mp_obj_list_t *pending = MP_OBJ_TO_PTR(MP_STATE_VM(mp_deferred_builtin_init));
+    for (size_t i = 0; i < pending->len; i++) {
+        if (pending->items[i] == self_in) {
+            // take the module off the pending list first so the __init__
+            // lookup below doesn't recurse back in here
+            pending->items[i] = pending->items[--pending->len];
+            if (pending->len == 0) {
+                MP_STATE_VM(mp_deferred_builtin_init) = MP_OBJ_NULL;
+            }
+            mp_obj_t dest[2];
+            mp_load_method_maybe(self_in, MP_QSTR___init__, dest);
+            if (dest[0] != MP_OBJ_NULL) {
+                mp_call_method_n_kw(0, 0, dest);
+            }
+            return;
+        }
+    }
+}
+#endif
 #endif
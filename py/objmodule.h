@@ -31,12 +31,16 @@
 extern const mp_map_t mp_builtin_module_map;
 
 mp_obj_t mp_module_get(qstr module_name);
+mp_obj_t mp_obj_module_claim(qstr module_name, bool *created);
 void mp_module_register(qstr qstr, mp_obj_t module);
 
 mp_obj_t mp_module_search_umodule(const char *module_str);
 
 #if MICROPY_MODULE_BUILTIN_INIT
 void mp_module_call_init(qstr module_name, mp_obj_t module_obj);
+#if MICROPY_MODULE_DEFER_BUILTIN_INIT
+void mp_module_defer_builtin_init(qstr module_name, mp_obj_t module_obj);
+#endif
 #else
 static inline void mp_module_call_init(qstr module_name, mp_obj_t module_obj) {
     (void)module_name;
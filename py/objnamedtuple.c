@@ -35,12 +35,30 @@
 #if MICROPY_PY_COLLECTIONS
 
 size_t mp_obj_namedtuple_find_field(const mp_obj_namedtuple_type_t *type, qstr name) {
+    #if MICROPY_PY_COLLECTIONS_NAMEDTUPLE_FIELD_INDEX
+    // binary search the field-order table built at type creation
+    size_t lo = 0;
+    size_t hi = type->n_fields;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        qstr mid_name = type->fields[type->field_order[mid]];
+        if (mid_name == name) {
+            return type->field_order[mid];
+        } else if (mid_name < name) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (size_t)-1;
+    #else
     for (size_t i = 0; i < type->n_fields; i++) {
         if (type->fields[i] == name) {
             return i;
         }
     }
     return (size_t)-1;
+    #endif
 }
 
 #if MICROPY_PY_COLLECTIONS_NAMEDTUPLE__ASDICT
@@ -148,6 +166,19 @@ mp_obj_namedtuple_type_t *mp_obj_new_namedtuple_base(size_t n_fields, mp_obj_t *
     for (size_t i = 0; i < n_fields; i++) {
         o->fields[i] = mp_obj_str_get_qstr(fields[i]);
     }
+    #if MICROPY_PY_COLLECTIONS_NAMEDTUPLE_FIELD_INDEX
+    // build the field-order table: insertion sort of the (few) field
+    // indices by qstr value
+    o->field_order = m_new(uint16_t, n_fields);
+    for (size_t i = 0; i < n_fields; i++) {
+        size_t j = i;
+        while (j > 0 && o->fields[o->field_order[j - 1]] > o->fields[i]) {
+            o->field_order[j] = o->field_order[j - 1];
+            j--;
+        }
+        o->field_order[j] = (uint16_t)i;
+    }
+    #endif
     return o;
 }
 
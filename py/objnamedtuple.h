@@ -31,6 +31,11 @@
 typedef struct _mp_obj_namedtuple_type_t {
     mp_obj_type_t base;
     size_t n_fields;
+    #if MICROPY_PY_COLLECTIONS_NAMEDTUPLE_FIELD_INDEX
+    // field indices sorted by qstr value, built once at type creation so
+    // that field lookup can binary search instead of scanning fields[]
+    uint16_t *field_order;
+    #endif
     qstr fields[];
 } mp_obj_namedtuple_type_t;
 
@@ -177,6 +177,7 @@ STATIC mp_obj_t set_copy(mp_obj_t self_in) {
     mp_obj_set_t *other = m_new_obj(mp_obj_set_t);
     other->base.type = self->base.type;
     mp_set_init(&other->set, self->set.alloc);
+    other->set.all_keys_are_small_ints = self->set.all_keys_are_small_ints;
     other->set.used = self->set.used;
     memcpy(other->set.table, self->set.table, self->set.alloc * sizeof(mp_obj_t));
     return MP_OBJ_FROM_PTR(other);
@@ -206,6 +207,18 @@ STATIC mp_obj_t set_diff_int(size_t n_args, const mp_obj_t *args, bool update) {
             set_clear(self);
         } else {
             mp_set_t *self_set = &((mp_obj_set_t *)MP_OBJ_TO_PTR(self))->set;
+            #if MICROPY_OPT_SET_BULK_OPS
+            if (is_set_or_frozenset(other)) {
+                // walk the other side's table directly, skipping the iterator protocol
+                mp_set_t *other_set = &((mp_obj_set_t *)MP_OBJ_TO_PTR(other))->set;
+                for (size_t j = 0; j < other_set->alloc; j++) {
+                    if (mp_set_slot_is_filled(other_set, j)) {
+                        mp_set_lookup(self_set, other_set->table[j], MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+                    }
+                }
+                continue;
+            }
+            #endif
             mp_obj_t iter = mp_getiter(other, NULL);
             mp_obj_t next;
             while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
@@ -242,16 +255,41 @@ STATIC mp_obj_t set_intersect_int(mp_obj_t self_in, mp_obj_t other, bool update)
     mp_obj_set_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_set_t *out = MP_OBJ_TO_PTR(mp_obj_new_set(0, NULL));
 
-    mp_obj_t iter = mp_getiter(other, NULL);
-    mp_obj_t next;
-    while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
-        if (mp_set_lookup(&self->set, next, MP_MAP_LOOKUP)) {
-            set_add(MP_OBJ_FROM_PTR(out), next);
+    #if MICROPY_OPT_SET_BULK_OPS
+    if (is_set_or_frozenset(other)) {
+        // Both sides are sets: walk the smaller table directly and probe the
+        // larger, and pre-size the result for the worst case so inserting
+        // into it never rehashes.
+        mp_set_t *small = &self->set;
+        mp_set_t *big = &((mp_obj_set_t *)MP_OBJ_TO_PTR(other))->set;
+        if (big->used < small->used) {
+            mp_set_t *tmp = small;
+            small = big;
+            big = tmp;
+        }
+        m_del(mp_obj_t, out->set.table, out->set.alloc);
+        mp_set_init(&out->set, small->used);
+        for (size_t i = 0; i < small->alloc; i++) {
+            if (mp_set_slot_is_filled(small, i)
+                && mp_set_lookup(big, small->table[i], MP_MAP_LOOKUP)) {
+                mp_set_lookup(&out->set, small->table[i], MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+            }
+        }
+    } else
+    #endif
+    {
+        mp_obj_t iter = mp_getiter(other, NULL);
+        mp_obj_t next;
+        while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+            if (mp_set_lookup(&self->set, next, MP_MAP_LOOKUP)) {
+                set_add(MP_OBJ_FROM_PTR(out), next);
+            }
         }
     }
 
     if (update) {
         m_del(mp_obj_t, self->set.table, self->set.alloc);
+        self->set.all_keys_are_small_ints = out->set.all_keys_are_small_ints;
         self->set.alloc = out->set.alloc;
         self->set.used = out->set.used;
         self->set.table = out->set.table;
@@ -398,6 +436,18 @@ STATIC mp_obj_t set_symmetric_difference(mp_obj_t self_in, mp_obj_t other_in) {
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(set_symmetric_difference_obj, set_symmetric_difference);
 
 STATIC void set_update_int(mp_obj_set_t *self, mp_obj_t other_in) {
+    #if MICROPY_OPT_SET_BULK_OPS
+    if (is_set_or_frozenset(other_in)) {
+        // walk the other side's table directly, skipping the iterator protocol
+        mp_set_t *other_set = &((mp_obj_set_t *)MP_OBJ_TO_PTR(other_in))->set;
+        for (size_t i = 0; i < other_set->alloc; i++) {
+            if (mp_set_slot_is_filled(other_set, i)) {
+                mp_set_lookup(&self->set, other_set->table[i], MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+            }
+        }
+        return;
+    }
+    #endif
     mp_obj_t iter = mp_getiter(other_in, NULL);
     mp_obj_t next;
     while ((next = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
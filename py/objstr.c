@@ -40,6 +40,7 @@ STATIC mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_
 
 STATIC mp_obj_t mp_obj_new_bytes_iterator(mp_obj_t str, mp_obj_iter_buf_t *iter_buf);
 STATIC NORETURN void bad_implicit_conversion(mp_obj_t self_in);
+STATIC mp_obj_t str_new_from_vstr(const mp_obj_type_t *type, vstr_t *vstr);
 
 /******************************************************************************/
 /* str                                                                        */
@@ -278,24 +279,38 @@ wrong_args:
 // TODO replace with something more efficient/standard
 const byte *find_subbytes(const byte *haystack, size_t hlen, const byte *needle, size_t nlen, int direction) {
     if (hlen >= nlen) {
-        size_t str_index, str_index_end;
-        if (direction > 0) {
-            str_index = 0;
-            str_index_end = hlen - nlen;
-        } else {
-            str_index = hlen - nlen;
-            str_index_end = 0;
+        if (nlen == 0) {
+            // an empty needle matches at the start (or end) of the haystack
+            return direction > 0 ? haystack : haystack + hlen;
         }
-        for (;;) {
-            if (memcmp(&haystack[str_index], needle, nlen) == 0) {
-                // found
-                return haystack + str_index;
+        if (direction > 0) {
+            // Let memchr find candidate positions for the first needle byte;
+            // libc implementations scan a word at a time, which is much
+            // faster than calling memcmp at every offset.
+            const byte *p = haystack;
+            const byte *end = haystack + hlen - nlen + 1;
+            while ((p = memchr(p, needle[0], end - p)) != NULL) {
+                if (memcmp(p + 1, needle + 1, nlen - 1) == 0) {
+                    // found
+                    return p;
+                }
+                p++;
             }
-            if (str_index == str_index_end) {
-                // not found
-                break;
+        } else {
+            size_t str_index = hlen - nlen;
+            for (;;) {
+                // check the first byte inline before paying for a memcmp call
+                if (haystack[str_index] == needle[0]
+                    && memcmp(&haystack[str_index + 1], needle + 1, nlen - 1) == 0) {
+                    // found
+                    return haystack + str_index;
+                }
+                if (str_index == 0) {
+                    // not found
+                    break;
+                }
+                str_index--;
             }
-            str_index += direction;
         }
     }
     return NULL;
@@ -394,6 +409,11 @@ mp_obj_t mp_obj_str_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
             vstr_init_len(&vstr, lhs_len + rhs_len);
             memcpy(vstr.buf, lhs_data, lhs_len);
             memcpy(vstr.buf + lhs_len, rhs_data, rhs_len);
+            if (op == MP_BINARY_OP_INPLACE_ADD) {
+                // s += x is (re)building a string; don't pay for hashing the
+                // whole result on every step to look for an interned twin
+                return str_new_from_vstr(lhs_type, &vstr);
+            }
             return mp_obj_new_str_from_vstr(lhs_type, &vstr);
         }
 
@@ -556,22 +576,23 @@ mp_obj_t mp_obj_str_split(size_t n_args, const mp_obj_t *args) {
             mp_raise_ValueError(MP_ERROR_TEXT("empty separator"));
         }
 
+        const byte *start0 = s;
         for (;;) {
             const byte *start = s;
-            for (;;) {
-                if (splits == 0 || s + sep_len > top) {
-                    s = top;
-                    break;
-                } else if (memcmp(s, sep_str, sep_len) == 0) {
-                    break;
+            const byte *found;
+            if (splits == 0
+                || (found = find_subbytes(s, top - s, (const byte *)sep_str, sep_len, 1)) == NULL) {
+                // no more separators
+                if (start == start0) {
+                    // nothing was split: reference the original string
+                    mp_obj_list_append(res, args[0]);
+                } else {
+                    mp_obj_list_append(res, mp_obj_new_str_of_type(self_type, start, top - start));
                 }
-                s++;
-            }
-            mp_obj_list_append(res, mp_obj_new_str_of_type(self_type, start, s - start));
-            if (s >= top) {
                 break;
             }
-            s += sep_len;
+            mp_obj_list_append(res, mp_obj_new_str_of_type(self_type, start, found - start));
+            s = found + sep_len;
             if (splits > 0) {
                 splits--;
             }
@@ -957,6 +978,21 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
     vstr_init_print(&vstr, 16, &print);
 
     for (; str < top; str++) {
+        if (*str != '{' && *str != '}') {
+            // copy the literal run up to the next brace in one chunk
+            const char *lb = memchr(str, '{', top - str);
+            const char *rb = memchr(str, '}', top - str);
+            const char *brace = lb;
+            if (lb == NULL || (rb != NULL && rb < lb)) {
+                brace = rb;
+            }
+            if (brace == NULL) {
+                vstr_add_strn(&vstr, str, top - str);
+                break;
+            }
+            vstr_add_strn(&vstr, str, brace - str);
+            str = brace;
+        }
         if (*str == '}') {
             str++;
             if (str < top && *str == '}') {
@@ -969,10 +1005,6 @@ STATIC vstr_t mp_obj_str_format_helper(const char *str, const char *top, int *ar
             mp_raise_ValueError(MP_ERROR_TEXT("single '}' encountered in format string"));
             #endif
         }
-        if (*str != '{') {
-            vstr_add_byte(&vstr, *str);
-            continue;
-        }
 
         str++;
         if (str < top && *str == '{') {
@@ -1424,8 +1456,14 @@ STATIC mp_obj_t str_modulo_format(mp_obj_t pattern, size_t n_args, const mp_obj_
     for (const byte *top = str + len; str < top; str++) {
         mp_obj_t arg = MP_OBJ_NULL;
         if (*str != '%') {
-            vstr_add_byte(&vstr, *str);
-            continue;
+            // copy the literal run up to the next format specifier in one chunk
+            const byte *pct = memchr(str, '%', top - str);
+            if (pct == NULL) {
+                vstr_add_strn(&vstr, (const char *)str, top - str);
+                break;
+            }
+            vstr_add_strn(&vstr, (const char *)str, pct - str);
+            str = pct;
         }
         if (++str >= top) {
             goto incomplete_format;
@@ -2020,7 +2058,7 @@ const mp_obj_type_t mp_type_bytes = {
 };
 
 // The zero-length bytes object, with data that includes a null-terminating byte
-const mp_obj_str_t mp_const_empty_bytes_obj = {{&mp_type_bytes}, 0, 0, (const byte *)""};
+const mp_obj_str_t mp_const_empty_bytes_obj = {{&mp_type_bytes}, 0, 0, (const byte *)"" MP_OBJ_STR_ANCHOR_INIT};
 
 // Create a str/bytes object using the given data.  New memory is allocated and
 // the data is copied across.  This function should only be used if the type is bytes,
@@ -2030,7 +2068,7 @@ mp_obj_t mp_obj_new_str_copy(const mp_obj_type_t *type, const byte *data, size_t
     o->base.type = type;
     o->len = len;
     if (data) {
-        o->hash = qstr_compute_hash(data, len);
+        o->hash = 0; // computed lazily, only if the string is hashed
         byte *p = m_new(byte, len + 1);
         o->data = p;
         memcpy(p, data, len * sizeof(byte));
@@ -2052,6 +2090,17 @@ mp_obj_t mp_obj_new_str_of_type(const mp_obj_type_t *type, const byte *data, siz
 
 // Create a str using a qstr to store the data; may use existing or new qstr.
 mp_obj_t mp_obj_new_str_via_qstr(const char *data, size_t len) {
+    #if MICROPY_OPT_CHAR_QSTR_CACHE
+    // single ASCII characters are common (s[i], chr(), iteration) and their
+    // qstrs never change, so remember them and skip the qstr pool search
+    if (len == 1 && (byte)data[0] < 0x80) {
+        qstr *slot = &MP_STATE_VM(char_qstr_cache)[(byte)data[0]];
+        if (*slot == MP_QSTRnull) {
+            *slot = qstr_from_strn(data, 1);
+        }
+        return MP_OBJ_NEW_QSTR(*slot);
+    }
+    #endif
     return MP_OBJ_NEW_QSTR(qstr_from_strn(data, len));
 }
 
@@ -2069,11 +2118,18 @@ mp_obj_t mp_obj_new_str_from_vstr(const mp_obj_type_t *type, vstr_t *vstr) {
         }
     }
 
+    return str_new_from_vstr(type, vstr);
+}
+
+// Like mp_obj_new_str_from_vstr but doesn't check for an existing interned
+// qstr, which requires hashing the whole buffer.  Used for transient results
+// (eg building a string with +=) that are unlikely to have an interned twin.
+STATIC mp_obj_t str_new_from_vstr(const mp_obj_type_t *type, vstr_t *vstr) {
     // make a new str/bytes object
     mp_obj_str_t *o = m_new_obj(mp_obj_str_t);
     o->base.type = type;
     o->len = vstr->len;
-    o->hash = qstr_compute_hash((byte *)vstr->buf, vstr->len);
+    o->hash = 0; // computed lazily, only if the string is hashed
     if (vstr->len + 1 == vstr->alloc) {
         o->data = (byte *)vstr->buf;
     } else {
@@ -34,9 +34,23 @@ typedef struct _mp_obj_str_t {
     // len == number of bytes used in data, alloc = len + 1 because (at the moment) we also append a null byte
     size_t len;
     const byte *data;
+    #if MICROPY_PY_BUILTINS_STR_UNICODE && MICROPY_OPT_STR_INDEX_ANCHOR
+    // the (character index, byte offset) pair resolved by the last index
+    // operation on this string, used as the starting point of the next
+    // utf-8 walk; (0, 0) is always a valid anchor
+    size_t anchor_char;
+    size_t anchor_byte;
+    #endif
 } mp_obj_str_t;
 
-#define MP_DEFINE_STR_OBJ(obj_name, str) mp_obj_str_t obj_name = {{&mp_type_str}, 0, sizeof(str) - 1, (const byte *)str}
+// initializer for the anchor fields, for statically defined string objects
+#if MICROPY_PY_BUILTINS_STR_UNICODE && MICROPY_OPT_STR_INDEX_ANCHOR
+#define MP_OBJ_STR_ANCHOR_INIT , 0, 0
+#else
+#define MP_OBJ_STR_ANCHOR_INIT
+#endif
+
+#define MP_DEFINE_STR_OBJ(obj_name, str) mp_obj_str_t obj_name = {{&mp_type_str}, 0, sizeof(str) - 1, (const byte *)str MP_OBJ_STR_ANCHOR_INIT}
 
 // use this macro to extract the string hash
 // warning: the hash can be 0, meaning invalid, and must then be explicitly computed from the data
@@ -62,6 +76,7 @@ const byte *mp_obj_str_get_data_no_check(mp_obj_t self_in, size_t *len);
 #endif
 
 mp_obj_t mp_obj_str_make_new(const mp_obj_type_t *type_in, size_t n_args, size_t n_kw, const mp_obj_t *args);
+void mp_str_print_quoted(const mp_print_t *print, const byte *str_data, size_t str_len, bool is_bytes);
 void mp_str_print_json(const mp_print_t *print, const byte *str_data, size_t str_len);
 mp_obj_t mp_obj_str_format(size_t n_args, const mp_obj_t *args, mp_map_t *kwargs);
 mp_obj_t mp_obj_str_split(size_t n_args, const mp_obj_t *args);
@@ -31,6 +31,9 @@
 #include "py/objstr.h"
 #include "py/objlist.h"
 #include "py/runtime.h"
+#if MICROPY_OPT_STR_INDEX_ANCHOR
+#include "py/gc.h"
+#endif
 
 #if MICROPY_PY_BUILTINS_STR_UNICODE
 
@@ -174,6 +177,71 @@ const byte *str_index_to_ptr(const mp_obj_type_t *type, const byte *self_data, s
     return s;
 }
 
+#if MICROPY_OPT_STR_INDEX_ANCHOR
+
+// Only strings at least this long use the index anchor; walking a shorter
+// string from one of its ends is already cheap.
+#define STR_INDEX_ANCHOR_MIN_LEN (64)
+
+// Like str_index_to_ptr, but starts the utf-8 walk from the (character
+// index, byte offset) anchor stored in the string object by a previous
+// lookup, and stores the new position back.  Falls back to the plain walk
+// for negative indices and for strings that can't hold an anchor (qstrs,
+// strings in ROM, short strings).
+STATIC const byte *str_index_to_ptr_anchored(mp_obj_t self_in, const byte *self_data, size_t self_len, mp_obj_t index) {
+    mp_int_t i;
+    if (self_len < STR_INDEX_ANCHOR_MIN_LEN
+        || mp_obj_is_qstr(self_in)
+        || !mp_obj_is_small_int(index)
+        || (i = MP_OBJ_SMALL_INT_VALUE(index)) < 0) {
+        return str_index_to_ptr(&mp_type_str, self_data, self_len, index, false);
+    }
+    mp_obj_str_t *self = MP_OBJ_TO_PTR(self_in);
+    if (gc_nbytes(self) == 0) {
+        // the string object lives in ROM so the anchor can't be stored
+        return str_index_to_ptr(&mp_type_str, self_data, self_len, index, false);
+    }
+    const byte *s;
+    const byte *top = self_data + self_len;
+    size_t anchor_char = self->anchor_char;
+    if ((size_t)i < anchor_char && anchor_char - (size_t)i < (size_t)i) {
+        // target is behind the anchor but closer to it than to the start
+        s = self_data + self->anchor_byte;
+        for (size_t n = anchor_char - (size_t)i; n; --n) {
+            do {
+                --s;
+            } while (UTF8_IS_CONT(*s));
+        }
+    } else {
+        // walk forwards, from the anchor when it isn't past the target
+        size_t n;
+        if ((size_t)i >= anchor_char) {
+            s = self_data + self->anchor_byte;
+            n = (size_t)i - anchor_char;
+        } else {
+            s = self_data;
+            n = (size_t)i;
+        }
+        for (;;) {
+            if (s >= top) {
+                mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("string index out of range"));
+            }
+            if (n-- == 0) {
+                break;
+            }
+            ++s;
+            while (UTF8_IS_CONT(*s)) {
+                ++s;
+            }
+        }
+    }
+    self->anchor_char = (size_t)i;
+    self->anchor_byte = s - self_data;
+    return s;
+}
+
+#endif // MICROPY_OPT_STR_INDEX_ANCHOR
+
 STATIC mp_obj_t str_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
     const mp_obj_type_t *type = mp_obj_get_type(self_in);
     assert(type == &mp_type_str);
@@ -211,7 +279,11 @@ STATIC mp_obj_t str_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value) {
             return mp_obj_new_str_of_type(type, (const byte *)pstart, pstop - pstart);
         }
         #endif
+        #if MICROPY_OPT_STR_INDEX_ANCHOR
+        const byte *s = str_index_to_ptr_anchored(self_in, self_data, self_len, index);
+        #else
         const byte *s = str_index_to_ptr(type, self_data, self_len, index, false);
+        #endif
         int len = 1;
         if (UTF8_IS_NONASCII(*s)) {
             // Count the number of 1 bits (after the first)
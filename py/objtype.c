@@ -101,7 +101,11 @@ mp_obj_instance_t *mp_obj_new_instance(const mp_obj_type_t *class, const mp_obj_
     assert(num_native_bases < 2);
     mp_obj_instance_t *o = m_new_obj_var(mp_obj_instance_t, mp_obj_t, num_native_bases);
     o->base.type = class;
+    #if MICROPY_PY_SLOTS
+    mp_map_init(&o->members, class->n_slots);
+    #else
     mp_map_init(&o->members, 0);
+    #endif
     // Initialise the native base-class slot (should be 1 at most) with a valid
     // object.  It doesn't matter which object, so long as it can be uniquely
     // distinguished from a native class that is initialised.
@@ -133,9 +137,52 @@ struct class_lookup_data {
     bool is_type;
 };
 
+#if MICROPY_OPT_MRO_CACHE
+// Invalidate all cached class attribute lookups.  Called whenever a class
+// attribute is stored or deleted, and when a new class is created (the new
+// class may reuse the heap address of a collected one).
+STATIC void mp_obj_class_lookup_cache_invalidate(void) {
+    MP_STATE_VM(mro_cache_epoch)++;
+}
+#endif
+
 STATIC void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_type_t *type) {
     assert(lookup->dest[0] == MP_OBJ_NULL);
     assert(lookup->dest[1] == MP_OBJ_NULL);
+    #if MICROPY_OPT_MRO_CACHE
+    // Probe the global lookup cache.  Lookups which can match a native
+    // special-method slot bypass the cache, as their result is not a
+    // locals-dict value.
+    mp_mro_cache_entry_t *cache_entry = NULL;
+    const mp_obj_type_t *cache_key_type = type;
+    bool cacheable = lookup->meth_offset == 0;
+    bool neg_cacheable = cacheable;
+    if (cacheable) {
+        cache_entry = &MP_STATE_VM(mro_cache)[((uintptr_t)type >> 4 ^ lookup->attr) & (MICROPY_OPT_MRO_CACHE_SIZE - 1)];
+        if (cache_entry->type == type && cache_entry->attr == lookup->attr
+            && cache_entry->epoch == MP_STATE_VM(mro_cache_epoch)) {
+            const mp_obj_type_t *def_type = cache_entry->def_type;
+            if (def_type == NULL) {
+                // cached negative result: attribute not found anywhere
+                return;
+            }
+            // Reproduce the conversion done on a locals-dict hit below.
+            if (lookup->is_type) {
+                mp_convert_member_lookup(MP_OBJ_NULL, (const mp_obj_type_t *)lookup->obj, cache_entry->value, lookup->dest);
+            } else {
+                mp_obj_instance_t *obj = lookup->obj;
+                mp_obj_t obj_obj;
+                if (obj != NULL && mp_obj_is_native_type(def_type) && def_type != &mp_type_object /* object is not a real type */) {
+                    obj_obj = obj->subobj[0];
+                } else {
+                    obj_obj = MP_OBJ_FROM_PTR(obj);
+                }
+                mp_convert_member_lookup(obj_obj, def_type, cache_entry->value, lookup->dest);
+            }
+            return;
+        }
+    }
+    #endif
     for (;;) {
         DEBUG_printf("mp_obj_class_lookup: Looking up %s in %s\n", qstr_str(lookup->attr), qstr_str(type->name));
         // Optimize special method lookup for native types
@@ -157,6 +204,15 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
             mp_map_t *locals_map = &type->locals_dict->map;
             mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(lookup->attr), MP_MAP_LOOKUP);
             if (elem != NULL) {
+                #if MICROPY_OPT_MRO_CACHE
+                if (cacheable) {
+                    cache_entry->type = cache_key_type;
+                    cache_entry->attr = lookup->attr;
+                    cache_entry->def_type = type;
+                    cache_entry->value = elem->value;
+                    cache_entry->epoch = MP_STATE_VM(mro_cache_epoch);
+                }
+                #endif
                 if (lookup->is_type) {
                     // If we look up a class method, we need to return original type for which we
                     // do a lookup, not a (base) type in which we found the class method.
@@ -190,6 +246,11 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
         // but some attributes of native types may be handled using .load_attr method,
         // so make sure we try to lookup those too.
         if (lookup->obj != NULL && !lookup->is_type && mp_obj_is_native_type(type) && type != &mp_type_object /* object is not a real type */) {
+            #if MICROPY_OPT_MRO_CACHE
+            // the outcome of this probe depends on the instance, not just the
+            // type, so a miss from here on cannot be cached
+            neg_cacheable = false;
+            #endif
             mp_load_method_maybe(lookup->obj->subobj[0], lookup->attr, lookup->dest);
             if (lookup->dest[0] != MP_OBJ_NULL) {
                 return;
@@ -200,9 +261,23 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
 
         if (type->parent == NULL) {
             DEBUG_printf("mp_obj_class_lookup: No more parents\n");
+            #if MICROPY_OPT_MRO_CACHE
+            if (neg_cacheable) {
+                cache_entry->type = cache_key_type;
+                cache_entry->attr = lookup->attr;
+                cache_entry->def_type = NULL;
+                cache_entry->value = MP_OBJ_NULL;
+                cache_entry->epoch = MP_STATE_VM(mro_cache_epoch);
+            }
+            #endif
             return;
         #if MICROPY_MULTIPLE_INHERITANCE
         } else if (((mp_obj_base_t *)type->parent)->type == &mp_type_tuple) {
+            #if MICROPY_OPT_MRO_CACHE
+            // results of the recursive calls below aren't tracked here, so a
+            // miss across multiple bases cannot be cached
+            neg_cacheable = false;
+            #endif
             const mp_obj_tuple_t *parent_tuple = type->parent;
             const mp_obj_t *item = parent_tuple->items;
             const mp_obj_t *top = item + parent_tuple->len - 1;
@@ -228,6 +303,15 @@ STATIC void mp_obj_class_lookup(struct class_lookup_data *lookup, const mp_obj_t
         }
         if (type == &mp_type_object) {
             // Not a "real" type
+            #if MICROPY_OPT_MRO_CACHE
+            if (neg_cacheable) {
+                cache_entry->type = cache_key_type;
+                cache_entry->attr = lookup->attr;
+                cache_entry->def_type = NULL;
+                cache_entry->value = MP_OBJ_NULL;
+                cache_entry->epoch = MP_STATE_VM(mro_cache_epoch);
+            }
+            #endif
             return;
         }
     }
@@ -591,6 +675,9 @@ STATIC void mp_obj_instance_load_attr(mp_obj_t self_in, qstr attr, mp_obj_t *des
         // This creates, unlike CPython, a read-only __dict__ that can't be modified.
         mp_obj_dict_t dict;
         dict.base.type = &mp_type_dict;
+        #if MICROPY_PY_THREAD_SAFE_CONTAINERS
+        mp_thread_mutex_init(&dict.mutex);
+        #endif
         dict.map = self->members;
         dest[0] = mp_obj_dict_copy(MP_OBJ_FROM_PTR(&dict));
         mp_obj_dict_t *dest_dict = MP_OBJ_TO_PTR(dest[0]);
@@ -1062,6 +1149,10 @@ STATIC void type_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
                 // can't apply delete/store to a fixed map
                 return;
             }
+            #if MICROPY_OPT_MRO_CACHE
+            // this class and any subclass may have cached this attribute
+            mp_obj_class_lookup_cache_invalidate();
+            #endif
             if (dest[1] == MP_OBJ_NULL) {
                 // delete attribute
                 mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP_REMOVE_IF_FOUND);
@@ -1141,6 +1232,10 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
     }
 
     mp_obj_type_t *o = m_new0(mp_obj_type_t, 1);
+    #if MICROPY_OPT_MRO_CACHE
+    // this allocation may reuse the address of a collected class
+    mp_obj_class_lookup_cache_invalidate();
+    #endif
     o->base.type = &mp_type_type;
     o->flags = base_flags;
     o->name = name;
@@ -1175,6 +1270,29 @@ mp_obj_t mp_obj_new_type(qstr name, mp_obj_t bases_tuple, mp_obj_t locals_dict)
 
     o->locals_dict = MP_OBJ_TO_PTR(locals_dict);
 
+    #if MICROPY_PY_SLOTS
+    // Resolve __slots__ once, at class creation: count the declared names
+    // (plus any inherited from a single instance base) so instances can
+    // pre-size their members map with one exactly-sized allocation.
+    size_t n_slots = 0;
+    if (bases_len == 1 && mp_obj_is_instance_type((const mp_obj_type_t *)o->parent)) {
+        n_slots = ((const mp_obj_type_t *)o->parent)->n_slots;
+    }
+    mp_map_elem_t *slots_elem = mp_map_lookup(&o->locals_dict->map, MP_OBJ_NEW_QSTR(MP_QSTR___slots__), MP_MAP_LOOKUP);
+    if (slots_elem != NULL) {
+        if (mp_obj_is_str(slots_elem->value)) {
+            // a bare string declares a single slot
+            n_slots += 1;
+        } else {
+            size_t slots_len;
+            mp_obj_t *slots_items;
+            mp_obj_get_array(slots_elem->value, &slots_len, &slots_items);
+            n_slots += slots_len;
+        }
+    }
+    o->n_slots = MIN(n_slots, UINT16_MAX);
+    #endif
+
     #if ENABLE_SPECIAL_ACCESSORS
     // Check if the class has any special accessor methods
     if (!(o->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS)) {
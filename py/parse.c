@@ -214,15 +214,6 @@ typedef struct _rule_stack_t {
     size_t arg_i; // this dictates the maximum nodes in a "list" of things
 } rule_stack_t;
 
-typedef struct _mp_parse_chunk_t {
-    size_t alloc;
-    union {
-        size_t used;
-        struct _mp_parse_chunk_t *next;
-    } union_;
-    byte data[];
-} mp_parse_chunk_t;
-
 typedef struct _parser_t {
     size_t rule_stack_alloc;
     size_t rule_stack_top;
@@ -235,11 +226,23 @@ typedef struct _parser_t {
     mp_lexer_t *lexer;
 
     mp_parse_tree_t tree;
-    mp_parse_chunk_t *cur_chunk;
+    m_arena_t arena;
 
     #if MICROPY_COMP_CONST
     mp_map_t consts;
     #endif
+
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    // dedup maps for folded constants, one per type so that lookups never
+    // compare across types or through value equality; see make_node_const_object
+    mp_map_t const_floats; // keyed by the float's bit pattern as an int
+    mp_map_t const_strs;
+    #endif
+
+    #if MICROPY_OPT_PARSE_RULE_FIRST_SET
+    // bitmap of which tokens each rule can start with; see rule_first_sets_init
+    uint8_t *rule_first_sets;
+    #endif
 } parser_t;
 
 STATIC const uint16_t *get_rule_arg(uint8_t r_id) {
@@ -250,45 +253,73 @@ STATIC const uint16_t *get_rule_arg(uint8_t r_id) {
     return &rule_arg_combined_table[off];
 }
 
-STATIC void *parser_alloc(parser_t *parser, size_t num_bytes) {
-    // use a custom memory allocator to store parse nodes sequentially in large chunks
-
-    mp_parse_chunk_t *chunk = parser->cur_chunk;
-
-    if (chunk != NULL && chunk->union_.used + num_bytes > chunk->alloc) {
-        // not enough room at end of previously allocated chunk so try to grow
-        mp_parse_chunk_t *new_data = (mp_parse_chunk_t *)m_renew_maybe(byte, chunk,
-            sizeof(mp_parse_chunk_t) + chunk->alloc,
-            sizeof(mp_parse_chunk_t) + chunk->alloc + num_bytes, false);
-        if (new_data == NULL) {
-            // could not grow existing memory; shrink it to fit previous
-            (void)m_renew_maybe(byte, chunk, sizeof(mp_parse_chunk_t) + chunk->alloc,
-                sizeof(mp_parse_chunk_t) + chunk->union_.used, false);
-            chunk->alloc = chunk->union_.used;
-            chunk->union_.next = parser->tree.chunk;
-            parser->tree.chunk = chunk;
-            chunk = NULL;
-        } else {
-            // could grow existing memory
-            chunk->alloc += num_bytes;
-        }
-    }
+#if MICROPY_OPT_PARSE_RULE_FIRST_SET
+
+#define RULE_FIRST_SET_NUM_RULES (MP_ARRAY_SIZE(rule_act_table))
+#define RULE_FIRST_SET_LEN ((MP_TOKEN_NUMBER_OF + 7) / 8)
+
+STATIC bool rule_can_start_with_token(parser_t *parser, uint8_t rule_id, mp_token_kind_t tok_kind) {
+    const uint8_t *set = &parser->rule_first_sets[rule_id * RULE_FIRST_SET_LEN];
+    return set[tok_kind >> 3] & (1 << (tok_kind & 7));
+}
 
-    if (chunk == NULL) {
-        // no previous chunk, allocate a new chunk
-        size_t alloc = MICROPY_ALLOC_PARSE_CHUNK_INIT;
-        if (alloc < num_bytes) {
-            alloc = num_bytes;
+// Compute, for every rule, the set of tokens the rule can start with, by
+// iterating to a fixed point: an or-rule can start with whatever any of its
+// alternatives can start with, and the other rule kinds with whatever their
+// first argument can start with.  The only rule whose first argument is
+// optional is the top-level file_input, which never appears as an or-rule
+// alternative, so it is conservatively given the full token set.
+STATIC void rule_first_sets_init(parser_t *parser) {
+    parser->rule_first_sets = m_new0(uint8_t, RULE_FIRST_SET_NUM_RULES * RULE_FIRST_SET_LEN);
+    bool changed;
+    do {
+        changed = false;
+        for (size_t r = 0; r < RULE_FIRST_SET_NUM_RULES; r++) {
+            uint8_t act = rule_act_table[r];
+            size_t n = act & RULE_ACT_ARG_MASK;
+            if (n == 0) {
+                // RULE_const_object; not part of the grammar
+                continue;
+            }
+            uint8_t *set = &parser->rule_first_sets[r * RULE_FIRST_SET_LEN];
+            const uint16_t *rule_arg = get_rule_arg(r);
+            size_t n_consider = (act & RULE_ACT_KIND_MASK) == RULE_ACT_OR ? n : 1;
+            for (size_t i = 0; i < n_consider; i++) {
+                uint16_t kind = rule_arg[i] & RULE_ARG_KIND_MASK;
+                if (kind == RULE_ARG_TOK) {
+                    size_t tok = rule_arg[i] & RULE_ARG_ARG_MASK;
+                    if (!(set[tok >> 3] & (1 << (tok & 7)))) {
+                        set[tok >> 3] |= 1 << (tok & 7);
+                        changed = true;
+                    }
+                } else if (kind == RULE_ARG_RULE) {
+                    const uint8_t *child = &parser->rule_first_sets[(rule_arg[i] & RULE_ARG_ARG_MASK) * RULE_FIRST_SET_LEN];
+                    for (size_t b = 0; b < RULE_FIRST_SET_LEN; b++) {
+                        if (child[b] & ~set[b]) {
+                            set[b] |= child[b];
+                            changed = true;
+                        }
+                    }
+                } else {
+                    // rule starts with an optional rule; it can start with anything
+                    for (size_t b = 0; b < RULE_FIRST_SET_LEN; b++) {
+                        if (set[b] != 0xff) {
+                            set[b] = 0xff;
+                            changed = true;
+                        }
+                    }
+                }
+            }
         }
-        chunk = (mp_parse_chunk_t *)m_new(byte, sizeof(mp_parse_chunk_t) + alloc);
-        chunk->alloc = alloc;
-        chunk->union_.used = 0;
-        parser->cur_chunk = chunk;
-    }
+    } while (changed);
+}
 
-    byte *ret = chunk->data + chunk->union_.used;
-    chunk->union_.used += num_bytes;
-    return ret;
+#endif // MICROPY_OPT_PARSE_RULE_FIRST_SET
+
+STATIC void *parser_alloc(parser_t *parser, size_t num_bytes) {
+    // parse nodes are stored sequentially in large chunks and are freed
+    // wholesale via mp_parse_tree_clear
+    return m_arena_alloc(&parser->arena, num_bytes);
 }
 
 STATIC void push_rule(parser_t *parser, size_t src_line, uint8_t rule_id, size_t arg_i) {
@@ -367,7 +398,7 @@ size_t mp_parse_node_extract_list(mp_parse_node_t *pn, size_t pn_kind, mp_parse_
 #if MICROPY_DEBUG_PRINTERS
 void mp_parse_node_print(const mp_print_t *print, mp_parse_node_t pn, size_t indent) {
     if (MP_PARSE_NODE_IS_STRUCT(pn)) {
-        mp_printf(print, "[% 4d] ", (int)((mp_parse_node_struct_t *)pn)->source_line);
+        mp_printf(print, "[% 4d] ", (int)MP_PARSE_NODE_STRUCT_SOURCE_LINE((mp_parse_node_struct_t *)pn));
     } else {
         mp_printf(print, "       ");
     }
@@ -449,8 +480,37 @@ STATIC void push_result_node(parser_t *parser, mp_parse_node_t pn) {
 }
 
 STATIC mp_parse_node_t make_node_const_object(parser_t *parser, size_t src_line, mp_obj_t obj) {
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    // Share one heap object between equal float/str constants in this module.
+    // Each type has its own map so a lookup can never go through cross-type
+    // equality (which would alias constants that merely compare equal), and
+    // floats are keyed by bit pattern so that -0.0 stays distinct from 0.0.
+    // Bytes constants are never shared: equal bytes literals must stay
+    // distinct objects because they can be mutated in place via
+    // uctypes.addressof (see tests/extmod/uctypes_32bit_intbig.py).
+    mp_map_t *dedup_map = NULL;
+    mp_obj_t key = obj;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (mp_obj_is_float(obj)) {
+        mp_float_union_t fb = {.f = mp_obj_float_get(obj)};
+        key = mp_obj_new_int_from_ull(fb.i);
+        dedup_map = &parser->const_floats;
+    } else
+    #endif
+    if (mp_obj_is_str(obj)) {
+        dedup_map = &parser->const_strs;
+    }
+    if (dedup_map != NULL) {
+        mp_map_elem_t *elem = mp_map_lookup(dedup_map, key, MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        if (elem->value == MP_OBJ_NULL) {
+            elem->value = obj;
+        } else {
+            obj = elem->value;
+        }
+    }
+    #endif
     mp_parse_node_struct_t *pn = parser_alloc(parser, sizeof(mp_parse_node_struct_t) + sizeof(mp_obj_t));
-    pn->source_line = src_line;
+    MP_PARSE_NODE_STRUCT_SET_SOURCE_LINE(pn, src_line);
     #if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D
     // nodes are 32-bit pointers, but need to store 64-bit object
     pn->kind_num_nodes = RULE_const_object | (2 << 8);
@@ -720,7 +780,7 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                     mp_obj_t exc = mp_obj_new_exception_msg(&mp_type_SyntaxError,
                         MP_ERROR_TEXT("constant must be an integer"));
                     mp_obj_exception_add_traceback(exc, parser->lexer->source_name,
-                        ((mp_parse_node_struct_t *)pn1)->source_line, MP_QSTRnull);
+                        MP_PARSE_NODE_STRUCT_SOURCE_LINE((mp_parse_node_struct_t *)pn1), MP_QSTRnull);
                     nlr_raise(exc);
                 }
 
@@ -769,9 +829,21 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
         }
         mp_obj_t dest[2];
         mp_load_method_maybe(elem->value, q_attr, dest);
-        if (!(dest[0] != MP_OBJ_NULL && mp_obj_is_int(dest[0]) && dest[1] == MP_OBJ_NULL)) {
+        if (!(dest[0] != MP_OBJ_NULL && dest[1] == MP_OBJ_NULL
+              && (mp_obj_is_int(dest[0]) || mp_obj_is_bool(dest[0])))) {
             return false;
         }
+        if (mp_obj_is_bool(dest[0])) {
+            // Replace with a True/False token node rather than a const object,
+            // so the compiler's constant-condition handling eliminates
+            // "if CONFIG.FEATURE:" blocks from the emitted bytecode.
+            for (size_t i = num_args; i > 0; i--) {
+                pop_result(parser);
+            }
+            push_result_node(parser, mp_parse_node_new_leaf(MP_PARSE_NODE_TOKEN,
+                mp_obj_is_true(dest[0]) ? MP_TOKEN_KW_TRUE : MP_TOKEN_KW_FALSE));
+            return true;
+        }
         arg0 = dest[0];
     #endif
 
@@ -793,6 +865,119 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
 
     return true;
 }
+
+#if MICROPY_COMP_CONST_FOLDING_EXTRA
+// like mp_parse_node_get_int_maybe, but also extracts float, str and bytes constants
+STATIC bool parse_node_get_const_maybe(mp_parse_node_t pn, mp_obj_t *o) {
+    if (MP_PARSE_NODE_IS_SMALL_INT(pn)) {
+        *o = MP_OBJ_NEW_SMALL_INT(MP_PARSE_NODE_LEAF_SMALL_INT(pn));
+        return true;
+    } else if (MP_PARSE_NODE_IS_LEAF(pn) && MP_PARSE_NODE_LEAF_KIND(pn) == MP_PARSE_NODE_STRING) {
+        *o = MP_OBJ_NEW_QSTR(MP_PARSE_NODE_LEAF_ARG(pn));
+        return true;
+    } else if (MP_PARSE_NODE_IS_LEAF(pn) && MP_PARSE_NODE_LEAF_KIND(pn) == MP_PARSE_NODE_BYTES) {
+        size_t len;
+        const byte *data = qstr_data(MP_PARSE_NODE_LEAF_ARG(pn), &len);
+        *o = mp_obj_new_bytes(data, len);
+        return true;
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_const_object)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+        #if MICROPY_OBJ_REPR == MICROPY_OBJ_REPR_D
+        // nodes are 32-bit pointers, but need to extract 64-bit object
+        *o = (uint64_t)pns->nodes[0] | ((uint64_t)pns->nodes[1] << 32);
+        #else
+        *o = (mp_obj_t)pns->nodes[0];
+        #endif
+        return mp_obj_is_int(*o) || mp_obj_is_float(*o) || mp_obj_is_str_or_bytes(*o);
+    } else {
+        return false;
+    }
+}
+
+// this code extends fold_constants to float arithmetic and string/bytes
+// concatenation; it runs only when fold_constants did not fold the rule
+STATIC bool fold_constants_extra(parser_t *parser, uint8_t rule_id, size_t num_args) {
+    mp_obj_t arg0;
+    if (rule_id == RULE_arith_expr || rule_id == RULE_term) {
+        // folding for binary ops: + - * /
+        mp_parse_node_t pn = peek_result(parser, num_args - 1);
+        if (!parse_node_get_const_maybe(pn, &arg0)) {
+            return false;
+        }
+        for (ssize_t i = num_args - 2; i >= 1; i -= 2) {
+            mp_obj_t arg1;
+            if (!parse_node_get_const_maybe(peek_result(parser, i - 1), &arg1)) {
+                return false;
+            }
+            mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(peek_result(parser, i));
+            if (mp_obj_is_str_or_bytes(arg0)) {
+                // only + of two strings of the same type can fold
+                if (tok != MP_TOKEN_OP_PLUS || mp_obj_get_type(arg1) != mp_obj_get_type(arg0)) {
+                    return false;
+                }
+            #if MICROPY_PY_BUILTINS_FLOAT
+            } else if (tok == MP_TOKEN_OP_PLUS || tok == MP_TOKEN_OP_MINUS
+                       || tok == MP_TOKEN_OP_STAR || tok == MP_TOKEN_OP_SLASH) {
+                if (mp_obj_is_str_or_bytes(arg1)) {
+                    // number op string; leave the TypeError to be raised at runtime
+                    return false;
+                }
+                if (tok == MP_TOKEN_OP_SLASH && mp_obj_get_float(arg1) == 0) {
+                    // leave division by zero to be raised at runtime
+                    return false;
+                }
+            #endif
+            } else {
+                return false;
+            }
+            arg0 = mp_binary_op(MP_BINARY_OP_LSHIFT + (tok - MP_TOKEN_OP_DBL_LESS), arg0, arg1);
+        }
+
+    #if MICROPY_PY_BUILTINS_FLOAT
+    } else if (rule_id == RULE_factor_2) {
+        // folding for unary ops + - applied to a float
+        mp_parse_node_t pn = peek_result(parser, 0);
+        if (!parse_node_get_const_maybe(pn, &arg0) || !mp_obj_is_float(arg0)) {
+            return false;
+        }
+        mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(peek_result(parser, 1));
+        if (tok != MP_TOKEN_OP_PLUS && tok != MP_TOKEN_OP_MINUS) {
+            return false;
+        }
+        arg0 = mp_unary_op(MP_UNARY_OP_POSITIVE + (tok - MP_TOKEN_OP_PLUS), arg0);
+    #endif
+
+    } else {
+        return false;
+    }
+
+    // success folding this rule
+
+    for (size_t i = num_args; i > 0; i--) {
+        pop_result(parser);
+    }
+    if (mp_obj_is_small_int(arg0)) {
+        push_result_node(parser, mp_parse_node_new_small_int_checked(parser, arg0));
+    } else if (mp_obj_is_str_or_bytes(arg0)) {
+        // intern short results, following the same rule as push_result_token
+        size_t len;
+        const char *data = mp_obj_str_get_data(arg0, &len);
+        qstr qst = len <= MICROPY_ALLOC_PARSE_INTERN_STRING_LEN
+            ? qstr_from_strn(data, len)
+            : qstr_find_strn(data, len);
+        if (qst != MP_QSTRnull) {
+            push_result_node(parser, mp_parse_node_new_leaf(
+                mp_obj_is_str(arg0) ? MP_PARSE_NODE_STRING : MP_PARSE_NODE_BYTES, qst));
+        } else {
+            push_result_node(parser, make_node_const_object(parser, 0, arg0));
+        }
+    } else {
+        push_result_node(parser, make_node_const_object(parser, 0, arg0));
+    }
+
+    return true;
+}
+#endif
 #endif
 
 STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id, size_t num_args) {
@@ -819,10 +1004,16 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
         // we folded this rule so return straight away
         return;
     }
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    if (fold_constants_extra(parser, rule_id, num_args)) {
+        // we folded this rule so return straight away
+        return;
+    }
+    #endif
     #endif
 
     mp_parse_node_struct_t *pn = parser_alloc(parser, sizeof(mp_parse_node_struct_t) + sizeof(mp_parse_node_t) * num_args);
-    pn->source_line = src_line;
+    MP_PARSE_NODE_STRUCT_SET_SOURCE_LINE(pn, src_line);
     pn->kind_num_nodes = (rule_id & 0xff) | (num_args << 8);
     for (size_t i = num_args; i > 0; i--) {
         pn->nodes[i - 1] = pop_result(parser);
@@ -847,12 +1038,21 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     parser.lexer = lex;
 
     parser.tree.chunk = NULL;
-    parser.cur_chunk = NULL;
+    m_arena_init(&parser.arena, MICROPY_ALLOC_PARSE_CHUNK_INIT);
 
     #if MICROPY_COMP_CONST
     mp_map_init(&parser.consts, 0);
     #endif
 
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    mp_map_init(&parser.const_floats, 0);
+    mp_map_init(&parser.const_strs, 0);
+    #endif
+
+    #if MICROPY_OPT_PARSE_RULE_FIRST_SET
+    rule_first_sets_init(&parser);
+    #endif
+
     // work out the top-level rule to use, and push it on the stack
     size_t top_level_rule;
     switch (input_kind) {
@@ -911,6 +1111,13 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
                         }
                     } else {
                         assert(kind == RULE_ARG_RULE);
+                        #if MICROPY_OPT_PARSE_RULE_FIRST_SET
+                        if (!rule_can_start_with_token(&parser, rule_arg[i] & RULE_ARG_ARG_MASK, lex->tok_kind)) {
+                            // this alternative cannot match the current token,
+                            // so don't bother descending into it
+                            continue;
+                        }
+                        #endif
                         if (i + 1 < n) {
                             push_rule(&parser, rule_src_line, rule_id, i + 1); // save this or-rule
                         }
@@ -1129,16 +1336,17 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     mp_map_deinit(&parser.consts);
     #endif
 
-    // truncate final chunk and link into chain of chunks
-    if (parser.cur_chunk != NULL) {
-        (void)m_renew_maybe(byte, parser.cur_chunk,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->alloc,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->union_.used,
-            false);
-        parser.cur_chunk->alloc = parser.cur_chunk->union_.used;
-        parser.cur_chunk->union_.next = parser.tree.chunk;
-        parser.tree.chunk = parser.cur_chunk;
-    }
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    mp_map_deinit(&parser.const_floats);
+    mp_map_deinit(&parser.const_strs);
+    #endif
+
+    #if MICROPY_OPT_PARSE_RULE_FIRST_SET
+    m_del(uint8_t, parser.rule_first_sets, RULE_FIRST_SET_NUM_RULES * RULE_FIRST_SET_LEN);
+    #endif
+
+    // truncate final chunk and take ownership of the chain of chunks
+    parser.tree.chunk = m_arena_finish(&parser.arena);
 
     if (
         lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
@@ -1177,12 +1385,7 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
 }
 
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
-    mp_parse_chunk_t *chunk = tree->chunk;
-    while (chunk != NULL) {
-        mp_parse_chunk_t *next = chunk->union_.next;
-        m_del(byte, chunk, sizeof(mp_parse_chunk_t) + chunk->alloc);
-        chunk = next;
-    }
+    m_arena_chunk_free_all(tree->chunk);
 }
 
 #endif // MICROPY_ENABLE_COMPILER
@@ -52,11 +52,23 @@ struct _mp_lexer_t;
 typedef uintptr_t mp_parse_node_t; // must be pointer size
 
 typedef struct _mp_parse_node_struct_t {
+    #if MICROPY_PARSE_NODE_SOURCE_LINE
     uint32_t source_line;       // line number in source file
+    #endif
     uint32_t kind_num_nodes;    // parse node kind, and number of nodes
     mp_parse_node_t nodes[];    // nodes
 } mp_parse_node_struct_t;
 
+// Accessors for the source line of a struct node; when the field is compiled
+// out (to lower peak memory during compile) the line reads back as 0.
+#if MICROPY_PARSE_NODE_SOURCE_LINE
+#define MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns) ((pns)->source_line)
+#define MP_PARSE_NODE_STRUCT_SET_SOURCE_LINE(pns, line) ((pns)->source_line = (line))
+#else
+#define MP_PARSE_NODE_STRUCT_SOURCE_LINE(pns) (0)
+#define MP_PARSE_NODE_STRUCT_SET_SOURCE_LINE(pns, line) ((void)(pns), (void)(line))
+#endif
+
 // macros for mp_parse_node_t usage
 // some of these evaluate their argument more than once
 
@@ -96,7 +108,7 @@ typedef enum {
 
 typedef struct _mp_parse_t {
     mp_parse_node_t root;
-    struct _mp_parse_chunk_t *chunk;
+    struct _m_arena_chunk_t *chunk;
 } mp_parse_tree_t;
 
 // the parser will raise an exception if an error occurred
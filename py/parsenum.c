@@ -78,6 +78,18 @@ mp_obj_t mp_parse_num_integer(const char *restrict str_, size_t len, int base, m
     // string should be an integer number
     mp_int_t int_val = 0;
     const byte *restrict str_val_start = str;
+
+    if (base == 10) {
+        // Fast path for decimal digits: as long as the accumulated value stays
+        // below this constant bound it cannot overflow a small int, so the
+        // call to mp_small_int_mul_overflow per digit is not needed.
+        while (str < top && (mp_uint_t)(*str - '0') <= 9
+               && int_val <= (MP_SMALL_INT_MAX - 9) / 10) {
+            int_val = int_val * 10 + (*str - '0');
+            str++;
+        }
+    }
+
     for (; str < top; str++) {
         // get next digit as a value
         mp_uint_t dig = *str;
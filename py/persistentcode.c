@@ -152,6 +152,14 @@ STATIC size_t read_uint(mp_reader_t *reader, byte **out);
 
 #if MICROPY_EMIT_MACHINE_CODE
 
+// Whether to try to execute native text in place from the buffer holding the
+// .mpy (not possible on ports that must commit text to a special region)
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP && !defined(MP_PLAT_COMMIT_EXEC)
+#define NATIVE_CODE_XIP (1)
+#else
+#define NATIVE_CODE_XIP (0)
+#endif
+
 typedef struct _reloc_info_t {
     mp_reader_t *reader;
     mp_uint_t *const_table;
@@ -235,6 +243,16 @@ void mp_native_relocate(void *ri_in, uint8_t *text, uintptr_t reloc_text) {
     }
 }
 
+#if NATIVE_CODE_XIP
+STATIC uint8_t *copy_fun_data(const uint8_t *fun_data, size_t fun_data_len) {
+    uint8_t *copy;
+    size_t fun_alloc;
+    MP_PLAT_ALLOC_EXEC(fun_data_len, (void **)&copy, &fun_alloc);
+    memcpy(copy, fun_data, fun_data_len);
+    return copy;
+}
+#endif
+
 #endif
 
 STATIC int read_byte(mp_reader_t *reader) {
@@ -288,12 +306,32 @@ STATIC mp_obj_t load_obj(mp_reader_t *reader) {
         return MP_OBJ_FROM_PTR(&mp_const_ellipsis_obj);
     } else {
         size_t len = read_uint(reader, NULL);
+        if (obj_type == 's' || obj_type == 'b') {
+            // str and bytes objects are stored with a null terminator so that
+            // their data can be referenced in place when the .mpy lives in
+            // directly-addressable memory
+            const mp_obj_type_t *type = obj_type == 's' ? &mp_type_str : &mp_type_bytes;
+            #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+            const byte *data = mp_reader_mem_map(reader, len + 1);
+            if (data != NULL) {
+                mp_obj_str_t *o = m_new_obj(mp_obj_str_t);
+                o->base.type = type;
+                o->len = len;
+                o->hash = qstr_compute_hash(data, len);
+                o->data = data;
+                return MP_OBJ_FROM_PTR(o);
+            }
+            #endif
+            vstr_t vstr;
+            vstr_init_len(&vstr, len);
+            read_bytes(reader, (byte *)vstr.buf, len);
+            read_byte(reader); // skip null terminator
+            return mp_obj_new_str_from_vstr(type, &vstr);
+        }
         vstr_t vstr;
         vstr_init_len(&vstr, len);
         read_bytes(reader, (byte *)vstr.buf, len);
-        if (obj_type == 's' || obj_type == 'b') {
-            return mp_obj_new_str_from_vstr(obj_type == 's' ? &mp_type_str : &mp_type_bytes, &vstr);
-        } else if (obj_type == 'i') {
+        if (obj_type == 'i') {
             return mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
         } else {
             assert(obj_type == 'f' || obj_type == 'c');
@@ -367,6 +405,9 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, qstr_window_t *qw) {
     size_t prelude_offset = 0;
     mp_uint_t type_sig = 0;
     size_t n_qstr_link = 0;
+    #if NATIVE_CODE_XIP
+    bool fun_data_xip = false;
+    #endif
     #endif
 
     if (kind == MP_CODE_BYTECODE) {
@@ -382,14 +423,36 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, qstr_window_t *qw) {
 
     #if MICROPY_EMIT_MACHINE_CODE
     } else {
-        // Allocate memory for native data and load it
-        size_t fun_alloc;
-        MP_PLAT_ALLOC_EXEC(fun_data_len, (void **)&fun_data, &fun_alloc);
-        read_bytes(reader, fun_data, fun_data_len);
+        #if NATIVE_CODE_XIP
+        // For viper and asm code, try to use the text in place directly from
+        // the buffer holding the .mpy (eg memory-mapped flash); this only
+        // sticks if the text turns out to need no load-time patching, see
+        // below.  Full native code always has its prelude qstrs patched so is
+        // always copied.
+        if (kind != MP_CODE_NATIVE_PY) {
+            fun_data = (uint8_t *)mp_reader_mem_map(reader, fun_data_len);
+            fun_data_xip = fun_data != NULL;
+        }
+        if (!fun_data_xip)
+        #endif
+        {
+            // Allocate memory for native data and load it
+            size_t fun_alloc;
+            MP_PLAT_ALLOC_EXEC(fun_data_len, (void **)&fun_data, &fun_alloc);
+            read_bytes(reader, fun_data, fun_data_len);
+        }
 
         if (kind == MP_CODE_NATIVE_PY || kind == MP_CODE_NATIVE_VIPER) {
             // Parse qstr link table and link native code
             n_qstr_link = read_uint(reader, NULL);
+            #if NATIVE_CODE_XIP
+            if (fun_data_xip && n_qstr_link > 0) {
+                // Qstrs must be patched into the text so it can't be used in
+                // place; copy it out into executable RAM
+                fun_data = copy_fun_data(fun_data, fun_data_len);
+                fun_data_xip = false;
+            }
+            #endif
             for (size_t i = 0; i < n_qstr_link; ++i) {
                 size_t off = read_uint(reader, NULL);
                 qstr qst = load_qstr(reader, qw);
@@ -470,8 +533,21 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, qstr_window_t *qw) {
             // Allocate and load rodata if needed
             if (prelude.scope_flags & MP_SCOPE_FLAG_VIPERRODATA) {
                 size_t size = read_uint(reader, NULL);
-                uint8_t *rodata = m_new(uint8_t, size);
-                read_bytes(reader, rodata, size);
+                uint8_t *rodata;
+                #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+                // Read-only data can be used in place when the .mpy lives in
+                // directly-addressable memory, but not if relocations might
+                // patch pointers within it
+                rodata = NULL;
+                if (!(prelude.scope_flags & MP_SCOPE_FLAG_VIPERRELOC)) {
+                    rodata = (uint8_t *)mp_reader_mem_map(reader, size);
+                }
+                if (rodata == NULL)
+                #endif
+                {
+                    rodata = m_new(uint8_t, size);
+                    read_bytes(reader, rodata, size);
+                }
                 *ct++ = (uintptr_t)rodata;
             }
 
@@ -498,7 +574,7 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, qstr_window_t *qw) {
     if (kind == MP_CODE_BYTECODE) {
         // Assign bytecode to raw code object
         mp_emit_glue_assign_bytecode(rc, fun_data,
-            #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS
+            #if MICROPY_PERSISTENT_CODE_SAVE || MICROPY_DEBUG_PRINTERS || MICROPY_OPT_VM_SUPERINSTRUCTIONS
             fun_data_len,
             #endif
             const_table,
@@ -516,6 +592,12 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, qstr_window_t *qw) {
         fun_data = MP_PLAT_COMMIT_EXEC(fun_data, fun_data_len, opt_ri);
         #else
         if (prelude.scope_flags & MP_SCOPE_FLAG_VIPERRELOC) {
+            #if NATIVE_CODE_XIP
+            if (fun_data_xip) {
+                // Relocations must be applied to a RAM copy of the text
+                fun_data = copy_fun_data(fun_data, fun_data_len);
+            }
+            #endif
             #if MICROPY_PERSISTENT_CODE_TRACK_RELOC_CODE
             // If native code needs relocations then it's not guaranteed that a pointer to
             // the head of `buf` (containing the machine code) will be retained for the GC
@@ -638,7 +720,7 @@ STATIC void save_obj(mp_print_t *print, mp_obj_t o) {
         const char *str = mp_obj_str_get_data(o, &len);
         mp_print_bytes(print, &obj_type, 1);
         mp_print_uint(print, len);
-        mp_print_bytes(print, (const byte *)str, len);
+        mp_print_bytes(print, (const byte *)str, len + 1); // +1 to store null terminator
     } else if (MP_OBJ_TO_PTR(o) == &mp_const_ellipsis_obj) {
         byte obj_type = 'e';
         mp_print_bytes(print, &obj_type, 1);
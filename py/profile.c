@@ -570,6 +570,9 @@ STATIC const byte *mp_prof_opcode_decode(const byte *ip, const mp_uint_t *const_
             instruction->qstr_opname = MP_QSTR_LOAD_METHOD;
             instruction->arg = qst;
             instruction->argobj = MP_OBJ_NEW_QSTR(qst);
+            if (MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE) {
+                instruction->argobjex_cache = MP_OBJ_NEW_SMALL_INT(*ip++);
+            }
             break;
 
         case MP_BC_LOAD_SUPER_METHOD:
@@ -980,3 +983,23 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state) {
 #endif // MICROPY_PROF_INSTR_DEBUG_PRINT_ENABLE
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+#if MICROPY_CPU_PROFILE
+
+// Record the active bytecode call stack in the sample ring, leaf frame
+// first.  Called from the VM poll point, so all frames in the chain are in a
+// consistent state.  Samples from all threads share one ring; a rare lost
+// sample from two threads hitting the same slot doesn't matter for a
+// statistical profile.
+void mp_cpu_prof_sample(const mp_code_state_t *code_state) {
+    qstr *stack = MP_STATE_VM(cpu_prof_ring)[MP_STATE_VM(cpu_prof_n_samples)++ % MICROPY_CPU_PROFILE_RING_LEN];
+    size_t depth = 0;
+    for (const mp_code_state_t *cs = code_state; cs != NULL && depth < MICROPY_CPU_PROFILE_MAX_DEPTH; cs = cs->prev_state) {
+        stack[depth++] = mp_obj_fun_get_name(MP_OBJ_FROM_PTR(cs->fun_bc));
+    }
+    while (depth < MICROPY_CPU_PROFILE_MAX_DEPTH) {
+        stack[depth++] = 0;
+    }
+}
+
+#endif // MICROPY_CPU_PROFILE
@@ -76,4 +76,9 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state);
 #endif
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+#if MICROPY_CPU_PROFILE
+void mp_cpu_prof_sample(const struct _mp_code_state_t *code_state);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_PROFILING_H
@@ -98,6 +98,7 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	runtime.o \
 	runtime_utils.o \
 	scheduler.o \
+	trace.o \
 	nativeglue.o \
 	pairheap.o \
 	ringbuf.o \
@@ -179,14 +180,17 @@ PY_EXTMOD_O_BASENAME = \
 	extmod/modure.o \
 	extmod/moduzlib.o \
 	extmod/moduheapq.o \
+	extmod/moduparallel.o \
 	extmod/modutimeq.o \
 	extmod/moduhashlib.o \
 	extmod/moducryptolib.o \
 	extmod/modubinascii.o \
 	extmod/virtpin.o \
+	extmod/machine_atomic.o \
 	extmod/machine_mem.o \
 	extmod/machine_pinbase.o \
 	extmod/machine_signal.o \
+	extmod/machine_pingroup.o \
 	extmod/machine_pulse.o \
 	extmod/machine_i2c.o \
 	extmod/machine_spi.o \
@@ -198,6 +202,8 @@ PY_EXTMOD_O_BASENAME = \
 	extmod/moduwebsocket.o \
 	extmod/modwebrepl.o \
 	extmod/modframebuf.o \
+	extmod/modnetutils.o \
+	extmod/modulog.o \
 	extmod/vfs.o \
 	extmod/vfs_blockdev.o \
 	extmod/vfs_reader.o \
@@ -207,6 +213,7 @@ PY_EXTMOD_O_BASENAME = \
 	extmod/vfs_fat_diskio.o \
 	extmod/vfs_fat_file.o \
 	extmod/vfs_lfs.o \
+	extmod/vfs_bundle.o \
 	extmod/utime_mphal.o \
 	extmod/uos_dupterm.o \
 	shared/libc/abort_.o \
@@ -81,6 +81,20 @@
 #define QSTR_EXIT()
 #endif
 
+// Without the GIL, qstr_find_strn and find_qstr run concurrently with
+// interning (parse and objstr probe for existing qstrs without the mutex),
+// so additions must be published in order: string data and pool entry
+// first, then the pool length / index slot / pool pointer that makes them
+// reachable.  A reader may still miss a concurrent addition, in which case
+// interning re-checks under the mutex.
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define QSTR_PUBLISH(dst, val) __atomic_store_n(&(dst), (val), __ATOMIC_RELEASE)
+#define QSTR_READ(src) __atomic_load_n(&(src), __ATOMIC_ACQUIRE)
+#else
+#define QSTR_PUBLISH(dst, val) ((dst) = (val))
+#define QSTR_READ(src) (src)
+#endif
+
 // Initial number of entries for qstr pool, set so that the first dynamically
 // allocated pool is twice this size.  The value here must be <= MP_QSTRnumber_of.
 #define MICROPY_ALLOC_QSTR_ENTRIES_INIT (10)
@@ -125,6 +139,10 @@ void qstr_init(void) {
     MP_STATE_VM(last_pool) = (qstr_pool_t *)&CONST_POOL; // we won't modify the const_pool since it has no allocated room left
     MP_STATE_VM(qstr_last_chunk) = NULL;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    MP_STATE_VM(qstr_index) = NULL; // built on the first dynamic intern
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     mp_thread_mutex_init(&MP_STATE_VM(qstr_mutex));
     #endif
@@ -133,13 +151,63 @@ void qstr_init(void) {
 STATIC const byte *find_qstr(qstr q) {
     // search pool for this qstr
     // total_prev_len==0 in the final pool, so the loop will always terminate
-    qstr_pool_t *pool = MP_STATE_VM(last_pool);
+    qstr_pool_t *pool = QSTR_READ(MP_STATE_VM(last_pool));
     while (q < pool->total_prev_len) {
         pool = pool->prev;
     }
     return pool->qstrs[q - pool->total_prev_len];
 }
 
+#if MICROPY_QSTR_HASH_INDEX
+
+// Initial number of slots in the qstr hash index; must be a power of 2.
+#define MICROPY_ALLOC_QSTR_INDEX_INIT (1024)
+
+// The slot count lives inside the allocation so a concurrent reader always
+// sees a (slots, alloc) pair that match, however stale.
+typedef struct _qstr_index_t {
+    size_t alloc; // number of slots, a power of 2
+    qstr slots[];
+} qstr_index_t;
+
+// Insert an already-pooled qstr into the given index, which must have a free
+// slot (the index is grown before it can become half full).
+STATIC void qstr_index_insert(qstr_index_t *index, qstr q) {
+    size_t mask = index->alloc - 1;
+    size_t i = Q_GET_HASH(find_qstr(q)) & mask;
+    while (index->slots[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    QSTR_PUBLISH(index->slots[i], q);
+}
+
+// (Re)build the hash index with the given number of slots, covering all
+// qstrs in all pools.  On allocation failure any existing index is dropped
+// and lookups fall back to the linear pool scan, which is always correct.
+// The old index is left for the GC to reclaim since concurrent readers may
+// still be probing it.
+// qstr_mutex must be taken while in this function.
+STATIC void qstr_index_rebuild(size_t alloc) {
+    qstr_index_t *index = m_new_obj_var_maybe(qstr_index_t, qstr, alloc);
+    if (index == NULL) {
+        MP_STATE_VM(qstr_index) = NULL;
+        return;
+    }
+    index->alloc = alloc;
+    memset(index->slots, 0, alloc * sizeof(qstr));
+    for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        for (size_t i = 0; i < pool->len; i++) {
+            qstr q = pool->total_prev_len + i;
+            if (q != 0) { // qstr 0 is the sentinel for an empty slot
+                qstr_index_insert(index, q);
+            }
+        }
+    }
+    QSTR_PUBLISH(MP_STATE_VM(qstr_index), index);
+}
+
+#endif // MICROPY_QSTR_HASH_INDEX
+
 // qstr_mutex must be taken while in this function
 STATIC qstr qstr_add(const byte *q_ptr) {
     DEBUG_printf("QSTR: add hash=%d len=%d data=%.*s\n", Q_GET_HASH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_LENGTH(q_ptr), Q_GET_DATA(q_ptr));
@@ -160,24 +228,62 @@ STATIC qstr qstr_add(const byte *q_ptr) {
         pool->total_prev_len = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len;
         pool->alloc = new_alloc;
         pool->len = 0;
-        MP_STATE_VM(last_pool) = pool;
+        // the pool is fully set up, so it can now be made visible to readers
+        QSTR_PUBLISH(MP_STATE_VM(last_pool), pool);
         DEBUG_printf("QSTR: allocate new pool of size %d\n", MP_STATE_VM(last_pool)->alloc);
     }
 
-    // add the new qstr
-    MP_STATE_VM(last_pool)->qstrs[MP_STATE_VM(last_pool)->len++] = q_ptr;
+    // add the new qstr; store the entry before publishing the grown length
+    qstr_pool_t *last_pool = MP_STATE_VM(last_pool);
+    last_pool->qstrs[last_pool->len] = q_ptr;
+    QSTR_PUBLISH(last_pool->len, last_pool->len + 1);
+    qstr q = last_pool->total_prev_len + last_pool->len - 1;
+
+    #if MICROPY_QSTR_HASH_INDEX
+    // keep the hash index in sync, growing it so it stays below half full
+    size_t n_qstr = q + 1;
+    if (MP_STATE_VM(qstr_index) != NULL && n_qstr * 2 < MP_STATE_VM(qstr_index)->alloc) {
+        qstr_index_insert(MP_STATE_VM(qstr_index), q);
+    } else {
+        size_t alloc = MICROPY_ALLOC_QSTR_INDEX_INIT;
+        while (n_qstr * 2 >= alloc) {
+            alloc *= 2;
+        }
+        qstr_index_rebuild(alloc); // picks up the new qstr from the pool
+    }
+    #endif
 
     // return id for the newly-added qstr
-    return MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len - 1;
+    return q;
 }
 
 qstr qstr_find_strn(const char *str, size_t str_len) {
     // work out hash of str
     mp_uint_t str_hash = qstr_compute_hash((const byte *)str, str_len);
 
+    #if MICROPY_QSTR_HASH_INDEX
+    // snapshot the index pointer: a rebuild may swap it out underneath us,
+    // and the snapshot (possibly one generation stale) stays valid because
+    // old indexes are never freed explicitly
+    qstr_index_t *index = QSTR_READ(MP_STATE_VM(qstr_index));
+    if (index != NULL) {
+        // probe the hash index; a run of occupied slots always ends because
+        // the index is kept below half full
+        size_t mask = index->alloc - 1;
+        for (size_t i = str_hash & mask; QSTR_READ(index->slots[i]) != 0; i = (i + 1) & mask) {
+            qstr q = QSTR_READ(index->slots[i]);
+            const byte *qd = find_qstr(q);
+            if (Q_GET_HASH(qd) == str_hash && Q_GET_LENGTH(qd) == str_len && memcmp(Q_GET_DATA(qd), str, str_len) == 0) {
+                return q;
+            }
+        }
+        return 0;
+    }
+    #endif
+
     // search pools for the data
-    for (qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
-        for (const byte **q = pool->qstrs, **q_top = pool->qstrs + pool->len; q < q_top; q++) {
+    for (qstr_pool_t *pool = QSTR_READ(MP_STATE_VM(last_pool)); pool != NULL; pool = pool->prev) {
+        for (const byte **q = pool->qstrs, **q_top = pool->qstrs + QSTR_READ(pool->len); q < q_top; q++) {
             if (Q_GET_HASH(*q) == str_hash && Q_GET_LENGTH(*q) == str_len && memcmp(Q_GET_DATA(*q), str, str_len) == 0) {
                 return pool->total_prev_len + (q - pool->qstrs);
             }
@@ -193,6 +299,16 @@ qstr qstr_from_str(const char *str) {
 }
 
 qstr qstr_from_strn(const char *str, size_t len) {
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    // fast path: existing qstrs can be found without taking the mutex
+    // because additions are published in order (see QSTR_PUBLISH above);
+    // a miss here might race a concurrent intern, so it re-checks below
+    qstr q_existing = qstr_find_strn(str, len);
+    if (q_existing != 0) {
+        return q_existing;
+    }
+    #endif
+
     QSTR_ENTER();
     qstr q = qstr_find_strn(str, len);
     if (q == 0) {
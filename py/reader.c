@@ -56,6 +56,24 @@ STATIC void mp_reader_mem_close(void *data) {
     m_del_obj(mp_reader_mem_t, reader);
 }
 
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP
+const byte *mp_reader_mem_map(mp_reader_t *reader, size_t len) {
+    if (reader->readbyte != mp_reader_mem_readbyte) {
+        // Not a mem reader so the data is not directly addressable
+        return NULL;
+    }
+    mp_reader_mem_t *rm = (mp_reader_mem_t *)reader->data;
+    if (rm->free_len > 0 || len > (size_t)(rm->end - rm->cur)) {
+        // The underlying buffer is freed on close so pointers into it won't
+        // stay valid (or there isn't enough data left)
+        return NULL;
+    }
+    const byte *ptr = rm->cur;
+    rm->cur += len;
+    return ptr;
+}
+#endif
+
 void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t free_len) {
     mp_reader_mem_t *rm = m_new_obj(mp_reader_mem_t);
     rm->free_len = free_len;
@@ -78,7 +96,7 @@ typedef struct _mp_reader_posix_t {
     int fd;
     size_t len;
     size_t pos;
-    byte buf[20];
+    byte buf[MICROPY_READER_BUF_SIZE];
 } mp_reader_posix_t;
 
 STATIC mp_uint_t mp_reader_posix_readbyte(void *data) {
@@ -111,7 +129,70 @@ STATIC void mp_reader_posix_close(void *data) {
     m_del_obj(mp_reader_posix_t, reader);
 }
 
+#if MICROPY_READER_POSIX_MMAP
+
+#include <sys/mman.h>
+
+typedef struct _mp_reader_mmap_t {
+    const byte *beg;
+    const byte *cur;
+    const byte *end;
+} mp_reader_mmap_t;
+
+STATIC mp_uint_t mp_reader_mmap_readbyte(void *data) {
+    mp_reader_mmap_t *reader = (mp_reader_mmap_t *)data;
+    if (reader->cur < reader->end) {
+        return *reader->cur++;
+    } else {
+        return MP_READER_EOF;
+    }
+}
+
+STATIC void mp_reader_mmap_close(void *data) {
+    mp_reader_mmap_t *reader = (mp_reader_mmap_t *)data;
+    munmap((void *)reader->beg, reader->end - reader->beg);
+    m_del_obj(mp_reader_mmap_t, reader);
+}
+
+// Try to create a reader over a private read-only mapping of the file.
+// Returns false if the file can't be mapped (not a regular file, empty, fd
+// not at offset 0, or mmap failed) and the caller should use read() instead.
+STATIC bool mp_reader_try_mmap(mp_reader_t *reader, int fd, bool close_fd) {
+    struct stat st;
+    MP_THREAD_GIL_EXIT();
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0
+        || lseek(fd, 0, SEEK_CUR) != 0) {
+        MP_THREAD_GIL_ENTER();
+        return false;
+    }
+    void *ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+        MP_THREAD_GIL_ENTER();
+        return false;
+    }
+    if (close_fd) {
+        // the mapping stays valid without the fd
+        close(fd);
+    }
+    MP_THREAD_GIL_ENTER();
+    mp_reader_mmap_t *rm = m_new_obj(mp_reader_mmap_t);
+    rm->beg = ptr;
+    rm->cur = rm->beg;
+    rm->end = rm->beg + st.st_size;
+    reader->data = rm;
+    reader->readbyte = mp_reader_mmap_readbyte;
+    reader->close = mp_reader_mmap_close;
+    return true;
+}
+
+#endif // MICROPY_READER_POSIX_MMAP
+
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd) {
+    #if MICROPY_READER_POSIX_MMAP
+    if (mp_reader_try_mmap(reader, fd, close_fd)) {
+        return;
+    }
+    #endif
     mp_reader_posix_t *rp = m_new_obj(mp_reader_posix_t);
     rp->close_fd = close_fd;
     rp->fd = fd;
@@ -40,6 +40,11 @@ typedef struct _mp_reader_t {
 } mp_reader_t;
 
 void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t free_len);
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP
+// If the reader is a mem reader over a persistent buffer then return a pointer
+// to the next len bytes and advance the reader past them, else return NULL.
+const byte *mp_reader_mem_map(mp_reader_t *reader, size_t len);
+#endif
 void mp_reader_new_file(mp_reader_t *reader, const char *filename);
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd);
 
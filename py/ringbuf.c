@@ -23,6 +23,8 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <string.h>
+
 #include "ringbuf.h"
 
 int ringbuf_get16(ringbuf_t *r) {
@@ -71,3 +73,47 @@ int ringbuf_put16(ringbuf_t *r, uint16_t v) {
     r->iput = iput_b;
     return 0;
 }
+
+int ringbuf_put_bytes(ringbuf_t *r, const uint8_t *data, size_t data_len) {
+    if (ringbuf_free(r) < data_len) {
+        return -1;
+    }
+    uint32_t iput = r->iput;
+    size_t tail = r->size - iput;
+    if (data_len > tail) {
+        // data wraps: copy the tail of the buffer then the rest at the start
+        memcpy(r->buf + iput, data, tail);
+        memcpy(r->buf, data + tail, data_len - tail);
+        iput = data_len - tail;
+    } else {
+        memcpy(r->buf + iput, data, data_len);
+        iput += data_len;
+        if (iput == r->size) {
+            iput = 0;
+        }
+    }
+    r->iput = iput;
+    return 0;
+}
+
+int ringbuf_get_bytes(ringbuf_t *r, uint8_t *data, size_t data_len) {
+    if (ringbuf_avail(r) < data_len) {
+        return -1;
+    }
+    uint32_t iget = r->iget;
+    size_t tail = r->size - iget;
+    if (data_len > tail) {
+        // data wraps: copy the tail of the buffer then the rest at the start
+        memcpy(data, r->buf + iget, tail);
+        memcpy(data + tail, r->buf, data_len - tail);
+        iget = data_len - tail;
+    } else {
+        memcpy(data, r->buf + iget, data_len);
+        iget += data_len;
+        if (iget == r->size) {
+            iget = 0;
+        }
+    }
+    r->iget = iget;
+    return 0;
+}
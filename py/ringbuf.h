@@ -96,4 +96,12 @@ int ringbuf_get16(ringbuf_t *r);
 int ringbuf_peek16(ringbuf_t *r);
 int ringbuf_put16(ringbuf_t *r, uint16_t v);
 
+// Bulk copy in/out, at most two memcpy's each.  Return 0 on success, -1 if
+// there is not enough space/data (in which case the buffer is unchanged).
+// The data is copied before the index is updated, so like the byte ops above
+// these are usable from one producer and one consumer without locking as
+// long as index load/stores are atomic on the target.
+int ringbuf_put_bytes(ringbuf_t *r, const uint8_t *data, size_t data_len);
+int ringbuf_get_bytes(ringbuf_t *r, uint8_t *data, size_t data_len);
+
 #endif // MICROPY_INCLUDED_PY_RINGBUF_H
@@ -59,20 +59,46 @@ const mp_obj_module_t mp_module___main__ = {
 };
 
 void mp_init(void) {
+    MICROPY_BOOT_PHASE_HOOK("mp_init");
+
     qstr_init();
 
     // no pending exceptions to start with
     MP_STATE_THREAD(mp_pending_exception) = MP_OBJ_NULL;
     #if MICROPY_ENABLE_SCHEDULER
     MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
+    #if MICROPY_SCHEDULER_LOCKFREE
+    MP_STATE_VM(sched_head) = 0;
+    MP_STATE_VM(sched_tail) = 0;
+    memset((void *)MP_STATE_VM(sched_ready), 0, sizeof(MP_STATE_VM(sched_ready)));
+    #else
     MP_STATE_VM(sched_idx) = 0;
     MP_STATE_VM(sched_len) = 0;
     #endif
+    MP_STATE_VM(sched_drops) = 0;
+    #endif
 
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
     mp_init_emergency_exception_buf();
     #endif
 
+    #if MICROPY_OPT_MRO_CACHE
+    // drop class attribute lookups cached before a soft reset
+    memset(MP_STATE_VM(mro_cache), 0, sizeof(MP_STATE_VM(mro_cache)));
+    MP_STATE_VM(mro_cache_epoch) = 0;
+    #endif
+
+    #if MICROPY_OPT_BOUND_METH_CACHE
+    // drop bound methods cached before a soft reset
+    memset(MP_STATE_VM(bound_meth_cache), 0, sizeof(MP_STATE_VM(bound_meth_cache)));
+    #endif
+
+    #if MICROPY_OPT_CHAR_QSTR_CACHE
+    // drop character qstrs cached before a soft reset (the qstr pool may
+    // have been reset along with the heap)
+    memset(MP_STATE_VM(char_qstr_cache), 0, sizeof(MP_STATE_VM(char_qstr_cache)));
+    #endif
+
     #if MICROPY_KBD_EXCEPTION
     // initialise the exception object for raising KeyboardInterrupt
     MP_STATE_VM(mp_kbd_exception).base.type = &mp_type_KeyboardInterrupt;
@@ -93,6 +119,29 @@ void mp_init(void) {
     // init global module dict
     mp_obj_dict_init(&MP_STATE_VM(mp_loaded_modules_dict), MICROPY_LOADED_MODULES_DICT_SIZE);
 
+    #if MICROPY_MODULE_DEFER_BUILTIN_INIT
+    MP_STATE_VM(mp_deferred_builtin_init) = MP_OBJ_NULL;
+    #endif
+
+    #if MICROPY_TRACE
+    MP_STATE_VM(trace_head) = 0;
+    MP_STATE_VM(trace_count) = 0;
+    MP_STATE_VM(trace_drops) = 0;
+    memset(MP_STATE_VM(trace_alloc_class), 0, sizeof(MP_STATE_VM(trace_alloc_class)));
+    #endif
+
+    #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+    mp_thread_mutex_init(&MP_STATE_VM(mp_module_mutex));
+    #endif
+
+    #if MICROPY_MODULE_IMPORT_STAT_CACHE
+    MP_STATE_VM(mp_import_stat_cache) = MP_OBJ_NULL;
+    #endif
+
+    #if MICROPY_PY_BUILTINS_FLOAT && MICROPY_OPT_FLOAT_INTERN
+    memset(MP_STATE_VM(float_intern_cache), 0, sizeof(MP_STATE_VM(float_intern_cache)));
+    #endif
+
     // initialise the __main__ module
     mp_obj_dict_init(&MP_STATE_VM(dict_main), 1);
     mp_obj_dict_store(MP_OBJ_FROM_PTR(&MP_STATE_VM(dict_main)), MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR___main__));
@@ -126,6 +175,21 @@ void mp_init(void) {
     MP_STATE_VM(sys_exitfunc) = mp_const_none;
     #endif
 
+    #if MICROPY_PY_UASYNCIO
+    MP_STATE_VM(uasyncio_sleep_singleton) = MP_OBJ_NULL;
+    #endif
+
+    #if MICROPY_PY_URE_CACHE_SIZE > 0
+    for (size_t i = 0; i < MP_ARRAY_SIZE(MP_STATE_VM(ure_cache)); ++i) {
+        MP_STATE_VM(ure_cache)[i] = MP_OBJ_NULL;
+    }
+    #endif
+
+    #if MICROPY_PY_MACHINE_SPI_ASYNC
+    MP_STATE_VM(machine_spi_txn_queue) = MP_OBJ_NULL;
+    MP_STATE_VM(machine_spi_txn_active) = MP_OBJ_NULL;
+    #endif
+
     #if MICROPY_PY_SYS_SETTRACE
     MP_STATE_THREAD(prof_trace_callback) = MP_OBJ_NULL;
     MP_STATE_THREAD(prof_callback_is_executing) = false;
@@ -146,6 +210,8 @@ void mp_init(void) {
     #endif
 
     MP_THREAD_GIL_ENTER();
+
+    MICROPY_BOOT_PHASE_HOOK("mp_init_done");
 }
 
 void mp_deinit(void) {
@@ -274,6 +340,12 @@ mp_obj_t mp_unary_op(mp_unary_op_t op, mp_obj_t arg) {
         if (h == 0) {
             GET_STR_DATA_LEN(arg, data, len);
             h = qstr_compute_hash(data, len);
+            #if MICROPY_ENABLE_GC
+            // memoize the hash in the object, unless it lives in ROM
+            if (!mp_obj_is_qstr(arg) && gc_nbytes(MP_OBJ_TO_PTR(arg)) != 0) {
+                ((mp_obj_str_t *)MP_OBJ_TO_PTR(arg))->hash = h;
+            }
+            #endif
         }
         return MP_OBJ_NEW_SMALL_INT(h);
     } else {
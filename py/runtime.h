@@ -72,8 +72,20 @@ void mp_handle_pending_tail(mp_uint_t atomic_state);
 #if MICROPY_ENABLE_SCHEDULER
 void mp_sched_lock(void);
 void mp_sched_unlock(void);
-#define mp_sched_num_pending() (MP_STATE_VM(sched_len))
+#if MICROPY_SCHEDULER_PRIORITY
+#define mp_sched_num_pri_pending() (MP_STATE_VM(sched_pri_len))
+#else
+#define mp_sched_num_pri_pending() (0)
+#endif
+#if MICROPY_SCHEDULER_LOCKFREE
+#define mp_sched_num_pending() (MP_STATE_VM(sched_tail) - MP_STATE_VM(sched_head) + mp_sched_num_pri_pending())
+#else
+#define mp_sched_num_pending() (MP_STATE_VM(sched_len) + mp_sched_num_pri_pending())
+#endif
 bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg);
+#if MICROPY_SCHEDULER_PRIORITY
+bool mp_sched_schedule_priority(mp_obj_t function, mp_obj_t arg);
+#endif
 #endif
 
 // extra printing method specifically for mp_obj_t's which are integral type
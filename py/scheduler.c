@@ -26,7 +26,9 @@
 
 #include <stdio.h>
 
+#include "py/gc.h"
 #include "py/runtime.h"
+#include "py/trace.h"
 
 // Schedules an exception on the main thread (for exceptions "thrown" by async
 // sources such as interrupts and UNIX signal handlers).
@@ -50,14 +52,20 @@ void MICROPY_WRAP_MP_SCHED_KEYBOARD_INTERRUPT(mp_sched_keyboard_interrupt)(void)
 #if MICROPY_ENABLE_SCHEDULER
 
 #define IDX_MASK(i) ((i) & (MICROPY_SCHEDULER_DEPTH - 1))
+#define PRI_IDX_MASK(i) ((i) & (MICROPY_SCHEDULER_PRIORITY_DEPTH - 1))
 
 // This is a macro so it is guaranteed to be inlined in functions like
-// mp_sched_schedule that may be located in a special memory region.
-#define mp_sched_full() (mp_sched_num_pending() == MICROPY_SCHEDULER_DEPTH)
+// mp_sched_schedule that may be located in a special memory region.  It only
+// counts the bulk queue; the priority lane has its own full check.
+#define mp_sched_full() (MP_STATE_VM(sched_len) == MICROPY_SCHEDULER_DEPTH)
 
 static inline bool mp_sched_empty(void) {
     MP_STATIC_ASSERT(MICROPY_SCHEDULER_DEPTH <= 255); // MICROPY_SCHEDULER_DEPTH must fit in 8 bits
     MP_STATIC_ASSERT((IDX_MASK(MICROPY_SCHEDULER_DEPTH) == 0)); // MICROPY_SCHEDULER_DEPTH must be a power of 2
+    #if MICROPY_SCHEDULER_PRIORITY
+    MP_STATIC_ASSERT(MICROPY_SCHEDULER_PRIORITY_DEPTH <= 255); // MICROPY_SCHEDULER_PRIORITY_DEPTH must fit in 8 bits
+    MP_STATIC_ASSERT((PRI_IDX_MASK(MICROPY_SCHEDULER_PRIORITY_DEPTH) == 0)); // MICROPY_SCHEDULER_PRIORITY_DEPTH must be a power of 2
+    #endif
 
     return mp_sched_num_pending() == 0;
 }
@@ -87,18 +95,64 @@ void mp_handle_pending(bool raise_exc) {
 }
 
 // This function should only be called by mp_handle_pending,
-// or by the VM's inlined version of that function.
+// or by the VM's inlined version of that function.  It runs at most
+// MICROPY_SCHEDULER_DRAIN_MAX queued callbacks, so the pause it introduces
+// at a VM checkpoint stays bounded no matter how full the queue is; any
+// remaining items are picked up at the next checkpoint.
 void mp_handle_pending_tail(mp_uint_t atomic_state) {
     MP_STATE_VM(sched_state) = MP_SCHED_LOCKED;
-    if (!mp_sched_empty()) {
+    for (size_t n_run = 0;;) {
+        if (mp_sched_empty()) {
+            MICROPY_END_ATOMIC_SECTION(atomic_state);
+            break;
+        }
+        #if MICROPY_SCHEDULER_PRIORITY
+        if (MP_STATE_VM(sched_pri_len) != 0) {
+            // Items in the priority lane preempt the bulk queue below
+            mp_sched_item_t item = MP_STATE_VM(sched_pri_queue)[MP_STATE_VM(sched_pri_idx)];
+            MP_STATE_VM(sched_pri_idx) = PRI_IDX_MASK(MP_STATE_VM(sched_pri_idx) + 1);
+            --MP_STATE_VM(sched_pri_len);
+            MICROPY_END_ATOMIC_SECTION(atomic_state);
+            mp_call_function_1_protected(item.func, item.arg);
+            if (++n_run >= MICROPY_SCHEDULER_DRAIN_MAX) {
+                break;
+            }
+            atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+            continue;
+        }
+        #endif
+        #if MICROPY_SCHEDULER_LOCKFREE
+        size_t iget = IDX_MASK(MP_STATE_VM(sched_head));
+        if (!__atomic_load_n(&MP_STATE_VM(sched_ready)[iget], __ATOMIC_ACQUIRE)) {
+            // A producer has reserved this slot but not yet finished writing
+            // it; leave it (and everything after it, to keep FIFO order) for
+            // the next checkpoint.
+            MICROPY_END_ATOMIC_SECTION(atomic_state);
+            break;
+        }
+        mp_sched_item_t item = MP_STATE_VM(sched_queue)[iget];
+        // Clear the slot before advancing sched_head, because a producer may
+        // reserve it again as soon as the head moves past it.
+        __atomic_store_n(&MP_STATE_VM(sched_ready)[iget], 0, __ATOMIC_RELEASE);
+        __atomic_store_n(&MP_STATE_VM(sched_head), MP_STATE_VM(sched_head) + 1, __ATOMIC_RELEASE);
+        #else
         mp_sched_item_t item = MP_STATE_VM(sched_queue)[MP_STATE_VM(sched_idx)];
         MP_STATE_VM(sched_idx) = IDX_MASK(MP_STATE_VM(sched_idx) + 1);
         --MP_STATE_VM(sched_len);
+        #endif
         MICROPY_END_ATOMIC_SECTION(atomic_state);
         mp_call_function_1_protected(item.func, item.arg);
-    } else {
-        MICROPY_END_ATOMIC_SECTION(atomic_state);
+        if (++n_run >= MICROPY_SCHEDULER_DRAIN_MAX) {
+            break;
+        }
+        atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    }
+    #if MICROPY_GC_DEFERRED_FINALISER
+    // also run at most one finaliser queued by the collector
+    if (MP_STATE_MEM(gc_pending_finaliser_count) != 0) {
+        gc_finaliser_run_one();
     }
+    #endif
     mp_sched_unlock();
 }
 
@@ -117,7 +171,11 @@ void mp_sched_unlock(void) {
     assert(MP_STATE_VM(sched_state) < 0);
     if (++MP_STATE_VM(sched_state) == 0) {
         // vm became unlocked
-        if (MP_STATE_THREAD(mp_pending_exception) != MP_OBJ_NULL || mp_sched_num_pending()) {
+        if (MP_STATE_THREAD(mp_pending_exception) != MP_OBJ_NULL || mp_sched_num_pending()
+            #if MICROPY_GC_DEFERRED_FINALISER
+            || MP_STATE_MEM(gc_pending_finaliser_count) != 0
+            #endif
+            ) {
             MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
         } else {
             MP_STATE_VM(sched_state) = MP_SCHED_IDLE;
@@ -126,6 +184,76 @@ void mp_sched_unlock(void) {
     MICROPY_END_ATOMIC_SECTION(atomic_state);
 }
 
+#if MICROPY_SCHEDULER_PRIORITY
+
+// Like mp_sched_schedule but the callback goes to the high-priority lane,
+// which mp_handle_pending_tail drains ahead of the bulk queue.  Intended for
+// a small number of short, latency-sensitive callbacks; the lane is always
+// filled under the atomic section, so with MICROPY_SCHEDULER_LOCKFREE it does
+// not have the bulk lane's lock-free progress guarantee for producers.
+bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule_priority)(mp_obj_t function, mp_obj_t arg) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    bool ret;
+    if (MP_STATE_VM(sched_pri_len) < MICROPY_SCHEDULER_PRIORITY_DEPTH) {
+        if (MP_STATE_VM(sched_state) == MP_SCHED_IDLE) {
+            MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
+        }
+        uint8_t iput = PRI_IDX_MASK(MP_STATE_VM(sched_pri_idx) + MP_STATE_VM(sched_pri_len)++);
+        MP_STATE_VM(sched_pri_queue)[iput].func = function;
+        MP_STATE_VM(sched_pri_queue)[iput].arg = arg;
+        #if MICROPY_TRACE
+        mp_trace_event(MP_TRACE_EV_SCHED, 1, MP_STATE_VM(sched_pri_len), 0);
+        #endif
+        MICROPY_SCHED_HOOK_SCHEDULED;
+        ret = true;
+    } else {
+        // priority lane is full
+        ++MP_STATE_VM(sched_drops);
+        ret = false;
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return ret;
+}
+
+#endif // MICROPY_SCHEDULER_PRIORITY
+
+#if MICROPY_SCHEDULER_LOCKFREE
+
+bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule)(mp_obj_t function, mp_obj_t arg) {
+    // Reserve a slot by advancing sched_tail; no atomic section is taken so
+    // concurrent producers (ISRs, other threads) never contend on it.
+    mp_uint_t tail;
+    for (;;) {
+        tail = __atomic_load_n(&MP_STATE_VM(sched_tail), __ATOMIC_RELAXED);
+        if (tail - __atomic_load_n(&MP_STATE_VM(sched_head), __ATOMIC_ACQUIRE) >= MICROPY_SCHEDULER_DEPTH) {
+            // schedule queue is full
+            __atomic_fetch_add(&MP_STATE_VM(sched_drops), 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&MP_STATE_VM(sched_tail), &tail, tail + 1,
+            false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    size_t iput = IDX_MASK(tail);
+    MP_STATE_VM(sched_queue)[iput].func = function;
+    MP_STATE_VM(sched_queue)[iput].arg = arg;
+    // Publish the slot, then raise sched_state from IDLE to PENDING; if the
+    // scheduler is locked right now, mp_sched_unlock re-checks the queue.
+    __atomic_store_n(&MP_STATE_VM(sched_ready)[iput], 1, __ATOMIC_RELEASE);
+    int16_t idle = MP_SCHED_IDLE;
+    __atomic_compare_exchange_n(&MP_STATE_VM(sched_state), &idle, MP_SCHED_PENDING,
+        false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    #if MICROPY_TRACE
+    mp_trace_event(MP_TRACE_EV_SCHED, 0,
+        tail + 1 - __atomic_load_n(&MP_STATE_VM(sched_head), __ATOMIC_RELAXED), 0);
+    #endif
+    MICROPY_SCHED_HOOK_SCHEDULED;
+    return true;
+}
+
+#else // MICROPY_SCHEDULER_LOCKFREE
+
 bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule)(mp_obj_t function, mp_obj_t arg) {
     mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
     bool ret;
@@ -136,16 +264,22 @@ bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule)(mp_obj_t function, mp_obj
         uint8_t iput = IDX_MASK(MP_STATE_VM(sched_idx) + MP_STATE_VM(sched_len)++);
         MP_STATE_VM(sched_queue)[iput].func = function;
         MP_STATE_VM(sched_queue)[iput].arg = arg;
+        #if MICROPY_TRACE
+        mp_trace_event(MP_TRACE_EV_SCHED, 0, MP_STATE_VM(sched_len), 0);
+        #endif
         MICROPY_SCHED_HOOK_SCHEDULED;
         ret = true;
     } else {
         // schedule queue is full
+        ++MP_STATE_VM(sched_drops);
         ret = false;
     }
     MICROPY_END_ATOMIC_SECTION(atomic_state);
     return ret;
 }
 
+#endif // MICROPY_SCHEDULER_LOCKFREE
+
 #else // MICROPY_ENABLE_SCHEDULER
 
 // A variant of this is inlined in the VM at the pending exception check
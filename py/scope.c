@@ -63,11 +63,17 @@ scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, qstr source_file, mp_u
     scope->emit_options = emit_options;
     scope->id_info_alloc = MICROPY_ALLOC_SCOPE_ID_INIT;
     scope->id_info = m_new(id_info_t, scope->id_info_alloc);
+    #if MICROPY_OPT_SCOPE_ID_INDEX
+    mp_map_init(&scope->id_index, scope->id_info_alloc);
+    #endif
 
     return scope;
 }
 
 void scope_free(scope_t *scope) {
+    #if MICROPY_OPT_SCOPE_ID_INDEX
+    mp_map_deinit(&scope->id_index);
+    #endif
     m_del(id_info_t, scope->id_info, scope->id_info_alloc);
     m_del(scope_t, scope, 1);
 }
@@ -93,16 +99,43 @@ id_info_t *scope_find_or_add_id(scope_t *scope, qstr qst, id_info_kind_t kind) {
     id_info->flags = 0;
     id_info->local_num = 0;
     id_info->qst = qst;
+
+    #if MICROPY_OPT_SCOPE_ID_INDEX
+    // Record the index of the new id; ids are never removed so the index
+    // stays valid even though id_info may be reallocated.  The map is keyed
+    // by the qstr *number* as a small int rather than a qstr object: some
+    // ids the compiler creates internally (eg the context variable of an
+    // async for loop) are not valid qstrs and must only ever be compared,
+    // never hashed as strings.
+    mp_map_elem_t *elem = mp_map_lookup(&scope->id_index, MP_OBJ_NEW_SMALL_INT(qst), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+    elem->value = MP_OBJ_NEW_SMALL_INT(scope->id_info_len - 1);
+    #endif
+
     return id_info;
 }
 
+#if MICROPY_OPT_SCOPE_ID_INDEX
+void scope_id_index_sync(scope_t *scope, id_info_t *id_info) {
+    mp_map_elem_t *elem = mp_map_lookup(&scope->id_index, MP_OBJ_NEW_SMALL_INT(id_info->qst), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+    elem->value = MP_OBJ_NEW_SMALL_INT(id_info - scope->id_info);
+}
+#endif
+
 id_info_t *scope_find(scope_t *scope, qstr qst) {
+    #if MICROPY_OPT_SCOPE_ID_INDEX
+    mp_map_elem_t *elem = mp_map_lookup(&scope->id_index, MP_OBJ_NEW_SMALL_INT(qst), MP_MAP_LOOKUP);
+    if (elem != NULL) {
+        return &scope->id_info[MP_OBJ_SMALL_INT_VALUE(elem->value)];
+    }
+    return NULL;
+    #else
     for (mp_uint_t i = 0; i < scope->id_info_len; i++) {
         if (scope->id_info[i].qst == qst) {
             return &scope->id_info[i];
         }
     }
     return NULL;
+    #endif
 }
 
 id_info_t *scope_find_global(scope_t *scope, qstr qst) {
@@ -88,11 +88,19 @@ typedef struct _scope_t {
     uint16_t id_info_alloc;
     uint16_t id_info_len;
     id_info_t *id_info;
+    #if MICROPY_OPT_SCOPE_ID_INDEX
+    // maps qstr of an id to its index in id_info, for fast lookup
+    mp_map_t id_index;
+    #endif
 } scope_t;
 
 scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, qstr source_file, mp_uint_t emit_options);
 void scope_free(scope_t *scope);
 id_info_t *scope_find_or_add_id(scope_t *scope, qstr qstr, id_info_kind_t kind);
+#if MICROPY_OPT_SCOPE_ID_INDEX
+// must be called if an id is moved within the id_info array
+void scope_id_index_sync(scope_t *scope, id_info_t *id_info);
+#endif
 id_info_t *scope_find(scope_t *scope, qstr qstr);
 id_info_t *scope_find_global(scope_t *scope, qstr qstr);
 void scope_check_to_close_over(scope_t *scope, id_info_t *id);
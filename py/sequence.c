@@ -151,8 +151,32 @@ bool mp_seq_cmp_objs(mp_uint_t op, const mp_obj_t *items1, size_t len1, const mp
 
     size_t len = len1 < len2 ? len1 : len2;
     for (size_t i = 0; i < len; i++) {
+        mp_obj_t a = items1[i];
+        mp_obj_t b = items2[i];
+
+        // Equal small ints and interned strings are identical objects and
+        // need no dispatch (a bare identity test would not be valid here
+        // because of types with non-reflexive equality, eg float nan)
+        if (a == b && (mp_obj_is_small_int(a) || mp_obj_is_qstr(a))) {
+            continue;
+        }
+
+        // Distinct small ints decide the comparison directly (for the
+        // relational ops a != b, so >= degenerates to >)
+        if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+            if (op == MP_BINARY_OP_EQUAL) {
+                return false;
+            }
+            return MP_OBJ_SMALL_INT_VALUE(a) > MP_OBJ_SMALL_INT_VALUE(b);
+        }
+
+        // Distinct interned strings are never equal
+        if (op == MP_BINARY_OP_EQUAL && mp_obj_is_qstr(a) && mp_obj_is_qstr(b)) {
+            return false;
+        }
+
         // If current elements equal, can't decide anything - go on
-        if (mp_obj_equal(items1[i], items2[i])) {
+        if (mp_obj_equal(a, b)) {
             continue;
         }
 
@@ -163,7 +187,7 @@ bool mp_seq_cmp_objs(mp_uint_t op, const mp_obj_t *items1, size_t len1, const mp
         }
 
         // Otherwise, application of relation op gives the answer
-        return mp_binary_op(op, items1[i], items2[i]) == mp_const_true;
+        return mp_binary_op(op, a, b) == mp_const_true;
     }
 
     // If we had tie in the last element...
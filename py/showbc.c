@@ -232,6 +232,9 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip) {
         case MP_BC_LOAD_METHOD:
             DECODE_QSTR;
             mp_printf(print, "LOAD_METHOD %s", qstr_str(qst));
+            if (MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE) {
+                mp_printf(print, " (cache=%u)", *ip++);
+            }
             break;
 
         case MP_BC_LOAD_SUPER_METHOD:
@@ -42,6 +42,33 @@ mp_uint_t mp_stack_usage(void) {
     return MP_STATE_THREAD(stack_top) - (char *)&stack_dummy;
 }
 
+// Move the recorded stack top down to the current stack pointer.  Use this
+// when entering MicroPython from a deep foreign C stack (eg a network-stack
+// callback): the GC's conservative scan then covers only the frames created
+// from this point on, which both shrinks the scan and stops stale words in
+// the foreign frames pinning heap objects.  The caller must guarantee that
+// the foreign frames hold no references to MicroPython heap objects, and
+// must call mp_stack_restore before returning to them.
+void mp_stack_rebase(mp_stack_rebase_t *ctx) {
+    volatile int stack_dummy;
+    ctx->stack_top = MP_STATE_THREAD(stack_top);
+    #if MICROPY_STACK_CHECK
+    // shrink the limit by the amount of stack already consumed, so the
+    // usage check still guards the real end of the stack
+    ctx->stack_limit = MP_STATE_THREAD(stack_limit);
+    mp_uint_t used = ctx->stack_top - (char *)&stack_dummy;
+    MP_STATE_THREAD(stack_limit) = used < ctx->stack_limit ? ctx->stack_limit - used : 0;
+    #endif
+    MP_STATE_THREAD(stack_top) = (char *)&stack_dummy;
+}
+
+void mp_stack_restore(const mp_stack_rebase_t *ctx) {
+    MP_STATE_THREAD(stack_top) = ctx->stack_top;
+    #if MICROPY_STACK_CHECK
+    MP_STATE_THREAD(stack_limit) = ctx->stack_limit;
+    #endif
+}
+
 #if MICROPY_STACK_CHECK
 
 void mp_stack_set_limit(mp_uint_t limit) {
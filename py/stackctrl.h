@@ -32,6 +32,17 @@ void mp_stack_ctrl_init(void);
 void mp_stack_set_top(void *top);
 mp_uint_t mp_stack_usage(void);
 
+// Saved stack-top state for mp_stack_rebase/mp_stack_restore.
+typedef struct _mp_stack_rebase_t {
+    char *stack_top;
+    #if MICROPY_STACK_CHECK
+    mp_uint_t stack_limit;
+    #endif
+} mp_stack_rebase_t;
+
+void mp_stack_rebase(mp_stack_rebase_t *ctx);
+void mp_stack_restore(const mp_stack_rebase_t *ctx);
+
 #if MICROPY_STACK_CHECK
 
 void mp_stack_set_limit(mp_uint_t limit);
@@ -265,6 +265,126 @@ STATIC mp_obj_t stream_write_method(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_write_obj, 2, 4, stream_write_method);
 
+#if MICROPY_STREAMS_WRITEV
+mp_uint_t mp_stream_writev(mp_obj_t stream, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode) {
+    const mp_stream_p_t *stream_p = mp_get_stream(stream);
+    if (stream_p->writev != NULL) {
+        return stream_p->writev(stream, iov, iovcnt, errcode);
+    }
+    // fallback: write out each segment in turn
+    mp_uint_t total = 0;
+    for (size_t i = 0; i < iovcnt; i++) {
+        mp_uint_t out_sz = mp_stream_write_exactly(stream, iov[i].base, iov[i].len, errcode);
+        total += out_sz;
+        if (*errcode != 0) {
+            return total == 0 ? MP_STREAM_ERROR : total;
+        }
+        if (out_sz < iov[i].len) {
+            // stream can't make progress (eg non-blocking); report what went out
+            break;
+        }
+    }
+    return total;
+}
+
+// writev(bufs): write a list/tuple of buffer segments with as few underlying
+// writes as the stream allows, returning the total number of bytes written
+STATIC mp_obj_t stream_writev_method(mp_obj_t self_in, mp_obj_t bufs_in) {
+    size_t n;
+    mp_obj_t *items;
+    mp_obj_get_array(bufs_in, &n, &items);
+    mp_stream_iovec_t *iov = m_new(mp_stream_iovec_t, n);
+    for (size_t i = 0; i < n; i++) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(items[i], &bufinfo, MP_BUFFER_READ);
+        iov[i].base = bufinfo.buf;
+        iov[i].len = bufinfo.len;
+    }
+    int error;
+    mp_uint_t out_sz = mp_stream_writev(self_in, iov, n, &error);
+    m_del(mp_stream_iovec_t, iov, n);
+    if (out_sz == MP_STREAM_ERROR) {
+        if (mp_is_nonblocking_error(error)) {
+            return mp_const_none;
+        }
+        mp_raise_OSError(error);
+    }
+    return mp_obj_new_int_from_uint(out_sz);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mp_stream_writev_obj, stream_writev_method);
+#endif
+
+#if MICROPY_STREAMS_SENDFILE
+// Copy up to limit bytes ((mp_uint_t)-1 means until EOF) from the src stream
+// to the dest stream via a single reusable buffer, so a bulk transfer costs
+// no per-chunk object allocation.  Returns the number of bytes copied;
+// follows the mp_stream_rw error convention (*errcode non-zero on error,
+// cleared if some progress was made before EAGAIN).  Note that on a
+// non-blocking dest, data already read from src when the dest stalls cannot
+// be pushed back, so this is intended for blocking streams.
+mp_uint_t mp_stream_splice(mp_obj_t dest, mp_obj_t src, mp_uint_t limit, int *errcode) {
+    const mp_stream_p_t *src_p = mp_get_stream(src);
+    mp_uint_t bufsize = 4 * DEFAULT_BUFFER_SIZE;
+    if (limit < bufsize) {
+        bufsize = limit;
+    }
+    byte *buf = m_new(byte, bufsize);
+    mp_uint_t total = 0;
+    *errcode = 0;
+    while (total < limit) {
+        mp_uint_t to_read = bufsize;
+        if (limit - total < to_read) {
+            to_read = limit - total;
+        }
+        mp_uint_t in_sz = src_p->read(src, buf, to_read, errcode);
+        if (in_sz == 0) {
+            // EOF on src
+            break;
+        }
+        if (in_sz == MP_STREAM_ERROR) {
+            if (mp_is_nonblocking_error(*errcode) && total != 0) {
+                *errcode = 0;
+            }
+            break;
+        }
+        mp_uint_t out_sz = mp_stream_write_exactly(dest, buf, in_sz, errcode);
+        total += out_sz;
+        if (*errcode != 0 || out_sz < in_sz) {
+            if (mp_is_nonblocking_error(*errcode) && total != 0) {
+                *errcode = 0;
+            }
+            break;
+        }
+    }
+    m_del(byte, buf, bufsize);
+    return total;
+}
+
+// sendfile(dest, src, count=-1): copy count bytes (default: until EOF) from
+// the src stream to the dest stream, returning the number of bytes copied.
+mp_obj_t mp_stream_sendfile(size_t n_args, const mp_obj_t *args) {
+    mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+    mp_get_stream_raise(args[1], MP_STREAM_OP_READ);
+    mp_uint_t limit = (mp_uint_t)-1;
+    if (n_args == 3) {
+        mp_int_t count = mp_obj_get_int(args[2]);
+        if (count >= 0) {
+            limit = count;
+        }
+    }
+    int error;
+    mp_uint_t total = mp_stream_splice(args[0], args[1], limit, &error);
+    if (error != 0) {
+        if (mp_is_nonblocking_error(error)) {
+            return mp_const_none;
+        }
+        mp_raise_OSError(error);
+    }
+    return mp_obj_new_int_from_uint(total);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_sendfile_obj, 2, 3, mp_stream_sendfile);
+#endif
+
 STATIC mp_obj_t stream_write1_method(mp_obj_t self_in, mp_obj_t arg) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(arg, &bufinfo, MP_BUFFER_READ);
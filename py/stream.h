@@ -43,6 +43,7 @@
 #define MP_STREAM_GET_DATA_OPTS (8)  // Get data/message options
 #define MP_STREAM_SET_DATA_OPTS (9)  // Set data/message options
 #define MP_STREAM_GET_FILENO    (10) // Get fileno of underlying file
+#define MP_STREAM_GET_BUFFER    (11) // Get underlying memory buffer, if directly addressable
 
 // These poll ioctl values are compatible with Linux
 #define MP_STREAM_POLL_RD       (0x0001)
@@ -65,6 +66,23 @@ struct mp_stream_seek_t {
 #define MP_SEEK_CUR (1)
 #define MP_SEEK_END (2)
 
+// Argument structure for MP_STREAM_GET_BUFFER.  Streams whose entire
+// contents live at a stable memory address (eg a file in a memory-mapped
+// bundle) fill this in; the buffer must remain valid after the stream is
+// closed, for as long as the backing store is available.
+struct mp_stream_buffer_t {
+    const void *buf;
+    size_t len;
+};
+
+#if MICROPY_STREAMS_WRITEV
+// One segment of a vectored write; layout-compatible with POSIX struct iovec
+typedef struct _mp_stream_iovec_t {
+    const void *base;
+    size_t len;
+} mp_stream_iovec_t;
+#endif
+
 // Stream protocol
 typedef struct _mp_stream_p_t {
     // On error, functions should return MP_STREAM_ERROR and fill in *errcode (values
@@ -72,7 +90,13 @@ typedef struct _mp_stream_p_t {
     mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
     mp_uint_t (*ioctl)(mp_obj_t obj, mp_uint_t request, uintptr_t arg, int *errcode);
+    #if MICROPY_STREAMS_WRITEV
+    // optional scatter/gather write; may be NULL, in which case
+    // mp_stream_writev falls back to writing each segment in turn
+    mp_uint_t (*writev)(mp_obj_t obj, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode);
+    #endif
     mp_uint_t is_text : 1; // default is bytes, set this for text stream
+    mp_uint_t can_get_buffer : 1; // set if the stream implements MP_STREAM_GET_BUFFER
 } mp_stream_p_t;
 
 MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_read_obj);
@@ -111,6 +135,15 @@ mp_obj_t mp_stream_write(mp_obj_t self_in, const void *buf, size_t len, byte fla
 #define MP_STREAM_RW_WRITE 2
 #define MP_STREAM_RW_ONCE  1
 mp_uint_t mp_stream_rw(mp_obj_t stream, void *buf, mp_uint_t size, int *errcode, byte flags);
+#if MICROPY_STREAMS_WRITEV
+MP_DECLARE_CONST_FUN_OBJ_2(mp_stream_writev_obj);
+mp_uint_t mp_stream_writev(mp_obj_t stream, const mp_stream_iovec_t *iov, size_t iovcnt, int *errcode);
+#endif
+#if MICROPY_STREAMS_SENDFILE
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(mp_stream_sendfile_obj);
+mp_uint_t mp_stream_splice(mp_obj_t dest, mp_obj_t src, mp_uint_t limit, int *errcode);
+mp_obj_t mp_stream_sendfile(size_t n_args, const mp_obj_t *args);
+#endif
 #define mp_stream_write_exactly(stream, buf, size, err) mp_stream_rw(stream, (byte *)buf, size, err, MP_STREAM_RW_WRITE)
 #define mp_stream_read_exactly(stream, buf, size, err) mp_stream_rw(stream, buf, size, err, MP_STREAM_RW_READ)
 
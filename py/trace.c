@@ -0,0 +1,108 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "py/trace.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/mphal.h"
+
+#if MICROPY_TRACE
+
+// Recording is a handful of stores with no allocation, so tracepoints can sit
+// on the gc and scheduler paths.  The ring is not reentrant: a record written
+// from an interrupt that lands in the middle of another writer may be lost,
+// which is acceptable for a diagnostic facility.
+
+void mp_trace_event(uint8_t event, uint16_t arg16, uint32_t arg0, uint32_t arg1) {
+    if (MP_STATE_VM(trace_count) >= MICROPY_TRACE_RING_LEN) {
+        MP_STATE_VM(trace_drops)++;
+        return;
+    }
+    size_t idx = (MP_STATE_VM(trace_head) + MP_STATE_VM(trace_count)) % MICROPY_TRACE_RING_LEN;
+    mp_trace_rec_t *rec = &MP_STATE_VM(trace_ring)[idx];
+    rec->event = event;
+    rec->pad = 0;
+    rec->arg16 = arg16;
+    rec->ticks_us = mp_hal_ticks_us();
+    rec->arg0 = arg0;
+    rec->arg1 = arg1;
+    MP_STATE_VM(trace_count)++;
+}
+
+void mp_trace_alloc(size_t n_blocks) {
+    // class k counts allocations of 2**k (up to the next class) heap blocks
+    size_t cls = 0;
+    while (cls < MICROPY_TRACE_ALLOC_CLASSES - 1 && (n_blocks >> cls) > 1) {
+        cls++;
+    }
+    MP_STATE_VM(trace_alloc_class)[cls]++;
+}
+
+STATIC void trace_write_rec(mp_obj_t stream, const mp_trace_rec_t *rec) {
+    int errcode;
+    mp_uint_t ret = mp_stream_write_exactly(stream, rec, sizeof(*rec), &errcode);
+    if (ret != sizeof(*rec)) {
+        mp_raise_OSError(errcode);
+    }
+}
+
+void mp_trace_drain(mp_obj_t stream) {
+    // drain the ring of timestamped records
+    while (MP_STATE_VM(trace_count) > 0) {
+        size_t head = MP_STATE_VM(trace_head);
+        MP_STATE_VM(trace_head) = (head + 1) % MICROPY_TRACE_RING_LEN;
+        MP_STATE_VM(trace_count)--;
+        trace_write_rec(stream, &MP_STATE_VM(trace_ring)[head]);
+    }
+
+    // emit the counters aggregated since the last drain, then reset them
+    mp_trace_rec_t rec = {0, 0, 0, mp_hal_ticks_us(), 0, 0};
+    for (size_t i = 0; i < MICROPY_TRACE_ALLOC_CLASSES; i++) {
+        if (MP_STATE_VM(trace_alloc_class)[i] != 0) {
+            rec.event = MP_TRACE_EV_ALLOC_CLASS;
+            rec.arg16 = i;
+            rec.arg0 = MP_STATE_VM(trace_alloc_class)[i];
+            MP_STATE_VM(trace_alloc_class)[i] = 0;
+            trace_write_rec(stream, &rec);
+        }
+    }
+    if (MP_STATE_VM(trace_drops) != 0) {
+        rec.event = MP_TRACE_EV_DROPS;
+        rec.arg16 = 0;
+        rec.arg0 = MP_STATE_VM(trace_drops);
+        MP_STATE_VM(trace_drops) = 0;
+        trace_write_rec(stream, &rec);
+    }
+}
+
+STATIC mp_obj_t mp_micropython_trace_drain(mp_obj_t stream) {
+    mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
+    mp_trace_drain(stream);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(mp_micropython_trace_drain_obj, mp_micropython_trace_drain);
+
+#endif // MICROPY_TRACE
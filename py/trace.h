@@ -0,0 +1,55 @@
+/*
+ * This file is part of the MicroPython project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2020 Damien P. George
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef MICROPY_INCLUDED_PY_TRACE_H
+#define MICROPY_INCLUDED_PY_TRACE_H
+
+#include "py/obj.h"
+
+#if MICROPY_TRACE
+
+// Trace event types; tools/mptrace.py must match
+enum {
+    MP_TRACE_EV_GC_START = 1, // a collection began
+    MP_TRACE_EV_GC_END = 2, // a collection finished; arg0 = bytes swept
+    MP_TRACE_EV_SCHED = 3, // mp_sched_schedule ran; arg0 = queue depth
+    MP_TRACE_EV_ALLOC_CLASS = 4, // arg16 = size class, arg0 = allocations since last drain
+    MP_TRACE_EV_DROPS = 5, // arg0 = records lost to a full ring since last drain
+};
+
+// Append a record to the trace ring; drops it (counted) when the ring is full
+void mp_trace_event(uint8_t event, uint16_t arg16, uint32_t arg0, uint32_t arg1);
+
+// Count an allocation of the given number of heap blocks in its size class
+void mp_trace_alloc(size_t n_blocks);
+
+// Write all pending records to a stream object and reset the counters
+void mp_trace_drain(mp_obj_t stream);
+
+MP_DECLARE_CONST_FUN_OBJ_1(mp_micropython_trace_drain_obj);
+
+#endif // MICROPY_TRACE
+
+#endif // MICROPY_INCLUDED_PY_TRACE_H
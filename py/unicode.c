@@ -25,9 +25,15 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/unicode.h"
 
+#if MICROPY_PY_BUILTINS_STR_UNICODE
+// A word with 0x80 in every byte, for testing a whole word of ASCII at once.
+#define UTF8_HIGH_BITS ((size_t)-1 / 0xFF * 0x80)
+#endif
+
 // attribute flags
 #define FL_PRINT (0x01)
 #define FL_SPACE (0x02)
@@ -105,10 +111,25 @@ mp_uint_t utf8_ptr_to_index(const byte *s, const byte *ptr) {
 
 size_t utf8_charlen(const byte *str, size_t len) {
     size_t charlen = 0;
-    for (const byte *top = str + len; str < top; ++str) {
+    const byte *top = str + len;
+    while (str < top) {
+        // count aligned words of pure ASCII a whole word at a time
+        while (((uintptr_t)str & (sizeof(size_t) - 1)) == 0 && str + sizeof(size_t) <= top) {
+            size_t w;
+            memcpy(&w, str, sizeof(w));
+            if (w & UTF8_HIGH_BITS) {
+                break;
+            }
+            charlen += sizeof(size_t);
+            str += sizeof(size_t);
+        }
+        if (str >= top) {
+            break;
+        }
         if (!UTF8_IS_CONT(*str)) {
             ++charlen;
         }
+        ++str;
     }
     return charlen;
 }
@@ -183,7 +204,7 @@ mp_uint_t unichar_xdigit_value(unichar c) {
 bool utf8_check(const byte *p, size_t len) {
     uint8_t need = 0;
     const byte *end = p + len;
-    for (; p < end; p++) {
+    while (p < end) {
         byte c = *p;
         if (need) {
             if (UTF8_IS_CONT(c)) {
@@ -202,8 +223,21 @@ bool utf8_check(const byte *p, size_t len) {
             } else if (c >= 0x80) {
                 // mismatch
                 return 0;
+            } else {
+                // ASCII; skip aligned words of further ASCII a word at a time
+                p++;
+                while (((uintptr_t)p & (sizeof(size_t) - 1)) == 0 && p + sizeof(size_t) <= end) {
+                    size_t w;
+                    memcpy(&w, p, sizeof(w));
+                    if (w & UTF8_HIGH_BITS) {
+                        break;
+                    }
+                    p += sizeof(size_t);
+                }
+                continue;
             }
         }
+        p++;
     }
     return need == 0; // no pending fragments allowed
 }
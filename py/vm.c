@@ -36,6 +36,10 @@
 #include "py/bc.h"
 #include "py/profile.h"
 
+#if MICROPY_STACKLESS_TAIL_CALL && (!MICROPY_STACKLESS || MICROPY_PY_SYS_SETTRACE || MICROPY_ENABLE_PYSTACK)
+#error "MICROPY_STACKLESS_TAIL_CALL requires MICROPY_STACKLESS without settrace or pystack"
+#endif
+
 // *FORMAT-OFF*
 
 #if 0
@@ -131,7 +135,17 @@
     } \
 } while (0)
 
+#if MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+
 #if MICROPY_PY_SYS_SETTRACE
+#define FRAME_ENTER_TRACE() do { \
+    if (!mp_prof_is_executing) { \
+        mp_prof_frame_enter(code_state); \
+    } \
+} while(0)
+#else
+#define FRAME_ENTER_TRACE()
+#endif
 
 #define FRAME_SETUP() do { \
     assert(code_state != code_state->prev_state); \
@@ -143,9 +157,7 @@
     assert(code_state != code_state->prev_state); \
     code_state->prev_state = MP_STATE_THREAD(current_code_state); \
     assert(code_state != code_state->prev_state); \
-    if (!mp_prof_is_executing) { \
-        mp_prof_frame_enter(code_state); \
-    } \
+    FRAME_ENTER_TRACE(); \
 } while(0)
 
 #define FRAME_LEAVE() do { \
@@ -154,6 +166,14 @@
     assert(code_state != code_state->prev_state); \
 } while(0)
 
+#else // MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+#define FRAME_SETUP()
+#define FRAME_ENTER()
+#define FRAME_LEAVE()
+#endif // MICROPY_PY_SYS_SETTRACE || MICROPY_CPU_PROFILE
+
+#if MICROPY_PY_SYS_SETTRACE
+
 #define FRAME_UPDATE() do { \
     assert(MP_STATE_THREAD(current_code_state) == code_state); \
     if (!mp_prof_is_executing) { \
@@ -173,13 +193,30 @@
 } while(0)
 
 #else // MICROPY_PY_SYS_SETTRACE
-#define FRAME_SETUP()
-#define FRAME_ENTER()
-#define FRAME_LEAVE()
 #define FRAME_UPDATE()
 #define TRACE_TICK(current_ip, current_sp, is_exception)
 #endif // MICROPY_PY_SYS_SETTRACE
 
+#if MICROPY_CPU_PROFILE
+// Take a stack sample every MICROPY_CPU_PROFILE_INTERVAL'th poll point.
+#define CPU_PROF_TICK() do { \
+    if (MP_STATE_THREAD(cpu_prof_countdown) == 0) { \
+        MP_STATE_THREAD(cpu_prof_countdown) = MICROPY_CPU_PROFILE_INTERVAL - 1; \
+        mp_cpu_prof_sample(code_state); \
+    } else { \
+        --MP_STATE_THREAD(cpu_prof_countdown); \
+    } \
+} while (0)
+#else
+#define CPU_PROF_TICK()
+#endif
+
+#if MICROPY_DEBUG_VM_OPCODE_STATS
+#define COUNT_OPCODE(ip) (MP_STATE_VM(vm_opcode_count)[*(ip)]++)
+#else
+#define COUNT_OPCODE(ip)
+#endif
+
 #if MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
 static inline mp_map_elem_t *mp_map_cached_lookup(mp_map_t *map, qstr qst, uint8_t *idx_cache) {
     size_t idx = *idx_cache;
@@ -204,7 +241,7 @@ static inline mp_map_elem_t *mp_map_cached_lookup(mp_map_t *map, qstr qst, uint8
 //  MP_VM_RETURN_YIELD, ip, sp valid, yielded value in *sp
 //  MP_VM_RETURN_EXCEPTION, exception in state[0]
 mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp_obj_t inject_exc) {
-#define SELECTIVE_EXC_IP (0)
+#define SELECTIVE_EXC_IP (MICROPY_OPT_VM_SELECTIVE_EXC_IP)
 #if SELECTIVE_EXC_IP
 #define MARK_EXC_IP_SELECTIVE() { code_state->ip = ip; } /* stores ip 1 byte past last opcode */
 #define MARK_EXC_IP_GLOBAL()
@@ -218,6 +255,7 @@ mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state, volatile mp
         TRACE(ip); \
         MARK_EXC_IP_GLOBAL(); \
         TRACE_TICK(ip, sp, false); \
+        COUNT_OPCODE(ip); \
         goto *entry_table[*ip++]; \
     } while (0)
     #define DISPATCH_WITH_PEND_EXC_CHECK() goto pending_exception_check
@@ -296,6 +334,7 @@ dispatch_loop:
                 TRACE(ip);
                 MARK_EXC_IP_GLOBAL();
                 TRACE_TICK(ip, sp, false);
+                COUNT_OPCODE(ip);
                 switch (*ip++) {
 #endif
 
@@ -440,6 +479,7 @@ dispatch_loop:
                 }
                 #endif
 
+                #if !MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -447,6 +487,38 @@ dispatch_loop:
                     sp += 1;
                     DISPATCH();
                 }
+                #else
+                // The cache slot caches the index of the method in the locals dict
+                // of the base's own type.  Instance members shadow methods so the
+                // fast-path is only taken when the members map doesn't have the
+                // attribute; and only self-binding functions use the hit, anything
+                // else (eg property, staticmethod, attr of a parent class) takes
+                // the generic path through mp_load_method.
+                ENTRY(MP_BC_LOAD_METHOD): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_QSTR;
+                    mp_obj_t top = *sp;
+                    const mp_obj_type_t *type = mp_obj_get_type(top);
+                    mp_map_elem_t *elem = NULL;
+                    if (mp_obj_is_instance_type(type) && type->locals_dict != NULL
+                        && mp_map_lookup(&((mp_obj_instance_t *)MP_OBJ_TO_PTR(top))->members,
+                            MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP) == NULL) {
+                        elem = mp_map_cached_lookup(&type->locals_dict->map, qst, (uint8_t *)ip);
+                    }
+                    if (elem != NULL && mp_obj_is_obj(elem->value)
+                        && (((mp_obj_base_t *)MP_OBJ_TO_PTR(elem->value))->type->flags
+                            & (MP_TYPE_FLAG_BINDS_SELF | MP_TYPE_FLAG_BUILTIN_FUN)) == MP_TYPE_FLAG_BINDS_SELF) {
+                        // push the unbound method and self, as mp_convert_member_lookup does
+                        sp[0] = elem->value;
+                        sp[1] = top;
+                    } else {
+                        mp_load_method(top, qst, sp);
+                    }
+                    sp += 1;
+                    ip++;
+                    DISPATCH();
+                }
+                #endif
 
                 ENTRY(MP_BC_LOAD_SUPER_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
@@ -623,6 +695,61 @@ dispatch_loop:
                     DISPATCH_WITH_PEND_EXC_CHECK();
                 }
 
+                #if MICROPY_OPT_VM_SUPERINSTRUCTIONS
+                // Fused opcode pairs; see mp_emit_glue_assign_bytecode for
+                // how the operands are packed into the byte that follows.
+                ENTRY(MP_BC_LOAD_FAST_LOAD_FAST): {
+                    size_t ab = *ip++;
+                    obj_shared = fastn[-(mp_int_t)(ab >> 4)];
+                    if (obj_shared == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(obj_shared);
+                    obj_shared = fastn[-(mp_int_t)(ab & 0xf)];
+                    goto load_check;
+                }
+
+                ENTRY(MP_BC_LOAD_FAST_BINARY_OP): {
+                    MARK_EXC_IP_SELECTIVE();
+                    size_t ab = *ip++;
+                    mp_obj_t rhs = fastn[-(mp_int_t)(ab >> 6)];
+                    if (rhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    mp_obj_t lhs = TOP();
+                    SET_TOP(mp_binary_op(ab & 0x3f, lhs, rhs));
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_BINARY_OP_STORE_FAST): {
+                    MARK_EXC_IP_SELECTIVE();
+                    size_t ab = *ip++;
+                    mp_binary_op_t op = *ip++;
+                    size_t dest = *ip++;
+                    mp_obj_t lhs = fastn[-(mp_int_t)(ab >> 4)];
+                    mp_obj_t rhs = fastn[-(mp_int_t)(ab & 0xf)];
+                    if (lhs == MP_OBJ_NULL || rhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    fastn[-(mp_int_t)dest] = mp_binary_op(op, lhs, rhs);
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF_TRUE):
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF_FALSE): {
+                    MARK_EXC_IP_SELECTIVE();
+                    bool sense = ip[-1] == MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+                    mp_binary_op_t op = *ip++;
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = POP();
+                    DECODE_SLABEL;
+                    if (mp_obj_is_true(mp_binary_op(op, lhs, rhs)) == sense) {
+                        ip += slab;
+                    }
+                    DISPATCH_WITH_PEND_EXC_CHECK();
+                }
+                #endif
+
                 ENTRY(MP_BC_JUMP_IF_TRUE_OR_POP): {
                     DECODE_SLABEL;
                     if (mp_obj_is_true(TOP())) {
@@ -995,7 +1122,19 @@ unwind_jump:;
                         } else
                         #endif
                         {
-                            new_state->prev = code_state;
+                            #if MICROPY_STACKLESS_TAIL_CALL
+                            if (*ip == MP_BC_RETURN_VALUE && exc_sp < exc_stack && code_state->prev != NULL) {
+                                // Tail call with no active exception handlers in this
+                                // frame: splice the frame out of the call chain so the
+                                // callee returns directly to our caller and this
+                                // frame's state can be reclaimed now.
+                                new_state->prev = code_state->prev;
+                                new_state->old_globals = code_state->old_globals;
+                            } else
+                            #endif
+                            {
+                                new_state->prev = code_state;
+                            }
                             code_state = new_state;
                             nlr_pop();
                             goto run_code_state;
@@ -1041,7 +1180,19 @@ unwind_jump:;
                         } else
                         #endif
                         {
-                            new_state->prev = code_state;
+                            #if MICROPY_STACKLESS_TAIL_CALL
+                            if (*ip == MP_BC_RETURN_VALUE && exc_sp < exc_stack && code_state->prev != NULL) {
+                                // Tail call with no active exception handlers in this
+                                // frame: splice the frame out of the call chain so the
+                                // callee returns directly to our caller and this
+                                // frame's state can be reclaimed now.
+                                new_state->prev = code_state->prev;
+                                new_state->old_globals = code_state->old_globals;
+                            } else
+                            #endif
+                            {
+                                new_state->prev = code_state;
+                            }
                             code_state = new_state;
                             nlr_pop();
                             goto run_code_state;
@@ -1080,7 +1231,19 @@ unwind_jump:;
                         } else
                         #endif
                         {
-                            new_state->prev = code_state;
+                            #if MICROPY_STACKLESS_TAIL_CALL
+                            if (*ip == MP_BC_RETURN_VALUE && exc_sp < exc_stack && code_state->prev != NULL) {
+                                // Tail call with no active exception handlers in this
+                                // frame: splice the frame out of the call chain so the
+                                // callee returns directly to our caller and this
+                                // frame's state can be reclaimed now.
+                                new_state->prev = code_state->prev;
+                                new_state->old_globals = code_state->old_globals;
+                            } else
+                            #endif
+                            {
+                                new_state->prev = code_state;
+                            }
                             code_state = new_state;
                             nlr_pop();
                             goto run_code_state;
@@ -1126,7 +1289,19 @@ unwind_jump:;
                         } else
                         #endif
                         {
-                            new_state->prev = code_state;
+                            #if MICROPY_STACKLESS_TAIL_CALL
+                            if (*ip == MP_BC_RETURN_VALUE && exc_sp < exc_stack && code_state->prev != NULL) {
+                                // Tail call with no active exception handlers in this
+                                // frame: splice the frame out of the call chain so the
+                                // callee returns directly to our caller and this
+                                // frame's state can be reclaimed now.
+                                new_state->prev = code_state->prev;
+                                new_state->old_globals = code_state->old_globals;
+                            } else
+                            #endif
+                            {
+                                new_state->prev = code_state;
+                            }
                             code_state = new_state;
                             nlr_pop();
                             goto run_code_state;
@@ -1360,6 +1535,7 @@ yield:
 
 pending_exception_check:
                 MICROPY_VM_HOOK_LOOP
+                CPU_PROF_TICK();
 
                 #if MICROPY_ENABLE_SCHEDULER
                 // This is an inlined variant of mp_handle_pending
@@ -118,6 +118,13 @@ static const void *const entry_table[256] = {
     [MP_BC_STORE_FAST_MULTI ... MP_BC_STORE_FAST_MULTI + MP_BC_STORE_FAST_MULTI_NUM - 1] = &&entry_MP_BC_STORE_FAST_MULTI,
     [MP_BC_UNARY_OP_MULTI ... MP_BC_UNARY_OP_MULTI + MP_BC_UNARY_OP_MULTI_NUM - 1] = &&entry_MP_BC_UNARY_OP_MULTI,
     [MP_BC_BINARY_OP_MULTI ... MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM - 1] = &&entry_MP_BC_BINARY_OP_MULTI,
+    #if MICROPY_OPT_VM_SUPERINSTRUCTIONS
+    [MP_BC_LOAD_FAST_LOAD_FAST] = &&entry_MP_BC_LOAD_FAST_LOAD_FAST,
+    [MP_BC_LOAD_FAST_BINARY_OP] = &&entry_MP_BC_LOAD_FAST_BINARY_OP,
+    [MP_BC_BINARY_OP_POP_JUMP_IF_TRUE] = &&entry_MP_BC_BINARY_OP_POP_JUMP_IF_TRUE,
+    [MP_BC_BINARY_OP_POP_JUMP_IF_FALSE] = &&entry_MP_BC_BINARY_OP_POP_JUMP_IF_FALSE,
+    [MP_BC_BINARY_OP_STORE_FAST] = &&entry_MP_BC_BINARY_OP_STORE_FAST,
+    #endif
 };
 
 #if __clang__
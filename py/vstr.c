@@ -111,7 +111,14 @@ STATIC void vstr_ensure_extra(vstr_t *vstr, size_t size) {
             // be there, so the only safe option is to raise an exception.
             mp_raise_msg(&mp_type_RuntimeError, NULL);
         }
+        // Grow geometrically (by 1.5x) so that a sequence of appends needs
+        // only O(log n) reallocations and O(n) amortised copying, but never
+        // allocate less than the caller needs.
         size_t new_alloc = ROUND_ALLOC((vstr->len + size) + 16);
+        size_t grow_alloc = ROUND_ALLOC(vstr->alloc + (vstr->alloc >> 1));
+        if (new_alloc < grow_alloc) {
+            new_alloc = grow_alloc;
+        }
         char *new_buf = m_renew(char, vstr->buf, vstr->alloc, new_alloc);
         vstr->alloc = new_alloc;
         vstr->buf = new_buf;
@@ -32,16 +32,28 @@
 #include "py/runtime.h"
 #include "shared/netutils/netutils.h"
 
+STATIC char *netutils_format_u8(char *p, uint8_t val) {
+    if (val >= 100) {
+        *p++ = '0' + val / 100;
+    }
+    if (val >= 10) {
+        *p++ = '0' + val / 10 % 10;
+    }
+    *p++ = '0' + val % 10;
+    return p;
+}
+
 // Takes an array with a raw IPv4 address and returns something like '192.168.0.1'.
 mp_obj_t netutils_format_ipv4_addr(uint8_t *ip, netutils_endian_t endian) {
     char ip_str[16];
-    mp_uint_t ip_len;
-    if (endian == NETUTILS_LITTLE) {
-        ip_len = snprintf(ip_str, 16, "%u.%u.%u.%u", ip[3], ip[2], ip[1], ip[0]);
-    } else {
-        ip_len = snprintf(ip_str, 16, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+    char *p = ip_str;
+    for (int i = 0; i < 4; i++) {
+        if (i != 0) {
+            *p++ = '.';
+        }
+        p = netutils_format_u8(p, endian == NETUTILS_LITTLE ? ip[3 - i] : ip[i]);
     }
-    return mp_obj_new_str(ip_str, ip_len);
+    return mp_obj_new_str(ip_str, p - ip_str);
 }
 
 // Takes an array with a raw IP address, and a port, and returns a net-address
@@ -92,3 +104,188 @@ mp_uint_t netutils_parse_inet_addr(mp_obj_t addr_in, uint8_t *out_ip, netutils_e
     netutils_parse_ipv4_addr(addr_items[0], out_ip, endian);
     return mp_obj_get_int(addr_items[1]);
 }
+
+// Takes a 16-byte raw IPv6 address in network order and returns something
+// like 'fe80::1', compressing the longest run of zero groups.
+mp_obj_t netutils_format_ipv6_addr(const uint8_t *ip) {
+    uint16_t groups[8];
+    for (int i = 0; i < 8; i++) {
+        groups[i] = ip[2 * i] << 8 | ip[2 * i + 1];
+    }
+    // find the longest run of two or more zero groups
+    int best_start = -1;
+    int best_len = 1;
+    for (int i = 0; i < 8;) {
+        int j = i;
+        while (j < 8 && groups[j] == 0) {
+            j++;
+        }
+        if (j - i > best_len) {
+            best_start = i;
+            best_len = j - i;
+        }
+        i = (j == i) ? i + 1 : j;
+    }
+    char buf[40];
+    char *p = buf;
+    for (int i = 0; i < 8; i++) {
+        if (i == best_start) {
+            *p++ = ':';
+            i += best_len - 1;
+            if (i == 7) {
+                *p++ = ':';
+            }
+            continue;
+        }
+        if (i != 0) {
+            *p++ = ':';
+        }
+        int started = 0;
+        for (int sh = 12; sh >= 0; sh -= 4) {
+            int d = groups[i] >> sh & 0xf;
+            if (d != 0 || started || sh == 0) {
+                *p++ = "0123456789abcdef"[d];
+                started = 1;
+            }
+        }
+    }
+    return mp_obj_new_str(buf, p - buf);
+}
+
+// Parses an IPv6 address string (hex groups and '::' compression; embedded
+// IPv4 forms are not supported) into 16 bytes in network order.
+void netutils_parse_ipv6_addr(mp_obj_t addr_in, uint8_t *out_ip) {
+    size_t addr_len;
+    const char *s = mp_obj_str_get_data(addr_in, &addr_len);
+    if (addr_len == 0) {
+        // special case of no address given
+        memset(out_ip, 0, NETUTILS_IPV6ADDR_BUFSIZE);
+        return;
+    }
+    const char *s_top = s + addr_len;
+    uint16_t groups[8] = {0};
+    int num = 0; // number of groups parsed so far
+    int split = -1; // group index where '::' was seen
+    if (s + 1 < s_top && s[0] == ':' && s[1] == ':') {
+        split = 0;
+        s += 2;
+    }
+    while (s < s_top) {
+        // parse 1-4 hex digits
+        mp_uint_t val = 0;
+        int ndig = 0;
+        while (s < s_top && ndig < 4) {
+            int c = *s;
+            if (c >= '0' && c <= '9') {
+                c -= '0';
+            } else {
+                c |= 0x20;
+                if (c >= 'a' && c <= 'f') {
+                    c -= 'a' - 10;
+                } else {
+                    break;
+                }
+            }
+            val = val << 4 | c;
+            s++;
+            ndig++;
+        }
+        if (ndig == 0 || num >= 8) {
+            goto error;
+        }
+        groups[num++] = val;
+        if (s == s_top) {
+            break;
+        }
+        if (*s != ':') {
+            goto error;
+        }
+        s++;
+        if (s < s_top && *s == ':') {
+            if (split >= 0) {
+                goto error;
+            }
+            split = num;
+            s++;
+        } else if (s == s_top) {
+            // trailing single ':'
+            goto error;
+        }
+    }
+    if (split < 0) {
+        if (num != 8) {
+            goto error;
+        }
+    } else {
+        // expand the '::' to the missing zero groups
+        int shift = 8 - num;
+        if (shift == 0) {
+            goto error;
+        }
+        for (int i = num - 1; i >= split; i--) {
+            groups[i + shift] = groups[i];
+            groups[i] = 0;
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        out_ip[2 * i] = groups[i] >> 8;
+        out_ip[2 * i + 1] = groups[i];
+    }
+    return;
+
+error:
+    mp_raise_ValueError(MP_ERROR_TEXT("invalid arguments"));
+}
+
+// Continue an RFC 1071 Internet-checksum accumulation over buf, starting
+// from sum (pass 0 to begin).  16-bit words are summed four at a time in
+// native byte order, with carries deferred to a single fold at the end;
+// the sum of byte-swapped words is the byte-swapped sum of words, so the
+// result only needs one swap, in netutils_checksum.  Every chunk except
+// the last must therefore have even length.
+uint32_t netutils_checksum_partial(uint32_t sum, const void *data, size_t len) {
+    const uint8_t *buf = data;
+    uint64_t acc = sum;
+    while (len >= 8) {
+        uint32_t w0, w1;
+        memcpy(&w0, buf, 4);
+        memcpy(&w1, buf + 4, 4);
+        acc += (uint64_t)w0 + w1;
+        buf += 8;
+        len -= 8;
+    }
+    if (len >= 4) {
+        uint32_t w;
+        memcpy(&w, buf, 4);
+        acc += w;
+        buf += 4;
+        len -= 4;
+    }
+    if (len >= 2) {
+        uint16_t w;
+        memcpy(&w, buf, 2);
+        acc += w;
+        buf += 2;
+        len -= 2;
+    }
+    if (len != 0) {
+        // odd trailing byte is the high-order byte of a zero-padded word
+        uint16_t w = 0;
+        memcpy(&w, buf, 1);
+        acc += w;
+    }
+    while (acc >> 16) {
+        acc = (acc & 0xffff) + (acc >> 16);
+    }
+    return acc;
+}
+
+// Whole-buffer RFC 1071 checksum: the inverted sum as a number whose high
+// byte is the first byte to go on the wire.
+uint16_t netutils_checksum(const void *data, size_t len) {
+    uint32_t sum = ~netutils_checksum_partial(0, data, len) & 0xffff;
+    #if MP_ENDIANNESS_LITTLE
+    sum = sum >> 8 | (sum & 0xff) << 8;
+    #endif
+    return sum;
+}
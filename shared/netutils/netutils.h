@@ -28,6 +28,7 @@
 #define MICROPY_INCLUDED_LIB_NETUTILS_NETUTILS_H
 
 #define NETUTILS_IPV4ADDR_BUFSIZE    4
+#define NETUTILS_IPV6ADDR_BUFSIZE    16
 
 #define NETUTILS_TRACE_IS_TX        (0x0001)
 #define NETUTILS_TRACE_PAYLOAD      (0x0002)
@@ -51,6 +52,25 @@ void netutils_parse_ipv4_addr(mp_obj_t addr_in, uint8_t *out_ip, netutils_endian
 // puts IP in out_ip (which must take at least IPADDR_BUF_SIZE bytes).
 mp_uint_t netutils_parse_inet_addr(mp_obj_t addr_in, uint8_t *out_ip, netutils_endian_t endian);
 
+// Takes a 16-byte raw IPv6 address in network order and returns something
+// like 'fe80::1', compressing the longest run of zero groups.
+mp_obj_t netutils_format_ipv6_addr(const uint8_t *ip);
+
+// Parses an IPv6 address string (hex groups and '::' compression; embedded
+// IPv4 forms are not supported) into 16 bytes in network order.
+void netutils_parse_ipv6_addr(mp_obj_t addr_in, uint8_t *out_ip);
+
+// Continue an RFC 1071 Internet-checksum accumulation over buf, starting
+// from sum (pass 0 to begin).  Data is summed a machine word at a time in
+// native byte order and only folded at the end, so every chunk except the
+// last must have even length.  The returned value is the running
+// ones-complement sum, not yet inverted.
+uint32_t netutils_checksum_partial(uint32_t sum, const void *data, size_t len);
+
+// Whole-buffer RFC 1071 checksum: the inverted sum as a number whose high
+// byte is the first byte to go on the wire.
+uint16_t netutils_checksum(const void *data, size_t len);
+
 void netutils_ethernet_trace(const mp_print_t *print, size_t len, const uint8_t *buf, unsigned int flags);
 
 #endif // MICROPY_INCLUDED_LIB_NETUTILS_NETUTILS_H
@@ -42,7 +42,7 @@
 
 #define READLINE_HIST_SIZE (MP_ARRAY_SIZE(MP_STATE_PORT(readline_hist)))
 
-enum { ESEQ_NONE, ESEQ_ESC, ESEQ_ESC_BRACKET, ESEQ_ESC_BRACKET_DIGIT, ESEQ_ESC_O };
+enum { ESEQ_NONE, ESEQ_ESC, ESEQ_ESC_BRACKET, ESEQ_ESC_BRACKET_DIGIT, ESEQ_ESC_BRACKET_20, ESEQ_ESC_BRACKET_200, ESEQ_ESC_O };
 
 void readline_init0(void) {
     memset(MP_STATE_PORT(readline_hist), 0, READLINE_HIST_SIZE * sizeof(const char*));
@@ -94,6 +94,12 @@ typedef struct _readline_t {
     int hist_cur;
     size_t cursor_pos;
     char escape_seq_buf[1];
+    #if MICROPY_REPL_BRACKETED_PASTE
+    bool in_paste;
+    uint8_t paste_esc; // progress matching the end-of-paste sequence
+    size_t paste_pos; // start of not-yet-echoed pasted text in the line
+    char paste_prev; // to swallow the \n of a pasted \r\n
+    #endif
     const char *prompt;
 } readline_t;
 
@@ -128,7 +134,70 @@ STATIC size_t cursor_count_word(int forward) {
 }
 #endif
 
+#if MICROPY_REPL_BRACKETED_PASTE
+
+#define PASTE_END_SEQ "\x1b[201~"
+#define PASTE_END_SEQ_LEN (6)
+
+// Echo all pasted text inserted since the last flush in a single write, and
+// put the terminal cursor back at the insertion point.
+STATIC void readline_paste_flush(void) {
+    mp_hal_stdout_tx_strn(rl.line->buf + rl.paste_pos, rl.line->len - rl.paste_pos);
+    mp_hal_move_cursor_back(rl.line->len - rl.cursor_pos);
+    rl.paste_pos = rl.cursor_pos;
+}
+
+STATIC int readline_process_paste_char(int c) {
+    if (c == CHAR_CTRL_C) {
+        // abandon paste mode (eg the end sequence was lost)
+        rl.in_paste = false;
+        rl.paste_esc = 0;
+        readline_paste_flush();
+        return c;
+    }
+    if (c == PASTE_END_SEQ[rl.paste_esc]) {
+        if (++rl.paste_esc == PASTE_END_SEQ_LEN) {
+            // end of paste: echo the pending text and resume normal editing
+            rl.in_paste = false;
+            rl.paste_esc = 0;
+            readline_paste_flush();
+        }
+        return -1;
+    }
+    // a partial match of the end sequence was ordinary pasted text after all
+    for (uint8_t i = 0; i < rl.paste_esc; i++) {
+        vstr_ins_char(rl.line, rl.cursor_pos++, PASTE_END_SEQ[i]);
+    }
+    rl.paste_esc = (c == PASTE_END_SEQ[0]) ? 1 : 0;
+    if (rl.paste_esc != 0) {
+        return -1;
+    }
+    char prev = rl.paste_prev;
+    rl.paste_prev = c;
+    if (c == '\r' || c == '\n') {
+        if (c == '\n' && prev == '\r') {
+            // second half of a pasted CRLF
+            return -1;
+        }
+        // complete this line; the next prompt continues in paste mode
+        readline_paste_flush();
+        mp_hal_stdout_tx_str("\r\n");
+        return 0;
+    }
+    if (c == '\t' || (32 <= c && c <= 126)) {
+        vstr_ins_char(rl.line, rl.cursor_pos++, c);
+    }
+    return -1;
+}
+
+#endif
+
 int readline_process_char(int c) {
+    #if MICROPY_REPL_BRACKETED_PASTE
+    if (rl.in_paste) {
+        return readline_process_paste_char(c);
+    }
+    #endif
     size_t last_line_len = rl.line->len;
     int redraw_step_back = 0;
     bool redraw_from_cursor = false;
@@ -178,6 +247,31 @@ int readline_process_char(int c) {
             redraw_step_back = rl.cursor_pos - rl.orig_line_len;
             redraw_from_cursor = true;
         #endif
+        #if MICROPY_REPL_HIST_SEARCH
+        } else if (c == CHAR_CTRL_R) {
+            // CTRL-R searches backwards through the history for a line that
+            // begins with the text before the cursor; pressing it again
+            // continues the search with older entries
+            size_t prefix_len = rl.cursor_pos - rl.orig_line_len;
+            for (int i = rl.hist_cur + 1; i < (int)READLINE_HIST_SIZE; i++) {
+                const char *hist = MP_STATE_PORT(readline_hist)[i];
+                if (hist == NULL) {
+                    break;
+                }
+                if (strncmp(hist, rl.line->buf + rl.orig_line_len, prefix_len) == 0) {
+                    rl.hist_cur = i;
+                    // set line to history
+                    rl.line->len = rl.orig_line_len;
+                    vstr_add_str(rl.line, hist);
+                    // set redraw parameters, leaving the cursor just after the
+                    // prefix so the search can be repeated
+                    redraw_step_back = prefix_len;
+                    redraw_from_cursor = true;
+                    redraw_step_forward = prefix_len;
+                    break;
+                }
+            }
+        #endif
         #if MICROPY_REPL_EMACS_EXTRA_WORDS_MOVE
         } else if (c == CHAR_CTRL_W) {
             goto backward_kill_word;
@@ -394,10 +488,36 @@ delete_key:
             // ctrl+left
             goto backward_word;
         #endif
+        #if MICROPY_REPL_BRACKETED_PASTE
+        } else if (c == '0' && rl.escape_seq_buf[0] == '2') {
+            // possibly the start-of-paste sequence ESC[200~
+            rl.escape_seq = ESEQ_ESC_BRACKET_20;
+            return -1;
+        #endif
         } else {
             DEBUG_printf("(ESC [ %c %d)", rl.escape_seq_buf[0], c);
         }
         rl.escape_seq = ESEQ_NONE;
+    #if MICROPY_REPL_BRACKETED_PASTE
+    } else if (rl.escape_seq == ESEQ_ESC_BRACKET_20) {
+        rl.escape_seq = ESEQ_NONE;
+        if (c == '0') {
+            rl.escape_seq = ESEQ_ESC_BRACKET_200;
+        } else {
+            DEBUG_printf("(ESC [ 2 0 %d)", c);
+        }
+    } else if (rl.escape_seq == ESEQ_ESC_BRACKET_200) {
+        rl.escape_seq = ESEQ_NONE;
+        if (c == '~') {
+            // start of paste: insert characters without echo until ESC[201~
+            rl.in_paste = true;
+            rl.paste_esc = 0;
+            rl.paste_prev = 0;
+            rl.paste_pos = rl.cursor_pos;
+        } else {
+            DEBUG_printf("(ESC [ 2 0 0 %d)", c);
+        }
+    #endif
     } else if (rl.escape_seq == ESEQ_ESC_O) {
         switch (c) {
             case 'H':
@@ -487,6 +607,13 @@ void readline_note_newline(const char *prompt) {
     rl.cursor_pos = rl.orig_line_len;
     rl.prompt = prompt;
     mp_hal_stdout_tx_str(prompt);
+    #if MICROPY_REPL_BRACKETED_PASTE
+    rl.paste_pos = rl.cursor_pos;
+    if (rl.in_paste) {
+        // pasted code keeps its own indentation
+        return;
+    }
+    #endif
     #if MICROPY_REPL_AUTO_INDENT
     readline_auto_indent();
     #endif
@@ -500,7 +627,20 @@ void readline_init(vstr_t *line, const char *prompt) {
     rl.hist_cur = -1;
     rl.cursor_pos = rl.orig_line_len;
     rl.prompt = prompt;
+    #if MICROPY_REPL_BRACKETED_PASTE
+    if (!rl.in_paste) {
+        // ask the terminal to bracket pasted text with ESC[200~ / ESC[201~
+        mp_hal_stdout_tx_str("\x1b[?2004h");
+    }
+    #endif
     mp_hal_stdout_tx_str(prompt);
+    #if MICROPY_REPL_BRACKETED_PASTE
+    rl.paste_pos = rl.cursor_pos;
+    if (rl.in_paste) {
+        // pasted code keeps its own indentation
+        return;
+    }
+    #endif
     #if MICROPY_REPL_AUTO_INDENT
     readline_auto_indent();
     #endif
@@ -512,6 +652,11 @@ int readline(vstr_t *line, const char *prompt) {
         int c = mp_hal_stdin_rx_chr();
         int r = readline_process_char(c);
         if (r >= 0) {
+            #if MICROPY_REPL_BRACKETED_PASTE
+            if (!rl.in_paste) {
+                mp_hal_stdout_tx_str("\x1b[?2004l");
+            }
+            #endif
             return r;
         }
     }
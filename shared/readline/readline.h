@@ -35,6 +35,7 @@
 #define CHAR_CTRL_K (11)
 #define CHAR_CTRL_N (14)
 #define CHAR_CTRL_P (16)
+#define CHAR_CTRL_R (18)
 #define CHAR_CTRL_U (21)
 #define CHAR_CTRL_W (23)
 
@@ -65,6 +65,20 @@ void mp_irq_init(mp_irq_obj_t *self, const mp_irq_methods_t *methods, mp_obj_t p
     self->ishard = false;
 }
 
+// Called when a handler is registered with hard=True.  A hard handler runs
+// directly in ISR context (see mp_irq_handler below) with the GC locked, so
+// ports can require it to be viper/native code, which is called with a
+// fixed C-stack frame and no scheduler round-trip.
+void mp_irq_check_hard_handler(mp_obj_t handler) {
+    #if MICROPY_IRQ_CHECK_HARD_HANDLER
+    if (handler != mp_const_none && !mp_obj_is_native_fun(handler)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("hard handler must be a viper/native function"));
+    }
+    #else
+    (void)handler;
+    #endif
+}
+
 void mp_irq_handler(mp_irq_obj_t *self) {
     if (self->handler != mp_const_none) {
         if (self->ishard) {
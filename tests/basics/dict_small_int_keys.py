@@ -0,0 +1,23 @@
+# test dicts/sets with only small-int keys probed with equivalent values
+d = {1: "one", 2: "two"}
+print(d[1], d[2])
+print(d[True])  # True == 1
+print(3 in d)
+
+# adding via an equivalent key must update the existing entry
+d[True] = "TRUE"
+print(d[1], sorted(d))
+del d[True]
+print(sorted(d))
+
+# a non-int key unseals the dict but lookups still work
+d = {1: "one"}
+d["s"] = "str"
+print(d[1], d["s"], d[True])
+
+s = {1, 2}
+print(True in s, 2 in s, 3 in s)
+s.add(True)
+print(sorted(s))
+s.discard(True)
+print(sorted(s))
@@ -0,0 +1,35 @@
+import uio as io
+
+try:
+    io.BytesIO
+    io.BufferedReader
+except AttributeError:
+    print('SKIP')
+    raise SystemExit
+
+bts = io.BytesIO(b"foobar\nspam\neggs")
+buf = io.BufferedReader(bts, 8)
+
+print(buf.read(3))
+print(buf.read(1))
+print(buf.readline())
+print(buf.readline())
+print(buf.readline())
+print(buf.read())
+
+# reads larger than the buffer bypass it
+bts = io.BytesIO(bytes(range(64)))
+buf = io.BufferedReader(bts, 4)
+print(buf.read(2))
+print(len(buf.read(50)))
+print(len(buf.read()))
+
+# iteration yields lines
+buf = io.BufferedReader(io.BytesIO(b"a\nbb\nccc"), 2)
+for line in buf:
+    print(line)
+
+# readinto
+buf = io.BufferedReader(io.BytesIO(b"123456"), 4)
+b = bytearray(5)
+print(buf.readinto(b), b)
@@ -0,0 +1,23 @@
+# test that list.sort() is stable and calls the key function once per element
+
+# equal keys keep their original relative order
+l = [(2, "a"), (1, "b"), (2, "c"), (1, "d"), (2, "e")]
+l.sort(key=lambda t: t[0])
+print(l)
+
+# also when sorting in reverse
+l = [(2, "a"), (1, "b"), (2, "c"), (1, "d"), (2, "e")]
+l.sort(key=lambda t: t[0], reverse=True)
+print(l)
+
+# the key function is called exactly once per element
+calls = []
+l = [5, 3, 8, 1, 9, 2, 7, 4, 6, 0]
+l.sort(key=lambda x: calls.append(x) or x)
+print(l)
+print(len(calls))
+
+# a mostly-sorted larger list
+l = list(range(40)) + [20, 10, 30]
+l.sort()
+print(l)
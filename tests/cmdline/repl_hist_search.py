@@ -0,0 +1,4 @@
+# REPL tests of Ctrl-R history search
+print('hello')
+1 + 2
+pr
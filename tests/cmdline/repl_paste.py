@@ -0,0 +1,5 @@
+# REPL tests of bracketed paste
+[200~def f(x):
+    return x + 1
+[201~
+f(5)
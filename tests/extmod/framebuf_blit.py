@@ -0,0 +1,62 @@
+try:
+    import framebuf
+    import ubinascii
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def printbuf(buf):
+    print(ubinascii.hexlify(buf))
+
+
+# MONO_VLSB -> RGB565, with and without a transparent key
+src = framebuf.FrameBuffer(bytearray(b"\x0f\x05"), 2, 4, framebuf.MONO_VLSB)
+buf = bytearray(2 * 4 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 4, framebuf.RGB565)
+fbuf.fill(0x7FFF)
+fbuf.blit(src, 0, 0)
+printbuf(buf)
+fbuf.fill(0x7FFF)
+fbuf.blit(src, 0, 0, 0)
+printbuf(buf)
+
+# GS8 -> RGB565
+src = framebuf.FrameBuffer(bytearray(b"\x80\x81\x82\x83"), 2, 2, framebuf.GS8)
+buf = bytearray(2 * 2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.RGB565)
+fbuf.blit(src, 0, 0)
+printbuf(buf)
+fbuf.fill(0)
+fbuf.blit(src, 0, 0, 0x81)
+printbuf(buf)
+
+# RGB565 -> RGB565, clipped at negative offsets
+src = framebuf.FrameBuffer(bytearray(b"\x11\x22\x33\x44\x55\x66\x77\x88"), 2, 2, framebuf.RGB565)
+buf = bytearray(2 * 2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.RGB565)
+fbuf.blit(src, 0, 0)
+printbuf(buf)
+fbuf.fill(0)
+fbuf.blit(src, -1, -1)
+printbuf(buf)
+fbuf.fill(0)
+fbuf.blit(src, 0, 0, 0x4433)
+printbuf(buf)
+
+# GS8 -> GS8
+src = framebuf.FrameBuffer(bytearray(b"\x01\x02\x03\x04"), 2, 2, framebuf.GS8)
+buf = bytearray(2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.GS8)
+fbuf.blit(src, 0, 0)
+printbuf(buf)
+fbuf.fill(0xAA)
+fbuf.blit(src, 0, 0, 3)
+printbuf(buf)
+
+# generic fallback path: GS4_HMSB -> RGB565
+src = framebuf.FrameBuffer(bytearray(b"\x12\x34"), 2, 2, framebuf.GS4_HMSB)
+buf = bytearray(2 * 2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.RGB565)
+fbuf.blit(src, 0, 0)
+printbuf(buf)
@@ -0,0 +1,62 @@
+try:
+    import framebuf
+    import ubinascii
+
+    framebuf.FrameBuffer(bytearray(1), 1, 1, framebuf.GS8).blit_scaled
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def printbuf(buf):
+    print(ubinascii.hexlify(buf))
+
+
+# 2x1 source with distinct pixels
+src = framebuf.FrameBuffer(bytearray(b"\x01\x02"), 2, 1, framebuf.GS8)
+
+# scale 2, no rotation
+buf = bytearray(4 * 2)
+fbuf = framebuf.FrameBuffer(buf, 4, 2, framebuf.GS8)
+fbuf.blit_scaled(src, 0, 0, 2)
+printbuf(buf)
+
+# scale 1 with each rotation
+for rot in range(4):
+    buf = bytearray(2 * 2)
+    fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.GS8)
+    fbuf.blit_scaled(src, 0, 0, 1, -1, rot)
+    printbuf(buf)
+
+# rotation combined with scaling
+buf = bytearray(2 * 4)
+fbuf = framebuf.FrameBuffer(buf, 2, 4, framebuf.GS8)
+fbuf.blit_scaled(src, 0, 0, 2, -1, 1)
+printbuf(buf)
+
+# transparent key
+buf = bytearray(b"\xaa" * 8)
+fbuf = framebuf.FrameBuffer(buf, 4, 2, framebuf.GS8)
+fbuf.blit_scaled(src, 0, 0, 2, 1)
+printbuf(buf)
+
+# clipping at the edges
+buf = bytearray(2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 2, 2, framebuf.GS8)
+fbuf.blit_scaled(src, -1, -1, 2)
+printbuf(buf)
+fbuf.fill(0)
+fbuf.blit_scaled(src, 1, 1, 2)
+printbuf(buf)
+
+# into RGB565
+buf = bytearray(4 * 2 * 2)
+fbuf = framebuf.FrameBuffer(buf, 4, 2, framebuf.RGB565)
+fbuf.blit_scaled(src, 0, 0, 2)
+printbuf(buf)
+
+# invalid scale
+try:
+    fbuf.blit_scaled(src, 0, 0, 0)
+except ValueError:
+    print("ValueError")
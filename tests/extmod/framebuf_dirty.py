@@ -0,0 +1,67 @@
+try:
+    import framebuf
+
+    framebuf.FrameBuffer(bytearray(1), 1, 1, framebuf.GS8).get_dirty
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+fbuf = framebuf.FrameBuffer(bytearray(16 * 16), 16, 16, framebuf.GS8)
+
+# fresh buffer is clean
+print(fbuf.get_dirty())
+
+# single pixel
+fbuf.pixel(3, 4, 1)
+print(fbuf.get_dirty())
+
+# reading a pixel doesn't dirty
+fbuf.clear_dirty()
+fbuf.pixel(3, 4)
+print(fbuf.get_dirty())
+
+# rects accumulate into one bounding box
+fbuf.fill_rect(1, 2, 3, 4, 1)
+fbuf.fill_rect(10, 10, 2, 2, 1)
+print(fbuf.get_dirty())
+
+# marks are clipped to the framebuffer
+fbuf.clear_dirty()
+fbuf.fill_rect(-5, -5, 8, 8, 1)
+print(fbuf.get_dirty())
+fbuf.clear_dirty()
+fbuf.fill_rect(14, 14, 10, 10, 1)
+print(fbuf.get_dirty())
+
+# fully off-screen op stays clean
+fbuf.clear_dirty()
+fbuf.fill_rect(20, 20, 4, 4, 1)
+print(fbuf.get_dirty())
+
+# lines, hline/vline
+fbuf.clear_dirty()
+fbuf.line(2, 3, 7, 5, 1)
+print(fbuf.get_dirty())
+fbuf.clear_dirty()
+fbuf.hline(0, 8, 5, 1)
+fbuf.vline(8, 0, 5, 1)
+print(fbuf.get_dirty())
+
+# text
+fbuf.clear_dirty()
+fbuf.text("ab", 1, 1)
+print(fbuf.get_dirty())
+
+# blit marks only the clipped destination region
+src = framebuf.FrameBuffer(bytearray(4 * 4), 4, 4, framebuf.GS8)
+fbuf.clear_dirty()
+fbuf.blit(src, 14, 14)
+print(fbuf.get_dirty())
+
+# fill and scroll mark everything
+fbuf.clear_dirty()
+fbuf.fill(0)
+print(fbuf.get_dirty())
+fbuf.clear_dirty()
+fbuf.scroll(1, 0)
+print(fbuf.get_dirty())
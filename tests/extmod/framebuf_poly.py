@@ -0,0 +1,60 @@
+try:
+    import framebuf
+    from array import array
+
+    framebuf.FrameBuffer(bytearray(1), 1, 1, framebuf.GS8).polyline
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+W = 8
+H = 8
+
+
+def printbuf(buf):
+    for y in range(H):
+        print("".join(str(buf[y * W + x]) for x in range(W)))
+    print("-" * W)
+
+
+buf = bytearray(W * H)
+fbuf = framebuf.FrameBuffer(buf, W, H, framebuf.GS8)
+
+# open polyline: a zig-zag waveform
+fbuf.polyline(array("h", [0, 6, 2, 1, 4, 6, 6, 1, 7, 4]), 1)
+printbuf(buf)
+
+# same shape via individual line calls must match
+buf2 = bytearray(W * H)
+fbuf2 = framebuf.FrameBuffer(buf2, W, H, framebuf.GS8)
+pts = [(0, 6), (2, 1), (4, 6), (6, 1), (7, 4)]
+for i in range(len(pts) - 1):
+    fbuf2.line(pts[i][0], pts[i][1], pts[i + 1][0], pts[i + 1][1], 1)
+print(buf == buf2)
+
+# filled triangle, closed automatically
+fbuf.fill(0)
+fbuf.fill_poly(array("h", [1, 1, 6, 1, 1, 6]), 1)
+printbuf(buf)
+
+# filled quad clipped at the framebuffer edge
+fbuf.fill(0)
+fbuf.fill_poly(array("h", [-2, 2, 5, 2, 5, 5, -2, 5]), 1)
+printbuf(buf)
+
+# degenerate polygons draw nothing
+fbuf.fill(0)
+fbuf.fill_poly(array("h", [3, 3, 5, 5]), 1)
+print(buf == bytearray(W * H))
+
+# batches of horizontal and vertical runs
+fbuf.fill(0)
+fbuf.hlines(array("h", [0, 0, 3, 2, 2, 4, -1, 7, 3]), 1)
+fbuf.vlines(array("h", [7, 0, 3, 6, 5, 9]), 1)
+printbuf(buf)
+
+# wrong coordinate array type
+try:
+    fbuf.polyline(array("b", [0, 0, 1, 1]), 1)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,40 @@
+# test machine.atomic_load/store/add/cas
+
+try:
+    try:
+        import umachine as machine
+    except ImportError:
+        import machine
+    import uctypes
+
+    machine.atomic_cas
+except:
+    print("SKIP")
+    raise SystemExit
+
+buf = bytearray(8)
+addr = uctypes.addressof(buf)
+
+# load/store round trip
+machine.atomic_store(addr, 41)
+print(machine.atomic_load(addr))
+
+# add returns the previous value
+print(machine.atomic_add(addr, 1))
+print(machine.atomic_load(addr))
+
+# cas succeeds only when the expected value matches
+print(machine.atomic_cas(addr, 42, 100))
+print(machine.atomic_cas(addr, 42, 200))
+print(machine.atomic_load(addr))
+
+# values wrap at 32 bits
+machine.atomic_store(addr, 0xFFFFFFFF)
+print(machine.atomic_add(addr, 1))
+print(machine.atomic_load(addr))
+
+# unaligned addresses are rejected
+try:
+    machine.atomic_load(addr + 1)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,55 @@
+try:
+    try:
+        import umachine as machine
+    except ImportError:
+        import machine
+    machine.PinGroup
+except:
+    print("SKIP")
+    raise SystemExit
+
+
+class MyPin(machine.PinBase):
+    def __init__(self, name, v=0):
+        self.name = name
+        self.v = v
+
+    def value(self, v=None):
+        if v is None:
+            return self.v
+        self.v = int(v)
+        print("write", self.name, self.v)
+
+
+pins = [MyPin(i) for i in range(4)]
+g = machine.PinGroup(pins)
+print(g)
+
+# read: pin i is bit (1 << i)
+pins[0].v = 1
+pins[2].v = 1
+print(hex(g.value()))
+print(hex(g.read_all()))
+print(g() == g.value())
+
+# write all pins
+g.value(0b1010)
+print(hex(g.read_all()))
+
+# call form
+g(0b0101)
+print(hex(g.read_all()))
+
+# masked write only touches pins in the mask
+g.write_all(0b11, 0b0110)
+print(hex(g.read_all()))
+
+# groups implement the pin protocol, so they nest/invert via Signal
+s = machine.Signal(g)
+print(hex(s.value()))
+
+# bad constructions
+try:
+    machine.PinGroup([])
+except ValueError:
+    print("ValueError")
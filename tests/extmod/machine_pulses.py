@@ -0,0 +1,50 @@
+# test machine.time_pulses_us multi-edge capture
+try:
+    from array import array
+
+    try:
+        import umachine as machine
+    except ImportError:
+        import machine
+    machine.PinBase
+    machine.time_pulses_us
+except:
+    print("SKIP")
+    raise SystemExit
+
+
+class TogglePin(machine.PinBase):
+    # toggles on every read, so every poll sees an edge
+    def __init__(self):
+        self.v = 0
+
+    def value(self, v=None):
+        if v is None:
+            self.v = 1 - self.v
+            return self.v
+
+
+class ConstPin(machine.PinBase):
+    def __init__(self, value):
+        self.v = value
+
+    def value(self, v=None):
+        if v is None:
+            return self.v
+
+
+buf = array("I", 8 * [0])
+
+# a toggling pin fills the whole buffer
+n = machine.time_pulses_us(TogglePin(), buf)
+print(n)
+print(all(buf[i] <= buf[i + 1] for i in range(n - 1)))
+
+# a constant pin has no edges and times out with 0 captured
+print(machine.time_pulses_us(ConstPin(0), buf, 100))
+
+# the edge buffer must have 32-bit items
+try:
+    machine.time_pulses_us(TogglePin(), array("h", [0]))
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,36 @@
+try:
+    import netutils
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# RFC 1071 checksum of an IPv4 header with the checksum field zeroed.
+hdr = bytes(
+    [0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11]
+    + [0x00, 0x00, 0xC0, 0xA8, 0x00, 0x01, 0xC0, 0xA8, 0x00, 0xC7]
+)
+print(hex(netutils.checksum(hdr)))
+
+# odd length and empty buffer
+print(hex(netutils.checksum(b"\x01\x02\x03")))
+print(hex(netutils.checksum(b"")))
+
+# IPv4 round trips
+for s in ["192.168.0.1", "0.0.0.0", "255.255.255.255"]:
+    p = netutils.inet_pton(netutils.AF_INET, s)
+    print(p, netutils.inet_ntop(netutils.AF_INET, p))
+
+# IPv6 round trips, including '::' compression rules
+for s in ["fe80::1", "::", "::1", "1::", "1:0:0:2:0:0:0:3", "2001:db8:0:1:1:1:1:1"]:
+    p = netutils.inet_pton(netutils.AF_INET6, s)
+    print(p, netutils.inet_ntop(netutils.AF_INET6, p))
+
+# invalid addresses
+for s in ["1::2::3", ":::", "12345::", "g::", "1:2:3", "1:2:3:4:5:6:7:8:9"]:
+    try:
+        netutils.inet_pton(netutils.AF_INET6, s)
+        print("no error", s)
+    except ValueError:
+        print("ValueError")
+
+print("done")
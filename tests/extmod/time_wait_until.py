@@ -0,0 +1,20 @@
+try:
+    import utime
+
+    utime.wait_until, utime.ticks_add, utime.ticks_diff, utime.ticks_ms
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# Wait for a deadline a little in the future.
+t0 = utime.ticks_ms()
+late = utime.wait_until(utime.ticks_add(t0, 20))
+dt = utime.ticks_diff(utime.ticks_ms(), t0)
+print(dt >= 20)
+print(late >= 0)
+
+# A deadline in the past returns immediately with the overshoot.
+t0 = utime.ticks_ms()
+late = utime.wait_until(utime.ticks_add(t0, -50))
+print(utime.ticks_diff(utime.ticks_ms(), t0) < 50)
+print(late >= 50)
@@ -0,0 +1,65 @@
+# Test uasyncio.open()/FileStream, which does file I/O in chunks so that
+# other tasks can run during a large transfer.
+
+try:
+    import uos
+    import uasyncio as asyncio
+
+    asyncio.FileStream
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+_FILE = "uasyncio_fileio_test.tmp"
+
+# check for a writable filesystem
+try:
+    f = open(_FILE, "wb")
+    f.close()
+    uos.remove(_FILE)
+except OSError:
+    print("SKIP")
+    raise SystemExit
+
+
+async def ticker(flag):
+    while flag[0]:
+        flag[1] += 1
+        await asyncio.sleep_ms(0)
+
+
+async def main():
+    data = bytes(range(256)) * 64
+
+    # chunked write
+    fs = await asyncio.open(_FILE, "wb", chunk=256)
+    print(await fs.write(data))
+    await fs.flush()
+    fs.close()
+
+    # chunked read, with a concurrent task making progress during it
+    flag = [True, 0]
+    t = asyncio.create_task(ticker(flag))
+    async with await asyncio.open(_FILE, "rb", chunk=256) as fs:
+        r = await fs.read()
+    flag[0] = False
+    await t
+    print(len(r), r == data)
+    print("ticker ran:", flag[1] >= 16)
+
+    # bounded read, readinto, seek/tell and readline
+    async with await asyncio.open(_FILE, "rb", chunk=100) as fs:
+        r = await fs.read(250)
+        print(len(r))
+        buf = bytearray(300)
+        n = await fs.readinto(buf)
+        print(n, bytes(buf[:4]))
+        fs.seek(0)
+        print(fs.tell())
+        l = await fs.readline()
+        print(len(l))
+
+    uos.remove(_FILE)
+
+
+asyncio.run(main())
@@ -0,0 +1,30 @@
+# test ubinascii.hexlify_into, writing into a caller-provided buffer
+try:
+    import ubinascii as binascii
+
+    binascii.hexlify_into
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+data = bytes(range(256))
+buf = bytearray(2 * len(data))
+print(binascii.hexlify_into(data, buf))
+print(bytes(buf) == binascii.hexlify(data))
+
+# odd-length input
+buf = bytearray(6)
+print(binascii.hexlify_into(b"\x01\xab\xff", buf), buf)
+
+# output via memoryview, only the needed prefix is written
+buf = bytearray(b"x" * 8)
+print(binascii.hexlify_into(b"\xde\xad", memoryview(buf)), buf)
+
+# output buffer too small
+try:
+    binascii.hexlify_into(b"abc", bytearray(5))
+except ValueError:
+    print("ValueError")
+
+# empty input
+print(binascii.hexlify_into(b"", bytearray(0)))
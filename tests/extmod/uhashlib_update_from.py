@@ -0,0 +1,39 @@
+# test hash.update_from(stream, nbytes)
+try:
+    import uhashlib as hashlib
+    import uio as io
+
+    hashlib.sha256().update_from
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+data = b"0123456789" * 123
+
+# hash a whole stream to EOF
+h = hashlib.sha256()
+n = h.update_from(io.BytesIO(data))
+print(n, h.digest() == hashlib.sha256(data).digest())
+
+# hash a bounded prefix of a stream
+h = hashlib.sha256()
+n = h.update_from(io.BytesIO(data), 700)
+print(n, h.digest() == hashlib.sha256(data[:700]).digest())
+
+# explicit None reads to EOF, and mixing with update() works
+h = hashlib.sha256()
+h.update(data[:100])
+n = h.update_from(io.BytesIO(data[100:]), None)
+print(n, h.digest() == hashlib.sha256(data).digest())
+
+# asking for more than the stream has stops at EOF
+h = hashlib.sha256()
+print(h.update_from(io.BytesIO(b"abc"), 1000))
+
+# finalised hash can't be updated from a stream
+h = hashlib.sha256(b"abc")
+h.digest()
+try:
+    h.update_from(io.BytesIO(b"def"))
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,52 @@
+try:
+    import uheapq as heapq
+except:
+    try:
+        import heapq
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+try:
+    heapq.heappushpop
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# heappushpop on an empty heap just returns the item
+h = []
+print(heapq.heappushpop(h, 3), h)
+
+# heappushpop with an item smaller than the root returns the item
+h = [1, 3, 2]
+print(heapq.heappushpop(h, 0), h)
+
+# heappushpop with an item larger than the root pops the root
+h = [1, 3, 2]
+print(heapq.heappushpop(h, 5))
+print(sorted(h))
+
+# heapreplace always pops the root
+h = [1, 3, 2]
+print(heapq.heapreplace(h, 0))
+print(sorted(h))
+
+try:
+    heapq.heapreplace([], 1)
+except IndexError:
+    print("IndexError")
+
+# nsmallest/nlargest return sorted selections
+l = [7, 3, 9, 1, 8, 5, 2, 6, 4, 0]
+print(heapq.nsmallest(3, l))
+print(heapq.nlargest(3, l))
+print(heapq.nsmallest(0, l))
+print(heapq.nlargest(20, l))
+print(heapq.nsmallest(4, iter(range(50, 0, -1))))
+
+# (priority, item) tuple entries, including equal priorities
+h = []
+for entry in [(3, "c"), (1, "a"), (2, "b"), (1, "A")]:
+    heapq.heappush(h, entry)
+print([heapq.heappop(h) for _ in range(len(h))])
+print(heapq.nsmallest(2, [(5, "x"), (4, "y"), (4, "X"), (6, "z")]))
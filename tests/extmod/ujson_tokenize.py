@@ -0,0 +1,42 @@
+try:
+    import uio as io
+    import ujson as json
+
+    json.tokenize
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+doc = '{"a": 1, "b": [true, null, {"c": "x\\n"}], "d": -2.5}'
+
+# Walk the whole document as events.
+tok = json.tokenize(io.StringIO(doc))
+for ev in tok:
+    if ev in ("key", "value"):
+        print(ev, tok.value)
+    else:
+        print(ev)
+
+# Pull just the subtree under a selected key, then keep iterating.
+tok = json.tokenize(io.StringIO(doc))
+for ev in tok:
+    if ev == "key" and tok.value == "b":
+        print("subtree", tok.load())
+        break
+print(list(tok))
+
+# A document that is a single scalar.
+tok = json.tokenize(io.StringIO(" 42 "))
+print(list(tok), tok.value)
+
+# load() of the whole document.
+print(json.tokenize(io.StringIO("[1, [2, 3]]")).load())
+
+# Malformed documents raise ValueError.
+for bad in ['{"a": 1', "[1}", "{1: 2}", "[] []"]:
+    try:
+        for ev in json.tokenize(io.StringIO(bad)):
+            pass
+        print("no exception")
+    except ValueError:
+        print("ValueError")
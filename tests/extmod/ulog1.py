@@ -0,0 +1,50 @@
+try:
+    import uio
+    import ulog
+    import micropython
+
+    micropython.heap_lock
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# with the scheduler enabled records drain asynchronously, so the manual
+# drain counts tested here are not deterministic
+if hasattr(micropython, "schedule"):
+    print("SKIP")
+    raise SystemExit
+
+# default level is WARNING: these are discarded before any capture
+ulog.debug("not seen {}", 1)
+ulog.info("not seen")
+print(ulog.drain())
+
+ulog.set_level(ulog.DEBUG)
+ulog.debug("d {} {}", 1, "two")
+ulog.info("i {{}} {}", [1, 2])
+ulog.warning("w")
+ulog.error("e {} end", 42)
+ulog.log(35, "custom {}", True)
+print(ulog.drain())
+print(ulog.drain())
+
+# logging allocates nothing once the ring exists
+ulog.set_level(ulog.WARNING)
+micropython.heap_lock()
+ulog.debug("filtered")
+ulog.error("logged with heap locked: {} {}", 7, "str")
+micropython.heap_unlock()
+print(ulog.drain())
+
+# ring overflow drops the oldest records and reports it on the next drain
+ulog.set_level(ulog.DEBUG)
+for i in range(20):
+    ulog.info("rec")
+print(ulog.drain())
+
+# drain to an explicit stream
+stream = uio.StringIO()
+ulog.set_stream(stream)
+ulog.error("to stream {}", 9)
+ulog.drain()
+print(repr(stream.getvalue()))
@@ -0,0 +1,22 @@
+# test uparallel.map
+try:
+    import uparallel
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# basic map over a range
+print(uparallel.map(lambda i: i * i, 8))
+
+# empty range
+print(uparallel.map(lambda i: i, 0))
+
+# explicit worker count, enough work to exercise chunk claiming
+res = uparallel.map(lambda i: i + 1, 1000, 4)
+print(len(res), res[0], res[-1], sum(res))
+
+# an exception in a worker propagates to the caller
+try:
+    uparallel.map(lambda i: 1 // (i - 50), 100, 4)
+except ZeroDivisionError:
+    print("ZeroDivisionError")
@@ -0,0 +1,35 @@
+try:
+    import urandom as random
+except ImportError:
+    try:
+        import random
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+try:
+    random.fill
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# fill an odd-sized buffer in place
+buf = bytearray(33)
+print(random.fill(buf))
+print(len(buf))
+
+# seeding makes the output reproducible
+random.seed(42)
+a = bytearray(16)
+random.fill(a)
+random.seed(42)
+b = bytearray(16)
+random.fill(b)
+print(a == b)
+
+# the buffer was actually written to
+print(any(a))
+
+# filling an empty buffer is a no-op
+random.fill(bytearray(0))
+print("done")
@@ -0,0 +1,33 @@
+# test finditer() of the ure module
+try:
+    import ure as re
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+try:
+    re.finditer
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# iterate over all matches, with a group
+for m in re.compile(r"(\d+):\d+").finditer("12:30 no 1:45 end 10:00"):
+    print(m.group(0), m.group(1))
+
+# module-level form with a pattern string
+for m in re.finditer(r"[a-c]+", "abxcaxbb"):
+    print(m.group(0))
+
+# no matches at all
+print(list(re.finditer("x", "abc")))
+
+# empty matches advance by one character and don't loop forever
+print(sum(1 for m in re.finditer("a*", "baab")))
+
+# the match object is recycled for each result, so it must be used
+# (or copied) before the next iteration step
+it = re.finditer("[ab]", "ab")
+m1 = next(it)
+m2 = next(it)
+print(m1 is m2, m2.group(0))
@@ -7,7 +7,11 @@ except ImportError:
         print("SKIP")
         raise SystemExit
 
+# The backtracking engine raises RuntimeError when the pattern nests too
+# deeply; the Pike VM executor matches it in linear time.  Either way the
+# pathological pattern must not crash the interpreter.
 try:
     re.match("(a*)*", "aaa")
 except RuntimeError:
-    print("RuntimeError")
+    pass
+print("done")
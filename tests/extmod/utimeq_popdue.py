@@ -0,0 +1,44 @@
+# Test utimeq.pop_all_due(), which drains all due entries in one call.
+try:
+    from utime import ticks_add
+    from utimeq import utimeq
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+try:
+    utimeq.pop_all_due
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+h = utimeq(10)
+
+# Out list must be a list
+try:
+    h.pop_all_due(0, None)
+    assert False
+except TypeError:
+    pass
+
+# Empty heap pops nothing
+out = []
+print(h.pop_all_due(0, out), out)
+
+# Entries pushed out of order come back in scheduling order, only due ones
+for t in (30, 10, 20, 40, 10):
+    h.push(t, "cb%d" % t, t)
+n = h.pop_all_due(20, out)
+print(n, out)
+print(len(h), h.peektime())
+
+# Draining the rest leaves an empty heap
+out2 = []
+print(h.pop_all_due(100, out2), out2)
+print(len(h))
+
+# Wraparound: an entry just before the tick rollover is due just after it
+MAX = ticks_add(0, -1)
+h.push(MAX, "wrap", None)
+out3 = []
+print(h.pop_all_due(5, out3), out3[0])
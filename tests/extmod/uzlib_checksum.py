@@ -0,0 +1,27 @@
+try:
+    import uzlib as zlib
+except ImportError:
+    try:
+        import zlib
+    except ImportError:
+        print("SKIP")
+        raise SystemExit
+
+try:
+    zlib.crc32
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+print(hex(zlib.crc32(b"")))
+print(hex(zlib.crc32(b"The quick brown fox jumps over the lazy dog")))
+print(hex(zlib.adler32(b"")))
+print(hex(zlib.adler32(b"The quick brown fox jumps over the lazy dog")))
+
+# incremental computation gives the same result as one shot
+data = b"0123456789" * 100
+print(zlib.crc32(data[500:], zlib.crc32(data[:500])) == zlib.crc32(data))
+print(zlib.adler32(data[500:], zlib.adler32(data[:500])) == zlib.adler32(data))
+
+# any buffer-protocol object is accepted
+print(zlib.crc32(bytearray(b"abc")) == zlib.crc32(b"abc"))
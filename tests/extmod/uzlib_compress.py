@@ -0,0 +1,47 @@
+# test compress() and CompIO of the uzlib module
+try:
+    import uzlib as zlib
+    import uio as io
+
+    zlib.compress
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+data = b"micropython " * 50
+
+# one-shot zlib roundtrip
+z = zlib.compress(data)
+print(len(z) < len(data), zlib.decompress(z) == data)
+
+# raw DEFLATE roundtrip with a small window
+z = zlib.compress(data, -8)
+print(zlib.decompress(z, -8) == data)
+
+# streaming compression into an underlying stream, in several chunks
+out = io.BytesIO()
+c = zlib.CompIO(out)
+c.write(data[:100])
+c.write(data[100:400])
+c.write(data[400:])
+c.close()
+print(zlib.decompress(out.getvalue()) == data)
+
+# writing after close is an error
+try:
+    c.write(b"x")
+except OSError:
+    print("OSError")
+
+# empty input
+print(zlib.decompress(zlib.compress(b"")))
+
+# incompressible input still roundtrips
+rnd = bytes((i * 97 + 13) & 0xFF for i in range(500))
+print(zlib.decompress(zlib.compress(rnd)) == rnd)
+
+# invalid window size
+try:
+    zlib.compress(data, 20)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,35 @@
+# test DecompIO with a source read buffer and a caller-provided window
+try:
+    import uzlib as zlib
+    import uio as io
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+try:
+    zlib.DecompIO(io.BytesIO(b"\xcbH\xcd\xc9\xc9\x07\x00"), -8, 16)
+except TypeError:
+    print("SKIP")
+    raise SystemExit
+
+# zlib bitstream with buffered source reads
+inp = zlib.DecompIO(io.BytesIO(b"x\x9c30\xa0=\x00\x00\xb3q\x12\xc1"), 0, 64)
+print(inp.read())
+
+# raw DEFLATE bitstream with the window in a caller-provided buffer
+win = bytearray(256)
+inp = zlib.DecompIO(io.BytesIO(b"\xcbH\xcd\xc9\xc9\x07\x00"), win, 16)
+print(inp.read())
+
+# buffered reads consume the source in blocks, so the source position is
+# past the end of the compressed data once output is exhausted
+buf = io.BytesIO(b"\xcbH\xcd\xc9\xc9\x07\x00" + b"trailing")
+inp = zlib.DecompIO(buf, -8, 64)
+print(inp.read())
+print(buf.seek(0, 1) > 7)
+
+# invalid buffer size
+try:
+    zlib.DecompIO(io.BytesIO(b""), 0, 0)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,115 @@
+# Test for VfsBundle using an in-memory bundle image
+
+try:
+    import uos, ustruct, uzlib
+
+    uos.VfsBundle
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+BUNDLE_MAGIC = 0x3142504D  # "MPB1"
+FLAG_COMPRESSED = 0x80000000
+
+
+def mkbundle(files):
+    # files: list of (name, data, file_len) tuples; file_len has
+    # FLAG_COMPRESSED set when data is a raw deflate stream
+    files = sorted(files)
+    names = b""
+    name_off = []
+    for name, _, _ in files:
+        name_off.append(len(names))
+        names += name + b"\x00"
+    index_end = 8 + 16 * len(files)
+    bundle = ustruct.pack("<II", BUNDLE_MAGIC, len(files))
+    data = b""
+    for i, (name, d, file_len) in enumerate(files):
+        bundle += ustruct.pack(
+            "<IIII", index_end + name_off[i], index_end + len(names) + len(data), len(d), file_len
+        )
+        data += d
+    return bundle + names + data
+
+
+# raw deflate stream of b"compressed bundle data\n" * 8
+comp_data = b"K\xce\xcf-(J-.NMQH*\xcdK\xc9IUHI,I\xe4J\x1e\xec\xc2\x00"
+
+bundle = mkbundle(
+    [
+        (b"hello.txt", b"hello bundle\n", 13),
+        (b"comp.txt", comp_data, 23 * 8 | FLAG_COMPRESSED),
+        (b"lib/bundle_mod.py", b"print('bundle_mod imported')\n", 29),
+        (b"lib/pkg/__init__.py", b"print('bundle pkg imported')\n", 29),
+        (b"zdata.bin", bytes(range(8)), 8),
+    ]
+)
+
+# construction
+vfs = uos.VfsBundle(bundle)
+
+# statvfs
+print(vfs.statvfs("/"))
+
+# ilistdir
+print(list(vfs.ilistdir()))
+print(list(vfs.ilistdir("/")))
+print(list(vfs.ilistdir(b"/")))
+print(list(vfs.ilistdir("lib")))
+
+# stat a file, a dir and the root
+print(vfs.stat("hello.txt"))
+print(vfs.stat("/lib/pkg"))
+print(vfs.stat("/"))
+
+# open and read, text and binary
+with vfs.open("hello.txt", "r") as f:
+    print(f.read())
+with vfs.open("/zdata.bin", "rb") as f:
+    print(f.read())
+
+# read in pieces, readline, seek/tell
+f = vfs.open("hello.txt", "r")
+print(f.read(5))
+print(f.tell())
+f.seek(0)
+print(f.readline())
+f.seek(-7, 2)
+print(f.read(20))
+f.close()
+
+# open and read a compressed entry
+with vfs.open("comp.txt", "r") as f:
+    data = f.read()
+    print(len(data), data[:23])
+
+# getcwd, chdir
+print(vfs.getcwd())
+vfs.chdir("lib")
+print(vfs.getcwd())
+print(list(vfs.ilistdir()))
+with vfs.open("bundle_mod.py", "r") as f:
+    print(f.readline())
+vfs.chdir("pkg")
+print(vfs.getcwd())
+vfs.chdir("..")
+print(vfs.getcwd())
+vfs.chdir("./pkg/../../lib/.//pkg")
+print(vfs.getcwd())
+vfs.chdir("/")
+print(vfs.getcwd())
+
+# mount and access through uos
+uos.mount(vfs, "/bundle")
+print(sorted(uos.listdir("/bundle")))
+with open("/bundle/hello.txt") as f:
+    print(f.read())
+
+# import from the mounted bundle
+import sys
+
+sys.path.append("/bundle/lib")
+import bundle_mod
+import pkg
+
+uos.umount("/bundle")
@@ -0,0 +1,128 @@
+# Test for VfsBundle error handling
+
+try:
+    import uos, ustruct, uerrno
+
+    uos.VfsBundle
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+BUNDLE_MAGIC = 0x3142504D
+
+
+def mkbundle(files):
+    files = sorted(files)
+    names = b""
+    name_off = []
+    for name, _ in files:
+        name_off.append(len(names))
+        names += name + b"\x00"
+    index_end = 8 + 16 * len(files)
+    bundle = ustruct.pack("<II", BUNDLE_MAGIC, len(files))
+    data = b""
+    for i, (name, d) in enumerate(files):
+        bundle += ustruct.pack(
+            "<IIII", index_end + name_off[i], index_end + len(names) + len(data), len(d), len(d)
+        )
+        data += d
+    return bundle + names + data
+
+
+# construction with a buffer that's too short
+try:
+    uos.VfsBundle(b"MPB1")
+except OSError as er:
+    print("make_new short", er.args[0] == uerrno.ENODEV)
+
+# construction with bad magic
+try:
+    uos.VfsBundle(b"NOTB" + bytes(12))
+except OSError as er:
+    print("make_new magic", er.args[0] == uerrno.ENODEV)
+
+# construction with a misaligned buffer
+try:
+    uos.VfsBundle(memoryview(b"xMPB1" + bytes(12))[1:])
+except OSError as er:
+    print("make_new align", er.args[0] == uerrno.ENODEV)
+
+# construction with an index larger than the buffer
+try:
+    uos.VfsBundle(ustruct.pack("<II", BUNDLE_MAGIC, 100))
+except OSError as er:
+    print("make_new count", er.args[0] == uerrno.ENODEV)
+
+vfs = uos.VfsBundle(mkbundle([(b"testfile", b"contents"), (b"testdir/sub", b"x")]))
+
+# open nonexistent
+try:
+    vfs.open("noexist", "r")
+except OSError as er:
+    print("open OSError", er.args[0] == uerrno.ENOENT)
+
+# open a directory
+try:
+    vfs.open("testdir", "r")
+except OSError as er:
+    print("open OSError", er.args[0] == uerrno.EISDIR)
+
+# open for writing; the filesystem is read-only
+for mode in ("w", "a", "x", "r+"):
+    try:
+        vfs.open("testfile", mode)
+    except OSError as er:
+        print("open OSError", er.args[0] == 30)  # uerrno.EROFS
+
+# write to an open file
+with vfs.open("testfile", "r") as f:
+    try:
+        f.write("data")
+    except OSError as er:
+        print("write OSError", er.args[0] == 30)  # uerrno.EROFS
+
+# ilistdir of nonexistent dir, and of a file
+try:
+    vfs.ilistdir("noexist")
+except OSError as er:
+    print("ilistdir OSError", er.args[0] == uerrno.ENOENT)
+try:
+    vfs.ilistdir("testfile")
+except OSError as er:
+    print("ilistdir OSError", er.args[0] == 20)  # uerrno.ENOTDIR
+
+# chdir to nonexistent dir, and to a file
+try:
+    vfs.chdir("noexist")
+except OSError as er:
+    print("chdir OSError", er.args[0] == uerrno.ENOENT)
+print(vfs.getcwd())  # check still at root
+try:
+    vfs.chdir("testfile")
+except OSError as er:
+    print("chdir OSError", er.args[0] == uerrno.ENOENT)
+print(vfs.getcwd())  # check still at root
+
+# stat nonexistent
+try:
+    vfs.stat("noexist")
+except OSError as er:
+    print("stat OSError", er.args[0] == uerrno.ENOENT)
+
+# seek out of range
+f = vfs.open("testfile", "r")
+try:
+    f.seek(-1)
+except OSError as er:
+    print("seek OSError", er.args[0] == uerrno.EINVAL)
+try:
+    f.seek(9, 1)
+except OSError as er:
+    print("seek OSError", er.args[0] == uerrno.EINVAL)
+
+# access after close
+f.close()
+try:
+    f.read()
+except ValueError:
+    print("read ValueError")
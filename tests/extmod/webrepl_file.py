@@ -0,0 +1,131 @@
+try:
+    import uio
+    import uos
+    import ustruct
+    import ubinascii
+    import uwebsocket
+    import _webrepl
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+# a bidirectional stream: the test feeds rbuf, the webrepl writes to wbuf
+class Pipe(uio.IOBase):
+    def __init__(self):
+        self.rbuf = b""
+        self.wbuf = b""
+
+    def readinto(self, buf):
+        n = min(len(buf), len(self.rbuf))
+        for i in range(n):
+            buf[i] = self.rbuf[i]
+        self.rbuf = self.rbuf[n:]
+        return n
+
+    def write(self, buf):
+        self.wbuf += buf
+        return len(buf)
+
+    def take_output(self):
+        out = self.wbuf
+        self.wbuf = b""
+        return out
+
+
+# construct an unmasked client->server websocket frame
+def frame(op, payload):
+    if len(payload) < 126:
+        return bytes([op, len(payload)]) + payload
+    return bytes([op, 126, len(payload) >> 8, len(payload) & 0xFF]) + payload
+
+
+# split a server->client byte stream into (opcode, payload) frames
+def frames(buf):
+    out = []
+    while buf:
+        op = buf[0] & 0x0F
+        sz = buf[1]
+        i = 2
+        if sz == 126:
+            sz = (buf[2] << 8) | buf[3]
+            i = 4
+        out.append((op, buf[i : i + sz]))
+        buf = buf[i + sz :]
+    return out
+
+
+def file_hdr(op, flags, fname, size):
+    return ustruct.pack("<2sBBQIH64s", b"WA", op, flags, 0, size, len(fname), fname)
+
+
+pipe = Pipe()
+_webrepl.password("test")
+wr = _webrepl._webrepl(uwebsocket.websocket(pipe))
+print(frames(pipe.take_output()))
+pipe.rbuf += frame(0x81, b"test\n")
+wr.read(1)
+print(frames(pipe.take_output()))
+
+# put a file
+data = bytes(range(64)) * 20
+pipe.rbuf += frame(0x82, file_hdr(1, 0, b"webrepl.tst", len(data)))
+pipe.rbuf += frame(0x82, data)
+wr.read(1)
+print(frames(pipe.take_output()))
+with open("webrepl.tst", "rb") as f:
+    print(f.read() == data)
+
+# get it back, stop-and-wait (one chunk per ack)
+pipe.rbuf += frame(0x82, file_hdr(2, 0, b"webrepl.tst", 0))
+wr.read(1)
+print(frames(pipe.take_output()))
+got = b""
+acks = 0
+while True:
+    pipe.rbuf += frame(0x82, b"\x00")
+    wr.read(1)
+    fs = frames(pipe.take_output())
+    acks += 1
+    payload = fs[0][1]
+    got += payload[2:]
+    if payload[0] | (payload[1] << 8) == 0:
+        print(fs)
+        break
+print(acks, got == data)
+
+# get it back, windowed (a whole window of chunks plus its CRC per ack)
+pipe.rbuf += frame(0x82, file_hdr(2, 1, b"webrepl.tst", 0))
+wr.read(1)
+print(frames(pipe.take_output()))
+pipe.rbuf += frame(0x82, b"\x00")
+wr.read(1)
+fs = frames(pipe.take_output())
+print([len(p) for op, p in fs])
+print(b"".join(p[2:] for op, p in fs[:6]) == data)
+print(fs[6][1] == ustruct.pack("<I", ubinascii.crc32(data) & 0xFFFFFFFF))
+print(fs[7][1])
+
+# a file larger than one window: one CRC per window
+data = bytes(range(256)) * 12  # 3072 bytes, 8 chunks + 4 chunks
+with open("webrepl.tst", "wb") as f:
+    f.write(data)
+pipe.rbuf += frame(0x82, file_hdr(2, 1, b"webrepl.tst", 0))
+wr.read(1)
+got = b""
+crcs = []
+for _ in range(2):
+    pipe.rbuf += frame(0x82, b"\x00")
+    wr.read(1)
+    fs = frames(pipe.take_output())
+    print([len(p) for op, p in fs])
+    for op, p in fs:
+        if len(p) >= 2 and (p[0] | (p[1] << 8)) == len(p) - 2:
+            got += p[2:]
+        elif len(p) == 4 and p != b"WB\x00\x00":
+            crcs.append(p)
+print(got == data)
+print(crcs[0] == ustruct.pack("<I", ubinascii.crc32(data[:2048]) & 0xFFFFFFFF))
+print(crcs[1] == ustruct.pack("<I", ubinascii.crc32(data[2048:]) & 0xFFFFFFFF))
+
+uos.remove("webrepl.tst")
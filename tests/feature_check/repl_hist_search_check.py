@@ -0,0 +1,5 @@
+# Check for Ctrl-R history search in REPL
+t = 0
+t = t + 1
+t
+t == 2
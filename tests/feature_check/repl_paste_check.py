@@ -0,0 +1,3 @@
+# Check for bracketed paste in REPL
+[200~t = 11[201~
+t == 11
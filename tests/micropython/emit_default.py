@@ -0,0 +1,26 @@
+# test micropython.emit() to change the default code emitter
+
+import micropython
+
+try:
+    micropython.emit
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+saved = micropython.emit()
+
+micropython.emit("native")
+print(micropython.emit())
+exec("def f(n):\n    return n + 1")
+print(f(41))
+
+micropython.emit("bytecode")
+print(micropython.emit())
+
+try:
+    micropython.emit("jit")
+except ValueError:
+    print("ValueError")
+
+micropython.emit(saved)
@@ -0,0 +1,37 @@
+# test arithmetic in native functions, in particular the small-int fast path
+
+
+@micropython.native
+def add(a, b):
+    return a + b
+
+
+@micropython.native
+def sub(a, b):
+    return a - b
+
+
+# values around the small-int boundaries, and big ints
+vals = [0, 1, -1, 100, 2**30 - 1, -(2**30), 2**62 - 1, -(2**62), 2**80, -(2**80)]
+for a in vals:
+    for b in vals:
+        print(add(a, b), sub(a, b))
+
+# fall back to the runtime for non-int types
+print(add("abc", "def"))
+print(add([1], [2]))
+print(add(2.5, 1))
+print(sub(2.5, 1))
+
+
+# augmented assignment in a loop
+@micropython.native
+def count():
+    i = 0
+    for _ in range(10):
+        i += 3
+        i -= 1
+    return i
+
+
+print(count())
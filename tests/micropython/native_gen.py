@@ -23,3 +23,52 @@ def gen2(x):
 
 
 print(list(gen2(3)))
+
+# a yield inside a finally, with an exception propagating through it
+@micropython.native
+def gen3():
+    try:
+        raise ValueError(1)
+    finally:
+        yield 2
+
+
+g = gen3()
+print(next(g))
+try:
+    next(g)
+except ValueError as e:
+    print("ValueError", e.args[0])
+
+# yield from inside a finally
+@micropython.native
+def gen4():
+    try:
+        raise ValueError(2)
+    finally:
+        yield from range(2)
+
+
+g = gen4()
+print(next(g))
+print(next(g))
+try:
+    next(g)
+except ValueError as e:
+    print("ValueError", e.args[0])
+
+# returning via a finally that yields
+@micropython.native
+def gen5():
+    try:
+        return 3
+    finally:
+        yield 4
+
+
+g = gen5()
+print(next(g))
+try:
+    next(g)
+except StopIteration as e:
+    print(e.args[0])
@@ -0,0 +1,31 @@
+# test native functions with more locals than available registers
+
+import micropython
+
+
+@micropython.native
+def f(n):
+    a = 0
+    b = 1
+    c = 2
+    d = 3
+    e = 4
+    g = 5
+    h = 6
+    for i in range(n):
+        a += b + c + d + e + g + h
+    return a
+
+
+print(f(10))
+
+
+@micropython.native
+def g(x, y, z):
+    t0 = x + y
+    t1 = y + z
+    t2 = z + x
+    return t0 * t1 * t2
+
+
+print(g(1, 2, 3))
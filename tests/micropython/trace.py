@@ -0,0 +1,44 @@
+# test micropython.trace_drain and the binary trace record format
+
+import micropython
+
+try:
+    import uio
+    import ustruct
+
+    micropython.trace_drain
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+import gc
+
+# discard records accumulated during start-up
+micropython.trace_drain(uio.BytesIO())
+
+gc.collect()
+for i in range(10):
+    b = bytearray(400)  # garbage for the next sweep to reclaim
+gc.collect()
+
+buf = uio.BytesIO()
+micropython.trace_drain(buf)
+data = buf.getvalue()
+
+# records are fixed size
+print(len(data) % 16)
+
+events = []
+for i in range(0, len(data), 16):
+    ev, _, arg16, ticks, arg0, arg1 = ustruct.unpack_from("<BBHIII", data, i)
+    events.append((ev, arg16, arg0))
+
+# both collections produced a start and an end record
+evs = [e[0] for e in events]
+print(evs.count(1) >= 2, evs.count(2) >= 2)
+
+# the second sweep reclaimed the bytearrays
+print(any(e[0] == 2 and e[2] > 0 for e in events))
+
+# the allocations were counted in at least one size class
+print(any(e[0] == 4 for e in events))
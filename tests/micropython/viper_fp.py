@@ -0,0 +1,68 @@
+# test the viper "fp" type, which holds a machine float
+
+# check that the fp type is supported on this build
+try:
+    exec("@micropython.viper\ndef f(x: fp) -> fp:\n    return x")
+except ViperTypeError:
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.viper
+def arith(x: fp, y: fp):
+    print(x + y)
+    print(x - y)
+    print(x * y)
+    print(x / y)
+
+
+arith(1.5, 2.0)
+arith(-4.0, 0.25)
+
+
+@micropython.viper
+def comp(x: fp, y: fp):
+    if x < y:
+        print("<")
+    if x > y:
+        print(">")
+    if x == y:
+        print("==")
+    if x <= y:
+        print("<=")
+    if x >= y:
+        print(">=")
+    if x != y:
+        print("!=")
+
+
+comp(1.0, 2.0)
+comp(2.0, 1.0)
+comp(1.5, 1.5)
+
+
+@micropython.viper
+def unary(x: fp):
+    print(+x)
+    print(-x)
+
+
+unary(2.5)
+
+
+@micropython.viper
+def cast(x) -> fp:
+    return fp(x) * fp(2.0)
+
+
+print(cast(1.25))
+
+
+@micropython.viper
+def local_store(x: fp) -> fp:
+    y = x
+    y += fp(1.0)
+    return y
+
+
+print(local_store(2.0))
@@ -0,0 +1,46 @@
+# Measure dict operations: store, lookup, membership and iteration over a
+# mixed set of int and str keys.
+
+
+def benchmark(n):
+    d = {}
+    for i in range(n):
+        d[i & 0x3FF] = i
+    x = 0
+    for i in range(n):
+        x += d[i & 0x3FF]
+    names = ("alpha", "beta", "gamma", "delta")
+    s = {}
+    for i in range(n):
+        s[names[i & 3]] = i
+        if names[i & 1] in s:
+            x += 1
+    for k in d:
+        x += k
+    return x
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 2000),
+    (50, 25): (2, 5000),
+    (100, 100): (4, 10000),
+    (1000, 1000): (20, 100000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+    state = 0
+
+    def run():
+        nonlocal state
+        for _ in range(nloop):
+            state = benchmark(n)
+
+    def result():
+        return nloop * n, state
+
+    return run, result
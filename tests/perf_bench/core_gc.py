@@ -0,0 +1,41 @@
+# Measure allocation and collection: churn the heap with short-lived
+# containers while keeping a bounded working set alive, then collect.
+
+import gc
+
+
+def benchmark(n):
+    keep = []
+    for i in range(n):
+        keep.append([0] * 16)
+        if len(keep) > 32:
+            keep.pop(0)
+    gc.collect()
+    return len(keep)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 2000),
+    (50, 25): (2, 5000),
+    (100, 100): (4, 10000),
+    (1000, 1000): (20, 100000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+    state = 0
+
+    def run():
+        nonlocal state
+        for _ in range(nloop):
+            state = benchmark(n)
+
+    def result():
+        # gc behaviour is port specific, don't compare against CPython
+        return nloop * n, None
+
+    return run, result
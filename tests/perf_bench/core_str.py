@@ -0,0 +1,40 @@
+# Measure string operations: join, replace, find, split and formatting,
+# dominated by the str implementation rather than the VM loop.
+
+
+def benchmark(n):
+    words = "the quick brown fox jumps over the lazy dog".split(" ")
+    x = 0
+    for i in range(n):
+        s = "-".join(words)
+        s = s.replace("-", " ")
+        x += s.find("fox")
+        x += len(s.split(" "))
+        x += len("%s:%d" % (words[i % 9], i))
+    return x
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 400),
+    (50, 25): (2, 1000),
+    (100, 100): (4, 2000),
+    (1000, 1000): (20, 20000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+    state = 0
+
+    def run():
+        nonlocal state
+        for _ in range(nloop):
+            state = benchmark(n)
+
+    def result():
+        return nloop * n, state
+
+    return run, result
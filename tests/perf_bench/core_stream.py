@@ -0,0 +1,49 @@
+# Measure stream throughput: write an in-memory stream in fixed-size chunks
+# then read it back, exercising the stream protocol rather than the VM loop.
+
+try:
+    import uio as io
+except ImportError:
+    import io
+
+
+def benchmark(n):
+    data = b"x" * 256
+    f = io.BytesIO()
+    for _ in range(n):
+        f.write(data)
+    f.seek(0)
+    x = 0
+    while True:
+        buf = f.read(256)
+        if not buf:
+            break
+        x += len(buf)
+    return x
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 100),
+    (50, 25): (2, 250),
+    (100, 100): (4, 500),
+    (1000, 1000): (20, 5000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+    state = 0
+
+    def run():
+        nonlocal state
+        for _ in range(nloop):
+            state = benchmark(n)
+
+    def result():
+        # norm is the number of bytes moved (written and read back)
+        return 2 * nloop * n * 256, state
+
+    return run, result
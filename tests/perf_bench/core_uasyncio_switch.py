@@ -0,0 +1,45 @@
+# Measure the uasyncio task switch rate: two tasks that do nothing but
+# yield control back to the scheduler.
+
+import uasyncio
+
+
+async def switcher(n):
+    for _ in range(n):
+        await uasyncio.sleep_ms(0)
+
+
+async def main(n):
+    t1 = uasyncio.create_task(switcher(n))
+    t2 = uasyncio.create_task(switcher(n))
+    await t1
+    await t2
+
+
+def benchmark(n):
+    uasyncio.run(main(n))
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 1000),
+    (50, 25): (2, 2500),
+    (100, 100): (4, 5000),
+    (1000, 1000): (20, 50000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+
+    def run():
+        for _ in range(nloop):
+            benchmark(n)
+
+    def result():
+        # norm is the number of task switches; no CPython equivalent
+        return 2 * nloop * n, None
+
+    return run, result
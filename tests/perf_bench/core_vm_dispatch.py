@@ -0,0 +1,37 @@
+# Measure raw VM opcode dispatch: a tight bytecode loop of small-int
+# arithmetic and comparisons, with no heap allocation once running.
+
+
+def benchmark(n):
+    x = 0
+    i = 0
+    while i < n:
+        x = x + i
+        i = i + 1
+    return x
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (1, 20000),
+    (50, 25): (2, 50000),
+    (100, 100): (4, 100000),
+    (1000, 1000): (20, 1000000),
+}
+
+
+def bm_setup(params):
+    nloop, n = params
+    state = 0
+
+    def run():
+        nonlocal state
+        for _ in range(nloop):
+            state = benchmark(n)
+
+    def result():
+        return nloop * n, state
+
+    return run, result
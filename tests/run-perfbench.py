@@ -253,6 +253,8 @@ def main():
         target = pyboard.Pyboard(args.device)
         target.enter_raw_repl()
     else:
+        # clear search path to make sure tests use only builtin modules and those in extmod
+        os.environ["MICROPYPATH"] = os.pathsep + "../extmod"
         target = [MICROPYTHON, "-X", "emit=" + args.emit]
 
     if len(args.files) == 0:
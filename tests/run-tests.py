@@ -198,6 +198,10 @@ def run_micropython(pyb, args, test_file, is_special=False):
     # canonical form for all ports/platforms is to use \n for end-of-line
     output_mupy = output_mupy.replace(b"\r\n", b"\n")
 
+    # the REPL may emit bracketed-paste enable/disable sequences; they are
+    # terminal control, not test output
+    output_mupy = output_mupy.replace(b"\x1b[?2004h", b"").replace(b"\x1b[?2004l", b"")
+
     # don't try to convert the output if we should skip this test
     if had_crash or output_mupy in (b"SKIP\n", b"CRASH"):
         return output_mupy
@@ -358,6 +362,16 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
         if "True" not in str(t, "ascii"):
             skip_tests.add("cmdline/repl_words_move.py")
 
+        # Check if bracketed paste in repl is supported, and skip such tests if it's not
+        t = run_feature_check(pyb, args, base_path, "repl_paste_check.py")
+        if "True" not in str(t, "ascii"):
+            skip_tests.add("cmdline/repl_paste.py")
+
+        # Check if history search in repl is supported, and skip such tests if it's not
+        t = run_feature_check(pyb, args, base_path, "repl_hist_search_check.py")
+        if "True" not in str(t, "ascii"):
+            skip_tests.add("cmdline/repl_hist_search.py")
+
         upy_byteorder = run_feature_check(pyb, args, base_path, "byteorder.py")
         upy_float_precision = run_feature_check(pyb, args, base_path, "float.py")
         try:
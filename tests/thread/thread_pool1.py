@@ -0,0 +1,49 @@
+# test _thread.pool: persistent worker threads with a shared task queue
+
+import _thread
+
+try:
+    _thread.pool
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+# run tasks across a pool and wait for them all to finish
+p = _thread.pool(4)
+results = [0] * 50
+def task(i):
+    results[i] = i * i
+for i in range(50):
+    p.submit(task, i)
+p.wait()
+print(results == [i * i for i in range(50)])
+
+# workers survive an exception in a task
+def bad(_):
+    raise SystemExit
+p.submit(bad, None)
+p.wait()
+p.submit(task, 0)
+p.wait()
+print(results[0])
+
+# submit blocks when the queue is full instead of losing tasks
+p2 = _thread.pool(2, 2)
+hits = []
+def hit(i):
+    hits.append(i)
+for i in range(20):
+    p2.submit(hit, i)
+
+# close drains the queue and joins the workers
+p2.close()
+print(len(hits), sorted(hits) == list(range(20)))
+
+# a closed pool rejects new tasks
+try:
+    p2.submit(hit, 0)
+except RuntimeError:
+    print("RuntimeError")
+
+p.close()
+print("done")
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+#
+# This file is part of the MicroPython project, http://micropython.org/
+#
+# The MIT License (MIT)
+#
+# Copyright (c) 2020 Damien P. George
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+"""
+Create a read-only bundle image from a directory tree, for mounting with
+uos.VfsBundle (see extmod/vfs_bundle.c for the image layout).
+
+Files are compressed with raw deflate when that actually saves space,
+except .mpy files which are stored uncompressed by default so they can be
+executed in place.
+
+Usage:
+
+    ./mpbundle.py -o assets.mpb assets/
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = 0x3142504D  # "MPB1"
+FLAG_COMPRESSED = 0x80000000
+ENTRY_FMT = "<IIII"
+ENTRY_SIZE = struct.calcsize(ENTRY_FMT)
+
+
+def collect_files(root):
+    names = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        dirnames.sort()
+        rel = os.path.relpath(dirpath, root)
+        for filename in sorted(filenames):
+            if rel == ".":
+                name = filename
+            else:
+                name = rel.replace(os.sep, "/") + "/" + filename
+            names.append(name)
+    # The index must be sorted by strcmp of the full path
+    names.sort(key=lambda n: n.encode())
+    return names
+
+
+def compress(data):
+    c = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return c.compress(data) + c.flush()
+
+
+def make_bundle(root, names, compress_mpy=False, align=8):
+    entries = []
+    name_table = bytearray()
+    for name in names:
+        name_off = len(name_table)
+        name_table.extend(name.encode() + b"\x00")
+        entries.append([name_off, 0, 0, 0])
+
+    data_start = 8 + len(names) * ENTRY_SIZE + len(name_table)
+    data_start = (data_start + align - 1) & ~(align - 1)
+    names_off = 8 + len(names) * ENTRY_SIZE
+
+    data_table = bytearray()
+    n_compressed = 0
+    for name, entry in zip(names, entries):
+        with open(os.path.join(root, name.replace("/", os.sep)), "rb") as f:
+            file_data = f.read()
+        file_len = len(file_data)
+        if compress_mpy or not name.endswith(".mpy"):
+            cdata = compress(file_data)
+            if len(cdata) < file_len:
+                file_data = cdata
+                file_len |= FLAG_COMPRESSED
+                n_compressed += 1
+        pad = -len(data_table) % align
+        data_table.extend(b"\x00" * pad)
+        entry[0] += names_off
+        entry[1] = data_start + len(data_table)
+        entry[2] = len(file_data)
+        entry[3] = file_len
+        data_table.extend(file_data)
+
+    bundle = bytearray(struct.pack("<II", MAGIC, len(names)))
+    for entry in entries:
+        bundle.extend(struct.pack(ENTRY_FMT, *entry))
+    bundle.extend(name_table)
+    bundle.extend(b"\x00" * (data_start - len(bundle)))
+    bundle.extend(data_table)
+    return bytes(bundle), n_compressed
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Create a VfsBundle image from a directory.")
+    parser.add_argument("-o", "--output", required=True, help="output bundle file")
+    parser.add_argument(
+        "--compress-mpy",
+        action="store_true",
+        help="also compress .mpy files (disables executing them in place)",
+    )
+    parser.add_argument("dir", help="directory to bundle")
+    args = parser.parse_args()
+
+    names = collect_files(args.dir)
+    bundle, n_compressed = make_bundle(args.dir, names, args.compress_mpy)
+    with open(args.output, "wb") as f:
+        f.write(bundle)
+    print(
+        "%s: %u files (%u compressed), %u bytes"
+        % (args.output, len(names), n_compressed, len(bundle))
+    )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Decode a binary trace stream produced by micropython.trace_drain() (see
+# py/trace.c).  Each record is 16 bytes, little-endian: event type, pad, a
+# 16-bit argument, a microsecond timestamp and two 32-bit arguments.
+#
+# Usage: mptrace.py [tracefile]     (reads stdin if no file is given)
+
+import struct
+import sys
+
+RECORD_FMT = "<BBHIII"
+RECORD_LEN = struct.calcsize(RECORD_FMT)
+
+EV_GC_START = 1
+EV_GC_END = 2
+EV_SCHED = 3
+EV_ALLOC_CLASS = 4
+EV_DROPS = 5
+
+EVENT_NAMES = {
+    EV_GC_START: "gc-start",
+    EV_GC_END: "gc-end",
+    EV_SCHED: "sched",
+    EV_ALLOC_CLASS: "alloc-class",
+    EV_DROPS: "drops",
+}
+
+
+def decode(f):
+    gc_start = None
+    while True:
+        rec = f.read(RECORD_LEN)
+        if len(rec) < RECORD_LEN:
+            break
+        event, _, arg16, ticks_us, arg0, arg1 = struct.unpack(RECORD_FMT, rec)
+        name = EVENT_NAMES.get(event, "event-%u" % event)
+        if event == EV_GC_START:
+            gc_start = ticks_us
+            detail = ""
+        elif event == EV_GC_END:
+            detail = "%u bytes swept" % arg0
+            if gc_start is not None:
+                detail += ", pause %u us" % ((ticks_us - gc_start) & 0xFFFFFFFF)
+                gc_start = None
+        elif event == EV_SCHED:
+            detail = "queue depth %u" % arg0
+        elif event == EV_ALLOC_CLASS:
+            detail = "%u allocations of ~2^%u blocks" % (arg0, arg16)
+        elif event == EV_DROPS:
+            detail = "%u records lost" % arg0
+        else:
+            detail = "arg16=%u arg0=%u arg1=%u" % (arg16, arg0, arg1)
+        print("%10u us  %-12s %s" % (ticks_us, name, detail))
+
+
+def main():
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb") as f:
+            decode(f)
+    else:
+        decode(sys.stdin.buffer)
+
+
+if __name__ == "__main__":
+    main()
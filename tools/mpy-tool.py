@@ -60,7 +60,7 @@ class FreezeError(Exception):
 
 
 class Config:
-    MPY_VERSION = 5
+    MPY_VERSION = 6
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
     MICROPY_LONGINT_IMPL_MPZ = 2
@@ -124,6 +124,7 @@ MP_BC_FORMAT_OFFSET = 3
 MP_BC_LOAD_NAME = 0x11
 MP_BC_LOAD_GLOBAL = 0x12
 MP_BC_LOAD_ATTR = 0x13
+MP_BC_LOAD_METHOD = 0x14
 MP_BC_STORE_ATTR = 0x18
 
 # this function mirrors that in py/bc.c
@@ -137,6 +138,7 @@ def mp_opcode_format(bytecode, ip, count_var_uint):
                 opcode == MP_BC_LOAD_NAME
                 or opcode == MP_BC_LOAD_GLOBAL
                 or opcode == MP_BC_LOAD_ATTR
+                or opcode == MP_BC_LOAD_METHOD
                 or opcode == MP_BC_STORE_ATTR
             ):
                 ip += 1
@@ -294,7 +296,7 @@ class RawCode(object):
                 else:
                     obj_type = "mp_type_bytes"
                 print(
-                    'STATIC const mp_obj_str_t %s = {{&%s}, %u, %u, (const byte*)"%s"};'
+                    'STATIC const mp_obj_str_t %s = {{&%s}, %u, %u, (const byte*)"%s" MP_OBJ_STR_ANCHOR_INIT};'
                     % (
                         obj_name,
                         obj_type,
@@ -672,8 +674,10 @@ def read_obj(f):
     else:
         buf = f.read(read_uint(f))
         if obj_type == b"s":
+            f.read(1)  # skip null terminator
             return str_cons(buf, "utf8")
         elif obj_type == b"b":
+            f.read(1)  # skip null terminator
             return bytes_cons(buf)
         elif obj_type == b"i":
             return int(str_cons(buf, "ascii"), 10)